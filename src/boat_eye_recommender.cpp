@@ -0,0 +1,346 @@
+#include "boat_eye_recommender.h"
+
+#include <algorithm>
+#include <cctype>
+#include <charconv>
+#include <cmath>
+#include <fstream>
+#include <sstream>
+#include <string_view>
+
+namespace {
+
+constexpr double kMinAngleIncrementPerPixel = 0.00220031449588;
+constexpr double kEpsilon = 1e-9;
+constexpr int kMaxChoices = 12;
+
+constexpr double kCursorSpeedMultipliers[20] = { 0.03125, 0.0625, 0.125, 0.25, 0.375, 0.5,  0.625, 0.75, 0.875, 1.0,
+                                                 1.25,    1.5,    1.75,  2.0,  2.25,  2.5,  2.75,  3.0,  3.25,  3.5 };
+
+// .NET Math.Round defaults to banker's rounding; nearbyint matches under the default FE_TONEAREST mode
+double RoundTo(double v, double scale) { return std::nearbyint(v * scale) / scale; }
+int RoundToInt(double v) { return static_cast<int>(std::nearbyint(v)); }
+
+double SensitivityMultiplier(double sens) { return std::pow(sens * 0.6 + 0.2, 3.0) * 8.0; }
+double SensitivityFromMultiplier(double mult) { return (std::pow(mult / 8.0, 1.0 / 3.0) - 0.2) / 0.6; }
+
+double PixelSkippingFor(double sens) { return 1.2 * std::pow(0.2 + 0.6 * sens, 3.0) / kMinAngleIncrementPerPixel; }
+
+// Snap a raw sensitivity onto the table. Same first-match semantics as Resolve-ClosestBoatEyeSensitivity,
+// but starts from a binary search instead of a linear scan.
+struct SnapResult {
+    size_t primary = 0;
+    bool hasSecondary = false;
+    size_t secondary = 0;
+};
+
+SnapResult SnapToTable(const BoatEyeSensitivityTable& table, double raw) {
+    const std::vector<double>& values = table.sensitivity;
+    const size_t n = values.size();
+    SnapResult snap;
+    if (raw <= values.front()) return snap;
+    if (raw >= values.back()) {
+        snap.primary = n - 1;
+        return snap;
+    }
+
+    // Every index before `start` has values[i + 1] < raw - 1e-12, so it can't match
+    size_t start = static_cast<size_t>(std::lower_bound(values.begin(), values.end(), raw - 1e-12) - values.begin());
+    if (start > 0) --start;
+    for (size_t i = start; i + 1 < n; ++i) {
+        const double d1 = raw - values[i];
+        const double d2 = raw - values[i + 1];
+        if (std::abs(d1) < 1e-12 || d1 * d2 < 0) {
+            snap.primary = i;
+            snap.hasSecondary = true;
+            snap.secondary = i + 1;
+            return snap;
+        }
+    }
+
+    // Unreachable for a sorted table; fall back to the nearest entry like the script does
+    size_t nearest = 0;
+    for (size_t i = 1; i < n; ++i) {
+        if (std::abs(values[i] - raw) < std::abs(values[nearest] - raw)) nearest = i;
+    }
+    snap.primary = nearest;
+    return snap;
+}
+
+BoatEyeCandidate BuildCandidate(const BoatEyeSensitivityTable& table, double rawSensitivity, double targetDpi, int targetCursorSpeed) {
+    const SnapResult snap = SnapToTable(table, rawSensitivity);
+    const double primary = table.sensitivity[snap.primary];
+    double selected = primary;
+    BoatEyeCandidate c;
+    if (snap.hasSecondary) {
+        const double secondary = table.sensitivity[snap.secondary];
+        if (std::abs(rawSensitivity - secondary) < std::abs(rawSensitivity - primary)) selected = secondary;
+        c.secondarySensitivity = RoundTo(secondary, 1e8);
+    }
+
+    c.targetDpiRaw = targetDpi;
+    c.targetDpiRounded = RoundToInt(targetDpi);
+    c.targetCursorSpeed = std::clamp(targetCursorSpeed, 1, 20);
+    c.rawSensitivity = RoundTo(rawSensitivity, 1e8);
+    c.primarySensitivity = RoundTo(primary, 1e8);
+    c.selectedSensitivity = RoundTo(selected, 1e8);
+    // Skipping is always reported for the primary (lower) entry, as in the script
+    c.pixelSkipping = RoundTo(table.pixelSkipping[snap.primary], 1e2);
+    return c;
+}
+
+bool SameRecommendation(const BoatEyeCandidate& a, const BoatEyeCandidate& b) {
+    return std::abs(a.pixelSkipping - b.pixelSkipping) <= kEpsilon && a.targetCursorSpeed == b.targetCursorSpeed &&
+           a.targetDpiRounded == b.targetDpiRounded && std::abs(a.selectedSensitivity - b.selectedSensitivity) <= kEpsilon;
+}
+
+// Strictly-better test used for both "closest feel" and "lowest skipping" picks
+bool IsLowerSkip(const BoatEyeCandidate& c, const BoatEyeCandidate* best) {
+    if (!best) return true;
+    if (c.pixelSkipping < best->pixelSkipping - kEpsilon) return true;
+    return std::abs(c.pixelSkipping - best->pixelSkipping) <= kEpsilon && c.score < best->score;
+}
+
+// Length of the leading number token, per the script's ^([+-]?(?:\d+\.?\d*|\.\d+)(?:[eE][+-]?\d+)?) pattern; 0 if none
+size_t MatchNumberToken(std::string_view line) {
+    auto isDigit = [&](size_t i) { return i < line.size() && line[i] >= '0' && line[i] <= '9'; };
+    size_t i = 0;
+    if (i < line.size() && (line[i] == '+' || line[i] == '-')) ++i;
+    const size_t mantissaStart = i;
+    while (isDigit(i)) ++i;
+    const bool hasIntegerDigits = i > mantissaStart;
+    if (i < line.size() && line[i] == '.') {
+        if (!hasIntegerDigits && !isDigit(i + 1)) return 0;
+        ++i;
+        while (isDigit(i)) ++i;
+    } else if (!hasIntegerDigits) {
+        return 0;
+    }
+    if (i < line.size() && (line[i] == 'e' || line[i] == 'E')) {
+        size_t exp = i + 1;
+        if (exp < line.size() && (line[exp] == '+' || line[exp] == '-')) ++exp;
+        if (isDigit(exp)) {
+            while (isDigit(exp)) ++exp;
+            i = exp;
+        }
+    }
+    return i;
+}
+
+// Parses the first-column number exactly as the script does: only the pattern's token, read with '.' decimals. The
+// pattern stops at ',', so "0,75" reads as 0 there and the script's comma fallback never sees a comma; matching that
+// keeps the native table identical to the one the script ranks.
+bool ParseFirstColumn(std::string_view line, double& outValue) {
+    const size_t length = MatchNumberToken(line);
+    if (length == 0) return false;
+    std::string token(line.substr(0, length));
+    if (token.front() == '+') token.erase(0, 1);
+    auto [ptr, ec] = std::from_chars(token.data(), token.data() + token.size(), outValue);
+    return ec == std::errc() && ptr == token.data() + token.size();
+}
+
+} // namespace
+
+double GetBoatEyeCursorSpeedMultiplier(int cursorSpeed) { return kCursorSpeedMultipliers[std::clamp(cursorSpeed, 1, 20) - 1]; }
+
+bool ParseBoatEyeSensitivityTable(const std::string& raw, BoatEyeSensitivityTable& outTable, std::string& outError) {
+    outTable = BoatEyeSensitivityTable();
+    std::vector<double> values;
+    values.reserve(1024);
+
+    size_t pos = 0;
+    bool firstLine = true;
+    while (pos <= raw.size()) {
+        size_t end = raw.find_first_of("\r\n", pos);
+        if (end == std::string::npos) end = raw.size();
+        std::string_view line(raw.data() + pos, end - pos);
+        // Treat \r\n as a single break
+        pos = end + ((end + 1 < raw.size() && raw[end] == '\r' && raw[end + 1] == '\n') ? 2 : 1);
+        outTable.lineCount++;
+
+        if (firstLine && line.size() >= 3 && static_cast<unsigned char>(line[0]) == 0xEF && static_cast<unsigned char>(line[1]) == 0xBB &&
+            static_cast<unsigned char>(line[2]) == 0xBF) {
+            line.remove_prefix(3);
+        }
+        firstLine = false;
+
+        while (!line.empty() && std::isspace(static_cast<unsigned char>(line.front()))) line.remove_prefix(1);
+        if (line.empty()) continue;
+
+        // First column only; headers and comments don't start with a number and are skipped
+        if (MatchNumberToken(line) == 0) continue;
+        outTable.parsedFirstColumnCount++;
+        double value = 0.0;
+        if (!ParseFirstColumn(line, value)) continue;
+
+        if (value >= 0.0 && value <= 1.0) {
+            values.push_back(value);
+            outTable.acceptedRangeCount++;
+        }
+    }
+
+    std::sort(values.begin(), values.end());
+    values.erase(std::unique(values.begin(), values.end()), values.end());
+    if (values.size() < 2) {
+        outError = "Boat-eye sensitivity list parse failed (not enough values).";
+        return false;
+    }
+
+    outTable.pixelSkipping.resize(values.size());
+    for (size_t i = 0; i < values.size(); ++i) { outTable.pixelSkipping[i] = PixelSkippingFor(values[i]); }
+    outTable.sensitivity = std::move(values);
+    return true;
+}
+
+bool LoadBoatEyeSensitivityTable(const std::filesystem::path& path, BoatEyeSensitivityTable& outTable, std::string& outError) {
+    std::ifstream in(path, std::ios::binary);
+    if (!in.is_open()) {
+        outError = "Could not open boat-eye sensitivity list: " + path.string();
+        return false;
+    }
+    std::ostringstream ss;
+    ss << in.rdbuf();
+    return ParseBoatEyeSensitivityTable(ss.str(), outTable, outError);
+}
+
+BoatEyeRecommendation ComputeBoatEyePixelPerfectRecommendation(const BoatEyeSensitivityTable& table, const BoatEyeRankingInput& input) {
+    BoatEyeRecommendation result;
+    if (!table.IsValid()) {
+        result.error = "Boat-eye sensitivity table is not loaded.";
+        return result;
+    }
+
+    const int currentDpi = std::max(1, input.currentDpi);
+    const int currentCursorSpeed = std::clamp(input.currentCursorSpeed, 1, 20);
+    const double origMult = SensitivityMultiplier(input.currentSensitivity);
+    const int cursorPreference = std::clamp(input.preferredCursorSpeed, 0, 20);
+    const int speedReference = cursorPreference > 0 ? cursorPreference : currentCursorSpeed;
+    const double maxSkipFilter = std::clamp(input.maxRecommendedPixelSkipping, 0.1, 5000.0);
+
+    std::vector<BoatEyeCandidate> candidates;
+    candidates.reserve(20);
+    for (int speed = 1; speed <= 20; ++speed) {
+        const double ratio = GetBoatEyeCursorSpeedMultiplier(speed) / GetBoatEyeCursorSpeedMultiplier(currentCursorSpeed);
+        const double newDpi = currentDpi / ratio;
+        const double rawSens = SensitivityFromMultiplier(origMult * ratio);
+        if (rawSens <= 0) continue;
+
+        BoatEyeCandidate c = BuildCandidate(table, rawSens, newDpi, speed);
+        c.speedDelta = std::abs(speed - speedReference);
+        c.dpiDeltaRatio = std::abs(newDpi - currentDpi) / std::max(static_cast<double>(currentDpi), 1.0);
+        c.sensitivityDelta = std::abs(rawSens - input.currentSensitivity);
+        const double speedScore = input.includeCursorInRanking ? c.speedDelta * 5.0 : 0.0;
+        c.score = speedScore + c.dpiDeltaRatio * 3.0 + c.sensitivityDelta;
+        candidates.push_back(c);
+    }
+
+    std::vector<BoatEyeCandidate> filtered;
+    for (const auto& c : candidates) {
+        if (c.pixelSkipping <= maxSkipFilter + kEpsilon) filtered.push_back(c);
+    }
+    if (filtered.empty()) {
+        result.skipFilterIgnored = true;
+        filtered = candidates;
+    }
+    if (filtered.empty()) {
+        result.error = "Could not derive a valid pixel-perfect recommendation.";
+        return result;
+    }
+
+    const BoatEyeCandidate* bestClosest = nullptr;
+    const BoatEyeCandidate* bestLowest = nullptr;
+    for (const auto& c : filtered) {
+        if (!bestClosest || c.score < bestClosest->score) bestClosest = &c;
+        if (IsLowerSkip(c, bestLowest)) bestLowest = &c;
+    }
+
+    for (auto& c : filtered) {
+        const double skipRatio = std::max(1e-9, c.pixelSkipping / std::max(bestLowest->pixelSkipping, 1e-9));
+        // Balanced score: retain low-skip pressure, but strongly favor sensitivity + cursor similarity
+        const double skipPenalty = std::log(skipRatio + 1.0);
+        const double speedPenalty = input.includeCursorInRanking ? c.speedDelta * 1.25 : 0.0;
+        double dpiLowerPenalty = 0.0;
+        if (input.preferHigherDpi && c.targetDpiRounded < currentDpi) {
+            dpiLowerPenalty = (static_cast<double>(currentDpi - c.targetDpiRounded) / std::max(static_cast<double>(currentDpi), 1.0)) * 1.2;
+        }
+        c.exploreScore = skipPenalty * 3.5 + c.sensitivityDelta * 60.0 + speedPenalty + dpiLowerPenalty;
+    }
+
+    auto exploreLess = [](bool includeSpeed, bool includeDpi) {
+        return [includeSpeed, includeDpi](const BoatEyeCandidate& a, const BoatEyeCandidate& b) {
+            if (a.exploreScore != b.exploreScore) return a.exploreScore < b.exploreScore;
+            if (a.pixelSkipping != b.pixelSkipping) return a.pixelSkipping < b.pixelSkipping;
+            if (a.sensitivityDelta != b.sensitivityDelta) return a.sensitivityDelta < b.sensitivityDelta;
+            if (includeSpeed && a.speedDelta != b.speedDelta) return a.speedDelta < b.speedDelta;
+            if (includeDpi && a.targetDpiRounded != b.targetDpiRounded) return a.targetDpiRounded > b.targetDpiRounded;
+            return false;
+        };
+    };
+
+    BoatEyeCandidate chosen = *bestLowest;
+    std::string selectionPolicy = "lowest-skipping";
+    if (!input.lowestSkipChoiceOne && (cursorPreference > 0 || input.preferHigherDpi || !input.includeCursorInRanking)) {
+        std::vector<BoatEyeCandidate> sorted = filtered;
+        std::stable_sort(sorted.begin(), sorted.end(), exploreLess(input.includeCursorInRanking, input.preferHigherDpi));
+        chosen = sorted.front();
+        if (std::abs(chosen.pixelSkipping - bestLowest->pixelSkipping) > kEpsilon || chosen.targetCursorSpeed != bestLowest->targetCursorSpeed ||
+            std::abs(chosen.selectedSensitivity - bestLowest->selectedSensitivity) > kEpsilon) {
+            selectionPolicy = "balanced-similarity";
+        }
+    }
+
+    std::vector<BoatEyeCandidate> ordered;
+    ordered.reserve(filtered.size() + 1);
+    ordered.push_back(chosen);
+    std::vector<BoatEyeCandidate> sortedByExplore = filtered;
+    std::stable_sort(sortedByExplore.begin(), sortedByExplore.end(), exploreLess(true, true));
+    for (const auto& c : sortedByExplore) {
+        if (SameRecommendation(c, chosen)) continue;
+        ordered.push_back(c);
+    }
+
+    const int choiceMax = std::min(kMaxChoices, static_cast<int>(ordered.size()));
+    const int choiceSelected = std::clamp(input.recommendationChoice, 1, choiceMax);
+    if (choiceSelected > 1) selectionPolicy = "ranked-choice";
+
+    result.choices.assign(ordered.begin(), ordered.begin() + choiceMax);
+    for (int i = 0; i < choiceMax; ++i) { result.choices[i].rank = i + 1; }
+
+    result.ok = true;
+    result.active = result.choices[choiceSelected - 1];
+    result.selectionPolicy = selectionPolicy;
+    result.recommendationChoice = choiceSelected;
+    result.recommendationChoiceMax = choiceMax;
+    result.cursorSpeedPreference = cursorPreference;
+    result.cursorSpeedReference = speedReference;
+    result.maxRecommendedPixelSkipping = RoundTo(maxSkipFilter, 1e2);
+    result.closestFeelPixelSkipping = RoundTo(bestClosest->pixelSkipping, 1e2);
+    result.lowestPixelSkipping = RoundTo(bestLowest->pixelSkipping, 1e2);
+    return result;
+}
+
+BoatEyeRecommendation ComputeBoatEyeTargetMappedRecommendation(const BoatEyeSensitivityTable& table, const BoatEyeRankingInput& input,
+                                                               int targetDpi, int targetCursorSpeed) {
+    BoatEyeRecommendation result;
+    if (!table.IsValid()) {
+        result.error = "Boat-eye sensitivity table is not loaded.";
+        return result;
+    }
+
+    const int currentCursorSpeed = std::clamp(input.currentCursorSpeed, 1, 20);
+    targetCursorSpeed = std::clamp(targetCursorSpeed, 1, 20);
+    targetDpi = std::max(1, targetDpi);
+    const double factor = (std::max(1, input.currentDpi) * GetBoatEyeCursorSpeedMultiplier(currentCursorSpeed)) /
+                          (targetDpi * GetBoatEyeCursorSpeedMultiplier(targetCursorSpeed));
+    const double rawSens = SensitivityFromMultiplier(SensitivityMultiplier(input.currentSensitivity) * factor);
+
+    result.ok = true;
+    result.active = BuildCandidate(table, rawSens, targetDpi, targetCursorSpeed);
+    result.active.rank = 1;
+    result.choices.push_back(result.active);
+    result.selectionPolicy = "target-mapped";
+    result.cursorSpeedReference = currentCursorSpeed;
+    result.lowestPixelSkipping = result.active.pixelSkipping;
+    result.closestFeelPixelSkipping = result.active.pixelSkipping;
+    return result;
+}
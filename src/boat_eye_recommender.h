@@ -0,0 +1,86 @@
+#pragma once
+
+// Native boat-eye sensitivity recommender.
+// Mirrors the ranking in scripts/boat_eye_calibrate.ps1 (Compute-PixelPerfectAutoRecommendation and
+// Build-RecommendationFromRawSensitivity) so the Boat tab can update recommendations live without
+// launching PowerShell. Platform-neutral: no Windows headers.
+
+#include <filesystem>
+#include <string>
+#include <vector>
+
+// Sorted, de-duplicated boat-eye sensitivity table stored as parallel arrays (SoA).
+// pixelSkipping[i] is the estimated pixel skipping when snapping to sensitivity[i].
+struct BoatEyeSensitivityTable {
+    std::vector<double> sensitivity;
+    std::vector<double> pixelSkipping;
+    size_t lineCount = 0;
+    size_t parsedFirstColumnCount = 0;
+    size_t acceptedRangeCount = 0;
+
+    bool IsValid() const { return sensitivity.size() >= 2; }
+};
+
+// Parse the raw text of boatEyeSensitivitiesv1_16.txt (first numeric column, values in [0, 1])
+bool ParseBoatEyeSensitivityTable(const std::string& raw, BoatEyeSensitivityTable& outTable, std::string& outError);
+bool LoadBoatEyeSensitivityTable(const std::filesystem::path& path, BoatEyeSensitivityTable& outTable, std::string& outError);
+
+// Cursor-speed multipliers for Windows pointer speed 1-20 (matches Pixel-Perfect-Tools calc)
+double GetBoatEyeCursorSpeedMultiplier(int cursorSpeed);
+
+struct BoatEyeRankingInput {
+    int currentDpi = 800;
+    double currentSensitivity = 0.0; // Minecraft raw sensitivity [0, 1]
+    int currentCursorSpeed = 10;     // Windows pointer speed used as the baseline (1-20)
+    int preferredCursorSpeed = 0;    // 0 = no preference
+    int recommendationChoice = 1;    // 1-based rank to activate
+    bool lowestSkipChoiceOne = true;
+    bool includeCursorInRanking = true;
+    bool preferHigherDpi = false;
+    double maxRecommendedPixelSkipping = 50.0;
+
+    bool operator==(const BoatEyeRankingInput& other) const = default;
+};
+
+struct BoatEyeCandidate {
+    int rank = 0;
+    int targetDpiRounded = 0;
+    double targetDpiRaw = 0.0;
+    int targetCursorSpeed = 0;
+    double rawSensitivity = 0.0;
+    double primarySensitivity = 0.0;
+    double secondarySensitivity = -1.0; // < 0 when there is no secondary
+    double selectedSensitivity = 0.0;
+    double pixelSkipping = 0.0; // Rounded to 2 decimals, as the script reports it
+    double score = 0.0;         // Closest-feel score
+    double exploreScore = 0.0;  // Balanced ranking score
+    double sensitivityDelta = 0.0;
+    int speedDelta = 0;
+    double dpiDeltaRatio = 0.0;
+
+    bool HasSecondary() const { return secondarySensitivity >= 0.0; }
+};
+
+struct BoatEyeRecommendation {
+    bool ok = false;
+    std::string error;
+
+    BoatEyeCandidate active;
+    std::vector<BoatEyeCandidate> choices; // Ranked, at most 12
+    std::string selectionPolicy;           // lowest-skipping | balanced-similarity | ranked-choice
+    int recommendationChoice = 1;
+    int recommendationChoiceMax = 1;
+    int cursorSpeedPreference = 0;
+    int cursorSpeedReference = 0;
+    bool skipFilterIgnored = false;
+    double maxRecommendedPixelSkipping = 0.0;
+    double closestFeelPixelSkipping = 0.0;
+    double lowestPixelSkipping = 0.0;
+};
+
+// Pixel-perfect auto recommendation over all 20 cursor speeds
+BoatEyeRecommendation ComputeBoatEyePixelPerfectRecommendation(const BoatEyeSensitivityTable& table, const BoatEyeRankingInput& input);
+
+// Legacy target-mapped recommendation for an explicit target DPI / cursor speed
+BoatEyeRecommendation ComputeBoatEyeTargetMappedRecommendation(const BoatEyeSensitivityTable& table, const BoatEyeRankingInput& input,
+                                                               int targetDpi, int targetCursorSpeed);
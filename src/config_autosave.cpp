@@ -0,0 +1,212 @@
+#include "config_autosave.h"
+#include "config_toml.h"
+#include "gui.h"
+#include "profiler.h"
+#include "utils.h"
+
+#include <condition_variable>
+#include <filesystem>
+#include <fstream>
+#include <mutex>
+#include <sstream>
+#include <thread>
+
+// Save once edits have been quiet for this long...
+static constexpr auto AUTOSAVE_DEBOUNCE = std::chrono::milliseconds(750);
+// ...but never hold a pending snapshot longer than this during continuous edits
+static constexpr auto AUTOSAVE_MAX_DEFER = std::chrono::milliseconds(3000);
+
+static std::thread s_autosaveThread;
+static std::mutex s_autosaveMutex;
+static std::condition_variable s_autosaveCv;     // Wakes the worker (new request, flush, backup, stop)
+static std::condition_variable s_autosaveDoneCv; // Wakes FlushConfigAutosave waiters
+
+// Protected by s_autosaveMutex
+static bool s_autosaveRunning = false;
+static bool s_autosaveStopRequested = false;
+static bool s_autosaveFlushRequested = false;
+static bool s_autosaveBackupRequested = false;
+static std::shared_ptr<const Config> s_pendingSnapshot;
+static std::wstring s_pendingPath;
+static std::chrono::steady_clock::time_point s_firstPendingTime{};
+static std::chrono::steady_clock::time_point s_lastRequestTime{};
+static uint64_t s_requestedSeq = 0;
+static uint64_t s_completedSeq = 0;
+
+// Last text written to (or read from) disk - only touched by whichever thread is persisting,
+// which is serialized by s_persistMutex. The file's size and write time at that point tell whether something else
+// (default config, an external edit) has written it since.
+static std::mutex s_persistMutex;
+static std::wstring s_persistedPath;
+static std::string s_persistedText;
+static bool s_hasPersistedText = false;
+static std::filesystem::file_time_type s_persistedWriteTime{};
+static uintmax_t s_persistedSize = 0;
+
+static bool FileStamp(const std::wstring& path, std::filesystem::file_time_type& writeTime, uintmax_t& size) {
+    std::error_code ec;
+    writeTime = std::filesystem::last_write_time(path, ec);
+    if (ec) return false;
+    size = std::filesystem::file_size(path, ec);
+    return !ec;
+}
+
+static std::string ReadFileToString(const std::wstring& path) {
+    std::ifstream in(path, std::ios::binary);
+    if (!in.is_open()) { return std::string(); }
+    std::ostringstream ss;
+    ss << in.rdbuf();
+    return ss.str();
+}
+
+// Serialize and write a snapshot, skipping the write when the effective content is unchanged
+static void PersistSnapshot(const Config& config, const std::wstring& path) {
+    PROFILE_SCOPE_CAT("Config Autosave", "IO Operations");
+
+    std::string text = SerializeConfigToTomlString(config);
+
+    std::lock_guard<std::mutex> lock(s_persistMutex);
+    std::filesystem::file_time_type writeTime{};
+    uintmax_t size = 0;
+    const bool hasStamp = FileStamp(path, writeTime, size);
+    if (!s_hasPersistedText || s_persistedPath != path || !hasStamp || writeTime != s_persistedWriteTime || size != s_persistedSize) {
+        // Baseline is whatever is on disk right now
+        s_persistedText = ReadFileToString(path);
+        s_persistedPath = path;
+        s_hasPersistedText = hasStamp;
+        s_persistedWriteTime = writeTime;
+        s_persistedSize = size;
+    }
+
+    if (text == s_persistedText) { return; }
+
+    if (WriteConfigTextAtomic(path, text)) {
+        s_persistedText = std::move(text);
+        s_hasPersistedText = FileStamp(path, s_persistedWriteTime, s_persistedSize);
+    } else {
+        Log("ERROR: Config autosave failed to write " + WideToUtf8(path));
+    }
+}
+
+static void ConfigAutosaveThreadFunc() {
+    _set_se_translator(SEHTranslator);
+    // Lowers both CPU and I/O priority so autosave never competes with the game
+    SetThreadPriority(GetCurrentThread(), THREAD_MODE_BACKGROUND_BEGIN);
+
+    std::unique_lock<std::mutex> lock(s_autosaveMutex);
+    while (true) {
+        s_autosaveCv.wait(lock, [] { return s_autosaveStopRequested || s_autosaveBackupRequested || s_pendingSnapshot != nullptr; });
+
+        if (s_autosaveBackupRequested) {
+            s_autosaveBackupRequested = false;
+            lock.unlock();
+            try {
+                BackupConfigFile();
+            } catch (const SE_Exception& e) {
+                LogException("ConfigAutosaveThread backup (SEH)", e.getCode(), e.getInfo());
+            } catch (const std::exception& e) { LogException("ConfigAutosaveThread backup", e); }
+            lock.lock();
+            continue;
+        }
+
+        if (!s_pendingSnapshot) {
+            if (s_autosaveStopRequested) break;
+            continue;
+        }
+
+        // Debounce: wait for edits to go quiet, bounded by the max defer time
+        while (!s_autosaveStopRequested && !s_autosaveFlushRequested) {
+            auto deadline = (std::min)(s_lastRequestTime + AUTOSAVE_DEBOUNCE, s_firstPendingTime + AUTOSAVE_MAX_DEFER);
+            if (std::chrono::steady_clock::now() >= deadline) break;
+            s_autosaveCv.wait_until(lock, deadline);
+        }
+
+        std::shared_ptr<const Config> snapshot = std::move(s_pendingSnapshot);
+        s_pendingSnapshot.reset();
+        std::wstring path = s_pendingPath;
+        uint64_t seq = s_requestedSeq;
+        s_autosaveFlushRequested = false;
+        lock.unlock();
+
+        try {
+            PersistSnapshot(*snapshot, path);
+        } catch (const SE_Exception& e) {
+            LogException("ConfigAutosaveThread (SEH)", e.getCode(), e.getInfo());
+        } catch (const std::exception& e) { LogException("ConfigAutosaveThread", e); }
+
+        lock.lock();
+        s_completedSeq = seq;
+        s_autosaveDoneCv.notify_all();
+    }
+
+    SetThreadPriority(GetCurrentThread(), THREAD_MODE_BACKGROUND_END);
+}
+
+void StartConfigAutosaveThread() {
+    std::lock_guard<std::mutex> lock(s_autosaveMutex);
+    if (s_autosaveRunning) return;
+    s_autosaveStopRequested = false;
+    s_autosaveRunning = true;
+    s_autosaveThread = std::thread(ConfigAutosaveThreadFunc);
+    Log("Started config autosave thread");
+}
+
+void StopConfigAutosaveThread() {
+    {
+        std::lock_guard<std::mutex> lock(s_autosaveMutex);
+        if (!s_autosaveRunning) return;
+        s_autosaveStopRequested = true;
+    }
+    s_autosaveCv.notify_all();
+    if (s_autosaveThread.joinable()) { s_autosaveThread.join(); }
+
+    std::lock_guard<std::mutex> lock(s_autosaveMutex);
+    s_autosaveRunning = false;
+    s_autosaveDoneCv.notify_all();
+}
+
+void RequestConfigAutosave(std::shared_ptr<const Config> snapshot, const std::wstring& path) {
+    if (!snapshot) return;
+    {
+        std::lock_guard<std::mutex> lock(s_autosaveMutex);
+        auto now = std::chrono::steady_clock::now();
+        if (!s_pendingSnapshot) { s_firstPendingTime = now; }
+        s_lastRequestTime = now;
+        s_pendingSnapshot = std::move(snapshot);
+        s_pendingPath = path;
+        ++s_requestedSeq;
+    }
+    s_autosaveCv.notify_one();
+}
+
+bool FlushConfigAutosave(std::chrono::milliseconds timeout) {
+    std::unique_lock<std::mutex> lock(s_autosaveMutex);
+    if (!s_autosaveRunning) {
+        // No worker (early startup / late shutdown) - persist inline
+        std::shared_ptr<const Config> snapshot = std::move(s_pendingSnapshot);
+        s_pendingSnapshot.reset();
+        std::wstring path = s_pendingPath;
+        s_completedSeq = s_requestedSeq;
+        lock.unlock();
+        if (snapshot) { PersistSnapshot(*snapshot, path); }
+        return true;
+    }
+
+    const uint64_t target = s_requestedSeq;
+    if (s_completedSeq >= target) return true;
+    s_autosaveFlushRequested = true;
+    s_autosaveCv.notify_one();
+    return s_autosaveDoneCv.wait_for(lock, timeout, [target] { return s_completedSeq >= target || !s_autosaveRunning; });
+}
+
+void RequestConfigBackup() {
+    {
+        std::lock_guard<std::mutex> lock(s_autosaveMutex);
+        if (s_autosaveRunning) {
+            s_autosaveBackupRequested = true;
+            s_autosaveCv.notify_one();
+            return;
+        }
+    }
+    BackupConfigFile();
+}
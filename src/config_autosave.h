@@ -0,0 +1,26 @@
+#pragma once
+
+#include <chrono>
+#include <memory>
+#include <string>
+
+struct Config;
+
+// Background config autosave service.
+// The GUI thread hands over immutable config snapshots (see PublishConfigSnapshot). A low-priority worker
+// coalesces bursts of edits (e.g. slider drags), serializes the newest snapshot, and only rewrites
+// config.toml when the serialized text differs from what was last persisted. Disk I/O never runs on the
+// GUI or game thread.
+
+void StartConfigAutosaveThread();
+void StopConfigAutosaveThread(); // Writes any pending snapshot before returning
+
+// Queue a snapshot for saving. Replaces any snapshot still waiting in the debounce window.
+void RequestConfigAutosave(std::shared_ptr<const Config> snapshot, const std::wstring& path);
+
+// Write the pending snapshot now (skipping the debounce) and wait up to `timeout` for it to land on disk.
+// Runs the save inline if the worker isn't running. Returns false on timeout.
+bool FlushConfigAutosave(std::chrono::milliseconds timeout);
+
+// Queue a gzip backup of config.toml on the worker. Runs inline if the worker isn't running.
+void RequestConfigBackup();
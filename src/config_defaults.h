@@ -59,6 +59,7 @@ constexpr int MIRROR_FPS = 30;
 constexpr bool MIRROR_RAW_OUTPUT = false;
 constexpr bool MIRROR_COLOR_PASSTHROUGH = false;
 constexpr bool MIRROR_ONLY_ON_MY_SCREEN = false;
+constexpr bool MIRROR_SKIP_UNCHANGED_FRAMES = false;
 
 // ============================================================================
 // MirrorBorderConfig Defaults
@@ -172,6 +173,7 @@ constexpr bool DEBUG_GLOBAL_LOG_TEXTURE_OPS = false;
 constexpr bool DEBUG_GLOBAL_LOG_GUI = false;
 constexpr bool DEBUG_GLOBAL_LOG_INIT = false;
 constexpr bool DEBUG_GLOBAL_LOG_CURSOR_TEXTURES = false;
+constexpr int DEBUG_GLOBAL_TRACE_CAPTURE_SECONDS = 10;
 
 // ============================================================================
 // CursorConfig Defaults
@@ -247,6 +249,7 @@ inline const std::string CONFIG_MIRROR_MATCH_COLORSPACE = "Auto";
 
 // Default GUI hotkey: LCtrl+I
 inline std::vector<DWORD> GetDefaultGuiHotkey() { return { VK_LCONTROL, 'I' }; }
+inline std::vector<DWORD> GetDefaultTraceCaptureHotkey() { return { VK_CONTROL, VK_SHIFT, VK_F12 }; }
 
 // ============================================================================
 // Transition Type String Constants
@@ -1,12 +1,17 @@
 #include "config_toml.h"
 #include "config_defaults.h"
 #include "gui.h"
+#include "toml_ordered_writer.h"
 #include "utils.h"
 
 #include <algorithm>
 #include <cmath>
 #include <filesystem>
 #include <fstream>
+#include <future>
+#include <memory>
+#include <mutex>
+#include <sstream>
 
 // Get optional value from TOML table with default
 template <typename T> T GetOr(const toml::table& tbl, const std::string& key, T defaultValue) {
@@ -36,49 +41,6 @@ const toml::array* GetArray(const toml::table& tbl, const std::string& key) {
     return nullptr;
 }
 
-// Write a table with keys in the specified order
-void WriteTableOrdered(std::ostream& out, const toml::table& tbl, const std::vector<std::string>& orderedKeys) {
-    // Write keys in the specified order first
-    for (const auto& key : orderedKeys) {
-        if (tbl.contains(key)) {
-            const toml::node* nodePtr = tbl.get(key);
-            if (!nodePtr) continue;
-
-            if (nodePtr->is_table()) {
-                // Inline table
-                const toml::table* subtbl = nodePtr->as_table();
-                if (subtbl) out << key << " = " << *subtbl << "\n";
-            } else if (nodePtr->is_array()) {
-                const toml::array* arr = nodePtr->as_array();
-                if (arr) out << key << " = " << *arr << "\n";
-            } else {
-                // Scalar value
-                out << key << " = ";
-                nodePtr->visit([&out](auto&& val) { out << val; });
-                out << "\n";
-            }
-        }
-    }
-
-    // Write any remaining keys not in orderedKeys
-    for (const auto& [key, node] : tbl) {
-        std::string keyStr(key.str());
-        if (std::find(orderedKeys.begin(), orderedKeys.end(), keyStr) == orderedKeys.end()) {
-            if (node.is_table()) {
-                const toml::table* subtbl = node.as_table();
-                if (subtbl) out << keyStr << " = " << *subtbl << "\n";
-            } else if (node.is_array()) {
-                const toml::array* arr = node.as_array();
-                if (arr) out << keyStr << " = " << *arr << "\n";
-            } else {
-                out << keyStr << " = ";
-                node.visit([&out](auto&& val) { out << val; });
-                out << "\n";
-            }
-        }
-    }
-}
-
 toml::array ColorToTomlArray(const Color& color) {
     // Convert from internal float [0-1] to int [0-255] RGB(A) array
     // Only include alpha if it's not fully opaque (1.0) for backward compatibility
@@ -425,6 +387,7 @@ void MirrorConfigToToml(const MirrorConfig& cfg, toml::table& out) {
     out.insert("rawOutput", cfg.rawOutput);
     out.insert("colorPassthrough", cfg.colorPassthrough);
     out.insert("onlyOnMyScreen", cfg.onlyOnMyScreen);
+    out.insert("skipUnchangedFrames", cfg.skipUnchangedFrames);
 }
 
 void MirrorConfigFromToml(const toml::table& tbl, MirrorConfig& cfg) {
@@ -466,6 +429,7 @@ void MirrorConfigFromToml(const toml::table& tbl, MirrorConfig& cfg) {
     cfg.rawOutput = GetOr(tbl, "rawOutput", ConfigDefaults::MIRROR_RAW_OUTPUT);
     cfg.colorPassthrough = GetOr(tbl, "colorPassthrough", ConfigDefaults::MIRROR_COLOR_PASSTHROUGH);
     cfg.onlyOnMyScreen = GetOr(tbl, "onlyOnMyScreen", ConfigDefaults::MIRROR_ONLY_ON_MY_SCREEN);
+    cfg.skipUnchangedFrames = GetOr(tbl, "skipUnchangedFrames", ConfigDefaults::MIRROR_SKIP_UNCHANGED_FRAMES);
     // Note: mirror.debug section is ignored for backward compatibility
 }
 
@@ -1134,6 +1098,10 @@ void DebugGlobalConfigToToml(const DebugGlobalConfig& cfg, toml::table& out) {
     out.insert("delayRenderingUntilBlitted", cfg.delayRenderingUntilBlitted);
     out.insert("virtualCameraEnabled", cfg.virtualCameraEnabled);
     out.insert("virtualCameraFps", cfg.virtualCameraFps);
+    toml::array traceHotkeyArr;
+    for (const auto& key : cfg.traceCaptureHotkey) { traceHotkeyArr.push_back(static_cast<int64_t>(key)); }
+    out.insert("traceCaptureHotkey", traceHotkeyArr);
+    out.insert("traceCaptureSeconds", cfg.traceCaptureSeconds);
 
     out.insert("logModeSwitch", cfg.logModeSwitch);
     out.insert("logAnimation", cfg.logAnimation);
@@ -1159,6 +1127,14 @@ void DebugGlobalConfigFromToml(const toml::table& tbl, DebugGlobalConfig& cfg) {
     cfg.delayRenderingUntilBlitted = GetOr(tbl, "delayRenderingUntilBlitted", ConfigDefaults::DEBUG_GLOBAL_DELAY_RENDERING_UNTIL_BLITTED);
     cfg.virtualCameraEnabled = GetOr(tbl, "virtualCameraEnabled", false);
     cfg.virtualCameraFps = GetOr(tbl, "virtualCameraFps", 30);
+    cfg.traceCaptureHotkey = ConfigDefaults::GetDefaultTraceCaptureHotkey();
+    if (auto arr = GetArray(tbl, "traceCaptureHotkey")) {
+        cfg.traceCaptureHotkey.clear();
+        for (const auto& elem : *arr) {
+            if (auto val = elem.value<int64_t>()) { cfg.traceCaptureHotkey.push_back(static_cast<DWORD>(*val)); }
+        }
+    }
+    cfg.traceCaptureSeconds = std::clamp(GetOr(tbl, "traceCaptureSeconds", ConfigDefaults::DEBUG_GLOBAL_TRACE_CAPTURE_SECONDS), 1, 60);
 
     cfg.logModeSwitch = GetOr(tbl, "logModeSwitch", ConfigDefaults::DEBUG_GLOBAL_LOG_MODE_SWITCH);
     cfg.logAnimation = GetOr(tbl, "logAnimation", ConfigDefaults::DEBUG_GLOBAL_LOG_ANIMATION);
@@ -1523,135 +1499,33 @@ void AppearanceConfigFromToml(const toml::table& tbl, AppearanceConfig& cfg) {
     }
 }
 
-void ConfigToToml(const Config& config, toml::table& out) {
-    out.insert("configVersion", config.configVersion);
-    out.insert("defaultMode", config.defaultMode);
-    out.insert("fontPath", config.fontPath);
-    out.insert("fpsLimit", config.fpsLimit);
-    out.insert("fpsLimitSleepThreshold", config.fpsLimitSleepThreshold);
-    out.insert("mirrorMatchColorspace", MirrorGammaModeToString(config.mirrorGammaMode));
-    out.insert("allowCursorEscape", config.allowCursorEscape);
-    out.insert("mouseSensitivity", config.mouseSensitivity);
-    out.insert("windowsMouseSpeed", config.windowsMouseSpeed);
-    out.insert("hideAnimationsInGame", config.hideAnimationsInGame);
-    out.insert("keyRepeatStartDelay", config.keyRepeatStartDelay);
-    out.insert("keyRepeatDelay", config.keyRepeatDelay);
-    out.insert("basicModeEnabled", config.basicModeEnabled);
-    out.insert("disableFullscreenPrompt", config.disableFullscreenPrompt);
-    out.insert("disableConfigurePrompt", config.disableConfigurePrompt);
-
-    // GUI Hotkey
-    toml::array guiHotkeyArr;
-    for (const auto& key : config.guiHotkey) { guiHotkeyArr.push_back(static_cast<int64_t>(key)); }
-    out.insert("guiHotkey", guiHotkeyArr);
-
-    // Debug
-    toml::table debugTbl;
-    DebugGlobalConfigToToml(config.debug, debugTbl);
-    out.insert("debug", debugTbl);
-
-    // EyeZoom
-    toml::table eyezoomTbl;
-    EyeZoomConfigToToml(config.eyezoom, eyezoomTbl);
-    out.insert("eyezoom", eyezoomTbl);
-
-    // Cursors
-    toml::table cursorsTbl;
-    CursorsConfigToToml(config.cursors, cursorsTbl);
-    out.insert("cursors", cursorsTbl);
-
-    // Key Rebinds
-    toml::table keyRebindsTbl;
-    KeyRebindsConfigToToml(config.keyRebinds, keyRebindsTbl);
-    out.insert("keyRebinds", keyRebindsTbl);
-
-    // Native stronghold overlay
-    toml::table strongholdOverlayTbl;
-    StrongholdOverlayConfigToToml(config.strongholdOverlay, strongholdOverlayTbl);
-    out.insert("strongholdOverlay", strongholdOverlayTbl);
+// Configs with at least this many array items decode their arrays on worker threads.
+// Below this the thread start-up cost outweighs the decode work.
+static constexpr size_t PARALLEL_DECODE_MIN_ITEMS = 48;
 
-    // MCSR tracker overlay
-    toml::table mcsrTrackerOverlayTbl;
-    McsrTrackerOverlayConfigToToml(config.mcsrTrackerOverlay, mcsrTrackerOverlayTbl);
-    out.insert("mcsrTrackerOverlay", mcsrTrackerOverlayTbl);
-
-    // Boat setup helper
-    toml::table boatSetupTbl;
-    BoatSetupConfigToToml(config.boatSetup, boatSetupTbl);
-    out.insert("boatSetup", boatSetupTbl);
-
-    // Notes overlay
-    toml::table notesOverlayTbl;
-    NotesOverlayConfigToToml(config.notesOverlay, notesOverlayTbl);
-    out.insert("notesOverlay", notesOverlayTbl);
-
-    // Appearance
-    toml::table appearanceTbl;
-    AppearanceConfigToToml(config.appearance, appearanceTbl);
-    out.insert("appearance", appearanceTbl);
-
-    // Modes array
-    toml::array modesArr;
-    for (const auto& mode : config.modes) {
-        toml::table modeTbl;
-        ModeConfigToToml(mode, modeTbl);
-        modesArr.push_back(modeTbl);
-    }
-    out.insert("mode", modesArr);
-
-    // Mirrors array
-    toml::array mirrorsArr;
-    for (const auto& mirror : config.mirrors) {
-        toml::table mirrorTbl;
-        MirrorConfigToToml(mirror, mirrorTbl);
-        mirrorsArr.push_back(mirrorTbl);
-    }
-    out.insert("mirror", mirrorsArr);
-
-    // Mirror groups array
-    toml::array mirrorGroupsArr;
-    for (const auto& group : config.mirrorGroups) {
-        toml::table groupTbl;
-        MirrorGroupConfigToToml(group, groupTbl);
-        mirrorGroupsArr.push_back(groupTbl);
-    }
-    out.insert("mirrorGroup", mirrorGroupsArr);
-
-    // Images array
-    toml::array imagesArr;
-    for (const auto& image : config.images) {
-        toml::table imageTbl;
-        ImageConfigToToml(image, imageTbl);
-        imagesArr.push_back(imageTbl);
-    }
-    out.insert("image", imagesArr);
-
-    // Window overlays array
-    toml::array windowOverlaysArr;
-    for (const auto& overlay : config.windowOverlays) {
-        toml::table overlayTbl;
-        WindowOverlayConfigToToml(overlay, overlayTbl);
-        windowOverlaysArr.push_back(overlayTbl);
-    }
-    out.insert("windowOverlay", windowOverlaysArr);
-
-    // Hotkeys array
-    toml::array hotkeysArr;
-    for (const auto& hotkey : config.hotkeys) {
-        toml::table hotkeyTbl;
-        HotkeyConfigToToml(hotkey, hotkeyTbl);
-        hotkeysArr.push_back(hotkeyTbl);
-    }
-    out.insert("hotkey", hotkeysArr);
-
-    // Sensitivity Hotkeys array
-    toml::array sensitivityHotkeysArr;
-    for (const auto& sensHotkey : config.sensitivityHotkeys) {
-        toml::table sensHotkeyTbl;
-        SensitivityHotkeyConfigToToml(sensHotkey, sensHotkeyTbl);
-        sensitivityHotkeysArr.push_back(sensHotkeyTbl);
-    }
-    out.insert("sensitivityHotkey", sensitivityHotkeysArr);
+// Decode an array of tables into `out` (cleared first). Runs on a worker thread when `parallel`
+// is set, otherwise decodes inline and returns an already-completed future.
+template <typename T, typename FromTomlFn>
+static std::future<void> DecodeTableArrayAsync(const toml::array* arr, std::vector<T>& out, FromTomlFn fromToml, bool parallel) {
+    auto decode = [arr, &out, fromToml]() {
+        out.clear();
+        if (!arr) return;
+        out.reserve(arr->size());
+        for (const auto& elem : *arr) {
+            if (auto t = elem.as_table()) {
+                T item;
+                fromToml(*t, item);
+                out.push_back(std::move(item));
+            }
+        }
+    };
+    if (parallel && arr && !arr->empty()) { return std::async(std::launch::async, decode); }
+    std::promise<void> done;
+    try {
+        decode();
+        done.set_value();
+    } catch (...) { done.set_exception(std::current_exception()); }
+    return done.get_future();
 }
 
 void ConfigFromToml(const toml::table& tbl, Config& config) {
@@ -1660,7 +1534,7 @@ void ConfigFromToml(const toml::table& tbl, Config& config) {
     config.fontPath = GetStringOr(tbl, "fontPath", ConfigDefaults::CONFIG_FONT_PATH);
     config.fpsLimit = GetOr(tbl, "fpsLimit", ConfigDefaults::CONFIG_FPS_LIMIT);
     config.fpsLimitSleepThreshold = GetOr(tbl, "fpsLimitSleepThreshold", ConfigDefaults::CONFIG_FPS_LIMIT_SLEEP_THRESHOLD);
-    bool hasGlobalMirrorMatchColorspace = tbl.contains("mirrorMatchColorspace");
+    const bool hasGlobalMirrorMatchColorspace = tbl.contains("mirrorMatchColorspace");
     config.mirrorGammaMode = StringToMirrorGammaMode(
         GetStringOr(tbl, "mirrorMatchColorspace", ConfigDefaults::CONFIG_MIRROR_MATCH_COLORSPACE));
     config.allowCursorEscape = GetOr(tbl, "allowCursorEscape", ConfigDefaults::CONFIG_ALLOW_CURSOR_ESCAPE);
@@ -1731,270 +1605,247 @@ void ConfigFromToml(const toml::table& tbl, Config& config) {
     // Appearance
     if (auto t = GetTable(tbl, "appearance")) { AppearanceConfigFromToml(*t, config.appearance); }
 
-    // Modes
-    config.modes.clear();
-    if (auto arr = GetArray(tbl, "mode")) {
-        for (const auto& elem : *arr) {
-            if (auto t = elem.as_table()) {
-                ModeConfig mode;
-                ModeConfigFromToml(*t, mode);
-                config.modes.push_back(mode);
-            }
-        }
-    }
-
-    // Mirrors
-    config.mirrors.clear();
-    if (auto arr = GetArray(tbl, "mirror")) {
-        for (const auto& elem : *arr) {
-            if (auto t = elem.as_table()) {
-                // Backward compatibility: old per-mirror gammaMode setting.
-                // If the new global key isn't present, adopt the first mirror's gammaMode as the global setting.
-                if (!hasGlobalMirrorMatchColorspace && t->contains("gammaMode")) {
-                    config.mirrorGammaMode = StringToMirrorGammaMode(GetStringOr(*t, "gammaMode", ConfigDefaults::CONFIG_MIRROR_MATCH_COLORSPACE));
-                    hasGlobalMirrorMatchColorspace = true;
-                }
-                MirrorConfig mirror;
-                MirrorConfigFromToml(*t, mirror);
-                config.mirrors.push_back(mirror);
+    // Backward compatibility: old per-mirror gammaMode setting.
+    // If the new global key isn't present, adopt the first mirror's gammaMode as the global setting.
+    const toml::array* mirrorArr = GetArray(tbl, "mirror");
+    if (!hasGlobalMirrorMatchColorspace && mirrorArr) {
+        for (const auto& elem : *mirrorArr) {
+            auto t = elem.as_table();
+            if (t && t->contains("gammaMode")) {
+                config.mirrorGammaMode = StringToMirrorGammaMode(GetStringOr(*t, "gammaMode", ConfigDefaults::CONFIG_MIRROR_MATCH_COLORSPACE));
+                break;
             }
         }
     }
 
-    // Mirror Groups
-    config.mirrorGroups.clear();
-    if (auto arr = GetArray(tbl, "mirrorGroup")) {
-        for (const auto& elem : *arr) {
-            if (auto t = elem.as_table()) {
-                MirrorGroupConfig group;
-                MirrorGroupConfigFromToml(*t, group);
-                config.mirrorGroups.push_back(group);
-            }
-        }
-    }
-
-    // Images
-    config.images.clear();
-    if (auto arr = GetArray(tbl, "image")) {
-        for (const auto& elem : *arr) {
-            if (auto t = elem.as_table()) {
-                ImageConfig image;
-                ImageConfigFromToml(*t, image);
-                config.images.push_back(image);
-            }
-        }
+    // Arrays of tables (modes, mirrors, images, ...). The parsed tree is only read here and every
+    // element decodes independently, so large configs decode the arrays concurrently.
+    const toml::array* modeArr = GetArray(tbl, "mode");
+    const toml::array* mirrorGroupArr = GetArray(tbl, "mirrorGroup");
+    const toml::array* imageArr = GetArray(tbl, "image");
+    const toml::array* windowOverlayArr = GetArray(tbl, "windowOverlay");
+    const toml::array* hotkeyArr = GetArray(tbl, "hotkey");
+    const toml::array* sensitivityHotkeyArr = GetArray(tbl, "sensitivityHotkey");
+
+    size_t totalItems = 0;
+    for (const toml::array* arr : { modeArr, mirrorArr, mirrorGroupArr, imageArr, windowOverlayArr, hotkeyArr, sensitivityHotkeyArr }) {
+        if (arr) totalItems += arr->size();
+    }
+    const bool parallel = totalItems >= PARALLEL_DECODE_MIN_ITEMS;
+
+    auto modesTask = DecodeTableArrayAsync(modeArr, config.modes, ModeConfigFromToml, parallel);
+    auto mirrorsTask = DecodeTableArrayAsync(mirrorArr, config.mirrors, MirrorConfigFromToml, parallel);
+    auto mirrorGroupsTask = DecodeTableArrayAsync(mirrorGroupArr, config.mirrorGroups, MirrorGroupConfigFromToml, parallel);
+    auto imagesTask = DecodeTableArrayAsync(imageArr, config.images, ImageConfigFromToml, parallel);
+    auto windowOverlaysTask = DecodeTableArrayAsync(windowOverlayArr, config.windowOverlays, WindowOverlayConfigFromToml, parallel);
+    auto hotkeysTask = DecodeTableArrayAsync(hotkeyArr, config.hotkeys, HotkeyConfigFromToml, parallel);
+    auto sensitivityHotkeysTask =
+        DecodeTableArrayAsync(sensitivityHotkeyArr, config.sensitivityHotkeys, SensitivityHotkeyConfigFromToml, parallel);
+
+    // get() rethrows any decode exception on this thread, matching the serial behavior
+    modesTask.get();
+    mirrorsTask.get();
+    mirrorGroupsTask.get();
+    imagesTask.get();
+    windowOverlaysTask.get();
+    hotkeysTask.get();
+    sensitivityHotkeysTask.get();
+}
+
+// Key order of the top level and of each [[array]] item; keys a converter writes that aren't listed follow the listed
+// ones, so nothing is dropped before a list is updated
+static const std::vector<std::string> kTopLevelKeyOrder = { "configVersion",
+                                                            "defaultMode",
+                                                            "fontPath",
+                                                            "fpsLimit",
+                                                            "fpsLimitSleepThreshold",
+                                                            "mirrorMatchColorspace",
+                                                            "allowCursorEscape",
+                                                            "mouseSensitivity",
+                                                            "windowsMouseSpeed",
+                                                            "hideAnimationsInGame",
+                                                            "keyRepeatStartDelay",
+                                                            "keyRepeatDelay",
+                                                            "basicModeEnabled",
+                                                            "disableFullscreenPrompt",
+                                                            "disableConfigurePrompt",
+                                                            "guiHotkey" };
+static const std::vector<std::string> kModeKeyOrder = { "id",
+                                                        "width",
+                                                        "height",
+                                                        "background",
+                                                        "mirrorIds",
+                                                        "mirrorGroupIds",
+                                                        "imageIds",
+                                                        "windowOverlayIds",
+                                                        "stretch",
+                                                        "gameTransition",
+                                                        "overlayTransition",
+                                                        "backgroundTransition",
+                                                        "transitionDurationMs",
+                                                        "easeInPower",
+                                                        "easeOutPower",
+                                                        "bounceCount",
+                                                        "bounceIntensity",
+                                                        "bounceDurationMs",
+                                                        "relativeStretching",
+                                                        "skipAnimateX",
+                                                        "skipAnimateY",
+                                                        "border",
+                                                        "sensitivityOverrideEnabled",
+                                                        "modeSensitivity",
+                                                        "separateXYSensitivity",
+                                                        "modeSensitivityX",
+                                                        "modeSensitivityY" };
+static const std::vector<std::string> kMirrorKeyOrder = { "name",   "captureWidth", "captureHeight",    "input",
+                                                          "output", "colors",       "colorSensitivity", "border",
+                                                          "fps",    "rawOutput",    "colorPassthrough", "onlyOnMyScreen",
+                                                          "debug" };
+static const std::vector<std::string> kMirrorGroupKeyOrder = { "name", "output", "mirrorIds" };
+static const std::vector<std::string> kImageKeyOrder = { "name",           "path",      "x",           "y",          "scale",
+                                                         "relativeTo",     "crop_top",  "crop_bottom", "crop_left",  "crop_right",
+                                                         "enableColorKey", "colorKeys", "opacity",     "background", "pixelatedScaling",
+                                                         "onlyOnMyScreen", "border" };
+static const std::vector<std::string> kWindowOverlayKeyOrder = { "name",
+                                                                 "windowTitle",
+                                                                 "windowClass",
+                                                                 "executableName",
+                                                                 "windowMatchPriority",
+                                                                 "x",
+                                                                 "y",
+                                                                 "scale",
+                                                                 "relativeTo",
+                                                                 "crop_top",
+                                                                 "crop_bottom",
+                                                                 "crop_left",
+                                                                 "crop_right",
+                                                                 "enableColorKey",
+                                                                 "colorKeys",
+                                                                 "opacity",
+                                                                 "background",
+                                                                 "pixelatedScaling",
+                                                                 "onlyOnMyScreen",
+                                                                 "fps",
+                                                                 "captureMethod",
+                                                                 "enableInteraction",
+                                                                 "border" };
+static const std::vector<std::string> kHotkeyKeyOrder = { "keys", "mainMode", "secondaryMode", "altSecondaryModes", "conditions", "debounce" };
+
+// Stream a config table section: converted, written and dropped before the next one is built, so the whole document
+// tree never exists in memory at once
+template <typename Cfg, typename ToTomlFn> static void WriteTomlSubTable(std::ostream& out, const char* key, const Cfg& cfg, ToTomlFn&& toToml) {
+    toml::table tbl;
+    toToml(cfg, tbl);
+    WriteTomlNamedTable(out, key, tbl);
+}
+
+// Stream an array of tables one element at a time as [[key]] entries
+template <typename Item, typename ToTomlFn>
+static void WriteTomlTableArray(std::ostream& out, const char* key, const std::vector<Item>& items, const std::vector<std::string>& keyOrder,
+                                ToTomlFn&& toToml) {
+    for (const auto& item : items) {
+        toml::table itemTbl;
+        toToml(item, itemTbl);
+        WriteTomlArrayTableEntry(out, key, itemTbl, keyOrder);
+    }
+}
+
+static void WriteConfigToml(std::ostream& out, const Config& config) {
+    // Top-level scalars must come before any table header
+    toml::table header;
+    header.insert("configVersion", config.configVersion);
+    header.insert("defaultMode", config.defaultMode);
+    header.insert("fontPath", config.fontPath);
+    header.insert("fpsLimit", config.fpsLimit);
+    header.insert("fpsLimitSleepThreshold", config.fpsLimitSleepThreshold);
+    header.insert("mirrorMatchColorspace", MirrorGammaModeToString(config.mirrorGammaMode));
+    header.insert("allowCursorEscape", config.allowCursorEscape);
+    header.insert("mouseSensitivity", config.mouseSensitivity);
+    header.insert("windowsMouseSpeed", config.windowsMouseSpeed);
+    header.insert("hideAnimationsInGame", config.hideAnimationsInGame);
+    header.insert("keyRepeatStartDelay", config.keyRepeatStartDelay);
+    header.insert("keyRepeatDelay", config.keyRepeatDelay);
+    header.insert("basicModeEnabled", config.basicModeEnabled);
+    header.insert("disableFullscreenPrompt", config.disableFullscreenPrompt);
+    header.insert("disableConfigurePrompt", config.disableConfigurePrompt);
+    toml::array guiHotkeyArr;
+    for (const auto& key : config.guiHotkey) { guiHotkeyArr.push_back(static_cast<int64_t>(key)); }
+    header.insert("guiHotkey", std::move(guiHotkeyArr));
+    WriteTomlTableOrdered(out, header, kTopLevelKeyOrder);
+
+    WriteTomlSubTable(out, "debug", config.debug, DebugGlobalConfigToToml);
+    WriteTomlSubTable(out, "eyezoom", config.eyezoom, EyeZoomConfigToToml);
+    WriteTomlSubTable(out, "cursors", config.cursors, CursorsConfigToToml);
+    WriteTomlSubTable(out, "keyRebinds", config.keyRebinds, KeyRebindsConfigToToml);
+    WriteTomlSubTable(out, "strongholdOverlay", config.strongholdOverlay, StrongholdOverlayConfigToToml);
+    WriteTomlSubTable(out, "mcsrTrackerOverlay", config.mcsrTrackerOverlay, McsrTrackerOverlayConfigToToml);
+    WriteTomlSubTable(out, "boatSetup", config.boatSetup, BoatSetupConfigToToml);
+    WriteTomlSubTable(out, "notesOverlay", config.notesOverlay, NotesOverlayConfigToToml);
+    WriteTomlSubTable(out, "appearance", config.appearance, AppearanceConfigToToml);
+
+    WriteTomlTableArray(out, "mode", config.modes, kModeKeyOrder, ModeConfigToToml);
+    WriteTomlTableArray(out, "mirror", config.mirrors, kMirrorKeyOrder, MirrorConfigToToml);
+    WriteTomlTableArray(out, "mirrorGroup", config.mirrorGroups, kMirrorGroupKeyOrder, MirrorGroupConfigToToml);
+    WriteTomlTableArray(out, "image", config.images, kImageKeyOrder, ImageConfigToToml);
+    WriteTomlTableArray(out, "windowOverlay", config.windowOverlays, kWindowOverlayKeyOrder, WindowOverlayConfigToToml);
+    WriteTomlTableArray(out, "hotkey", config.hotkeys, kHotkeyKeyOrder, HotkeyConfigToToml);
+    WriteTomlTableArray(out, "sensitivityHotkey", config.sensitivityHotkeys, {}, SensitivityHotkeyConfigToToml);
+}
+
+std::string SerializeConfigToTomlString(const Config& config) {
+    std::ostringstream out;
+    WriteConfigToml(out, config);
+    return out.str();
+}
+
+bool WriteConfigTextAtomic(const std::wstring& path, const std::string& text) {
+    const std::wstring tempPath = path + L".tmp";
+    HANDLE hFile = CreateFileW(tempPath.c_str(), GENERIC_WRITE, 0, NULL, CREATE_ALWAYS, FILE_ATTRIBUTE_NORMAL, NULL);
+    if (hFile == INVALID_HANDLE_VALUE) {
+        Log("ERROR: Failed to open temp config file for writing. Error: " + std::to_string(GetLastError()));
+        return false;
     }
 
-    // Window overlays
-    config.windowOverlays.clear();
-    if (auto arr = GetArray(tbl, "windowOverlay")) {
-        for (const auto& elem : *arr) {
-            if (auto t = elem.as_table()) {
-                WindowOverlayConfig overlay;
-                WindowOverlayConfigFromToml(*t, overlay);
-                config.windowOverlays.push_back(overlay);
-            }
+    const char* data = text.data();
+    size_t remaining = text.size();
+    bool ok = true;
+    while (remaining > 0) {
+        DWORD chunk = static_cast<DWORD>(std::min<size_t>(remaining, 1u << 20));
+        DWORD written = 0;
+        if (!WriteFile(hFile, data, chunk, &written, NULL) || written == 0) {
+            ok = false;
+            break;
         }
+        data += written;
+        remaining -= written;
     }
+    // Make sure the bytes are on disk before the rename makes them the live config
+    if (ok && !FlushFileBuffers(hFile)) { ok = false; }
+    CloseHandle(hFile);
 
-    // Hotkeys
-    config.hotkeys.clear();
-    if (auto arr = GetArray(tbl, "hotkey")) {
-        for (const auto& elem : *arr) {
-            if (auto t = elem.as_table()) {
-                HotkeyConfig hotkey;
-                HotkeyConfigFromToml(*t, hotkey);
-                config.hotkeys.push_back(hotkey);
-            }
-        }
+    if (!ok) {
+        Log("ERROR: Failed while writing temp config file. Error: " + std::to_string(GetLastError()));
+        DeleteFileW(tempPath.c_str());
+        return false;
     }
-
-    // Sensitivity Hotkeys
-    config.sensitivityHotkeys.clear();
-    if (auto arr = GetArray(tbl, "sensitivityHotkey")) {
-        for (const auto& elem : *arr) {
-            if (auto t = elem.as_table()) {
-                SensitivityHotkeyConfig sensHotkey;
-                SensitivityHotkeyConfigFromToml(*t, sensHotkey);
-                config.sensitivityHotkeys.push_back(sensHotkey);
-            }
-        }
+    if (!MoveFileExW(tempPath.c_str(), path.c_str(), MOVEFILE_REPLACE_EXISTING | MOVEFILE_WRITE_THROUGH)) {
+        Log("ERROR: Failed to replace config file. Error: " + std::to_string(GetLastError()));
+        DeleteFileW(tempPath.c_str());
+        return false;
     }
+    return true;
 }
 
 bool SaveConfigToTomlFile(const Config& config, const std::wstring& path) {
+    // Same writer the autosave worker uses, so there is one temp file convention and every save is flushed to disk
+    std::string text;
     try {
-        toml::table tbl;
-        ConfigToToml(config, tbl);
-
-        // Convert wide path to narrow for ofstream
-        std::string narrowPath = WideToUtf8(path);
-        std::ofstream file(narrowPath);
-        if (!file.is_open()) { return false; }
-
-        // Define the order of top-level keys
-        std::vector<std::string> orderedKeys = { "configVersion",
-                                                 "defaultMode",
-                                                 "fontPath",
-                                                 "fpsLimit",
-                                                 "fpsLimitSleepThreshold",
-                                                 "allowCursorEscape",
-                                                 "mouseSensitivity",
-                                                 "windowsMouseSpeed",
-                                                 "hideAnimationsInGame",
-                                                 "keyRepeatStartDelay",
-                                                 "keyRepeatDelay",
-                                                 "basicModeEnabled",
-                                                 "disableFullscreenPrompt",
-                                                 "disableConfigurePrompt",
-                                                 "guiHotkey",
-                                                 "debug",
-                                                 "eyezoom",
-                                                 "cursors",
-                                                 "keyRebinds",
-                                                 "strongholdOverlay",
-                                                 "mcsrTrackerOverlay",
-                                                 "boatSetup",
-                                                 "notesOverlay",
-                                                 "appearance",
-                                                 "mode",
-                                                 "mirror",
-                                                 "mirrorGroup",
-                                                 "image",
-                                                 "windowOverlay",
-                                                 "hotkey",
-                                                 "sensitivityHotkey" };
-
-        // Key orders for each item type (matches the order in *ToToml functions)
-        std::vector<std::string> modeKeys = { "id",
-                                              "width",
-                                              "height",
-                                              "background",
-                                              "mirrorIds",
-                                              "mirrorGroupIds",
-                                              "imageIds",
-                                              "windowOverlayIds",
-                                              "stretch",
-                                              "gameTransition",
-                                              "overlayTransition",
-                                              "backgroundTransition",
-                                              "transitionDurationMs",
-                                              "easeInPower",
-                                              "easeOutPower",
-                                              "bounceCount",
-                                              "bounceIntensity",
-                                              "bounceDurationMs",
-                                              "relativeStretching",
-                                              "skipAnimateX",
-                                              "skipAnimateY",
-                                              "border",
-                                              "sensitivityOverrideEnabled",
-                                              "modeSensitivity",
-                                              "separateXYSensitivity",
-                                              "modeSensitivityX",
-                                              "modeSensitivityY" };
-        std::vector<std::string> mirrorKeys = { "name",   "captureWidth", "captureHeight",    "input",
-                                                "output", "colors",       "colorSensitivity", "border",
-                                                "fps",    "rawOutput",    "colorPassthrough", "onlyOnMyScreen",
-                                                "debug" };
-        std::vector<std::string> mirrorGroupKeys = { "name", "output", "mirrorIds" };
-        std::vector<std::string> imageKeys = { "name",           "path",      "x",           "y",          "scale",
-                                               "relativeTo",     "crop_top",  "crop_bottom", "crop_left",  "crop_right",
-                                               "enableColorKey", "colorKeys", "opacity",     "background", "pixelatedScaling",
-                                               "onlyOnMyScreen", "border" };
-        std::vector<std::string> windowOverlayKeys = { "name",
-                                                       "windowTitle",
-                                                       "windowClass",
-                                                       "executableName",
-                                                       "windowMatchPriority",
-                                                       "x",
-                                                       "y",
-                                                       "scale",
-                                                       "relativeTo",
-                                                       "crop_top",
-                                                       "crop_bottom",
-                                                       "crop_left",
-                                                       "crop_right",
-                                                       "enableColorKey",
-                                                       "colorKeys",
-                                                       "opacity",
-                                                       "background",
-                                                       "pixelatedScaling",
-                                                       "onlyOnMyScreen",
-                                                       "fps",
-                                                       "captureMethod",
-                                                       "enableInteraction",
-                                                       "border" };
-        std::vector<std::string> hotkeyKeys = { "keys", "mainMode", "secondaryMode", "altSecondaryModes", "conditions", "debounce" };
-
-        // Helper to get key order for a given array type
-        auto getKeyOrder = [&](const std::string& arrayKey) -> const std::vector<std::string>* {
-            if (arrayKey == "mode") return &modeKeys;
-            if (arrayKey == "mirror") return &mirrorKeys;
-            if (arrayKey == "mirrorGroup") return &mirrorGroupKeys;
-            if (arrayKey == "image") return &imageKeys;
-            if (arrayKey == "windowOverlay") return &windowOverlayKeys;
-            if (arrayKey == "hotkey") return &hotkeyKeys;
-            return nullptr;
-        };
-
-        // Write keys in the specified order
-        for (const auto& key : orderedKeys) {
-            if (tbl.contains(key)) {
-                const toml::node* nodePtr = tbl.get(key);
-                if (!nodePtr) continue;
-
-                // Arrays of tables need special formatting with [[array_name]]
-                if (nodePtr->is_array()) {
-                    const toml::array* arr = nodePtr->as_array();
-                    // Check if it's an array of tables (like [[mode]])
-                    if (arr && !arr->empty() && (*arr)[0].is_table()) {
-                        const std::vector<std::string>* itemKeyOrder = getKeyOrder(key);
-                        for (const auto& elem : *arr) {
-                            file << "\n[[" << key << "]]\n";
-                            const toml::table* elemTbl = elem.as_table();
-                            if (elemTbl) {
-                                if (itemKeyOrder) {
-                                    WriteTableOrdered(file, *elemTbl, *itemKeyOrder);
-                                } else {
-                                    file << *elemTbl;
-                                }
-                            }
-                        }
-                    } else if (arr) {
-                        // Simple array - use default formatting
-                        file << key << " = " << *arr << "\n";
-                    }
-                } else if (nodePtr->is_table()) {
-                    // Named table like [debug]
-                    file << "\n[" << key << "]\n";
-                    const toml::table* subtbl = nodePtr->as_table();
-                    if (subtbl) file << *subtbl;
-                } else {
-                    // Scalar values
-                    file << key << " = ";
-                    nodePtr->visit([&file](auto&& val) { file << val; });
-                    file << "\n";
-                }
-            }
-        }
-
-        // Write any remaining keys that weren't in orderedKeys (for forward compatibility)
-        for (const auto& [key, node] : tbl) {
-            std::string keyStr(key.str());
-            if (std::find(orderedKeys.begin(), orderedKeys.end(), keyStr) == orderedKeys.end()) {
-                file << keyStr << " = ";
-                node.visit([&file](auto&& val) { file << val; });
-                file << "\n";
-            }
-        }
-
-        file.close();
-        return true;
+        text = SerializeConfigToTomlString(config);
     } catch (const std::exception& e) {
         Log("ERROR: Failed to save config to TOML: " + std::string(e.what()));
         return false;
     }
+    return WriteConfigTextAtomic(path, text);
 }
 
 bool LoadConfigFromTomlFile(const std::wstring& path, Config& config) {
@@ -2065,17 +1916,29 @@ std::string GetEmbeddedDefaultConfigString() {
     return s_embeddedConfigCache;
 }
 
+// Parsed embedded default config, built once on first use. Every GetDefault*FromEmbedded() call
+// would otherwise re-parse the full default.toml; they all decode from this shared read-only tree.
+static std::once_flag s_embeddedConfigTableOnce;
+static std::unique_ptr<const toml::table> s_embeddedConfigTable;
+
+static const toml::table* GetEmbeddedDefaultConfigTable() {
+    std::call_once(s_embeddedConfigTableOnce, []() {
+        std::string configStr = GetEmbeddedDefaultConfigString();
+        if (configStr.empty()) { return; }
+        try {
+            s_embeddedConfigTable = std::make_unique<const toml::table>(toml::parse(configStr));
+        } catch (const toml::parse_error& e) { Log("ERROR: Failed to parse embedded default.toml: " + std::string(e.what())); }
+    });
+    return s_embeddedConfigTable.get();
+}
+
 bool LoadEmbeddedDefaultConfig(Config& config) {
-    std::string configStr = GetEmbeddedDefaultConfigString();
-    if (configStr.empty()) { return false; }
+    const toml::table* tbl = GetEmbeddedDefaultConfigTable();
+    if (!tbl) { return false; }
 
     try {
-        toml::table tbl = toml::parse(configStr);
-        ConfigFromToml(tbl, config);
+        ConfigFromToml(*tbl, config);
         return true;
-    } catch (const toml::parse_error& e) {
-        Log("ERROR: Failed to parse embedded default.toml: " + std::string(e.what()));
-        return false;
     } catch (const std::exception& e) {
         Log("ERROR: Failed to load embedded default config: " + std::string(e.what()));
         return false;
@@ -2087,16 +1950,16 @@ int GetCachedScreenWidth();
 int GetCachedScreenHeight();
 
 std::vector<ModeConfig> GetDefaultModesFromEmbedded() {
-    std::string configStr = GetEmbeddedDefaultConfigString();
+    const toml::table* defaults = GetEmbeddedDefaultConfigTable();
     std::vector<ModeConfig> modes;
 
-    if (configStr.empty()) {
+    if (!defaults) {
         Log("WARNING: Could not load embedded config for modes, falling back to empty");
         return modes;
     }
 
     try {
-        toml::table tbl = toml::parse(configStr);
+        const toml::table& tbl = *defaults;
 
         // Parse modes array
         if (auto arr = GetArray(tbl, "mode")) {
@@ -2139,16 +2002,16 @@ std::vector<ModeConfig> GetDefaultModesFromEmbedded() {
 }
 
 std::vector<MirrorConfig> GetDefaultMirrorsFromEmbedded() {
-    std::string configStr = GetEmbeddedDefaultConfigString();
+    const toml::table* defaults = GetEmbeddedDefaultConfigTable();
     std::vector<MirrorConfig> mirrors;
 
-    if (configStr.empty()) {
+    if (!defaults) {
         Log("WARNING: Could not load embedded config for mirrors, falling back to empty");
         return mirrors;
     }
 
     try {
-        toml::table tbl = toml::parse(configStr);
+        const toml::table& tbl = *defaults;
 
         // Parse mirrors array
         if (auto arr = GetArray(tbl, "mirror")) {
@@ -2167,16 +2030,16 @@ std::vector<MirrorConfig> GetDefaultMirrorsFromEmbedded() {
 }
 
 std::vector<HotkeyConfig> GetDefaultHotkeysFromEmbedded() {
-    std::string configStr = GetEmbeddedDefaultConfigString();
+    const toml::table* defaults = GetEmbeddedDefaultConfigTable();
     std::vector<HotkeyConfig> hotkeys;
 
-    if (configStr.empty()) {
+    if (!defaults) {
         Log("WARNING: Could not load embedded config for hotkeys, falling back to empty");
         return hotkeys;
     }
 
     try {
-        toml::table tbl = toml::parse(configStr);
+        const toml::table& tbl = *defaults;
 
         // Parse hotkeys array
         if (auto arr = GetArray(tbl, "hotkey")) {
@@ -2195,16 +2058,16 @@ std::vector<HotkeyConfig> GetDefaultHotkeysFromEmbedded() {
 }
 
 std::vector<ImageConfig> GetDefaultImagesFromEmbedded() {
-    std::string configStr = GetEmbeddedDefaultConfigString();
+    const toml::table* defaults = GetEmbeddedDefaultConfigTable();
     std::vector<ImageConfig> images;
 
-    if (configStr.empty()) {
+    if (!defaults) {
         Log("WARNING: Could not load embedded config for images, falling back to empty");
         return images;
     }
 
     try {
-        toml::table tbl = toml::parse(configStr);
+        const toml::table& tbl = *defaults;
 
         // Parse images array
         if (auto arr = GetArray(tbl, "image")) {
@@ -2234,16 +2097,16 @@ std::vector<ImageConfig> GetDefaultImagesFromEmbedded() {
 }
 
 CursorsConfig GetDefaultCursorsFromEmbedded() {
-    std::string configStr = GetEmbeddedDefaultConfigString();
+    const toml::table* defaults = GetEmbeddedDefaultConfigTable();
     CursorsConfig cursors;
 
-    if (configStr.empty()) {
+    if (!defaults) {
         Log("WARNING: Could not load embedded config for cursors, falling back to defaults");
         return cursors;
     }
 
     try {
-        toml::table tbl = toml::parse(configStr);
+        const toml::table& tbl = *defaults;
 
         // Parse cursors section
         if (auto t = GetTable(tbl, "cursors")) { CursorsConfigFromToml(*t, cursors); }
@@ -2267,16 +2130,16 @@ CursorsConfig GetDefaultCursorsFromEmbedded() {
 }
 
 EyeZoomConfig GetDefaultEyeZoomConfigFromEmbedded() {
-    std::string configStr = GetEmbeddedDefaultConfigString();
+    const toml::table* defaults = GetEmbeddedDefaultConfigTable();
     EyeZoomConfig eyezoom;
 
-    if (configStr.empty()) {
+    if (!defaults) {
         Log("WARNING: Could not load embedded config for eyezoom, falling back to defaults");
         return eyezoom;
     }
 
     try {
-        toml::table tbl = toml::parse(configStr);
+        const toml::table& tbl = *defaults;
 
         // Parse eyezoom section
         if (auto t = GetTable(tbl, "eyezoom")) { EyeZoomConfigFromToml(*t, eyezoom); }
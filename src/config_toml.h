@@ -78,7 +78,6 @@ void McsrTrackerOverlayConfigToToml(const McsrTrackerOverlayConfig& cfg, toml::t
 void BoatSetupConfigToToml(const BoatSetupConfig& cfg, toml::table& out);
 void NotesOverlayConfigToToml(const NotesOverlayConfig& cfg, toml::table& out);
 void AppearanceConfigToToml(const AppearanceConfig& cfg, toml::table& out);
-void ConfigToToml(const Config& config, toml::table& out);
 
 // ============================================================================
 // TOML Deserialization Functions (TOML -> Config)
@@ -125,6 +124,12 @@ bool SaveConfigToTomlFile(const Config& config, const std::wstring& path);
 // Load config from TOML file
 bool LoadConfigFromTomlFile(const std::wstring& path, Config& config);
 
+// Serialize config to TOML text (same layout SaveConfigToTomlFile writes)
+std::string SerializeConfigToTomlString(const Config& config);
+
+// Replace the file at path with text via temp file + flush to disk + rename
+bool WriteConfigTextAtomic(const std::wstring& path, const std::string& text);
+
 // ============================================================================
 // Embedded Default Config Functions
 // ============================================================================
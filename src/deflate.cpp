@@ -0,0 +1,758 @@
+#include "deflate.h"
+
+#include <algorithm>
+#include <array>
+#include <bit>
+#include <cstring>
+#include <fstream>
+#include <mutex>
+
+// LZ77 with hash chains (zlib's matching strategy and level table) + per-block choice of fixed / dynamic Huffman
+// or stored encoding
+
+namespace {
+
+constexpr size_t kWindowSize = 32768;
+constexpr size_t kWindowMask = kWindowSize - 1;
+constexpr size_t kMinMatch = 3;
+constexpr size_t kMaxMatch = 258;
+constexpr size_t kMinLookahead = kMaxMatch + kMinMatch + 1; // Enough for a full match plus the next hash
+constexpr size_t kMaxDist = kWindowSize - kMinLookahead;
+constexpr size_t kTooFar = 4096; // A 3-byte match further back than this costs more than three literals
+constexpr int kHashBits = 15;
+constexpr size_t kMaxBlockSymbols = 16384;
+constexpr size_t kMaxStoredBlock = 65535;
+
+struct LevelConfig {
+    uint16_t goodLength; // Search a quarter of the chain once the current match is this long
+    uint16_t maxLazy;    // Lazy: don't look for a better match past this length. Fast: insert matches up to this long.
+    uint16_t niceLength; // Stop searching at a match this long
+    uint16_t maxChain;
+    bool lazy;
+};
+
+const LevelConfig kLevelConfigs[10] = {
+    { 0, 0, 0, 0, false },          { 4, 4, 8, 4, false },       { 4, 5, 16, 8, false },       { 4, 6, 32, 32, false },
+    { 4, 4, 16, 16, true },         { 8, 16, 32, 32, true },     { 8, 16, 128, 128, true },    { 8, 32, 128, 256, true },
+    { 32, 128, 258, 1024, true },   { 32, 258, 258, 4096, true },
+};
+
+const uint16_t kLenBase[29] = { 3,  4,  5,  6,  7,  8,  9,  10, 11,  13,  15,  17,  19,  23, 27,
+                                31, 35, 43, 51, 59, 67, 83, 99, 115, 131, 163, 195, 227, 258 };
+const uint8_t kLenExtra[29] = { 0, 0, 0, 0, 0, 0, 0, 0, 1, 1, 1, 1, 2, 2, 2, 2, 3, 3, 3, 3, 4, 4, 4, 4, 5, 5, 5, 5, 0 };
+const uint16_t kDistBase[30] = { 1,   2,   3,   4,   5,   7,    9,    13,   17,   25,   33,   49,   65,    97,    129,
+                                 193, 257, 385, 513, 769, 1025, 1537, 2049, 3073, 4097, 6145, 8193, 12289, 16385, 24577 };
+const uint8_t kDistExtra[30] = { 0, 0, 0, 0, 1, 1, 2, 2, 3, 3, 4, 4, 5, 5, 6, 6, 7, 7, 8, 8, 9, 9, 10, 10, 11, 11, 12, 12, 13, 13 };
+const uint8_t kCodeLengthOrder[19] = { 16, 17, 18, 0, 8, 7, 9, 6, 10, 5, 11, 4, 12, 3, 13, 2, 14, 1, 15 };
+
+struct HuffCode {
+    uint16_t code = 0; // bit-reversed for LSB-first bitstream writer
+    uint8_t bits = 0;
+};
+
+struct StaticTables {
+    uint32_t crc[8][256];     // Slice-by-8
+    uint8_t lengthCode[256];  // Length - 3 -> length code index (0..28)
+    uint8_t distCode[512];    // Distance - 1 < 256: [d], else [256 + (d >> 7)]
+    HuffCode fixedLitLen[288];
+    HuffCode fixedDist[30];
+    uint8_t fixedLitLenBits[288];
+};
+
+StaticTables g_tables;
+std::once_flag g_tablesInitFlag;
+
+uint16_t ReverseBits(uint16_t v, uint8_t bitCount) {
+    uint16_t r = 0;
+    for (uint8_t i = 0; i < bitCount; i++) {
+        r = static_cast<uint16_t>((r << 1) | (v & 1u));
+        v >>= 1;
+    }
+    return r;
+}
+
+void BuildCanonicalCodes(const uint8_t* lengths, size_t count, HuffCode* out) {
+    int blCount[16] = { 0 };
+    for (size_t i = 0; i < count; i++) {
+        if (lengths[i] > 0 && lengths[i] <= 15) blCount[lengths[i]]++;
+    }
+
+    int nextCode[16] = { 0 };
+    int code = 0;
+    for (int bits = 1; bits <= 15; bits++) {
+        code = (code + blCount[bits - 1]) << 1;
+        nextCode[bits] = code;
+    }
+
+    for (size_t symbol = 0; symbol < count; symbol++) {
+        const uint8_t len = lengths[symbol];
+        out[symbol] = {};
+        if (len == 0) continue;
+        out[symbol].bits = len;
+        out[symbol].code = ReverseBits(static_cast<uint16_t>(nextCode[len]++), len);
+    }
+}
+
+const StaticTables& Tables() {
+    std::call_once(g_tablesInitFlag, []() {
+        StaticTables& t = g_tables;
+        for (uint32_t i = 0; i < 256; i++) {
+            uint32_t c = i;
+            for (int j = 0; j < 8; j++) { c = (c & 1u) ? ((c >> 1) ^ 0xEDB88320u) : (c >> 1); }
+            t.crc[0][i] = c;
+        }
+        for (int k = 1; k < 8; k++) {
+            for (uint32_t i = 0; i < 256; i++) { t.crc[k][i] = (t.crc[k - 1][i] >> 8) ^ t.crc[0][t.crc[k - 1][i] & 0xFFu]; }
+        }
+
+        for (uint8_t code = 0; code < 29; code++) {
+            for (int len = kLenBase[code]; len < kLenBase[code] + (1 << kLenExtra[code]) && len <= 258; len++) {
+                t.lengthCode[len - 3] = code;
+            }
+        }
+        for (uint8_t code = 0; code < 30; code++) {
+            for (int d = kDistBase[code] - 1; d < kDistBase[code] - 1 + (1 << kDistExtra[code]); d++) {
+                if (d < 256) {
+                    t.distCode[d] = code;
+                } else {
+                    t.distCode[256 + (d >> 7)] = code;
+                }
+            }
+        }
+
+        for (int i = 0; i <= 143; i++) t.fixedLitLenBits[i] = 8;
+        for (int i = 144; i <= 255; i++) t.fixedLitLenBits[i] = 9;
+        for (int i = 256; i <= 279; i++) t.fixedLitLenBits[i] = 7;
+        for (int i = 280; i <= 287; i++) t.fixedLitLenBits[i] = 8;
+        BuildCanonicalCodes(t.fixedLitLenBits, 288, t.fixedLitLen);
+        uint8_t distBits[30];
+        std::fill(std::begin(distBits), std::end(distBits), uint8_t{ 5 });
+        BuildCanonicalCodes(distBits, 30, t.fixedDist);
+    });
+    return g_tables;
+}
+
+// Number of leading bytes a and b share, given that the first `start` already match
+inline size_t CommonPrefixLength(const uint8_t* a, const uint8_t* b, size_t start, size_t maxLength) {
+    size_t len = start;
+    if constexpr (std::endian::native == std::endian::little) {
+        // 8 bytes per step; the lowest differing byte is the first mismatch
+        while (len + 8 <= maxLength) {
+            uint64_t wordA;
+            uint64_t wordB;
+            std::memcpy(&wordA, a + len, 8);
+            std::memcpy(&wordB, b + len, 8);
+            if (wordA != wordB) return len + (static_cast<size_t>(std::countr_zero(wordA ^ wordB)) >> 3);
+            len += 8;
+        }
+    }
+    while (len < maxLength && a[len] == b[len]) len++;
+    return len;
+}
+
+inline uint8_t DistanceCode(const StaticTables& t, size_t distance) {
+    const size_t d = distance - 1;
+    return d < 256 ? t.distCode[d] : t.distCode[256 + (d >> 7)];
+}
+
+// Huffman code lengths for `freq`, none longer than maxBits (unused symbols get 0). At least two symbols always get
+// a code, since some inflaters reject a tree with a single code.
+void BuildCodeLengths(uint32_t* freq, size_t count, int maxBits, uint8_t* lengths) {
+    struct SymFreq {
+        uint32_t key; // Frequency on input, code length on output
+        uint16_t symbol;
+    };
+
+    int used = 0;
+    for (size_t i = 0; i < count; i++) {
+        if (freq[i] > 0) used++;
+    }
+    for (size_t i = 0; used < 2 && i < count; i++) {
+        if (freq[i] == 0) {
+            freq[i] = 1;
+            used++;
+        }
+    }
+
+    SymFreq syms[288] = {};
+    int n = 0;
+    for (size_t i = 0; i < count; i++) {
+        lengths[i] = 0;
+        if (freq[i] > 0) syms[n++] = { freq[i], static_cast<uint16_t>(i) };
+    }
+    std::sort(syms, syms + n, [](const SymFreq& a, const SymFreq& b) { return a.key != b.key ? a.key < b.key : a.symbol < b.symbol; });
+
+    // In-place minimum-redundancy code lengths (Moffat & Katajainen) over the ascending frequencies
+    syms[0].key += syms[1].key;
+    int root = 0;
+    int leaf = 2;
+    for (int next = 1; next < n - 1; next++) {
+        if (leaf >= n || syms[root].key < syms[leaf].key) {
+            syms[next].key = syms[root].key;
+            syms[root++].key = static_cast<uint32_t>(next);
+        } else {
+            syms[next].key = syms[leaf++].key;
+        }
+        if (leaf >= n || (root < next && syms[root].key < syms[leaf].key)) {
+            syms[next].key += syms[root].key;
+            syms[root++].key = static_cast<uint32_t>(next);
+        } else {
+            syms[next].key += syms[leaf++].key;
+        }
+    }
+    syms[n - 2].key = 0;
+    for (int next = n - 3; next >= 0; next--) {
+        syms[next].key = syms[syms[next].key].key + 1;
+    }
+    int available = 1;
+    int depth = 0;
+    root = n - 2;
+    int next = n - 1;
+    while (available > 0) {
+        int usedAtDepth = 0;
+        while (root >= 0 && static_cast<int>(syms[root].key) == depth) {
+            usedAtDepth++;
+            root--;
+        }
+        while (available > usedAtDepth) {
+            syms[next--].key = static_cast<uint32_t>(depth);
+            available--;
+        }
+        available = 2 * usedAtDepth;
+        depth++;
+    }
+
+    // Fold anything deeper than maxBits back in, then split shorter codes until the Kraft sum is exact again
+    int numCodes[33] = { 0 };
+    for (int i = 0; i < n; i++) {
+        numCodes[std::min<int>(static_cast<int>(syms[i].key), 32)]++;
+    }
+    for (int bits = maxBits + 1; bits <= 32; bits++) {
+        numCodes[maxBits] += numCodes[bits];
+        numCodes[bits] = 0;
+    }
+    uint32_t kraft = 0;
+    for (int bits = maxBits; bits > 0; bits--) {
+        kraft += static_cast<uint32_t>(numCodes[bits]) << (maxBits - bits);
+    }
+    while (kraft != (1u << maxBits)) {
+        numCodes[maxBits]--;
+        for (int bits = maxBits - 1; bits > 0; bits--) {
+            if (numCodes[bits] != 0) {
+                numCodes[bits]--;
+                numCodes[bits + 1] += 2;
+                break;
+            }
+        }
+        kraft--;
+    }
+
+    // Shortest codes to the most frequent symbols (the end of the ascending list)
+    int j = n;
+    for (int bits = 1; bits <= maxBits; bits++) {
+        for (int k = numCodes[bits]; k > 0; k--) {
+            lengths[syms[--j].symbol] = static_cast<uint8_t>(bits);
+        }
+    }
+}
+
+} // namespace
+
+uint32_t Crc32(const uint8_t* data, size_t size, uint32_t crc) {
+    const StaticTables& t = Tables();
+    crc ^= 0xFFFFFFFFu;
+    // Slice-by-8: eight table lookups per 8 input bytes instead of a serial dependency per byte
+    while (size >= 8) {
+        const uint32_t lo = crc ^ (static_cast<uint32_t>(data[0]) | (static_cast<uint32_t>(data[1]) << 8) |
+                                   (static_cast<uint32_t>(data[2]) << 16) | (static_cast<uint32_t>(data[3]) << 24));
+        const uint32_t hi = static_cast<uint32_t>(data[4]) | (static_cast<uint32_t>(data[5]) << 8) |
+                            (static_cast<uint32_t>(data[6]) << 16) | (static_cast<uint32_t>(data[7]) << 24);
+        crc = t.crc[7][lo & 0xFFu] ^ t.crc[6][(lo >> 8) & 0xFFu] ^ t.crc[5][(lo >> 16) & 0xFFu] ^ t.crc[4][lo >> 24] ^
+              t.crc[3][hi & 0xFFu] ^ t.crc[2][(hi >> 8) & 0xFFu] ^ t.crc[1][(hi >> 16) & 0xFFu] ^ t.crc[0][hi >> 24];
+        data += 8;
+        size -= 8;
+    }
+    for (size_t i = 0; i < size; i++) { crc = t.crc[0][(crc ^ data[i]) & 0xFFu] ^ (crc >> 8); }
+    return crc ^ 0xFFFFFFFFu;
+}
+
+uint32_t Adler32(const uint8_t* data, size_t size, uint32_t adler) {
+    constexpr uint32_t kModAdler = 65521u;
+    // 5552 is the largest run that cannot overflow 32 bits before the modulo
+    constexpr size_t kMaxRun = 5552;
+    uint32_t a = adler & 0xFFFFu;
+    uint32_t b = adler >> 16;
+    while (size > 0) {
+        const size_t run = std::min(size, kMaxRun);
+        for (size_t i = 0; i < run; i++) {
+            a += data[i];
+            b += a;
+        }
+        a %= kModAdler;
+        b %= kModAdler;
+        data += run;
+        size -= run;
+    }
+    return (b << 16) | a;
+}
+
+DeflateEncoder::DeflateEncoder(int level)
+    : m_level(std::clamp(level, 0, 9)), m_window(2 * kWindowSize), m_head(size_t{ 1 } << kHashBits), m_prev(kWindowSize),
+      m_symLitLen(kMaxBlockSymbols), m_symDist(kMaxBlockSymbols) {
+    Tables();
+    m_matchLength = kMinMatch - 1;
+}
+
+void DeflateEncoder::PutBits(uint32_t value, int count, std::vector<uint8_t>& out) {
+    m_bitBuffer |= static_cast<uint64_t>(value) << m_bitCount;
+    m_bitCount += count;
+    if (m_bitCount >= 32) {
+        const uint32_t word = static_cast<uint32_t>(m_bitBuffer);
+        const uint8_t bytes[4] = { static_cast<uint8_t>(word), static_cast<uint8_t>(word >> 8), static_cast<uint8_t>(word >> 16),
+                                   static_cast<uint8_t>(word >> 24) };
+        out.insert(out.end(), bytes, bytes + 4);
+        m_bitBuffer >>= 32;
+        m_bitCount -= 32;
+    }
+}
+
+void DeflateEncoder::AlignToByte(std::vector<uint8_t>& out) {
+    while (m_bitCount > 0) {
+        out.push_back(static_cast<uint8_t>(m_bitBuffer));
+        m_bitBuffer >>= 8;
+        m_bitCount = std::max(0, m_bitCount - 8);
+    }
+    m_bitBuffer = 0;
+}
+
+void DeflateEncoder::WriteStoredBlocks(const uint8_t* data, size_t size, bool last, std::vector<uint8_t>& out) {
+    do {
+        const size_t chunk = std::min(size, kMaxStoredBlock);
+        const bool final = last && chunk == size;
+        PutBits(final ? 1u : 0u, 1, out);
+        PutBits(0b00, 2, out); // BTYPE=00 (stored)
+        AlignToByte(out);
+        const uint8_t header[4] = { static_cast<uint8_t>(chunk), static_cast<uint8_t>(chunk >> 8), static_cast<uint8_t>(~chunk),
+                                    static_cast<uint8_t>(~chunk >> 8) };
+        out.insert(out.end(), header, header + 4);
+        out.insert(out.end(), data, data + chunk);
+        data += chunk;
+        size -= chunk;
+    } while (size > 0);
+}
+
+void DeflateEncoder::Write(const uint8_t* data, size_t size, std::vector<uint8_t>& out) {
+    if (m_finished) return;
+    if (m_level == 0) {
+        // No matching, so nothing to buffer: store the chunk as is and end the stream with an empty block in Finish()
+        if (size > 0) WriteStoredBlocks(data, size, false, out);
+        return;
+    }
+
+    while (size > 0) {
+        if (m_strStart >= kWindowSize + kMaxDist) SlideWindow();
+        const size_t room = m_window.size() - m_strStart - m_lookahead;
+        const size_t n = std::min(size, room);
+        std::memcpy(m_window.data() + m_strStart + m_lookahead, data, n);
+        m_lookahead += n;
+        data += n;
+        size -= n;
+        Compress(false, out);
+    }
+}
+
+void DeflateEncoder::Finish(std::vector<uint8_t>& out) {
+    if (m_finished) return;
+    m_finished = true;
+    if (m_level == 0) {
+        WriteStoredBlocks(nullptr, 0, true, out);
+    } else {
+        Compress(true, out);
+        FlushBlock(true, out);
+    }
+    AlignToByte(out);
+}
+
+void DeflateEncoder::SlideWindow() {
+    std::memcpy(m_window.data(), m_window.data() + kWindowSize, kWindowSize);
+    m_strStart -= kWindowSize;
+    m_matchStart -= kWindowSize;
+    m_blockStart -= static_cast<ptrdiff_t>(kWindowSize);
+    // Positions that fell out of the window become 0 (no entry)
+    for (uint16_t& pos : m_head) {
+        pos = pos >= kWindowSize ? static_cast<uint16_t>(pos - kWindowSize) : 0;
+    }
+    for (uint16_t& pos : m_prev) {
+        pos = pos >= kWindowSize ? static_cast<uint16_t>(pos - kWindowSize) : 0;
+    }
+}
+
+uint16_t DeflateEncoder::InsertString(size_t pos) {
+    const uint8_t* p = m_window.data() + pos;
+    const uint32_t key = static_cast<uint32_t>(p[0]) | (static_cast<uint32_t>(p[1]) << 8) | (static_cast<uint32_t>(p[2]) << 16);
+    const size_t hash = (key * 2654435761u) >> (32 - kHashBits);
+    const uint16_t previous = m_head[hash];
+    m_prev[pos & kWindowMask] = previous;
+    m_head[hash] = static_cast<uint16_t>(pos);
+    return previous;
+}
+
+size_t DeflateEncoder::LongestMatch(size_t curMatch, size_t prevLength) {
+    const LevelConfig& config = kLevelConfigs[m_level];
+    const size_t maxLength = std::min(kMaxMatch, m_lookahead);
+    size_t bestLength = prevLength;
+    if (bestLength >= maxLength) return bestLength;
+
+    unsigned chain = config.maxChain;
+    if (prevLength >= config.goodLength) chain >>= 2;
+    const size_t niceLength = std::min<size_t>(config.niceLength, maxLength);
+    const size_t limit = m_strStart > kMaxDist ? m_strStart - kMaxDist : 0;
+    const uint8_t* window = m_window.data();
+    const uint8_t* scan = window + m_strStart;
+
+    do {
+        const uint8_t* match = window + curMatch;
+        // Cheap rejects: the byte that would extend the best match, then the first two
+        if (match[bestLength] != scan[bestLength] || match[0] != scan[0] || match[1] != scan[1]) continue;
+
+        const size_t len = CommonPrefixLength(scan, match, 2, maxLength);
+        if (len > bestLength) {
+            m_matchStart = curMatch;
+            bestLength = len;
+            if (len >= niceLength) break;
+        }
+    } while ((curMatch = m_prev[curMatch & kWindowMask]) > limit && --chain != 0);
+
+    return bestLength;
+}
+
+bool DeflateEncoder::TallyLiteral(uint8_t literal) {
+    m_symLitLen[m_symCount] = literal;
+    m_symDist[m_symCount] = 0;
+    m_symCount++;
+    m_litLenFreq[literal]++;
+    return m_symCount == kMaxBlockSymbols;
+}
+
+bool DeflateEncoder::TallyMatch(size_t distance, size_t length) {
+    const StaticTables& t = g_tables;
+    m_symLitLen[m_symCount] = static_cast<uint8_t>(length - kMinMatch);
+    m_symDist[m_symCount] = static_cast<uint16_t>(distance);
+    m_symCount++;
+    m_litLenFreq[257 + t.lengthCode[length - kMinMatch]]++;
+    m_distFreq[DistanceCode(t, distance)]++;
+    return m_symCount == kMaxBlockSymbols;
+}
+
+void DeflateEncoder::Compress(bool finish, std::vector<uint8_t>& out) {
+    if (kLevelConfigs[m_level].lazy) {
+        CompressLazy(finish, out);
+    } else {
+        CompressFast(finish, out);
+    }
+}
+
+// Levels 1-3: take the match found at each position
+void DeflateEncoder::CompressFast(bool finish, std::vector<uint8_t>& out) {
+    const LevelConfig& config = kLevelConfigs[m_level];
+    while (m_lookahead >= kMinLookahead || (finish && m_lookahead > 0)) {
+        size_t hashHead = 0;
+        if (m_lookahead >= kMinMatch) hashHead = InsertString(m_strStart);
+
+        m_matchLength = kMinMatch - 1;
+        if (hashHead != 0 && m_strStart - hashHead <= kMaxDist) m_matchLength = LongestMatch(hashHead, kMinMatch - 1);
+
+        bool flush = false;
+        if (m_matchLength >= kMinMatch) {
+            flush = TallyMatch(m_strStart - m_matchStart, m_matchLength);
+            m_lookahead -= m_matchLength;
+            if (m_matchLength <= config.maxLazy && m_lookahead >= kMinMatch) {
+                // Short match: index every position it covers
+                for (size_t i = 1; i < m_matchLength; i++) {
+                    InsertString(m_strStart + i);
+                }
+            }
+            m_strStart += m_matchLength;
+        } else {
+            flush = TallyLiteral(m_window[m_strStart]);
+            m_lookahead--;
+            m_strStart++;
+        }
+        if (flush) FlushBlock(false, out);
+    }
+}
+
+// Levels 4-9: hold each match back one byte in case the next position starts a longer one
+void DeflateEncoder::CompressLazy(bool finish, std::vector<uint8_t>& out) {
+    const LevelConfig& config = kLevelConfigs[m_level];
+    while (m_lookahead >= kMinLookahead || (finish && m_lookahead > 0)) {
+        size_t hashHead = 0;
+        if (m_lookahead >= kMinMatch) hashHead = InsertString(m_strStart);
+
+        const size_t prevLength = m_matchLength;
+        const size_t prevMatch = m_matchStart;
+        m_matchLength = kMinMatch - 1;
+        if (hashHead != 0 && prevLength < config.maxLazy && m_strStart - hashHead <= kMaxDist) {
+            m_matchLength = LongestMatch(hashHead, prevLength);
+            if (m_matchLength <= prevLength) {
+                m_matchLength = kMinMatch - 1;
+            } else if (m_matchLength == kMinMatch && m_strStart - m_matchStart > kTooFar) {
+                m_matchLength = kMinMatch - 1;
+            }
+        }
+
+        if (prevLength >= kMinMatch && m_matchLength <= prevLength) {
+            // The match from the previous byte wins; emit it and index the positions it covers
+            const size_t maxInsert = m_strStart + m_lookahead - kMinMatch;
+            const bool flush = TallyMatch(m_strStart - 1 - prevMatch, prevLength);
+            m_lookahead -= prevLength - 1;
+            for (size_t i = 0; i < prevLength - 2; i++) {
+                if (++m_strStart <= maxInsert) InsertString(m_strStart);
+            }
+            m_matchAvailable = false;
+            m_matchLength = kMinMatch - 1;
+            m_strStart++;
+            if (flush) FlushBlock(false, out);
+        } else if (m_matchAvailable) {
+            // No better match here, so the previous byte goes out as a literal
+            if (TallyLiteral(m_window[m_strStart - 1])) FlushBlock(false, out);
+            m_strStart++;
+            m_lookahead--;
+        } else {
+            m_matchAvailable = true;
+            m_strStart++;
+            m_lookahead--;
+        }
+    }
+
+    if (finish && m_matchAvailable) {
+        TallyLiteral(m_window[m_strStart - 1]);
+        m_matchAvailable = false;
+    }
+}
+
+void DeflateEncoder::FlushBlock(bool last, std::vector<uint8_t>& out) {
+    const StaticTables& t = g_tables;
+    // A byte held back by lazy matching sits at strStart and belongs to the next block
+    const size_t blockEnd = m_strStart;
+
+    m_litLenFreq[256] = 1; // End of block
+    uint32_t litLenFreq[286];
+    uint32_t distFreq[30];
+    std::copy(std::begin(m_litLenFreq), std::end(m_litLenFreq), litLenFreq);
+    std::copy(std::begin(m_distFreq), std::end(m_distFreq), distFreq);
+
+    uint8_t litLenBits[286];
+    uint8_t distBits[30];
+    BuildCodeLengths(litLenFreq, 286, 15, litLenBits);
+    BuildCodeLengths(distFreq, 30, 15, distBits);
+
+    int numLitLen = 286;
+    while (numLitLen > 257 && litLenBits[numLitLen - 1] == 0) numLitLen--;
+    int numDist = 30;
+    while (numDist > 1 && distBits[numDist - 1] == 0) numDist--;
+
+    // Run-length code the two length tables as one sequence (symbols 16-18 repeat)
+    uint8_t allBits[286 + 30];
+    std::copy(litLenBits, litLenBits + numLitLen, allBits);
+    std::copy(distBits, distBits + numDist, allBits + numLitLen);
+    const int numAll = numLitLen + numDist;
+    uint8_t rleSymbols[286 + 30];
+    uint8_t rleExtra[286 + 30];
+    int numRle = 0;
+    uint32_t codeLengthFreq[19] = {};
+    for (int i = 0; i < numAll;) {
+        const uint8_t len = allBits[i];
+        int run = 1;
+        while (i + run < numAll && allBits[i + run] == len) run++;
+        if (len == 0 && run >= 3) {
+            run = std::min(run, 138);
+            rleSymbols[numRle] = run >= 11 ? 18 : 17;
+            rleExtra[numRle++] = static_cast<uint8_t>(run >= 11 ? run - 11 : run - 3);
+        } else if (len != 0 && run >= 4) {
+            run = std::min(run, 7);
+            rleSymbols[numRle] = len;
+            rleExtra[numRle++] = 0;
+            codeLengthFreq[len]++;
+            rleSymbols[numRle] = 16;
+            rleExtra[numRle++] = static_cast<uint8_t>(run - 1 - 3);
+        } else {
+            run = 1;
+            rleSymbols[numRle] = len;
+            rleExtra[numRle++] = 0;
+        }
+        codeLengthFreq[rleSymbols[numRle - 1]]++;
+        i += run;
+    }
+
+    uint8_t codeLengthBits[19];
+    BuildCodeLengths(codeLengthFreq, 19, 7, codeLengthBits);
+    int numCodeLengths = 19;
+    while (numCodeLengths > 4 && codeLengthBits[kCodeLengthOrder[numCodeLengths - 1]] == 0) numCodeLengths--;
+
+    // Size of each encoding in bits
+    uint64_t extraBits = 0;
+    for (int code = 0; code < 29; code++) extraBits += static_cast<uint64_t>(m_litLenFreq[257 + code]) * kLenExtra[code];
+    for (int code = 0; code < 30; code++) extraBits += static_cast<uint64_t>(m_distFreq[code]) * kDistExtra[code];
+    uint64_t dynamicBits = 3 + 5 + 5 + 4 + 3 * static_cast<uint64_t>(numCodeLengths) + extraBits;
+    uint64_t fixedBits = 3 + extraBits;
+    for (int s = 0; s < 286; s++) {
+        dynamicBits += static_cast<uint64_t>(m_litLenFreq[s]) * litLenBits[s];
+        fixedBits += static_cast<uint64_t>(m_litLenFreq[s]) * t.fixedLitLenBits[s];
+    }
+    for (int s = 0; s < 30; s++) {
+        dynamicBits += static_cast<uint64_t>(m_distFreq[s]) * distBits[s];
+        fixedBits += static_cast<uint64_t>(m_distFreq[s]) * 5;
+    }
+    for (int s = 0; s < 19; s++) dynamicBits += static_cast<uint64_t>(codeLengthFreq[s]) * codeLengthBits[s];
+    dynamicBits += static_cast<uint64_t>(codeLengthFreq[16]) * 2 + static_cast<uint64_t>(codeLengthFreq[17]) * 3 +
+                   static_cast<uint64_t>(codeLengthFreq[18]) * 7;
+
+    const size_t storedLength = blockEnd - static_cast<size_t>(std::max<ptrdiff_t>(m_blockStart, 0));
+    const uint64_t storedBits = (storedLength / kMaxStoredBlock + 1) * 40 + 7 + static_cast<uint64_t>(storedLength) * 8;
+
+    if (m_blockStart >= 0 && storedBits < std::min(dynamicBits, fixedBits)) {
+        WriteStoredBlocks(m_window.data() + m_blockStart, storedLength, last, out);
+    } else {
+        HuffCode dynLitLen[286];
+        HuffCode dynDist[30];
+        const HuffCode* litLenCodes = t.fixedLitLen;
+        const HuffCode* distCodes = t.fixedDist;
+        PutBits(last ? 1u : 0u, 1, out);
+        if (fixedBits <= dynamicBits) {
+            PutBits(0b01, 2, out); // BTYPE=01 (fixed)
+        } else {
+            PutBits(0b10, 2, out); // BTYPE=10 (dynamic)
+            PutBits(static_cast<uint32_t>(numLitLen - 257), 5, out);
+            PutBits(static_cast<uint32_t>(numDist - 1), 5, out);
+            PutBits(static_cast<uint32_t>(numCodeLengths - 4), 4, out);
+            for (int i = 0; i < numCodeLengths; i++) PutBits(codeLengthBits[kCodeLengthOrder[i]], 3, out);
+
+            HuffCode codeLengthCodes[19];
+            BuildCanonicalCodes(codeLengthBits, 19, codeLengthCodes);
+            static const int kRleExtraBits[3] = { 2, 3, 7 };
+            for (int i = 0; i < numRle; i++) {
+                const HuffCode& hc = codeLengthCodes[rleSymbols[i]];
+                PutBits(hc.code, hc.bits, out);
+                if (rleSymbols[i] >= 16) PutBits(rleExtra[i], kRleExtraBits[rleSymbols[i] - 16], out);
+            }
+
+            BuildCanonicalCodes(litLenBits, 286, dynLitLen);
+            BuildCanonicalCodes(distBits, 30, dynDist);
+            litLenCodes = dynLitLen;
+            distCodes = dynDist;
+        }
+
+        for (size_t i = 0; i < m_symCount; i++) {
+            const uint16_t distance = m_symDist[i];
+            if (distance == 0) {
+                const HuffCode& hc = litLenCodes[m_symLitLen[i]];
+                PutBits(hc.code, hc.bits, out);
+                continue;
+            }
+            const uint8_t lenCode = t.lengthCode[m_symLitLen[i]];
+            const HuffCode& lenH = litLenCodes[257 + lenCode];
+            PutBits(lenH.code, lenH.bits, out);
+            if (kLenExtra[lenCode] > 0) PutBits(m_symLitLen[i] + kMinMatch - kLenBase[lenCode], kLenExtra[lenCode], out);
+
+            const uint8_t distCode = DistanceCode(t, distance);
+            const HuffCode& distH = distCodes[distCode];
+            PutBits(distH.code, distH.bits, out);
+            if (kDistExtra[distCode] > 0) PutBits(distance - kDistBase[distCode], kDistExtra[distCode], out);
+        }
+        const HuffCode& eob = litLenCodes[256];
+        PutBits(eob.code, eob.bits, out);
+    }
+
+    m_blockStart = static_cast<ptrdiff_t>(blockEnd);
+    m_symCount = 0;
+    std::fill(std::begin(m_litLenFreq), std::end(m_litLenFreq), 0u);
+    std::fill(std::begin(m_distFreq), std::end(m_distFreq), 0u);
+}
+
+bool DeflateCompress(const uint8_t* data, size_t size, std::vector<uint8_t>& out, int level) {
+    DeflateEncoder encoder(level);
+    encoder.Write(data, size, out);
+    encoder.Finish(out);
+    return true;
+}
+
+bool ZlibCompress(const uint8_t* data, size_t size, std::vector<uint8_t>& out, int level) {
+    // CMF = deflate with a 32K window, FLG = default level with the check bits making CMF*256+FLG a multiple of 31
+    out.push_back(0x78);
+    out.push_back(0x9C);
+    if (!DeflateCompress(data, size, out, level)) return false;
+    const uint32_t adler = Adler32(data, size);
+    out.push_back(static_cast<uint8_t>(adler >> 24));
+    out.push_back(static_cast<uint8_t>(adler >> 16));
+    out.push_back(static_cast<uint8_t>(adler >> 8));
+    out.push_back(static_cast<uint8_t>(adler));
+    return true;
+}
+
+bool CompressFileToGzip(const std::filesystem::path& srcPath, const std::filesystem::path& dstPath, const std::atomic<bool>* cancel) {
+    std::error_code ec;
+    if (!std::filesystem::is_regular_file(srcPath, ec)) return false;
+
+    std::ifstream in(srcPath, std::ios::binary);
+    if (!in.is_open()) return false;
+
+    std::filesystem::path tempPath = dstPath;
+    tempPath += ".tmp";
+    std::ofstream out(tempPath, std::ios::binary | std::ios::trunc);
+    if (!out.is_open()) return false;
+
+    // Gzip header (RFC 1952): deflate, no flags, no mtime
+#ifdef _WIN32
+    const uint8_t os = 0x0B; // NTFS
+#else
+    const uint8_t os = 0x03; // Unix
+#endif
+    const uint8_t hdr[10] = { 0x1F, 0x8B, 0x08, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, os };
+    out.write(reinterpret_cast<const char*>(hdr), sizeof(hdr));
+
+    // Streamed in fixed-size chunks, so memory use doesn't depend on the file size
+    constexpr size_t kChunkSize = 256 * 1024;
+    std::vector<uint8_t> chunk(kChunkSize);
+    std::vector<uint8_t> deflate;
+    deflate.reserve(kChunkSize);
+    DeflateEncoder encoder;
+    uint32_t crc = 0;
+    uint64_t totalSize = 0;
+    bool cancelled = false;
+    while (in && out) {
+        if (cancel && cancel->load(std::memory_order_relaxed)) {
+            cancelled = true;
+            break;
+        }
+        in.read(reinterpret_cast<char*>(chunk.data()), static_cast<std::streamsize>(chunk.size()));
+        const size_t n = static_cast<size_t>(in.gcount());
+        if (n == 0) break;
+        crc = Crc32(chunk.data(), n, crc);
+        totalSize += n;
+        deflate.clear();
+        encoder.Write(chunk.data(), n, deflate);
+        if (!deflate.empty()) out.write(reinterpret_cast<const char*>(deflate.data()), static_cast<std::streamsize>(deflate.size()));
+    }
+    const bool readFailed = in.bad();
+    in.close();
+
+    if (!cancelled) {
+        deflate.clear();
+        encoder.Finish(deflate);
+        const uint32_t isize = static_cast<uint32_t>(totalSize & 0xFFFFFFFFu);
+        for (uint32_t v : { crc, isize }) {
+            for (int shift = 0; shift < 32; shift += 8) deflate.push_back(static_cast<uint8_t>(v >> shift));
+        }
+        out.write(reinterpret_cast<const char*>(deflate.data()), static_cast<std::streamsize>(deflate.size()));
+        out.flush();
+    }
+    const bool good = !cancelled && out.good() && !readFailed;
+    out.close();
+    if (good) std::filesystem::rename(tempPath, dstPath, ec);
+    if (!good || ec) {
+        std::filesystem::remove(tempPath, ec);
+        return false;
+    }
+    return true;
+}
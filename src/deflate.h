@@ -0,0 +1,81 @@
+#pragma once
+
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <filesystem>
+#include <vector>
+
+// In-process DEFLATE (RFC 1951) encoder plus the zlib / gzip checksums, no external libraries. Platform-neutral.
+// Used for gzip log and config backups and for compressed PDF content streams.
+
+// Levels as in zlib: 0 stores, 1-3 take the first match that is good enough, 4-9 search longer chains and defer to
+// a better match starting one byte later
+constexpr int kDeflateDefaultLevel = 6;
+
+// Checksums; pass the previous result to continue over the next chunk
+uint32_t Crc32(const uint8_t* data, size_t size, uint32_t crc = 0);
+uint32_t Adler32(const uint8_t* data, size_t size, uint32_t adler = 1);
+
+// Streaming encoder with a fixed footprint (about 250 KB) whatever the input size. Input may arrive in chunks of any
+// size; each block goes out as fixed Huffman, dynamic Huffman or stored, whichever is smallest.
+class DeflateEncoder {
+  public:
+    explicit DeflateEncoder(int level = kDeflateDefaultLevel);
+
+    // Compresses `size` bytes; completed output is appended to `out` (some input is held back for matching)
+    void Write(const uint8_t* data, size_t size, std::vector<uint8_t>& out);
+
+    // Compresses the rest and ends the stream. Further writes are ignored.
+    void Finish(std::vector<uint8_t>& out);
+
+  private:
+    void Compress(bool finish, std::vector<uint8_t>& out);
+    void CompressFast(bool finish, std::vector<uint8_t>& out);
+    void CompressLazy(bool finish, std::vector<uint8_t>& out);
+    void SlideWindow();
+    uint16_t InsertString(size_t pos);
+    size_t LongestMatch(size_t curMatch, size_t prevLength);
+    bool TallyLiteral(uint8_t literal);
+    bool TallyMatch(size_t distance, size_t length);
+    void FlushBlock(bool last, std::vector<uint8_t>& out);
+    void WriteStoredBlocks(const uint8_t* data, size_t size, bool last, std::vector<uint8_t>& out);
+    void PutBits(uint32_t value, int count, std::vector<uint8_t>& out);
+    void AlignToByte(std::vector<uint8_t>& out);
+
+    int m_level = kDeflateDefaultLevel;
+    bool m_finished = false;
+
+    // Two 32 KB halves; the upper half slides down once the scan position passes it
+    std::vector<uint8_t> m_window;
+    std::vector<uint16_t> m_head; // Hash of the next 3 bytes -> most recent window position (0 = none)
+    std::vector<uint16_t> m_prev; // Window position & 32K mask -> previous position with the same hash
+    size_t m_strStart = 0;
+    size_t m_lookahead = 0;
+    ptrdiff_t m_blockStart = 0; // Negative once the block's first bytes have slid out of the window
+    size_t m_matchStart = 0;
+    size_t m_matchLength = 0;
+    bool m_matchAvailable = false;
+
+    // Symbols of the block being built: literal or length - 3, plus distance (0 for a literal)
+    std::vector<uint8_t> m_symLitLen;
+    std::vector<uint16_t> m_symDist;
+    size_t m_symCount = 0;
+    uint32_t m_litLenFreq[286] = {};
+    uint32_t m_distFreq[30] = {};
+
+    uint64_t m_bitBuffer = 0;
+    int m_bitCount = 0;
+};
+
+// Raw DEFLATE stream, appended to `out`
+bool DeflateCompress(const uint8_t* data, size_t size, std::vector<uint8_t>& out, int level = kDeflateDefaultLevel);
+
+// zlib stream (RFC 1950: header, DEFLATE data, Adler-32), appended to `out`. This is what PDF /FlateDecode expects.
+bool ZlibCompress(const uint8_t* data, size_t size, std::vector<uint8_t>& out, int level = kDeflateDefaultLevel);
+
+// Compresses a file into a gzip file (RFC 1952), streaming it in fixed-size chunks. The output is written to
+// `dstPath` + ".tmp" and renamed over `dstPath` once complete, so a failed or cancelled run leaves no partial file.
+// `cancel` is polled between chunks.
+bool CompressFileToGzip(const std::filesystem::path& srcPath, const std::filesystem::path& dstPath,
+                        const std::atomic<bool>* cancel = nullptr);
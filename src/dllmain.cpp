@@ -1,9 +1,12 @@
+#include "config_autosave.h"
 #include "fake_cursor.h"
 #include "gui.h"
 #include "imgui_cache.h"
 #include "input_hook.h"
 #include "logic_thread.h"
 #include "mirror_thread.h"
+#include "notes_index.h"
+#include "notes_persistence.h"
 #include "obs_thread.h"
 #include "profiler.h"
 #include "render.h"
@@ -41,7 +44,6 @@
 #pragma comment(lib, "libglew32.lib")
 #pragma comment(lib, "DbgHelp.lib")
 
-#define STB_IMAGE_IMPLEMENTATION
 #include "imgui_impl_opengl3.h"
 #include "imgui_impl_win32.h"
 #include "stb_image.h"
@@ -61,6 +63,7 @@ static std::mutex g_configSnapshotMutex; // Only held briefly by publisher
 
 void PublishConfigSnapshot() {
     auto snapshot = std::make_shared<const Config>(g_config);
+    SetLogCategoryMask(LogCategoryMaskFromConfig(snapshot->debug));
     std::lock_guard<std::mutex> lock(g_configSnapshotMutex);
     g_configSnapshot = std::move(snapshot);
 }
@@ -299,7 +302,7 @@ template <typename T> bool CreateHookOrDie(LPVOID pTarget, LPVOID pDetour, T** p
         Log(errorMsg);
         return false;
     }
-    LogCategory("init", "Created hook for " + std::string(hookName));
+    LogCategory(LogCategoryId::Init, "Created hook for " + std::string(hookName));
     return true;
 }
 
@@ -371,7 +374,7 @@ void SaveOriginalWindowsMouseSpeed() {
     int currentSpeed = 0;
     if (SystemParametersInfo(SPI_GETMOUSESPEED, 0, &currentSpeed, 0)) {
         g_originalWindowsMouseSpeed = currentSpeed;
-        LogCategory("init", "Saved original Windows mouse speed: " + std::to_string(currentSpeed));
+        LogCategory(LogCategoryId::Init, "Saved original Windows mouse speed: " + std::to_string(currentSpeed));
     } else {
         Log("WARNING: Failed to get current Windows mouse speed");
         g_originalWindowsMouseSpeed = 10; // Default to middle value
@@ -423,9 +426,9 @@ void SaveOriginalKeyRepeatSettings() {
     g_originalFilterKeys.cbSize = sizeof(FILTERKEYS);
     if (SystemParametersInfo(SPI_GETFILTERKEYS, sizeof(FILTERKEYS), &g_originalFilterKeys, 0)) {
         g_originalFilterKeysCaptured.store(true);
-        LogCategory("init", "Saved original FILTERKEYS: flags=0x" + std::to_string(g_originalFilterKeys.dwFlags) +
-                                ", iDelayMSec=" + std::to_string(g_originalFilterKeys.iDelayMSec) +
-                                ", iRepeatMSec=" + std::to_string(g_originalFilterKeys.iRepeatMSec));
+        LogCategory(LogCategoryId::Init, "Saved original FILTERKEYS: flags=0x" + std::to_string(g_originalFilterKeys.dwFlags) +
+                                             ", iDelayMSec=" + std::to_string(g_originalFilterKeys.iDelayMSec) +
+                                             ", iRepeatMSec=" + std::to_string(g_originalFilterKeys.iRepeatMSec));
     } else {
         Log("WARNING: Failed to get current FILTERKEYS settings");
         // Initialize with defaults
@@ -768,7 +771,7 @@ void WINAPI hkglClear(GLbitfield mask) {
                     if (MH_CreateHook(pFunc, &hkglBlitNamedFramebuffer, reinterpret_cast<void**>(&oglBlitNamedFramebuffer)) == MH_OK) {
                         if (MH_EnableHook(pFunc) == MH_OK) {
                             glBlitNamedFramebufferHooked = true;
-                            LogCategory("init", "Successfully hooked glBlitNamedFramebuffer via GLEW");
+                            LogCategory(LogCategoryId::Init, "Successfully hooked glBlitNamedFramebuffer via GLEW");
                         } else {
                             Log("ERROR: Failed to enable glBlitNamedFramebuffer hook");
                         }
@@ -1193,7 +1196,7 @@ BOOL WINAPI hkwglSwapBuffers(HDC hDc) {
             PROFILE_SCOPE_CAT("GLEW Initialization", "SwapBuffers");
             glewExperimental = GL_TRUE;
             if (glewInit() == GLEW_OK) {
-                LogCategory("init", "[RENDER] GLEW Initialized successfully.");
+                LogCategory(LogCategoryId::Init, "[RENDER] GLEW Initialized successfully.");
                 g_glewLoaded = true;
 
                 // Record the initial context used for sharing.
@@ -1210,7 +1213,8 @@ BOOL WINAPI hkwglSwapBuffers(HDC hDc) {
                 HGLRC currentContext = wglGetCurrentContext();
                 if (currentContext) {
                     if (InitializeSharedContexts(currentContext, hDc)) {
-                        LogCategory("init", "[RENDER] Shared contexts initialized - GPU texture sharing enabled for all threads");
+                        LogCategory(LogCategoryId::Init,
+                                    "[RENDER] Shared contexts initialized - GPU texture sharing enabled for all threads");
                     } else {
                         Log("[RENDER] Shared context initialization failed - starting worker threads in fallback mode");
                     }
@@ -1793,6 +1797,8 @@ void main() {
         // Enable/disable profiler based on config
         Profiler::GetInstance().SetEnabled(showProfiler);
         if (showProfiler) { Profiler::GetInstance().MarkAsRenderThread(); }
+        // Named every frame, not just with the overlay on: a trace capture records this thread either way
+        Profiler::GetInstance().SetThreadName("Game Thread");
 
         ModeConfig modeToRenderCopy;
         bool modeFound = false;
@@ -1922,7 +1928,7 @@ void main() {
                     submission.context.gameW = current_gameW;
                     submission.context.gameH = current_gameH;
                     submission.context.gameTextureId = g_cachedGameTextureId.load();
-                    submission.context.modeId = modeToRenderCopy.id;
+                    submission.context.mode = InternModeId(modeToRenderCopy.id);
                     submission.context.relativeStretching = modeToRenderCopy.relativeStretching;
                     submission.context.bgR = modeToRenderCopy.background.color.r;
                     submission.context.bgG = modeToRenderCopy.background.color.g;
@@ -2116,9 +2122,9 @@ BOOL APIENTRY DllMain(HMODULE hModule, DWORD ul_reason_for_call, LPVOID lpReserv
         InstallGlobalExceptionHandlers();
 
         // Verify logging works immediately
-        LogCategory("init", "========================================");
-        LogCategory("init", "=== Toolscreen INITIALIZATION START ===");
-        LogCategory("init", "========================================");
+        LogCategory(LogCategoryId::Init, "========================================");
+        LogCategory(LogCategoryId::Init, "=== Toolscreen INITIALIZATION START ===");
+        LogCategory(LogCategoryId::Init, "========================================");
         PrintVersionToStdout();
 
         // Create high-resolution waitable timer for FPS limiting (Windows 10 1803+)
@@ -2128,7 +2134,7 @@ BOOL APIENTRY DllMain(HMODULE hModule, DWORD ul_reason_for_call, LPVOID lpReserv
                                                 TIMER_ALL_ACCESS                       // Full access
         );
         if (g_highResTimer) {
-            LogCategory("init", "High-resolution waitable timer created successfully for FPS limiting.");
+            LogCategory(LogCategoryId::Init, "High-resolution waitable timer created successfully for FPS limiting.");
         } else {
             Log("Warning: Failed to create high-resolution waitable timer. FPS limiting may be less precise.");
         }
@@ -2142,82 +2148,16 @@ BOOL APIENTRY DllMain(HMODULE hModule, DWORD ul_reason_for_call, LPVOID lpReserv
             // Path to latest.log
             std::wstring latestLogPath = logsDir + L"\\latest.log";
 
-            // If latest.log exists, rename it to timestamped filename
-            if (GetFileAttributesW(latestLogPath.c_str()) != INVALID_FILE_ATTRIBUTES) {
-                // Get file last write time (not creation time - creation time stays the same
-                // across sessions, causing archived logs to have incorrect/stale dates)
-                HANDLE hFile =
-                    CreateFileW(latestLogPath.c_str(), GENERIC_READ, FILE_SHARE_READ, NULL, OPEN_EXISTING, FILE_ATTRIBUTE_NORMAL, NULL);
-                if (hFile != INVALID_HANDLE_VALUE) {
-                    FILETIME lastWriteTime;
-                    if (GetFileTime(hFile, NULL, NULL, &lastWriteTime)) {
-                        // Convert to local time first, then to system time
-                        // This ensures the timestamp reflects the user's timezone
-                        FILETIME localFileTime;
-                        FileTimeToLocalFileTime(&lastWriteTime, &localFileTime);
-                        SYSTEMTIME st;
-                        FileTimeToSystemTime(&localFileTime, &st);
-
-                        // Format: YYYYMMDD_HHMMSS
-                        WCHAR timestamp[32];
-                        swprintf_s(timestamp, L"%04d%02d%02d_%02d%02d%02d", st.wYear, st.wMonth, st.wDay, st.wHour, st.wMinute, st.wSecond);
-
-                        std::wstring archivedLogPath = logsDir + L"\\" + timestamp + L".log";
-
-                        // Close handle before moving
-                        CloseHandle(hFile);
-
-                        // Check if archive path already exists (same second collision)
-                        // If so, append a counter
-                        if (GetFileAttributesW(archivedLogPath.c_str()) != INVALID_FILE_ATTRIBUTES) {
-                            for (int counter = 1; counter < 100; counter++) {
-                                std::wstring altPath = logsDir + L"\\" + timestamp + L"_" + std::to_wstring(counter) + L".log";
-                                if (GetFileAttributesW(altPath.c_str()) == INVALID_FILE_ATTRIBUTES) {
-                                    archivedLogPath = altPath;
-                                    break;
-                                }
-                            }
-                        }
-
-                        // Rename the file
-                        if (!MoveFileW(latestLogPath.c_str(), archivedLogPath.c_str())) {
-                            // If rename fails, DON'T delete - log a warning and the file will be
-                            // overwritten when the new latest.log is opened (data preserved until then)
-                            // This is better than losing all the log data
-                            Log("WARNING: Could not rename old log to " + WideToUtf8(archivedLogPath) +
-                                ", error code: " + std::to_string(GetLastError()));
-                        } else {
-                            // Compress the archived log to .gz on a background thread
-                            // so we don't block DLL initialization
-                            std::wstring archiveSrc = archivedLogPath;
-                            std::thread([archiveSrc]() {
-                                std::wstring gzPath = archiveSrc + L".gz";
-                                if (CompressFileToGzip(archiveSrc, gzPath)) {
-                                    // Compression succeeded - delete the uncompressed file
-                                    DeleteFileW(archiveSrc.c_str());
-                                }
-                                // If compression fails, keep the uncompressed .log as fallback
-                            }).detach();
-                        }
-                    } else {
-                        CloseHandle(hFile);
-                    }
-                }
-            }
-            // Note: If latest.log doesn't exist, that's fine - this is normal for first run
-
-            // Open new latest.log
-            {
-                std::lock_guard<std::mutex> lock(g_logFileMutex);
-                logFile.open(latestLogPath, std::ios_base::out | std::ios_base::trunc);
-            }
+            // Archives the previous session's latest.log (compressed in the background) and opens a fresh one.
+            // From here on latest.log is rotated by size and age; see log_rotation.h.
+            OpenLogFile(latestLogPath);
 
             // Start async logging thread now that log file is open
             StartLogThread();
 
             g_modeFilePath = g_toolscreenPath + L"\\mode.txt";
         }
-        LogCategory("init", "--- DLL instance attached ---");
+        LogCategory(LogCategoryId::Init, "--- DLL instance attached ---");
         LogVersionInfo(); // Log version information
         if (g_toolscreenPath.empty()) { Log("FATAL: Could not get toolscreen directory."); }
 
@@ -2236,25 +2176,26 @@ BOOL APIENTRY DllMain(HMODULE hModule, DWORD ul_reason_for_call, LPVOID lpReserv
             } else {
                 oss << " is outside supported range [1.16.1 - 1.18.2].";
             }
-            LogCategory("init", oss.str());
+            LogCategory(LogCategoryId::Init, oss.str());
         } else {
             // No version detected - enable hook by default for backward compatibility
-            LogCategory("init", "No game version detected from command line.");
+            LogCategory(LogCategoryId::Init, "No game version detected from command line.");
         }
 
+        StartConfigAutosaveThread();
         LoadConfig();
 
         WCHAR dir[MAX_PATH];
         if (GetCurrentDirectoryW(MAX_PATH, dir) > 0) {
             g_stateFilePath = std::wstring(dir) + L"\\wpstateout.txt";
-            LogCategory("init", "State file path set to: " + WideToUtf8(g_stateFilePath));
+            LogCategory(LogCategoryId::Init, "State file path set to: " + WideToUtf8(g_stateFilePath));
 
             DWORD stateFileAttrs = GetFileAttributesW(g_stateFilePath.c_str());
             bool stateOutputAvailable = (stateFileAttrs != INVALID_FILE_ATTRIBUTES) && !(stateFileAttrs & FILE_ATTRIBUTE_DIRECTORY);
             g_isStateOutputAvailable.store(stateOutputAvailable, std::memory_order_release);
             if (!stateOutputAvailable) {
                 LogCategory(
-                    "init",
+                    LogCategoryId::Init,
                     "WARNING: wpstateout.txt not found. Game-state hotkey restrictions will not apply until State Output is installed.");
             }
         } else {
@@ -2274,7 +2215,7 @@ BOOL APIENTRY DllMain(HMODULE hModule, DWORD ul_reason_for_call, LPVOID lpReserv
             return TRUE;
         }
 
-        LogCategory("init", "Setting up hooks...");
+        LogCategory(LogCategoryId::Init, "Setting up hooks...");
 
         // Get function addresses
         HMODULE hOpenGL32 = GetModuleHandle(L"opengl32.dll");
@@ -2288,7 +2229,7 @@ BOOL APIENTRY DllMain(HMODULE hModule, DWORD ul_reason_for_call, LPVOID lpReserv
         if (IsVersionInRange(g_gameVersion, GameVersion(1, 0, 0), GameVersion(1, 21, 0))) {
             if (HOOK(hOpenGL32, glViewport)) {
                 g_glViewportHookCount.fetch_add(1);
-                LogCategory("init", "Initial glViewport hook created via opengl32.dll");
+                LogCategory(LogCategoryId::Init, "Initial glViewport hook created via opengl32.dll");
             }
         }
         HOOK(hOpenGL32, glClear);
@@ -2304,7 +2245,7 @@ BOOL APIENTRY DllMain(HMODULE hModule, DWORD ul_reason_for_call, LPVOID lpReserv
         if (pGlBlitNamedFramebuffer != NULL) {
             CreateHookOrDie(pGlBlitNamedFramebuffer, &hkglBlitNamedFramebuffer, &oglBlitNamedFramebuffer, "glBlitNamedFramebuffer");
         } else {
-            LogCategory("init",
+            LogCategory(LogCategoryId::Init,
                         "WARNING: glBlitNamedFramebuffer not found in opengl32.dll - will attempt to hook via GLEW after context init");
         }
 
@@ -2313,7 +2254,7 @@ BOOL APIENTRY DllMain(HMODULE hModule, DWORD ul_reason_for_call, LPVOID lpReserv
             return TRUE;
         }
 
-        LogCategory("init", "Hooks enabled.");
+        LogCategory(LogCategoryId::Init, "Hooks enabled.");
 
         // Save the original Windows mouse speed so we can restore it on exit
         SaveOriginalWindowsMouseSpeed();
@@ -2354,6 +2295,7 @@ BOOL APIENTRY DllMain(HMODULE hModule, DWORD ul_reason_for_call, LPVOID lpReserv
         RestoreKeyRepeatSettings();
 
         SaveConfigImmediate();
+        StopConfigAutosaveThread();
         Log("Config saved.");
 
         // Stop monitoring threads
@@ -2365,6 +2307,9 @@ BOOL APIENTRY DllMain(HMODULE hModule, DWORD ul_reason_for_call, LPVOID lpReserv
 
         // Stop background threads
         StopWindowCaptureThread();
+        StopNotesPersistenceThread();
+        StopNotesIndexThread();
+        StopImageDecodePool();
 
         // Cleanup shared OpenGL contexts
         CleanupSharedContexts();
@@ -2374,9 +2319,6 @@ BOOL APIENTRY DllMain(HMODULE hModule, DWORD ul_reason_for_call, LPVOID lpReserv
         // Clean up CPU-allocated memory that won't be freed by Windows
         {
             std::lock_guard<std::mutex> lock(g_decodedImagesMutex);
-            for (auto& decodedImg : g_decodedImagesQueue) {
-                if (decodedImg.data) { stbi_image_free(decodedImg.data); }
-            }
             g_decodedImagesQueue.clear();
         }
 
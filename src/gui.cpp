@@ -1,4 +1,6 @@
 ﻿#include "gui.h"
+#include "boat_eye_recommender.h"
+#include "config_autosave.h"
 #include "config_toml.h"
 #include "expression_parser.h"
 #include "fake_cursor.h"
@@ -26,6 +28,7 @@
 #include <atomic>
 #include <cctype>
 #include <chrono>
+#include <cmath>
 #include <commdlg.h>
 #include <cstring>
 #include <cstdio>
@@ -53,9 +56,6 @@ extern std::atomic<bool> g_gameWindowActive;
 static constexpr float spinnerHoldDelay = 0.2f;     // Delay before repeat starts (in seconds)
 static constexpr float spinnerHoldInterval = 0.01f; // Interval between repeats (in seconds)
 
-// Track background save status
-static std::atomic<bool> s_isConfigSaving{ false };
-
 // IMAGE VALIDATION AND FILE PICKER HELPERS
 // State for async file picker results
 struct ImagePickerResult {
@@ -801,6 +801,73 @@ static BoatSetupScriptRunResult RunBoatSetupRestoreScript(const std::wstring& to
     return result;
 }
 
+// Boat-eye table bundled next to the calibration script. Loaded once; the GUI thread is the only caller.
+static const BoatEyeSensitivityTable* GetBoatEyeSensitivityTable(const std::wstring& toolscreenPath, std::string& outError) {
+    static bool s_attempted = false;
+    static BoatEyeSensitivityTable s_table;
+    static std::string s_error;
+    if (!s_attempted) {
+        s_attempted = true;
+        std::filesystem::path scriptPath;
+        std::string searchedPaths;
+        if (TryResolveBoatCalibrationScriptPath(toolscreenPath, scriptPath, searchedPaths)) {
+            const std::filesystem::path tablePath =
+                scriptPath.parent_path() / L"resources" / L"boat_eye_senses" / L"boatEyeSensitivitiesv1_16.txt";
+            if (LoadBoatEyeSensitivityTable(tablePath, s_table, s_error)) {
+                Log("Boat setup: loaded " + std::to_string(s_table.sensitivity.size()) + " boat-eye sensitivities from " +
+                    WideToUtf8(tablePath.wstring()));
+            } else {
+                Log("Boat setup: " + s_error);
+            }
+        } else {
+            s_error = "Boat calibration script not found. Searched:\n" + searchedPaths;
+        }
+    }
+    outError = s_error;
+    return s_table.IsValid() ? &s_table : nullptr;
+}
+
+static nlohmann::json BoatEyeCandidateToJson(const BoatEyeCandidate& c) {
+    nlohmann::json row;
+    row["Rank"] = c.rank;
+    row["TargetDpiRaw"] = c.targetDpiRaw;
+    row["TargetDpiRounded"] = c.targetDpiRounded;
+    row["TargetCursorSpeed"] = c.targetCursorSpeed;
+    row["RawSensitivity"] = c.rawSensitivity;
+    row["PrimarySensitivity"] = c.primarySensitivity;
+    row["SecondarySensitivity"] = c.HasSecondary() ? nlohmann::json(c.secondarySensitivity) : nlohmann::json();
+    row["SelectedSensitivity"] = c.selectedSensitivity;
+    row["EstimatedPixelSkipping"] = c.pixelSkipping;
+    row["SpeedDeltaFromPreference"] = c.speedDelta;
+    // Rounded like the script's CandidateChoices rows
+    row["SensitivityDelta"] = std::nearbyint(c.sensitivityDelta * 1e8) / 1e8;
+    row["SensitivityDeltaPercent"] = std::nearbyint(c.sensitivityDelta * 200.0 * 100.0) / 100.0;
+    row["ExploreScore"] = std::nearbyint(c.exploreScore * 1e6) / 1e6;
+    return row;
+}
+
+// Shapes a native recommendation like the script's recommendations.active object so the Boat tab can render either.
+static nlohmann::json BoatEyeRecommendationToJson(const BoatEyeRecommendation& rec, const BoatSetupConfig& cfg, const char* source) {
+    nlohmann::json active = BoatEyeCandidateToJson(rec.active);
+    active.erase("Rank");
+    active["Source"] = source;
+    active["SelectionPolicy"] = rec.selectionPolicy;
+    active["RecommendationChoice"] = rec.recommendationChoice;
+    active["RecommendationChoiceMax"] = rec.recommendationChoiceMax;
+    active["LowestSkipChoiceOne"] = cfg.lowestSkipChoiceOne;
+    active["IncludeCursorInRanking"] = cfg.includeCursorInRanking;
+    active["PreferHigherDpi"] = cfg.preferHigherDpi;
+    active["MaxRecommendedPixelSkipping"] = rec.maxRecommendedPixelSkipping;
+    active["SkipFilterIgnored"] = rec.skipFilterIgnored;
+    active["CursorSpeedPreference"] = rec.cursorSpeedPreference;
+    active["ClosestFeelPixelSkipping"] = rec.closestFeelPixelSkipping;
+    active["LowestPixelSkipping"] = rec.lowestPixelSkipping;
+    nlohmann::json choices = nlohmann::json::array();
+    for (const auto& c : rec.choices) { choices.push_back(BoatEyeCandidateToJson(c)); }
+    active["CandidateChoices"] = std::move(choices);
+    return active;
+}
+
 static bool ApplyVisualEffectsDirectFallback(const BoatSetupConfig& cfg, std::string& outError, std::wstring* outOptionsPath = nullptr,
                                              std::wstring* outStandardSettingsPath = nullptr, std::wstring* outExtraOptionsPath = nullptr,
                                              bool* outUpdatedStandardSettings = nullptr, bool* outUpdatedExtraOptions = nullptr);
@@ -1798,120 +1865,39 @@ error_case:
 }
 
 void SaveConfig() {
-    PROFILE_SCOPE_CAT("Config Save", "IO Operations");
-
-    // Throttle saves: only save if config is dirty AND at least 1 second has passed
-    static auto s_lastSaveTime = std::chrono::steady_clock::now();
-
-    auto currentTime = std::chrono::steady_clock::now();
-    auto timeSinceLastSave = std::chrono::duration_cast<std::chrono::milliseconds>(currentTime - s_lastSaveTime).count();
-
+    // Cheap enough to call every frame: publishing the snapshot and queueing it is all that happens here.
+    // The autosave worker debounces bursts of edits and does the serialization and disk I/O.
     if (!g_configIsDirty.load()) {
         return; // Nothing changed, skip save
     }
 
-    if (timeSinceLastSave < 1000) {
-        return; // Less than 1 second since last save, skip
-    }
-
-    if (s_isConfigSaving.load()) {
-        return; // Save in progress, skip
-    }
-
     if (g_toolscreenPath.empty()) {
         Log("ERROR: Cannot save config, toolscreen path is not available.");
         return;
     }
     std::wstring configPath = g_toolscreenPath + L"\\config.toml";
     try {
-        // Snapshot config and convert to TOML (thread-safe for detached write thread)
-        toml::table tbl;
-        ConfigToToml(g_config, tbl);
-
-        // Publish updated config snapshot for reader threads (RCU pattern)
+        // Publish updated config snapshot for reader threads (RCU pattern).
+        // The snapshot is immutable, so the autosave worker serializes it without touching g_config.
         PublishConfigSnapshot();
-
         g_configIsDirty = false;
-        s_lastSaveTime = currentTime;
-        s_isConfigSaving = true;
-
-        std::thread([configPath, tbl = std::move(tbl)]() {
-            _set_se_translator(SEHTranslator);
-            try {
-                try {
-                    std::string narrowPath = WideToUtf8(configPath);
-                    std::ofstream o(narrowPath);
-                    if (!o.is_open()) {
-                        Log("ERROR: Failed to open config file for writing.");
-                    } else {
-                        o << tbl;
-                        o.close();
-                    }
-                } catch (const std::exception& e) { Log("ERROR: Failed to write config file: " + std::string(e.what())); }
-            } catch (const SE_Exception& e) {
-                LogException("ConfigSaveThread (SEH)", e.getCode(), e.getInfo());
-            } catch (const std::exception& e) { LogException("ConfigSaveThread", e); } catch (...) {
-                Log("EXCEPTION in ConfigSaveThread: Unknown exception");
-            }
-            s_isConfigSaving = false;
-        }).detach();
-
-    } catch (const std::exception& e) { Log("ERROR: Failed to prepare config for save: " + std::string(e.what())); } catch (...) {
+        RequestConfigAutosave(GetConfigSnapshot(), configPath);
+    } catch (const std::exception& e) { Log("ERROR: Failed to queue config save: " + std::string(e.what())); } catch (...) {
         Log("ERROR: Unknown exception in SaveConfig");
     }
 }
 
-// Force immediate save, bypassing throttle (for shutdown, GUI close, etc.)
+// Force immediate save, bypassing the autosave debounce (for shutdown)
 void SaveConfigImmediate() {
     PROFILE_SCOPE_CAT("Config Save (Immediate)", "IO Operations");
 
-    // Wait for any background save to complete to avoid file corruption
-    if (s_isConfigSaving.load()) {
-        Log("SaveConfigImmediate: Waiting for background save to complete...");
-        auto startWait = std::chrono::steady_clock::now();
-        while (s_isConfigSaving.load()) {
-            // Timeout after 3 seconds to prevent infinite hang on shutdown
-            if (std::chrono::duration_cast<std::chrono::seconds>(std::chrono::steady_clock::now() - startWait).count() > 3) {
-                Log("SaveConfigImmediate: Timed out waiting for background save. Proceeding anyway.");
-                break;
-            }
-            std::this_thread::sleep_for(std::chrono::milliseconds(10));
-        }
-    }
-
-    if (!g_configIsDirty) {
-        return; // Nothing changed, skip save
-    }
-
-    if (g_toolscreenPath.empty()) {
-        Log("ERROR: Cannot save config, toolscreen path is not available.");
-        return;
-    }
-    std::wstring configPath = g_toolscreenPath + L"\\config.toml";
-    try {
-        Log("SaveConfigImmediate: Starting config copy...");
-        // Convert config to TOML
-        toml::table tbl;
-        ConfigToToml(g_config, tbl);
-
-        // Publish updated config snapshot for reader threads (RCU pattern)
-        PublishConfigSnapshot();
-
-        std::string narrowPath = WideToUtf8(configPath);
-        std::ofstream o(narrowPath);
-        if (!o.is_open()) {
-            Log("ERROR: Failed to open config file for writing.");
-            return;
-        }
-        o << tbl;
-        o.close();
+    SaveConfig();
 
+    // Timeout after 3 seconds to prevent infinite hang on shutdown
+    if (!FlushConfigAutosave(std::chrono::seconds(3))) {
+        Log("SaveConfigImmediate: Timed out waiting for config autosave.");
+    } else {
         Log("Configuration saved to file (immediate).");
-        g_configIsDirty = false;
-
-        // Cursor config is now handled directly by fake_cursor.cpp
-    } catch (const std::exception& e) { Log("ERROR: Failed to write config file: " + std::string(e.what())); } catch (...) {
-        Log("ERROR: Unknown exception in SaveConfigImmediate");
     }
 }
 
@@ -2456,17 +2442,12 @@ void WriteDefaultConfig(const std::wstring& path) {
         defaultConfig.cursors.wall.cursorSize = systemCursorSize;
         defaultConfig.cursors.ingame.cursorSize = systemCursorSize;
 
-        try {
-            toml::table tbl;
-            ConfigToToml(defaultConfig, tbl);
-
-            std::string narrowPath = WideToUtf8(path);
-            std::ofstream o(narrowPath);
-            o << tbl;
-            o.close();
+        if (SaveConfigToTomlFile(defaultConfig, path)) {
             Log("Wrote default config.toml from embedded defaults, customized for your monitor (" + std::to_string(screenWidth) + "x" +
                 std::to_string(screenHeight) + ").");
-        } catch (const std::exception& e) { Log("ERROR: Failed to write default config file: " + std::string(e.what())); }
+        } else {
+            Log("ERROR: Failed to write default config file.");
+        }
     } else {
         // Fallback: if embedded config fails, create minimal config
         Log("WARNING: Could not load embedded default config, creating minimal fallback config");
@@ -2484,16 +2465,11 @@ void WriteDefaultConfig(const std::wstring& path) {
         fullscreenMode.stretch.height = screenHeight;
         defaultConfig.modes.push_back(fullscreenMode);
 
-        try {
-            toml::table tbl;
-            ConfigToToml(defaultConfig, tbl);
-
-            std::string narrowPath = WideToUtf8(path);
-            std::ofstream o(narrowPath);
-            o << tbl;
-            o.close();
+        if (SaveConfigToTomlFile(defaultConfig, path)) {
             Log("Wrote fallback config.toml for your monitor (" + std::to_string(screenWidth) + "x" + std::to_string(screenHeight) + ").");
-        } catch (const std::exception& e) { Log("ERROR: Failed to write fallback config file: " + std::string(e.what())); }
+        } else {
+            Log("ERROR: Failed to write fallback config file.");
+        }
     }
 }
 
@@ -2523,8 +2499,8 @@ void LoadConfig() {
         }
     }
 
-    // Create backup of existing config file
-    BackupConfigFile();
+    // Create backup of existing config file (compressed on the autosave worker)
+    RequestConfigBackup();
 
     try {
         g_config = Config(); // Initialize with struct defaults
@@ -3114,6 +3090,9 @@ void RenderSettingsGUI() {
                 if (s_mainHotkeyToBind == -999) {
                     // Special case for GUI hotkey
                     g_config.guiHotkey = keys;
+                } else if (s_mainHotkeyToBind == -998) {
+                    // Special case for profiler trace capture hotkey
+                    g_config.debug.traceCaptureHotkey = keys;
                 } else {
                     g_config.hotkeys[s_mainHotkeyToBind].keys = keys;
                 }
@@ -3424,14 +3403,9 @@ void RenderSettingsGUI() {
     }
     ImGui::End();
 
-    // Periodic save while GUI is open (throttled to 1 second)
+    // Publish + queue for the debounced background autosave. This also makes structural changes
+    // (push_back/erase on vectors) visible to reader threads immediately.
     SaveConfig();
-
-    // Ensure config snapshot is published for reader threads after GUI mutations.
-    // SaveConfig already publishes when it runs, but it's throttled to 1s.
-    // For structural changes (push_back/erase on vectors) we need immediate snapshot
-    // update to prevent reader threads from seeing stale/freed vector data.
-    if (g_configIsDirty.load()) { PublishConfigSnapshot(); }
 }
 
 void HandleImGuiContextReset() {
@@ -3792,12 +3766,18 @@ void RenderProfilerOverlay(bool showProfiler, bool showPerformanceOverlay) {
         ImGui::Text("%s", sectionTitle);
         ImGui::PopStyleColor();
 
-        if (ImGui::BeginTable("##ProfilerTable", 5, ImGuiTableFlags_SizingFixedFit | ImGuiTableFlags_NoHostExtendX)) {
+        if (ImGui::BeginTable("##ProfilerTable", 9, ImGuiTableFlags_SizingFixedFit | ImGuiTableFlags_NoHostExtendX)) {
             ImGui::TableSetupColumn("Section", ImGuiTableColumnFlags_WidthFixed, 280.0f);
             ImGui::TableSetupColumn("Time", ImGuiTableColumnFlags_WidthFixed, 90.0f);
             ImGui::TableSetupColumn("Self", ImGuiTableColumnFlags_WidthFixed, 90.0f);
             ImGui::TableSetupColumn("Of Parent", ImGuiTableColumnFlags_WidthFixed, 70.0f);
             ImGui::TableSetupColumn("Of Total", ImGuiTableColumnFlags_WidthFixed, 60.0f);
+            // Per-call latency over the profiler's rolling window (last few seconds)
+            ImGui::TableSetupColumn("p50", ImGuiTableColumnFlags_WidthFixed, 70.0f);
+            ImGui::TableSetupColumn("p99", ImGuiTableColumnFlags_WidthFixed, 70.0f);
+            ImGui::TableSetupColumn("p99.9", ImGuiTableColumnFlags_WidthFixed, 70.0f);
+            ImGui::TableSetupColumn("Max", ImGuiTableColumnFlags_WidthFixed, 70.0f);
+            ImGui::TableHeadersRow();
 
             for (size_t i = 0; i < entries.size(); ++i) {
                 const auto& [name, entry] = entries[i];
@@ -3877,6 +3857,18 @@ void RenderProfilerOverlay(bool showProfiler, bool showPerformanceOverlay) {
                 } else {
                     ImGui::Text("<1%%");
                 }
+
+                const double latencyMs[] = { entry.p50Ms, entry.p99Ms, entry.p999Ms, entry.maxMs };
+                for (int c = 0; c < 4; ++c) {
+                    ImGui::TableSetColumnIndex(5 + c);
+                    if (entry.windowCalls == 0) {
+                        ImGui::Text("-");
+                    } else if (latencyMs[c] >= 0.001) {
+                        ImGui::Text("%.3fms", latencyMs[c]);
+                    } else {
+                        ImGui::Text("<0.001");
+                    }
+                }
             }
 
             ImGui::EndTable();
@@ -3892,9 +3884,48 @@ void RenderProfilerOverlay(bool showProfiler, bool showPerformanceOverlay) {
         renderTreeSection("Other Threads", displayData.otherThreads, ImVec4(0.4f, 0.7f, 1.0f, 1.0f));
     }
 
+    // Published counters (virtual camera pacing, etc.)
+    auto counters = Profiler::GetInstance().GetCounters();
+    if (!counters.empty()) {
+        ImGui::Separator();
+        ImGui::PushStyleColor(ImGuiCol_Text, ImVec4(1.0f, 0.7f, 0.4f, 1.0f));
+        ImGui::Text("Counters");
+        ImGui::PopStyleColor();
+        if (ImGui::BeginTable("##ProfilerCounters", 2, ImGuiTableFlags_SizingFixedFit | ImGuiTableFlags_NoHostExtendX)) {
+            ImGui::TableSetupColumn("Counter", ImGuiTableColumnFlags_WidthFixed, 280.0f);
+            ImGui::TableSetupColumn("Value", ImGuiTableColumnFlags_WidthFixed, 90.0f);
+            for (const auto& [name, value] : counters) {
+                ImGui::TableNextRow();
+                ImGui::TableSetColumnIndex(0);
+                ImGui::Text("%s", name.c_str());
+                ImGui::TableSetColumnIndex(1);
+                ImGui::Text("%.2f", value);
+            }
+            ImGui::EndTable();
+        }
+    }
+
     ImGui::End();
 }
 
+bool StartProfilerTraceCapture() {
+    if (g_toolscreenPath.empty()) { return false; }
+
+    SYSTEMTIME st;
+    GetLocalTime(&st);
+    wchar_t fileName[64];
+    swprintf_s(fileName, L"trace-%04u%02u%02u-%02u%02u%02u.json", st.wYear, st.wMonth, st.wDay, st.wHour, st.wMinute, st.wSecond);
+    const std::filesystem::path tracePath = std::filesystem::path(g_toolscreenPath) / L"logs" / fileName;
+
+    auto cfgSnap = GetConfigSnapshot();
+    const int seconds = cfgSnap ? cfgSnap->debug.traceCaptureSeconds : ConfigDefaults::DEBUG_GLOBAL_TRACE_CAPTURE_SECONDS;
+    if (!Profiler::GetInstance().StartTraceCapture(tracePath, static_cast<double>(seconds))) {
+        Log("Profiler trace capture not started (previous capture still running or file could not be created)");
+        return false;
+    }
+    return true;
+}
+
 void HandleConfigLoadFailed(HDC hDc, BOOL (*oWglSwapBuffers)(HDC)) {
     if (ImGui::GetCurrentContext() == nullptr) {
         IMGUI_CHECKVERSION();
@@ -14,28 +14,22 @@
 #include <vector>
 
 #include "config_defaults.h"
+#include "config_types.h"
+#include "image_decode.h"
 #include "imgui.h"
 #include "version.h"
 
 // Forward declarations for OpenGL types
 typedef unsigned int GLuint;
 
-struct Color {
-    float r = 0.0f, g = 0.0f, b = 0.0f, a = 1.0f;
-};
-
 struct DecodedImageData {
     enum Type { Background, UserImage };
     Type type;
     std::string id;
-    int width = 0, height = 0, channels = 0;
-    unsigned char* data = nullptr;
-
-    // Animation data (for animated GIFs)
-    bool isAnimated = false;
-    int frameCount = 0;
-    int frameHeight = 0;          // Height of a single frame (height / frameCount)
-    std::vector<int> frameDelays; // Delay in ms per frame (from GIF)
+    uint64_t loadId = 0; // One per LoadImageAsync call; ties the parts of a streamed animation together
+
+    // Decoded frames (or, for a large animation, one run of them), shared with the decoded-image cache
+    DecodedImagePart part;
 };
 
 void ParseColorString(const std::string& input, Color& outColor);
@@ -57,499 +51,6 @@ void RegisterBindingInputEvent(UINT uMsg, WPARAM wParam, LPARAM lParam);
 uint64_t GetLatestBindingInputSequence();
 bool ConsumeBindingInputEventSince(uint64_t& lastSeenSequence, DWORD& outVk, LPARAM& outLParam, bool& outIsMouseButton);
 
-// Gradient animation types
-enum class GradientAnimationType {
-    None,   // Static gradient (current behavior)
-    Rotate, // Rotates gradient angle continuously
-    Slide,  // Slides gradient position across screen
-    Wave,   // Sine wave distortion
-    Spiral, // Colors spiral from center outward
-    Fade    // Fade/blend between color stops over time
-};
-
-// A single color stop in a gradient
-struct GradientColorStop {
-    Color color = { 0.0f, 0.0f, 0.0f };
-    float position = 0.0f; // 0.0 to 1.0, position along gradient
-};
-
-struct BackgroundConfig {
-    std::string selectedMode = "color"; // "image", "color", or "gradient"
-    std::string image;
-    Color color;
-
-    // Gradient settings (used when selectedMode == "gradient")
-    std::vector<GradientColorStop> gradientStops; // Color stops (minimum 2)
-    float gradientAngle = 0.0f;                   // Angle in degrees (0 = left-to-right, 90 = bottom-to-top)
-
-    // Gradient animation settings
-    GradientAnimationType gradientAnimation = GradientAnimationType::None;
-    float gradientAnimationSpeed = 1.0f; // Multiplier for animation speed (0.1-5.0)
-    bool gradientColorFade = false;      // When true, colors smoothly cycle through stops
-};
-
-struct MirrorCaptureConfig {
-    int x = 0, y = 0;
-    std::string relativeTo = "topLeftScreen";
-};
-struct MirrorRenderConfig {
-    int x = 0, y = 0;
-    bool useRelativePosition = false; // When true, x/y are calculated from relativeX/relativeY
-    float relativeX = 0.5f;           // X position as percentage of screen (0.0-1.0, where 0.5 = center)
-    float relativeY = 0.5f;           // Y position as percentage of screen (0.0-1.0, where 0.5 = center)
-    float scale = 1.0f;
-    bool separateScale = false; // When true, use scaleX and scaleY instead of scale
-    float scaleX = 1.0f;        // X-axis scale (used when separateScale is true)
-    float scaleY = 1.0f;        // Y-axis scale (used when separateScale is true)
-    std::string relativeTo = "topLeftScreen";
-};
-struct MirrorColors {
-    std::vector<Color> targetColors; // Multiple target colors - any matching pixel is shown
-    Color output, border;
-};
-
-// How to interpret the captured game texture for color matching.
-// This only affects the filter/matching step (not raw output blit).
-enum class MirrorGammaMode {
-    Auto = 0,       // Auto-detect (best effort) based on framebuffer/texture encoding
-    AssumeSRGB = 1, // Treat captured input as sRGB and linearize for distance comparisons
-    AssumeLinear = 2 // Treat captured input as already linear
-};
-
-// Border type: dynamic (shader-based around content) or static (shape overlay)
-enum class MirrorBorderType {
-    Dynamic, // Existing shader-based border around content pixels
-    Static   // Static shape rendered when mirror has content
-};
-
-// Shape options for static borders
-enum class MirrorBorderShape {
-    Rectangle, // Rectangle (use staticRadius for rounded corners)
-    Circle     // Circle/ellipse that fits mirror dimensions
-};
-
-// Custom border configuration for mirrors
-struct MirrorBorderConfig {
-    MirrorBorderType type = MirrorBorderType::Dynamic; // Which border type to use
-
-    // Dynamic border settings (existing behavior)
-    int dynamicThickness = 1; // Thickness for dynamic border (was: borderThickness)
-
-    // Static border settings (new) - rendered if thickness > 0
-    MirrorBorderShape staticShape = MirrorBorderShape::Rectangle;
-    Color staticColor = { 1.0f, 1.0f, 1.0f }; // Static border color (white default)
-    int staticThickness = 2;                  // Static border thickness in pixels (0 = disabled)
-    int staticRadius = 0;                     // Corner radius for Rectangle shape (0 = sharp corners)
-    // Custom position/size offsets (relative to mirror output position)
-    int staticOffsetX = 0; // X offset from mirror position
-    int staticOffsetY = 0; // Y offset from mirror position
-    int staticWidth = 0;   // Custom width (0 = use mirror width)
-    int staticHeight = 0;  // Custom height (0 = use mirror height)
-};
-
-struct MirrorConfig {
-    std::string name;
-    int captureWidth = 50;
-    int captureHeight = 50;
-    std::vector<MirrorCaptureConfig> input;
-    MirrorRenderConfig output;
-    MirrorColors colors;
-    float colorSensitivity = 0.001f;
-    MirrorBorderConfig border; // Custom border configuration
-    int fps = 30;
-    float opacity = 1.0f;
-    bool rawOutput = false;
-    bool colorPassthrough = false; // If true, output original pixel color instead of Output Color when matching
-    bool onlyOnMyScreen = false;   // If true, render only to user's screen, not to OBS
-};
-// Per-item sizing for mirrors within a group - only applies when rendered as part of group
-struct MirrorGroupItem {
-    std::string mirrorId;
-    bool enabled = true;        // Whether this mirror is rendered as part of the group
-    float widthPercent = 1.0f;  // Width as % of mirror's normal size (1.0 = 100%)
-    float heightPercent = 1.0f; // Height as % of mirror's normal size (1.0 = 100%)
-    int offsetX = 0;            // X offset from group position (pixels)
-    int offsetY = 0;            // Y offset from group position (pixels)
-};
-struct MirrorGroupConfig {
-    std::string name;
-    MirrorRenderConfig output;            // Position/relativeTo for the group (scale fields are IGNORED at render time)
-    std::vector<MirrorGroupItem> mirrors; // Per-item sizing for each mirror in the group
-};
-struct ImageBackgroundConfig {
-    bool enabled = false;
-    Color color = { 0.0f, 0.0f, 0.0f };
-    float opacity = 1.0f;
-};
-struct StretchConfig {
-    bool enabled = false;
-    int width = 0, height = 0, x = 0, y = 0;
-
-    // Expression-based values (empty = use numeric fields)
-    std::string widthExpr;  // e.g., "screenWidth", "screenWidth - 100"
-    std::string heightExpr; // e.g., "screenHeight", "min(screenHeight, 800)"
-    std::string xExpr;      // e.g., "0", "(screenWidth - 300) / 2"
-    std::string yExpr;      // e.g., "0", "screenHeight - 100"
-};
-struct BorderConfig {
-    bool enabled = false;
-    Color color = { 1.0f, 1.0f, 1.0f }; // White default
-    int width = 4;                      // Border width in pixels
-    int radius = 0;                     // Corner radius in pixels (0 = sharp corners)
-};
-// Color key configuration for transparency
-struct ColorKeyConfig {
-    Color color;
-    float sensitivity = 0.05f;
-};
-struct ImageConfig {
-    std::string name;
-    std::string path;
-    int x = 0, y = 0;
-    float scale = 1.0f; // Scale as percentage (1.0 = 100%)
-    std::string relativeTo = "topLeftScreen";
-    int crop_top = 0, crop_bottom = 0, crop_left = 0, crop_right = 0;
-    bool enableColorKey = false;
-    std::vector<ColorKeyConfig> colorKeys; // Multiple color keys (new format)
-    Color colorKey;                        // Single color key (legacy, for backward compat)
-    float colorKeySensitivity = 0.001f;    // Legacy sensitivity
-    float opacity = 1.0f;
-    ImageBackgroundConfig background;
-    bool pixelatedScaling = false;
-    bool onlyOnMyScreen = false; // If true, render only to user's screen, not to OBS
-    BorderConfig border;         // Border around the image overlay
-};
-struct WindowOverlayConfig {
-    std::string name;
-    std::string windowTitle;                   // Window title to search for
-    std::string windowClass;                   // Window class name (optional, hidden from GUI but kept in config)
-    std::string executableName;                // Executable name (hidden from GUI but kept in config)
-    std::string windowMatchPriority = "title"; // Match priority: "title", "title_executable"
-    int x = 0, y = 0;
-    float scale = 1.0f; // Scale as percentage (1.0 = 100%)
-    std::string relativeTo = "topLeftScreen";
-    int crop_top = 0, crop_bottom = 0, crop_left = 0, crop_right = 0;
-    bool enableColorKey = false;
-    std::vector<ColorKeyConfig> colorKeys; // Multiple color keys (new format)
-    Color colorKey;                        // Single color key (legacy, for backward compat)
-    float colorKeySensitivity = 0.001f;    // Legacy sensitivity
-    float opacity = 1.0f;
-    ImageBackgroundConfig background;
-    bool pixelatedScaling = false;
-    bool onlyOnMyScreen = false;               // If true, render only to user's screen, not to OBS
-    int fps = 30;                              // Capture framerate
-    int searchInterval = 1000;                 // Window search interval in milliseconds (default 1 second)
-    std::string captureMethod = "Windows 10+"; // Capture method: "Windows 10+" (default) or "BitBlt"
-    bool enableInteraction = false;            // Enable mouse/keyboard interaction forwarding to the real window
-    BorderConfig border;                       // Border around the window overlay
-};
-// StretchConfig and BorderConfig are defined above ImageConfig
-
-enum class GameTransitionType {
-    Cut,   // Instant switch, no animation
-    Bounce // Animate resizing with optional bounce effect at target
-};
-
-enum class OverlayTransitionType {
-    Cut // Instant switch, no animation
-};
-
-enum class BackgroundTransitionType {
-    Cut // Instant switch, no animation
-};
-
-enum class EasingType {
-    Linear,   // No easing, constant speed
-    EaseOut,  // Slow down at end
-    EaseIn,   // Speed up from start
-    EaseInOut // Slow start and end
-};
-
-struct ModeConfig {
-    std::string id;
-    int width = 0, height = 0;
-    bool useRelativeSize = false; // When true, width/height are calculated from relativeWidth/relativeHeight
-    float relativeWidth = 0.5f;   // Width as percentage of screen (0.0-1.0, where 1.0 = 100%)
-    float relativeHeight = 0.5f;  // Height as percentage of screen (0.0-1.0, where 1.0 = 100%)
-
-    // Expression-based dimensions (empty = use numeric/relative fields)
-    std::string widthExpr;  // e.g., "screenWidth", "min(screenWidth, 300)", "screenWidth * 0.9"
-    std::string heightExpr; // e.g., "screenHeight", "screenHeight - 300"
-
-    BackgroundConfig background;
-    std::vector<std::string> mirrorIds;
-    std::vector<std::string> mirrorGroupIds;
-    std::vector<std::string> imageIds;
-    std::vector<std::string> windowOverlayIds;
-    StretchConfig stretch;
-
-    // Transition properties (used when switching TO this mode)
-    GameTransitionType gameTransition = GameTransitionType::Bounce;
-    OverlayTransitionType overlayTransition = OverlayTransitionType::Cut;
-    BackgroundTransitionType backgroundTransition = BackgroundTransitionType::Cut;
-    int transitionDurationMs = 500; // Game transition duration in milliseconds
-
-    // Easing settings (for Bounce transition) - separate control for ease in and ease out
-    float easeInPower = 1.0f;        // Power for ease-in (1.0 = linear/no ease-in, higher = more pronounced)
-    float easeOutPower = 3.0f;       // Power for ease-out (1.0 = linear/no ease-out, higher = more pronounced)
-    int bounceCount = 0;             // Number of bounces after reaching target (0 = no bounce)
-    float bounceIntensity = 0.15f;   // How much the bounce goes back towards origin (0.0-0.5)
-    int bounceDurationMs = 150;      // Duration of each bounce cycle in milliseconds
-    bool relativeStretching = false; // When true, viewport-relative overlays scale with viewport during animation
-    bool skipAnimateX = false;       // When true, X axis (width) instantly jumps to target, only Y animates
-    bool skipAnimateY = false;       // When true, Y axis (height) instantly jumps to target, only X animates
-
-    // Border settings
-    BorderConfig border;
-
-    // Mouse sensitivity override for this mode
-    bool sensitivityOverrideEnabled = false; // If true, use modeSensitivity instead of global
-    float modeSensitivity = 1.0f;            // Mode-specific sensitivity (1.0 = normal)
-    bool separateXYSensitivity = false;      // If true, use separate X and Y sensitivity values
-    float modeSensitivityX = 1.0f;           // X-axis sensitivity (when separateXYSensitivity is true)
-    float modeSensitivityY = 1.0f;           // Y-axis sensitivity (when separateXYSensitivity is true)
-
-    // Transition animation
-    bool slideMirrorsIn = false; // If true, mirrors slide in/out from screen edge during transitions
-};
-struct HotkeyConditions {
-    std::vector<std::string> gameState;
-    std::vector<DWORD> exclusions;
-};
-struct AltSecondaryMode {
-    std::vector<DWORD> keys;
-    std::string mode;
-};
-struct HotkeyConfig {
-    std::vector<DWORD> keys;
-
-    std::string mainMode;
-    std::string secondaryMode;
-    std::vector<AltSecondaryMode> altSecondaryModes;
-
-    HotkeyConditions conditions;
-    int debounce = 100;
-    bool triggerOnRelease = false; // When true, hotkey triggers on key release instead of key press
-};
-
-// Sensitivity hotkey - temporarily overrides mouse sensitivity until next mode change
-struct SensitivityHotkeyConfig {
-    std::vector<DWORD> keys;     // Key combination to trigger
-    float sensitivity = 1.0f;    // Sensitivity value to set (same as global/mode sensitivity)
-    bool separateXY = false;     // If true, use separate X/Y sensitivity values
-    float sensitivityX = 1.0f;   // X-axis sensitivity (when separateXY is true)
-    float sensitivityY = 1.0f;   // Y-axis sensitivity (when separateXY is true)
-    bool toggle = false;         // If true, pressing the hotkey again resets sensitivity to normal
-    HotkeyConditions conditions; // Game state conditions and exclusions
-    int debounce = 100;          // Debounce time in milliseconds
-};
-struct DebugGlobalConfig {
-    bool showPerformanceOverlay = false;
-    bool showProfiler = false;
-    float profilerScale = 0.8f; // Scale of profiler overlay (0.25 to 2.0)
-    bool showHotkeyDebug = false;
-    bool fakeCursor = false;
-    bool showTextureGrid = false;
-    bool delayRenderingUntilFinished = false; // Call glFinish() before SwapBuffers to ensure all rendering is complete
-    bool delayRenderingUntilBlitted = false;  // Wait on async overlay blit fence before SwapBuffers
-    bool virtualCameraEnabled = false;        // Output to OBS Virtual Camera driver
-    int virtualCameraFps = 60;                // Virtual camera FPS limit
-
-    // Log category filters (Debug > Advanced Logging)
-    bool logModeSwitch = false;
-    bool logAnimation = false;
-    bool logHotkey = false;
-    bool logObs = false;
-    bool logWindowOverlay = false;
-    bool logFileMonitor = false;
-    bool logImageMonitor = false;
-    bool logPerformance = false;
-    bool logTextureOps = false;
-    bool logGui = false;
-    bool logInit = false;           // Initialization/startup messages
-    bool logCursorTextures = false; // Cursor texture loading messages
-};
-// Cursor selection based on game state
-// Valid cursor values come from dynamically scanned cursors folder
-struct CursorConfig {
-    std::string cursorName = ""; // Selected cursor (empty = use first available)
-    int cursorSize = 64;         // Cursor size in pixels (from STANDARD_SIZES: 16-512px with 24 options, loaded on-demand)
-};
-struct CursorsConfig {
-    bool enabled = false; // Master switch for cursor customization
-    CursorConfig title;   // Cursor for title screen
-    CursorConfig wall;    // Cursor for wall (world preview)
-    CursorConfig ingame;  // Cursor for in-game (everything else)
-};
-struct EyeZoomConfig {
-    int cloneWidth = 24;
-    int cloneHeight = 2080;
-    int stretchWidth = 810; // Width of the rendered zoom output on screen
-    int windowWidth = 384;
-    int windowHeight = 16384;
-    int horizontalMargin = 0;   // Horizontal margin on both sides of the eyezoom stretch output
-    int verticalMargin = 0;     // Vertical margin on top and bottom of the eyezoom stretch output
-    int textFontSize = 24;      // Font size for text labels in pixels (range: 8-80 pixels)
-    std::string textFontPath;   // Custom font path for EyeZoom text (empty = use global fontPath)
-    int rectHeight = 24;        // Height of colored overlay rectangles in pixels (linked to textFontSize by default)
-    bool linkRectToFont = true; // If true, rectHeight scales with textFontSize (rectHeight = textFontSize * 1.2)
-    // Overlay colors
-    Color gridColor1 = { 1.0f, 0.714f, 0.757f };   // First alternating grid box color (light pink)
-    float gridColor1Opacity = 1.0f;                // Opacity for gridColor1 (0.0 = transparent, 1.0 = opaque)
-    Color gridColor2 = { 0.678f, 0.847f, 0.902f }; // Second alternating grid box color (light blue)
-    float gridColor2Opacity = 1.0f;                // Opacity for gridColor2 (0.0 = transparent, 1.0 = opaque)
-    Color centerLineColor = { 1.0f, 1.0f, 1.0f };  // Vertical center line color (white)
-    float centerLineColorOpacity = 1.0f;           // Opacity for centerLineColor (0.0 = transparent, 1.0 = opaque)
-    Color textColor = { 0.0f, 0.0f, 0.0f };        // Number text color inside grid boxes (black)
-    float textColorOpacity = 1.0f;                 // Opacity for textColor (0.0 = transparent, 1.0 = opaque)
-    // Transition settings
-    bool slideZoomIn = false;    // If true, zoom slides in from left instead of growing with viewport
-    bool slideMirrorsIn = false; // If true, mirrors slide in from their nearest screen edge (left or right)
-};
-// GUI appearance configuration - ImGui color scheme
-struct AppearanceConfig {
-    std::string theme = "Dark";                // "Dark", "Light", "Classic", or "Custom"
-    std::map<std::string, Color> customColors; // Custom color overrides (only saved for "Custom" theme)
-};
-
-// Key rebinding configuration - intercept and remap keyboard keys
-struct KeyRebind {
-    DWORD fromKey = 0; // Original key to intercept
-    DWORD toKey = 0;   // Key to send instead (virtual key code)
-    bool enabled = true;
-    bool onlyInWorld = false; // If true, this rebind only fires while gameState contains "inworld"
-
-    // Optional: Custom output settings (when useCustomOutput is true)
-    bool useCustomOutput = false;   // If true, use custom VK/scancode instead of auto-calculated
-    DWORD customOutputVK = 0;       // Custom virtual key code to output
-    DWORD customOutputScanCode = 0; // Custom scan code to output
-};
-struct KeyRebindsConfig {
-    bool enabled = false; // Master switch for all rebinds
-    bool globalOnlyInWorld = true; // If true, all macro-style inputs only fire while gameState contains "inworld"
-    std::vector<KeyRebind> rebinds;
-};
-struct StrongholdOverlayConfig {
-    bool enabled = true;                 // Master toggle for native stronghold overlay
-    bool visible = false;                // Runtime startup visibility (hidden by default)
-    bool autoHideOnEyeSpy = true;        // Auto-hide panel after Eye Spy advancement appears in Minecraft latest.log
-    bool nonMcsrFeaturesEnabled = false; // Master toggle for non-approved MCSR visual helpers
-    bool showDirectionArrow = true;      // Show/hide large direction arrow glyph
-    bool showEstimateValues = true;      // Show/hide estimated/offset values (Aim/Off/Err)
-    bool showAlignmentText = true;       // Show/hide Align/Aim percentage text
-    int hudLayoutMode = 2;               // 0=full, 2=speedrun (1=legacy compact alias -> speedrun)
-    bool preferNetherCoords = true;      // Show nether-scaled coordinates by default
-    bool autoLockOnFirstNether = true;   // Auto-lock once after entering nether/boat throw
-    bool useChunkCenterTarget = false;   // False = chunk corner (matches NBB display)
-    bool standaloneClipboardMode = true; // Read F3+C clipboard directly in Toolscreen (no NBB process/API required)
-    bool standaloneAllowNonBoatThrows = true; // Double Eye mode: use normal eye throws (1-2 eye method)
-    bool renderInGameOverlay = true;          // Render stronghold HUD on the Minecraft game view
-    bool renderCompanionOverlay = true;       // Render detached companion window overlays on non-game monitors
-    bool manageNinjabrainBotProcess = false; // Standalone-only release default
-    bool autoStartNinjabrainBot = false;     // Standalone-only release default
-    bool hideNinjabrainBotWindow = false;    // Standalone-only release default
-    std::string ninjabrainBotJarPath;       // Optional path to Ninjabrain-Bot jar (absolute or relative to toolscreen dir)
-    int renderMonitorMode = 0;              // 0=all monitors, 1=selected monitor(s)
-    unsigned long long renderMonitorMask = ~0ull; // Bitmask of selected monitors when mode=selected
-    int x = 0;                           // Overlay X offset from top-center screen
-    int y = 20;                          // Overlay Y offset from top edge
-    float scale = 1.0f;                  // UI scale multiplier
-    float opacity = 1.0f;                // Text/border opacity multiplier
-    float backgroundOpacity = 0.55f;     // Panel background alpha multiplier
-    int pollIntervalMs = 125;            // API polling interval
-};
-struct McsrTrackerOverlayConfig {
-    bool enabled = false;              // Master toggle for MCSR tracker overlay feature
-    bool visible = false;              // Startup visibility (hidden by default)
-    bool renderInGameOverlay = true;   // Render tracker card on game view
-    bool autoDetectPlayer = true;      // Auto-grab Minecraft account username from latest.log
-    std::string player;                // Manual MCSR username search/override
-    bool refreshOnlyMode = true;       // If true, poll only on manual refresh or identifier changes
-    bool useApiKey = false;            // Include API key header for expanded ratelimit
-    std::string apiKeyHeader = "x-api-key"; // Header name for API key
-    std::string apiKey;                // API key value (from MCSR ticket)
-    int pollIntervalMs = 15000;        // API polling interval
-    bool hotkeyCtrl = true;            // Toggle hotkey requires Ctrl
-    bool hotkeyShift = true;           // Toggle hotkey requires Shift
-    bool hotkeyAlt = false;            // Toggle hotkey requires Alt
-    int hotkeyKey = 'U';               // Toggle hotkey key virtual-key code
-    int x = 0;                         // Overlay X offset from top-right anchor
-    int y = 0;                         // Overlay Y offset from top-right anchor
-    float scale = 1.0f;                // UI scale multiplier
-    float opacity = 1.0f;              // Text/border opacity multiplier
-    float backgroundOpacity = 0.55f;   // Panel background alpha multiplier
-};
-struct BoatSetupConfig {
-    bool enabled = true;                // Enable boat-eye setup helper tab/workflow
-    bool preferPixelPerfect = true;     // True = use pixel-perfect recommendation as primary
-    bool prioritizeLowestPixelSkipping = true;  // Pixel-perfect auto policy is enforced to lowest skipping
-    int currentDpi = 800;               // User-entered current DPI
-    int preferredCursorSpeed = 0;       // 0 = auto; 1-20 = preferred Windows cursor speed
-    int manualCurrentWindowsSpeed = 10; // Manual mode only: current Windows pointer speed baseline (1-20)
-    int recommendationChoice = 1;       // 1 = best (lowest skip), higher = alternate ranked choices
-    bool lowestSkipChoiceOne = true;    // If true, rank #1 is always strict lowest skip
-    bool includeCursorInRanking = true; // Include cursor-speed distance in recommendation ranking
-    bool preferHigherDpi = false;       // Bias recommendations toward higher DPI when otherwise comparable
-    float maxRecommendedPixelSkipping = 50.0f; // Exclude candidates above this skip threshold (fallbacks if none)
-    bool autoTrackPreferredStandardSensitivity = true; // Auto mode helper: keep manual input value synced from detected standardsettings
-    bool usePreferredStandardSensitivity = false;      // Input mode: true = use manual preferredStandardSensitivity as current baseline
-    float preferredStandardSensitivity = 0.0f;         // Manual input baseline sensitivity in [0,1]
-    float appliedRecommendedSensitivity = -1.0f;       // Last successfully applied boat recommendation sensitivity in [0,1], -1 = unset
-    bool autoApplyVisualEffects = true;                // Apply distortion/FOV effect scale values once on game startup
-    int autoDistortionPercent = 0;                     // Distortion effect scale target in MC percent (0-100)
-    int autoFovEffectPercent = 10;                     // FOV effect scale target in MC percent (0-100)
-    int legacyTargetDpi = 800;          // Target DPI for legacy target-mapped mode
-    bool disableMouseAccel = true;      // Apply disabling Windows mouse acceleration
-    bool enableRawInput = true;         // Apply enabling Minecraft rawMouseInput
-};
-struct NotesOverlayConfig {
-    bool enabled = true;             // Master toggle for notes overlay feature
-    bool visible = false;            // Startup visibility (hidden by default)
-    float backgroundOpacity = 0.62f; // Full-screen dim backdrop alpha
-    float panelScale = 1.0f;         // Notes panel scale multiplier
-    bool hotkeyCtrl = true;          // Notes toggle hotkey requires Ctrl
-    bool hotkeyShift = true;         // Notes toggle hotkey requires Shift
-    bool hotkeyAlt = false;          // Notes toggle hotkey requires Alt
-    int hotkeyKey = 'N';             // Notes toggle key virtual-key code
-    std::string markdownDirectory = "notes/General"; // Base directory for .md notes (IGN uses markdownDirectory/IGN)
-    std::string pdfDirectory = "notes/PDF";          // Base directory for exported PDFs
-    bool openPdfFolderAfterExport = false;           // Optionally open the containing folder after PDF export
-};
-struct Config {
-    int configVersion = 1; // Config version for automatic upgrades
-    std::vector<MirrorConfig> mirrors;
-    std::vector<MirrorGroupConfig> mirrorGroups;
-    std::vector<ImageConfig> images;
-    std::vector<WindowOverlayConfig> windowOverlays;
-    std::vector<ModeConfig> modes;
-    std::vector<HotkeyConfig> hotkeys;
-    std::vector<SensitivityHotkeyConfig> sensitivityHotkeys; // Hotkeys for temporary sensitivity override
-    EyeZoomConfig eyezoom;
-    std::string defaultMode = "fullscreen";
-    DebugGlobalConfig debug;
-    std::vector<DWORD> guiHotkey = { VK_CONTROL, 'E' };
-    CursorsConfig cursors;
-    std::string fontPath = "c:\\Windows\\Fonts\\Arial.ttf"; // Custom font path for ImGui
-    int fpsLimit = 0;                                       // FPS limit (0 = unlimited, 1-1000 = target FPS)
-    int fpsLimitSleepThreshold = 1000;                      // Microseconds threshold for using timer sleep during high FPS
-    // Global mirror color-matching colorspace/gamma mode (applies to all mirrors)
-    MirrorGammaMode mirrorGammaMode = MirrorGammaMode::Auto;
-    bool allowCursorEscape = false;                         // Allow cursor to escape window boundaries
-    float mouseSensitivity = 1.0f;                          // Mouse sensitivity multiplier (1.0 = normal)
-    int windowsMouseSpeed = 0;                              // Windows mouse speed override (0 = disabled, 1-20 = override)
-    bool hideAnimationsInGame = false;                      // Show transition animations only on OBS, not in-game
-    KeyRebindsConfig keyRebinds;                            // Key rebinding configuration
-    StrongholdOverlayConfig strongholdOverlay;              // Native stronghold direction overlay
-    McsrTrackerOverlayConfig mcsrTrackerOverlay;            // MCSR Ranked stats/splits overlay
-    BoatSetupConfig boatSetup;                              // Boat-eye pixel-perfect setup helper
-    NotesOverlayConfig notesOverlay;                        // Notes overlay (IGN + General notes)
-    AppearanceConfig appearance;                            // GUI color scheme configuration
-    int keyRepeatStartDelay = 0;                            // Key repeat start delay (0 = disabled, 1-500ms = custom)
-    int keyRepeatDelay = 0;                                 // Key repeat delay between repeats (0 = disabled, 1-500ms = custom)
-    bool basicModeEnabled = true;                           // Basic-only GUI mode (advanced UI hidden in this branch)
-    bool disableFullscreenPrompt = true;                    // Disable fullscreen toast prompt (toast2)
-    bool disableConfigurePrompt = true;                     // Disable configure toast prompt (toast1)
-};
 struct GameViewportGeometry {
     int gameW = 0, gameH = 0;
     int finalX = 0, finalY = 0, finalW = 0, finalH = 0;
@@ -797,6 +298,8 @@ void RenderSettingsGUI();
 void RenderConfigErrorGUI();
 void RenderPerformanceOverlay(bool showPerformanceOverlay);
 void RenderProfilerOverlay(bool showProfiler, bool showPerformanceOverlay);
+// Starts a profiler timeline capture into logs/trace-<timestamp>.json (trace hotkey / Debug tab)
+bool StartProfilerTraceCapture();
 
 // Welcome toast overlay (prompt visibility controlled by config toggles)
 extern std::atomic<bool> g_welcomeToastVisible;
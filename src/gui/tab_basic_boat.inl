@@ -114,6 +114,8 @@ if (ImGui::BeginTabItem("[B] Boat")) {
     static bool s_boatHasRun = false;
     static bool s_boatLastApply = false;
     static BoatSetupScriptRunResult s_boatLastRun;
+    static bool s_boatNativeActive = false;
+    static bool s_boatNativeSeeded = false; // s_boatLastRun was built natively from typed values, not by the script
     static std::string s_boatCopyFeedback;
     static std::chrono::steady_clock::time_point s_boatCopyFeedbackUntil{};
     static bool s_showManualDpiPopup = false;
@@ -241,12 +243,61 @@ if (ImGui::BeginTabItem("[B] Boat")) {
         return oss.str();
     };
 
+    struct BoatNativeKey {
+        BoatEyeRankingInput input;
+        bool pixelPerfect = true;
+        int legacyTargetDpi = 0;
+
+        bool operator==(const BoatNativeKey& other) const = default;
+    };
+    static BoatNativeKey s_boatNativeKey;
+    static bool s_boatNativeHasKey = false;
+
+    // Current sensitivity/cursor come from the typed values in manual mode, otherwise from the last detection run
+    auto buildBoatNativeKey = [&](BoatNativeKey& out) -> bool {
+        const BoatSetupConfig& boat = g_config.boatSetup;
+        out = BoatNativeKey();
+        out.pixelPerfect = boat.preferPixelPerfect;
+        out.legacyTargetDpi = std::max(1, boat.legacyTargetDpi);
+        BoatEyeRankingInput& in = out.input;
+        in.currentDpi = std::max(1, boat.currentDpi);
+        in.preferredCursorSpeed = std::clamp(boat.preferredCursorSpeed, 0, 20);
+        in.recommendationChoice = std::clamp(boat.recommendationChoice, 1, 12);
+        in.lowestSkipChoiceOne = boat.lowestSkipChoiceOne;
+        in.includeCursorInRanking = boat.includeCursorInRanking;
+        in.preferHigherDpi = boat.preferHigherDpi;
+        in.maxRecommendedPixelSkipping = std::clamp(boat.maxRecommendedPixelSkipping, 0.1f, 5000.0f);
+        if (boat.usePreferredStandardSensitivity) {
+            in.currentSensitivity = std::clamp(static_cast<double>(boat.preferredStandardSensitivity), 0.0, 1.0);
+            in.currentCursorSpeed = std::clamp(boat.manualCurrentWindowsSpeed, 1, 20);
+            return true;
+        }
+        if (!s_boatLastRun.parsedOk || !s_boatLastRun.payload.contains("current") || !s_boatLastRun.payload["current"].is_object()) {
+            return false;
+        }
+        const auto& current = s_boatLastRun.payload["current"];
+        if (!current.contains("minecraftSensitivity") || !current["minecraftSensitivity"].is_number()) return false;
+        in.currentSensitivity = std::clamp(current.value("minecraftSensitivity", 0.0), 0.0, 1.0);
+        int cursorSpeed = 10;
+        if (current.contains("currentCursorSpeedForCalc") && current["currentCursorSpeedForCalc"].is_number_integer()) {
+            cursorSpeed = current.value("currentCursorSpeedForCalc", 10);
+        } else if (current.contains("windowsPointerSpeed") && current["windowsPointerSpeed"].is_number_integer()) {
+            cursorSpeed = current.value("windowsPointerSpeed", 10);
+        }
+        in.currentCursorSpeed = std::clamp(cursorSpeed, 1, 20);
+        return true;
+    };
+
     if (s_boatRunActive && s_boatRunFuture.valid()) {
         const auto ready = s_boatRunFuture.wait_for(std::chrono::milliseconds(0));
         if (ready == std::future_status::ready) {
             s_boatLastRun = s_boatRunFuture.get();
             s_boatHasRun = true;
             s_boatRunActive = false;
+            // The script's ranking is authoritative for the inputs it ran with; re-rank natively only once they change
+            s_boatNativeHasKey = buildBoatNativeKey(s_boatNativeKey);
+            s_boatNativeActive = false;
+            s_boatNativeSeeded = false;
             const bool runOk = s_boatLastRun.parsedOk && s_boatLastRun.payload.value("ok", false);
             if (s_boatLastApply && runOk && g_config.windowsMouseSpeed != 0) {
                 // Avoid game-vs-desktop cursor mismatch from runtime override.
@@ -292,6 +343,62 @@ if (ImGui::BeginTabItem("[B] Boat")) {
         }
     }
 
+    std::string boatTableError;
+    const BoatEyeSensitivityTable* boatTable = GetBoatEyeSensitivityTable(g_toolscreenPath, boatTableError);
+    if (s_boatNativeSeeded && !g_config.boatSetup.usePreferredStandardSensitivity) {
+        // Nothing was detected yet; the typed values must not stand in for a detection
+        s_boatLastRun = BoatSetupScriptRunResult();
+        s_boatHasRun = false;
+        s_boatNativeActive = false;
+        s_boatNativeSeeded = false;
+    }
+    // Typed values are all manual mode needs, so it ranks natively before (or without) any script run; the script's
+    // detection and mouse-software hints are only added once [Recommend] runs
+    if (boatTable && !s_boatHasRun && !s_boatRunActive && g_config.boatSetup.usePreferredStandardSensitivity) {
+        s_boatLastRun = BoatSetupScriptRunResult();
+        s_boatLastRun.parsedOk = true;
+        s_boatLastRun.output = "Native ranking from typed values; calibration script not run.";
+        s_boatLastRun.payload = { { "ok", true },
+                                  { "inputMode", "manual" },
+                                  { "current", { { "inputMode", "manual" }, { "sensitivitySource", "manual-input" } } },
+                                  { "recommendations", nlohmann::json::object() } };
+        s_boatHasRun = true;
+        s_boatLastApply = false;
+        s_boatNativeHasKey = false;
+        s_boatNativeSeeded = true;
+    }
+    if (boatTable && s_boatHasRun && !s_boatRunActive && !s_boatLastApply && s_boatLastRun.parsedOk &&
+        s_boatLastRun.payload.value("ok", false) && s_boatLastRun.payload.contains("recommendations") &&
+        s_boatLastRun.payload["recommendations"].is_object()) {
+        BoatNativeKey key;
+        if (buildBoatNativeKey(key) && (!s_boatNativeHasKey || !(key == s_boatNativeKey))) {
+            BoatEyeRecommendation rec;
+            const char* source = "pixel-perfect-auto";
+            if (key.pixelPerfect) {
+                rec = ComputeBoatEyePixelPerfectRecommendation(*boatTable, key.input);
+            } else {
+                const int targetCursor = key.input.preferredCursorSpeed > 0 ? key.input.preferredCursorSpeed : key.input.currentCursorSpeed;
+                rec = ComputeBoatEyeTargetMappedRecommendation(*boatTable, key.input, key.legacyTargetDpi, targetCursor);
+                source = "target-mapped";
+            }
+            if (rec.ok) {
+                auto& payload = s_boatLastRun.payload;
+                payload["recommendations"]["active"] = BoatEyeRecommendationToJson(rec, g_config.boatSetup, source);
+                if (payload.contains("current") && payload["current"].is_object()) {
+                    auto& current = payload["current"];
+                    current["dpi"] = key.input.currentDpi;
+                    if (g_config.boatSetup.usePreferredStandardSensitivity) {
+                        current["minecraftSensitivity"] = key.input.currentSensitivity;
+                        current["currentCursorSpeedForCalc"] = key.input.currentCursorSpeed;
+                    }
+                }
+                s_boatNativeActive = true;
+            }
+            s_boatNativeKey = key;
+            s_boatNativeHasKey = true;
+        }
+    }
+
     ImGui::Separator();
 
     ImGui::BeginDisabled(s_boatRunActive);
@@ -327,6 +434,11 @@ if (ImGui::BeginTabItem("[B] Boat")) {
 
     if (s_boatRunActive) {
         ImGui::TextDisabled("Running calibration script...");
+    } else if (s_boatNativeActive) {
+        ImGui::TextDisabled("Live: recommendation re-ranked natively from %s.",
+                            s_boatNativeSeeded ? "the typed values" : "the last detection");
+    } else if (!boatTable && !boatTableError.empty()) {
+        ImGui::TextDisabled("Live ranking unavailable: %s", boatTableError.c_str());
     }
 
     if (s_boatHasRun) {
@@ -438,8 +550,9 @@ if (ImGui::BeginTabItem("[B] Boat")) {
                                 if (ImGui::Selectable(rowLabel.str().c_str(), isSelectedRow)) {
                                     g_config.boatSetup.recommendationChoice = std::clamp(rank, 1, 12);
                                     g_configIsDirty = true;
-                                    setBoatCopyFeedback("Choice selected. Recomputing recommendation...");
-                                    if (!s_boatRunActive) {
+                                    setBoatCopyFeedback("Choice selected.");
+                                    // Re-ranked natively next frame; only fall back to the script without the table
+                                    if (!boatTable && !s_boatRunActive) {
                                         BoatSetupConfig runCfg = g_config.boatSetup;
                                         std::wstring toolsPath = g_toolscreenPath;
                                         s_boatLastApply = false;
@@ -520,6 +520,14 @@ if (ImGui::BeginTabItem("[R] Mirrors")) {
             if (ImGui::IsItemHovered()) {
                 ImGui::SetTooltip("When enabled, this mirror will only be visible to you and not captured by OBS");
             }
+            if (ImGui::Checkbox("Skip unchanged frames", &mirror.skipUnchangedFrames)) {
+                g_configIsDirty = true;
+                UpdateMirrorSkipUnchanged(mirror.name, mirror.skipUnchangedFrames);
+            }
+            if (ImGui::IsItemHovered()) {
+                ImGui::SetTooltip("Only re-render this mirror when the captured region actually changes.\n"
+                                  "Saves GPU time for mostly static areas (pie chart, F3 text). Skip ratio shows in the profiler.");
+            }
             ImGui::Separator();
 
             ImGui::Text("Output Position");
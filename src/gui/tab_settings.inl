@@ -158,6 +158,36 @@ if (ImGui::BeginTabItem("[S] Settings")) {
         if (ImGui::SliderFloat("Profiler Scale", &g_config.debug.profilerScale, 0.25f, 2.0f, "%.2f")) { g_configIsDirty = true; }
         ImGui::SameLine();
         HelpMarker("Scale of the profiler overlay\n25% = tiny, 50% = half size, 100% = normal, 200% = double size");
+        {
+            const bool capturing = Profiler::GetInstance().IsTraceCaptureActive();
+            if (ImGui::Button(capturing ? "Capturing Trace..." : "Capture Trace") && !capturing) { StartProfilerTraceCapture(); }
+            ImGui::SameLine();
+            ImGui::SetNextItemWidth(150);
+            if (ImGui::SliderInt("Trace Length (s)", &g_config.debug.traceCaptureSeconds, 1, 60)) { g_configIsDirty = true; }
+            ImGui::SameLine();
+            HelpMarker("Records every profiled scope on every thread and saves a timeline to\n"
+                       "logs/trace-<date>-<time>.json. Open it in ui.perfetto.dev or chrome://tracing\n"
+                       "to see when a stutter happened and what each thread was doing.\n\n"
+                       "Works even while the profiler overlay is hidden.");
+
+            ImGui::PushID("trace_hotkey");
+            std::string traceKeyStr = GetKeyComboString(g_config.debug.traceCaptureHotkey);
+            const char* traceButtonLabel =
+                (s_mainHotkeyToBind == -998) ? "[Press Keys...]" : (traceKeyStr.empty() ? "[None]" : traceKeyStr.c_str());
+            ImGui::Text("Trace Capture Hotkey:");
+            ImGui::SameLine();
+            if (ImGui::Button(traceButtonLabel)) {
+                s_mainHotkeyToBind = -998; // Special ID for trace capture hotkey
+                s_altHotkeyToBind = { -1, -1 };
+                s_exclusionToBind = { -1, -1 };
+            }
+            ImGui::SameLine();
+            if (ImGui::Button("Clear")) {
+                g_config.debug.traceCaptureHotkey.clear();
+                g_configIsDirty = true;
+            }
+            ImGui::PopID();
+        }
         if (ImGui::Checkbox("Show Hotkey Debug", &g_config.debug.showHotkeyDebug)) { g_configIsDirty = true; }
         if (ImGui::Checkbox("Fake Cursor Overlay", &g_config.debug.fakeCursor)) { g_configIsDirty = true; }
         ImGui::SameLine();
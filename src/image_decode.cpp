@@ -0,0 +1,297 @@
+#include "image_decode.h"
+
+#include <chrono>
+#include <climits>
+#include <cstring>
+
+// The stb_image implementation lives here: frame-by-frame GIF decoding needs its internal GIF reader
+#define STB_IMAGE_IMPLEMENTATION
+#include "stb_image.h"
+
+#ifdef _WIN32
+#include <Windows.h>
+#endif
+
+namespace {
+
+std::atomic<size_t> s_streamedBytesInFlight{ 0 };
+
+bool IsCancelled(const std::atomic<bool>* cancel) { return cancel && cancel->load(std::memory_order_relaxed); }
+
+// Collects decoded frames and delivers them either as one whole image or, past the stream threshold, as parts
+class FrameSink {
+  public:
+    FrameSink(const ImageDecodeLimits& limits, const std::atomic<bool>* cancel, const std::function<void(DecodedImagePart&&)>& onPart)
+        : m_limits(limits), m_cancel(cancel), m_onPart(onPart), m_current(std::make_unique<DecodedImage>()) {}
+
+    // `rgba` is top row first, as decoded; stored bottom row first
+    void Add(const uint8_t* rgba, int width, int height, int delayMs) {
+        const size_t rowBytes = static_cast<size_t>(width) * 4;
+        const size_t frameBytes = rowBytes * height;
+        m_totalBytes += frameBytes;
+        if (!m_streaming && m_totalBytes > m_limits.streamThresholdBytes) m_streaming = true;
+        if (m_streaming && !m_current->frames.empty() && m_current->ByteSize() + frameBytes > m_limits.streamPartBytes) Deliver(false);
+        if (m_current->frames.empty()) {
+            m_current->width = width;
+            m_current->height = height;
+        }
+
+        std::vector<uint8_t> frame(frameBytes);
+        for (int y = 0; y < height; y++) {
+            std::memcpy(frame.data() + static_cast<size_t>(height - 1 - y) * rowBytes, rgba + static_cast<size_t>(y) * rowBytes, rowBytes);
+        }
+        m_current->frames.push_back(std::move(frame));
+        m_current->frameDelays.push_back(delayMs > 0 ? delayMs : 100);
+    }
+
+    bool HasFrames() const { return m_delivered > 0 || !m_current->frames.empty(); }
+
+    void Finish() {
+        if (!m_current->frames.empty()) Deliver(true);
+    }
+
+  private:
+    void Deliver(bool last) {
+        DecodedImagePart part;
+        part.firstFrame = m_delivered;
+        part.lastPart = last;
+        m_delivered += m_current->frames.size();
+
+        // Only a decode split into several parts is streamed. An image delivered whole (e.g. one frame past the
+        // threshold) may be cached and live on indefinitely, so it must not count against the in-flight budget.
+        if (m_streaming && !part.IsWhole()) {
+            // Back-pressure: let the uploader catch up before handing over more frames (a part always goes through
+            // when nothing else is pending, however large)
+            const size_t bytes = m_current->ByteSize();
+            while (s_streamedBytesInFlight.load(std::memory_order_acquire) > 0 &&
+                   s_streamedBytesInFlight.load(std::memory_order_acquire) + bytes > m_limits.maxStreamedBytesInFlight &&
+                   !IsCancelled(m_cancel)) {
+                std::this_thread::sleep_for(std::chrono::milliseconds(2));
+            }
+            s_streamedBytesInFlight.fetch_add(bytes, std::memory_order_acq_rel);
+            part.image = std::shared_ptr<const DecodedImage>(m_current.release(), [bytes](const DecodedImage* image) {
+                s_streamedBytesInFlight.fetch_sub(bytes, std::memory_order_acq_rel);
+                delete image;
+            });
+        } else {
+            part.image = std::shared_ptr<const DecodedImage>(m_current.release());
+        }
+        m_current = std::make_unique<DecodedImage>();
+        m_onPart(std::move(part));
+    }
+
+    const ImageDecodeLimits& m_limits;
+    const std::atomic<bool>* m_cancel;
+    const std::function<void(DecodedImagePart&&)>& m_onPart;
+    std::unique_ptr<DecodedImage> m_current;
+    size_t m_delivered = 0; // Frames handed out so far
+    size_t m_totalBytes = 0;
+    bool m_streaming = false;
+};
+
+// Same compositing as stbi_load_gif_from_memory, but each frame is handed out as soon as it is decoded instead of
+// being appended to one buffer that is reallocated per frame
+bool DecodeGifFrames(stbi__context& context, FrameSink& sink, const std::atomic<bool>* cancel, std::string& error) {
+    stbi__gif gif;
+    std::memset(&gif, 0, sizeof(gif));
+    int comp = 0;
+    // Composited output of the previous two frames; "restore to previous" disposal reverts to the older one
+    std::vector<uint8_t> previous, twoBack;
+    size_t frameCount = 0;
+    bool cancelled = false;
+
+    while (true) {
+        if (IsCancelled(cancel)) {
+            cancelled = true;
+            break;
+        }
+        stbi_uc* frame = stbi__gif_load_next(&context, &gif, &comp, 4, frameCount >= 2 ? twoBack.data() : nullptr);
+        if (frame == reinterpret_cast<stbi_uc*>(&context) || !frame) break; // End marker, or an error (kept as the end if frames exist)
+
+        const size_t frameBytes = static_cast<size_t>(gif.w) * gif.h * 4;
+        sink.Add(frame, gif.w, gif.h, gif.delay);
+        twoBack.swap(previous);
+        previous.assign(frame, frame + frameBytes);
+        frameCount++;
+    }
+
+    STBI_FREE(gif.out);
+    STBI_FREE(gif.history);
+    STBI_FREE(gif.background);
+
+    if (cancelled) {
+        error = "cancelled";
+        return false;
+    }
+    if (frameCount == 0) {
+        error = stbi_failure_reason() ? stbi_failure_reason() : "no frames";
+        return false;
+    }
+    return true;
+}
+
+} // namespace
+
+bool DecodeImage(const uint8_t* data, size_t size, const ImageDecodeLimits& limits, const std::atomic<bool>* cancel,
+                 const std::function<void(DecodedImagePart&& part)>& onPart, std::string& error) {
+    if (!data || size == 0 || size > static_cast<size_t>(INT_MAX)) {
+        error = "empty or oversized file";
+        return false;
+    }
+
+    // Frames are flipped while being copied out, so stb's (possibly global) flip setting must stay off here
+    stbi_set_flip_vertically_on_load_thread(0);
+    FrameSink sink(limits, cancel, onPart);
+
+    stbi__context context;
+    stbi__start_mem(&context, data, static_cast<int>(size));
+    if (stbi__gif_test(&context)) {
+        const bool ok = DecodeGifFrames(context, sink, cancel, error);
+        if (!ok && !sink.HasFrames()) return false;
+        if (IsCancelled(cancel)) return false;
+        sink.Finish();
+        return true;
+    }
+
+    int width = 0, height = 0, channels = 0;
+    stbi_uc* pixels = stbi_load_from_memory(data, static_cast<int>(size), &width, &height, &channels, 4);
+    if (!pixels || width <= 0 || height <= 0) {
+        error = stbi_failure_reason() ? stbi_failure_reason() : "unknown error";
+        if (pixels) stbi_image_free(pixels);
+        return false;
+    }
+    sink.Add(pixels, width, height, 0);
+    stbi_image_free(pixels);
+    sink.Finish();
+    return true;
+}
+
+size_t StreamedImageBytesInFlight() { return s_streamedBytesInFlight.load(std::memory_order_acquire); }
+
+ImageContentKey MakeImageContentKey(const uint8_t* data, size_t size) {
+    // FNV-1a over 64-bit words (then the tail bytes), with a final avalanche; the size is part of the key as well
+    uint64_t hash = 0xcbf29ce484222325ull;
+    size_t i = 0;
+    for (; i + 8 <= size; i += 8) {
+        uint64_t word;
+        std::memcpy(&word, data + i, 8);
+        hash = (hash ^ word) * 0x100000001b3ull;
+    }
+    for (; i < size; i++) hash = (hash ^ data[i]) * 0x100000001b3ull;
+    hash ^= hash >> 33;
+    hash *= 0xff51afd7ed558ccdull;
+    hash ^= hash >> 33;
+
+    ImageContentKey key;
+    key.hash = hash;
+    key.size = size;
+    return key;
+}
+
+DecodedImageCache::DecodedImageCache(size_t byteBudget) : m_byteBudget(byteBudget) {}
+
+std::shared_ptr<const DecodedImage> DecodedImageCache::GetOrDecode(const ImageContentKey& key,
+                                                                   const std::function<std::shared_ptr<const DecodedImage>()>& decode,
+                                                                   bool& ranDecode) {
+    ranDecode = false;
+    {
+        std::unique_lock<std::mutex> lock(m_mutex);
+        while (true) {
+            auto it = m_entries.find(key);
+            if (it != m_entries.end()) {
+                m_lru.splice(m_lru.begin(), m_lru, it->second.lruPosition);
+                return it->second.image;
+            }
+            if (m_decoding.insert(key).second) break;
+            m_decodeDone.wait(lock);
+        }
+    }
+
+    ranDecode = true;
+    std::shared_ptr<const DecodedImage> image;
+    try {
+        image = decode();
+    } catch (...) {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        m_decoding.erase(key);
+        m_decodeDone.notify_all();
+        throw;
+    }
+
+    std::lock_guard<std::mutex> lock(m_mutex);
+    m_decoding.erase(key);
+    if (image) InsertLocked(key, image);
+    m_decodeDone.notify_all();
+    return image;
+}
+
+void DecodedImageCache::InsertLocked(const ImageContentKey& key, std::shared_ptr<const DecodedImage> image) {
+    const size_t bytes = image->ByteSize();
+    if (bytes > m_byteBudget || m_entries.count(key)) return;
+
+    while (!m_lru.empty() && m_bytesUsed + bytes > m_byteBudget) {
+        auto oldest = m_entries.find(m_lru.back());
+        m_bytesUsed -= oldest->second.image->ByteSize();
+        m_entries.erase(oldest);
+        m_lru.pop_back();
+    }
+    m_lru.push_front(key);
+    m_entries[key] = Entry{ std::move(image), m_lru.begin() };
+    m_bytesUsed += bytes;
+}
+
+void DecodedImageCache::Clear() {
+    std::lock_guard<std::mutex> lock(m_mutex);
+    m_entries.clear();
+    m_lru.clear();
+    m_bytesUsed = 0;
+}
+
+size_t DecodedImageCache::BytesUsed() const {
+    std::lock_guard<std::mutex> lock(m_mutex);
+    return m_bytesUsed;
+}
+
+ImageDecodePool::ImageDecodePool(size_t threadCount) {
+    for (size_t i = 0; i < threadCount; i++) m_threads.emplace_back(&ImageDecodePool::WorkerMain, this);
+}
+
+ImageDecodePool::~ImageDecodePool() { Shutdown(); }
+
+void ImageDecodePool::Submit(std::function<void()> job) {
+    {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        if (m_stop) return;
+        m_jobs.push_back(std::move(job));
+    }
+    m_wake.notify_one();
+}
+
+void ImageDecodePool::Shutdown() {
+    {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        m_stop = true;
+        m_jobs.clear();
+    }
+    m_wake.notify_all();
+    for (std::thread& thread : m_threads) {
+        if (thread.joinable()) thread.join();
+    }
+}
+
+void ImageDecodePool::WorkerMain() {
+#ifdef _WIN32
+    SetThreadPriority(GetCurrentThread(), THREAD_PRIORITY_BELOW_NORMAL);
+#endif
+    while (true) {
+        std::function<void()> job;
+        {
+            std::unique_lock<std::mutex> lock(m_mutex);
+            m_wake.wait(lock, [&] { return m_stop || !m_jobs.empty(); });
+            if (m_stop) return;
+            job = std::move(m_jobs.front());
+            m_jobs.pop_front();
+        }
+        job();
+    }
+}
@@ -0,0 +1,120 @@
+#pragma once
+
+#include <atomic>
+#include <condition_variable>
+#include <cstddef>
+#include <cstdint>
+#include <deque>
+#include <functional>
+#include <list>
+#include <map>
+#include <memory>
+#include <mutex>
+#include <set>
+#include <string>
+#include <thread>
+#include <vector>
+
+// Background image decoding for backgrounds and user images: a bounded worker pool, a decoded-image cache keyed by
+// file content (so the same file used by several modes or images is decoded once) and frame-by-frame GIF decoding.
+// Large animations are delivered in parts as they decode instead of as one buffer. Platform-neutral; the upload
+// side lives in render.cpp.
+
+// One image, or a run of consecutive frames of one
+struct DecodedImage {
+    int width = 0; // One frame
+    int height = 0;
+    std::vector<std::vector<uint8_t>> frames; // RGBA8, bottom row first (OpenGL order)
+    std::vector<int> frameDelays;             // ms, one per frame
+
+    size_t ByteSize() const { return frames.size() * static_cast<size_t>(width) * height * 4; }
+};
+
+// One delivery of a decode. Images within ImageDecodeLimits::streamThresholdBytes arrive whole (firstFrame 0 and
+// lastPart), as does a single frame of any size; larger animations arrive as several parts of consecutive frames.
+struct DecodedImagePart {
+    std::shared_ptr<const DecodedImage> image;
+    size_t firstFrame = 0;
+    bool lastPart = true;
+
+    bool IsWhole() const { return firstFrame == 0 && lastPart; }
+};
+
+struct ImageDecodeLimits {
+    size_t streamThresholdBytes = 64u << 20;      // Decoded size past which an animation is streamed (and not cached)
+    size_t streamPartBytes = 8u << 20;            // Target size of each streamed part
+    size_t maxStreamedBytesInFlight = 96u << 20;  // Decoding pauses while delivered parts this large are unreleased
+};
+
+// Decodes an encoded image (anything stb_image reads; GIFs one frame at a time) and hands every part to `onPart` in
+// frame order. Returns false with `error` set when the data can't be decoded or `cancel` became true; parts already
+// delivered stay valid.
+bool DecodeImage(const uint8_t* data, size_t size, const ImageDecodeLimits& limits, const std::atomic<bool>* cancel,
+                 const std::function<void(DecodedImagePart&& part)>& onPart, std::string& error);
+
+// Bytes held by streamed parts (those of a decode delivered in several parts) that have not been released yet
+size_t StreamedImageBytesInFlight();
+
+struct ImageContentKey {
+    uint64_t hash = 0;
+    uint64_t size = 0;
+    bool operator<(const ImageContentKey& other) const { return hash != other.hash ? hash < other.hash : size < other.size; }
+};
+
+ImageContentKey MakeImageContentKey(const uint8_t* data, size_t size);
+
+// LRU cache of whole decoded images within a byte budget. Thread-safe.
+class DecodedImageCache {
+  public:
+    explicit DecodedImageCache(size_t byteBudget);
+
+    // Returns the image cached for `key`. On a miss, runs `decode`, then caches what it returns (nullptr: nothing to
+    // cache, e.g. a streamed or failed decode). Only one caller decodes a key at a time; others wait for it and then
+    // look again, so images submitted together with the same content decode once. `ranDecode` tells which happened.
+    std::shared_ptr<const DecodedImage> GetOrDecode(const ImageContentKey& key,
+                                                    const std::function<std::shared_ptr<const DecodedImage>()>& decode, bool& ranDecode);
+
+    void Clear();
+    size_t BytesUsed() const;
+
+  private:
+    struct Entry {
+        std::shared_ptr<const DecodedImage> image;
+        std::list<ImageContentKey>::iterator lruPosition;
+    };
+
+    void InsertLocked(const ImageContentKey& key, std::shared_ptr<const DecodedImage> image);
+
+    const size_t m_byteBudget;
+    mutable std::mutex m_mutex;
+    std::condition_variable m_decodeDone;
+    std::map<ImageContentKey, Entry> m_entries;
+    std::list<ImageContentKey> m_lru; // Most recently used first
+    std::set<ImageContentKey> m_decoding;
+    size_t m_bytesUsed = 0;
+};
+
+// Fixed set of worker threads running submitted jobs in FIFO order
+class ImageDecodePool {
+  public:
+    explicit ImageDecodePool(size_t threadCount);
+    ~ImageDecodePool();
+    ImageDecodePool(const ImageDecodePool&) = delete;
+    ImageDecodePool& operator=(const ImageDecodePool&) = delete;
+
+    void Submit(std::function<void()> job);
+
+    // Drops queued jobs and joins the workers. Running jobs should watch their own cancel flag to finish quickly.
+    void Shutdown();
+
+    size_t ThreadCount() const { return m_threads.size(); }
+
+  private:
+    void WorkerMain();
+
+    std::vector<std::thread> m_threads;
+    std::mutex m_mutex;
+    std::condition_variable m_wake;
+    std::deque<std::function<void()>> m_jobs;
+    bool m_stop = false;
+};
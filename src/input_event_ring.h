@@ -0,0 +1,101 @@
+#pragma once
+
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <type_traits>
+
+// Compact input event published by the game's message thread for consumers that don't need to
+// influence the consume/passthrough decision. Platform-neutral: message/key values are opaque here.
+enum class InputEventKind : uint8_t {
+    KeyDown,
+    KeyUp,
+    StrongholdPanelHotkey,  // H / Shift+H / Ctrl+Shift+H (modifiers in flags)
+    StrongholdNumpadHotkey, // key = numpad virtual key
+};
+
+enum InputEventFlags : uint8_t {
+    InputEventFlag_Shift = 1 << 0,
+    InputEventFlag_Ctrl = 1 << 1,
+    InputEventFlag_Alt = 1 << 2,
+};
+
+struct InputEvent {
+    uint64_t timestampNs = 0; // steady_clock nanoseconds at publish time
+    uint32_t key = 0;
+    int32_t x = 0;
+    int32_t y = 0;
+    InputEventKind kind = InputEventKind::KeyDown;
+    uint8_t flags = 0;
+};
+
+// Bounded lock-free multi-producer / single-consumer ring (Vyukov sequence-per-cell scheme).
+// Producers never block: TryPush fails when the ring is full and the drop is counted.
+template <typename T, size_t Capacity> class MpscRing {
+    static_assert(Capacity >= 2 && (Capacity & (Capacity - 1)) == 0, "Capacity must be a power of two");
+    static_assert(std::is_trivially_copyable_v<T>, "Ring payload must be trivially copyable");
+
+  public:
+    MpscRing() {
+        for (size_t i = 0; i < Capacity; ++i) { m_cells[i].sequence.store(i, std::memory_order_relaxed); }
+    }
+
+    MpscRing(const MpscRing&) = delete;
+    MpscRing& operator=(const MpscRing&) = delete;
+
+    bool TryPush(const T& value) {
+        size_t pos = m_enqueuePos.load(std::memory_order_relaxed);
+        for (;;) {
+            Cell& cell = m_cells[pos & (Capacity - 1)];
+            const size_t seq = cell.sequence.load(std::memory_order_acquire);
+            const intptr_t diff = static_cast<intptr_t>(seq) - static_cast<intptr_t>(pos);
+            if (diff == 0) {
+                if (m_enqueuePos.compare_exchange_weak(pos, pos + 1, std::memory_order_relaxed)) {
+                    cell.value = value;
+                    cell.sequence.store(pos + 1, std::memory_order_release);
+                    return true;
+                }
+            } else if (diff < 0) {
+                m_dropped.fetch_add(1, std::memory_order_relaxed);
+                return false;
+            } else {
+                pos = m_enqueuePos.load(std::memory_order_relaxed);
+            }
+        }
+    }
+
+    // Single consumer only
+    bool TryPop(T& out) {
+        Cell& cell = m_cells[m_dequeuePos & (Capacity - 1)];
+        const size_t seq = cell.sequence.load(std::memory_order_acquire);
+        if (static_cast<intptr_t>(seq) - static_cast<intptr_t>(m_dequeuePos + 1) < 0) return false;
+        out = cell.value;
+        cell.sequence.store(m_dequeuePos + Capacity, std::memory_order_release);
+        ++m_dequeuePos;
+        return true;
+    }
+
+    // Pops up to maxCount events, invoking fn for each. Returns the number consumed.
+    template <typename Fn> size_t Drain(Fn&& fn, size_t maxCount = Capacity) {
+        size_t count = 0;
+        T value;
+        while (count < maxCount && TryPop(value)) {
+            fn(value);
+            ++count;
+        }
+        return count;
+    }
+
+    uint64_t DroppedCount() const { return m_dropped.load(std::memory_order_relaxed); }
+
+  private:
+    struct alignas(64) Cell {
+        std::atomic<size_t> sequence{ 0 };
+        T value{};
+    };
+
+    Cell m_cells[Capacity];
+    alignas(64) std::atomic<size_t> m_enqueuePos{ 0 };
+    alignas(64) size_t m_dequeuePos = 0;
+    alignas(64) std::atomic<uint64_t> m_dropped{ 0 };
+};
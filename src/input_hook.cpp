@@ -2,6 +2,7 @@
 
 #include "fake_cursor.h"
 #include "gui.h"
+#include "key_rebind_table.h"
 #include "logic_thread.h"
 #include "notes_overlay.h"
 #include "practice_world_launch.h"
@@ -58,6 +59,9 @@ namespace {
 
 std::atomic<bool> g_macrosEnabledRuntime = true;
 
+// Producers: WndProc (game message thread). Consumer: logic thread.
+MpscRing<InputEvent, 1024> g_inputEventRing;
+
 bool IsInWorldGameState(const std::string& gameState) { return gameState.find("inworld") != std::string::npos; }
 
 void ClearTriggerOnReleaseState() {
@@ -269,6 +273,16 @@ InputHandlerResult HandleImGuiInput(HWND hWnd, UINT uMsg, WPARAM wParam, LPARAM
     return { false, 0 };
 }
 
+InputHandlerResult HandleProfilerTraceHotkey(UINT uMsg, WPARAM wParam, LPARAM lParam) {
+    if (uMsg != WM_KEYDOWN || (lParam & (1 << 30))) { return { false, 0 }; } // Ignore auto-repeat
+
+    auto cfgSnap = GetConfigSnapshot();
+    if (!cfgSnap || !CheckHotkeyMatch(cfgSnap->debug.traceCaptureHotkey, wParam)) { return { false, 0 }; }
+
+    StartProfilerTraceCapture();
+    return { false, 0 }; // Never swallow the key - capturing is a side effect
+}
+
 InputHandlerResult HandleGuiToggle(HWND hWnd, UINT uMsg, WPARAM wParam, LPARAM lParam) {
     PROFILE_SCOPE("HandleGuiToggle");
 
@@ -399,14 +413,24 @@ InputHandlerResult HandleStrongholdOverlayHotkey(HWND hWnd, UINT uMsg, WPARAM wP
     // Ignore key-repeat events so one key hold doesn't toggle multiple times.
     if ((lParam & (1LL << 30)) != 0) { return { true, 1 }; }
 
+    // Only the consume decision is made here; the overlay state update runs on the logic thread so the
+    // message thread never waits on the stronghold overlay mutex. Fall back to inline handling if the ring is full.
+    auto cfgSnap = GetConfigSnapshot();
+    if (!cfgSnap || !cfgSnap->strongholdOverlay.enabled) { return { false, 0 }; }
+
     if (isNumpadHotkey) {
-        if (!HandleStrongholdOverlayNumpadHotkey(mappedNumpadHotkey)) { return { false, 0 }; }
+        if (!PublishInputEvent(InputEventKind::StrongholdNumpadHotkey, static_cast<uint32_t>(mappedNumpadHotkey))) {
+            HandleStrongholdOverlayNumpadHotkey(mappedNumpadHotkey);
+        }
         return { true, 1 };
     }
 
     bool shiftDown = (GetAsyncKeyState(VK_SHIFT) & 0x8000) != 0;
     bool ctrlDown = (GetAsyncKeyState(VK_CONTROL) & 0x8000) != 0;
-    if (!HandleStrongholdOverlayHotkeyH(shiftDown, ctrlDown)) { return { false, 0 }; }
+    const uint8_t flags = (shiftDown ? InputEventFlag_Shift : 0) | (ctrlDown ? InputEventFlag_Ctrl : 0);
+    if (!PublishInputEvent(InputEventKind::StrongholdPanelHotkey, static_cast<uint32_t>(wParam), flags)) {
+        HandleStrongholdOverlayHotkeyH(shiftDown, ctrlDown);
+    }
     return { true, 1 };
 }
 
@@ -722,7 +746,9 @@ InputHandlerResult HandleHotkeys(HWND hWnd, UINT uMsg, WPARAM wParam, LPARAM lPa
 
     if (uMsg == WM_KEYDOWN || uMsg == WM_SYSKEYDOWN || uMsg == WM_KEYUP || uMsg == WM_SYSKEYUP) {
         const bool isDown = (uMsg == WM_KEYDOWN || uMsg == WM_SYSKEYDOWN);
-        ReportStrongholdLiveKeyState(static_cast<int>(wParam), isDown);
+        if (!PublishInputEvent(isDown ? InputEventKind::KeyDown : InputEventKind::KeyUp, static_cast<uint32_t>(wParam))) {
+            ReportStrongholdLiveKeyState(static_cast<int>(wParam), isDown);
+        }
     }
 
     // Determine the virtual key code based on message type
@@ -1164,35 +1190,67 @@ static bool TryTranslateVkToChar(DWORD vkCode, bool shiftDown, WCHAR& outChar) {
     return false;
 }
 
-static bool RebindKeyMatchesInput(DWORD inputVkCode, DWORD configuredFromKey, bool isKeyDown) {
-    if (inputVkCode == configuredFromKey) return true;
-
-    auto matchesModifierFamily = [&](DWORD genericKey, DWORD leftKey, DWORD rightKey) {
-        const bool inputIsGeneric = (inputVkCode == genericKey);
-        const bool inputIsSpecific = (inputVkCode == leftKey || inputVkCode == rightKey);
-        const bool fromIsGeneric = (configuredFromKey == genericKey);
-        const bool fromIsSpecific = (configuredFromKey == leftKey || configuredFromKey == rightKey);
-
-        if (!(inputIsGeneric || inputIsSpecific) || !(fromIsGeneric || fromIsSpecific)) return false;
+// Rebinds compiled from one config snapshot + keyboard layout. Only touched on the window thread.
+struct CompiledCharRebind {
+    WCHAR fromUnshifted = 0;
+    WCHAR fromShifted = 0;
+    WCHAR outputUnshifted = 0; // Output char when the unshifted source char matched (0 = no mapping)
+    WCHAR outputShifted = 0;   // Output char when the shifted source char matched (0 = no mapping)
+    bool onlyInWorld = false;
+};
+
+struct CompiledRebinds {
+    std::shared_ptr<const Config> source;
+    HKL keyboardLayout = nullptr;
+    KeyRebindTable keys;
+    std::vector<CompiledCharRebind> chars;
+};
+
+// Resolves output scan codes and WM_CHAR translations once, instead of calling MapVirtualKey / ToUnicodeEx
+// for every rebind on every key message. Rebuilt when the config snapshot or keyboard layout changes.
+static const CompiledRebinds& GetCompiledRebinds(const std::shared_ptr<const Config>& cfg) {
+    static CompiledRebinds s_compiled;
+    const HKL keyboardLayout = GetKeyboardLayout(0);
+    if (s_compiled.source == cfg && s_compiled.keyboardLayout == keyboardLayout) { return s_compiled; }
+
+    PROFILE_SCOPE("CompileKeyRebinds");
+    s_compiled.source = cfg;
+    s_compiled.keyboardLayout = keyboardLayout;
+    s_compiled.chars.clear();
+
+    std::vector<KeyRebindSpec> specs;
+    for (const auto& rebind : cfg->keyRebinds.rebinds) {
+        if (!rebind.enabled || rebind.fromKey == 0 || rebind.toKey == 0) continue;
 
-        // Windows often reports generic modifier VKs in message wParam.
-        // For key-down, verify the configured specific side is actually down.
-        if (inputIsGeneric && fromIsSpecific) {
-            if (isKeyDown) return (GetAsyncKeyState(configuredFromKey) & 0x8000) != 0;
-            return true;
+        KeyRebindSpec spec;
+        spec.fromKey = rebind.fromKey;
+        spec.onlyInWorld = rebind.onlyInWorld;
+        if (rebind.useCustomOutput) {
+            spec.outputVk = (rebind.customOutputVK != 0) ? rebind.customOutputVK : rebind.toKey;
+            spec.outputScanCode = ResolveOutputScanCode(spec.outputVk, rebind.customOutputScanCode);
+        } else {
+            spec.outputVk = rebind.toKey;
+            spec.outputScanCode = GetScanCodeWithExtendedFlag(rebind.toKey);
         }
-
-        // If Windows reports specific side while config uses generic modifier, accept it.
-        if (inputIsSpecific && fromIsGeneric) return true;
-
-        return false;
-    };
-
-    if (matchesModifierFamily(VK_CONTROL, VK_LCONTROL, VK_RCONTROL)) return true;
-    if (matchesModifierFamily(VK_SHIFT, VK_LSHIFT, VK_RSHIFT)) return true;
-    if (matchesModifierFamily(VK_MENU, VK_LMENU, VK_RMENU)) return true;
-
-    return false;
+        specs.push_back(spec);
+
+        CompiledCharRebind charRebind;
+        charRebind.onlyInWorld = rebind.onlyInWorld;
+        TryTranslateVkToChar(rebind.fromKey, false, charRebind.fromUnshifted);
+        TryTranslateVkToChar(rebind.fromKey, true, charRebind.fromShifted);
+        if (charRebind.fromUnshifted == 0 && charRebind.fromShifted == 0) continue;
+
+        const DWORD outputVK = rebind.useCustomOutput ? rebind.customOutputVK : rebind.toKey;
+        WCHAR outputUnshifted = 0;
+        TryTranslateVkToChar(outputVK, false, outputUnshifted);
+        charRebind.outputUnshifted = outputUnshifted;
+        // Fallback: use the unshifted mapping if the shifted equivalent doesn't exist
+        WCHAR outputShifted = 0;
+        charRebind.outputShifted = (TryTranslateVkToChar(outputVK, true, outputShifted) && outputShifted != 0) ? outputShifted : outputUnshifted;
+        s_compiled.chars.push_back(charRebind);
+    }
+    s_compiled.keys.Build(std::move(specs));
+    return s_compiled;
 }
 
 static bool IsInWorldStateForRebinds() {
@@ -1259,66 +1317,61 @@ InputHandlerResult HandleKeyRebinding(HWND hWnd, UINT uMsg, WPARAM wParam, LPARA
     const bool isInWorldState = IsInWorldStateForRebinds();
     if (rebindCfg->keyRebinds.globalOnlyInWorld && !isInWorldState) { return { false, 0 }; }
 
-    for (size_t i = 0; i < rebindCfg->keyRebinds.rebinds.size(); ++i) {
-        const auto& rebind = rebindCfg->keyRebinds.rebinds[i];
+    const CompiledRebinds& compiled = GetCompiledRebinds(rebindCfg);
+    for (const KeyRebindCandidate& candidate : compiled.keys.Candidates(vkCode)) {
+        const KeyRebindSpec& rebind = compiled.keys.Spec(candidate.specIndex);
         if (rebind.onlyInWorld && !isInWorldState) { continue; }
 
-        if (rebind.enabled && rebind.fromKey != 0 && rebind.toKey != 0 && RebindKeyMatchesInput(vkCode, rebind.fromKey, isKeyDown)) {
-            DWORD outputVK;
-            UINT outputScanCode;
-
-            if (rebind.useCustomOutput) {
-                outputVK = (rebind.customOutputVK != 0) ? rebind.customOutputVK : rebind.toKey;
-                outputScanCode = ResolveOutputScanCode(outputVK, rebind.customOutputScanCode);
-            } else {
-                outputVK = rebind.toKey;
-                outputScanCode = GetScanCodeWithExtendedFlag(rebind.toKey);
-            }
-
-            // For mouse button output, synthesize the appropriate mouse message
-            if (outputVK == VK_LBUTTON || outputVK == VK_RBUTTON || outputVK == VK_MBUTTON || outputVK == VK_XBUTTON1 ||
-                outputVK == VK_XBUTTON2) {
-                UINT newMsg = 0;
-                WPARAM newWParam = wParam;
-
-                if (outputVK == VK_LBUTTON) {
-                    newMsg = isKeyDown ? WM_LBUTTONDOWN : WM_LBUTTONUP;
-                } else if (outputVK == VK_RBUTTON) {
-                    newMsg = isKeyDown ? WM_RBUTTONDOWN : WM_RBUTTONUP;
-                } else if (outputVK == VK_MBUTTON) {
-                    newMsg = isKeyDown ? WM_MBUTTONDOWN : WM_MBUTTONUP;
-                } else if (outputVK == VK_XBUTTON1) {
-                    newMsg = isKeyDown ? WM_XBUTTONDOWN : WM_XBUTTONUP;
-                    newWParam = MAKEWPARAM(LOWORD(wParam), XBUTTON1);
-                } else if (outputVK == VK_XBUTTON2) {
-                    newMsg = isKeyDown ? WM_XBUTTONDOWN : WM_XBUTTONUP;
-                    newWParam = MAKEWPARAM(LOWORD(wParam), XBUTTON2);
-                }
-
-                return { true, CallWindowProc(g_originalWndProc, hWnd, newMsg, newWParam, lParam) };
+        // Windows often reports generic modifier VKs in message wParam.
+        // For key-down, verify the configured specific side is actually down.
+        if (candidate.requiresSideCheck && isKeyDown && (GetAsyncKeyState(static_cast<int>(rebind.fromKey)) & 0x8000) == 0) { continue; }
+
+        const DWORD outputVK = rebind.outputVk;
+        const UINT outputScanCode = rebind.outputScanCode;
+
+        // For mouse button output, synthesize the appropriate mouse message
+        if (outputVK == VK_LBUTTON || outputVK == VK_RBUTTON || outputVK == VK_MBUTTON || outputVK == VK_XBUTTON1 ||
+            outputVK == VK_XBUTTON2) {
+            UINT newMsg = 0;
+            WPARAM newWParam = wParam;
+
+            if (outputVK == VK_LBUTTON) {
+                newMsg = isKeyDown ? WM_LBUTTONDOWN : WM_LBUTTONUP;
+            } else if (outputVK == VK_RBUTTON) {
+                newMsg = isKeyDown ? WM_RBUTTONDOWN : WM_RBUTTONUP;
+            } else if (outputVK == VK_MBUTTON) {
+                newMsg = isKeyDown ? WM_MBUTTONDOWN : WM_MBUTTONUP;
+            } else if (outputVK == VK_XBUTTON1) {
+                newMsg = isKeyDown ? WM_XBUTTONDOWN : WM_XBUTTONUP;
+                newWParam = MAKEWPARAM(LOWORD(wParam), XBUTTON1);
+            } else if (outputVK == VK_XBUTTON2) {
+                newMsg = isKeyDown ? WM_XBUTTONDOWN : WM_XBUTTONUP;
+                newWParam = MAKEWPARAM(LOWORD(wParam), XBUTTON2);
             }
 
-            // For keyboard output from keyboard/mouse input
-            const bool sourceIsAltFamily = IsAltFamilyKey(vkCode) || IsAltFamilyKey(rebind.fromKey);
-            const bool isSystemKeyMsg = (uMsg == WM_SYSKEYDOWN || uMsg == WM_SYSKEYUP) && !sourceIsAltFamily;
-            UINT outputMsg = isKeyDown ? (isSystemKeyMsg ? WM_SYSKEYDOWN : WM_KEYDOWN) : (isSystemKeyMsg ? WM_SYSKEYUP : WM_KEYUP);
-
-            UINT repeatCount = 1;
-            bool previousState = !isKeyDown;
-            bool transitionState = !isKeyDown;
-            if (!isMouseButton) {
-                repeatCount = static_cast<UINT>(lParam & 0xFFFF);
-                if (repeatCount == 0) repeatCount = 1;
-
-                // Mirror source-message semantics (especially for key repeat/down transitions).
-                previousState = ((lParam & (1LL << 30)) != 0);
-                transitionState = ((lParam & (1LL << 31)) != 0);
-            }
+            return { true, CallWindowProc(g_originalWndProc, hWnd, newMsg, newWParam, lParam) };
+        }
 
-            LPARAM newLParam =
-                BuildKeyboardMessageLParam(outputScanCode, isKeyDown, isSystemKeyMsg, repeatCount, previousState, transitionState);
-            return { true, CallWindowProc(g_originalWndProc, hWnd, outputMsg, outputVK, newLParam) };
+        // For keyboard output from keyboard/mouse input
+        const bool sourceIsAltFamily = IsAltFamilyKey(vkCode) || IsAltFamilyKey(rebind.fromKey);
+        const bool isSystemKeyMsg = (uMsg == WM_SYSKEYDOWN || uMsg == WM_SYSKEYUP) && !sourceIsAltFamily;
+        UINT outputMsg = isKeyDown ? (isSystemKeyMsg ? WM_SYSKEYDOWN : WM_KEYDOWN) : (isSystemKeyMsg ? WM_SYSKEYUP : WM_KEYUP);
+
+        UINT repeatCount = 1;
+        bool previousState = !isKeyDown;
+        bool transitionState = !isKeyDown;
+        if (!isMouseButton) {
+            repeatCount = static_cast<UINT>(lParam & 0xFFFF);
+            if (repeatCount == 0) repeatCount = 1;
+
+            // Mirror source-message semantics (especially for key repeat/down transitions).
+            previousState = ((lParam & (1LL << 30)) != 0);
+            transitionState = ((lParam & (1LL << 31)) != 0);
         }
+
+        LPARAM newLParam =
+            BuildKeyboardMessageLParam(outputScanCode, isKeyDown, isSystemKeyMsg, repeatCount, previousState, transitionState);
+        return { true, CallWindowProc(g_originalWndProc, hWnd, outputMsg, outputVK, newLParam) };
     }
     return { false, 0 };
 }
@@ -1334,46 +1387,43 @@ InputHandlerResult HandleCharRebinding(HWND hWnd, UINT uMsg, WPARAM wParam, LPAR
 
     WCHAR inputChar = static_cast<WCHAR>(wParam);
 
-    for (const auto& rebind : charRebindCfg->keyRebinds.rebinds) {
+    for (const auto& rebind : GetCompiledRebinds(charRebindCfg).chars) {
         if (rebind.onlyInWorld && !isInWorldState) continue;
-        if (!rebind.enabled || rebind.fromKey == 0 || rebind.toKey == 0) continue;
-
-        WCHAR fromUnshifted = 0;
-        WCHAR fromShifted = 0;
-        bool hasFromUnshifted = TryTranslateVkToChar(rebind.fromKey, false, fromUnshifted);
-        bool hasFromShifted = TryTranslateVkToChar(rebind.fromKey, true, fromShifted);
-
-        bool matched = false;
-        bool matchedShifted = false;
 
-        if (hasFromUnshifted && inputChar == fromUnshifted) {
-            matched = true;
-            matchedShifted = false;
-        } else if (hasFromShifted && inputChar == fromShifted) {
-            matched = true;
-            matchedShifted = true;
+        WCHAR outputChar = 0;
+        if (rebind.fromUnshifted != 0 && inputChar == rebind.fromUnshifted) {
+            outputChar = rebind.outputUnshifted;
+        } else if (rebind.fromShifted != 0 && inputChar == rebind.fromShifted) {
+            outputChar = rebind.outputShifted;
+        } else {
+            continue;
         }
+        if (outputChar == 0) continue;
 
-        if (matched) {
-            DWORD outputVK = rebind.useCustomOutput ? rebind.customOutputVK : rebind.toKey;
-
-            WCHAR outputChar = 0;
-            if (!TryTranslateVkToChar(outputVK, matchedShifted, outputChar) || outputChar == 0) {
-                // Fallback: try unshifted mapping if shifted equivalent doesn't exist
-                if (!TryTranslateVkToChar(outputVK, false, outputChar) || outputChar == 0) { continue; }
-            }
-
-            Log("[REBIND WM_CHAR] Remapping char code " + std::to_string(static_cast<unsigned int>(inputChar)) + " -> " +
-                std::to_string(static_cast<unsigned int>(outputChar)));
+        Log("[REBIND WM_CHAR] Remapping char code " + std::to_string(static_cast<unsigned int>(inputChar)) + " -> " +
+            std::to_string(static_cast<unsigned int>(outputChar)));
 
-            return { true, CallWindowProc(g_originalWndProc, hWnd, uMsg, outputChar, lParam) };
-        }
+        return { true, CallWindowProc(g_originalWndProc, hWnd, uMsg, outputChar, lParam) };
     }
     return { false, 0 };
 }
 
 bool AreMacrosRuntimeEnabled() { return g_macrosEnabledRuntime.load(std::memory_order_relaxed); }
 
+bool PublishInputEvent(InputEventKind kind, uint32_t key, uint8_t flags) {
+    InputEvent evt;
+    evt.timestampNs = static_cast<uint64_t>(
+        std::chrono::duration_cast<std::chrono::nanoseconds>(std::chrono::steady_clock::now().time_since_epoch()).count());
+    evt.kind = kind;
+    evt.key = key;
+    evt.flags = flags;
+    return g_inputEventRing.TryPush(evt);
+}
+
+bool PopInputEvent(InputEvent& outEvent) { return g_inputEventRing.TryPop(outEvent); }
+
+uint64_t GetDroppedInputEventCount() { return g_inputEventRing.DroppedCount(); }
+
 LRESULT CALLBACK SubclassedWndProc(HWND hWnd, UINT uMsg, WPARAM wParam, LPARAM lParam) {
     PROFILE_SCOPE("SubclassedWndProc");
 
@@ -1461,6 +1511,9 @@ LRESULT CALLBACK SubclassedWndProc(HWND hWnd, UINT uMsg, WPARAM wParam, LPARAM l
     if (g_isShuttingDown.load()) { return CallWindowProc(g_originalWndProc, hWnd, uMsg, wParam, lParam); }
 
     // --- Phase 6: GUI and Input Handling ---
+    result = HandleProfilerTraceHotkey(uMsg, wParam, lParam);
+    if (result.consumed) return result.result;
+
     result = HandleImGuiInput(hWnd, uMsg, wParam, lParam);
     if (result.consumed) return result.result;
 
@@ -1,5 +1,7 @@
 #pragma once
 
+#include "input_event_ring.h"
+
 #include <Windows.h>
 #include <string>
 
@@ -45,6 +47,9 @@ InputHandlerResult HandleSetCursor(HWND hWnd, UINT uMsg, WPARAM wParam, LPARAM l
 // Handle WM_DESTROY message
 InputHandlerResult HandleDestroy(HWND hWnd, UINT uMsg, WPARAM wParam, LPARAM lParam);
 
+// Start a profiler trace capture on the trace hotkey (never consumes the key)
+InputHandlerResult HandleProfilerTraceHotkey(UINT uMsg, WPARAM wParam, LPARAM lParam);
+
 // Handle ImGui input when GUI is open
 InputHandlerResult HandleImGuiInput(HWND hWnd, UINT uMsg, WPARAM wParam, LPARAM lParam);
 
@@ -76,6 +81,12 @@ InputHandlerResult HandleKeyRebinding(HWND hWnd, UINT uMsg, WPARAM wParam, LPARA
 // Handle WM_CHAR key rebinding
 InputHandlerResult HandleCharRebinding(HWND hWnd, UINT uMsg, WPARAM wParam, LPARAM lParam);
 
+// Input event bus: the WndProc publishes events whose handling doesn't affect consume/passthrough,
+// and the logic thread drains them each tick. Publish never blocks; it returns false when the ring is full.
+bool PublishInputEvent(InputEventKind kind, uint32_t key, uint8_t flags = 0);
+bool PopInputEvent(InputEvent& outEvent);
+uint64_t GetDroppedInputEventCount();
+
 // Runtime macro engine status (Ctrl+Shift+M toggle).
 bool AreMacrosRuntimeEnabled();
 
@@ -0,0 +1,54 @@
+#include "key_rebind_table.h"
+
+namespace {
+
+// Win32 virtual-key values for the modifier families (generic, left, right)
+struct ModifierFamily {
+    uint32_t generic;
+    uint32_t left;
+    uint32_t right;
+};
+constexpr ModifierFamily kModifierFamilies[] = {
+    { 0x10, 0xA0, 0xA1 }, // VK_SHIFT, VK_LSHIFT, VK_RSHIFT
+    { 0x11, 0xA2, 0xA3 }, // VK_CONTROL, VK_LCONTROL, VK_RCONTROL
+    { 0x12, 0xA4, 0xA5 }, // VK_MENU, VK_LMENU, VK_RMENU
+};
+
+// Mirrors RebindKeyMatchesInput: returns whether a rebind from `fromKey` can fire for `inputVk`
+bool MatchesInput(uint32_t inputVk, uint32_t fromKey, bool& outRequiresSideCheck) {
+    outRequiresSideCheck = false;
+    if (inputVk == fromKey) return true;
+
+    for (const auto& family : kModifierFamilies) {
+        const bool inputIsGeneric = inputVk == family.generic;
+        const bool inputIsSpecific = inputVk == family.left || inputVk == family.right;
+        const bool fromIsGeneric = fromKey == family.generic;
+        const bool fromIsSpecific = fromKey == family.left || fromKey == family.right;
+        if (!(inputIsGeneric || inputIsSpecific) || !(fromIsGeneric || fromIsSpecific)) continue;
+
+        if (inputIsGeneric && fromIsSpecific) {
+            outRequiresSideCheck = true;
+            return true;
+        }
+        if (inputIsSpecific && fromIsGeneric) return true;
+        return false;
+    }
+    return false;
+}
+
+} // namespace
+
+void KeyRebindTable::Build(std::vector<KeyRebindSpec> specs) {
+    m_specs = std::move(specs);
+    m_candidates.clear();
+
+    for (uint32_t vk = 0; vk < kKeyCount; ++vk) {
+        m_offsets[vk] = static_cast<uint32_t>(m_candidates.size());
+        for (size_t i = 0; i < m_specs.size() && i <= UINT16_MAX; ++i) {
+            bool requiresSideCheck = false;
+            if (!MatchesInput(vk, m_specs[i].fromKey, requiresSideCheck)) continue;
+            m_candidates.push_back({ static_cast<uint16_t>(i), requiresSideCheck });
+        }
+    }
+    m_offsets[kKeyCount] = static_cast<uint32_t>(m_candidates.size());
+}
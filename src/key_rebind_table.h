@@ -0,0 +1,47 @@
+#pragma once
+
+// Compiled key-rebind lookup table.
+// Built once per config snapshot so the WndProc resolves a rebind with a direct per-VK lookup instead of
+// scanning KeyRebindsConfig on every key message. Platform-neutral: virtual-key codes are plain integers and
+// scan codes are resolved by the caller before Build().
+
+#include <array>
+#include <cstdint>
+#include <span>
+#include <vector>
+
+struct KeyRebindSpec {
+    uint32_t fromKey = 0;
+    uint32_t outputVk = 0;
+    uint32_t outputScanCode = 0; // Scan code with 0xE0/0xE1 extended prefix in the high byte
+    bool onlyInWorld = false;
+};
+
+struct KeyRebindCandidate {
+    uint16_t specIndex = 0;
+    // Input was a generic modifier (e.g. VK_SHIFT) while the rebind targets one side (VK_LSHIFT):
+    // on key-down the caller must confirm that side is actually held.
+    bool requiresSideCheck = false;
+};
+
+class KeyRebindTable {
+  public:
+    static constexpr uint32_t kKeyCount = 256;
+
+    // specs must already be filtered to enabled rebinds with non-zero keys. Candidate order follows spec order,
+    // so the first matching rebind wins exactly as with the linear scan.
+    void Build(std::vector<KeyRebindSpec> specs);
+
+    std::span<const KeyRebindCandidate> Candidates(uint32_t inputVk) const {
+        if (inputVk >= kKeyCount) return {};
+        return std::span<const KeyRebindCandidate>(m_candidates.data() + m_offsets[inputVk], m_offsets[inputVk + 1] - m_offsets[inputVk]);
+    }
+
+    const KeyRebindSpec& Spec(size_t index) const { return m_specs[index]; }
+    bool Empty() const { return m_specs.empty(); }
+
+  private:
+    std::vector<KeyRebindSpec> m_specs;
+    std::vector<KeyRebindCandidate> m_candidates;  // Flattened per-VK candidate lists
+    std::array<uint32_t, kKeyCount + 1> m_offsets{}; // m_candidates range for VK v is [m_offsets[v], m_offsets[v + 1])
+};
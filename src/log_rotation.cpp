@@ -0,0 +1,238 @@
+#include "log_rotation.h"
+#include "deflate.h"
+
+#include <algorithm>
+#include <cstdio>
+#include <ctime>
+#include <map>
+#include <string>
+#include <vector>
+
+#ifdef _WIN32
+#include <Windows.h>
+#endif
+
+namespace fs = std::filesystem;
+
+namespace {
+
+// Splits "YYYYMMDD_HHMMSS[_N].log[.gz]" into its sort key; false for anything else
+bool ParseArchiveName(const std::string& name, std::string& stamp, int& counter, bool& compressed) {
+    auto isDigits = [&](size_t pos, size_t count) {
+        if (pos + count > name.size()) return false;
+        return std::all_of(name.begin() + pos, name.begin() + pos + count, [](char c) { return c >= '0' && c <= '9'; });
+    };
+    if (!isDigits(0, 8) || name.size() < 15 || name[8] != '_' || !isDigits(9, 6)) return false;
+    stamp = name.substr(0, 15);
+    size_t pos = 15;
+    counter = 0;
+    if (pos < name.size() && name[pos] == '_') {
+        const size_t start = ++pos;
+        while (pos < name.size() && pos - start < 4 && name[pos] >= '0' && name[pos] <= '9') counter = counter * 10 + (name[pos++] - '0');
+        if (pos == start) return false;
+    }
+    const std::string rest = name.substr(pos);
+    compressed = rest == ".log.gz";
+    return compressed || rest == ".log";
+}
+
+std::chrono::system_clock::time_point LastWriteTime(const fs::path& path) {
+    std::error_code ec;
+    const auto fileTime = fs::last_write_time(path, ec);
+    const auto now = std::chrono::system_clock::now();
+    if (ec) return now;
+    // No clock_cast for file_clock on every toolchain yet; map through the two clocks' current times
+    return now + std::chrono::duration_cast<std::chrono::system_clock::duration>(fileTime - fs::file_time_type::clock::now());
+}
+
+// Archive names are ASCII, but other files in the folder may not be representable in the narrow code page
+std::string FileNameOf(const fs::path& path) {
+    const std::u8string name = path.filename().u8string();
+    return std::string(name.begin(), name.end());
+}
+
+} // namespace
+
+bool IsLogArchiveName(const std::string& fileName) {
+    std::string stamp;
+    int counter = 0;
+    bool compressed = false;
+    return ParseArchiveName(fileName, stamp, counter, compressed);
+}
+
+LogRotator::~LogRotator() { Stop(); }
+
+bool LogRotator::Open(const fs::path& activePath, const LogRotationPolicy& policy, std::ofstream& file) {
+    Stop();
+    if (file.is_open()) file.close();
+    m_activePath = activePath;
+    m_policy = policy;
+
+    // The previous session's log becomes an archive stamped with its last write time (creation time stays the same
+    // across sessions). If the rename fails the file is overwritten below, as before rotation existed.
+    std::error_code ec;
+    if (fs::is_regular_file(activePath, ec)) fs::rename(activePath, ArchivePathFor(LastWriteTime(activePath)), ec);
+    ec.clear();
+
+    file.open(activePath, std::ios_base::out | std::ios_base::trunc);
+    m_bytesWritten = 0;
+    m_nextSizeCheck = m_policy.maxBytes;
+    m_nextAgeCheck = std::chrono::steady_clock::now() + m_policy.maxAge;
+
+    // Pick up archives left uncompressed (this one, or a previous session's that stopped early), oldest first.
+    // A .gz only appears once complete, so an archive that has one was already compressed.
+    std::vector<std::pair<std::string, fs::path>> pending;
+    fs::directory_iterator it(activePath.parent_path(), ec);
+    for (; !ec && it != fs::directory_iterator(); it.increment(ec)) {
+        const fs::directory_entry& entry = *it;
+        const std::string name = FileNameOf(entry.path());
+        std::error_code entryEc;
+        if (name.size() > 7 && name.compare(name.size() - 7, 7, ".gz.tmp") == 0 && IsLogArchiveName(name.substr(0, name.size() - 4))) {
+            fs::remove(entry.path(), entryEc); // Abandoned compression
+            continue;
+        }
+        std::string stamp;
+        int counter = 0;
+        bool compressed = false;
+        if (!ParseArchiveName(name, stamp, counter, compressed) || compressed) continue;
+        fs::path gzPath = entry.path();
+        gzPath += ".gz";
+        if (fs::exists(gzPath, entryEc)) {
+            fs::remove(entry.path(), entryEc);
+            continue;
+        }
+        char key[32];
+        std::snprintf(key, sizeof(key), "%s_%04d", stamp.c_str(), counter);
+        pending.emplace_back(key, entry.path());
+    }
+    std::sort(pending.begin(), pending.end());
+    {
+        std::lock_guard<std::mutex> lock(m_queueMutex);
+        for (auto& [key, path] : pending) m_queue.push_back(std::move(path));
+    }
+
+    m_stop.store(false, std::memory_order_relaxed);
+    m_worker = std::thread(&LogRotator::WorkerMain, this);
+    return file.is_open();
+}
+
+bool LogRotator::OnWrite(size_t bytes, std::ofstream& file) {
+    m_bytesWritten += bytes;
+    const auto now = std::chrono::steady_clock::now();
+    const bool sizeDue = m_policy.maxBytes > 0 && m_bytesWritten >= m_nextSizeCheck;
+    const bool ageDue = m_policy.maxAge.count() > 0 && now >= m_nextAgeCheck;
+    if (!sizeDue && !ageDue) return false;
+
+    if (RotateLocked(file, std::chrono::system_clock::now())) return true;
+
+    // Rename failed (the file is open elsewhere without delete sharing): keep appending and retry a step later
+    m_nextSizeCheck = m_bytesWritten + std::max<uint64_t>(m_policy.maxBytes / 8, 1);
+    m_nextAgeCheck = now + std::chrono::minutes(1);
+    return false;
+}
+
+void LogRotator::Stop() {
+    if (!m_worker.joinable()) return;
+    {
+        std::lock_guard<std::mutex> lock(m_queueMutex);
+        m_stop.store(true, std::memory_order_relaxed);
+        m_queue.clear();
+    }
+    m_queueCv.notify_all();
+    m_worker.join();
+}
+
+bool LogRotator::RotateLocked(std::ofstream& file, std::chrono::system_clock::time_point stamp) {
+    file.flush();
+    file.close();
+
+    const fs::path archivePath = ArchivePathFor(stamp);
+    std::error_code ec;
+    fs::rename(m_activePath, archivePath, ec);
+    const bool rotated = !ec;
+    file.open(m_activePath, std::ios_base::out | (rotated ? std::ios_base::trunc : std::ios_base::app));
+    if (!rotated) return false;
+
+    m_bytesWritten = 0;
+    m_nextSizeCheck = m_policy.maxBytes;
+    m_nextAgeCheck = std::chrono::steady_clock::now() + m_policy.maxAge;
+    Enqueue(archivePath);
+    return true;
+}
+
+fs::path LogRotator::ArchivePathFor(std::chrono::system_clock::time_point stamp) const {
+    const std::time_t t = std::chrono::system_clock::to_time_t(stamp);
+    std::tm local = {};
+#ifdef _WIN32
+    localtime_s(&local, &t);
+#else
+    localtime_r(&t, &local);
+#endif
+    char base[32];
+    std::strftime(base, sizeof(base), "%Y%m%d_%H%M%S", &local);
+
+    // Same-second collisions (or an archive already compressed under this name) get a counter
+    const fs::path dir = m_activePath.parent_path();
+    std::error_code ec;
+    for (int counter = 0; counter < 1000; counter++) {
+        const std::string name = counter == 0 ? std::string(base) : std::string(base) + "_" + std::to_string(counter);
+        const fs::path candidate = dir / (name + ".log");
+        if (!fs::exists(candidate, ec) && !fs::exists(dir / (name + ".log.gz"), ec)) return candidate;
+    }
+    return dir / (std::string(base) + "_last.log"); // Not an archive name, so never pruned or compressed
+}
+
+void LogRotator::Enqueue(const fs::path& archivePath) {
+    {
+        std::lock_guard<std::mutex> lock(m_queueMutex);
+        m_queue.push_back(archivePath);
+    }
+    m_queueCv.notify_one();
+}
+
+void LogRotator::WorkerMain() {
+#ifdef _WIN32
+    // Lowers CPU, I/O and memory priority so compression stays out of the game's way
+    SetThreadPriority(GetCurrentThread(), THREAD_MODE_BACKGROUND_BEGIN);
+#endif
+    PruneArchives();
+    while (true) {
+        fs::path archivePath;
+        {
+            std::unique_lock<std::mutex> lock(m_queueMutex);
+            m_queueCv.wait(lock, [&] { return m_stop.load(std::memory_order_relaxed) || !m_queue.empty(); });
+            if (m_stop.load(std::memory_order_relaxed)) return;
+            archivePath = std::move(m_queue.front());
+            m_queue.pop_front();
+        }
+
+        if (m_policy.compress) {
+            fs::path gzPath = archivePath;
+            gzPath += ".gz";
+            std::error_code ec;
+            // If compression fails or is cancelled, the uncompressed archive is kept
+            if (CompressFileToGzip(archivePath, gzPath, &m_stop)) fs::remove(archivePath, ec);
+        }
+        PruneArchives();
+    }
+}
+
+void LogRotator::PruneArchives() {
+    // Generation -> its files (an archive and its .gz count once while compression is catching up)
+    std::map<std::pair<std::string, int>, std::vector<fs::path>> generations;
+    std::error_code ec;
+    fs::directory_iterator it(m_activePath.parent_path(), ec);
+    for (; !ec && it != fs::directory_iterator(); it.increment(ec)) {
+        std::string stamp;
+        int counter = 0;
+        bool compressed = false;
+        if (!ParseArchiveName(FileNameOf(it->path()), stamp, counter, compressed)) continue;
+        generations[{ stamp, counter }].push_back(it->path());
+    }
+
+    std::error_code removeEc;
+    size_t excess = generations.size() > m_policy.keepGenerations ? generations.size() - m_policy.keepGenerations : 0;
+    for (auto generation = generations.begin(); excess > 0; ++generation, --excess) {
+        for (const fs::path& path : generation->second) fs::remove(path, removeEc);
+    }
+}
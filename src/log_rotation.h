@@ -0,0 +1,68 @@
+#pragma once
+
+#include <atomic>
+#include <chrono>
+#include <condition_variable>
+#include <cstdint>
+#include <deque>
+#include <filesystem>
+#include <fstream>
+#include <mutex>
+#include <thread>
+
+// Rotation for the active log file (logs/latest.log). The active file is archived as <YYYYMMDD_HHMMSS>.log next to
+// it when it grows past a size or age limit, and once per session start. Archives are gzipped by a low-priority
+// worker and only the newest generations are kept. Platform-neutral.
+//
+// The writer owns the active file and calls OnWrite() under its own lock. The worker never touches the active file
+// or that lock, so a crash-path flush never waits behind a compression.
+
+struct LogRotationPolicy {
+    uint64_t maxBytes = 16ull * 1024 * 1024;    // Rotate once the active file reaches this size (0 = no limit)
+    std::chrono::seconds maxAge{ 6 * 60 * 60 }; // Rotate once the active file has been open this long (0 = no limit)
+    size_t keepGenerations = 20;                // Archives kept, compressed or not; older ones are deleted
+    bool compress = true;
+};
+
+class LogRotator {
+  public:
+    LogRotator() = default;
+    ~LogRotator();
+    LogRotator(const LogRotator&) = delete;
+    LogRotator& operator=(const LogRotator&) = delete;
+
+    // Archives an active file left by the previous session (stamped with its last write time), opens a fresh one
+    // into `file` and starts the worker, which also compresses archives a previous session left uncompressed.
+    bool Open(const std::filesystem::path& activePath, const LogRotationPolicy& policy, std::ofstream& file);
+
+    // Writer side, called with the file lock held after appending `bytes`. Rotates when a limit is reached; returns
+    // true if it did. If the rename fails (another process holds the file), logging continues in the same file and
+    // rotation is retried after the next limit step.
+    bool OnWrite(size_t bytes, std::ofstream& file);
+
+    // Stops the worker. A compression in progress is abandoned (its source archive is kept) and queued archives
+    // stay uncompressed until the next Open().
+    void Stop();
+
+  private:
+    bool RotateLocked(std::ofstream& file, std::chrono::system_clock::time_point stamp);
+    std::filesystem::path ArchivePathFor(std::chrono::system_clock::time_point stamp) const;
+    void Enqueue(const std::filesystem::path& archivePath);
+    void WorkerMain();
+    void PruneArchives();
+
+    std::filesystem::path m_activePath;
+    LogRotationPolicy m_policy;
+    uint64_t m_bytesWritten = 0;
+    uint64_t m_nextSizeCheck = 0; // Pushed back by a step after a failed rename
+    std::chrono::steady_clock::time_point m_nextAgeCheck;
+
+    std::thread m_worker;
+    std::mutex m_queueMutex;
+    std::condition_variable m_queueCv;
+    std::deque<std::filesystem::path> m_queue;
+    std::atomic<bool> m_stop{ false };
+};
+
+// Name test for archives written by LogRotator: YYYYMMDD_HHMMSS[_N].log, optionally .gz
+bool IsLogArchiveName(const std::string& fileName);
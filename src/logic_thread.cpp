@@ -1,6 +1,7 @@
 #include "logic_thread.h"
 #include "expression_parser.h"
 #include "gui.h"
+#include "input_hook.h"
 #include "mirror_thread.h"
 #include "profiler.h"
 #include "render.h"
@@ -6469,8 +6470,8 @@ void ProcessPendingModeSwitch() {
         SwitchToMode(toModeId, "Preview (animated)");
     } else {
         // Normal mode switch
-        LogCategory("gui", "[GUI] Processing deferred mode switch to: " + g_pendingModeSwitch.modeId +
-                               " (source: " + g_pendingModeSwitch.source + ")");
+        LogCategory(LogCategoryId::Gui, "[GUI] Processing deferred mode switch to: " + g_pendingModeSwitch.modeId +
+                                            " (source: " + g_pendingModeSwitch.source + ")");
 
         // Use forceCut parameter instead of temporarily mutating g_config.modes
         // This avoids cross-thread mutation of g_config from the logic thread
@@ -7491,8 +7492,36 @@ void ResetStrongholdLiveInputState() {
     s_strongholdLivePlayerPose.lastUpdate = std::chrono::steady_clock::now();
 }
 
+// Drain input events published by the WndProc. Runs every tick, even while idle, so the ring never backs up.
+static void ProcessInputEvents() {
+    PROFILE_SCOPE_CAT("Process Input Events", "Logic Thread");
+    InputEvent evt;
+    while (PopInputEvent(evt)) {
+        switch (evt.kind) {
+        case InputEventKind::KeyDown:
+        case InputEventKind::KeyUp:
+            ReportStrongholdLiveKeyState(static_cast<int>(evt.key), evt.kind == InputEventKind::KeyDown);
+            break;
+        case InputEventKind::StrongholdPanelHotkey:
+            HandleStrongholdOverlayHotkeyH((evt.flags & InputEventFlag_Shift) != 0, (evt.flags & InputEventFlag_Ctrl) != 0);
+            break;
+        case InputEventKind::StrongholdNumpadHotkey:
+            HandleStrongholdOverlayNumpadHotkey(static_cast<int>(evt.key));
+            break;
+        }
+    }
+
+    static uint64_t s_lastReportedDrops = 0;
+    const uint64_t drops = GetDroppedInputEventCount();
+    if (drops != s_lastReportedDrops) {
+        LogEvent(LogCategoryId::Hotkey, "[LogicThread] Input event ring full, {} event(s) handled inline", drops - s_lastReportedDrops);
+        s_lastReportedDrops = drops;
+    }
+}
+
 static void LogicThreadFunc() {
-    LogCategory("init", "[LogicThread] Started");
+    LogCategory(LogCategoryId::Init, "[LogicThread] Started");
+    Profiler::GetInstance().SetThreadName("Logic Thread");
 
     // Target ~60Hz tick rate (approximately 16.67ms per tick)
     const auto tickInterval = std::chrono::milliseconds(16);
@@ -7501,6 +7530,8 @@ static void LogicThreadFunc() {
         PROFILE_SCOPE_CAT("Logic Thread Tick", "Logic Thread");
         auto tickStart = std::chrono::steady_clock::now();
 
+        ProcessInputEvents();
+
         // Skip all logic if shutting down
         if (g_isShuttingDown.load()) {
             std::this_thread::sleep_for(std::chrono::milliseconds(100));
@@ -7548,7 +7579,7 @@ void StartLogicThread() {
     g_logicThread = std::thread(LogicThreadFunc);
     g_logicThreadRunning.store(true);
 
-    LogCategory("init", "[LogicThread] Logic thread started");
+    LogCategory(LogCategoryId::Init, "[LogicThread] Logic thread started");
 }
 
 void StopLogicThread() {
@@ -0,0 +1,77 @@
+#include "mirror_batch.h"
+
+#include <algorithm>
+#include <cmath>
+#include <numeric>
+
+bool PackMirrorAtlas(const std::vector<MirrorAtlasRect>& sizes, int maxSize, std::vector<MirrorAtlasRect>& out, int& atlasW,
+                     int& atlasH) {
+    constexpr int kGutter = 1;
+    out.assign(sizes.size(), MirrorAtlasRect());
+    atlasW = 0;
+    atlasH = 0;
+    if (sizes.empty()) return true;
+
+    // Target a roughly square atlas: width from total area, but never narrower than the widest rect
+    long long area = 0;
+    int widest = 0;
+    for (const auto& s : sizes) {
+        if (s.w <= 0 || s.h <= 0 || s.w > maxSize || s.h > maxSize) return false;
+        area += static_cast<long long>(s.w + kGutter) * (s.h + kGutter);
+        widest = std::max(widest, s.w);
+    }
+    const int shelfWidth = std::min(maxSize, std::max(widest, static_cast<int>(std::ceil(std::sqrt(static_cast<double>(area))))));
+
+    // Tallest first keeps shelves tight
+    std::vector<size_t> order(sizes.size());
+    std::iota(order.begin(), order.end(), size_t{ 0 });
+    std::stable_sort(order.begin(), order.end(), [&sizes](size_t a, size_t b) { return sizes[a].h > sizes[b].h; });
+
+    int shelfY = 0, shelfH = 0, cursorX = 0;
+    for (size_t idx : order) {
+        const MirrorAtlasRect& s = sizes[idx];
+        if (cursorX > 0 && cursorX + s.w > shelfWidth) {
+            shelfY += shelfH + kGutter;
+            shelfH = 0;
+            cursorX = 0;
+        }
+        if (shelfY + s.h > maxSize) return false;
+
+        out[idx] = { cursorX, shelfY, s.w, s.h };
+        cursorX += s.w + kGutter;
+        shelfH = std::max(shelfH, s.h);
+        atlasW = std::max(atlasW, out[idx].x + s.w);
+    }
+    atlasH = shelfY + shelfH;
+    return true;
+}
+
+MirrorFilterInstanceStd140 BuildMirrorFilterInstance(const MirrorFilterInstanceDesc& desc) {
+    MirrorFilterInstanceStd140 inst = {};
+    inst.dstRect[0] = static_cast<float>(desc.dst.x);
+    inst.dstRect[1] = static_cast<float>(desc.dst.y);
+    inst.dstRect[2] = static_cast<float>(desc.dst.w);
+    inst.dstRect[3] = static_cast<float>(desc.dst.h);
+    inst.clipRect[0] = static_cast<float>(desc.clip.x);
+    inst.clipRect[1] = static_cast<float>(desc.clip.y);
+    inst.clipRect[2] = static_cast<float>(desc.clip.w);
+    inst.clipRect[3] = static_cast<float>(desc.clip.h);
+    for (int i = 0; i < 4; ++i) {
+        inst.srcRect[i] = desc.srcRect[i];
+        inst.outputColor[i] = desc.outputColor[i];
+    }
+
+    const int colorCount = std::clamp(desc.targetColorCount, 0, MIRROR_BATCH_MAX_TARGET_COLORS);
+    for (int i = 0; i < colorCount; ++i) {
+        inst.targetColors[i][0] = desc.targetColors[i][0];
+        inst.targetColors[i][1] = desc.targetColors[i][1];
+        inst.targetColors[i][2] = desc.targetColors[i][2];
+    }
+
+    inst.params[0] = static_cast<int32_t>(desc.mode);
+    inst.params[1] = colorCount;
+    inst.params[2] = desc.gammaMode;
+    inst.params[3] = desc.colorLutLayer;
+    inst.misc[0] = desc.sensitivity;
+    return inst;
+}
@@ -0,0 +1,59 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+// Batched mirror filter pass: every mirror due this capture is packed into one atlas texture, its per-region filter
+// parameters go into a std140 uniform block, and all filter passes are issued as instanced draws against the atlas.
+// This file is the platform-neutral half (packing + uniform layout); the GL side lives in mirror_thread.cpp.
+
+struct MirrorAtlasRect {
+    int x = 0;
+    int y = 0;
+    int w = 0;
+    int h = 0;
+};
+
+// Shelf-pack sizes (w, h) into an atlas no larger than maxSize x maxSize. out[i] is the rect for sizes[i].
+// A 1-texel gutter separates rects so edge texels never bleed between mirrors. Returns false if they don't fit.
+bool PackMirrorAtlas(const std::vector<MirrorAtlasRect>& sizes, int maxSize, std::vector<MirrorAtlasRect>& out, int& atlasW,
+                     int& atlasH);
+
+enum class MirrorFilterMode : int32_t {
+    Filter = 0,           // Matching pixels -> output color
+    ColorPassthrough = 1, // Matching pixels keep their original color
+    Raw = 2,              // Straight copy
+};
+
+constexpr int MIRROR_BATCH_MAX_TARGET_COLORS = 8;
+constexpr int MIRROR_BATCH_MAX_INSTANCES = 64; // Per draw; 64 * 224 B stays under the 16 KB minimum UBO size
+
+// One instance = one input region of one mirror. Layout matches the std140 MirrorFilterInstance block in
+// mt_batch_filter_vert_shader / mt_batch_filter_frag_shader (every member is a 16-byte vec4/ivec4).
+struct MirrorFilterInstanceStd140 {
+    float dstRect[4];     // Atlas pixels: x, y, w, h (bottom-left origin, border padding already applied)
+    float srcRect[4];     // Normalized source rect in the game texture (same as the filter shader's u_sourceRect)
+    float clipRect[4];    // Atlas pixels the instance may write: its mirror's whole rect (x, y, w, h)
+    float outputColor[4]; // Filter mode output color
+    float targetColors[MIRROR_BATCH_MAX_TARGET_COLORS][4];
+    int32_t params[4]; // x = MirrorFilterMode, y = target color count, z = gamma mode, w = color LUT layer (-1 = none)
+    float misc[4];     // x = sensitivity
+};
+static_assert(sizeof(MirrorFilterInstanceStd140) == 224, "std140 layout mismatch");
+static_assert(offsetof(MirrorFilterInstanceStd140, params) == 192, "std140 layout mismatch");
+
+struct MirrorFilterInstanceDesc {
+    MirrorAtlasRect dst;
+    MirrorAtlasRect clip; // dst is clamped to this, so a region larger than its mirror can't spill into a neighbour
+    float srcRect[4] = { 0, 0, 1, 1 };
+    MirrorFilterMode mode = MirrorFilterMode::Filter;
+    const float (*targetColors)[3] = nullptr; // count entries of rgb
+    int targetColorCount = 0;
+    float outputColor[4] = { 0, 0, 0, 0 };
+    float sensitivity = 0.0f;
+    int gammaMode = 0;
+    int colorLutLayer = -1; // Layer in the color-match LUT array, -1 = exact matching only
+};
+
+MirrorFilterInstanceStd140 BuildMirrorFilterInstance(const MirrorFilterInstanceDesc& desc);
@@ -0,0 +1,55 @@
+#include "mirror_change_detect.h"
+
+#include <algorithm>
+#include <cmath>
+
+MirrorHashRegion MirrorHashRegionFromRect(float sx, float sy, float sw, float sh, int texW, int texH) {
+    MirrorHashRegion region;
+    region.x = static_cast<int>(std::floor(sx * static_cast<float>(texW)));
+    region.y = static_cast<int>(std::floor(sy * static_cast<float>(texH)));
+    region.w = std::max(1, static_cast<int>(std::floor(sw * static_cast<float>(texW) + 0.5f)));
+    region.h = std::max(1, static_cast<int>(std::floor(sh * static_cast<float>(texH) + 0.5f)));
+    return region;
+}
+
+void MirrorHashGridSize(const MirrorHashRegion& region, int& gridW, int& gridH) {
+    gridW = std::clamp(region.w, 1, MIRROR_HASH_MAX_GRID);
+    gridH = std::clamp(region.h, 1, MIRROR_HASH_MAX_GRID);
+}
+
+void ComputeMirrorCellHashes(const uint8_t* rgba, int texW, int texH, const MirrorHashRegion& region, int gridW, int gridH,
+                             uint32_t* out) {
+    for (int cy = 0; cy < gridH; ++cy) {
+        const int y0 = region.y + cy * region.h / gridH;
+        const int y1 = region.y + (cy + 1) * region.h / gridH;
+        const int strideY = MirrorHashSampleStride(y1 - y0);
+        for (int cx = 0; cx < gridW; ++cx) {
+            const int x0 = region.x + cx * region.w / gridW;
+            const int x1 = region.x + (cx + 1) * region.w / gridW;
+            const int strideX = MirrorHashSampleStride(x1 - x0);
+
+            uint32_t hash = MIRROR_HASH_CELL_SEED;
+            for (int y = y0; y < y1; y += strideY) {
+                const int ty = std::clamp(y, 0, texH - 1);
+                for (int x = x0; x < x1; x += strideX) {
+                    const int tx = std::clamp(x, 0, texW - 1);
+                    const uint8_t* p = rgba + (static_cast<size_t>(ty) * texW + tx) * 4;
+                    const uint32_t packed = static_cast<uint32_t>(p[0]) | (static_cast<uint32_t>(p[1]) << 8) |
+                                            (static_cast<uint32_t>(p[2]) << 16) | (static_cast<uint32_t>(p[3]) << 24);
+                    hash = MirrorHashStep(hash, packed);
+                }
+            }
+            out[cy * gridW + cx] = hash;
+        }
+    }
+}
+
+uint64_t MirrorDigestMix(uint64_t digest, const void* data, size_t size) {
+    const uint8_t* bytes = static_cast<const uint8_t*>(data);
+    for (size_t i = 0; i < size; ++i) { digest = (digest ^ bytes[i]) * 1099511628211ull; }
+    return digest;
+}
+
+uint64_t CombineMirrorCellHashes(const uint32_t* cells, size_t count, uint64_t seed) {
+    return MirrorDigestMix(seed, cells, count * sizeof(uint32_t));
+}
@@ -0,0 +1,55 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+
+// Unchanged-frame detection for mirror captures.
+// Each input region is split into a small grid of cells; every cell is reduced to a 32-bit FNV-1a hash of a downsampled
+// view of its texels (nearest-sampled on a stride, at most MIRROR_HASH_MAX_CELL_SAMPLES per axis), and the cell hashes
+// are folded into one 64-bit digest. Regions up to 16 * 8 = 128 texels per axis are still hashed texel for texel, so
+// any single-pixel change flips a cell; larger regions trade that for a bounded cost per capture.
+// The mirror thread computes the cell hashes on the GPU (see mt_change_hash_frag_shader); the functions here are the
+// CPU reference of that exact computation and must stay in lockstep with the shader.
+// Platform-neutral: no GL or Win32 dependencies.
+
+constexpr int MIRROR_HASH_MAX_GRID = 16;         // Max cells per axis per region
+constexpr int MIRROR_HASH_MAX_CELL_SAMPLES = 8;  // Max texels hashed per cell per axis
+
+// Texel rectangle of a region in GL orientation (y = 0 is the bottom row)
+struct MirrorHashRegion {
+    int x = 0;
+    int y = 0;
+    int w = 0;
+    int h = 0;
+};
+
+// Same derivation the shader uses: normalized source rect (as passed to the filter shader) -> texel rect
+MirrorHashRegion MirrorHashRegionFromRect(float sx, float sy, float sw, float sh, int texW, int texH);
+
+// Cells across/down for a region (at most MIRROR_HASH_MAX_GRID, at least 1, never more than the region's texels)
+void MirrorHashGridSize(const MirrorHashRegion& region, int& gridW, int& gridH);
+
+// Distance between hashed texels along one axis of a cell spanning `span` texels
+inline int MirrorHashSampleStride(int span) {
+    return span > MIRROR_HASH_MAX_CELL_SAMPLES ? (span + MIRROR_HASH_MAX_CELL_SAMPLES - 1) / MIRROR_HASH_MAX_CELL_SAMPLES : 1;
+}
+
+// 32-bit FNV-1a step over one packed RGBA8 texel (r in the low byte)
+inline uint32_t MirrorHashStep(uint32_t hash, uint32_t rgba) { return (hash ^ rgba) * 16777619u; }
+constexpr uint32_t MIRROR_HASH_CELL_SEED = 2166136261u;
+
+// CPU reference: hash every cell of region (stride-sampled as above) over an RGBA8 image laid out bottom row first (glReadPixels order).
+// Out-of-range texels are clamped to the edge, matching the shader. out receives gridW*gridH values, row-major,
+// bottom cell row first.
+void ComputeMirrorCellHashes(const uint8_t* rgba, int texW, int texH, const MirrorHashRegion& region, int gridW, int gridH,
+                             uint32_t* out);
+
+// Fold cell hashes (from any number of regions) into one digest, seeded with the non-pixel render state
+uint64_t CombineMirrorCellHashes(const uint32_t* cells, size_t count, uint64_t seed);
+
+// 64-bit FNV-1a helpers for building the render-state seed
+constexpr uint64_t MIRROR_DIGEST_SEED = 14695981039346656037ull;
+uint64_t MirrorDigestMix(uint64_t digest, const void* data, size_t size);
+template <typename T> inline uint64_t MirrorDigestMixValue(uint64_t digest, const T& value) {
+    return MirrorDigestMix(digest, &value, sizeof(value));
+}
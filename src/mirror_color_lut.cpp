@@ -0,0 +1,133 @@
+#include "mirror_color_lut.h"
+
+#include <algorithm>
+#include <cmath>
+
+namespace {
+
+// Distances within this of the sensitivity are left to the shader. Covers the gap between the CPU's pow()/sqrt() and
+// the GPU's lower-precision versions, so a definite class can never disagree with what the shader would compute.
+constexpr float kClassifyMargin = 1.0e-3f;
+
+struct Box {
+    float lo[3];
+    float hi[3];
+};
+
+void BoxDistanceBounds(const Box& box, const float p[3], float& minDist, float& maxDist) {
+    float minSq = 0.0f, maxSq = 0.0f;
+    for (int i = 0; i < 3; ++i) {
+        const float below = box.lo[i] - p[i];
+        const float above = p[i] - box.hi[i];
+        const float nearest = (std::max)({ below, above, 0.0f });
+        const float farthest = (std::max)(std::fabs(p[i] - box.lo[i]), std::fabs(p[i] - box.hi[i]));
+        minSq += nearest * nearest;
+        maxSq += farthest * farthest;
+    }
+    minDist = std::sqrt(minSq);
+    maxDist = std::sqrt(maxSq);
+}
+
+float Distance(const float a[3], const float b[3]) {
+    const float dx = a[0] - b[0], dy = a[1] - b[1], dz = a[2] - b[2];
+    return std::sqrt(dx * dx + dy * dy + dz * dz);
+}
+
+} // namespace
+
+bool MirrorColorLutParams::operator==(const MirrorColorLutParams& other) const {
+    if (targetColorCount != other.targetColorCount || sensitivity != other.sensitivity || gammaMode != other.gammaMode) return false;
+    for (int i = 0; i < targetColorCount; ++i) {
+        for (int c = 0; c < 3; ++c) {
+            if (targetColors[i][c] != other.targetColors[i][c]) return false;
+        }
+    }
+    return true;
+}
+
+float MirrorSRGBToLinear(float c) {
+    if (c <= 0.04045f) return c / 12.92f;
+    return std::pow((c + 0.055f) / 1.055f, 2.4f);
+}
+
+bool MirrorColorMatches(const MirrorColorLutParams& params, const float rgb[3]) {
+    const float rgbLinear[3] = { MirrorSRGBToLinear(rgb[0]), MirrorSRGBToLinear(rgb[1]), MirrorSRGBToLinear(rgb[2]) };
+    const int count = std::clamp(params.targetColorCount, 0, MIRROR_LUT_MAX_TARGET_COLORS);
+    for (int i = 0; i < count; ++i) {
+        const float* target = params.targetColors[i];
+        const float targetLinear[3] = { MirrorSRGBToLinear(target[0]), MirrorSRGBToLinear(target[1]), MirrorSRGBToLinear(target[2]) };
+
+        float dist;
+        if (params.gammaMode == 2) {
+            dist = Distance(rgb, targetLinear);
+        } else if (params.gammaMode == 1) {
+            dist = Distance(rgbLinear, targetLinear);
+        } else {
+            dist = (std::min)(Distance(rgb, target), Distance(rgbLinear, targetLinear));
+        }
+        if (dist < params.sensitivity) return true;
+    }
+    return false;
+}
+
+int BuildMirrorColorLut(const MirrorColorLutParams& params, std::vector<uint8_t>& out) {
+    out.assign(static_cast<size_t>(MIRROR_LUT_TILE_W) * MIRROR_LUT_TILE_H, MIRROR_LUT_NO_MATCH);
+
+    const int count = std::clamp(params.targetColorCount, 0, MIRROR_LUT_MAX_TARGET_COLORS);
+    if (count == 0) return 0;
+
+    float targetLinear[MIRROR_LUT_MAX_TARGET_COLORS][3];
+    for (int i = 0; i < count; ++i) {
+        for (int c = 0; c < 3; ++c) { targetLinear[i][c] = MirrorSRGBToLinear(params.targetColors[i][c]); }
+    }
+
+    // Per-channel cell bounds, in encoded and linear space (SRGBToLinear is monotonic, so the box maps to a box)
+    float encLo[MIRROR_LUT_CELLS], encHi[MIRROR_LUT_CELLS], linLo[MIRROR_LUT_CELLS], linHi[MIRROR_LUT_CELLS];
+    for (int i = 0; i < MIRROR_LUT_CELLS; ++i) {
+        encLo[i] = static_cast<float>(i * MIRROR_LUT_VALUES_PER_CELL) / 255.0f;
+        encHi[i] = static_cast<float>(i * MIRROR_LUT_VALUES_PER_CELL + MIRROR_LUT_VALUES_PER_CELL - 1) / 255.0f;
+        linLo[i] = MirrorSRGBToLinear(encLo[i]);
+        linHi[i] = MirrorSRGBToLinear(encHi[i]);
+    }
+
+    const float matchBelow = params.sensitivity - kClassifyMargin;
+    const float missAtOrAbove = params.sensitivity + kClassifyMargin;
+    const bool useEncoded = params.gammaMode != 1; // Auto and Linear compare the encoded input
+    const bool useLinear = params.gammaMode != 2;  // Auto and sRGB compare the linearized input
+    int ambiguous = 0;
+
+    for (int b = 0; b < MIRROR_LUT_CELLS; ++b) {
+        for (int g = 0; g < MIRROR_LUT_CELLS; ++g) {
+            uint8_t* row = out.data() + static_cast<size_t>(g + MIRROR_LUT_CELLS * (b / 8)) * MIRROR_LUT_TILE_W + MIRROR_LUT_CELLS * (b % 8);
+            for (int r = 0; r < MIRROR_LUT_CELLS; ++r) {
+                const Box enc = { { encLo[r], encLo[g], encLo[b] }, { encHi[r], encHi[g], encHi[b] } };
+                const Box lin = { { linLo[r], linLo[g], linLo[b] }, { linHi[r], linHi[g], linHi[b] } };
+
+                bool allMatch = false;
+                bool anyMayMatch = false;
+                for (int i = 0; i < count && !allMatch; ++i) {
+                    float minD, maxD;
+                    if (useEncoded) {
+                        // Linear mode compares the encoded input against the linearized target; Auto against the raw target
+                        BoxDistanceBounds(enc, params.gammaMode == 2 ? targetLinear[i] : params.targetColors[i], minD, maxD);
+                        if (maxD < matchBelow) allMatch = true;
+                        if (minD < missAtOrAbove) anyMayMatch = true;
+                    }
+                    if (useLinear) {
+                        BoxDistanceBounds(lin, targetLinear[i], minD, maxD);
+                        if (maxD < matchBelow) allMatch = true;
+                        if (minD < missAtOrAbove) anyMayMatch = true;
+                    }
+                }
+
+                if (allMatch) {
+                    row[r] = MIRROR_LUT_MATCH;
+                } else if (anyMayMatch) {
+                    row[r] = MIRROR_LUT_AMBIGUOUS;
+                    ++ambiguous;
+                }
+            }
+        }
+    }
+    return ambiguous;
+}
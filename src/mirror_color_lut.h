@@ -0,0 +1,50 @@
+#pragma once
+
+#include <cstdint>
+#include <vector>
+
+// Color-match lookup table for mirror filters.
+// The 8-bit RGB cube is split into MIRROR_LUT_CELLS^3 cells (4 values per channel per cell). Each cell is classified
+// once on the CPU, from distance bounds over the cell's box, as "every color matches", "no color matches", or
+// "ambiguous". The filter shaders fetch one texel per pixel and only run the exact sRGB/distance math for ambiguous
+// cells, so output is identical to the unaccelerated shaders.
+// The cube is stored as a MIRROR_LUT_TILE_W x MIRROR_LUT_TILE_H R8 image: blue slice b is the 64x64 tile at
+// (64 * (b % 8), 64 * (b / 8)), red along x, green along y. Must match ColorLutClass() in the mirror filter shaders.
+// Platform-neutral: no GL or Win32 dependencies.
+
+constexpr int MIRROR_LUT_CELLS = 64;
+constexpr int MIRROR_LUT_VALUES_PER_CELL = 256 / MIRROR_LUT_CELLS;
+constexpr int MIRROR_LUT_TILE_W = MIRROR_LUT_CELLS * 8;
+constexpr int MIRROR_LUT_TILE_H = MIRROR_LUT_CELLS * (MIRROR_LUT_CELLS / 8);
+constexpr int MIRROR_LUT_MAX_TARGET_COLORS = 8;
+
+constexpr uint8_t MIRROR_LUT_NO_MATCH = 0;
+constexpr uint8_t MIRROR_LUT_AMBIGUOUS = 128;
+constexpr uint8_t MIRROR_LUT_MATCH = 255;
+
+// Everything the match result depends on. gammaMode uses MirrorGammaMode values (0 = Auto, 1 = sRGB, 2 = Linear).
+struct MirrorColorLutParams {
+    float targetColors[MIRROR_LUT_MAX_TARGET_COLORS][3] = {};
+    int targetColorCount = 0;
+    float sensitivity = 0.0f;
+    int gammaMode = 0;
+
+    bool operator==(const MirrorColorLutParams& other) const;
+    bool operator!=(const MirrorColorLutParams& other) const { return !(*this == other); }
+};
+
+// Same piecewise curve as SRGBToLinear() in the shaders
+float MirrorSRGBToLinear(float c);
+
+// CPU reference of the filter shaders' per-pixel match test (rgb in 0..1)
+bool MirrorColorMatches(const MirrorColorLutParams& params, const float rgb[3]);
+
+// Fill out (MIRROR_LUT_TILE_W * MIRROR_LUT_TILE_H bytes, row-major, bottom row first) with cell classes.
+// Returns the number of ambiguous cells.
+int BuildMirrorColorLut(const MirrorColorLutParams& params, std::vector<uint8_t>& out);
+
+// Byte offset of the cell containing 8-bit color (r, g, b)
+inline int MirrorColorLutIndex(int r, int g, int b) {
+    const int cr = r / MIRROR_LUT_VALUES_PER_CELL, cg = g / MIRROR_LUT_VALUES_PER_CELL, cb = b / MIRROR_LUT_VALUES_PER_CELL;
+    return (cg + MIRROR_LUT_CELLS * (cb / 8)) * MIRROR_LUT_TILE_W + cr + MIRROR_LUT_CELLS * (cb % 8);
+}
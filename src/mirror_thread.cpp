@@ -1,6 +1,9 @@
 #include "mirror_thread.h"
 #include "gui.h"
 #include "logic_thread.h"
+#include "mirror_batch.h"
+#include "mirror_change_detect.h"
+#include "mirror_color_lut.h"
 #include "profiler.h"
 #include "render.h"
 #include "shared_contexts.h"
@@ -87,16 +90,16 @@ static void MT_LogSharedContextHealthOnce() {
     const char* renderer = reinterpret_cast<const char*>(glGetString(GL_RENDERER));
     const char* version = reinterpret_cast<const char*>(glGetString(GL_VERSION));
 
-    LogCategory("init", std::string("Mirror Capture Thread: GL_VENDOR=") + (vendor ? vendor : "<null>"));
-    LogCategory("init", std::string("Mirror Capture Thread: GL_RENDERER=") + (renderer ? renderer : "<null>"));
-    LogCategory("init", std::string("Mirror Capture Thread: GL_VERSION=") + (version ? version : "<null>"));
+    LogCategory(LogCategoryId::Init, std::string("Mirror Capture Thread: GL_VENDOR=") + (vendor ? vendor : "<null>"));
+    LogCategory(LogCategoryId::Init, std::string("Mirror Capture Thread: GL_RENDERER=") + (renderer ? renderer : "<null>"));
+    LogCategory(LogCategoryId::Init, std::string("Mirror Capture Thread: GL_VERSION=") + (version ? version : "<null>"));
 
     // Validate that the shared copy textures created on the game context are visible here.
     // If these are not visible, mirrors/raw output will never work.
     for (int i = 0; i < 2; i++) {
         GLuint tex = g_copyTextures[i];
         if (tex == 0) {
-            LogCategory("init", "Mirror Capture Thread: g_copyTextures[" + std::to_string(i) + "] = 0 (not initialized yet)");
+            LogCategory(LogCategoryId::Init, "Mirror Capture Thread: g_copyTextures[" + std::to_string(i) + "] = 0 (not initialized yet)");
             continue;
         }
 
@@ -108,9 +111,9 @@ static void MT_LogSharedContextHealthOnce() {
         glGetTexLevelParameteriv(GL_TEXTURE_2D, 0, GL_TEXTURE_INTERNAL_FORMAT, &ifmt);
         glBindTexture(GL_TEXTURE_2D, 0);
 
-        LogCategory("init", "Mirror Capture Thread: shared copy tex[" + std::to_string(i) + "] id=" + std::to_string(tex) +
-                                " glIsTexture=" + std::to_string((int)isTex) + " size=" + std::to_string(w) + "x" +
-                                std::to_string(h) + " ifmt=" + std::to_string(ifmt));
+        LogCategory(LogCategoryId::Init, "Mirror Capture Thread: shared copy tex[" + std::to_string(i) + "] id=" + std::to_string(tex) +
+                                             " glIsTexture=" + std::to_string((int)isTex) + " size=" + std::to_string(w) + "x" +
+                                             std::to_string(h) + " ifmt=" + std::to_string(ifmt));
     }
 
     // Clear any errors so subsequent GL error checks are meaningful.
@@ -147,6 +150,8 @@ uniform vec3 u_targetColors[8];  // Support up to 8 target colors
 uniform int u_targetColorCount;  // Number of active target colors
 uniform vec4 outputColor;
 uniform float u_sensitivity;
+uniform sampler2DArray u_colorLut;
+uniform int u_colorLutLayer;    // -1 = no LUT
 
 vec3 SRGBToLinear(vec3 c) {
     bvec3 cutoff = lessThanEqual(c, vec3(0.04045));
@@ -154,13 +159,23 @@ vec3 SRGBToLinear(vec3 c) {
     vec3 high = pow((c + 0.055) / 1.055, vec3(2.4));
     return mix(high, low, vec3(cutoff));
 }
+// Color-match LUT cell class: 0 = no match, 1 = ambiguous (run the exact test), 2 = match. See mirror_color_lut.h.
+int ColorLutClass(vec3 c, int layer) {
+    if (layer < 0) return 1;
+    ivec3 cell = clamp(ivec3(c * 255.0 + 0.5), ivec3(0), ivec3(255)) / 4;
+    ivec2 texel = ivec2(cell.r + 64 * (cell.b % 8), cell.g + 64 * (cell.b / 8));
+    float v = texelFetch(u_colorLut, ivec3(texel, layer), 0).r;
+    return v < 0.25 ? 0 : (v > 0.75 ? 2 : 1);
+}
 void main() {
     vec2 srcCoord = u_sourceRect.xy + TexCoord * u_sourceRect.zw;
     vec3 screenColor = texture(screenTexture, srcCoord).rgb;
-    vec3 screenColorLinear = SRGBToLinear(screenColor);
-    
-    bool matches = false;
-    for (int i = 0; i < u_targetColorCount; i++) {
+
+    // One LUT fetch settles most pixels; only cells near a match boundary run the exact test
+    int lutClass = ColorLutClass(screenColor, u_colorLutLayer);
+    bool matches = lutClass == 2;
+    vec3 screenColorLinear = lutClass == 1 ? SRGBToLinear(screenColor) : screenColor;
+    for (int i = 0; lutClass == 1 && i < u_targetColorCount; i++) {
         vec3 targetColorSRGB = u_targetColors[i];
         vec3 targetColorLinear = SRGBToLinear(targetColorSRGB);
 
@@ -202,6 +217,8 @@ uniform int u_gammaMode;       // 0=Auto, 1=Assume sRGB, 2=Assume Linear
 uniform vec3 u_targetColors[8];  // Support up to 8 target colors
 uniform int u_targetColorCount;  // Number of active target colors
 uniform float u_sensitivity;
+uniform sampler2DArray u_colorLut;
+uniform int u_colorLutLayer;    // -1 = no LUT
 
 vec3 SRGBToLinear(vec3 c) {
     bvec3 cutoff = lessThanEqual(c, vec3(0.04045));
@@ -209,13 +226,23 @@ vec3 SRGBToLinear(vec3 c) {
     vec3 high = pow((c + 0.055) / 1.055, vec3(2.4));
     return mix(high, low, vec3(cutoff));
 }
+// Color-match LUT cell class: 0 = no match, 1 = ambiguous (run the exact test), 2 = match. See mirror_color_lut.h.
+int ColorLutClass(vec3 c, int layer) {
+    if (layer < 0) return 1;
+    ivec3 cell = clamp(ivec3(c * 255.0 + 0.5), ivec3(0), ivec3(255)) / 4;
+    ivec2 texel = ivec2(cell.r + 64 * (cell.b % 8), cell.g + 64 * (cell.b / 8));
+    float v = texelFetch(u_colorLut, ivec3(texel, layer), 0).r;
+    return v < 0.25 ? 0 : (v > 0.75 ? 2 : 1);
+}
 void main() {
     vec2 srcCoord = u_sourceRect.xy + TexCoord * u_sourceRect.zw;
     vec3 screenColor = texture(screenTexture, srcCoord).rgb;
-    vec3 screenColorLinear = SRGBToLinear(screenColor);
-    
-    bool matches = false;
-    for (int i = 0; i < u_targetColorCount; i++) {
+
+    // One LUT fetch settles most pixels; only cells near a match boundary run the exact test
+    int lutClass = ColorLutClass(screenColor, u_colorLutLayer);
+    bool matches = lutClass == 2;
+    vec3 screenColorLinear = lutClass == 1 ? SRGBToLinear(screenColor) : screenColor;
+    for (int i = 0; lutClass == 1 && i < u_targetColorCount; i++) {
         vec3 targetColorSRGB = u_targetColors[i];
         vec3 targetColorLinear = SRGBToLinear(targetColorSRGB);
 
@@ -406,6 +433,151 @@ void main() {
     }
 })";
 
+// Change-detection hash shader - one output texel per grid cell of an input region, holding the 32-bit FNV-1a hash
+// of the cell's texels, stride-sampled down to at most 8x8. Must match ComputeMirrorCellHashes() in mirror_change_detect.cpp.
+static_assert(MIRROR_HASH_MAX_CELL_SAMPLES == 8, "Update kMaxSamples in mt_change_hash_frag_shader");
+
+static const char* mt_change_hash_frag_shader = R"(#version 330 core
+out uint o_hash;
+uniform sampler2D u_source;
+uniform vec4 u_sourceRect; // Same normalized rect the filter shader samples
+uniform ivec2 u_grid;      // Cells across / down for this region
+uniform int u_rowOffset;   // First output row of this region
+
+void main() {
+    ivec2 texSize = textureSize(u_source, 0);
+    ivec4 region = ivec4(int(floor(u_sourceRect.x * float(texSize.x))), int(floor(u_sourceRect.y * float(texSize.y))),
+                         max(1, int(floor(u_sourceRect.z * float(texSize.x) + 0.5))), max(1, int(floor(u_sourceRect.w * float(texSize.y) + 0.5))));
+    ivec2 cell = ivec2(gl_FragCoord.xy) - ivec2(0, u_rowOffset);
+    int x0 = region.x + cell.x * region.z / u_grid.x;
+    int x1 = region.x + (cell.x + 1) * region.z / u_grid.x;
+    int y0 = region.y + cell.y * region.w / u_grid.y;
+    int y1 = region.y + (cell.y + 1) * region.w / u_grid.y;
+    ivec2 maxCoord = texSize - ivec2(1);
+    const int kMaxSamples = 8;
+    int strideX = (x1 - x0 > kMaxSamples) ? (x1 - x0 + kMaxSamples - 1) / kMaxSamples : 1;
+    int strideY = (y1 - y0 > kMaxSamples) ? (y1 - y0 + kMaxSamples - 1) / kMaxSamples : 1;
+
+    uint hash = 2166136261u;
+    for (int y = y0; y < y1; y += strideY) {
+        for (int x = x0; x < x1; x += strideX) {
+            uvec4 c = uvec4(floor(texelFetch(u_source, clamp(ivec2(x, y), ivec2(0), maxCoord), 0) * 255.0 + 0.5));
+            hash = (hash ^ (c.r | (c.g << 8) | (c.b << 16) | (c.a << 24))) * 16777619u;
+        }
+    }
+    o_hash = hash;
+})";
+
+// Batched filter pass - one instance per (mirror, input region), all drawn into a shared atlas.
+// The MirrorFilterInstance block layout must match MirrorFilterInstanceStd140 in mirror_batch.h.
+static_assert(MIRROR_BATCH_MAX_INSTANCES == 64, "Update u_instances[] in the batched filter shaders");
+
+static const char* mt_batch_filter_vert_shader = R"(#version 330 core
+struct MirrorFilterInstance {
+    vec4 dstRect;
+    vec4 srcRect;
+    vec4 clipRect;
+    vec4 outputColor;
+    vec4 targetColors[8];
+    ivec4 params;
+    vec4 misc;
+};
+layout(std140) uniform MirrorFilterBatch {
+    MirrorFilterInstance u_instances[64];
+};
+layout(location = 1) in vec2 aTexCoord;
+uniform vec2 u_atlasSize;
+out vec2 v_srcCoord;
+flat out int v_instance;
+void main() {
+    // Clamp the quad to the instance's clip rect (the atlas has no viewport per mirror) and keep the source mapping
+    vec4 dst = u_instances[gl_InstanceID].dstRect;
+    vec4 clip = u_instances[gl_InstanceID].clipRect;
+    vec2 pixel = clamp(dst.xy + aTexCoord * dst.zw, clip.xy, clip.xy + clip.zw);
+    gl_Position = vec4(pixel / u_atlasSize * 2.0 - 1.0, 0.0, 1.0);
+    vec4 src = u_instances[gl_InstanceID].srcRect;
+    v_srcCoord = src.xy + (pixel - dst.xy) / dst.zw * src.zw;
+    v_instance = gl_InstanceID;
+})";
+
+// Same matching rules as mt_filter_frag_shader / mt_filter_passthrough_frag_shader / mt_passthrough_frag_shader,
+// selected per instance by params.x (0 = filter, 1 = color passthrough, 2 = raw). params.w is the color LUT layer.
+static const char* mt_batch_filter_frag_shader = R"(#version 330 core
+struct MirrorFilterInstance {
+    vec4 dstRect;
+    vec4 srcRect;
+    vec4 clipRect;
+    vec4 outputColor;
+    vec4 targetColors[8];
+    ivec4 params;
+    vec4 misc;
+};
+layout(std140) uniform MirrorFilterBatch {
+    MirrorFilterInstance u_instances[64];
+};
+out vec4 FragColor;
+in vec2 v_srcCoord;
+flat in int v_instance;
+uniform sampler2D screenTexture;
+uniform sampler2DArray u_colorLut;
+
+vec3 SRGBToLinear(vec3 c) {
+    bvec3 cutoff = lessThanEqual(c, vec3(0.04045));
+    vec3 low = c / 12.92;
+    vec3 high = pow((c + 0.055) / 1.055, vec3(2.4));
+    return mix(high, low, vec3(cutoff));
+}
+// Color-match LUT cell class: 0 = no match, 1 = ambiguous (run the exact test), 2 = match. See mirror_color_lut.h.
+int ColorLutClass(vec3 c, int layer) {
+    if (layer < 0) return 1;
+    ivec3 cell = clamp(ivec3(c * 255.0 + 0.5), ivec3(0), ivec3(255)) / 4;
+    ivec2 texel = ivec2(cell.r + 64 * (cell.b % 8), cell.g + 64 * (cell.b / 8));
+    float v = texelFetch(u_colorLut, ivec3(texel, layer), 0).r;
+    return v < 0.25 ? 0 : (v > 0.75 ? 2 : 1);
+}
+void main() {
+    ivec4 params = u_instances[v_instance].params;
+    if (params.x == 2) {
+        FragColor = texture(screenTexture, v_srcCoord);
+        return;
+    }
+
+    vec3 screenColor = texture(screenTexture, v_srcCoord).rgb;
+    float sensitivity = u_instances[v_instance].misc.x;
+
+    int lutClass = ColorLutClass(screenColor, params.w);
+    bool matches = lutClass == 2;
+    vec3 screenColorLinear = lutClass == 1 ? SRGBToLinear(screenColor) : screenColor;
+    for (int i = 0; lutClass == 1 && i < params.y; i++) {
+        vec3 targetColorSRGB = u_instances[v_instance].targetColors[i].rgb;
+        vec3 targetColorLinear = SRGBToLinear(targetColorSRGB);
+
+        float dist;
+        if (params.z == 2) {
+            dist = distance(screenColor, targetColorLinear);
+        } else if (params.z == 1) {
+            dist = distance(screenColorLinear, targetColorLinear);
+        } else {
+            float distSRGB = distance(screenColor, targetColorSRGB);
+            float distLinear = distance(screenColorLinear, targetColorLinear);
+            dist = min(distSRGB, distLinear);
+        }
+
+        if (dist < sensitivity) {
+            matches = true;
+            break;
+        }
+    }
+
+    if (!matches) {
+        FragColor = vec4(0.0, 0.0, 0.0, 0.0);
+    } else if (params.x == 1) {
+        FragColor = vec4(screenColor, 1.0);
+    } else {
+        FragColor = u_instances[v_instance].outputColor;
+    }
+})";
+
 // Local shader program handles (created on mirror thread context)
 static GLuint mt_filterProgram = 0;
 static GLuint mt_filterPassthroughProgram = 0; // Color passthrough filter shader
@@ -414,6 +586,8 @@ static GLuint mt_backgroundProgram = 0;
 static GLuint mt_renderProgram = 0;
 static GLuint mt_renderPassthroughProgram = 0; // Color passthrough render shader
 static GLuint mt_staticBorderProgram = 0;      // Static border shape shader
+static GLuint mt_changeHashProgram = 0;        // Change-detection cell hash shader (optional)
+static GLuint mt_batchFilterProgram = 0;       // Batched atlas filter shader (optional)
 
 // Uniform locations for local shaders
 struct MT_FilterShaderLocs {
@@ -422,6 +596,7 @@ struct MT_FilterShaderLocs {
     GLint targetColors = -1;     // Array of target colors (up to 8)
     GLint targetColorCount = -1; // Number of active target colors
     GLint outputColor = -1, sensitivity = -1;
+    GLint colorLut = -1, colorLutLayer = -1;
 };
 // Color passthrough filter shader uniform locations (no outputColor since it uses original pixel)
 struct MT_FilterPassthroughShaderLocs {
@@ -430,6 +605,7 @@ struct MT_FilterPassthroughShaderLocs {
     GLint targetColors = -1;     // Array of target colors (up to 8)
     GLint targetColorCount = -1; // Number of active target colors
     GLint sensitivity = -1;
+    GLint colorLut = -1, colorLutLayer = -1;
 };
 struct MT_PassthroughShaderLocs {
     GLint screenTexture = -1, sourceRect = -1;
@@ -448,6 +624,12 @@ struct MT_RenderPassthroughShaderLocs {
 struct MT_StaticBorderShaderLocs {
     GLint shape = -1, borderColor = -1, thickness = -1, radius = -1, size = -1;
 };
+struct MT_ChangeHashShaderLocs {
+    GLint source = -1, sourceRect = -1, grid = -1, rowOffset = -1;
+};
+struct MT_BatchFilterShaderLocs {
+    GLint screenTexture = -1, atlasSize = -1, colorLut = -1;
+};
 
 static MT_FilterShaderLocs mt_filterShaderLocs;
 static MT_PassthroughShaderLocs mt_passthroughShaderLocs;
@@ -455,6 +637,8 @@ static MT_BackgroundShaderLocs mt_backgroundShaderLocs;
 static MT_RenderShaderLocs mt_renderShaderLocs;
 static MT_RenderPassthroughShaderLocs mt_renderPassthroughShaderLocs;
 static MT_StaticBorderShaderLocs mt_staticBorderShaderLocs;
+static MT_ChangeHashShaderLocs mt_changeHashShaderLocs;
+static MT_BatchFilterShaderLocs mt_batchFilterShaderLocs;
 
 static MT_FilterPassthroughShaderLocs mt_filterPassthroughShaderLocs;
 
@@ -502,7 +686,7 @@ static GLuint MT_CreateShaderProgram(const char* vertSrc, const char* fragSrc) {
 }
 
 static bool MT_InitializeShaders() {
-    LogCategory("init", "Mirror Thread: Initializing local shaders...");
+    LogCategory(LogCategoryId::Init, "Mirror Thread: Initializing local shaders...");
 
     mt_filterProgram = MT_CreateShaderProgram(mt_passthrough_vert_shader, mt_filter_frag_shader);
     mt_filterPassthroughProgram = MT_CreateShaderProgram(mt_passthrough_vert_shader, mt_filter_passthrough_frag_shader);
@@ -526,6 +710,8 @@ static bool MT_InitializeShaders() {
     mt_filterShaderLocs.targetColorCount = glGetUniformLocation(mt_filterProgram, "u_targetColorCount");
     mt_filterShaderLocs.outputColor = glGetUniformLocation(mt_filterProgram, "outputColor");
     mt_filterShaderLocs.sensitivity = glGetUniformLocation(mt_filterProgram, "u_sensitivity");
+    mt_filterShaderLocs.colorLut = glGetUniformLocation(mt_filterProgram, "u_colorLut");
+    mt_filterShaderLocs.colorLutLayer = glGetUniformLocation(mt_filterProgram, "u_colorLutLayer");
 
     // Get uniform locations for color passthrough filter shader
     mt_filterPassthroughShaderLocs.screenTexture = glGetUniformLocation(mt_filterPassthroughProgram, "screenTexture");
@@ -534,6 +720,8 @@ static bool MT_InitializeShaders() {
     mt_filterPassthroughShaderLocs.targetColors = glGetUniformLocation(mt_filterPassthroughProgram, "u_targetColors");
     mt_filterPassthroughShaderLocs.targetColorCount = glGetUniformLocation(mt_filterPassthroughProgram, "u_targetColorCount");
     mt_filterPassthroughShaderLocs.sensitivity = glGetUniformLocation(mt_filterPassthroughProgram, "u_sensitivity");
+    mt_filterPassthroughShaderLocs.colorLut = glGetUniformLocation(mt_filterPassthroughProgram, "u_colorLut");
+    mt_filterPassthroughShaderLocs.colorLutLayer = glGetUniformLocation(mt_filterPassthroughProgram, "u_colorLutLayer");
 
     mt_passthroughShaderLocs.screenTexture = glGetUniformLocation(mt_passthroughProgram, "screenTexture");
     mt_passthroughShaderLocs.sourceRect = glGetUniformLocation(mt_passthroughProgram, "u_sourceRect");
@@ -560,14 +748,52 @@ static bool MT_InitializeShaders() {
     mt_staticBorderShaderLocs.radius = glGetUniformLocation(mt_staticBorderProgram, "u_radius");
     mt_staticBorderShaderLocs.size = glGetUniformLocation(mt_staticBorderProgram, "u_size");
 
+    // Change detection is optional - without integer render targets mirrors just always re-render
+    mt_changeHashProgram = MT_CreateShaderProgram(mt_passthrough_vert_shader, mt_change_hash_frag_shader);
+    if (mt_changeHashProgram) {
+        mt_changeHashShaderLocs.source = glGetUniformLocation(mt_changeHashProgram, "u_source");
+        mt_changeHashShaderLocs.sourceRect = glGetUniformLocation(mt_changeHashProgram, "u_sourceRect");
+        mt_changeHashShaderLocs.grid = glGetUniformLocation(mt_changeHashProgram, "u_grid");
+        mt_changeHashShaderLocs.rowOffset = glGetUniformLocation(mt_changeHashProgram, "u_rowOffset");
+    } else {
+        Log("Mirror Thread: Change-detection shader unavailable, unchanged-frame skipping disabled");
+    }
+
+    // Batched filtering is optional too - without it every mirror runs its own filter pass
+    mt_batchFilterProgram = MT_CreateShaderProgram(mt_batch_filter_vert_shader, mt_batch_filter_frag_shader);
+    if (mt_batchFilterProgram) {
+        mt_batchFilterShaderLocs.screenTexture = glGetUniformLocation(mt_batchFilterProgram, "screenTexture");
+        mt_batchFilterShaderLocs.atlasSize = glGetUniformLocation(mt_batchFilterProgram, "u_atlasSize");
+        mt_batchFilterShaderLocs.colorLut = glGetUniformLocation(mt_batchFilterProgram, "u_colorLut");
+        GLuint blockIndex = glGetUniformBlockIndex(mt_batchFilterProgram, "MirrorFilterBatch");
+        GLint blockSize = 0;
+        if (blockIndex != GL_INVALID_INDEX) {
+            glGetActiveUniformBlockiv(mt_batchFilterProgram, blockIndex, GL_UNIFORM_BLOCK_DATA_SIZE, &blockSize);
+        }
+        if (blockIndex == GL_INVALID_INDEX || blockSize != static_cast<GLint>(sizeof(MirrorFilterInstanceStd140) * MIRROR_BATCH_MAX_INSTANCES)) {
+            Log("Mirror Thread: Batched filter uniform block mismatch (size " + std::to_string(blockSize) + "), batching disabled");
+            glDeleteProgram(mt_batchFilterProgram);
+            mt_batchFilterProgram = 0;
+        } else {
+            glUniformBlockBinding(mt_batchFilterProgram, blockIndex, 0);
+        }
+    } else {
+        Log("Mirror Thread: Batched filter shader unavailable, mirrors will be filtered individually");
+    }
+
     // Set texture sampler uniforms once
+    // Color LUTs live on unit 1 (a 2D array sampler can't share screenTexture's unit)
     glUseProgram(mt_filterProgram);
     glUniform1i(mt_filterShaderLocs.screenTexture, 0);
     if (mt_filterShaderLocs.gammaMode >= 0) { glUniform1i(mt_filterShaderLocs.gammaMode, 0); }
+    glUniform1i(mt_filterShaderLocs.colorLut, 1);
+    glUniform1i(mt_filterShaderLocs.colorLutLayer, -1);
 
     glUseProgram(mt_filterPassthroughProgram);
     glUniform1i(mt_filterPassthroughShaderLocs.screenTexture, 0);
     if (mt_filterPassthroughShaderLocs.gammaMode >= 0) { glUniform1i(mt_filterPassthroughShaderLocs.gammaMode, 0); }
+    glUniform1i(mt_filterPassthroughShaderLocs.colorLut, 1);
+    glUniform1i(mt_filterPassthroughShaderLocs.colorLutLayer, -1);
 
     glUseProgram(mt_passthroughProgram);
     glUniform1i(mt_passthroughShaderLocs.screenTexture, 0);
@@ -581,9 +807,20 @@ static bool MT_InitializeShaders() {
     glUseProgram(mt_renderPassthroughProgram);
     glUniform1i(mt_renderPassthroughShaderLocs.filterTexture, 0);
 
+    if (mt_changeHashProgram) {
+        glUseProgram(mt_changeHashProgram);
+        glUniform1i(mt_changeHashShaderLocs.source, 0);
+    }
+
+    if (mt_batchFilterProgram) {
+        glUseProgram(mt_batchFilterProgram);
+        glUniform1i(mt_batchFilterShaderLocs.screenTexture, 0);
+        glUniform1i(mt_batchFilterShaderLocs.colorLut, 1);
+    }
+
     glUseProgram(0);
 
-    LogCategory("init", "Mirror Thread: Local shaders initialized successfully");
+    LogCategory(LogCategoryId::Init, "Mirror Thread: Local shaders initialized successfully");
     return true;
 }
 
@@ -616,6 +853,14 @@ static void MT_CleanupShaders() {
         glDeleteProgram(mt_staticBorderProgram);
         mt_staticBorderProgram = 0;
     }
+    if (mt_changeHashProgram) {
+        glDeleteProgram(mt_changeHashProgram);
+        mt_changeHashProgram = 0;
+    }
+    if (mt_batchFilterProgram) {
+        glDeleteProgram(mt_batchFilterProgram);
+        mt_batchFilterProgram = 0;
+    }
 }
 
 // Get the most recent copy texture (for OBS/render_thread to use)
@@ -685,8 +930,9 @@ void InitCaptureTexture(int width, int height) {
     g_copyTextureWriteIndex.store(0);
     g_copyTextureReadIndex.store(-1);
 
-    LogCategory("init", "InitCaptureTexture: Created FBO and " + std::to_string(2) + " textures of " + std::to_string(width) + "x" +
-                            std::to_string(height));
+    LogCategory(LogCategoryId::Init,
+                "InitCaptureTexture: Created FBO and " + std::to_string(2) + " textures of " + std::to_string(width) + "x" +
+                    std::to_string(height));
 }
 
 void CleanupCaptureTexture() {
@@ -802,7 +1048,7 @@ void SubmitFrameCapture(GLuint gameTexture, int width, int height) {
 
         g_copyTextureW = width;
         g_copyTextureH = height;
-        LogCategory("texture_ops", "SubmitFrameCapture: Resized copy textures to " + std::to_string(width) + "x" + std::to_string(height));
+        LogEvent(LogCategoryId::TextureOps, "SubmitFrameCapture: Resized copy textures to {}x{}", width, height);
     }
 
     // Create temp FBO to read from game texture
@@ -816,9 +1062,8 @@ void SubmitFrameCapture(GLuint gameTexture, int width, int height) {
     if (srcStatus != GL_FRAMEBUFFER_COMPLETE) {
         static int s_srcIncompleteLog = 0;
         if ((++s_srcIncompleteLog % 240) == 1) {
-            LogCategory("texture_ops",
-                        "SubmitFrameCapture: Source FBO incomplete (status " + std::to_string(srcStatus) + ") gameTex=" +
-                            std::to_string(gameTexture) + " size=" + std::to_string(width) + "x" + std::to_string(height));
+            LogEvent(LogCategoryId::TextureOps, "SubmitFrameCapture: Source FBO incomplete (status {}) gameTex={} size={}x{}", srcStatus,
+                     gameTexture, width, height);
         }
         // Game texture is in a bad state (probably being recreated due to WM_SIZE)
         // Skip this frame's capture - the next frame will have a valid texture
@@ -838,10 +1083,9 @@ void SubmitFrameCapture(GLuint gameTexture, int width, int height) {
     if (dstStatus != GL_FRAMEBUFFER_COMPLETE) {
         static int s_dstIncompleteLog = 0;
         if ((++s_dstIncompleteLog % 240) == 1) {
-            LogCategory("texture_ops",
-                        "SubmitFrameCapture: Destination FBO incomplete (status " + std::to_string(dstStatus) + ") writeIdx=" +
-                            std::to_string(writeIndex) + " dstTex=" + std::to_string(g_copyTextures[writeIndex]) + " size=" +
-                            std::to_string(width) + "x" + std::to_string(height));
+            LogEvent(LogCategoryId::TextureOps,
+                     "SubmitFrameCapture: Destination FBO incomplete (status {}) writeIdx={} dstTex={} size={}x{}", dstStatus, writeIndex,
+                     g_copyTextures[writeIndex], width, height);
         }
         // Our copy texture is in a bad state - skip this frame
         glBindFramebuffer(GL_READ_FRAMEBUFFER, 0);
@@ -971,11 +1215,213 @@ static void ComputeMirrorRenderCache(MirrorInstance* inst, const ThreadedMirrorC
     cache.isValid = true;
 }
 
+// Color-match LUTs (mirror-thread local): one GL_TEXTURE_2D_ARRAY layer per filter mirror, rebuilt on the CPU only
+// when that mirror's target colors, sensitivity or the global gamma mode change.
+struct MT_ColorLutSlot {
+    MirrorColorLutParams params;
+    int layer = -1;
+    std::chrono::steady_clock::time_point lastUsed;
+};
+struct MT_ColorLutCache {
+    GLuint texture = 0;
+    int layers = 0;
+    uint64_t generation = 0; // Bumped whenever the array is reallocated, which invalidates every layer handed out
+    bool disabled = false;
+    std::unordered_map<std::string, MT_ColorLutSlot> slots;
+    std::vector<uint8_t> scratch;
+};
+static MT_ColorLutCache mt_colorLuts;
+
+static void MT_CleanupColorLuts() {
+    if (mt_colorLuts.texture) { glDeleteTextures(1, &mt_colorLuts.texture); }
+    mt_colorLuts = MT_ColorLutCache();
+}
+
+// Free layer for a new slot: reuse one nobody owns, evict mirrors idle for a few seconds, else grow the array
+// (which drops every slot and bumps the generation - layers resolved before that are stale). Returns -1 if no layer
+// can be had.
+static int MT_AllocColorLutLayer(std::chrono::steady_clock::time_point now) {
+    auto freeLayer = [] {
+        std::vector<bool> used(mt_colorLuts.layers, false);
+        for (const auto& kv : mt_colorLuts.slots) { used[kv.second.layer] = true; }
+        for (int i = 0; i < mt_colorLuts.layers; ++i) {
+            if (!used[i]) return i;
+        }
+        return -1;
+    };
+
+    int layer = freeLayer();
+    if (layer >= 0) return layer;
+
+    for (auto it = mt_colorLuts.slots.begin(); it != mt_colorLuts.slots.end();) {
+        if (now - it->second.lastUsed > std::chrono::seconds(5)) {
+            it = mt_colorLuts.slots.erase(it);
+        } else {
+            ++it;
+        }
+    }
+    layer = freeLayer();
+    if (layer >= 0) return layer;
+
+    GLint maxLayers = 0;
+    glGetIntegerv(GL_MAX_ARRAY_TEXTURE_LAYERS, &maxLayers);
+    const int newLayers = (std::min)((std::max)(4, mt_colorLuts.layers * 2), static_cast<int>(maxLayers));
+    if (newLayers <= mt_colorLuts.layers) return -1;
+
+    if (mt_colorLuts.texture == 0) { glGenTextures(1, &mt_colorLuts.texture); }
+    while (glGetError() != GL_NO_ERROR) {} // Only report errors from the allocation below
+    glBindTexture(GL_TEXTURE_2D_ARRAY, mt_colorLuts.texture);
+    glTexImage3D(GL_TEXTURE_2D_ARRAY, 0, GL_R8, MIRROR_LUT_TILE_W, MIRROR_LUT_TILE_H, newLayers, 0, GL_RED, GL_UNSIGNED_BYTE, nullptr);
+    glTexParameteri(GL_TEXTURE_2D_ARRAY, GL_TEXTURE_MIN_FILTER, GL_NEAREST);
+    glTexParameteri(GL_TEXTURE_2D_ARRAY, GL_TEXTURE_MAG_FILTER, GL_NEAREST);
+    glTexParameteri(GL_TEXTURE_2D_ARRAY, GL_TEXTURE_MAX_LEVEL, 0);
+    glBindTexture(GL_TEXTURE_2D_ARRAY, 0);
+    if (glGetError() != GL_NO_ERROR) {
+        Log("Mirror Capture Thread: Failed to allocate color LUT array (" + std::to_string(newLayers) +
+            " layers), using exact color matching");
+        MT_CleanupColorLuts();
+        mt_colorLuts.disabled = true;
+        return -1;
+    }
+    mt_colorLuts.layers = newLayers;
+    mt_colorLuts.slots.clear();
+    mt_colorLuts.generation++;
+    return 0;
+}
+
+// LUT layer holding this mirror's color-match classes, building it if needed. -1 = shader does the exact match.
+static int MT_GetMirrorColorLutLayer(const ThreadedMirrorConfig& conf, MirrorGammaMode gammaMode) {
+    if (mt_colorLuts.disabled || conf.targetColors.empty()) return -1;
+
+    MirrorColorLutParams params;
+    params.targetColorCount = (std::min)(static_cast<int>(conf.targetColors.size()), MIRROR_LUT_MAX_TARGET_COLORS);
+    for (int i = 0; i < params.targetColorCount; ++i) {
+        params.targetColors[i][0] = conf.targetColors[i].r;
+        params.targetColors[i][1] = conf.targetColors[i].g;
+        params.targetColors[i][2] = conf.targetColors[i].b;
+    }
+    params.sensitivity = conf.colorSensitivity;
+    params.gammaMode = static_cast<int>(gammaMode);
+
+    const auto now = std::chrono::steady_clock::now();
+    auto it = mt_colorLuts.slots.find(conf.name);
+    if (it != mt_colorLuts.slots.end() && it->second.params == params) {
+        it->second.lastUsed = now;
+        return it->second.layer;
+    }
+
+    int layer = (it != mt_colorLuts.slots.end()) ? it->second.layer : MT_AllocColorLutLayer(now);
+    if (layer < 0) return -1;
+
+    PROFILE_SCOPE_CAT("Build Color LUT", "Mirror Thread");
+    int ambiguous = BuildMirrorColorLut(params, mt_colorLuts.scratch);
+    glBindTexture(GL_TEXTURE_2D_ARRAY, mt_colorLuts.texture);
+    glPixelStorei(GL_UNPACK_ALIGNMENT, 1);
+    glTexSubImage3D(GL_TEXTURE_2D_ARRAY, 0, 0, 0, layer, MIRROR_LUT_TILE_W, MIRROR_LUT_TILE_H, 1, GL_RED, GL_UNSIGNED_BYTE,
+                    mt_colorLuts.scratch.data());
+    glPixelStorei(GL_UNPACK_ALIGNMENT, 4);
+    glBindTexture(GL_TEXTURE_2D_ARRAY, 0);
+
+    MT_ColorLutSlot& slot = mt_colorLuts.slots[conf.name];
+    slot.params = params;
+    slot.layer = layer;
+    slot.lastUsed = now;
+    LogCategory(LogCategoryId::TextureOps,
+                "Mirror Capture Thread: Built color LUT for '" + conf.name + "' in layer " + std::to_string(layer) +
+                    " (" + std::to_string(ambiguous) + " ambiguous cells)");
+    return layer;
+}
+
+// === PASS 2: Apply border shader and render to final texture ===
+// Reads inst->fboTextureBack (filter output) and writes inst->finalTextureBack. Expects captureVAO/VBO bound.
+static void MT_ApplyMirrorFinalPass(MirrorInstance* inst, const ThreadedMirrorConfig& conf, bool useRawOutput, bool useColorPassthrough,
+                                    GLuint captureFinalBackFbo) {
+    // This produces screen-ready content so render thread just needs to blit.
+    // IMPORTANT: Use the mirror-thread-local FBO (framebuffer objects may not be shared across contexts).
+    if (captureFinalBackFbo != 0 && inst->finalTextureBack != 0) {
+        PROFILE_SCOPE_CAT("Apply Border Shader", "Mirror Thread");
+
+        if (useRawOutput) {
+            // Raw output: just passthrough, no borders
+            glBindFramebuffer(GL_FRAMEBUFFER, captureFinalBackFbo);
+            if (oglViewport)
+                oglViewport(0, 0, inst->final_w_back, inst->final_h_back);
+            else
+                glViewport(0, 0, inst->final_w_back, inst->final_h_back);
+            glClearColor(0.0f, 0.0f, 0.0f, 1.0f); // Opaque for raw output
+            glClear(GL_COLOR_BUFFER_BIT);
+
+            glBindTexture(GL_TEXTURE_2D, inst->fboTextureBack);
+            glUseProgram(mt_backgroundProgram);
+            glUniform1i(mt_backgroundShaderLocs.backgroundTexture, 0);
+            glUniform1f(mt_backgroundShaderLocs.opacity, 1.0f);
+
+            static const float fullscreenVerts[] = { -1, -1, 0, 0, 1, -1, 1, 0, 1, 1, 1, 1, -1, -1, 0, 0, 1, 1, 1, 1, -1, 1, 0, 1 };
+            glBufferSubData(GL_ARRAY_BUFFER, 0, sizeof(fullscreenVerts), fullscreenVerts);
+            glDrawArrays(GL_TRIANGLES, 0, 6);
+        } else if (conf.borderType == MirrorBorderType::Static) {
+            // Static border mode: just passthrough the filter output (no dynamic border shader)
+            // Static border will be rendered later in render_thread.cpp on top of the mirror
+            glBindFramebuffer(GL_FRAMEBUFFER, captureFinalBackFbo);
+            if (oglViewport)
+                oglViewport(0, 0, inst->final_w_back, inst->final_h_back);
+            else
+                glViewport(0, 0, inst->final_w_back, inst->final_h_back);
+            glClearColor(0.0f, 0.0f, 0.0f, 0.0f); // Transparent
+            glClear(GL_COLOR_BUFFER_BIT);
+
+            glBindTexture(GL_TEXTURE_2D, inst->fboTextureBack);
+            glUseProgram(mt_backgroundProgram);
+            glUniform1i(mt_backgroundShaderLocs.backgroundTexture, 0);
+            glUniform1f(mt_backgroundShaderLocs.opacity, 1.0f);
+
+            static const float fullscreenVerts[] = { -1, -1, 0, 0, 1, -1, 1, 0, 1, 1, 1, 1, -1, -1, 0, 0, 1, 1, 1, 1, -1, 1, 0, 1 };
+            glBufferSubData(GL_ARRAY_BUFFER, 0, sizeof(fullscreenVerts), fullscreenVerts);
+            glDrawArrays(GL_TRIANGLES, 0, 6);
+        } else {
+            // Dynamic border mode: apply the border render shader
+            glBindFramebuffer(GL_FRAMEBUFFER, captureFinalBackFbo);
+            if (oglViewport)
+                oglViewport(0, 0, inst->final_w_back, inst->final_h_back);
+            else
+                glViewport(0, 0, inst->final_w_back, inst->final_h_back);
+            glClearColor(0.0f, 0.0f, 0.0f, 0.0f); // Transparent for non-raw
+            glClear(GL_COLOR_BUFFER_BIT);
+
+            glBindTexture(GL_TEXTURE_2D, inst->fboTextureBack);
+            if (useColorPassthrough) {
+                // Use passthrough render shader - preserves original pixel color
+                glUseProgram(mt_renderPassthroughProgram);
+                glUniform1i(mt_renderPassthroughShaderLocs.borderWidth, conf.dynamicBorderThickness);
+                glUniform4f(mt_renderPassthroughShaderLocs.borderColor, conf.borderColor.r, conf.borderColor.g, conf.borderColor.b,
+                            conf.borderColor.a);
+                glUniform2f(mt_renderPassthroughShaderLocs.screenPixel, 1.0f / inst->final_w_back, 1.0f / inst->final_h_back);
+            } else {
+                // Use normal render shader - replaces pixel color with outputColor
+                glUseProgram(mt_renderProgram);
+                glUniform1i(mt_renderShaderLocs.borderWidth, conf.dynamicBorderThickness);
+                glUniform4f(mt_renderShaderLocs.outputColor, conf.outputColor.r, conf.outputColor.g, conf.outputColor.b,
+                            conf.outputColor.a);
+                glUniform4f(mt_renderShaderLocs.borderColor, conf.borderColor.r, conf.borderColor.g, conf.borderColor.b,
+                            conf.borderColor.a);
+                glUniform2f(mt_renderShaderLocs.screenPixel, 1.0f / inst->final_w_back, 1.0f / inst->final_h_back);
+            }
+
+            static const float fullscreenVerts[] = { -1, -1, 0, 0, 1, -1, 1, 0, 1, 1, 1, 1, -1, -1, 0, 0, 1, 1, 1, 1, -1, 1, 0, 1 };
+            glBufferSubData(GL_ARRAY_BUFFER, 0, sizeof(fullscreenVerts), fullscreenVerts);
+            glDrawArrays(GL_TRIANGLES, 0, 6);
+        }
+
+        // NOTE: Static border is rendered in render_thread.cpp after mirror compositing
+        // to allow the border to extend beyond the mirror bounds
+    }
+}
+
 // Helper: Render a single mirror to its back buffer
 // Returns true if rendering succeeded
 static bool RenderMirrorToBackBuffer(MirrorInstance* inst, const ThreadedMirrorConfig& conf, GLuint validCopyTexture, GLuint captureVAO,
                                      GLuint captureVBO, GLuint captureBackFbo, GLuint captureFinalBackFbo, MirrorGammaMode gammaMode,
-                                     int gameW, int gameH) {
+                                     int gameW, int gameH, int colorLutLayer) {
     PROFILE_SCOPE_CAT("Capture Single Mirror", "Mirror Thread");
 
     // Capture to back buffer
@@ -995,6 +1441,10 @@ static bool RenderMirrorToBackBuffer(MirrorInstance* inst, const ThreadedMirrorC
     glClearColor(0.0f, 0.0f, 0.0f, 0.0f);
     glClear(GL_COLOR_BUFFER_BIT);
 
+    // Color-match LUT on unit 1 (ignored by the shaders when colorLutLayer < 0)
+    glActiveTexture(GL_TEXTURE1);
+    glBindTexture(GL_TEXTURE_2D_ARRAY, colorLutLayer >= 0 ? mt_colorLuts.texture : 0);
+
     // Bind VALID COPIED texture (the last known good copy)
     glActiveTexture(GL_TEXTURE0);
     glBindTexture(GL_TEXTURE_2D, validCopyTexture);
@@ -1026,6 +1476,7 @@ static bool RenderMirrorToBackBuffer(MirrorInstance* inst, const ThreadedMirrorC
         }
 
         glUniform1f(mt_filterPassthroughShaderLocs.sensitivity, conf.colorSensitivity);
+        glUniform1i(mt_filterPassthroughShaderLocs.colorLutLayer, colorLutLayer);
     } else {
         glUseProgram(mt_filterProgram);
         glUniform1i(mt_filterShaderLocs.screenTexture, 0);
@@ -1044,6 +1495,7 @@ static bool RenderMirrorToBackBuffer(MirrorInstance* inst, const ThreadedMirrorC
 
         glUniform4f(mt_filterShaderLocs.outputColor, conf.outputColor.r, conf.outputColor.g, conf.outputColor.b, conf.outputColor.a);
         glUniform1f(mt_filterShaderLocs.sensitivity, conf.colorSensitivity);
+        glUniform1i(mt_filterShaderLocs.colorLutLayer, colorLutLayer);
     }
 
     glBindVertexArray(captureVAO);
@@ -1114,105 +1566,541 @@ static bool RenderMirrorToBackBuffer(MirrorInstance* inst, const ThreadedMirrorC
     }
     inst->hasFrameContentBack = hasContent;
 
-    // === PASS 2: Apply border shader and render to final texture ===
-    // This produces screen-ready content so render thread just needs to blit.
-    // IMPORTANT: Use the mirror-thread-local FBO (framebuffer objects may not be shared across contexts).
-    if (captureFinalBackFbo != 0 && inst->finalTextureBack != 0) {
-        PROFILE_SCOPE_CAT("Apply Border Shader", "Mirror Thread");
+    MT_ApplyMirrorFinalPass(inst, conf, useRawOutput, useColorPassthrough, captureFinalBackFbo);
 
-        if (useRawOutput) {
-            // Raw output: just passthrough, no borders
-            glBindFramebuffer(GL_FRAMEBUFFER, captureFinalBackFbo);
-            if (oglViewport)
-                oglViewport(0, 0, inst->final_w_back, inst->final_h_back);
-            else
-                glViewport(0, 0, inst->final_w_back, inst->final_h_back);
-            glClearColor(0.0f, 0.0f, 0.0f, 1.0f); // Opaque for raw output
-            glClear(GL_COLOR_BUFFER_BIT);
+    return true;
+}
 
-            glBindTexture(GL_TEXTURE_2D, inst->fboTextureBack);
-            glUseProgram(mt_backgroundProgram);
-            glUniform1i(mt_backgroundShaderLocs.backgroundTexture, 0);
-            glUniform1f(mt_backgroundShaderLocs.opacity, 1.0f);
+// Mirror-thread local FBOs.
+// IMPORTANT: Framebuffer objects are not reliably shared between WGL contexts across all drivers.
+// We therefore create FBO objects on the mirror capture context and only attach the shared textures.
+struct MT_MirrorFbos {
+    GLuint backFbo = 0;       // attaches inst->fboTextureBack
+    GLuint finalBackFbo = 0;  // attaches inst->finalTextureBack
+    GLuint lastBackTex = 0;
+    GLuint lastFinalBackTex = 0;
+};
 
-            static const float fullscreenVerts[] = { -1, -1, 0, 0, 1, -1, 1, 0, 1, 1, 1, 1, -1, -1, 0, 0, 1, 1, 1, 1, -1, 1, 0, 1 };
-            glBufferSubData(GL_ARRAY_BUFFER, 0, sizeof(fullscreenVerts), fullscreenVerts);
-            glDrawArrays(GL_TRIANGLES, 0, 6);
-        } else if (conf.borderType == MirrorBorderType::Static) {
-            // Static border mode: just passthrough the filter output (no dynamic border shader)
-            // Static border will be rendered later in render_thread.cpp on top of the mirror
-            glBindFramebuffer(GL_FRAMEBUFFER, captureFinalBackFbo);
-            if (oglViewport)
-                oglViewport(0, 0, inst->final_w_back, inst->final_h_back);
-            else
-                glViewport(0, 0, inst->final_w_back, inst->final_h_back);
-            glClearColor(0.0f, 0.0f, 0.0f, 0.0f); // Transparent
-            glClear(GL_COLOR_BUFFER_BIT);
+// Unchanged-frame detection (mirror-thread local). A mirror with skipUnchangedFrames re-renders only when the
+// digest of its input pixels + render state differs from the one its front buffer was rendered from.
+// Cell hashes come back through a PBO + fence and are collected on a later capture, so hashing never stalls the
+// thread; the price is that an input change is noticed one capture late.
+struct MT_ChangeDetectState {
+    uint64_t lastDigest = 0; // Digest of the input the front buffer was rendered from
+    bool hasDigest = false;
+    uint64_t latestDigest = 0; // Most recent digest read back, and the render-state seed it was taken with
+    uint64_t latestSeed = 0;
+    bool hasLatest = false;
+
+    // In-flight readback (fence != nullptr while the GPU may still be writing pbo)
+    GLuint pbo = 0;
+    GLsizeiptr pboSize = 0;
+    GLsync fence = nullptr;
+    uint64_t pendingSeed = 0;
+    bool pendingRendered = false;      // The capture the hash was taken from was rendered
+    std::vector<int> pendingGridSizes; // gridW, gridH per input region
+
+    uint64_t windowChecks = 0; // Reset each time stats are published
+    uint64_t windowSkips = 0;
+};
 
-            glBindTexture(GL_TEXTURE_2D, inst->fboTextureBack);
-            glUseProgram(mt_backgroundProgram);
-            glUniform1i(mt_backgroundShaderLocs.backgroundTexture, 0);
-            glUniform1f(mt_backgroundShaderLocs.opacity, 1.0f);
+static void MT_CleanupChangeDetectState(MT_ChangeDetectState& change) {
+    if (change.fence) { glDeleteSync(change.fence); }
+    if (change.pbo) { glDeleteBuffers(1, &change.pbo); }
+    change = MT_ChangeDetectState();
+}
 
-            static const float fullscreenVerts[] = { -1, -1, 0, 0, 1, -1, 1, 0, 1, 1, 1, 1, -1, -1, 0, 0, 1, 1, 1, 1, -1, 1, 0, 1 };
-            glBufferSubData(GL_ARRAY_BUFFER, 0, sizeof(fullscreenVerts), fullscreenVerts);
-            glDrawArrays(GL_TRIANGLES, 0, 6);
+// Non-blocking fence poll; deletes and clears the fence once the GPU has passed it
+static bool MT_PollFence(GLsync& fence) {
+    if (!fence) return true;
+    GLenum result = glClientWaitSync(fence, 0, 0);
+    if (result != GL_ALREADY_SIGNALED && result != GL_CONDITION_SATISFIED) return false;
+    glDeleteSync(fence);
+    fence = nullptr;
+    return true;
+}
+
+// Shared R32UI target for the cell hashes: MIRROR_HASH_MAX_GRID wide, MIRROR_HASH_MAX_GRID rows per input region
+struct MT_ChangeHashTarget {
+    GLuint fbo = 0;
+    GLuint texture = 0;
+    int rows = 0;
+};
+static MT_ChangeHashTarget mt_changeHashTarget;
+static std::vector<uint32_t> mt_changeHashCells;
+
+static void MT_CleanupChangeHashTarget() {
+    if (mt_changeHashTarget.fbo) { glDeleteFramebuffers(1, &mt_changeHashTarget.fbo); }
+    if (mt_changeHashTarget.texture) { glDeleteTextures(1, &mt_changeHashTarget.texture); }
+    mt_changeHashTarget = MT_ChangeHashTarget();
+}
+
+// Everything besides input pixels that changes what RenderMirrorToBackBuffer/ComputeMirrorRenderCache produce
+static uint64_t MT_MirrorRenderStateSeed(const MirrorInstance* inst, const ThreadedMirrorConfig& conf, bool rawOutput,
+                                         MirrorGammaMode gammaMode, int gameW, int gameH) {
+    uint64_t d = MIRROR_DIGEST_SEED;
+    auto mixString = [&d](const std::string& str) {
+        d = MirrorDigestMixValue(d, str.size());
+        d = MirrorDigestMix(d, str.data(), str.size());
+    };
+    auto mixColor = [&d](const Color& c) {
+        d = MirrorDigestMixValue(d, c.r);
+        d = MirrorDigestMixValue(d, c.g);
+        d = MirrorDigestMixValue(d, c.b);
+        d = MirrorDigestMixValue(d, c.a);
+    };
+
+    d = MirrorDigestMixValue(d, conf.captureWidth);
+    d = MirrorDigestMixValue(d, conf.captureHeight);
+    d = MirrorDigestMixValue(d, conf.borderType);
+    d = MirrorDigestMixValue(d, conf.dynamicBorderThickness);
+    d = MirrorDigestMixValue(d, rawOutput);
+    d = MirrorDigestMixValue(d, conf.colorPassthrough);
+    d = MirrorDigestMixValue(d, conf.targetColors.size());
+    for (const auto& c : conf.targetColors) { mixColor(c); }
+    mixColor(conf.outputColor);
+    mixColor(conf.borderColor);
+    d = MirrorDigestMixValue(d, conf.colorSensitivity);
+    d = MirrorDigestMixValue(d, conf.input.size());
+    for (const auto& r : conf.input) {
+        d = MirrorDigestMixValue(d, r.x);
+        d = MirrorDigestMixValue(d, r.y);
+        mixString(r.relativeTo);
+    }
+    d = MirrorDigestMixValue(d, conf.outputScale);
+    d = MirrorDigestMixValue(d, conf.outputSeparateScale);
+    d = MirrorDigestMixValue(d, conf.outputScaleX);
+    d = MirrorDigestMixValue(d, conf.outputScaleY);
+    d = MirrorDigestMixValue(d, conf.outputX);
+    d = MirrorDigestMixValue(d, conf.outputY);
+    mixString(conf.outputRelativeTo);
+    d = MirrorDigestMixValue(d, gammaMode);
+    d = MirrorDigestMixValue(d, gameW);
+    d = MirrorDigestMixValue(d, gameH);
+    d = MirrorDigestMixValue(d, inst->fbo_w);
+    d = MirrorDigestMixValue(d, inst->fbo_h);
+
+    const int geometry[] = { g_captureScreenW.load(std::memory_order_acquire), g_captureScreenH.load(std::memory_order_acquire),
+                             g_captureFinalX.load(std::memory_order_acquire),  g_captureFinalY.load(std::memory_order_acquire),
+                             g_captureFinalW.load(std::memory_order_acquire),  g_captureFinalH.load(std::memory_order_acquire) };
+    d = MirrorDigestMix(d, geometry, sizeof(geometry));
+    return d;
+}
+
+// Hash the mirror's input regions on the GPU and start reading the cell hashes back into the mirror's PBO.
+// The caller must have collected any previous readback. Returns false if detection isn't available (caller just renders).
+static bool MT_StartMirrorInputHash(const ThreadedMirrorConfig& conf, GLuint srcTexture, int gameW, int gameH, GLuint captureVAO,
+                                    GLuint captureVBO, uint64_t seed, bool rendered, MT_ChangeDetectState& change) {
+    PROFILE_SCOPE_CAT("Mirror Change Hash", "Mirror Thread");
+    constexpr size_t kMaxHashedRegions = 64;
+    if (!mt_changeHashProgram || conf.input.empty() || conf.input.size() > kMaxHashedRegions || gameW <= 0 || gameH <= 0) return false;
+
+    GLint texW = 0, texH = 0;
+    glBindTexture(GL_TEXTURE_2D, srcTexture);
+    glGetTexLevelParameteriv(GL_TEXTURE_2D, 0, GL_TEXTURE_WIDTH, &texW);
+    glGetTexLevelParameteriv(GL_TEXTURE_2D, 0, GL_TEXTURE_HEIGHT, &texH);
+    if (texW <= 0 || texH <= 0) return false;
+
+    const int rows = static_cast<int>(conf.input.size()) * MIRROR_HASH_MAX_GRID;
+    if (mt_changeHashTarget.rows < rows) {
+        if (mt_changeHashTarget.texture == 0) { glGenTextures(1, &mt_changeHashTarget.texture); }
+        if (mt_changeHashTarget.fbo == 0) { glGenFramebuffers(1, &mt_changeHashTarget.fbo); }
+        glBindTexture(GL_TEXTURE_2D, mt_changeHashTarget.texture);
+        glTexImage2D(GL_TEXTURE_2D, 0, GL_R32UI, MIRROR_HASH_MAX_GRID, rows, 0, GL_RED_INTEGER, GL_UNSIGNED_INT, nullptr);
+        glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MIN_FILTER, GL_NEAREST);
+        glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MAG_FILTER, GL_NEAREST);
+        glBindFramebuffer(GL_FRAMEBUFFER, mt_changeHashTarget.fbo);
+        glFramebufferTexture2D(GL_FRAMEBUFFER, GL_COLOR_ATTACHMENT0, GL_TEXTURE_2D, mt_changeHashTarget.texture, 0);
+        if (glCheckFramebufferStatus(GL_FRAMEBUFFER) != GL_FRAMEBUFFER_COMPLETE) {
+            Log("Mirror Capture Thread: Change-hash FBO incomplete, unchanged-frame skipping disabled");
+            MT_CleanupChangeHashTarget();
+            glDeleteProgram(mt_changeHashProgram);
+            mt_changeHashProgram = 0;
+            return false;
+        }
+        mt_changeHashTarget.rows = rows;
+    }
+
+    glBindFramebuffer(GL_FRAMEBUFFER, mt_changeHashTarget.fbo);
+    glDisable(GL_BLEND);
+    glDisable(GL_DEPTH_TEST);
+    glDisable(GL_STENCIL_TEST);
+    glDisable(GL_SCISSOR_TEST);
+    glActiveTexture(GL_TEXTURE0);
+    glBindTexture(GL_TEXTURE_2D, srcTexture);
+    glUseProgram(mt_changeHashProgram);
+    glBindVertexArray(captureVAO);
+    glBindBuffer(GL_ARRAY_BUFFER, captureVBO);
+
+    // One grid per input region, stacked vertically; grid sizes are derived exactly as the shader derives regions
+    const size_t regionCount = conf.input.size();
+    change.pendingGridSizes.resize(regionCount * 2);
+    for (size_t i = 0; i < regionCount; ++i) {
+        const auto& r = conf.input[i];
+        int capX, capY;
+        GetRelativeCoords(r.relativeTo, r.x, r.y, conf.captureWidth, conf.captureHeight, gameW, gameH, capX, capY);
+        int capY_gl = gameH - capY - conf.captureHeight;
+        float sx = static_cast<float>(capX) / gameW;
+        float sy = static_cast<float>(capY_gl) / gameH;
+        float sw = static_cast<float>(conf.captureWidth) / gameW;
+        float sh = static_cast<float>(conf.captureHeight) / gameH;
+
+        int gridW, gridH;
+        MirrorHashGridSize(MirrorHashRegionFromRect(sx, sy, sw, sh, texW, texH), gridW, gridH);
+        change.pendingGridSizes[i * 2] = gridW;
+        change.pendingGridSizes[i * 2 + 1] = gridH;
+
+        const int rowOffset = static_cast<int>(i) * MIRROR_HASH_MAX_GRID;
+        if (oglViewport)
+            oglViewport(0, rowOffset, gridW, gridH);
+        else
+            glViewport(0, rowOffset, gridW, gridH);
+        glUniform4f(mt_changeHashShaderLocs.sourceRect, sx, sy, sw, sh);
+        glUniform2i(mt_changeHashShaderLocs.grid, gridW, gridH);
+        glUniform1i(mt_changeHashShaderLocs.rowOffset, rowOffset);
+        glDrawArrays(GL_TRIANGLES, 0, 6);
+    }
+
+    // Asynchronous readback (1 KB per region) into the PBO; MT_CollectMirrorInputHash picks it up once the fence passes
+    const int readRows = static_cast<int>(regionCount) * MIRROR_HASH_MAX_GRID;
+    const GLsizeiptr readSize = static_cast<GLsizeiptr>(MIRROR_HASH_MAX_GRID) * readRows * sizeof(uint32_t);
+    if (change.pbo == 0) { glGenBuffers(1, &change.pbo); }
+    glBindBuffer(GL_PIXEL_PACK_BUFFER, change.pbo);
+    if (change.pboSize < readSize) {
+        glBufferData(GL_PIXEL_PACK_BUFFER, readSize, nullptr, GL_STREAM_READ);
+        change.pboSize = readSize;
+    }
+    glPixelStorei(GL_PACK_ALIGNMENT, 4);
+    glReadPixels(0, 0, MIRROR_HASH_MAX_GRID, readRows, GL_RED_INTEGER, GL_UNSIGNED_INT, (void*)0);
+    glBindBuffer(GL_PIXEL_PACK_BUFFER, 0);
+
+    change.fence = glFenceSync(GL_SYNC_GPU_COMMANDS_COMPLETE, 0);
+    change.pendingSeed = seed;
+    change.pendingRendered = rendered;
+
+    glUseProgram(0);
+    return true;
+}
+
+// If the mirror's hash readback has finished, fold it into latestDigest (and lastDigest if that capture was rendered).
+// Never waits on the GPU.
+static void MT_CollectMirrorInputHash(MT_ChangeDetectState& change) {
+    if (!change.fence || !MT_PollFence(change.fence)) return;
+
+    const size_t regionCount = change.pendingGridSizes.size() / 2;
+    mt_changeHashCells.resize(regionCount * MIRROR_HASH_MAX_GRID * MIRROR_HASH_MAX_GRID);
+    glBindBuffer(GL_PIXEL_PACK_BUFFER, change.pbo);
+    glGetBufferSubData(GL_PIXEL_PACK_BUFFER, 0, mt_changeHashCells.size() * sizeof(uint32_t), mt_changeHashCells.data());
+    glBindBuffer(GL_PIXEL_PACK_BUFFER, 0);
+
+    uint64_t digest = change.pendingSeed;
+    for (size_t i = 0; i < regionCount; ++i) {
+        const int gridW = change.pendingGridSizes[i * 2];
+        const int gridH = change.pendingGridSizes[i * 2 + 1];
+        for (int row = 0; row < gridH; ++row) {
+            const uint32_t* cells = mt_changeHashCells.data() + (i * MIRROR_HASH_MAX_GRID + row) * MIRROR_HASH_MAX_GRID;
+            digest = CombineMirrorCellHashes(cells, gridW, digest);
+        }
+    }
+
+    change.latestDigest = digest;
+    change.latestSeed = change.pendingSeed;
+    change.hasLatest = true;
+    if (change.pendingRendered) {
+        change.lastDigest = digest;
+        change.hasDigest = true;
+    }
+}
+
+// Mirror due this capture, collected before rendering so the filter passes can be batched
+struct MT_PendingMirror {
+    MirrorInstance* inst = nullptr;
+    ThreadedMirrorConfig* conf = nullptr;
+    GLuint backFbo = 0;
+    GLuint finalBackFbo = 0;
+    bool rawOutput = false;
+    int colorLutLayer = -1;
+};
+
+// Resolve the color LUT layer of every pending mirror. Growing the LUT array mid-way reallocates it and drops the
+// layers resolved so far, so resolve again until a whole pass completes at one generation (bounded: each grow doubles
+// the array, and allocation fails instead of growing past GL_MAX_ARRAY_TEXTURE_LAYERS).
+static void MT_ResolveColorLutLayers(std::vector<MT_PendingMirror>& pending, MirrorGammaMode gammaMode) {
+    for (;;) {
+        const uint64_t generation = mt_colorLuts.generation;
+        for (auto& p : pending) { p.colorLutLayer = p.rawOutput ? -1 : MT_GetMirrorColorLutLayer(*p.conf, gammaMode); }
+        if (mt_colorLuts.generation == generation) break;
+    }
+}
+
+// Shared atlas the batched filter pass renders into, plus the uniform buffer holding the instance block
+struct MT_BatchTarget {
+    GLuint fbo = 0;
+    GLuint texture = 0;
+    GLuint ubo = 0;
+    int w = 0;
+    int h = 0;
+};
+static MT_BatchTarget mt_batchTarget;
+static std::vector<MirrorFilterInstanceStd140> mt_batchRawInstances;
+static std::vector<MirrorFilterInstanceStd140> mt_batchFilterInstances;
+static std::vector<unsigned char> mt_batchPixels;
+
+static void MT_CleanupBatchTarget() {
+    if (mt_batchTarget.fbo) { glDeleteFramebuffers(1, &mt_batchTarget.fbo); }
+    if (mt_batchTarget.texture) { glDeleteTextures(1, &mt_batchTarget.texture); }
+    if (mt_batchTarget.ubo) { glDeleteBuffers(1, &mt_batchTarget.ubo); }
+    mt_batchTarget = MT_BatchTarget();
+}
+
+static bool MT_EnsureBatchTarget(int w, int h) {
+    if (mt_batchTarget.ubo == 0) {
+        glGenBuffers(1, &mt_batchTarget.ubo);
+        glBindBuffer(GL_UNIFORM_BUFFER, mt_batchTarget.ubo);
+        glBufferData(GL_UNIFORM_BUFFER, sizeof(MirrorFilterInstanceStd140) * MIRROR_BATCH_MAX_INSTANCES, nullptr, GL_STREAM_DRAW);
+    }
+    if (mt_batchTarget.w >= w && mt_batchTarget.h >= h) return true;
+
+    // Grow only; the atlas is reused every capture
+    const int newW = (std::max)(w, mt_batchTarget.w);
+    const int newH = (std::max)(h, mt_batchTarget.h);
+    if (mt_batchTarget.texture == 0) { glGenTextures(1, &mt_batchTarget.texture); }
+    if (mt_batchTarget.fbo == 0) { glGenFramebuffers(1, &mt_batchTarget.fbo); }
+    glBindTexture(GL_TEXTURE_2D, mt_batchTarget.texture);
+    glTexImage2D(GL_TEXTURE_2D, 0, GL_RGBA8, newW, newH, 0, GL_RGBA, GL_UNSIGNED_BYTE, nullptr);
+    glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MIN_FILTER, GL_NEAREST);
+    glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MAG_FILTER, GL_NEAREST);
+    glBindTexture(GL_TEXTURE_2D, 0);
+    glBindFramebuffer(GL_FRAMEBUFFER, mt_batchTarget.fbo);
+    glFramebufferTexture2D(GL_FRAMEBUFFER, GL_COLOR_ATTACHMENT0, GL_TEXTURE_2D, mt_batchTarget.texture, 0);
+    if (glCheckFramebufferStatus(GL_FRAMEBUFFER) != GL_FRAMEBUFFER_COMPLETE) {
+        Log("Mirror Capture Thread: Batch atlas FBO incomplete (" + std::to_string(newW) + "x" + std::to_string(newH) +
+            "), batching disabled");
+        MT_CleanupBatchTarget();
+        glDeleteProgram(mt_batchFilterProgram);
+        mt_batchFilterProgram = 0;
+        return false;
+    }
+    mt_batchTarget.w = newW;
+    mt_batchTarget.h = newH;
+    return true;
+}
+
+// Pass 1 for every pending mirror at once: pack their filter FBOs into the atlas, draw all input regions as instances
+// (raw mirrors with blending off, filter mirrors additively - same as RenderMirrorToBackBuffer), do one content
+// readback for the whole atlas, then copy each rect into the mirror's own fboTextureBack and run its pass 2.
+// Returns false without touching any mirror if batching isn't possible; the caller then renders them individually.
+static bool MT_RenderMirrorBatch(std::vector<MT_PendingMirror>& pending, GLuint validCopyTexture, GLuint captureVAO, GLuint captureVBO,
+                                 MirrorGammaMode gammaMode, int gameW, int gameH) {
+    PROFILE_SCOPE_CAT("Capture Mirror Batch", "Mirror Thread");
+    if (!mt_batchFilterProgram || pending.empty() || gameW <= 0 || gameH <= 0) return false;
+
+    static GLint s_maxTextureSize = 0;
+    if (s_maxTextureSize == 0) { glGetIntegerv(GL_MAX_TEXTURE_SIZE, &s_maxTextureSize); }
+
+    std::vector<MirrorAtlasRect> sizes(pending.size());
+    for (size_t i = 0; i < pending.size(); ++i) { sizes[i] = { 0, 0, pending[i].inst->fbo_w, pending[i].inst->fbo_h }; }
+    std::vector<MirrorAtlasRect> rects;
+    int atlasW = 0, atlasH = 0;
+    if (!PackMirrorAtlas(sizes, (std::min)(static_cast<int>(s_maxTextureSize), 8192), rects, atlasW, atlasH)) return false;
+    if (!MT_EnsureBatchTarget(atlasW, atlasH)) return false;
+
+    // One instance per input region
+    mt_batchRawInstances.clear();
+    mt_batchFilterInstances.clear();
+    for (size_t i = 0; i < pending.size(); ++i) {
+        const ThreadedMirrorConfig& conf = *pending[i].conf;
+        const int padding = (conf.borderType == MirrorBorderType::Dynamic) ? conf.dynamicBorderThickness : 0;
+
+        float targetColors[MIRROR_BATCH_MAX_TARGET_COLORS][3] = {};
+        const int colorCount = (std::min)(static_cast<int>(conf.targetColors.size()), MIRROR_BATCH_MAX_TARGET_COLORS);
+        for (int c = 0; c < colorCount; ++c) {
+            targetColors[c][0] = conf.targetColors[c].r;
+            targetColors[c][1] = conf.targetColors[c].g;
+            targetColors[c][2] = conf.targetColors[c].b;
+        }
+
+        MirrorFilterInstanceDesc desc;
+        desc.dst = { rects[i].x + padding, rects[i].y + padding, conf.captureWidth, conf.captureHeight };
+        desc.clip = rects[i];
+        if (pending[i].rawOutput) {
+            desc.mode = MirrorFilterMode::Raw;
+        } else if (conf.colorPassthrough) {
+            desc.mode = MirrorFilterMode::ColorPassthrough;
         } else {
-            // Dynamic border mode: apply the border render shader
-            glBindFramebuffer(GL_FRAMEBUFFER, captureFinalBackFbo);
-            if (oglViewport)
-                oglViewport(0, 0, inst->final_w_back, inst->final_h_back);
-            else
-                glViewport(0, 0, inst->final_w_back, inst->final_h_back);
-            glClearColor(0.0f, 0.0f, 0.0f, 0.0f); // Transparent for non-raw
-            glClear(GL_COLOR_BUFFER_BIT);
+            desc.mode = MirrorFilterMode::Filter;
+        }
+        desc.targetColors = targetColors;
+        desc.targetColorCount = colorCount;
+        desc.outputColor[0] = conf.outputColor.r;
+        desc.outputColor[1] = conf.outputColor.g;
+        desc.outputColor[2] = conf.outputColor.b;
+        desc.outputColor[3] = conf.outputColor.a;
+        desc.sensitivity = conf.colorSensitivity;
+        desc.gammaMode = static_cast<int>(gammaMode);
+        desc.colorLutLayer = pending[i].colorLutLayer;
+
+        auto& instances = pending[i].rawOutput ? mt_batchRawInstances : mt_batchFilterInstances;
+        for (const auto& r : conf.input) {
+            int capX, capY;
+            GetRelativeCoords(r.relativeTo, r.x, r.y, conf.captureWidth, conf.captureHeight, gameW, gameH, capX, capY);
+            int capY_gl = gameH - capY - conf.captureHeight;
+            desc.srcRect[0] = static_cast<float>(capX) / gameW;
+            desc.srcRect[1] = static_cast<float>(capY_gl) / gameH;
+            desc.srcRect[2] = static_cast<float>(conf.captureWidth) / gameW;
+            desc.srcRect[3] = static_cast<float>(conf.captureHeight) / gameH;
+            instances.push_back(BuildMirrorFilterInstance(desc));
+        }
+    }
 
-            glBindTexture(GL_TEXTURE_2D, inst->fboTextureBack);
-            if (useColorPassthrough) {
-                // Use passthrough render shader - preserves original pixel color
-                glUseProgram(mt_renderPassthroughProgram);
-                glUniform1i(mt_renderPassthroughShaderLocs.borderWidth, conf.dynamicBorderThickness);
-                glUniform4f(mt_renderPassthroughShaderLocs.borderColor, conf.borderColor.r, conf.borderColor.g, conf.borderColor.b,
-                            conf.borderColor.a);
-                glUniform2f(mt_renderPassthroughShaderLocs.screenPixel, 1.0f / inst->final_w_back, 1.0f / inst->final_h_back);
-            } else {
-                // Use normal render shader - replaces pixel color with outputColor
-                glUseProgram(mt_renderProgram);
-                glUniform1i(mt_renderShaderLocs.borderWidth, conf.dynamicBorderThickness);
-                glUniform4f(mt_renderShaderLocs.outputColor, conf.outputColor.r, conf.outputColor.g, conf.outputColor.b,
-                            conf.outputColor.a);
-                glUniform4f(mt_renderShaderLocs.borderColor, conf.borderColor.r, conf.borderColor.g, conf.borderColor.b,
-                            conf.borderColor.a);
-                glUniform2f(mt_renderShaderLocs.screenPixel, 1.0f / inst->final_w_back, 1.0f / inst->final_h_back);
-            }
+    glBindFramebuffer(GL_FRAMEBUFFER, mt_batchTarget.fbo);
+    if (oglViewport)
+        oglViewport(0, 0, atlasW, atlasH);
+    else
+        glViewport(0, 0, atlasW, atlasH);
+    glDisable(GL_DEPTH_TEST);
+    glDisable(GL_STENCIL_TEST);
+    glDisable(GL_SCISSOR_TEST);
+    glColorMask(GL_TRUE, GL_TRUE, GL_TRUE, GL_TRUE);
+    glClearColor(0.0f, 0.0f, 0.0f, 0.0f);
+    glClear(GL_COLOR_BUFFER_BIT);
 
-            static const float fullscreenVerts[] = { -1, -1, 0, 0, 1, -1, 1, 0, 1, 1, 1, 1, -1, -1, 0, 0, 1, 1, 1, 1, -1, 1, 0, 1 };
-            glBufferSubData(GL_ARRAY_BUFFER, 0, sizeof(fullscreenVerts), fullscreenVerts);
-            glDrawArrays(GL_TRIANGLES, 0, 6);
+    glActiveTexture(GL_TEXTURE1);
+    glBindTexture(GL_TEXTURE_2D_ARRAY, mt_colorLuts.texture);
+    glActiveTexture(GL_TEXTURE0);
+    glBindTexture(GL_TEXTURE_2D, validCopyTexture);
+    glUseProgram(mt_batchFilterProgram);
+    glUniform2f(mt_batchFilterShaderLocs.atlasSize, static_cast<float>(atlasW), static_cast<float>(atlasH));
+    glBindVertexArray(captureVAO);
+    glBindBuffer(GL_ARRAY_BUFFER, captureVBO);
+    glBindBufferBase(GL_UNIFORM_BUFFER, 0, mt_batchTarget.ubo);
+
+    auto drawInstances = [](const std::vector<MirrorFilterInstanceStd140>& instances) {
+        for (size_t first = 0; first < instances.size(); first += MIRROR_BATCH_MAX_INSTANCES) {
+            const size_t count = (std::min)(instances.size() - first, static_cast<size_t>(MIRROR_BATCH_MAX_INSTANCES));
+            // Orphan so the driver doesn't stall on the previous chunk's draw
+            glBufferData(GL_UNIFORM_BUFFER, sizeof(MirrorFilterInstanceStd140) * MIRROR_BATCH_MAX_INSTANCES, nullptr, GL_STREAM_DRAW);
+            glBufferSubData(GL_UNIFORM_BUFFER, 0, sizeof(MirrorFilterInstanceStd140) * count, instances.data() + first);
+            glDrawArraysInstanced(GL_TRIANGLES, 0, 6, static_cast<GLsizei>(count));
         }
+    };
 
-        // NOTE: Static border is rendered in render_thread.cpp after mirror compositing
-        // to allow the border to extend beyond the mirror bounds
+    // Raw output: straight copy, later regions overwrite earlier ones
+    if (!mt_batchRawInstances.empty()) {
+        glDisable(GL_BLEND);
+        drawInstances(mt_batchRawInstances);
+    }
+    // Non-raw: additive blending for multiple input regions
+    if (!mt_batchFilterInstances.empty()) {
+        glEnable(GL_BLEND);
+        glBlendFunc(GL_ONE, GL_ONE);
+        drawInstances(mt_batchFilterInstances);
+        glDisable(GL_BLEND);
     }
+    glBindBufferBase(GL_UNIFORM_BUFFER, 0, 0);
 
+    // === Content Detection: one readback covering every filter mirror ===
+    if (!mt_batchFilterInstances.empty()) {
+        mt_batchPixels.resize(static_cast<size_t>(atlasW) * atlasH * 4);
+        glPixelStorei(GL_PACK_ALIGNMENT, 4);
+        glReadPixels(0, 0, atlasW, atlasH, GL_RGBA, GL_UNSIGNED_BYTE, mt_batchPixels.data());
+    }
+
+    for (size_t i = 0; i < pending.size(); ++i) {
+        MirrorInstance* inst = pending[i].inst;
+        const MirrorAtlasRect& rect = rects[i];
+
+        bool hasContent = pending[i].rawOutput; // Raw output always has content
+        for (int y = rect.y; !hasContent && y < rect.y + rect.h; ++y) {
+            const unsigned char* row = mt_batchPixels.data() + (static_cast<size_t>(y) * atlasW + rect.x) * 4;
+            for (int x = 0; x < rect.w; ++x) {
+                if (row[x * 4 + 3] > 0) {
+                    hasContent = true;
+                    break;
+                }
+            }
+        }
+        inst->hasFrameContentBack = hasContent;
+
+        // The render thread (and pass 2) read each mirror's own filter texture, so hand the rect back there
+        glBindFramebuffer(GL_READ_FRAMEBUFFER, mt_batchTarget.fbo);
+        glBindFramebuffer(GL_DRAW_FRAMEBUFFER, pending[i].backFbo);
+        glBlitFramebuffer(rect.x, rect.y, rect.x + rect.w, rect.y + rect.h, 0, 0, rect.w, rect.h, GL_COLOR_BUFFER_BIT, GL_NEAREST);
+
+        glActiveTexture(GL_TEXTURE0);
+        glBindVertexArray(captureVAO);
+        glBindBuffer(GL_ARRAY_BUFFER, captureVBO);
+        MT_ApplyMirrorFinalPass(inst, *pending[i].conf, pending[i].rawOutput, pending[i].conf->colorPassthrough, pending[i].finalBackFbo);
+    }
+
+    glUseProgram(0);
     return true;
 }
 
-// Mirror-thread local FBOs.
-// IMPORTANT: Framebuffer objects are not reliably shared between WGL contexts across all drivers.
-// We therefore create FBO objects on the mirror capture context and only attach the shared textures.
-struct MT_MirrorFbos {
-    GLuint backFbo = 0;       // attaches inst->fboTextureBack
-    GLuint finalBackFbo = 0;  // attaches inst->finalTextureBack
-    GLuint lastBackTex = 0;
-    GLuint lastFinalBackTex = 0;
+// GPU time of the mirror render phase via GL_TIME_ELAPSED queries. Results are collected a few captures later so the
+// thread never waits on them; averages are published to the profiler once per second.
+struct MT_GpuTimer {
+    static constexpr int kQueries = 4;
+    GLuint queries[kQueries] = {};
+    bool pending[kQueries] = {};
+    int next = 0;
+    bool active = false;
+    double windowMs = 0.0;
+    int windowSamples = 0;
 };
+static MT_GpuTimer mt_gpuTimer;
+
+static void MT_GpuTimerBegin() {
+    MT_GpuTimer& t = mt_gpuTimer;
+    if (t.queries[0] == 0) { glGenQueries(MT_GpuTimer::kQueries, t.queries); }
+    if (t.pending[t.next]) return; // Every slot still in flight - skip timing this capture
+    glBeginQuery(GL_TIME_ELAPSED, t.queries[t.next]);
+    t.active = true;
+}
+
+static void MT_GpuTimerEnd() {
+    MT_GpuTimer& t = mt_gpuTimer;
+    if (!t.active) return;
+    glEndQuery(GL_TIME_ELAPSED);
+    t.pending[t.next] = true;
+    t.next = (t.next + 1) % MT_GpuTimer::kQueries;
+    t.active = false;
+}
+
+static void MT_GpuTimerCollect() {
+    MT_GpuTimer& t = mt_gpuTimer;
+    for (int i = 0; i < MT_GpuTimer::kQueries; ++i) {
+        if (!t.pending[i]) continue;
+        GLint available = 0;
+        glGetQueryObjectiv(t.queries[i], GL_QUERY_RESULT_AVAILABLE, &available);
+        if (!available) continue;
+        GLuint64 ns = 0;
+        glGetQueryObjectui64v(t.queries[i], GL_QUERY_RESULT, &ns);
+        t.pending[i] = false;
+        t.windowMs += static_cast<double>(ns) / 1.0e6;
+        t.windowSamples++;
+    }
+}
+
+static void MT_GpuTimerPublish() {
+    MT_GpuTimer& t = mt_gpuTimer;
+    if (t.windowSamples == 0) return;
+    Profiler::GetInstance().SetCounter("Mirror GPU Time (ms)", t.windowMs / t.windowSamples);
+    t.windowMs = 0.0;
+    t.windowSamples = 0;
+}
+
+static void MT_CleanupGpuTimer() {
+    if (mt_gpuTimer.queries[0]) { glDeleteQueries(MT_GpuTimer::kQueries, mt_gpuTimer.queries); }
+    mt_gpuTimer = MT_GpuTimer();
+}
 
 static void MirrorCaptureThreadFunc(void* unused) {
     _set_se_translator(SEHTranslator);
 
     try {
         Log("Mirror Capture Thread: Starting thread loop...");
+        Profiler::GetInstance().SetThreadName("Mirror Thread");
 
         // Context should already be created and shared by StartMirrorCaptureThread on main thread
         if (!g_mirrorCaptureDC || !g_mirrorCaptureContext) {
@@ -1274,11 +2162,15 @@ static void MirrorCaptureThreadFunc(void* unused) {
         // Per-mirror FBOs created on THIS context.
         std::unordered_map<std::string, MT_MirrorFbos> mt_fbos;
 
+        // Per-mirror unchanged-frame detection state, plus once-per-second skip-ratio publishing
+        std::unordered_map<std::string, MT_ChangeDetectState> mt_changeStates;
+        auto lastChangeStatsPublish = std::chrono::steady_clock::now();
+        auto lastGpuTimePublish = lastChangeStatsPublish;
+
         // Debug: sample pixels from the shared copy texture (only when Texture Ops logging is enabled)
         GLuint debugSampleFbo = 0;
         auto debugSamplePixel = [&](const ThreadedMirrorConfig& conf, GLuint srcTex, int gameW, int gameH) {
-            auto snap = GetConfigSnapshot();
-            if (!snap || !snap->debug.logTextureOps) return;
+            if (!IsLogCategoryEnabled(LogCategoryId::TextureOps)) return;
             if (srcTex == 0 || gameW <= 0 || gameH <= 0) return;
             if (conf.input.empty()) return;
 
@@ -1306,7 +2198,7 @@ static void MirrorCaptureThreadFunc(void* unused) {
             glFramebufferTexture2D(GL_READ_FRAMEBUFFER, GL_COLOR_ATTACHMENT0, GL_TEXTURE_2D, srcTex, 0);
             GLenum st = glCheckFramebufferStatus(GL_READ_FRAMEBUFFER);
             if (st != GL_FRAMEBUFFER_COMPLETE) {
-                LogCategory("texture_ops",
+                LogCategory(LogCategoryId::TextureOps,
                             "MirrorDebugSample: READ FBO incomplete for mirror '" + conf.name + "' (status " + std::to_string(st) +
                                 ") tex=" + std::to_string(srcTex));
                 glBindFramebuffer(GL_READ_FRAMEBUFFER, prevReadFbo);
@@ -1326,7 +2218,7 @@ static void MirrorCaptureThreadFunc(void* unused) {
             }
 
             MirrorGammaMode gm = GetGlobalMirrorGammaMode();
-            LogCategory("texture_ops",
+            LogCategory(LogCategoryId::TextureOps,
                         "MirrorDebugSample: '" + conf.name + "' sample(" + std::to_string(sampleX) + "," + std::to_string(sampleY) +
                             ") rgba=" + std::to_string((int)px[0]) + "," + std::to_string((int)px[1]) + "," +
                             std::to_string((int)px[2]) + "," + std::to_string((int)px[3]) +
@@ -1387,10 +2279,9 @@ static void MirrorCaptureThreadFunc(void* unused) {
                             glGetTexLevelParameteriv(GL_TEXTURE_2D, 0, GL_TEXTURE_WIDTH, &tw);
                             glGetTexLevelParameteriv(GL_TEXTURE_2D, 0, GL_TEXTURE_HEIGHT, &th);
                             glBindTexture(GL_TEXTURE_2D, 0);
-                            LogCategory("texture_ops",
-                                        "Mirror Capture Thread: Using copy texture idx=" + std::to_string(readIndex) +
-                                            " id=" + std::to_string(validTexture) + " glIsTexture=" + std::to_string((int)isTex) +
-                                            " size=" + std::to_string(tw) + "x" + std::to_string(th));
+                            LogEvent(LogCategoryId::TextureOps,
+                                     "Mirror Capture Thread: Using copy texture idx={} id={} glIsTexture={} size={}x{}", readIndex,
+                                     validTexture, (int)isTex, tw, th);
                         }
 
                         // === CRITICAL: Publish ready frame for OBS ===
@@ -1428,8 +2319,9 @@ static void MirrorCaptureThreadFunc(void* unused) {
             // Global colorspace mode for matching (applies to all mirrors)
             MirrorGammaMode gammaMode = GetGlobalMirrorGammaMode();
 
-            // Process each mirror using the copied texture
+            // Collect the mirrors due this capture, then render them together
             bool didCapture = false;
+            std::vector<MT_PendingMirror> pending;
             for (auto& conf : configs) {
                 PROFILE_SCOPE_CAT("Process Mirror", "Mirror Thread");
                 // Check FPS throttling for this mirror
@@ -1442,6 +2334,8 @@ static void MirrorCaptureThreadFunc(void* unused) {
                 MirrorInstance* inst = nullptr;
                 GLuint localBackFbo = 0;
                 GLuint localFinalBackFbo = 0;
+                bool frontMatchesLastRender = false; // Front buffer + render cache still hold our last published render
+                bool forceRender = false;
                 {
                     std::unique_lock<std::shared_mutex> lock(g_mirrorInstancesMutex);
                     auto it = g_mirrorInstances.find(conf.name);
@@ -1536,6 +2430,9 @@ static void MirrorCaptureThreadFunc(void* unused) {
 
                     localBackFbo = fb.backFbo;
                     localFinalBackFbo = fb.finalBackFbo;
+
+                    frontMatchesLastRender = inst->hasValidContent && inst->cachedRenderState.isValid;
+                    forceRender = inst->forceUpdateFrames > 0; // Counted down by SwapMirrorBuffers as captures are consumed
                 }
 
                 // Validate instance
@@ -1548,11 +2445,61 @@ static void MirrorCaptureThreadFunc(void* unused) {
                 // Do NOT overwrite it here from conf.rawOutput - that causes race condition where
                 // stale config value overwrites the GUI's immediate update.
 
-                // Render the mirror
+                // Unchanged-frame detection: skip the filter pass and buffer swap if neither the input pixels (as of the
+                // latest finished hash readback) nor the render state changed since the front buffer was produced.
+                // The FPS clock still advances.
+                if (conf.skipUnchangedFrames) {
+                    MT_ChangeDetectState& change = mt_changeStates[conf.name];
+                    uint64_t seed = MT_MirrorRenderStateSeed(inst, conf, inst->desiredRawOutput.load(std::memory_order_acquire),
+                                                             gammaMode, gameW, gameH);
+                    MT_CollectMirrorInputHash(change);
+                    bool skip = false;
+                    if (change.hasLatest) {
+                        change.windowChecks++;
+                        skip = !forceRender && frontMatchesLastRender && change.hasDigest && change.latestSeed == seed &&
+                               change.latestDigest == change.lastDigest;
+                    }
+
+                    // Keep one hash in flight; a render with none tied to it leaves the front's digest unknown
+                    if (!skip) { change.hasDigest = false; }
+                    if (!change.fence &&
+                        !MT_StartMirrorInputHash(conf, validTexture, gameW, gameH, captureVAO, captureVBO, seed, !skip, change)) {
+                        change.hasLatest = false;
+                    }
+
+                    if (skip) {
+                        change.windowSkips++;
+                        conf.lastCaptureTime = now;
+                        didCapture = true;
+                        continue;
+                    }
+                }
+
                 debugSamplePixel(conf, validTexture, gameW, gameH);
 
-                RenderMirrorToBackBuffer(inst, conf, validTexture, captureVAO, captureVBO, localBackFbo, localFinalBackFbo, gammaMode, gameW,
-                                         gameH);
+                MT_PendingMirror p;
+                p.inst = inst;
+                p.conf = &conf;
+                p.backFbo = localBackFbo;
+                p.finalBackFbo = localFinalBackFbo;
+                p.rawOutput = inst->desiredRawOutput.load(std::memory_order_acquire);
+                pending.push_back(p);
+            }
+
+            if (!pending.empty()) {
+                MT_ResolveColorLutLayers(pending, gammaMode);
+
+                // Render every due mirror. A single mirror gains nothing from the atlas (it would only add a copy).
+                MT_GpuTimerBegin();
+                bool batched = pending.size() > 1 &&
+                               MT_RenderMirrorBatch(pending, validTexture, captureVAO, captureVBO, gammaMode, gameW, gameH);
+                if (!batched) {
+                    for (const auto& p : pending) {
+                        RenderMirrorToBackBuffer(p.inst, *p.conf, validTexture, captureVAO, captureVBO, p.backFbo, p.finalBackFbo,
+                                                 gammaMode, gameW, gameH, p.colorLutLayer);
+                    }
+                }
+                MT_GpuTimerEnd();
 
                 // Pre-compute render cache for the render thread
                 // Read current screen geometry from atomics
@@ -1563,34 +2510,62 @@ static void MirrorCaptureThreadFunc(void* unused) {
                 int finalW = g_captureFinalW.load(std::memory_order_acquire);
                 int finalH = g_captureFinalH.load(std::memory_order_acquire);
 
-                if (screenW > 0 && screenH > 0) {
-                    ComputeMirrorRenderCache(inst, conf, gameW, gameH, screenW, screenH, finalX, finalY, finalW, finalH);
-                }
+                for (const auto& p : pending) {
+                    if (screenW > 0 && screenH > 0) {
+                        ComputeMirrorRenderCache(p.inst, *p.conf, gameW, gameH, screenW, screenH, finalX, finalY, finalW, finalH);
+                    }
 
-                // Record how this capture was made
-                inst->capturedAsRawOutputBack = inst->desiredRawOutput.load(std::memory_order_acquire);
+                    // Record how this capture was made
+                    p.inst->capturedAsRawOutputBack = p.rawOutput;
 
-                // Create GPU fence for cross-context synchronization
-                // This fence will be swapped along with the texture and waited on by the render thread
-                // before it reads from the texture. This ensures the GPU has finished rendering
-                // even across different OpenGL contexts (which glFinish doesn't guarantee).
-                if (inst->gpuFenceBack) { glDeleteSync(inst->gpuFenceBack); }
-                inst->gpuFenceBack = glFenceSync(GL_SYNC_GPU_COMMANDS_COMPLETE, 0);
+                    // Create GPU fence for cross-context synchronization
+                    // This fence will be swapped along with the texture and waited on by the render thread
+                    // before it reads from the texture. This ensures the GPU has finished rendering
+                    // even across different OpenGL contexts (which glFinish doesn't guarantee).
+                    if (p.inst->gpuFenceBack) { glDeleteSync(p.inst->gpuFenceBack); }
+                    p.inst->gpuFenceBack = glFenceSync(GL_SYNC_GPU_COMMANDS_COMPLETE, 0);
+                }
 
                 // CRITICAL: Use glFinish() to ensure all GPU work is complete before signaling
-                // that the buffer is ready. This is more aggressive than glFlush() but guarantees
-                // no race conditions with the render thread reading the texture.
+                // that the buffers are ready. This is more aggressive than glFlush() but guarantees
+                // no race conditions with the render thread reading the textures.
                 {
                     PROFILE_SCOPE_CAT("glFinish", "Mirror Thread");
                     glFinish();
                 }
 
-                // Signal that back buffer is ready
-                inst->captureReady.store(true, std::memory_order_release);
-                conf.lastCaptureTime = now;
+                // Signal that back buffers are ready
+                for (const auto& p : pending) {
+                    p.inst->captureReady.store(true, std::memory_order_release);
+                    p.conf->lastCaptureTime = now;
+                }
                 didCapture = true;
             }
 
+            MT_GpuTimerCollect();
+            if (now - lastGpuTimePublish >= std::chrono::seconds(1)) {
+                MT_GpuTimerPublish();
+                lastGpuTimePublish = now;
+            }
+
+            // Publish unchanged-frame skip ratios once per second
+            if (!mt_changeStates.empty() && now - lastChangeStatsPublish >= std::chrono::seconds(1)) {
+                uint64_t totalChecks = 0, totalSkips = 0;
+                for (auto& [name, change] : mt_changeStates) {
+                    if (change.windowChecks == 0) continue;
+                    totalChecks += change.windowChecks;
+                    totalSkips += change.windowSkips;
+                    Profiler::GetInstance().SetCounter("Mirror Skip % (" + name + ")",
+                                                       100.0 * static_cast<double>(change.windowSkips) / change.windowChecks);
+                    change.windowChecks = 0;
+                    change.windowSkips = 0;
+                }
+                if (totalChecks > 0) {
+                    Profiler::GetInstance().SetCounter("Mirror Skip % (all)", 100.0 * static_cast<double>(totalSkips) / totalChecks);
+                }
+                lastChangeStatsPublish = now;
+            }
+
             // Update only lastCaptureTime in global configs, NOT the full config
             // This preserves FPS and other settings that may have been updated by GUI during capture
             if (didCapture) {
@@ -1635,6 +2610,12 @@ static void MirrorCaptureThreadFunc(void* unused) {
             if (kv.second.finalBackFbo) { glDeleteFramebuffers(1, &kv.second.finalBackFbo); }
         }
         mt_fbos.clear();
+        for (auto& [name, change] : mt_changeStates) { MT_CleanupChangeDetectState(change); }
+        mt_changeStates.clear();
+        MT_CleanupChangeHashTarget();
+        MT_CleanupBatchTarget();
+        MT_CleanupGpuTimer();
+        MT_CleanupColorLuts();
 
         // Cleanup shared capture textures (requires GL context current)
         CleanupCaptureTexture();
@@ -1750,7 +2731,7 @@ void StartMirrorCaptureThread(void* gameGLContext) {
     g_mirrorCaptureShouldStop.store(false);
     g_mirrorCaptureRunning.store(true); // Mark as running BEFORE starting thread
     g_mirrorCaptureThread = std::thread(MirrorCaptureThreadFunc, gameGLContext);
-    LogCategory("init", "Mirror Capture Thread: Started");
+    LogCategory(LogCategoryId::Init, "Mirror Capture Thread: Started");
 }
 
 // Stop the mirror capture thread
@@ -1789,6 +2770,7 @@ void SwapMirrorBuffers() {
             std::swap(inst.gpuFence, inst.gpuFenceBack);               // Swap fence with texture
 
             inst.hasValidContent = true; // Front now has renderable content
+            if (inst.forceUpdateFrames > 0) { inst.forceUpdateFrames--; }
 
             // Clear captureReady so capture thread can write to back again
             inst.captureReady.store(false, std::memory_order_release);
@@ -1828,6 +2810,7 @@ void UpdateMirrorCaptureConfigs(const std::vector<MirrorConfig>& activeMirrors)
         conf.outputColor = m.colors.output;
         conf.borderColor = m.colors.border;
         conf.colorSensitivity = m.colorSensitivity;
+        conf.skipUnchangedFrames = m.skipUnchangedFrames;
         conf.input = m.input;
         // Output positioning config for render cache computation
         conf.outputScale = m.output.scale;
@@ -1876,6 +2859,16 @@ void UpdateMirrorFPS(const std::string& mirrorName, int fps) {
     }
 }
 
+void UpdateMirrorSkipUnchanged(const std::string& mirrorName, bool skipUnchangedFrames) {
+    std::lock_guard<std::mutex> lock(g_threadedMirrorConfigMutex);
+    for (auto& conf : g_threadedMirrorConfigs) {
+        if (conf.name == mirrorName) {
+            conf.skipUnchangedFrames = skipUnchangedFrames;
+            break;
+        }
+    }
+}
+
 void UpdateMirrorOutputPosition(const std::string& mirrorName, int x, int y, float scale, bool separateScale, float scaleX, float scaleY,
                                 const std::string& relativeTo) {
     // Update the threaded config
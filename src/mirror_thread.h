@@ -52,6 +52,7 @@ struct ThreadedMirrorConfig {
     Color outputColor;
     Color borderColor; // Border color for dynamic render shader
     float colorSensitivity = 0.0f;
+    bool skipUnchangedFrames = false;       // Skip re-rendering when the input region and render state are unchanged
     std::vector<MirrorCaptureConfig> input; // Uses MirrorCaptureConfig from gui.h
     std::chrono::steady_clock::time_point lastCaptureTime;
 
@@ -143,6 +144,9 @@ void UpdateMirrorCaptureConfigs(const std::vector<MirrorConfig>& activeMirrors);
 // Update FPS for a specific mirror (call from GUI when FPS spinner changes)
 void UpdateMirrorFPS(const std::string& mirrorName, int fps);
 
+// Enable/disable unchanged-frame skipping for a specific mirror (call from GUI when the toggle changes)
+void UpdateMirrorSkipUnchanged(const std::string& mirrorName, bool skipUnchangedFrames);
+
 // Update output position for a specific mirror (call from GUI when position changes)
 void UpdateMirrorOutputPosition(const std::string& mirrorName, int x, int y, float scale, bool separateScale, float scaleX, float scaleY,
                                 const std::string& relativeTo);
@@ -0,0 +1,353 @@
+#include "notes_index.h"
+#include "notes_search.h"
+#include "profiler.h"
+#include "utils.h"
+
+#include <algorithm>
+#include <cctype>
+#include <condition_variable>
+#include <fstream>
+#include <map>
+#include <mutex>
+#include <sstream>
+#include <thread>
+#include <unordered_map>
+#include <unordered_set>
+
+// Coalesce the burst of notifications a single save produces (temp file, rename, attribute updates)
+static constexpr auto INDEX_WATCH_DEBOUNCE = std::chrono::milliseconds(200);
+// Rescan interval without a watcher (non-Windows, or the watch could not be armed)
+static constexpr auto INDEX_POLL_INTERVAL = std::chrono::milliseconds(2000);
+// Safety-net rescan with a watcher; network shares and some sync tools drop change notifications
+static constexpr auto INDEX_WATCH_FALLBACK_INTERVAL = std::chrono::milliseconds(30000);
+// Larger files are cataloged and searchable by title only
+static constexpr uint64_t INDEX_MAX_BODY_BYTES = 4ull * 1024ull * 1024ull;
+
+static std::thread s_indexThread;
+static std::mutex s_indexMutex;
+static std::condition_variable s_indexCv;
+
+// Protected by s_indexMutex
+static bool s_indexRunning = false;
+static bool s_indexStopRequested = false;
+static bool s_indexRescanRequested = false;
+static std::filesystem::path s_indexRoot;
+static uint64_t s_indexRootVersion = 0;
+static void (*s_indexPrepareRoot)() = nullptr;
+static std::shared_ptr<const NotesCatalog> s_indexCatalog;
+
+#if defined(_WIN32)
+static HANDLE s_indexWakeEvent = nullptr; // Auto-reset; signaled alongside s_indexCv so the watcher wait wakes up too
+#endif
+
+// Protected by s_searchMutex (never held together with s_indexMutex)
+struct IndexedNote {
+    std::filesystem::path path;
+    std::string folder;
+    std::string title;
+};
+static std::mutex s_searchMutex;
+static NotesSearchIndex s_searchIndex;
+static std::map<std::string, IndexedNote, std::less<>> s_indexedNotes;
+
+// Worker-only: what each cataloged file looked like when it was last indexed
+struct IndexedFileStamp {
+    int64_t writeTime = 0;
+    uint64_t size = 0;
+};
+static std::unordered_map<std::string, IndexedFileStamp> s_indexedStamps;
+
+static std::string PathToUtf8(const std::filesystem::path& path) {
+    const std::u8string text = path.u8string();
+    return std::string(text.begin(), text.end());
+}
+
+static std::string GenericPathToUtf8(const std::filesystem::path& path) {
+    const std::u8string text = path.generic_u8string();
+    return std::string(text.begin(), text.end());
+}
+
+static int64_t FileTimeToEpochSeconds(const std::filesystem::file_time_type& fileTime) {
+    using namespace std::chrono;
+    const auto sysTp = time_point_cast<system_clock::duration>(fileTime - std::filesystem::file_time_type::clock::now() + system_clock::now());
+    return duration_cast<seconds>(sysTp.time_since_epoch()).count();
+}
+
+static bool ReadNoteFile(const std::filesystem::path& path, std::string& out) {
+    out.clear();
+    std::ifstream in(path, std::ios::binary);
+    if (!in.is_open()) return false;
+    std::ostringstream ss;
+    ss << in.rdbuf();
+    out = ss.str();
+    return true;
+}
+
+bool IsNotesCatalogFile(const std::filesystem::path& path) {
+    std::string filenameLower = PathToUtf8(path.filename());
+    std::transform(filenameLower.begin(), filenameLower.end(), filenameLower.begin(),
+                   [](unsigned char c) { return static_cast<char>(std::tolower(c)); });
+    if (filenameLower.empty()) return false;
+    if (filenameLower[0] == '.') return false;
+    if (filenameLower.rfind(".toolscreen_", 0) == 0) return false;
+
+    const size_t dot = filenameLower.find_last_of('.');
+    if (dot == std::string::npos) return true;
+    const std::string ext = filenameLower.substr(dot);
+    return ext == ".md" || ext == ".txt" || ext == ".log";
+}
+
+static void WakeNotesIndexWorker() {
+    s_indexCv.notify_all();
+#if defined(_WIN32)
+    if (s_indexWakeEvent) { SetEvent(s_indexWakeEvent); }
+#endif
+}
+
+static void ResetSearchIndex() {
+    s_indexedStamps.clear();
+    std::lock_guard<std::mutex> lock(s_searchMutex);
+    s_searchIndex.Clear();
+    s_indexedNotes.clear();
+}
+
+// Walk root, re-index new or changed files, drop vanished ones. Returns the new catalog, or nullptr when nothing
+// visible changed since `previous`.
+static std::shared_ptr<NotesCatalog> ScanNotesRoot(const std::filesystem::path& root, const NotesCatalog* previous) {
+    PROFILE_SCOPE_CAT("Notes Index Scan", "IO Operations");
+
+    auto catalog = std::make_shared<NotesCatalog>();
+    catalog->root = root;
+    bool changed = (previous == nullptr);
+
+    std::error_code ec;
+    std::filesystem::create_directories(root, ec);
+
+    std::unordered_set<std::string> seen;
+    std::string body;
+    ec.clear();
+    std::filesystem::recursive_directory_iterator it(root, std::filesystem::directory_options::skip_permission_denied, ec);
+    for (; !ec && it != std::filesystem::recursive_directory_iterator(); it.increment(ec)) {
+        const std::filesystem::directory_entry& entry = *it;
+        std::error_code entryEc;
+        if (entry.is_directory(entryEc)) {
+            if (it.depth() == 0) { catalog->folders.push_back(PathToUtf8(entry.path().filename())); }
+            continue;
+        }
+        if (!entry.is_regular_file(entryEc) || !IsNotesCatalogFile(entry.path())) continue;
+
+        NotesCatalogEntry item;
+        item.path = entry.path();
+        item.title = PathToUtf8(item.path.stem());
+        const std::filesystem::path relativeFolder = item.path.parent_path().lexically_relative(root);
+        if (!relativeFolder.empty() && relativeFolder != ".") { item.folder = GenericPathToUtf8(relativeFolder); }
+        const std::filesystem::file_time_type writeTime = entry.last_write_time(entryEc);
+        const int64_t writeTimeRaw = entryEc ? 0 : static_cast<int64_t>(writeTime.time_since_epoch().count());
+        item.modifiedEpochSeconds = entryEc ? 0 : FileTimeToEpochSeconds(writeTime);
+        entryEc.clear();
+        item.sizeBytes = entry.file_size(entryEc);
+        if (entryEc) item.sizeBytes = 0;
+
+        std::string key = PathToUtf8(item.path);
+        auto stamp = s_indexedStamps.find(key);
+        if (stamp == s_indexedStamps.end() || stamp->second.writeTime != writeTimeRaw || stamp->second.size != item.sizeBytes) {
+            // Read outside the search lock; tokenizing one note under it takes microseconds
+            body.clear();
+            if (item.sizeBytes <= INDEX_MAX_BODY_BYTES) { ReadNoteFile(item.path, body); }
+            {
+                std::lock_guard<std::mutex> lock(s_searchMutex);
+                s_searchIndex.Upsert(key, item.title, body);
+                s_indexedNotes[key] = IndexedNote{ item.path, item.folder, item.title };
+            }
+            s_indexedStamps[key] = IndexedFileStamp{ writeTimeRaw, item.sizeBytes };
+            changed = true;
+        }
+        seen.insert(std::move(key));
+        catalog->entries.push_back(std::move(item));
+    }
+
+    for (auto stamp = s_indexedStamps.begin(); stamp != s_indexedStamps.end();) {
+        if (seen.count(stamp->first)) {
+            ++stamp;
+            continue;
+        }
+        {
+            std::lock_guard<std::mutex> lock(s_searchMutex);
+            s_searchIndex.Remove(stamp->first);
+            s_indexedNotes.erase(stamp->first);
+        }
+        stamp = s_indexedStamps.erase(stamp);
+        changed = true;
+    }
+
+    ReadNoteFile(root / L".toolscreen_pins.txt", catalog->pinnedMetadataText);
+    ReadNoteFile(root / L".toolscreen_favorites.txt", catalog->favoriteMetadataText);
+
+    if (previous) {
+        changed = changed || catalog->entries.size() != previous->entries.size() || catalog->folders != previous->folders ||
+                  catalog->pinnedMetadataText != previous->pinnedMetadataText ||
+                  catalog->favoriteMetadataText != previous->favoriteMetadataText;
+    }
+    if (!changed) return nullptr;
+    catalog->generation = previous ? previous->generation + 1 : 1;
+    return catalog;
+}
+
+static void NotesIndexThreadFunc() {
+#if defined(_WIN32)
+    _set_se_translator(SEHTranslator);
+    // Lowers both CPU and I/O priority so indexing never competes with the game
+    SetThreadPriority(GetCurrentThread(), THREAD_MODE_BACKGROUND_BEGIN);
+    HANDLE watch = INVALID_HANDLE_VALUE;
+#endif
+
+    std::filesystem::path root;
+    uint64_t rootVersion = 0;
+    void (*prepareRoot)() = nullptr;
+    std::shared_ptr<const NotesCatalog> catalog;
+
+    while (true) {
+        bool rootChanged = false;
+        {
+            std::lock_guard<std::mutex> lock(s_indexMutex);
+            if (s_indexStopRequested) break;
+            s_indexRescanRequested = false;
+            if (s_indexRootVersion != rootVersion) {
+                root = s_indexRoot;
+                rootVersion = s_indexRootVersion;
+                prepareRoot = s_indexPrepareRoot;
+                s_indexCatalog.reset();
+                rootChanged = true;
+            }
+        }
+        if (rootChanged) {
+            catalog.reset();
+            ResetSearchIndex();
+#if defined(_WIN32)
+            if (watch != INVALID_HANDLE_VALUE) {
+                FindCloseChangeNotification(watch);
+                watch = INVALID_HANDLE_VALUE;
+            }
+#endif
+        }
+
+        try {
+            if (rootChanged && prepareRoot) { prepareRoot(); }
+            std::shared_ptr<NotesCatalog> scanned = ScanNotesRoot(root, catalog.get());
+            if (scanned) {
+                catalog = scanned;
+                std::lock_guard<std::mutex> lock(s_indexMutex);
+                if (s_indexRootVersion == rootVersion) { s_indexCatalog = catalog; }
+            }
+#if defined(_WIN32)
+        } catch (const SE_Exception& e) {
+            LogException("NotesIndexThread (SEH)", e.getCode(), e.getInfo());
+#endif
+        } catch (const std::exception& e) { LogException("NotesIndexThread", e); }
+
+#if defined(_WIN32)
+        if (watch == INVALID_HANDLE_VALUE) {
+            watch = FindFirstChangeNotificationW(root.c_str(), TRUE,
+                                                 FILE_NOTIFY_CHANGE_FILE_NAME | FILE_NOTIFY_CHANGE_DIR_NAME | FILE_NOTIFY_CHANGE_SIZE |
+                                                     FILE_NOTIFY_CHANGE_LAST_WRITE);
+            if (watch == INVALID_HANDLE_VALUE) { Log("Notes index: could not watch " + PathToUtf8(root) + ", polling instead"); }
+        }
+
+        const HANDLE handles[2] = { s_indexWakeEvent, watch };
+        const DWORD handleCount = (watch != INVALID_HANDLE_VALUE) ? 2 : 1;
+        const auto timeout = (watch != INVALID_HANDLE_VALUE) ? INDEX_WATCH_FALLBACK_INTERVAL : INDEX_POLL_INTERVAL;
+        const DWORD result = WaitForMultipleObjects(handleCount, handles, FALSE, static_cast<DWORD>(timeout.count()));
+        if (result == WAIT_OBJECT_0 + 1) {
+            if (!FindNextChangeNotification(watch)) {
+                FindCloseChangeNotification(watch);
+                watch = INVALID_HANDLE_VALUE;
+            }
+            // Stop / root changes still cut the debounce short
+            WaitForSingleObject(s_indexWakeEvent, static_cast<DWORD>(INDEX_WATCH_DEBOUNCE.count()));
+        }
+#else
+        std::unique_lock<std::mutex> lock(s_indexMutex);
+        s_indexCv.wait_for(lock, INDEX_POLL_INTERVAL, [rootVersion] {
+            return s_indexStopRequested || s_indexRescanRequested || s_indexRootVersion != rootVersion;
+        });
+#endif
+    }
+
+#if defined(_WIN32)
+    if (watch != INVALID_HANDLE_VALUE) { FindCloseChangeNotification(watch); }
+    SetThreadPriority(GetCurrentThread(), THREAD_MODE_BACKGROUND_END);
+#endif
+}
+
+void SetNotesIndexRoot(const std::filesystem::path& root, void (*prepareRoot)()) {
+    {
+        std::lock_guard<std::mutex> lock(s_indexMutex);
+        if (s_indexRunning && s_indexRoot == root) return;
+        if (s_indexRoot != root || !s_indexRunning) {
+            s_indexRoot = root;
+            s_indexPrepareRoot = prepareRoot;
+            ++s_indexRootVersion;
+            s_indexCatalog.reset();
+        }
+        if (!s_indexRunning) {
+#if defined(_WIN32)
+            if (!s_indexWakeEvent) { s_indexWakeEvent = CreateEventW(nullptr, FALSE, FALSE, nullptr); }
+#endif
+            s_indexStopRequested = false;
+            s_indexRunning = true;
+            s_indexThread = std::thread(NotesIndexThreadFunc);
+            Log("Started notes index thread");
+            return;
+        }
+    }
+    WakeNotesIndexWorker();
+}
+
+void RequestNotesIndexRescan() {
+    {
+        std::lock_guard<std::mutex> lock(s_indexMutex);
+        if (!s_indexRunning) return;
+        s_indexRescanRequested = true;
+    }
+    WakeNotesIndexWorker();
+}
+
+void StopNotesIndexThread() {
+    {
+        std::lock_guard<std::mutex> lock(s_indexMutex);
+        if (!s_indexRunning) return;
+        s_indexStopRequested = true;
+    }
+    WakeNotesIndexWorker();
+    if (s_indexThread.joinable()) { s_indexThread.join(); }
+
+    std::lock_guard<std::mutex> lock(s_indexMutex);
+    s_indexRunning = false;
+    s_indexCatalog.reset();
+#if defined(_WIN32)
+    if (s_indexWakeEvent) {
+        CloseHandle(s_indexWakeEvent);
+        s_indexWakeEvent = nullptr;
+    }
+#endif
+}
+
+std::shared_ptr<const NotesCatalog> GetNotesCatalogSnapshot() {
+    std::lock_guard<std::mutex> lock(s_indexMutex);
+    return s_indexCatalog;
+}
+
+std::vector<NotesSearchResult> SearchNotes(const std::string& query, size_t maxResults) {
+    PROFILE_SCOPE_CAT("Notes Search", "GUI");
+
+    std::vector<NotesSearchResult> results;
+    std::lock_guard<std::mutex> lock(s_searchMutex);
+    const std::vector<NotesSearchIndex::Hit> hits = s_searchIndex.Search(query, maxResults);
+    results.reserve(hits.size());
+    for (const NotesSearchIndex::Hit& hit : hits) {
+        auto it = s_indexedNotes.find(hit.key);
+        if (it == s_indexedNotes.end()) continue;
+        results.push_back(NotesSearchResult{ it->second.path, it->second.folder, it->second.title, hit.score });
+    }
+    return results;
+}
@@ -0,0 +1,54 @@
+#pragma once
+
+#include <cstdint>
+#include <filesystem>
+#include <memory>
+#include <string>
+#include <vector>
+
+// Background notes index service.
+// A low-priority worker keeps an in-memory catalog of every note under the notes root, plus a full-text index over
+// note titles and bodies (see NotesSearchIndex). Directory changes come from a file-change watcher on Windows
+// (FindFirstChangeNotification) and from periodic polling elsewhere; each rescan only re-reads files whose size or
+// write time changed. The overlay reads published catalog snapshots and searches the index without touching disk.
+
+struct NotesCatalogEntry {
+    std::filesystem::path path;
+    std::string folder; // UTF-8 parent folder relative to the root, '/'-separated ("" for the root itself)
+    std::string title;  // UTF-8 file stem
+    int64_t modifiedEpochSeconds = 0;
+    uint64_t sizeBytes = 0;
+};
+
+struct NotesCatalog {
+    uint64_t generation = 0; // Bumped whenever anything below changes
+    std::filesystem::path root;
+    std::vector<NotesCatalogEntry> entries; // Every note file under root, recursively
+    std::vector<std::string> folders;       // UTF-8 names of root's direct subdirectories
+    std::string pinnedMetadataText;         // Raw contents of the pin / favorite lists stored in root
+    std::string favoriteMetadataText;
+};
+
+struct NotesSearchResult {
+    std::filesystem::path path;
+    std::string folder;
+    std::string title;
+    float score = 0.0f;
+};
+
+// Note files the catalog includes: no hidden or .toolscreen_* files; .md, .txt, .log or no extension
+bool IsNotesCatalogFile(const std::filesystem::path& path);
+
+// Starts the worker on first use. Switching roots drops the old catalog and index. `prepareRoot` runs on the worker
+// before the first scan of a new root (e.g. to create default folders and seed notes off the render thread).
+void SetNotesIndexRoot(const std::filesystem::path& root, void (*prepareRoot)() = nullptr);
+// Rescan as soon as possible (after the overlay wrote, renamed or deleted a file)
+void RequestNotesIndexRescan();
+void StopNotesIndexThread();
+
+// Latest published catalog (nullptr until the first scan of the current root completes)
+std::shared_ptr<const NotesCatalog> GetNotesCatalogSnapshot();
+
+// Ranked full-text search over the indexed notes. Every query word must match; the last one also matches as a prefix
+// while it is still being typed.
+std::vector<NotesSearchResult> SearchNotes(const std::string& query, size_t maxResults);
@@ -0,0 +1,442 @@
+#include "notes_markdown.h"
+
+#include <algorithm>
+#include <cctype>
+#include <cstring>
+#include <unordered_set>
+
+namespace {
+
+std::string TrimAscii(const std::string& text) {
+    size_t first = 0;
+    while (first < text.size() && std::isspace(static_cast<unsigned char>(text[first]))) {
+        ++first;
+    }
+    size_t last = text.size();
+    while (last > first && std::isspace(static_cast<unsigned char>(text[last - 1]))) {
+        --last;
+    }
+    return text.substr(first, last - first);
+}
+
+std::string TrimLeftAscii(const std::string& text) {
+    size_t first = 0;
+    while (first < text.size() && std::isspace(static_cast<unsigned char>(text[first]))) {
+        ++first;
+    }
+    return text.substr(first);
+}
+
+bool IsMarkdownHorizontalRule(const std::string& line) {
+    return line == "---" || line == "***" || line == "___";
+}
+
+bool IsMarkdownNumberedListLine(const std::string& trimmedLine, std::string& outPrefix, std::string& outValue) {
+    size_t i = 0;
+    while (i < trimmedLine.size() && std::isdigit(static_cast<unsigned char>(trimmedLine[i]))) {
+        ++i;
+    }
+    if (i == 0 || i + 1 >= trimmedLine.size()) return false;
+    const char sep = trimmedLine[i];
+    if (sep != '.' && sep != ')') return false;
+    if (trimmedLine[i + 1] != ' ') return false;
+    outPrefix = trimmedLine.substr(0, i) + ". ";
+    outValue = trimmedLine.substr(i + 2);
+    return true;
+}
+
+bool IsMarkdownTaskMarker(const std::string& text, bool& outChecked, std::string& outBody) {
+    if (text.size() < 4 || text[0] != '[') return false;
+    const char mark = static_cast<char>(std::tolower(static_cast<unsigned char>(text[1])));
+    if (text[2] != ']' || text[3] != ' ') return false;
+    if (mark != 'x' && mark != ' ') return false;
+    outChecked = (mark == 'x');
+    outBody = text.substr(4);
+    return true;
+}
+
+bool RangesOverlap(size_t startA, size_t endA, size_t startB, size_t endB) {
+    return (startA < endB) && (startB < endA);
+}
+
+size_t FindUrlEnd(const std::string& text, size_t start) {
+    size_t end = start;
+    while (end < text.size()) {
+        const unsigned char c = static_cast<unsigned char>(text[end]);
+        if (std::isspace(c) || c == '<' || c == '>' || c == '"' || c == '\'' || c == '`') break;
+        ++end;
+    }
+    while (end > start) {
+        const char tail = text[end - 1];
+        if (tail == '.' || tail == ',' || tail == ';' || tail == ':' || tail == ')' || tail == ']') {
+            --end;
+            continue;
+        }
+        break;
+    }
+    return end;
+}
+
+// Parses one source line (without its '\n'). inCodeFence carries the ``` state from line to line.
+void ParseMarkdownLine(std::string_view source, bool& inCodeFence, size_t sourceLineIndex, MarkdownPreviewLine& line) {
+    line = MarkdownPreviewLine();
+    line.sourceLineIndex = sourceLineIndex;
+
+    auto setLine = [&](MarkdownLineKind kind, std::string text, int headingLevel, std::string listPrefix, bool checked) {
+        line.kind = kind;
+        line.text = std::move(text);
+        line.headingLevel = headingLevel;
+        line.listPrefix = std::move(listPrefix);
+        line.checked = checked;
+        if (kind != MarkdownLineKind::Code && line.text.find("http") != std::string::npos) {
+            line.links = ExtractMarkdownPreviewLinks(line.text);
+        }
+    };
+
+    std::string rawLine(source);
+    if (!rawLine.empty() && rawLine.back() == '\r') rawLine.pop_back();
+    const std::string trimmed = TrimAscii(rawLine);
+    const std::string leadingTrimmed = TrimLeftAscii(rawLine);
+    const size_t indentColumns = CountLeadingIndentColumns(rawLine);
+    const size_t listIndent = std::min<size_t>(32, (indentColumns / 2) * 2);
+
+    if (trimmed.rfind("```", 0) == 0) {
+        inCodeFence = !inCodeFence;
+        setLine(MarkdownLineKind::Rule, "", 0, "", false);
+        return;
+    }
+
+    if (inCodeFence) {
+        setLine(MarkdownLineKind::Code, rawLine, 0, "", false);
+        return;
+    }
+
+    if (trimmed.empty()) {
+        setLine(MarkdownLineKind::Blank, "", 0, "", false);
+        return;
+    }
+
+    if (IsMarkdownHorizontalRule(trimmed)) {
+        setLine(MarkdownLineKind::Rule, "", 0, "", false);
+        return;
+    }
+
+    size_t headingLevel = 0;
+    while (headingLevel < trimmed.size() && trimmed[headingLevel] == '#') {
+        ++headingLevel;
+    }
+    if (headingLevel > 0 && headingLevel <= 6 && headingLevel < trimmed.size() && trimmed[headingLevel] == ' ') {
+        setLine(MarkdownLineKind::Heading, trimmed.substr(headingLevel + 1), static_cast<int>(headingLevel), "", false);
+        return;
+    }
+
+    if (leadingTrimmed.rfind("> ", 0) == 0) {
+        setLine(MarkdownLineKind::Quote, leadingTrimmed.substr(2), 0, "", false);
+        return;
+    }
+
+    std::string listValue;
+    std::string listPrefix;
+    if (leadingTrimmed.rfind("- ", 0) == 0 || leadingTrimmed.rfind("* ", 0) == 0 || leadingTrimmed.rfind("+ ", 0) == 0) {
+        listValue = leadingTrimmed.substr(2);
+        listPrefix = std::string(listIndent, ' ') + GetRenderedBulletPrefix();
+    } else {
+        std::string numberedPrefix;
+        std::string numberedBody;
+        if (IsMarkdownNumberedListLine(leadingTrimmed, numberedPrefix, numberedBody)) {
+            const std::string prefix = std::string(listIndent, ' ') + numberedPrefix;
+            setLine(MarkdownLineKind::Numbered, numberedBody, 0, prefix, false);
+            return;
+        }
+    }
+    if (!listValue.empty()) {
+        bool taskChecked = false;
+        std::string taskBody;
+        if (IsMarkdownTaskMarker(listValue, taskChecked, taskBody)) {
+            const std::string taskPrefix = std::string(listIndent, ' ') + (taskChecked ? "[x] " : "[ ] ");
+            setLine(MarkdownLineKind::Task, taskBody, 0, taskPrefix, taskChecked);
+        } else {
+            setLine(MarkdownLineKind::Bullet, listValue, 0, listPrefix, false);
+        }
+        return;
+    }
+
+    setLine(MarkdownLineKind::Body, rawLine, 0, "", false);
+}
+
+// Byte-compare in blocks first so a one-character edit in a large note doesn't walk every byte
+constexpr size_t kCompareBlock = 64;
+
+size_t CommonPrefixLength(const char* a, const char* b, size_t maxLength) {
+    size_t n = 0;
+    while (n + kCompareBlock <= maxLength && std::memcmp(a + n, b + n, kCompareBlock) == 0) {
+        n += kCompareBlock;
+    }
+    while (n < maxLength && a[n] == b[n]) {
+        ++n;
+    }
+    return n;
+}
+
+// aEnd / bEnd point one past the last byte
+size_t CommonSuffixLength(const char* aEnd, const char* bEnd, size_t maxLength) {
+    size_t n = 0;
+    while (n + kCompareBlock <= maxLength && std::memcmp(aEnd - n - kCompareBlock, bEnd - n - kCompareBlock, kCompareBlock) == 0) {
+        n += kCompareBlock;
+    }
+    while (n < maxLength && aEnd[-1 - static_cast<ptrdiff_t>(n)] == bEnd[-1 - static_cast<ptrdiff_t>(n)]) {
+        ++n;
+    }
+    return n;
+}
+
+// Replaces items [first, last) with replacement, shifting the tail at most once
+template <typename T> void SpliceRange(std::vector<T>& items, size_t first, size_t last, std::vector<T>& replacement) {
+    const size_t removed = last - first;
+    const size_t inserted = replacement.size();
+    if (inserted > removed) {
+        items.insert(items.begin() + last, inserted - removed, T());
+    } else if (inserted < removed) {
+        items.erase(items.begin() + first + inserted, items.begin() + last);
+    }
+    std::move(replacement.begin(), replacement.end(), items.begin() + first);
+}
+
+// std::getline semantics: a trailing empty segment (text ending in '\n') is not a line, but empty text is one
+size_t VisibleLineCount(const std::vector<size_t>& lineStarts, size_t textSize) {
+    const size_t segments = lineStarts.size();
+    if (segments > 1 && lineStarts.back() == textSize) return segments - 1;
+    return segments;
+}
+
+} // namespace
+
+bool IsHttpUrl(const std::string& value) {
+    return value.rfind("https://", 0) == 0 || value.rfind("http://", 0) == 0;
+}
+
+size_t CountLeadingIndentColumns(const std::string& line) {
+    size_t columns = 0;
+    for (char c : line) {
+        if (c == ' ') {
+            ++columns;
+            continue;
+        }
+        if (c == '\t') {
+            columns += 4;
+            continue;
+        }
+        break;
+    }
+    return columns;
+}
+
+const char* GetRenderedBulletPrefix() { return "\xE2\x80\xA2 "; }
+
+std::vector<MarkdownPreviewLink> ExtractMarkdownPreviewLinks(const std::string& text) {
+    std::vector<MarkdownPreviewLink> links;
+    links.reserve(4);
+
+    // Markdown links: [label](url)
+    for (size_t i = 0; i < text.size();) {
+        if (text[i] != '[') {
+            ++i;
+            continue;
+        }
+        const size_t closeBracket = text.find(']', i + 1);
+        if (closeBracket == std::string::npos || closeBracket + 1 >= text.size() || text[closeBracket + 1] != '(') {
+            ++i;
+            continue;
+        }
+        const size_t closeParen = text.find(')', closeBracket + 2);
+        if (closeParen == std::string::npos) {
+            ++i;
+            continue;
+        }
+
+        const std::string label = TrimAscii(text.substr(i + 1, closeBracket - (i + 1)));
+        const std::string url = TrimAscii(text.substr(closeBracket + 2, closeParen - (closeBracket + 2)));
+        if (IsHttpUrl(url)) {
+            MarkdownPreviewLink link;
+            link.label = label;
+            link.url = url;
+            link.start = i;
+            link.end = closeParen + 1;
+            links.push_back(std::move(link));
+            i = closeParen + 1;
+            continue;
+        }
+        ++i;
+    }
+
+    // Plain URLs not already covered by markdown link ranges.
+    for (size_t pos = 0; pos < text.size();) {
+        const size_t httpPos = text.find("http://", pos);
+        const size_t httpsPos = text.find("https://", pos);
+        size_t start = std::string::npos;
+        if (httpPos == std::string::npos) {
+            start = httpsPos;
+        } else if (httpsPos == std::string::npos) {
+            start = httpPos;
+        } else {
+            start = std::min(httpPos, httpsPos);
+        }
+        if (start == std::string::npos) break;
+
+        const size_t end = FindUrlEnd(text, start);
+        if (end <= start) {
+            pos = start + 1;
+            continue;
+        }
+
+        bool overlaps = false;
+        for (const auto& existing : links) {
+            if (RangesOverlap(start, end, existing.start, existing.end)) {
+                overlaps = true;
+                break;
+            }
+        }
+        if (!overlaps) {
+            MarkdownPreviewLink link;
+            link.url = text.substr(start, end - start);
+            link.label = link.url;
+            link.start = start;
+            link.end = end;
+            if (IsHttpUrl(link.url)) { links.push_back(std::move(link)); }
+        }
+        pos = end;
+    }
+
+    std::sort(links.begin(), links.end(), [](const MarkdownPreviewLink& a, const MarkdownPreviewLink& b) {
+        if (a.start != b.start) return a.start < b.start;
+        return a.end < b.end;
+    });
+
+    std::unordered_set<std::string> seenUrls;
+    std::vector<MarkdownPreviewLink> deduped;
+    deduped.reserve(links.size());
+    for (auto& link : links) {
+        if (seenUrls.insert(link.url).second) { deduped.push_back(std::move(link)); }
+    }
+    return deduped;
+}
+
+std::vector<MarkdownPreviewLine> ParseMarkdownPreviewLines(const std::string& markdownText) {
+    std::vector<MarkdownPreviewLine> out;
+    bool inCodeFence = false;
+    size_t start = 0;
+    while (start < markdownText.size()) {
+        size_t end = markdownText.find('\n', start);
+        if (end == std::string::npos) end = markdownText.size();
+        const size_t lineIndex = out.size();
+        ParseMarkdownLine(std::string_view(markdownText).substr(start, end - start), inCodeFence, lineIndex, out.emplace_back());
+        start = end + 1;
+    }
+
+    if (out.empty()) {
+        MarkdownPreviewLine line;
+        line.kind = MarkdownLineKind::Blank;
+        line.sourceLineIndex = 0;
+        out.push_back(line);
+    }
+    return out;
+}
+
+void ForEachMarkdownPreviewLine(std::string_view markdownText, const std::function<void(const MarkdownPreviewLine&)>& visit) {
+    MarkdownPreviewLine line;
+    bool inCodeFence = false;
+    size_t lineIndex = 0;
+    size_t start = 0;
+    while (start < markdownText.size()) {
+        size_t end = markdownText.find('\n', start);
+        if (end == std::string_view::npos) end = markdownText.size();
+        ParseMarkdownLine(markdownText.substr(start, end - start), inCodeFence, lineIndex++, line);
+        visit(line);
+        start = end + 1;
+    }
+
+    if (lineIndex == 0) {
+        line = MarkdownPreviewLine();
+        line.kind = MarkdownLineKind::Blank;
+        line.sourceLineIndex = 0;
+        visit(line);
+    }
+}
+
+MarkdownDocument::MarkdownDocument() {
+    // Empty text: a single empty segment, which parses to the Blank placeholder line
+    bool inCodeFence = false;
+    ParseMarkdownLine(std::string_view(), inCodeFence, 0, m_lines.emplace_back());
+    m_lineStarts.push_back(0);
+    m_inCodeFenceBefore.push_back(0);
+}
+
+std::span<MarkdownPreviewLine> MarkdownDocument::Lines() {
+    return std::span<MarkdownPreviewLine>(m_lines.data(), VisibleLineCount(m_lineStarts, m_text.size()));
+}
+
+bool MarkdownDocument::Update(const std::string& text) {
+    const size_t oldSize = m_text.size();
+    const size_t newSize = text.size();
+    if (oldSize == newSize && std::memcmp(m_text.data(), text.data(), newSize) == 0) return false;
+
+    // Common prefix / suffix of the old and new text; everything in between is the edit
+    const size_t maxCommon = std::min(oldSize, newSize);
+    const size_t prefix = CommonPrefixLength(m_text.data(), text.data(), maxCommon);
+    const size_t suffix = CommonSuffixLength(m_text.data() + oldSize, text.data() + newSize, maxCommon - prefix);
+
+    // First dirty segment: the one containing the first changed byte (earlier segments end before it, newline
+    // included). First clean segment: the first one whose preceding '\n' lies inside the common suffix.
+    const size_t firstDirty = static_cast<size_t>(std::upper_bound(m_lineStarts.begin(), m_lineStarts.end(), prefix) - m_lineStarts.begin()) - 1;
+    const size_t firstClean = static_cast<size_t>(
+        std::lower_bound(m_lineStarts.begin() + firstDirty + 1, m_lineStarts.end(), oldSize - suffix + 1) - m_lineStarts.begin());
+    const ptrdiff_t delta = static_cast<ptrdiff_t>(newSize) - static_cast<ptrdiff_t>(oldSize);
+
+    // Re-parse the edited region of the new text
+    const size_t regionStart = m_lineStarts[firstDirty];
+    const size_t regionEnd = firstClean < m_lineStarts.size() ? static_cast<size_t>(static_cast<ptrdiff_t>(m_lineStarts[firstClean]) + delta) - 1 : newSize;
+    bool inCodeFence = m_inCodeFenceBefore[firstDirty] != 0;
+
+    std::vector<MarkdownPreviewLine> parsed;
+    std::vector<size_t> parsedStarts;
+    std::vector<uint8_t> parsedFence;
+    const std::string_view source(text);
+    for (size_t start = regionStart;;) {
+        size_t end = source.find('\n', start);
+        if (end == std::string_view::npos || end > regionEnd) end = regionEnd;
+        parsedStarts.push_back(start);
+        parsedFence.push_back(inCodeFence ? 1 : 0);
+        const size_t lineIndex = firstDirty + parsed.size();
+        ParseMarkdownLine(source.substr(start, end - start), inCodeFence, lineIndex, parsed.emplace_back());
+        if (end >= regionEnd) break;
+        start = end + 1;
+    }
+
+    const size_t inserted = parsed.size();
+    SpliceRange(m_lines, firstDirty, firstClean, parsed);
+    SpliceRange(m_lineStarts, firstDirty, firstClean, parsedStarts);
+    SpliceRange(m_inCodeFenceBefore, firstDirty, firstClean, parsedFence);
+
+    // Segments after the edit keep their parse, shifted. If the edit opened or closed a code fence, the following
+    // lines change meaning too: re-parse them until the fence state matches the one they were parsed with.
+    size_t reparsed = inserted;
+    size_t i = firstDirty + inserted;
+    for (; i < m_lines.size() && (m_inCodeFenceBefore[i] != 0) != inCodeFence; ++i) {
+        const size_t start = static_cast<size_t>(static_cast<ptrdiff_t>(m_lineStarts[i]) + delta);
+        size_t end = source.find('\n', start);
+        if (end == std::string_view::npos) end = newSize;
+        m_lineStarts[i] = start;
+        m_inCodeFenceBefore[i] = inCodeFence ? 1 : 0;
+        ParseMarkdownLine(source.substr(start, end - start), inCodeFence, i, m_lines[i]);
+        ++reparsed;
+    }
+    for (size_t j = i; j < m_lines.size(); ++j) {
+        m_lineStarts[j] = static_cast<size_t>(static_cast<ptrdiff_t>(m_lineStarts[j]) + delta);
+        m_lines[j].sourceLineIndex = j;
+    }
+
+    m_text = text;
+    m_lastReparsed = reparsed;
+    ++m_revision;
+    return true;
+}
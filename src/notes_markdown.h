@@ -0,0 +1,78 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <limits>
+#include <span>
+#include <string>
+#include <string_view>
+#include <vector>
+
+// Markdown model behind the notes overlay preview and PDF export. Platform-neutral (no ImGui / Win32).
+
+enum class MarkdownLineKind : int { Blank = 0, Rule, Heading, Quote, Bullet, Numbered, Task, Code, Body };
+
+struct MarkdownPreviewLink {
+    std::string label;
+    std::string url;
+    size_t start = 0;
+    size_t end = 0;
+};
+
+struct MarkdownPreviewLine {
+    MarkdownLineKind kind = MarkdownLineKind::Body;
+    std::string text;
+    int headingLevel = 0; // 1..6 when kind == Heading
+    std::string listPrefix;
+    bool checked = false; // used when kind == Task
+    size_t sourceLineIndex = std::numeric_limits<size_t>::max();
+    std::vector<MarkdownPreviewLink> links; // http(s) links in text, first occurrence of each URL (not for Code lines)
+
+    // Layout cache owned by the renderer: height of the line (including item spacing) at the given wrap width and
+    // font size. A re-parsed line starts with no layout.
+    float layoutWrapWidth = -1.0f;
+    float layoutFontSize = -1.0f;
+    float layoutHeight = 0.0f;
+};
+
+bool IsHttpUrl(const std::string& value);
+size_t CountLeadingIndentColumns(const std::string& line);
+const char* GetRenderedBulletPrefix();
+
+// Markdown links ([label](url)) and bare URLs, ordered by position, one entry per distinct URL
+std::vector<MarkdownPreviewLink> ExtractMarkdownPreviewLinks(const std::string& text);
+
+// One-shot parse of a whole note (always at least one line)
+std::vector<MarkdownPreviewLine> ParseMarkdownPreviewLines(const std::string& markdownText);
+
+// Same lines, handed to `visit` one at a time instead of being kept (for exporting large notes)
+void ForEachMarkdownPreviewLine(std::string_view markdownText, const std::function<void(const MarkdownPreviewLine&)>& visit);
+
+// Parsed note that follows edits incrementally. Update() diffs the new text against the previous one and re-parses
+// only the lines touched by the edit (plus any lines whose code-fence state flipped because of it); untouched lines
+// keep their parse, links and layout cache. Revision() changes whenever the text does.
+class MarkdownDocument {
+  public:
+    MarkdownDocument();
+
+    // Returns true if the text changed since the last call
+    bool Update(const std::string& text);
+
+    uint64_t Revision() const { return m_revision; }
+
+    // Same lines ParseMarkdownPreviewLines() would return for the current text
+    std::span<MarkdownPreviewLine> Lines();
+
+    // Lines re-parsed by the last Update() that changed something (for checking the incremental path)
+    size_t LastReparsedLineCount() const { return m_lastReparsed; }
+
+  private:
+    std::string m_text;
+    // One entry per '\n'-separated segment of m_text, including an empty trailing one (hidden by Lines())
+    std::vector<MarkdownPreviewLine> m_lines;
+    std::vector<size_t> m_lineStarts;
+    std::vector<uint8_t> m_inCodeFenceBefore;
+    uint64_t m_revision = 0;
+    size_t m_lastReparsed = 0;
+};
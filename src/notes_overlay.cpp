@@ -1,5 +1,9 @@
 #include "notes_overlay.h"
 #include "gui.h"
+#include "notes_index.h"
+#include "notes_markdown.h"
+#include "notes_pdf.h"
+#include "notes_persistence.h"
 #include "utils.h"
 
 #include "imgui.h"
@@ -16,6 +20,7 @@
 #include <fstream>
 #include <iomanip>
 #include <limits>
+#include <memory>
 #include <mutex>
 #include <set>
 #include <sstream>
@@ -44,6 +49,7 @@ enum class NotesSortMode : int {
 
 struct NotesFileEntry {
     std::filesystem::path path;
+    std::string folder; // Relative to the notes root, see NotesCatalogEntry
     std::string title;
     std::string displayLabel;
     int64_t modifiedEpochSeconds = 0;
@@ -52,6 +58,15 @@ struct NotesFileEntry {
     bool favorite = false;
 };
 
+// A draft save handed to the persistence worker
+struct NotesSaveSlot {
+    uint64_t ticket = 0;                      // In-flight request (0 = none)
+    std::filesystem::path editingPathAtStart; // The editor adopts the written file only if it still shows this note
+    bool draftClosed = false;                 // The draft was cleared after handing it over (IGN save on close)
+    uint64_t draftGeneration = 0;             // ignDraftGeneration / generalDraftGeneration when the save was taken
+    std::string statusVerb;                   // Empty for silent autosaves
+};
+
 struct NotesOverlayState {
     bool initializedVisibility = false;
     bool visible = false;
@@ -73,6 +88,8 @@ struct NotesOverlayState {
     bool ignEditedSinceOpen = false;
     std::string ignDraft;
     std::filesystem::path ignEditingPath;
+    // Bumped whenever the IGN draft is reset or replaced (clear, load, delete, close), like generalDraftGeneration
+    uint64_t ignDraftGeneration = 0;
     std::vector<NotesFileEntry> ignEntries;
     int selectedIgnEntryIndex = -1;
 
@@ -85,16 +102,35 @@ struct NotesOverlayState {
     std::string generalTitle;
     std::string generalDraft;
     std::filesystem::path generalEditingPath;
+    // Bumped whenever the editor moves to another note (new, load, delete, folder switch). Two unsaved new notes share
+    // an empty path, so a landing save checks this rather than the path before adopting the written file.
+    uint64_t generalDraftGeneration = 0;
     std::vector<NotesFileEntry> generalEntries;
     int selectedGeneralEntryIndex = -1;
     std::set<std::wstring> pinnedPathKeys;
     std::set<std::wstring> favoritePathKeys;
 
+    // Listings are built from the notes index catalog; reloaded when a new one is published
+    std::shared_ptr<const NotesCatalog> catalog;
+    bool metadataLoaded = false;
+    std::string loadedPinnedText;
+    std::string loadedFavoriteText;
+
+    std::string searchQuery;
+    std::string searchResultsQuery; // Query/catalog the results below were computed for
+    std::shared_ptr<const NotesCatalog> searchResultsCatalog;
+    std::vector<NotesSearchResult> searchResults;
+
     bool ignDraftDirty = false;
     bool generalDraftDirty = false;
+    // At most one save per draft is in flight; edits made meanwhile stay dirty and go out once it lands
+    NotesSaveSlot ignSave;
+    NotesSaveSlot generalSave;
+    bool ignCloseSaveDeferred = false; // Overlay closed while an IGN save was in flight
+    MarkdownDocument ignPreview; // Parsed drafts for the Preview tabs, updated incrementally as the text changes
+    MarkdownDocument generalPreview;
     std::chrono::steady_clock::time_point ignLastEdit = std::chrono::steady_clock::time_point::min();
     std::chrono::steady_clock::time_point generalLastEdit = std::chrono::steady_clock::time_point::min();
-    std::chrono::steady_clock::time_point lastAutoRefresh = std::chrono::steady_clock::time_point::min();
 
     std::string statusText;
     std::chrono::steady_clock::time_point statusUntil = std::chrono::steady_clock::time_point::min();
@@ -115,11 +151,11 @@ struct NotesOverlayState {
 std::mutex s_notesMutex;
 NotesOverlayState s_notes;
 std::atomic<bool> s_pendingIgnAutoSaveOnClose{ false };
+std::atomic<int> s_notesPersistInFlight{ 0 }; // Requests whose results the overlay has not collected yet
 
 constexpr const char* kGeneralFolderRoot = "";
 constexpr const char* kGeneralFolderFavorites = "__favorites__";
 
-std::filesystem::path BuildUniqueFilePath(const std::filesystem::path& folder, const std::string& fileBase, const std::string& extWithDot);
 std::string GuessTitleFromPath(const std::filesystem::path& path);
 
 struct NotesIconTexture {
@@ -239,14 +275,6 @@ std::string FormatEpochForList(int64_t epochSeconds) {
     return out.str();
 }
 
-int64_t ToEpochSeconds(const std::filesystem::file_time_type& fileTime) {
-    using namespace std::chrono;
-    const auto sysNow = system_clock::now();
-    const auto fileNow = std::filesystem::file_time_type::clock::now();
-    const auto sysTp = time_point_cast<system_clock::duration>(fileTime - fileNow + sysNow);
-    return duration_cast<seconds>(sysTp.time_since_epoch()).count();
-}
-
 uint64_t ExtractFirstNumberKey(const std::string& text) {
     uint64_t value = 0;
     bool found = false;
@@ -565,6 +593,14 @@ std::filesystem::path GetPdfExportRootPath() {
     return ResolveConfiguredPath(configuredPath, std::filesystem::path("notes") / "PDF");
 }
 
+// Exports use the overlay's UI font, so the PDF covers the same characters the editor shows
+NotesPdfFonts GetPdfExportFonts() {
+    NotesPdfFonts fonts;
+    auto cfgSnap = GetConfigSnapshot();
+    if (cfgSnap && !cfgSnap->fontPath.empty()) { fonts.regular = std::filesystem::path(Utf8ToWide(cfgSnap->fontPath)); }
+    return fonts;
+}
+
 void EnsureNotesDirectories() {
     try {
         std::filesystem::create_directories(GetGeneralNotesRootPath());
@@ -588,19 +624,6 @@ bool WriteUtf8TextFile(const std::filesystem::path& path, const std::string& tex
     }
 }
 
-bool WriteBinaryFile(const std::filesystem::path& path, const std::string& data) {
-    try {
-        std::filesystem::create_directories(path.parent_path());
-        std::ofstream out(path, std::ios::binary | std::ios::trunc);
-        if (!out.is_open()) return false;
-        out.write(data.data(), static_cast<std::streamsize>(data.size()));
-        out.flush();
-        return out.good();
-    } catch (...) {
-        return false;
-    }
-}
-
 bool ReadUtf8TextFile(const std::filesystem::path& path, std::string& outText) {
     outText.clear();
     try {
@@ -669,11 +692,8 @@ std::wstring NormalizePathKey(const std::filesystem::path& path) {
     }
 }
 
-void LoadPathSetMetadata(const std::filesystem::path& metaPath, std::set<std::wstring>& outSet) {
+void ParsePathSetMetadata(const std::string& raw, std::set<std::wstring>& outSet) {
     outSet.clear();
-    std::string raw;
-    if (!ReadUtf8TextFile(metaPath, raw)) return;
-
     std::istringstream in(raw);
     std::string line;
     while (std::getline(in, line)) {
@@ -697,12 +717,18 @@ void SavePathSetMetadata(const std::filesystem::path& metaPath, const std::set<s
     WriteUtf8TextFile(metaPath, out);
 }
 
-void LoadPinnedMetadata(NotesOverlayState& st) {
-    LoadPathSetMetadata(GetNotesPinnedMetaPath(), st.pinnedPathKeys);
-}
-
-void LoadFavoriteMetadata(NotesOverlayState& st) {
-    LoadPathSetMetadata(GetNotesFavoritesMetaPath(), st.favoritePathKeys);
+// Pin / favorite lists come with the catalog; only re-parse them when the file contents changed. Toggles update the
+// sets directly and write the file, which the next catalog picks up.
+void LoadPinAndFavoriteMetadata(NotesOverlayState& st, const NotesCatalog& catalog) {
+    if (!st.metadataLoaded || catalog.pinnedMetadataText != st.loadedPinnedText) {
+        ParsePathSetMetadata(catalog.pinnedMetadataText, st.pinnedPathKeys);
+        st.loadedPinnedText = catalog.pinnedMetadataText;
+    }
+    if (!st.metadataLoaded || catalog.favoriteMetadataText != st.loadedFavoriteText) {
+        ParsePathSetMetadata(catalog.favoriteMetadataText, st.favoritePathKeys);
+        st.loadedFavoriteText = catalog.favoriteMetadataText;
+    }
+    st.metadataLoaded = true;
 }
 
 void SavePinnedMetadata(const NotesOverlayState& st) { SavePathSetMetadata(GetNotesPinnedMetaPath(), st.pinnedPathKeys); }
@@ -868,16 +894,6 @@ std::string FormatNotesHotkeyLabel(const NotesOverlayConfig& cfg) {
     return label;
 }
 
-std::filesystem::path BuildUniqueFilePath(const std::filesystem::path& folder, const std::string& fileBase, const std::string& extWithDot) {
-    std::filesystem::path target = folder / Utf8ToWide(fileBase + extWithDot);
-    int suffix = 1;
-    while (std::filesystem::exists(target) && suffix < 100000) {
-        target = folder / Utf8ToWide(fileBase + "_" + std::to_string(suffix) + extWithDot);
-        ++suffix;
-    }
-    return target;
-}
-
 bool OpenFolderContainingPath(const std::filesystem::path& path) {
     try {
         std::filesystem::path folder = path.parent_path();
@@ -1007,13 +1023,21 @@ void EnsureRuleUnderTopHeading(std::string& markdownText) {
     markdownText.swap(rebuilt);
 }
 
-std::string BuildNextUntitledTitle(const std::filesystem::path& folder) {
+// Checks the index catalog rather than the disk; the persistence worker still uniquifies a name taken since the last scan
+std::string BuildNextUntitledTitle(const NotesOverlayState& st, const std::filesystem::path& folder) {
+    std::set<std::wstring> takenKeys;
+    if (st.catalog) {
+        const std::wstring folderKey = NormalizePathKey(folder);
+        for (const NotesCatalogEntry& entry : st.catalog->entries) {
+            if (NormalizePathKey(entry.path.parent_path()) == folderKey) { takenKeys.insert(NormalizePathKey(entry.path)); }
+        }
+    }
+
     std::string base = "untitled";
     int index = 1;
     while (index < 100000) {
         const std::string candidate = base + "_" + std::to_string(index);
-        const std::filesystem::path p = folder / Utf8ToWide(candidate + ".md");
-        if (!std::filesystem::exists(p)) return candidate;
+        if (takenKeys.count(NormalizePathKey(folder / Utf8ToWide(candidate + ".md"))) == 0) return candidate;
         ++index;
     }
     return "untitled_" + CurrentDateStamp() + "_" + CurrentTimeStamp();
@@ -1046,7 +1070,7 @@ std::string ResolveIgnDraftSaveTitle(const NotesOverlayState& st, const std::fil
     std::string titleFromMarkdown = SanitizeFileComponent(ExtractMarkdownTitle(st.ignDraft));
     std::string titleFromPath = SanitizeFileComponent(GuessTitleFromPath(st.ignEditingPath));
     std::string title = HasMeaningfulText(titleFromMarkdown) ? titleFromMarkdown : titleFromPath;
-    if (title.empty() || title == "note") { title = BuildNextUntitledTitle(ignFolder); }
+    if (title.empty() || title == "note") { title = BuildNextUntitledTitle(st, ignFolder); }
     return title;
 }
 
@@ -1059,71 +1083,6 @@ std::string ResolveGeneralPreviewTitle(const NotesOverlayState& st) {
     return "General Note";
 }
 
-enum class MarkdownLineKind : int { Blank = 0, Rule, Heading, Quote, Bullet, Numbered, Task, Code, Body };
-
-struct MarkdownPreviewLine {
-    MarkdownLineKind kind = MarkdownLineKind::Body;
-    std::string text;
-    int headingLevel = 0; // 1..6 when kind == Heading
-    std::string listPrefix;
-    bool checked = false; // used when kind == Task
-    size_t sourceLineIndex = std::numeric_limits<size_t>::max();
-};
-
-bool IsMarkdownHorizontalRule(const std::string& line) {
-    return line == "---" || line == "***" || line == "___";
-}
-
-bool IsMarkdownNumberedListLine(const std::string& trimmedLine, std::string& outPrefix, std::string& outValue) {
-    size_t i = 0;
-    while (i < trimmedLine.size() && std::isdigit(static_cast<unsigned char>(trimmedLine[i]))) {
-        ++i;
-    }
-    if (i == 0 || i + 1 >= trimmedLine.size()) return false;
-    const char sep = trimmedLine[i];
-    if (sep != '.' && sep != ')') return false;
-    if (trimmedLine[i + 1] != ' ') return false;
-    outPrefix = trimmedLine.substr(0, i) + ". ";
-    outValue = trimmedLine.substr(i + 2);
-    return true;
-}
-
-bool IsMarkdownTaskMarker(const std::string& text, bool& outChecked, std::string& outBody) {
-    if (text.size() < 4 || text[0] != '[') return false;
-    const char mark = static_cast<char>(std::tolower(static_cast<unsigned char>(text[1])));
-    if (text[2] != ']' || text[3] != ' ') return false;
-    if (mark != 'x' && mark != ' ') return false;
-    outChecked = (mark == 'x');
-    outBody = text.substr(4);
-    return true;
-}
-
-size_t CountLeadingIndentColumns(const std::string& line) {
-    size_t columns = 0;
-    for (char c : line) {
-        if (c == ' ') {
-            ++columns;
-            continue;
-        }
-        if (c == '\t') {
-            columns += 4;
-            continue;
-        }
-        break;
-    }
-    return columns;
-}
-
-std::string TrimLeftAscii(const std::string& text) {
-    size_t first = 0;
-    while (first < text.size() && std::isspace(static_cast<unsigned char>(text[first]))) {
-        ++first;
-    }
-    return text.substr(first);
-}
-
-const char* GetRenderedBulletPrefix() { return "\xE2\x80\xA2 "; }
-
 bool BuildNextMarkdownListPrefix(const std::string& rawLine, std::string& outPrefix) {
     outPrefix.clear();
     if (rawLine.empty()) return false;
@@ -1216,113 +1175,6 @@ bool ApplyAutoListContinuation(std::string& text, size_t previousSize) {
     return true;
 }
 
-std::vector<MarkdownPreviewLine> ParseMarkdownPreviewLines(const std::string& markdownText) {
-    std::vector<MarkdownPreviewLine> out;
-    std::istringstream in(markdownText);
-    std::string rawLine;
-    bool inCodeFence = false;
-    size_t sourceLineIndex = 0;
-
-    auto pushLine = [&](MarkdownLineKind kind, std::string text, int headingLevel, std::string listPrefix, bool checked) {
-        MarkdownPreviewLine line;
-        line.kind = kind;
-        line.text = std::move(text);
-        line.headingLevel = headingLevel;
-        line.listPrefix = std::move(listPrefix);
-        line.checked = checked;
-        line.sourceLineIndex = sourceLineIndex;
-        out.push_back(std::move(line));
-    };
-
-    while (std::getline(in, rawLine)) {
-        if (!rawLine.empty() && rawLine.back() == '\r') rawLine.pop_back();
-        const std::string trimmed = TrimAscii(rawLine);
-        const std::string leadingTrimmed = TrimLeftAscii(rawLine);
-        const size_t indentColumns = CountLeadingIndentColumns(rawLine);
-        const size_t listIndent = std::min<size_t>(32, (indentColumns / 2) * 2);
-
-        if (trimmed.rfind("```", 0) == 0) {
-            inCodeFence = !inCodeFence;
-            pushLine(MarkdownLineKind::Rule, "", 0, "", false);
-            ++sourceLineIndex;
-            continue;
-        }
-
-        if (inCodeFence) {
-            pushLine(MarkdownLineKind::Code, rawLine, 0, "", false);
-            ++sourceLineIndex;
-            continue;
-        }
-
-        if (trimmed.empty()) {
-            pushLine(MarkdownLineKind::Blank, "", 0, "", false);
-            ++sourceLineIndex;
-            continue;
-        }
-
-        if (IsMarkdownHorizontalRule(trimmed)) {
-            pushLine(MarkdownLineKind::Rule, "", 0, "", false);
-            ++sourceLineIndex;
-            continue;
-        }
-
-        size_t headingLevel = 0;
-        while (headingLevel < trimmed.size() && trimmed[headingLevel] == '#') {
-            ++headingLevel;
-        }
-        if (headingLevel > 0 && headingLevel <= 6 && headingLevel < trimmed.size() && trimmed[headingLevel] == ' ') {
-            pushLine(MarkdownLineKind::Heading, trimmed.substr(headingLevel + 1), static_cast<int>(headingLevel), "", false);
-            ++sourceLineIndex;
-            continue;
-        }
-
-        if (leadingTrimmed.rfind("> ", 0) == 0) {
-            pushLine(MarkdownLineKind::Quote, leadingTrimmed.substr(2), 0, "", false);
-            ++sourceLineIndex;
-            continue;
-        }
-
-        std::string listValue;
-        std::string listPrefix;
-        if (leadingTrimmed.rfind("- ", 0) == 0 || leadingTrimmed.rfind("* ", 0) == 0 || leadingTrimmed.rfind("+ ", 0) == 0) {
-            listValue = leadingTrimmed.substr(2);
-            listPrefix = std::string(listIndent, ' ') + GetRenderedBulletPrefix();
-        } else {
-            std::string numberedPrefix;
-            std::string numberedBody;
-            if (IsMarkdownNumberedListLine(leadingTrimmed, numberedPrefix, numberedBody)) {
-                const std::string prefix = std::string(listIndent, ' ') + numberedPrefix;
-                pushLine(MarkdownLineKind::Numbered, numberedBody, 0, prefix, false);
-                ++sourceLineIndex;
-                continue;
-            }
-        }
-        if (!listValue.empty()) {
-            bool taskChecked = false;
-            std::string taskBody;
-            if (IsMarkdownTaskMarker(listValue, taskChecked, taskBody)) {
-                const std::string taskPrefix = std::string(listIndent, ' ') + (taskChecked ? "[x] " : "[ ] ");
-                pushLine(MarkdownLineKind::Task, taskBody, 0, taskPrefix, taskChecked);
-            } else {
-                pushLine(MarkdownLineKind::Bullet, listValue, 0, listPrefix, false);
-            }
-            ++sourceLineIndex;
-            continue;
-        }
-
-        pushLine(MarkdownLineKind::Body, rawLine, 0, "", false);
-        ++sourceLineIndex;
-    }
-
-    if (out.empty()) {
-        MarkdownPreviewLine line;
-        line.kind = MarkdownLineKind::Blank;
-        line.sourceLineIndex = 0;
-        out.push_back(line);
-    }
-    return out;
-}
-
 bool ToggleMarkdownTaskLineByIndex(std::string& markdownText, size_t sourceLineIndex) {
     if (sourceLineIndex == std::numeric_limits<size_t>::max()) return false;
     std::vector<std::string> lines;
@@ -1370,133 +1222,12 @@ bool ToggleMarkdownTaskLineByIndex(std::string& markdownText, size_t sourceLineI
     return true;
 }
 
-struct MarkdownPreviewLink {
-    std::string label;
-    std::string url;
-    size_t start = 0;
-    size_t end = 0;
-};
-
-bool IsHttpUrl(const std::string& value) {
-    return value.rfind("https://", 0) == 0 || value.rfind("http://", 0) == 0;
-}
-
 bool IsLikelyVideoUrl(const std::string& url) {
     const std::string lower = ToLowerAscii(url);
     return lower.find("youtube.com/") != std::string::npos || lower.find("youtu.be/") != std::string::npos ||
            lower.find("vimeo.com/") != std::string::npos || lower.find("twitch.tv/") != std::string::npos;
 }
 
-bool RangesOverlap(size_t startA, size_t endA, size_t startB, size_t endB) {
-    return (startA < endB) && (startB < endA);
-}
-
-size_t FindUrlEnd(const std::string& text, size_t start) {
-    size_t end = start;
-    while (end < text.size()) {
-        const unsigned char c = static_cast<unsigned char>(text[end]);
-        if (std::isspace(c) || c == '<' || c == '>' || c == '"' || c == '\'' || c == '`') break;
-        ++end;
-    }
-    while (end > start) {
-        const char tail = text[end - 1];
-        if (tail == '.' || tail == ',' || tail == ';' || tail == ':' || tail == ')' || tail == ']') {
-            --end;
-            continue;
-        }
-        break;
-    }
-    return end;
-}
-
-std::vector<MarkdownPreviewLink> ExtractMarkdownPreviewLinks(const std::string& text) {
-    std::vector<MarkdownPreviewLink> links;
-    links.reserve(4);
-
-    // Markdown links: [label](url)
-    for (size_t i = 0; i < text.size();) {
-        if (text[i] != '[') {
-            ++i;
-            continue;
-        }
-        const size_t closeBracket = text.find(']', i + 1);
-        if (closeBracket == std::string::npos || closeBracket + 1 >= text.size() || text[closeBracket + 1] != '(') {
-            ++i;
-            continue;
-        }
-        const size_t closeParen = text.find(')', closeBracket + 2);
-        if (closeParen == std::string::npos) {
-            ++i;
-            continue;
-        }
-
-        const std::string label = TrimAscii(text.substr(i + 1, closeBracket - (i + 1)));
-        const std::string url = TrimAscii(text.substr(closeBracket + 2, closeParen - (closeBracket + 2)));
-        if (IsHttpUrl(url)) {
-            MarkdownPreviewLink link;
-            link.label = label;
-            link.url = url;
-            link.start = i;
-            link.end = closeParen + 1;
-            links.push_back(std::move(link));
-            i = closeParen + 1;
-            continue;
-        }
-        ++i;
-    }
-
-    // Plain URLs not already covered by markdown link ranges.
-    for (size_t pos = 0; pos < text.size();) {
-        const size_t httpPos = text.find("http://", pos);
-        const size_t httpsPos = text.find("https://", pos);
-        size_t start = std::string::npos;
-        if (httpPos == std::string::npos) {
-            start = httpsPos;
-        } else if (httpsPos == std::string::npos) {
-            start = httpPos;
-        } else {
-            start = std::min(httpPos, httpsPos);
-        }
-        if (start == std::string::npos) break;
-
-        const size_t end = FindUrlEnd(text, start);
-        if (end <= start) {
-            pos = start + 1;
-            continue;
-        }
-
-        bool overlaps = false;
-        for (const auto& existing : links) {
-            if (RangesOverlap(start, end, existing.start, existing.end)) {
-                overlaps = true;
-                break;
-            }
-        }
-        if (!overlaps) {
-            MarkdownPreviewLink link;
-            link.url = text.substr(start, end - start);
-            link.label = link.url;
-            link.start = start;
-            link.end = end;
-            if (IsHttpUrl(link.url)) { links.push_back(std::move(link)); }
-        }
-        pos = end;
-    }
-
-    std::sort(links.begin(), links.end(), [](const MarkdownPreviewLink& a, const MarkdownPreviewLink& b) {
-        if (a.start != b.start) return a.start < b.start;
-        return a.end < b.end;
-    });
-
-    std::set<std::string> seenUrls;
-    std::vector<MarkdownPreviewLink> deduped;
-    deduped.reserve(links.size());
-    for (const auto& link : links) {
-        if (seenUrls.insert(link.url).second) { deduped.push_back(link); }
-    }
-    return deduped;
-}
-
 bool OpenMarkdownPreviewUrl(const std::string& url) {
     if (!IsHttpUrl(url)) return false;
     const std::wstring wideUrl = Utf8ToWide(url);
@@ -1505,7 +1236,7 @@ bool OpenMarkdownPreviewUrl(const std::string& url) {
 }
 
 void RenderMarkdownPreviewLinksInline(const MarkdownPreviewLine& line) {
-    const std::vector<MarkdownPreviewLink> links = ExtractMarkdownPreviewLinks(line.text);
+    const std::vector<MarkdownPreviewLink>& links = line.links;
     if (links.empty()) return;
 
     for (size_t i = 0; i < links.size(); ++i) {
@@ -1527,396 +1258,6 @@ void RenderMarkdownPreviewLinksInline(const MarkdownPreviewLine& line) {
     }
 }
 
-std::vector<std::string> WrapTextToColumns(const std::string& text, size_t maxColumns) {
-    std::vector<std::string> wrapped;
-    std::string expanded;
-    expanded.reserve(text.size() + 8);
-    for (char c : text) {
-        if (c == '\t') {
-            expanded += "    ";
-        } else {
-            expanded.push_back(c);
-        }
-    }
-
-    if (expanded.empty()) {
-        wrapped.emplace_back();
-        return wrapped;
-    }
-
-    std::string remaining = expanded;
-    while (remaining.size() > maxColumns) {
-        size_t cut = remaining.rfind(' ', maxColumns);
-        if (cut == std::string::npos || cut < maxColumns / 3) { cut = maxColumns; }
-        wrapped.push_back(remaining.substr(0, cut));
-        size_t next = cut;
-        while (next < remaining.size() && remaining[next] == ' ') {
-            ++next;
-        }
-        remaining = remaining.substr(next);
-    }
-    wrapped.push_back(remaining);
-    return wrapped;
-}
-
-std::vector<std::string> WrapTextWithPrefix(const std::string& text, const std::string& firstPrefix, const std::string& nextPrefix,
-                                            size_t maxColumns) {
-    std::vector<std::string> wrapped = WrapTextToColumns(text, maxColumns > firstPrefix.size() ? maxColumns - firstPrefix.size() : maxColumns);
-    for (size_t i = 0; i < wrapped.size(); ++i) {
-        wrapped[i] = (i == 0 ? firstPrefix : nextPrefix) + wrapped[i];
-    }
-    return wrapped;
-}
-
-float EstimateIndentPointsFromPrefix(const std::string& prefix) {
-    size_t leadingSpaces = 0;
-    for (char c : prefix) {
-        if (c == ' ') {
-            ++leadingSpaces;
-            continue;
-        }
-        if (c == '\t') {
-            leadingSpaces += 4;
-            continue;
-        }
-        break;
-    }
-    return static_cast<float>(leadingSpaces) * 3.4f;
-}
-
-std::string EscapePdfLiteralText(const std::string& text) {
-    std::string escaped;
-    escaped.reserve(text.size() * 2);
-    for (unsigned char c : text) {
-        if (c == '\\' || c == '(' || c == ')') {
-            escaped.push_back('\\');
-            escaped.push_back(static_cast<char>(c));
-            continue;
-        }
-        if (c >= 32 && c <= 126) {
-            escaped.push_back(static_cast<char>(c));
-        } else {
-            escaped.push_back('?');
-        }
-    }
-    return escaped;
-}
-
-float HeadingPdfFontSize(int headingLevel) {
-    static const float kSizes[] = { 20.0f, 18.0f, 16.0f, 14.0f, 12.5f, 11.5f };
-    const int idx = std::clamp(headingLevel, 1, 6) - 1;
-    return kSizes[idx];
-}
-
-size_t HeadingWrapColumns(int headingLevel) {
-    static const size_t kColumns[] = { 52, 58, 66, 74, 82, 90 };
-    const int idx = std::clamp(headingLevel, 1, 6) - 1;
-    return kColumns[idx];
-}
-
-bool WriteSimpleMarkdownPdf(const std::filesystem::path& path, const std::string& title, const std::string& markdownText) {
-    enum class PdfFont : int {
-        Regular = 0,
-        Bold = 1,
-        Mono = 2
-    };
-
-    struct PdfLine {
-        std::string text;
-        float fontSize = 11.0f;
-        bool isBlank = false;
-        bool isRule = false;
-        PdfFont font = PdfFont::Regular;
-        float colorR = 0.07f;
-        float colorG = 0.08f;
-        float colorB = 0.10f;
-        bool drawQuoteBar = false;
-        bool drawBulletDot = false;
-        bool drawTaskBox = false;
-        bool taskChecked = false;
-        float xOffset = 0.0f;
-        float markerIndent = 0.0f;
-    };
-
-    (void)title;
-    std::vector<PdfLine> renderLines;
-
-    const std::vector<MarkdownPreviewLine> parsed = ParseMarkdownPreviewLines(markdownText);
-    for (const auto& line : parsed) {
-        switch (line.kind) {
-        case MarkdownLineKind::Blank:
-            renderLines.push_back({ "", 0.0f, true, false, PdfFont::Regular, 0.07f, 0.08f, 0.10f });
-            break;
-        case MarkdownLineKind::Rule:
-            renderLines.push_back({ "", 10.0f, false, true, PdfFont::Regular, 0.35f, 0.39f, 0.46f });
-            break;
-        case MarkdownLineKind::Heading: {
-            const float size = HeadingPdfFontSize(line.headingLevel);
-            const size_t cols = HeadingWrapColumns(line.headingLevel);
-            const auto wrapped = WrapTextToColumns(line.text, cols);
-            for (const auto& w : wrapped) {
-                renderLines.push_back({ w, size, false, false, PdfFont::Bold, 0.06f, 0.08f, 0.11f });
-            }
-            break;
-        }
-        case MarkdownLineKind::Quote: {
-            const auto wrapped = WrapTextToColumns(line.text, 86);
-            for (const auto& w : wrapped) {
-                PdfLine q{};
-                q.text = w;
-                q.fontSize = 11.0f;
-                q.isBlank = false;
-                q.isRule = false;
-                q.font = PdfFont::Regular;
-                q.colorR = 0.32f;
-                q.colorG = 0.37f;
-                q.colorB = 0.45f;
-                q.drawQuoteBar = true;
-                q.xOffset = 14.0f;
-                q.markerIndent = 0.0f;
-                renderLines.push_back(q);
-            }
-            break;
-        }
-        case MarkdownLineKind::Bullet: {
-            const std::string prefix = line.listPrefix.empty() ? "- " : line.listPrefix;
-            const float indentPoints = EstimateIndentPointsFromPrefix(prefix);
-            const auto wrapped = WrapTextToColumns(line.text, 84);
-            for (size_t i = 0; i < wrapped.size(); ++i) {
-                PdfLine b{};
-                b.text = wrapped[i];
-                b.fontSize = 11.0f;
-                b.isBlank = false;
-                b.isRule = false;
-                b.font = PdfFont::Regular;
-                b.colorR = 0.08f;
-                b.colorG = 0.09f;
-                b.colorB = 0.11f;
-                b.drawBulletDot = (i == 0);
-                b.xOffset = indentPoints + 12.0f;
-                b.markerIndent = indentPoints;
-                renderLines.push_back(b);
-            }
-            break;
-        }
-        case MarkdownLineKind::Numbered: {
-            const std::string prefix = line.listPrefix.empty() ? "1. " : line.listPrefix;
-            const std::string indent(prefix.size(), ' ');
-            const auto wrapped = WrapTextWithPrefix(line.text, prefix, indent, 92);
-            for (const auto& w : wrapped) {
-                renderLines.push_back({ w, 11.0f, false, false, PdfFont::Regular, 0.08f, 0.09f, 0.11f });
-            }
-            break;
-        }
-        case MarkdownLineKind::Task: {
-            const std::string prefix = line.listPrefix.empty() ? (line.checked ? "[x] " : "[ ] ") : line.listPrefix;
-            const float r = line.checked ? 0.12f : 0.48f;
-            const float g = line.checked ? 0.46f : 0.35f;
-            const float b = line.checked ? 0.21f : 0.13f;
-            const float indentPoints = EstimateIndentPointsFromPrefix(prefix);
-            const auto wrapped = WrapTextToColumns(line.text, 84);
-            for (size_t i = 0; i < wrapped.size(); ++i) {
-                PdfLine t{};
-                t.text = wrapped[i];
-                t.fontSize = 11.0f;
-                t.isBlank = false;
-                t.isRule = false;
-                t.font = PdfFont::Regular;
-                t.colorR = r;
-                t.colorG = g;
-                t.colorB = b;
-                t.drawTaskBox = (i == 0);
-                t.taskChecked = line.checked;
-                t.xOffset = indentPoints + 16.0f;
-                t.markerIndent = indentPoints;
-                renderLines.push_back(t);
-            }
-            break;
-        }
-        case MarkdownLineKind::Code: {
-            const auto wrapped = WrapTextToColumns(line.text, 96);
-            for (const auto& w : wrapped) {
-                renderLines.push_back({ w, 10.0f, false, false, PdfFont::Mono, 0.10f, 0.30f, 0.56f });
-            }
-            break;
-        }
-        case MarkdownLineKind::Body:
-        default: {
-            const auto wrapped = WrapTextToColumns(line.text, 96);
-            for (const auto& w : wrapped) {
-                renderLines.push_back({ w, 11.0f, false, false, PdfFont::Regular, 0.08f, 0.09f, 0.11f });
-            }
-            break;
-        }
-        }
-    }
-
-    if (renderLines.empty()) renderLines.push_back({ "", 0.0f, true, false, PdfFont::Regular, 0.07f, 0.08f, 0.10f });
-
-    std::vector<std::string> pageStreams;
-    std::ostringstream stream;
-    constexpr float kLeft = 50.0f;
-    constexpr float kTopY = 770.0f;
-    constexpr float kBottomY = 50.0f;
-    float y = kTopY;
-
-    auto flushPage = [&]() {
-        pageStreams.push_back(stream.str());
-        stream.str("");
-        stream.clear();
-        y = kTopY;
-    };
-
-    for (const auto& line : renderLines) {
-        float lineHeight = 0.0f;
-        if (line.isBlank) {
-            lineHeight = 7.0f;
-        } else if (line.isRule) {
-            lineHeight = 8.0f;
-        } else if (line.font == PdfFont::Bold && line.fontSize >= 12.0f) {
-            lineHeight = line.fontSize + 1.6f;
-        } else {
-            lineHeight = line.fontSize + 3.0f;
-        }
-        if (y - lineHeight < kBottomY) { flushPage(); }
-
-        if (!line.isBlank) {
-            if (line.isRule) {
-                const float yLine = y - 2.0f;
-                const float x1 = kLeft;
-                const float x2 = 612.0f - kLeft;
-                stream << std::fixed << std::setprecision(3) << line.colorR << " " << line.colorG << " " << line.colorB << " RG\n";
-                stream << "1 w\n";
-                stream << x1 << " " << yLine << " m\n";
-                stream << x2 << " " << yLine << " l\n";
-                stream << "S\n";
-                y -= lineHeight;
-                continue;
-            }
-
-            if (line.drawQuoteBar) {
-                const float xBar = kLeft + line.markerIndent + 4.0f;
-                // Align the quote bar to the text glyph bounds around the current baseline.
-                const float ascent = std::clamp(line.fontSize * 0.72f, 6.5f, 9.0f);
-                const float descent = std::clamp(line.fontSize * 0.30f, 2.2f, 4.4f);
-                const float yTop = y + ascent;
-                const float yBottom = y - descent;
-                stream << std::fixed << std::setprecision(3) << 0.36f << " " << 0.45f << " " << 0.60f << " RG\n";
-                stream << "2 w\n";
-                stream << xBar << " " << yBottom << " m\n";
-                stream << xBar << " " << yTop << " l\n";
-                stream << "S\n";
-            }
-
-            if (line.drawBulletDot) {
-                const float dotRadius = std::clamp(line.fontSize * 0.17f, 1.4f, 2.1f);
-                const float dotX = kLeft + line.markerIndent + 6.0f;
-                const float dotY = y + std::clamp(line.fontSize * 0.24f, 1.5f, 3.6f);
-                const float k = dotRadius * 0.55228475f;
-                stream << std::fixed << std::setprecision(3) << line.colorR << " " << line.colorG << " " << line.colorB << " rg\n";
-                stream << (dotX + dotRadius) << " " << dotY << " m\n";
-                stream << (dotX + dotRadius) << " " << (dotY + k) << " " << (dotX + k) << " " << (dotY + dotRadius) << " " << dotX << " "
-                       << (dotY + dotRadius) << " c\n";
-                stream << (dotX - k) << " " << (dotY + dotRadius) << " " << (dotX - dotRadius) << " " << (dotY + k) << " " << (dotX - dotRadius)
-                       << " " << dotY << " c\n";
-                stream << (dotX - dotRadius) << " " << (dotY - k) << " " << (dotX - k) << " " << (dotY - dotRadius) << " " << dotX << " "
-                       << (dotY - dotRadius) << " c\n";
-                stream << (dotX + k) << " " << (dotY - dotRadius) << " " << (dotX + dotRadius) << " " << (dotY - k) << " "
-                       << (dotX + dotRadius) << " " << dotY << " c\n";
-                stream << "f\n";
-            }
-
-            if (line.drawTaskBox) {
-                const float boxSize = std::clamp(line.fontSize * 0.64f, 6.5f, 8.0f);
-                const float boxX = kLeft + line.markerIndent + 2.0f;
-                const float baselineOffset = std::clamp(line.fontSize * 0.16f, 1.5f, 2.2f);
-                const float boxY = y - baselineOffset;
-                stream << std::fixed << std::setprecision(3) << line.colorR << " " << line.colorG << " " << line.colorB << " RG\n";
-                stream << "1 w\n";
-                stream << boxX << " " << boxY << " " << boxSize << " " << boxSize << " re\n";
-                stream << "S\n";
-                if (line.taskChecked) {
-                    const float x1 = boxX + boxSize * 0.22f;
-                    const float y1 = boxY + boxSize * 0.48f;
-                    const float x2 = boxX + boxSize * 0.43f;
-                    const float y2 = boxY + boxSize * 0.22f;
-                    const float x3 = boxX + boxSize * 0.80f;
-                    const float y3 = boxY + boxSize * 0.86f;
-                    stream << x1 << " " << y1 << " m\n";
-                    stream << x2 << " " << y2 << " l\n";
-                    stream << x3 << " " << y3 << " l\n";
-                    stream << "S\n";
-                }
-            }
-
-            stream << "BT\n";
-            const char* fontTag = "/F1";
-            if (line.font == PdfFont::Bold) {
-                fontTag = "/F2";
-            } else if (line.font == PdfFont::Mono) {
-                fontTag = "/F3";
-            }
-            stream << std::fixed << std::setprecision(3) << line.colorR << " " << line.colorG << " " << line.colorB << " rg\n";
-            stream << fontTag << " " << std::fixed << std::setprecision(1) << line.fontSize << " Tf\n";
-            stream << "1 0 0 1 " << (kLeft + line.xOffset) << " " << y << " Tm\n";
-            stream << "(" << EscapePdfLiteralText(line.text) << ") Tj\n";
-            stream << "ET\n";
-        }
-        y -= lineHeight;
-    }
-    if (pageStreams.empty() || !stream.str().empty()) { flushPage(); }
-
-    std::vector<std::string> objects(6);
-    objects[1] = "<< /Type /Catalog /Pages 2 0 R >>";
-    objects[3] = "<< /Type /Font /Subtype /Type1 /BaseFont /Helvetica >>";
-    objects[4] = "<< /Type /Font /Subtype /Type1 /BaseFont /Helvetica-Bold >>";
-    objects[5] = "<< /Type /Font /Subtype /Type1 /BaseFont /Courier >>";
-
-    std::vector<int> pageObjectIds;
-    pageObjectIds.reserve(pageStreams.size());
-    for (const auto& streamData : pageStreams) {
-        const int contentObjId = static_cast<int>(objects.size());
-        objects.push_back("<< /Length " + std::to_string(streamData.size()) + " >>\nstream\n" + streamData + "endstream");
-
-        const int pageObjId = static_cast<int>(objects.size());
-        objects.push_back("<< /Type /Page /Parent 2 0 R /MediaBox [0 0 612 792] /Resources << /Font << /F1 3 0 R /F2 4 0 R /F3 5 0 R >> >> "
-                          "/Contents " +
-                          std::to_string(contentObjId) + " 0 R >>");
-        pageObjectIds.push_back(pageObjId);
-    }
-
-    std::ostringstream kids;
-    for (int pageObjId : pageObjectIds) {
-        kids << pageObjId << " 0 R ";
-    }
-    objects[2] = "<< /Type /Pages /Count " + std::to_string(pageObjectIds.size()) + " /Kids [ " + kids.str() + "] >>";
-
-    std::string pdf;
-    pdf.reserve(4096 + renderLines.size() * 120);
-    pdf += "%PDF-1.4\n%\xE2\xE3\xCF\xD3\n";
-
-    std::vector<size_t> offsets(objects.size(), 0);
-    for (size_t objId = 1; objId < objects.size(); ++objId) {
-        offsets[objId] = pdf.size();
-        pdf += std::to_string(objId) + " 0 obj\n";
-        pdf += objects[objId];
-        pdf += "\nendobj\n";
-    }
-
-    const size_t xrefOffset = pdf.size();
-    pdf += "xref\n0 " + std::to_string(objects.size()) + "\n";
-    pdf += "0000000000 65535 f \n";
-    for (size_t objId = 1; objId < objects.size(); ++objId) {
-        char lineBuf[32];
-        std::snprintf(lineBuf, sizeof(lineBuf), "%010zu 00000 n \n", offsets[objId]);
-        pdf += lineBuf;
-    }
-    pdf += "trailer\n<< /Size " + std::to_string(objects.size()) + " /Root 1 0 R >>\n";
-    pdf += "startxref\n" + std::to_string(xrefOffset) + "\n%%EOF\n";
-
-    return WriteBinaryFile(path, pdf);
-}
-
 void QueueGeneralSaveConflict(NotesOverlayState& st, const std::filesystem::path& target, const std::filesystem::path& currentPath,
                               const std::string& title, const std::string& draft) {
     st.pendingSaveConflictTargetPath = target;
@@ -1954,29 +1295,47 @@ bool FinalizePdfExportSuccess(NotesOverlayState& st, const std::filesystem::path
     return true;
 }
 
+uint64_t SubmitNotesPersist(NotesPersistRequest request) {
+    s_notesPersistInFlight.fetch_add(1, std::memory_order_acq_rel);
+    return EnqueueNotesPersist(std::move(request));
+}
+
 bool ExportDraftToPdf(NotesOverlayState& st, const std::string& preferredTitle, const std::string& markdownText, const char* sourceLabel) {
     if (!HasMeaningfulText(markdownText)) {
         SetStatus(st, std::string(sourceLabel) + " note is empty; nothing exported.");
         return false;
     }
 
-    EnsureNotesDirectories();
     std::string fileBase = SanitizeFileComponent(preferredTitle);
     if (fileBase.empty() || fileBase == "note") { fileBase = "note_" + CurrentDateStamp() + "_" + CurrentTimeStamp(); }
 
-    const std::filesystem::path folder = GetPdfExportRootPath();
-    std::filesystem::create_directories(folder);
-    const std::filesystem::path target = folder / Utf8ToWide(fileBase + ".pdf");
-    if (std::filesystem::exists(target)) {
-        QueuePdfSaveConflict(st, target, fileBase, markdownText);
-        return false;
-    }
+    // Rendering and writing happen on the persistence worker; an existing file comes back as a conflict
+    NotesPersistRequest request;
+    request.kind = NotesPersistKind::Pdf;
+    request.folder = GetPdfExportRootPath();
+    request.fileBase = fileBase;
+    request.extension = ".pdf";
+    request.onConflict = NotesConflictPolicy::Report;
+    request.title = fileBase;
+    request.pdfFonts = GetPdfExportFonts();
+    request.text = std::make_shared<const std::string>(markdownText);
+    SubmitNotesPersist(std::move(request));
+    SetStatus(st, "Exporting PDF...");
+    return true;
+}
 
-    if (!WriteSimpleMarkdownPdf(target, fileBase, markdownText)) {
+void FinishPdfExport(NotesOverlayState& st, const NotesPersistResult& result) {
+    switch (result.status) {
+    case NotesPersistStatus::Written:
+        FinalizePdfExportSuccess(st, result.writtenPath);
+        break;
+    case NotesPersistStatus::Conflict:
+        QueuePdfSaveConflict(st, result.conflictPath, result.request.title, result.request.text ? *result.request.text : std::string());
+        break;
+    case NotesPersistStatus::Failed:
         SetStatus(st, "Failed to export PDF.");
-        return false;
+        break;
     }
-    return FinalizePdfExportSuccess(st, target);
 }
 
 void RenderPreviewTitleBlock(const std::string& noteTitle) {
@@ -1988,107 +1347,171 @@ void RenderPreviewTitleBlock(const std::string& noteTitle) {
     ImGui::Spacing();
 }
 
-bool RenderMarkdownPreview(std::string& markdownText) {
-    const std::vector<MarkdownPreviewLine> lines = ParseMarkdownPreviewLines(markdownText);
-    size_t pendingToggleLine = std::numeric_limits<size_t>::max();
-    for (const auto& line : lines) {
-        switch (line.kind) {
-        case MarkdownLineKind::Blank:
-            ImGui::Spacing();
-            break;
-        case MarkdownLineKind::Rule:
-            ImGui::Separator();
-            break;
-        case MarkdownLineKind::Heading: {
-            const int level = std::clamp(line.headingLevel, 1, 6);
-            const ImU32 shades[] = { IM_COL32(236, 243, 255, 255), IM_COL32(220, 235, 255, 255), IM_COL32(200, 224, 255, 255),
-                                     IM_COL32(184, 212, 246, 255), IM_COL32(170, 198, 232, 255), IM_COL32(154, 188, 220, 255) };
-            const float scales[] = { 1.45f, 1.30f, 1.20f, 1.12f, 1.06f, 1.00f };
-            ImGui::SetWindowFontScale(scales[level - 1]);
-            ImGui::TextColored(ImGui::ColorConvertU32ToFloat4(shades[level - 1]), "%s", line.text.c_str());
-            ImGui::SetWindowFontScale(1.0f);
-            RenderMarkdownPreviewLinksInline(line);
-            if (level <= 2) ImGui::Spacing();
-            break;
-        }
-        case MarkdownLineKind::Quote:
-            ImGui::BeginGroup();
-            ImGui::Dummy(ImVec2(10.0f, 0.0f));
-            ImGui::SameLine(0.0f, 0.0f);
-            ImGui::PushStyleColor(ImGuiCol_Text, IM_COL32(180, 195, 212, 255));
-            ImGui::TextWrapped("%s", line.text.c_str());
-            ImGui::PopStyleColor();
-            ImGui::EndGroup();
-            {
-                ImDrawList* dl = ImGui::GetWindowDrawList();
-                if (dl) {
-                    const ImVec2 qMin = ImGui::GetItemRectMin();
-                    const ImVec2 qMax = ImGui::GetItemRectMax();
-                    dl->AddLine(ImVec2(qMin.x + 3.0f, qMin.y + 2.0f), ImVec2(qMin.x + 3.0f, qMax.y - 2.0f),
-                                IM_COL32(112, 148, 192, 255), 2.0f);
-                }
+constexpr float kMarkdownHeadingScales[] = { 1.45f, 1.30f, 1.20f, 1.12f, 1.06f, 1.00f };
+
+void RenderMarkdownPreviewLine(const MarkdownPreviewLine& line, size_t& pendingToggleLine) {
+    switch (line.kind) {
+    case MarkdownLineKind::Blank:
+        ImGui::Spacing();
+        break;
+    case MarkdownLineKind::Rule:
+        ImGui::Separator();
+        break;
+    case MarkdownLineKind::Heading: {
+        const int level = std::clamp(line.headingLevel, 1, 6);
+        const ImU32 shades[] = { IM_COL32(236, 243, 255, 255), IM_COL32(220, 235, 255, 255), IM_COL32(200, 224, 255, 255),
+                                 IM_COL32(184, 212, 246, 255), IM_COL32(170, 198, 232, 255), IM_COL32(154, 188, 220, 255) };
+        ImGui::SetWindowFontScale(kMarkdownHeadingScales[level - 1]);
+        ImGui::TextColored(ImGui::ColorConvertU32ToFloat4(shades[level - 1]), "%s", line.text.c_str());
+        ImGui::SetWindowFontScale(1.0f);
+        RenderMarkdownPreviewLinksInline(line);
+        if (level <= 2) ImGui::Spacing();
+        break;
+    }
+    case MarkdownLineKind::Quote:
+        ImGui::BeginGroup();
+        ImGui::Dummy(ImVec2(10.0f, 0.0f));
+        ImGui::SameLine(0.0f, 0.0f);
+        ImGui::PushStyleColor(ImGuiCol_Text, IM_COL32(180, 195, 212, 255));
+        ImGui::TextWrapped("%s", line.text.c_str());
+        ImGui::PopStyleColor();
+        ImGui::EndGroup();
+        {
+            ImDrawList* dl = ImGui::GetWindowDrawList();
+            if (dl) {
+                const ImVec2 qMin = ImGui::GetItemRectMin();
+                const ImVec2 qMax = ImGui::GetItemRectMax();
+                dl->AddLine(ImVec2(qMin.x + 3.0f, qMin.y + 2.0f), ImVec2(qMin.x + 3.0f, qMax.y - 2.0f),
+                            IM_COL32(112, 148, 192, 255), 2.0f);
             }
-            RenderMarkdownPreviewLinksInline(line);
-            break;
-        case MarkdownLineKind::Bullet:
-            ImGui::TextWrapped("%s%s", line.listPrefix.empty() ? GetRenderedBulletPrefix() : line.listPrefix.c_str(), line.text.c_str());
-            RenderMarkdownPreviewLinksInline(line);
-            break;
-        case MarkdownLineKind::Numbered:
-            ImGui::TextWrapped("%s%s", line.listPrefix.empty() ? "1. " : line.listPrefix.c_str(), line.text.c_str());
-            RenderMarkdownPreviewLinksInline(line);
-            break;
-        case MarkdownLineKind::Task: {
-            const ImU32 color = line.checked ? IM_COL32(120, 220, 145, 255) : IM_COL32(242, 200, 124, 255);
-            const float baseX = ImGui::GetCursorPosX();
-            const float spaceW = ImGui::CalcTextSize(" ").x;
-            const size_t indentCols = CountLeadingIndentColumns(line.listPrefix);
-            const float indentPx = static_cast<float>(indentCols) * spaceW;
-            const float boxSize = std::max(9.0f, ImGui::GetFontSize() * 0.78f);
-            const float lineH = ImGui::GetTextLineHeight();
-
-            ImGui::SetCursorPosX(baseX + indentPx);
-            ImGui::PushID(static_cast<int>(line.sourceLineIndex));
-            if (ImGui::InvisibleButton("##task_toggle", ImVec2(boxSize + 2.0f, lineH))) {
-                pendingToggleLine = line.sourceLineIndex;
+        }
+        RenderMarkdownPreviewLinksInline(line);
+        break;
+    case MarkdownLineKind::Bullet:
+        ImGui::TextWrapped("%s%s", line.listPrefix.empty() ? GetRenderedBulletPrefix() : line.listPrefix.c_str(), line.text.c_str());
+        RenderMarkdownPreviewLinksInline(line);
+        break;
+    case MarkdownLineKind::Numbered:
+        ImGui::TextWrapped("%s%s", line.listPrefix.empty() ? "1. " : line.listPrefix.c_str(), line.text.c_str());
+        RenderMarkdownPreviewLinksInline(line);
+        break;
+    case MarkdownLineKind::Task: {
+        const ImU32 color = line.checked ? IM_COL32(120, 220, 145, 255) : IM_COL32(242, 200, 124, 255);
+        const float baseX = ImGui::GetCursorPosX();
+        const float spaceW = ImGui::CalcTextSize(" ").x;
+        const size_t indentCols = CountLeadingIndentColumns(line.listPrefix);
+        const float indentPx = static_cast<float>(indentCols) * spaceW;
+        const float boxSize = std::max(9.0f, ImGui::GetFontSize() * 0.78f);
+        const float lineH = ImGui::GetTextLineHeight();
+
+        ImGui::SetCursorPosX(baseX + indentPx);
+        ImGui::PushID(static_cast<int>(line.sourceLineIndex));
+        if (ImGui::InvisibleButton("##task_toggle", ImVec2(boxSize + 2.0f, lineH))) {
+            pendingToggleLine = line.sourceLineIndex;
+        }
+        const bool hovered = ImGui::IsItemHovered();
+        const ImVec2 itemMin = ImGui::GetItemRectMin();
+        const float boxY = itemMin.y + (lineH - boxSize) * 0.5f;
+
+        if (ImDrawList* dl = ImGui::GetWindowDrawList()) {
+            const ImVec2 b0(itemMin.x, boxY);
+            const ImVec2 b1(itemMin.x + boxSize, boxY + boxSize);
+            dl->AddRect(b0, b1, color, 2.0f, 0, hovered ? 1.8f : 1.2f);
+            if (line.checked) {
+                const ImVec2 c1(b0.x + boxSize * 0.20f, b0.y + boxSize * 0.56f);
+                const ImVec2 c2(b0.x + boxSize * 0.44f, b0.y + boxSize * 0.78f);
+                const ImVec2 c3(b0.x + boxSize * 0.82f, b0.y + boxSize * 0.24f);
+                dl->AddLine(c1, c2, color, 1.5f);
+                dl->AddLine(c2, c3, color, 1.5f);
             }
-            const bool hovered = ImGui::IsItemHovered();
-            const ImVec2 itemMin = ImGui::GetItemRectMin();
-            const float boxY = itemMin.y + (lineH - boxSize) * 0.5f;
+        }
 
-            if (ImDrawList* dl = ImGui::GetWindowDrawList()) {
-                const ImVec2 b0(itemMin.x, boxY);
-                const ImVec2 b1(itemMin.x + boxSize, boxY + boxSize);
-                dl->AddRect(b0, b1, color, 2.0f, 0, hovered ? 1.8f : 1.2f);
-                if (line.checked) {
-                    const ImVec2 c1(b0.x + boxSize * 0.20f, b0.y + boxSize * 0.56f);
-                    const ImVec2 c2(b0.x + boxSize * 0.44f, b0.y + boxSize * 0.78f);
-                    const ImVec2 c3(b0.x + boxSize * 0.82f, b0.y + boxSize * 0.24f);
-                    dl->AddLine(c1, c2, color, 1.5f);
-                    dl->AddLine(c2, c3, color, 1.5f);
-                }
-            }
+        ImGui::SameLine(0.0f, 6.0f);
+        ImGui::PushStyleColor(ImGuiCol_Text, color);
+        ImGui::TextWrapped("%s", line.text.c_str());
+        ImGui::PopStyleColor();
+        ImGui::PopID();
+        RenderMarkdownPreviewLinksInline(line);
+        break;
+    }
+    case MarkdownLineKind::Code:
+        ImGui::PushStyleColor(ImGuiCol_Text, IM_COL32(150, 210, 255, 255));
+        ImGui::TextUnformatted(line.text.c_str());
+        ImGui::PopStyleColor();
+        break;
+    case MarkdownLineKind::Body:
+    default:
+        ImGui::TextWrapped("%s", line.text.c_str());
+        RenderMarkdownPreviewLinksInline(line);
+        break;
+    }
+}
 
-            ImGui::SameLine(0.0f, 6.0f);
-            ImGui::PushStyleColor(ImGuiCol_Text, color);
-            ImGui::TextWrapped("%s", line.text.c_str());
-            ImGui::PopStyleColor();
-            ImGui::PopID();
-            RenderMarkdownPreviewLinksInline(line);
-            break;
+// Height of a line that hasn't been drawn at the current wrap width yet. Only used to place off-screen lines; it is
+// replaced by the measured height as soon as the line is drawn.
+float EstimateMarkdownPreviewLineHeight(const MarkdownPreviewLine& line, float wrapWidth) {
+    const float spacing = ImGui::GetStyle().ItemSpacing.y;
+    const float lineHeight = ImGui::GetTextLineHeight();
+    switch (line.kind) {
+    case MarkdownLineKind::Blank:
+    case MarkdownLineKind::Rule:
+        return spacing;
+    case MarkdownLineKind::Heading: {
+        const int level = std::clamp(line.headingLevel, 1, 6);
+        return lineHeight * kMarkdownHeadingScales[level - 1] + spacing * (level <= 2 ? 2.0f : 1.0f);
+    }
+    case MarkdownLineKind::Code:
+        return lineHeight + spacing;
+    default: {
+        const float prefixWidth = line.listPrefix.empty() ? 0.0f : ImGui::CalcTextSize(line.listPrefix.c_str()).x;
+        const float textWidth = std::max(wrapWidth - prefixWidth, 1.0f);
+        const float textHeight = ImGui::CalcTextSize(line.text.c_str(), nullptr, false, textWidth).y;
+        return std::max(textHeight, lineHeight) + spacing;
+    }
+    }
+}
+
+// Draws the preview from the incrementally parsed document. Only lines overlapping the visible part of the child
+// window are submitted; the others are stepped over using their cached heights, so a 10k-line note costs about the
+// same per frame as a short one.
+bool RenderMarkdownPreview(std::string& markdownText, MarkdownDocument& document) {
+    document.Update(markdownText);
+
+    const float wrapWidth = ImGui::GetContentRegionAvail().x;
+    const float fontSize = ImGui::GetFontSize();
+    const float visibleTop = ImGui::GetScrollY();
+    const float visibleBottom = visibleTop + ImGui::GetWindowHeight();
+    float y = ImGui::GetCursorPosY();
+    bool cursorAtY = true;
+
+    size_t pendingToggleLine = std::numeric_limits<size_t>::max();
+    for (MarkdownPreviewLine& line : document.Lines()) {
+        if (line.layoutWrapWidth != wrapWidth || line.layoutFontSize != fontSize) {
+            line.layoutHeight = EstimateMarkdownPreviewLineHeight(line, wrapWidth);
+            line.layoutWrapWidth = wrapWidth;
+            line.layoutFontSize = fontSize;
+        }
+        if (y + line.layoutHeight < visibleTop || y > visibleBottom) {
+            y += line.layoutHeight;
+            cursorAtY = false;
+            continue;
         }
-        case MarkdownLineKind::Code:
-            ImGui::PushStyleColor(ImGuiCol_Text, IM_COL32(150, 210, 255, 255));
-            ImGui::TextUnformatted(line.text.c_str());
-            ImGui::PopStyleColor();
-            break;
-        case MarkdownLineKind::Body:
-        default:
-            ImGui::TextWrapped("%s", line.text.c_str());
-            RenderMarkdownPreviewLinksInline(line);
-            break;
+
+        if (!cursorAtY) {
+            ImGui::SetCursorPosY(y);
+            cursorAtY = true;
         }
+        RenderMarkdownPreviewLine(line, pendingToggleLine);
+        const float next = ImGui::GetCursorPosY();
+        line.layoutHeight = next - y;
+        y = next;
+    }
+    if (!cursorAtY) {
+        // Extend the scroll range over the skipped tail
+        ImGui::SetCursorPosY(y);
+        ImGui::Dummy(ImVec2(0.0f, 0.0f));
     }
+
     if (pendingToggleLine != std::numeric_limits<size_t>::max()) {
         return ToggleMarkdownTaskLineByIndex(markdownText, pendingToggleLine);
     }
@@ -2137,19 +1560,12 @@ void SortEntries(std::vector<NotesFileEntry>& entries, NotesSortMode mode) {
     });
 }
 
-void ApplyPinnedFlagsAndLabels(std::vector<NotesFileEntry>& entries, const NotesOverlayState& st, bool showRelativeFolder,
-                               const std::filesystem::path& relativeRoot) {
+void ApplyPinnedFlagsAndLabels(std::vector<NotesFileEntry>& entries, const NotesOverlayState& st, bool showRelativeFolder) {
     for (auto& item : entries) {
         item.pinned = IsPathPinned(st, item.path);
         item.favorite = IsPathFavorited(st, item.path);
         item.displayLabel = item.title;
-        if (showRelativeFolder) {
-            try {
-                const std::filesystem::path rel = std::filesystem::relative(item.path.parent_path(), relativeRoot);
-                const std::wstring relW = rel.lexically_normal().wstring();
-                if (!relW.empty() && relW != L"." && relW != L"..") { item.displayLabel += "  [" + WideToUtf8(relW) + "]"; }
-            } catch (...) {}
-        }
+        if (showRelativeFolder && !item.folder.empty()) { item.displayLabel += "  [" + item.folder + "]"; }
         const std::string stamp = FormatEpochForList(item.modifiedEpochSeconds);
         if (!stamp.empty()) { item.displayLabel += "  [" + stamp + "]"; }
     }
@@ -2163,8 +1579,8 @@ bool ShouldSkipGeneralFolder(const std::string& nameLower) {
     return false;
 }
 
-void ReloadGeneralFolders(NotesOverlayState& st) {
-    EnsureNotesDirectories();
+void ReloadGeneralFolders(NotesOverlayState& st, const NotesCatalog* catalog) {
+    if (!catalog && !st.generalFolders.empty()) return; // Keep the current tabs until the index has scanned the root
     const std::string prevSelection =
         (st.selectedGeneralFolderIndex >= 0 && st.selectedGeneralFolderIndex < static_cast<int>(st.generalFolders.size()))
             ? st.generalFolders[static_cast<size_t>(st.selectedGeneralFolderIndex)]
@@ -2174,18 +1590,12 @@ void ReloadGeneralFolders(NotesOverlayState& st) {
     st.generalFolders.push_back(kGeneralFolderRoot);
     st.generalFolders.push_back(kGeneralFolderFavorites);
 
-    const std::filesystem::path root = GetGeneralNotesRootPath();
-    try {
-        for (const auto& entry : std::filesystem::directory_iterator(root)) {
-            if (!entry.is_directory()) continue;
-            std::filesystem::path rel = entry.path().filename();
-            if (rel.empty()) continue;
-            const std::string folderName = WideToUtf8(rel.wstring());
-            const std::string folderNameLower = ToLowerAscii(folderName);
-            if (ShouldSkipGeneralFolder(folderNameLower)) continue;
+    if (catalog) {
+        for (const std::string& folderName : catalog->folders) {
+            if (ShouldSkipGeneralFolder(ToLowerAscii(folderName))) continue;
             st.generalFolders.push_back(folderName);
         }
-    } catch (...) {}
+    }
 
     std::sort(st.generalFolders.begin() + 2, st.generalFolders.end(), [](const std::string& a, const std::string& b) {
         return ToLowerAscii(a) < ToLowerAscii(b);
@@ -2211,95 +1621,75 @@ std::filesystem::path ResolveGeneralFolderPath(const NotesOverlayState& st) {
     return root / Utf8ToWide(rel);
 }
 
-bool ShouldSkipNotesFile(const std::filesystem::path& path) {
-    const std::string filenameLower = ToLowerAscii(path.filename().string());
-    if (filenameLower.empty()) return true;
-    if (filenameLower[0] == '.') return true;
-    if (filenameLower.rfind(".toolscreen_", 0) == 0) return true;
-    return false;
-}
-
-std::vector<NotesFileEntry> LoadNotesInDirectory(const std::filesystem::path& folderPath, bool recursive) {
+// Notes from the catalog whose folder satisfies `match` (given the lowercased relative folder)
+template <typename FolderMatch> std::vector<NotesFileEntry> CollectCatalogNotes(const NotesCatalog* catalog, FolderMatch&& match) {
     std::vector<NotesFileEntry> entries;
-    auto consume = [&](const std::filesystem::directory_entry& entry) {
-        if (!entry.is_regular_file()) return;
-        if (ShouldSkipNotesFile(entry.path())) return;
-        const std::string ext = ToLowerAscii(entry.path().extension().string());
-        if (!ext.empty() && ext != ".md" && ext != ".txt" && ext != ".log") return;
-
+    if (!catalog) return entries;
+    for (const NotesCatalogEntry& source : catalog->entries) {
+        if (!match(ToLowerAscii(source.folder))) continue;
         NotesFileEntry item;
-        item.path = entry.path();
-        item.title = WideToUtf8(item.path.stem().wstring());
+        item.path = source.path;
+        item.folder = source.folder;
+        item.title = source.title;
         item.numberKey = ExtractFirstNumberKey(item.title);
-        try {
-            item.modifiedEpochSeconds = ToEpochSeconds(std::filesystem::last_write_time(item.path));
-        } catch (...) {
-            item.modifiedEpochSeconds = 0;
-        }
+        item.modifiedEpochSeconds = source.modifiedEpochSeconds;
         entries.push_back(std::move(item));
-    };
-
-    try {
-        if (recursive) {
-            for (const auto& entry : std::filesystem::recursive_directory_iterator(folderPath)) {
-                consume(entry);
-            }
-        } else {
-            for (const auto& entry : std::filesystem::directory_iterator(folderPath)) {
-                consume(entry);
-            }
-        }
-    } catch (...) {}
+    }
     return entries;
 }
 
+int FindEntryIndexByPathKey(const std::vector<NotesFileEntry>& entries, const std::wstring& key) {
+    if (key.empty()) return -1;
+    for (int i = 0; i < static_cast<int>(entries.size()); ++i) {
+        if (NormalizePathKey(entries[static_cast<size_t>(i)].path) == key) return i;
+    }
+    return -1;
+}
+
+// Rebuilds the lists from the latest catalog snapshot; no disk I/O
 void ReloadListings(NotesOverlayState& st) {
-    std::filesystem::path selectedGeneralPath;
+    // Keep the selection by path; a note that was just saved keeps its highlight once the catalog lists it
+    std::filesystem::path selectedGeneralPath = st.generalEditingPath;
     if (st.selectedGeneralEntryIndex >= 0 && st.selectedGeneralEntryIndex < static_cast<int>(st.generalEntries.size())) {
         selectedGeneralPath = st.generalEntries[static_cast<size_t>(st.selectedGeneralEntryIndex)].path;
     }
-    std::filesystem::path selectedIgnPath;
+    std::filesystem::path selectedIgnPath = st.ignEditingPath;
     if (st.selectedIgnEntryIndex >= 0 && st.selectedIgnEntryIndex < static_cast<int>(st.ignEntries.size())) {
         selectedIgnPath = st.ignEntries[static_cast<size_t>(st.selectedIgnEntryIndex)].path;
     }
 
-    ReloadGeneralFolders(st);
-    LoadPinnedMetadata(st);
-    LoadFavoriteMetadata(st);
+    st.catalog = GetNotesCatalogSnapshot();
+    const NotesCatalog* catalog = (st.catalog && st.catalog->root == GetMarkdownNotesRootPath()) ? st.catalog.get() : nullptr;
+
+    ReloadGeneralFolders(st, catalog);
+    if (catalog) { LoadPinAndFavoriteMetadata(st, *catalog); }
 
-    const std::filesystem::path generalFolder = ResolveGeneralFolderPath(st);
     const bool favoritesMode =
         st.selectedGeneralFolderIndex >= 0 && st.selectedGeneralFolderIndex < static_cast<int>(st.generalFolders.size()) &&
         IsGeneralFavoritesFolderKey(st.generalFolders[static_cast<size_t>(st.selectedGeneralFolderIndex)]);
     if (favoritesMode) {
-        st.generalEntries = LoadNotesInDirectory(GetGeneralNotesRootPath(), true);
+        st.generalEntries = CollectCatalogNotes(catalog, [](const std::string&) { return true; });
         st.generalEntries.erase(std::remove_if(st.generalEntries.begin(), st.generalEntries.end(),
                                                [&](const NotesFileEntry& item) { return !IsPathFavorited(st, item.path); }),
                                 st.generalEntries.end());
     } else {
-        st.generalEntries = LoadNotesInDirectory(generalFolder, false);
-    }
-    ApplyPinnedFlagsAndLabels(st.generalEntries, st, favoritesMode, GetGeneralNotesRootPath());
+        // A general folder lists its direct children only
+        const std::string folderLower =
+            (st.selectedGeneralFolderIndex >= 0 && st.selectedGeneralFolderIndex < static_cast<int>(st.generalFolders.size()))
+                ? ToLowerAscii(st.generalFolders[static_cast<size_t>(st.selectedGeneralFolderIndex)])
+                : std::string();
+        st.generalEntries = CollectCatalogNotes(catalog, [&](const std::string& itemFolderLower) { return itemFolderLower == folderLower; });
+    }
+    ApplyPinnedFlagsAndLabels(st.generalEntries, st, favoritesMode);
     SortEntries(st.generalEntries, static_cast<NotesSortMode>(std::clamp(st.generalSortMode, 0, 5)));
-    st.selectedGeneralEntryIndex = -1;
-    for (int i = 0; i < static_cast<int>(st.generalEntries.size()); ++i) {
-        if (PathsEquivalentLoose(st.generalEntries[static_cast<size_t>(i)].path, selectedGeneralPath)) {
-            st.selectedGeneralEntryIndex = i;
-            break;
-        }
-    }
+    st.selectedGeneralEntryIndex = FindEntryIndexByPathKey(st.generalEntries, NormalizePathKey(selectedGeneralPath));
 
-    const std::filesystem::path ignRoot = GetIgnNotesRootPath();
-    st.ignEntries = LoadNotesInDirectory(ignRoot, true);
-    ApplyPinnedFlagsAndLabels(st.ignEntries, st, false, ignRoot);
+    st.ignEntries = CollectCatalogNotes(catalog, [](const std::string& itemFolderLower) {
+        return itemFolderLower == "ign" || itemFolderLower.rfind("ign/", 0) == 0;
+    });
+    ApplyPinnedFlagsAndLabels(st.ignEntries, st, false);
     SortEntries(st.ignEntries, static_cast<NotesSortMode>(std::clamp(st.ignSortMode, 0, 5)));
-    st.selectedIgnEntryIndex = -1;
-    for (int i = 0; i < static_cast<int>(st.ignEntries.size()); ++i) {
-        if (PathsEquivalentLoose(st.ignEntries[static_cast<size_t>(i)].path, selectedIgnPath)) {
-            st.selectedIgnEntryIndex = i;
-            break;
-        }
-    }
+    st.selectedIgnEntryIndex = FindEntryIndexByPathKey(st.ignEntries, NormalizePathKey(selectedIgnPath));
 
     st.refreshRequested = false;
 }
@@ -2310,6 +1700,7 @@ bool SaveIgnDraft(NotesOverlayState& st, bool inWorldNow, bool clearDraftAfterSa
         if (clearDraftAfterSave) {
             st.ignEditedSinceOpen = false;
             st.ignDraft.clear();
+            ++st.ignDraftGeneration;
         }
         return false;
     }
@@ -2318,50 +1709,61 @@ bool SaveIgnDraft(NotesOverlayState& st, bool inWorldNow, bool clearDraftAfterSa
         if (!silent) SetStatus(st, "IGN save blocked (not in game).");
         return false;
     }
+    if (st.ignSave.ticket != 0) return false;
 
-    std::filesystem::path target;
-    bool updatingExisting = false;
-    if (!st.ignEditingPath.empty()) {
-        target = st.ignEditingPath;
-        updatingExisting = true;
-    } else {
-        std::string filenameBase = CurrentDateStamp() + "_" + CurrentTimeStamp() + "_ign";
-        filenameBase = SanitizeFileComponent(filenameBase);
-        std::filesystem::path folder = GetIgnNotesRootPath();
-        std::filesystem::create_directories(folder);
-        target = BuildUniqueFilePath(folder, filenameBase, ".md");
+    const bool updatingExisting = !st.ignEditingPath.empty();
+    NotesPersistRequest request;
+    request.currentPath = st.ignEditingPath;
+    if (!updatingExisting) {
+        request.folder = GetIgnNotesRootPath();
+        request.fileBase = SanitizeFileComponent(CurrentDateStamp() + "_" + CurrentTimeStamp() + "_ign");
     }
+    request.text = std::make_shared<const std::string>(st.ignDraft);
 
-    if (!WriteUtf8TextFile(target, st.ignDraft)) {
-        if (!silent) SetStatus(st, "Failed to save IGN note.");
-        return false;
-    }
-
-    st.ignEditingPath = target;
-    st.refreshRequested = true;
+    st.ignSave.ticket = SubmitNotesPersist(std::move(request));
+    st.ignSave.editingPathAtStart = st.ignEditingPath;
+    st.ignSave.draftClosed = clearDraftAfterSave;
+    st.ignSave.statusVerb = silent ? "" : (updatingExisting ? "Updated" : "Saved");
     st.ignEditedSinceOpen = false;
-    if (!silent) SetStatus(st, std::string(updatingExisting ? "Updated: " : "Saved: ") + PathForDisplay(target));
     st.ignDraftDirty = false;
 
-    if (clearDraftAfterSave) { st.ignDraft.clear(); }
+    if (clearDraftAfterSave) {
+        st.ignDraft.clear();
+        ++st.ignDraftGeneration;
+    }
+    // A closing save belongs to the empty draft that follows it: its text comes back only if nothing replaced that
+    st.ignSave.draftGeneration = st.ignDraftGeneration;
     return true;
 }
 
-bool SaveGeneralToResolvedPath(NotesOverlayState& st, const std::filesystem::path& target, const std::string& title, const std::string& draft,
-                               const char* statusVerb, bool silent) {
-    if (!WriteUtf8TextFile(target, draft)) {
-        if (!silent) SetStatus(st, "Failed to save general note.");
-        return false;
+void BeginGeneralSave(NotesOverlayState& st, NotesPersistRequest request, const char* statusVerb) {
+    st.generalSave.ticket = SubmitNotesPersist(std::move(request));
+    st.generalSave.editingPathAtStart = st.generalEditingPath;
+    st.generalSave.draftClosed = false;
+    st.generalSave.draftGeneration = st.generalDraftGeneration;
+    st.generalSave.statusVerb = statusVerb;
+    st.generalDraftDirty = false;
+}
+
+void FinishGeneralSave(NotesOverlayState& st, const NotesPersistResult& result) {
+    const NotesSaveSlot slot = std::move(st.generalSave);
+    st.generalSave = NotesSaveSlot();
+    const bool stillOpen = st.generalDraftGeneration == slot.draftGeneration;
+
+    if (result.status != NotesPersistStatus::Written) {
+        if (!slot.statusVerb.empty()) SetStatus(st, "Failed to save general note.");
+        if (stillOpen) { MarkGeneralDraftDirty(st); } // Retry after the autosave delay
+        return;
     }
 
-    st.generalEditingPath = target;
-    st.generalTitle = title;
-    st.generalDraft = draft;
-    st.selectedGeneralEntryIndex = -1;
     st.refreshRequested = true;
-    if (!silent && statusVerb && *statusVerb) { SetStatus(st, std::string(statusVerb) + ": " + PathForDisplay(target)); }
-    st.generalDraftDirty = false;
-    return true;
+    if (stillOpen) {
+        st.generalEditingPath = result.writtenPath;
+        st.selectedGeneralEntryIndex = -1;
+        // The worker may have picked name_N; follow it unless the title was edited meanwhile
+        if (!st.generalDraftDirty) { st.generalTitle = GuessTitleFromPath(result.writtenPath); }
+    }
+    if (!slot.statusVerb.empty()) { SetStatus(st, slot.statusVerb + ": " + PathForDisplay(result.writtenPath)); }
 }
 
 void ClearPendingSaveConflict(NotesOverlayState& st) {
@@ -2379,6 +1781,16 @@ void SaveIgnDraftOnCloseIfNeeded(NotesOverlayState& st, bool inWorldNow) {
         st.ignDraft.clear();
         st.ignEditingPath.clear();
         st.selectedIgnEntryIndex = -1;
+        ++st.ignDraftGeneration;
+        // An autosave still in flight becomes the closing save: it must not reattach to the next draft
+        st.ignSave.draftClosed = true;
+        st.ignSave.draftGeneration = st.ignDraftGeneration;
+        return;
+    }
+
+    if (st.ignSave.ticket != 0) {
+        // Let the in-flight autosave land first so the close save targets the file it created
+        st.ignCloseSaveDeferred = true;
         return;
     }
 
@@ -2388,7 +1800,38 @@ void SaveIgnDraftOnCloseIfNeeded(NotesOverlayState& st, bool inWorldNow) {
     }
 }
 
+void FinishIgnSave(NotesOverlayState& st, const NotesPersistResult& result, bool inWorldNow) {
+    const NotesSaveSlot slot = std::move(st.ignSave);
+    st.ignSave = NotesSaveSlot();
+    const bool stillOpen = st.ignDraftGeneration == slot.draftGeneration;
+
+    if (result.status == NotesPersistStatus::Written) {
+        st.refreshRequested = true;
+        if (!slot.draftClosed && stillOpen) { st.ignEditingPath = result.writtenPath; }
+        if (!slot.statusVerb.empty()) { SetStatus(st, slot.statusVerb + ": " + PathForDisplay(result.writtenPath)); }
+    } else {
+        if (!slot.statusVerb.empty()) SetStatus(st, "Failed to save IGN note.");
+        if (slot.draftClosed) {
+            // Bring back the text the closed draft failed to write, unless another note was opened or typed since
+            if (stillOpen && !HasMeaningfulText(st.ignDraft) && result.request.text) {
+                st.ignDraft = *result.request.text;
+                st.ignEditingPath = result.request.currentPath;
+                MarkIgnDraftDirty(st);
+            }
+        } else if (stillOpen) {
+            MarkIgnDraftDirty(st);
+        }
+    }
+
+    if (st.ignCloseSaveDeferred) {
+        st.ignCloseSaveDeferred = false;
+        SaveIgnDraftOnCloseIfNeeded(st, inWorldNow);
+    }
+}
+
 bool SaveGeneralDraft(NotesOverlayState& st, bool silent) {
+    if (st.generalSave.ticket != 0) return false;
+
     const bool creatingNewFile = st.generalEditingPath.empty();
     std::string titleFromMarkdown = SanitizeFileComponent(ExtractMarkdownTitle(st.generalDraft));
     std::string titleFromInput = SanitizeFileComponent(st.generalTitle);
@@ -2399,41 +1842,20 @@ bool SaveGeneralDraft(NotesOverlayState& st, bool silent) {
         IsGeneralFavoritesFolderKey(st.generalFolders[static_cast<size_t>(st.selectedGeneralFolderIndex)])) {
         folder = GetGeneralNotesRootPath();
     }
-    if (title.empty() || title == "note") { title = BuildNextUntitledTitle(folder); }
+    if (title.empty() || title == "note") { title = BuildNextUntitledTitle(st, folder); }
     st.generalTitle = title;
     UpsertMarkdownTitle(st.generalDraft, title);
     if (creatingNewFile) { EnsureRuleUnderTopHeading(st.generalDraft); }
 
-    std::filesystem::path target;
-    if (!st.generalEditingPath.empty()) {
-        target = st.generalEditingPath.parent_path() / Utf8ToWide(title + ".md");
-        if (!PathsEquivalentLoose(st.generalEditingPath, target)) {
-            if (std::filesystem::exists(target)) {
-                target = BuildUniqueFilePath(target.parent_path(), title, ".md");
-            }
-            try {
-                std::filesystem::create_directories(target.parent_path());
-                std::filesystem::rename(st.generalEditingPath, target);
-                st.generalEditingPath = target;
-            } catch (...) {
-                if (!silent) SetStatus(st, "Failed to rename current note.");
-                try {
-                    if (!WriteUtf8TextFile(target, st.generalDraft)) return false;
-                    std::filesystem::remove(st.generalEditingPath);
-                    st.generalEditingPath = target;
-                } catch (...) { return false; }
-            }
-        }
-    } else {
-        std::filesystem::create_directories(folder);
-        target = folder / Utf8ToWide(title + ".md");
-        if (std::filesystem::exists(target)) {
-            target = BuildUniqueFilePath(folder, title, ".md");
-        }
-        st.generalEditingPath = target;
-    }
-
-    return SaveGeneralToResolvedPath(st, target, title, st.generalDraft, "Saved", silent);
+    // A changed title renames the current file on the worker (name_N if the new name is taken)
+    NotesPersistRequest request;
+    request.currentPath = st.generalEditingPath;
+    request.folder = folder;
+    request.fileBase = title;
+    request.onConflict = NotesConflictPolicy::Uniquify;
+    request.text = std::make_shared<const std::string>(st.generalDraft);
+    BeginGeneralSave(st, std::move(request), silent ? "" : "Saved");
+    return true;
 }
 
 bool RenameGeneralCurrentNote(NotesOverlayState& st) {
@@ -2441,6 +1863,10 @@ bool RenameGeneralCurrentNote(NotesOverlayState& st) {
         SetStatus(st, "No loaded note to rename.");
         return false;
     }
+    if (st.generalSave.ticket != 0) {
+        SetStatus(st, "Saving; try renaming again in a moment.");
+        return false;
+    }
     std::string title = SanitizeFileComponent(st.generalTitle);
     if (title.empty() || title == "note") {
         SetStatus(st, "Enter a note title first.");
@@ -2471,6 +1897,13 @@ bool RenameGeneralCurrentNote(NotesOverlayState& st) {
 }
 
 bool DeleteNoteFile(NotesOverlayState& st, const std::filesystem::path& path, bool isIgn) {
+    // A save still in flight for this note would recreate the file
+    const NotesSaveSlot& pendingSave = isIgn ? st.ignSave : st.generalSave;
+    if (pendingSave.ticket != 0 && !pendingSave.editingPathAtStart.empty() && PathsEquivalentLoose(pendingSave.editingPathAtStart, path)) {
+        SetStatus(st, "Saving; try deleting again in a moment.");
+        return false;
+    }
+
     bool noteMissing = false;
     try {
         if (!std::filesystem::exists(path)) {
@@ -2498,6 +1931,7 @@ bool DeleteNoteFile(NotesOverlayState& st, const std::filesystem::path& path, bo
             if (PathsEquivalentLoose(selected, path)) {
                 st.selectedIgnEntryIndex = -1;
                 st.ignDraft.clear();
+                ++st.ignDraftGeneration;
                 st.ignEditedSinceOpen = false;
                 st.ignDraftDirty = false;
                 st.ignLastEdit = std::chrono::steady_clock::time_point::min();
@@ -2505,6 +1939,7 @@ bool DeleteNoteFile(NotesOverlayState& st, const std::filesystem::path& path, bo
         }
         if (!st.ignEditingPath.empty() && PathsEquivalentLoose(st.ignEditingPath, path)) {
             st.ignEditingPath.clear();
+            ++st.ignDraftGeneration;
             st.ignDraft.clear();
             st.ignEditedSinceOpen = false;
             st.ignDraftDirty = false;
@@ -2517,6 +1952,7 @@ bool DeleteNoteFile(NotesOverlayState& st, const std::filesystem::path& path, bo
         }
         if (!st.generalEditingPath.empty() && PathsEquivalentLoose(st.generalEditingPath, path)) {
             st.generalEditingPath.clear();
+            ++st.generalDraftGeneration;
             st.generalTitle.clear();
             st.generalDraft.clear();
             st.generalDraftDirty = false;
@@ -2582,6 +2018,7 @@ void RenderIgnTab(NotesOverlayState& st, bool inWorldNow) {
         st.ignDraftDirty = false;
         st.selectedIgnEntryIndex = -1;
         st.ignEditingPath.clear();
+        ++st.ignDraftGeneration;
     }
     ImGui::SameLine();
     const bool canDeleteIgn = st.selectedIgnEntryIndex >= 0 && st.selectedIgnEntryIndex < static_cast<int>(st.ignEntries.size());
@@ -2648,6 +2085,7 @@ void RenderIgnTab(NotesOverlayState& st, bool inWorldNow) {
                     st.ignDraftDirty = false;
                     st.selectedIgnEntryIndex = i;
                     st.ignEditingPath = entry.path;
+                    ++st.ignDraftGeneration;
                     SetStatus(st, "Loaded IGN note.");
                     st.focusIgnEditorNextFrame = true;
                 } else {
@@ -2685,7 +2123,7 @@ void RenderIgnTab(NotesOverlayState& st, bool inWorldNow) {
             st.ignEditorTab = 1;
             ImGui::BeginChild("##ign_preview", ImVec2(0.0f, -ImGui::GetFrameHeightWithSpacing() * 2.2f), false,
                               ImGuiWindowFlags_HorizontalScrollbar);
-            if (RenderMarkdownPreview(st.ignDraft)) { MarkIgnDraftDirty(st); }
+            if (RenderMarkdownPreview(st.ignDraft, st.ignPreview)) { MarkIgnDraftDirty(st); }
             ImGui::EndChild();
             ImGui::EndTabItem();
         }
@@ -2695,6 +2133,53 @@ void RenderIgnTab(NotesOverlayState& st, bool inWorldNow) {
     ImGui::EndChild();
 }
 
+bool LoadGeneralNoteIntoEditor(NotesOverlayState& st, const std::filesystem::path& path, const std::string& fallbackTitle) {
+    std::string loaded;
+    if (!ReadUtf8TextFile(path, loaded)) {
+        SetStatus(st, "Failed to read note.");
+        return false;
+    }
+    st.generalDraft = loaded;
+    st.generalTitle = ExtractMarkdownTitle(st.generalDraft);
+    if (!HasMeaningfulText(st.generalTitle)) st.generalTitle = fallbackTitle;
+    st.generalEditingPath = path;
+    ++st.generalDraftGeneration;
+    st.generalDraftDirty = false;
+    SetStatus(st, "Loaded note.");
+    st.focusGeneralEditorNextFrame = true;
+    return true;
+}
+
+// Search results replace the note list while the query is non-empty. Recomputed only when the query or the
+// catalog changes; the index lives in memory, so this never waits on disk.
+void RenderGeneralSearchResults(NotesOverlayState& st) {
+    constexpr size_t kMaxSearchResults = 100;
+    if (st.searchQuery != st.searchResultsQuery || st.catalog != st.searchResultsCatalog) {
+        st.searchResults = SearchNotes(st.searchQuery, kMaxSearchResults);
+        st.searchResultsQuery = st.searchQuery;
+        st.searchResultsCatalog = st.catalog;
+    }
+
+    if (st.searchResults.empty()) {
+        ImGui::TextDisabled("No matching notes.");
+        return;
+    }
+
+    const std::wstring editingKey = st.generalEditingPath.empty() ? std::wstring() : NormalizePathKey(st.generalEditingPath);
+    for (int i = 0; i < static_cast<int>(st.searchResults.size()); ++i) {
+        const NotesSearchResult& result = st.searchResults[static_cast<size_t>(i)];
+        std::string label = result.title;
+        if (!result.folder.empty()) { label += "  [" + result.folder + "]"; }
+        const bool selected = !editingKey.empty() && NormalizePathKey(result.path) == editingKey;
+
+        ImGui::PushID(i);
+        if (ImGui::Selectable(label.c_str(), selected) && LoadGeneralNoteIntoEditor(st, result.path, result.title)) {
+            st.selectedGeneralEntryIndex = FindEntryIndexByPathKey(st.generalEntries, NormalizePathKey(result.path));
+        }
+        ImGui::PopID();
+    }
+}
+
 void RenderGeneralTab(NotesOverlayState& st, float panelScale) {
     const int folderCount = static_cast<int>(st.generalFolders.size());
     if (folderCount > 0) {
@@ -2729,6 +2214,7 @@ void RenderGeneralTab(NotesOverlayState& st, float panelScale) {
             st.selectedGeneralFolderIndex = nextFolderIndex;
             st.selectedGeneralEntryIndex = -1;
             st.generalEditingPath.clear();
+            ++st.generalDraftGeneration;
             st.refreshRequested = true;
         }
     }
@@ -2759,6 +2245,7 @@ void RenderGeneralTab(NotesOverlayState& st, float panelScale) {
                 st.selectedGeneralFolderIndex = i;
                 st.selectedGeneralEntryIndex = -1;
                 st.generalEditingPath.clear();
+                ++st.generalDraftGeneration;
                 st.refreshRequested = true;
             }
             if (selected) { ImGui::PopStyleColor(3); }
@@ -2776,13 +2263,16 @@ void RenderGeneralTab(NotesOverlayState& st, float panelScale) {
     ImGui::SetNextItemWidth(165.0f * panelScale);
     if (RenderSortCombo("Sort##general", st.generalSortMode)) { st.refreshRequested = true; }
     ImGui::SameLine();
+    ImGui::SetNextItemWidth(200.0f * panelScale);
+    ImGui::InputTextWithHint("##general_search", "Search all notes", &st.searchQuery);
+    ImGui::SameLine();
     if (ImGui::Button("New##general")) {
         std::filesystem::path folder = ResolveGeneralFolderPath(st);
         if (st.selectedGeneralFolderIndex >= 0 && st.selectedGeneralFolderIndex < static_cast<int>(st.generalFolders.size()) &&
             IsGeneralFavoritesFolderKey(st.generalFolders[static_cast<size_t>(st.selectedGeneralFolderIndex)])) {
             folder = GetGeneralNotesRootPath();
         }
-        st.pendingNewGeneralNoteName = BuildNextUntitledTitle(folder);
+        st.pendingNewGeneralNoteName = BuildNextUntitledTitle(st, folder);
         st.pendingNewGeneralNotePopupOpen = true;
     }
     ImGui::SameLine();
@@ -2825,10 +2315,11 @@ void RenderGeneralTab(NotesOverlayState& st, float panelScale) {
 
         auto createFromPopup = [&]() {
             std::string title = SanitizeFileComponent(TrimAscii(st.pendingNewGeneralNoteName));
-            if (!HasMeaningfulText(title)) title = BuildNextUntitledTitle(folder);
+            if (!HasMeaningfulText(title)) title = BuildNextUntitledTitle(st, folder);
             st.generalTitle = title;
             st.generalDraft = BuildDefaultNewNoteMarkdown(st.generalTitle);
             st.generalEditingPath.clear();
+            ++st.generalDraftGeneration;
             st.selectedGeneralEntryIndex = -1;
             st.focusGeneralEditorNextFrame = true;
             MarkGeneralDraftDirty(st);
@@ -2843,7 +2334,10 @@ void RenderGeneralTab(NotesOverlayState& st, float panelScale) {
 
     const float listWidth = std::max(220.0f, ImGui::GetContentRegionAvail().x * 0.34f);
     ImGui::BeginChild("##general_notes_list", ImVec2(listWidth, 0.0f), true);
-    if (ImGui::BeginTable("##general_note_table", 3, ImGuiTableFlags_RowBg | ImGuiTableFlags_BordersInnerV | ImGuiTableFlags_SizingFixedFit)) {
+    if (HasMeaningfulText(st.searchQuery)) {
+        RenderGeneralSearchResults(st);
+    } else if (ImGui::BeginTable("##general_note_table", 3,
+                                 ImGuiTableFlags_RowBg | ImGuiTableFlags_BordersInnerV | ImGuiTableFlags_SizingFixedFit)) {
         ImGui::TableSetupColumn("P", ImGuiTableColumnFlags_WidthFixed, 24.0f);
         ImGui::TableSetupColumn("F", ImGuiTableColumnFlags_WidthFixed, 24.0f);
         ImGui::TableSetupColumn("Note", ImGuiTableColumnFlags_WidthStretch);
@@ -2874,19 +2368,7 @@ void RenderGeneralTab(NotesOverlayState& st, float panelScale) {
                 ImGui::PushStyleColor(ImGuiCol_HeaderActive, IM_COL32(80, 120, 164, 255));
             }
             if (ImGui::Selectable(entry.displayLabel.c_str(), selected, ImGuiSelectableFlags_SpanAllColumns)) {
-                std::string loaded;
-                if (ReadUtf8TextFile(entry.path, loaded)) {
-                    st.generalDraft = loaded;
-                    st.generalTitle = ExtractMarkdownTitle(st.generalDraft);
-                    if (!HasMeaningfulText(st.generalTitle)) st.generalTitle = entry.title;
-                    st.generalEditingPath = entry.path;
-                    st.selectedGeneralEntryIndex = i;
-                    st.generalDraftDirty = false;
-                    SetStatus(st, "Loaded note.");
-                    st.focusGeneralEditorNextFrame = true;
-                } else {
-                    SetStatus(st, "Failed to read note.");
-                }
+                if (LoadGeneralNoteIntoEditor(st, entry.path, entry.title)) { st.selectedGeneralEntryIndex = i; }
             }
             if (selected) { ImGui::PopStyleColor(3); }
             ImGui::PopID();
@@ -2919,7 +2401,7 @@ void RenderGeneralTab(NotesOverlayState& st, float panelScale) {
             st.generalEditorTab = 1;
             ImGui::BeginChild("##general_preview", ImVec2(0.0f, -ImGui::GetFrameHeightWithSpacing() * 2.2f), false,
                               ImGuiWindowFlags_HorizontalScrollbar);
-            if (RenderMarkdownPreview(st.generalDraft)) {
+            if (RenderMarkdownPreview(st.generalDraft, st.generalPreview)) {
                 const std::string titleFromMarkdown = ExtractMarkdownTitle(st.generalDraft);
                 if (HasMeaningfulText(titleFromMarkdown)) { st.generalTitle = titleFromMarkdown; }
                 MarkGeneralDraftDirty(st);
@@ -2973,6 +2455,48 @@ void RenderDeletePopup(NotesOverlayState& st) {
     ImGui::EndPopup();
 }
 
+// Writes the conflicting draft or PDF over the existing file, or next to it as name_N
+void SubmitSaveConflictResolution(NotesOverlayState& st, NotesConflictPolicy policy, const char* statusVerb) {
+    const std::filesystem::path& target = st.pendingSaveConflictTargetPath;
+    NotesPersistRequest request;
+    request.kind = st.pendingSaveConflictIsPdf ? NotesPersistKind::Pdf : NotesPersistKind::Markdown;
+    request.folder = target.parent_path();
+    request.fileBase = GuessTitleFromPath(target);
+    if (!HasMeaningfulText(request.fileBase)) request.fileBase = "note";
+    request.extension = st.pendingSaveConflictIsPdf ? ".pdf" : ".md";
+    try {
+        const std::string rawExt = WideToUtf8(target.extension().wstring());
+        if (!rawExt.empty()) request.extension = rawExt;
+    } catch (...) {}
+    request.onConflict = policy;
+    request.title = st.pendingSaveConflictTitle;
+    if (st.pendingSaveConflictIsPdf) { request.pdfFonts = GetPdfExportFonts(); }
+    request.text = std::make_shared<const std::string>(st.pendingSaveConflictDraft);
+
+    if (st.pendingSaveConflictIsPdf) {
+        SubmitNotesPersist(std::move(request));
+        SetStatus(st, "Exporting PDF...");
+    } else {
+        BeginGeneralSave(st, std::move(request), statusVerb);
+    }
+}
+
+void CollectNotesPersistResults(NotesOverlayState& st, bool inWorldNow) {
+    for (const NotesPersistResult& result : TakeNotesPersistResults()) {
+        s_notesPersistInFlight.fetch_sub(1, std::memory_order_acq_rel);
+        if (!result.error.empty()) { Log("Notes: " + result.error); }
+        if (result.ticket == st.generalSave.ticket) {
+            FinishGeneralSave(st, result);
+        } else if (result.ticket == st.ignSave.ticket) {
+            FinishIgnSave(st, result, inWorldNow);
+        } else if (result.request.kind == NotesPersistKind::Pdf) {
+            FinishPdfExport(st, result);
+        } else if (result.status == NotesPersistStatus::Written) {
+            st.refreshRequested = true; // A save superseded by a conflict resolution
+        }
+    }
+}
+
 void RenderSaveConflictPopup(NotesOverlayState& st) {
     if (st.pendingSaveConflictOpenPopup) {
         ImGui::OpenPopup("File Already Exists");
@@ -2990,53 +2514,15 @@ void RenderSaveConflictPopup(NotesOverlayState& st) {
     ImGui::Separator();
 
     if (ImGui::Button("Overwrite", ImVec2(130.0f, 0.0f))) {
-        bool ok = false;
-        if (st.pendingSaveConflictIsPdf) {
-            ok = WriteSimpleMarkdownPdf(st.pendingSaveConflictTargetPath, st.pendingSaveConflictTitle, st.pendingSaveConflictDraft);
-            if (ok) {
-                FinalizePdfExportSuccess(st, st.pendingSaveConflictTargetPath);
-            } else {
-                SetStatus(st, "Failed to export PDF.");
-            }
-        } else {
-            ok = SaveGeneralToResolvedPath(st, st.pendingSaveConflictTargetPath, st.pendingSaveConflictTitle, st.pendingSaveConflictDraft,
-                                           "Overwrote", false);
-        }
-        if (ok) {
-            ClearPendingSaveConflict(st);
-            ImGui::CloseCurrentPopup();
-        }
+        SubmitSaveConflictResolution(st, NotesConflictPolicy::Overwrite, "Overwrote");
+        ClearPendingSaveConflict(st);
+        ImGui::CloseCurrentPopup();
     }
     ImGui::SameLine();
     if (ImGui::Button("Save As New (+1)", ImVec2(150.0f, 0.0f))) {
-        std::string baseName = "note";
-        try {
-            baseName = WideToUtf8(st.pendingSaveConflictTargetPath.stem().wstring());
-        } catch (...) {}
-        baseName = SanitizeFileComponent(baseName);
-        std::string ext = st.pendingSaveConflictIsPdf ? ".pdf" : ".md";
-        try {
-            const std::string rawExt = st.pendingSaveConflictTargetPath.extension().string();
-            if (!rawExt.empty()) ext = rawExt;
-        } catch (...) {}
-        const std::filesystem::path copyPath =
-            BuildUniqueFilePath(st.pendingSaveConflictTargetPath.parent_path(), baseName, ext);
-        bool ok = false;
-        if (st.pendingSaveConflictIsPdf) {
-            ok = WriteSimpleMarkdownPdf(copyPath, st.pendingSaveConflictTitle, st.pendingSaveConflictDraft);
-            if (ok) {
-                FinalizePdfExportSuccess(st, copyPath);
-            } else {
-                SetStatus(st, "Failed to export PDF.");
-            }
-        } else {
-            const std::string copyTitle = GuessTitleFromPath(copyPath);
-            ok = SaveGeneralToResolvedPath(st, copyPath, copyTitle, st.pendingSaveConflictDraft, "Saved", false);
-        }
-        if (ok) {
-            ClearPendingSaveConflict(st);
-            ImGui::CloseCurrentPopup();
-        }
+        SubmitSaveConflictResolution(st, NotesConflictPolicy::Uniquify, "Saved");
+        ClearPendingSaveConflict(st);
+        ImGui::CloseCurrentPopup();
     }
     ImGui::SameLine();
     if (ImGui::Button("Cancel", ImVec2(110.0f, 0.0f))) {
@@ -3068,7 +2554,6 @@ bool HandleNotesOverlayToggleHotkey(unsigned int keyVk, bool ctrlDown, bool shif
     s_notes.visible = !s_notes.visible;
     if (s_notes.visible) {
         s_notes.refreshRequested = true;
-        s_notes.lastAutoRefresh = std::chrono::steady_clock::time_point::min();
         s_notes.storageDraftInitialized = false;
         s_notes.activeTab = inWorldNow ? 0 : 1;
         s_notes.forceTabSelectionNextFrame = true;
@@ -3076,6 +2561,7 @@ bool HandleNotesOverlayToggleHotkey(unsigned int keyVk, bool ctrlDown, bool shif
         s_notes.generalEditorTab = 0;
         s_notes.focusIgnEditorNextFrame = inWorldNow;
         s_notes.focusGeneralEditorNextFrame = !inWorldNow;
+        s_notes.ignCloseSaveDeferred = false;
     } else if (wasVisible) {
         s_pendingIgnAutoSaveOnClose.store(true, std::memory_order_release);
     }
@@ -3095,6 +2581,7 @@ bool IsNotesOverlayInputCaptureActive() { return IsNotesOverlayVisible(); }
 
 bool HasNotesOverlayPendingWork() {
     if (s_pendingIgnAutoSaveOnClose.load(std::memory_order_acquire)) return true;
+    if (s_notesPersistInFlight.load(std::memory_order_acquire) > 0) return true;
     return IsNotesOverlayVisible();
 }
 
@@ -3105,6 +2592,7 @@ void RenderNotesOverlayImGui() {
 
     std::lock_guard<std::mutex> lock(s_notesMutex);
     EnsureInitializedLocked(s_notes, *cfgSnap);
+    CollectNotesPersistResults(s_notes, inWorldNow);
 
     if (!cfgSnap->notesOverlay.enabled) {
         s_notes.visible = false;
@@ -3118,15 +2606,16 @@ void RenderNotesOverlayImGui() {
 
     if (!s_notes.visible) return;
 
-    const auto now = std::chrono::steady_clock::now();
-    if (s_notes.lastAutoRefresh == std::chrono::steady_clock::time_point::min() ||
-        (now - s_notes.lastAutoRefresh) >= std::chrono::milliseconds(1000)) {
-        s_notes.refreshRequested = true;
-        s_notes.lastAutoRefresh = now;
-    }
+    // The index worker watches the notes folder; listings follow its catalog instead of polling the disk
+    SetNotesIndexRoot(GetMarkdownNotesRootPath(), EnsureNotesDirectories);
 
     RunNotesAutoSaveTick(s_notes, inWorldNow);
-    if (s_notes.refreshRequested) { ReloadListings(s_notes); }
+    if (s_notes.refreshRequested) {
+        RequestNotesIndexRescan();
+        ReloadListings(s_notes);
+    } else if (GetNotesCatalogSnapshot() != s_notes.catalog) {
+        ReloadListings(s_notes);
+    }
 
     EnsureNotesIconTexturesLoaded();
 
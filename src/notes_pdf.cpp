@@ -0,0 +1,720 @@
+#include "notes_pdf.h"
+#include "deflate.h"
+#include "notes_markdown.h"
+#include "truetype_font.h"
+
+#include <algorithm>
+#include <cstdio>
+#include <fstream>
+#include <iomanip>
+#include <memory>
+#include <sstream>
+#include <string_view>
+#include <vector>
+
+namespace {
+
+constexpr float kPageWidth = 612.0f;
+constexpr float kPageHeight = 792.0f;
+constexpr float kLeft = 50.0f;
+constexpr float kTopY = 770.0f;
+constexpr float kBottomY = 50.0f;
+constexpr float kTextWidth = kPageWidth - 2.0f * kLeft;
+
+// Object ids fixed up front; pages and fonts are numbered as they are written
+constexpr int kCatalogObjectId = 1;
+constexpr int kPagesObjectId = 2;
+
+// Advance widths (1/1000 em) of the standard fonts for WinAnsi codes 32..126
+const uint16_t kHelveticaWidths[95] = { 278, 278, 355, 556, 556, 889, 667, 191, 333, 333, 389, 584, 278, 333, 278, 278, 556, 556, 556,
+                                        556, 556, 556, 556, 556, 556, 556, 278, 278, 584, 584, 584, 556, 1015, 667, 667, 722, 722, 667,
+                                        611, 778, 722, 278, 500, 667, 556, 833, 722, 778, 667, 778, 722, 667, 611, 722, 667, 944, 667,
+                                        667, 611, 278, 278, 278, 469, 556, 333, 556, 556, 500, 556, 556, 278, 556, 556, 222, 222, 500,
+                                        222, 833, 556, 556, 556, 556, 333, 500, 278, 556, 500, 722, 500, 500, 500, 334, 260, 334, 584 };
+const uint16_t kHelveticaBoldWidths[95] = { 278, 333, 474, 556, 556, 889, 722, 238, 333, 333, 389, 584, 278, 333, 278, 278, 556, 556, 556,
+                                            556, 556, 556, 556, 556, 556, 556, 333, 333, 584, 584, 584, 611, 975, 722, 722, 722, 722, 667,
+                                            611, 778, 722, 278, 556, 722, 611, 833, 722, 778, 667, 778, 722, 667, 611, 722, 667, 944, 667,
+                                            667, 611, 333, 278, 333, 584, 556, 333, 556, 611, 556, 611, 556, 333, 611, 611, 278, 278, 556,
+                                            278, 889, 611, 611, 611, 611, 389, 556, 333, 611, 556, 778, 556, 556, 500, 389, 280, 389, 584 };
+constexpr uint16_t kCourierWidth = 600;
+
+// Decodes one UTF-8 sequence at text[i] and advances i (invalid bytes decode as U+FFFD)
+uint32_t NextCodepoint(std::string_view text, size_t& i) {
+    const unsigned char lead = static_cast<unsigned char>(text[i++]);
+    if (lead < 0x80) return lead;
+    int extra = 0;
+    uint32_t cp = 0;
+    if ((lead & 0xE0) == 0xC0) {
+        extra = 1;
+        cp = lead & 0x1Fu;
+    } else if ((lead & 0xF0) == 0xE0) {
+        extra = 2;
+        cp = lead & 0x0Fu;
+    } else if ((lead & 0xF8) == 0xF0) {
+        extra = 3;
+        cp = lead & 0x07u;
+    } else {
+        return 0xFFFD;
+    }
+    for (int k = 0; k < extra; ++k) {
+        if (i >= text.size() || (static_cast<unsigned char>(text[i]) & 0xC0) != 0x80) return 0xFFFD;
+        cp = (cp << 6) | (static_cast<unsigned char>(text[i++]) & 0x3Fu);
+    }
+    return cp <= 0x10FFFF ? cp : 0xFFFD;
+}
+
+struct EmbeddedFont {
+    TrueTypeFont font;
+    std::vector<uint8_t> used;     // Per glyph id
+    std::vector<uint32_t> unicode; // Codepoint each used glyph stands for (ToUnicode map)
+    uint16_t fallbackGlyph = 0;    // '?' for characters the font lacks
+    int objectId = 0;
+};
+
+struct PdfFont {
+    const char* resourceName = "F1";
+    int objectId = 0;
+    const char* standardName = "Helvetica"; // Used when `embedded` is null
+    const uint16_t* standardWidths = nullptr; // nullptr: fixed pitch (Courier)
+    std::shared_ptr<EmbeddedFont> embedded;
+    bool syntheticBold = false;
+
+    uint16_t GlyphFor(uint32_t codepoint) const {
+        const uint16_t glyph = embedded->font.GlyphForCodepoint(codepoint);
+        return glyph != 0 ? glyph : embedded->fallbackGlyph;
+    }
+
+    // 1/1000 em
+    float Advance(uint32_t codepoint) const {
+        if (embedded) { return embedded->font.AdvanceWidth(GlyphFor(codepoint)) * 1000.0f / embedded->font.UnitsPerEm(); }
+        if (codepoint < 32 || codepoint > 126) codepoint = '?';
+        return standardWidths ? standardWidths[codepoint - 32] : kCourierWidth;
+    }
+
+    float Measure(std::string_view text, float fontSize) const {
+        float width = 0.0f;
+        for (size_t i = 0; i < text.size();) {
+            width += Advance(NextCodepoint(text, i));
+        }
+        return width * fontSize / 1000.0f;
+    }
+
+    // Appends `text` as a string operand: glyph ids (hex) for an embedded font, escaped ASCII otherwise
+    void AppendString(std::string& out, std::string_view text) const {
+        if (!embedded) {
+            out.push_back('(');
+            for (unsigned char c : text) {
+                if (c == '\\' || c == '(' || c == ')') {
+                    out.push_back('\\');
+                    out.push_back(static_cast<char>(c));
+                } else if (c >= 32 && c <= 126) {
+                    out.push_back(static_cast<char>(c));
+                } else if (c < 0x80 || c >= 0xC0) {
+                    out.push_back('?'); // One '?' per character, not per UTF-8 byte
+                }
+            }
+            out.push_back(')');
+            return;
+        }
+
+        static const char kHex[] = "0123456789ABCDEF";
+        out.push_back('<');
+        for (size_t i = 0; i < text.size();) {
+            const uint32_t codepoint = NextCodepoint(text, i);
+            if (codepoint < 32) continue;
+            const uint16_t glyph = GlyphFor(codepoint);
+            if (!embedded->used[glyph]) {
+                embedded->used[glyph] = 1;
+                embedded->unicode[glyph] = glyph == embedded->fallbackGlyph ? '?' : codepoint;
+            }
+            out.push_back(kHex[(glyph >> 12) & 0xF]);
+            out.push_back(kHex[(glyph >> 8) & 0xF]);
+            out.push_back(kHex[(glyph >> 4) & 0xF]);
+            out.push_back(kHex[glyph & 0xF]);
+        }
+        out.push_back('>');
+    }
+};
+
+std::shared_ptr<EmbeddedFont> LoadEmbeddedFont(const std::filesystem::path& path) {
+    if (path.empty()) return nullptr;
+    std::error_code ec;
+    const uintmax_t size = std::filesystem::file_size(path, ec);
+    if (ec || size == 0 || size > (64u << 20)) return nullptr;
+
+    std::ifstream in(path, std::ios::binary);
+    if (!in.is_open()) return nullptr;
+    std::string data(static_cast<size_t>(size), '\0');
+    in.read(data.data(), static_cast<std::streamsize>(data.size()));
+    if (static_cast<size_t>(in.gcount()) != data.size()) return nullptr;
+
+    auto embedded = std::make_shared<EmbeddedFont>();
+    if (!embedded->font.Load(std::move(data))) return nullptr;
+    // The subset is built after every page is written, too late to switch fonts. BuildSubset only fails when hmtx is
+    // too short for the subset's glyph count, which peaks when the last glyph is kept: probe that case now so such a
+    // font falls back to the standard fonts instead.
+    std::string probe;
+    if (!embedded->font.BuildSubset({ static_cast<uint16_t>(embedded->font.GlyphCount() - 1) }, probe)) return nullptr;
+    embedded->used.assign(embedded->font.GlyphCount(), 0);
+    embedded->unicode.assign(embedded->font.GlyphCount(), 0);
+    embedded->fallbackGlyph = embedded->font.GlyphForCodepoint('?');
+    return embedded;
+}
+
+std::filesystem::path FindBoldSibling(const std::filesystem::path& regular) {
+    // Windows pairs Arial.ttf with arialbd.ttf and segoeui.ttf with segoeuib.ttf; most other families use Name-Bold.ttf
+    static const char* kSuffixes[] = { "bd", "b", "-Bold", "Bold", " Bold" };
+    for (const char* suffix : kSuffixes) {
+        std::filesystem::path candidate = regular.parent_path() / regular.stem();
+        candidate += suffix;
+        candidate += regular.extension();
+        std::error_code ec;
+        if (std::filesystem::is_regular_file(candidate, ec)) return candidate;
+    }
+    return {};
+}
+
+// Splits text into lines no wider than maxWidth points, breaking at the last space when it is far enough in
+std::vector<std::string> WrapTextToWidth(const std::string& text, const PdfFont& font, float fontSize, float maxWidth) {
+    std::string expanded;
+    expanded.reserve(text.size() + 8);
+    for (char c : text) {
+        if (c == '\t') {
+            expanded += "    ";
+        } else {
+            expanded.push_back(c);
+        }
+    }
+
+    std::vector<std::string> wrapped;
+    const float maxUnits = std::max(1.0f, maxWidth * 1000.0f / fontSize);
+    size_t lineStart = 0;
+    while (true) {
+        float width = 0.0f;
+        size_t lastSpace = std::string::npos;
+        float widthAtLastSpace = 0.0f;
+        size_t i = lineStart;
+        size_t cut = std::string::npos;
+        while (i < expanded.size()) {
+            const size_t charStart = i;
+            const uint32_t codepoint = NextCodepoint(expanded, i);
+            const float advance = font.Advance(codepoint);
+            if (width + advance > maxUnits && charStart > lineStart) {
+                cut = (lastSpace != std::string::npos && widthAtLastSpace >= maxUnits / 3.0f) ? lastSpace : charStart;
+                break;
+            }
+            if (codepoint == ' ') {
+                lastSpace = charStart;
+                widthAtLastSpace = width;
+            }
+            width += advance;
+        }
+        if (cut == std::string::npos) {
+            wrapped.push_back(expanded.substr(lineStart));
+            return wrapped;
+        }
+        wrapped.push_back(expanded.substr(lineStart, cut - lineStart));
+        lineStart = cut;
+        while (lineStart < expanded.size() && expanded[lineStart] == ' ') {
+            ++lineStart;
+        }
+        if (lineStart >= expanded.size()) return wrapped;
+    }
+}
+
+float EstimateIndentPointsFromPrefix(const std::string& prefix) {
+    size_t leadingSpaces = 0;
+    for (char c : prefix) {
+        if (c == ' ') {
+            ++leadingSpaces;
+            continue;
+        }
+        if (c == '\t') {
+            leadingSpaces += 4;
+            continue;
+        }
+        break;
+    }
+    return static_cast<float>(leadingSpaces) * 3.4f;
+}
+
+float HeadingPdfFontSize(int headingLevel) {
+    static const float kSizes[] = { 20.0f, 18.0f, 16.0f, 14.0f, 12.5f, 11.5f };
+    const int idx = std::clamp(headingLevel, 1, 6) - 1;
+    return kSizes[idx];
+}
+
+// PDF text string: literal for printable ASCII, UTF-16BE with a byte order mark otherwise
+std::string PdfTextString(std::string_view text) {
+    const bool ascii = std::all_of(text.begin(), text.end(), [](char c) { return c >= 32 && c <= 126; });
+    if (ascii) {
+        std::string out = "(";
+        for (char c : text) {
+            if (c == '\\' || c == '(' || c == ')') out.push_back('\\');
+            out.push_back(c);
+        }
+        return out + ")";
+    }
+
+    std::string out = "<FEFF";
+    char buf[16];
+    for (size_t i = 0; i < text.size();) {
+        const uint32_t codepoint = NextCodepoint(text, i);
+        if (codepoint >= 0x10000) {
+            const uint32_t v = codepoint - 0x10000;
+            std::snprintf(buf, sizeof(buf), "%04X%04X", 0xD800u + (v >> 10), 0xDC00u + (v & 0x3FFu));
+        } else {
+            std::snprintf(buf, sizeof(buf), "%04X", codepoint);
+        }
+        out += buf;
+    }
+    return out + ">";
+}
+
+// Writes objects straight to the output and remembers their offsets for the cross-reference table
+class PdfStreamWriter {
+  public:
+    explicit PdfStreamWriter(std::ostream& out) : m_out(out) { m_offsets.push_back(0); }
+
+    int ReserveObject() {
+        m_offsets.push_back(0);
+        return static_cast<int>(m_offsets.size() - 1);
+    }
+
+    void Write(std::string_view data) {
+        m_out.write(data.data(), static_cast<std::streamsize>(data.size()));
+        m_position += data.size();
+    }
+
+    void WriteObject(int id, std::string_view body) {
+        BeginObject(id);
+        Write(body);
+        Write("\nendobj\n");
+    }
+
+    // Flate-compresses `data`; `extraEntries` go into the stream dictionary
+    void WriteStreamObject(int id, std::string_view data, const std::string& extraEntries = std::string()) {
+        m_compressed.clear();
+        ZlibCompress(reinterpret_cast<const uint8_t*>(data.data()), data.size(), m_compressed);
+        BeginObject(id);
+        Write("<< /Length " + std::to_string(m_compressed.size()) + " /Filter /FlateDecode" + extraEntries + " >>\nstream\n");
+        Write(std::string_view(reinterpret_cast<const char*>(m_compressed.data()), m_compressed.size()));
+        Write("\nendstream\nendobj\n");
+    }
+
+    void Finish(int infoObjectId) {
+        const uint64_t xrefOffset = m_position;
+        Write("xref\n0 " + std::to_string(m_offsets.size()) + "\n");
+        Write("0000000000 65535 f \n");
+        char lineBuf[32];
+        for (size_t objId = 1; objId < m_offsets.size(); ++objId) {
+            std::snprintf(lineBuf, sizeof(lineBuf), "%010llu 00000 n \n", static_cast<unsigned long long>(m_offsets[objId]));
+            Write(lineBuf);
+        }
+        Write("trailer\n<< /Size " + std::to_string(m_offsets.size()) + " /Root " + std::to_string(kCatalogObjectId) + " 0 R /Info " +
+              std::to_string(infoObjectId) + " 0 R >>\n");
+        Write("startxref\n" + std::to_string(xrefOffset) + "\n%%EOF\n");
+    }
+
+  private:
+    void BeginObject(int id) {
+        m_offsets[static_cast<size_t>(id)] = m_position;
+        Write(std::to_string(id) + " 0 obj\n");
+    }
+
+    std::ostream& m_out;
+    uint64_t m_position = 0;
+    std::vector<uint64_t> m_offsets; // Indexed by object id; 0 is the free-list head
+    std::vector<uint8_t> m_compressed;
+};
+
+void WriteEmbeddedFontObjects(PdfStreamWriter& writer, const EmbeddedFont& embedded) {
+    const TrueTypeFont& font = embedded.font;
+    const float scale = 1000.0f / font.UnitsPerEm();
+    auto scaled = [&](int value) { return std::to_string(static_cast<int>(value * scale)); };
+
+    std::vector<uint16_t> glyphs;
+    for (size_t glyph = 0; glyph < embedded.used.size(); ++glyph) {
+        if (embedded.used[glyph]) glyphs.push_back(static_cast<uint16_t>(glyph));
+    }
+
+    // Subset tag: six capitals derived from the glyph set, so identical exports produce identical files
+    uint32_t hash = 2166136261u;
+    for (uint16_t glyph : glyphs) {
+        hash = (hash ^ glyph) * 16777619u;
+    }
+    std::string baseFont;
+    for (int i = 0; i < 6; ++i) {
+        baseFont.push_back(static_cast<char>('A' + hash % 26));
+        hash /= 26;
+    }
+    baseFont += "+" + font.PostScriptName();
+
+    const int descendantId = writer.ReserveObject();
+    const int descriptorId = writer.ReserveObject();
+    const int fontFileId = writer.ReserveObject();
+    const int toUnicodeId = writer.ReserveObject();
+
+    writer.WriteObject(embedded.objectId, "<< /Type /Font /Subtype /Type0 /BaseFont /" + baseFont + " /Encoding /Identity-H /DescendantFonts [" +
+                                              std::to_string(descendantId) + " 0 R] /ToUnicode " + std::to_string(toUnicodeId) + " 0 R >>");
+
+    std::string widths = "[";
+    for (size_t i = 0; i < glyphs.size(); ++i) {
+        if (i == 0 || glyphs[i] != glyphs[i - 1] + 1) {
+            if (i > 0) widths += "]";
+            widths += " " + std::to_string(glyphs[i]) + " [";
+        } else {
+            widths += " ";
+        }
+        widths += scaled(font.AdvanceWidth(glyphs[i]));
+    }
+    widths += glyphs.empty() ? "]" : "] ]";
+    writer.WriteObject(descendantId, "<< /Type /Font /Subtype /CIDFontType2 /BaseFont /" + baseFont +
+                                         " /CIDSystemInfo << /Registry (Adobe) /Ordering (Identity) /Supplement 0 >> /FontDescriptor " +
+                                         std::to_string(descriptorId) + " 0 R /CIDToGIDMap /Identity /DW " + scaled(font.AdvanceWidth(0)) +
+                                         " /W " + widths + " >>");
+
+    std::string subset;
+    const bool haveSubset = font.BuildSubset(glyphs, subset);
+
+    int flags = 4; // Symbolic: glyphs are addressed by id, not through a standard encoding
+    if (font.IsFixedPitch()) flags |= 1;
+    if (font.ItalicAngle() != 0.0f) flags |= 64;
+    const int16_t* bbox = font.BoundingBox();
+    char italicAngle[32];
+    std::snprintf(italicAngle, sizeof(italicAngle), "%.1f", font.ItalicAngle());
+    writer.WriteObject(descriptorId, "<< /Type /FontDescriptor /FontName /" + baseFont + " /Flags " + std::to_string(flags) + " /FontBBox [" +
+                                         scaled(bbox[0]) + " " + scaled(bbox[1]) + " " + scaled(bbox[2]) + " " + scaled(bbox[3]) +
+                                         "] /ItalicAngle " + italicAngle + " /Ascent " + scaled(font.Ascent()) + " /Descent " +
+                                         scaled(font.Descent()) + " /CapHeight " + scaled(font.CapHeight()) + " /StemV 80" +
+                                         (haveSubset ? " /FontFile2 " + std::to_string(fontFileId) + " 0 R" : std::string()) + " >>");
+    // LoadEmbeddedFont rules this out; should it happen anyway, leave the font unembedded rather than write an empty program
+    if (haveSubset) {
+        writer.WriteStreamObject(fontFileId, subset, " /Length1 " + std::to_string(subset.size()));
+    } else {
+        writer.WriteObject(fontFileId, "null");
+    }
+
+    std::string cmap = "/CIDInit /ProcSet findresource begin\n12 dict begin\nbegincmap\n"
+                       "/CIDSystemInfo << /Registry (Adobe) /Ordering (UCS) /Supplement 0 >> def\n"
+                       "/CMapName /Adobe-Identity-UCS def\n/CMapType 2 def\n"
+                       "1 begincodespacerange\n<0000> <FFFF>\nendcodespacerange\n";
+    char entry[40];
+    for (size_t first = 0; first < glyphs.size(); first += 100) {
+        const size_t count = std::min<size_t>(100, glyphs.size() - first);
+        cmap += std::to_string(count) + " beginbfchar\n";
+        for (size_t i = first; i < first + count; ++i) {
+            const uint32_t codepoint = embedded.unicode[glyphs[i]];
+            if (codepoint >= 0x10000) {
+                const uint32_t v = codepoint - 0x10000;
+                std::snprintf(entry, sizeof(entry), "<%04X> <%04X%04X>\n", glyphs[i], 0xD800u + (v >> 10), 0xDC00u + (v & 0x3FFu));
+            } else {
+                std::snprintf(entry, sizeof(entry), "<%04X> <%04X>\n", glyphs[i], codepoint);
+            }
+            cmap += entry;
+        }
+        cmap += "endbfchar\n";
+    }
+    cmap += "endcmap\nCMapName currentdict /CMap defineresource pop\nend\nend\n";
+    writer.WriteStreamObject(toUnicodeId, cmap);
+}
+
+} // namespace
+
+bool WriteMarkdownPdf(std::ostream& out, const std::string& title, const std::string& markdownText, const NotesPdfFonts& fonts) {
+    enum class PdfFontSlot : int {
+        Regular = 0,
+        Bold = 1,
+        Mono = 2
+    };
+
+    struct PdfLine {
+        std::string text;
+        float fontSize = 11.0f;
+        bool isBlank = false;
+        bool isRule = false;
+        PdfFontSlot font = PdfFontSlot::Regular;
+        float colorR = 0.07f;
+        float colorG = 0.08f;
+        float colorB = 0.10f;
+        bool drawQuoteBar = false;
+        bool drawBulletDot = false;
+        bool drawTaskBox = false;
+        bool taskChecked = false;
+        float xOffset = 0.0f;
+        float markerIndent = 0.0f;
+    };
+
+    PdfStreamWriter writer(out);
+    writer.ReserveObject(); // Catalog
+    writer.ReserveObject(); // Pages
+
+    PdfFont pdfFonts[3];
+    pdfFonts[0].resourceName = "F1";
+    pdfFonts[0].standardWidths = kHelveticaWidths;
+    pdfFonts[0].embedded = LoadEmbeddedFont(fonts.regular);
+    pdfFonts[1].resourceName = "F2";
+    pdfFonts[1].standardName = "Helvetica-Bold";
+    pdfFonts[1].standardWidths = kHelveticaBoldWidths;
+    if (pdfFonts[0].embedded) {
+        pdfFonts[1].embedded = LoadEmbeddedFont(fonts.bold.empty() ? FindBoldSibling(fonts.regular) : fonts.bold);
+        if (!pdfFonts[1].embedded) {
+            pdfFonts[1].embedded = pdfFonts[0].embedded;
+            pdfFonts[1].syntheticBold = true;
+        }
+    }
+    pdfFonts[2].resourceName = "F3";
+    pdfFonts[2].standardName = "Courier";
+    for (PdfFont& font : pdfFonts) {
+        if (font.embedded && font.embedded->objectId == 0) { font.embedded->objectId = writer.ReserveObject(); }
+        font.objectId = font.embedded ? font.embedded->objectId : writer.ReserveObject();
+    }
+
+    writer.Write("%PDF-1.4\n%\xE2\xE3\xCF\xD3\n");
+
+    std::vector<int> pageObjectIds;
+    std::ostringstream stream;
+    std::string textOperand;
+    float y = kTopY;
+
+    auto flushPage = [&]() {
+        const int contentObjId = writer.ReserveObject();
+        writer.WriteStreamObject(contentObjId, stream.str());
+        const int pageObjId = writer.ReserveObject();
+        writer.WriteObject(pageObjId, "<< /Type /Page /Parent " + std::to_string(kPagesObjectId) + " 0 R /MediaBox [0 0 " +
+                                          std::to_string(static_cast<int>(kPageWidth)) + " " + std::to_string(static_cast<int>(kPageHeight)) +
+                                          "] /Contents " + std::to_string(contentObjId) + " 0 R >>");
+        pageObjectIds.push_back(pageObjId);
+        stream.str("");
+        stream.clear();
+        y = kTopY;
+    };
+
+    auto emitLine = [&](const PdfLine& line) {
+        float lineHeight = 0.0f;
+        if (line.isBlank) {
+            lineHeight = 7.0f;
+        } else if (line.isRule) {
+            lineHeight = 8.0f;
+        } else if (line.font == PdfFontSlot::Bold && line.fontSize >= 12.0f) {
+            lineHeight = line.fontSize + 1.6f;
+        } else {
+            lineHeight = line.fontSize + 3.0f;
+        }
+        if (y - lineHeight < kBottomY) { flushPage(); }
+
+        if (line.isBlank) {
+            y -= lineHeight;
+            return;
+        }
+
+        if (line.isRule) {
+            const float yLine = y - 2.0f;
+            const float x1 = kLeft;
+            const float x2 = kPageWidth - kLeft;
+            stream << std::fixed << std::setprecision(3) << line.colorR << " " << line.colorG << " " << line.colorB << " RG\n";
+            stream << "1 w\n";
+            stream << x1 << " " << yLine << " m\n";
+            stream << x2 << " " << yLine << " l\n";
+            stream << "S\n";
+            y -= lineHeight;
+            return;
+        }
+
+        if (line.drawQuoteBar) {
+            const float xBar = kLeft + line.markerIndent + 4.0f;
+            // Align the quote bar to the text glyph bounds around the current baseline.
+            const float ascent = std::clamp(line.fontSize * 0.72f, 6.5f, 9.0f);
+            const float descent = std::clamp(line.fontSize * 0.30f, 2.2f, 4.4f);
+            const float yTop = y + ascent;
+            const float yBottom = y - descent;
+            stream << std::fixed << std::setprecision(3) << 0.36f << " " << 0.45f << " " << 0.60f << " RG\n";
+            stream << "2 w\n";
+            stream << xBar << " " << yBottom << " m\n";
+            stream << xBar << " " << yTop << " l\n";
+            stream << "S\n";
+        }
+
+        if (line.drawBulletDot) {
+            const float dotRadius = std::clamp(line.fontSize * 0.17f, 1.4f, 2.1f);
+            const float dotX = kLeft + line.markerIndent + 6.0f;
+            const float dotY = y + std::clamp(line.fontSize * 0.24f, 1.5f, 3.6f);
+            const float k = dotRadius * 0.55228475f;
+            stream << std::fixed << std::setprecision(3) << line.colorR << " " << line.colorG << " " << line.colorB << " rg\n";
+            stream << (dotX + dotRadius) << " " << dotY << " m\n";
+            stream << (dotX + dotRadius) << " " << (dotY + k) << " " << (dotX + k) << " " << (dotY + dotRadius) << " " << dotX << " "
+                   << (dotY + dotRadius) << " c\n";
+            stream << (dotX - k) << " " << (dotY + dotRadius) << " " << (dotX - dotRadius) << " " << (dotY + k) << " " << (dotX - dotRadius)
+                   << " " << dotY << " c\n";
+            stream << (dotX - dotRadius) << " " << (dotY - k) << " " << (dotX - k) << " " << (dotY - dotRadius) << " " << dotX << " "
+                   << (dotY - dotRadius) << " c\n";
+            stream << (dotX + k) << " " << (dotY - dotRadius) << " " << (dotX + dotRadius) << " " << (dotY - k) << " " << (dotX + dotRadius)
+                   << " " << dotY << " c\n";
+            stream << "f\n";
+        }
+
+        if (line.drawTaskBox) {
+            const float boxSize = std::clamp(line.fontSize * 0.64f, 6.5f, 8.0f);
+            const float boxX = kLeft + line.markerIndent + 2.0f;
+            const float baselineOffset = std::clamp(line.fontSize * 0.16f, 1.5f, 2.2f);
+            const float boxY = y - baselineOffset;
+            stream << std::fixed << std::setprecision(3) << line.colorR << " " << line.colorG << " " << line.colorB << " RG\n";
+            stream << "1 w\n";
+            stream << boxX << " " << boxY << " " << boxSize << " " << boxSize << " re\n";
+            stream << "S\n";
+            if (line.taskChecked) {
+                const float x1 = boxX + boxSize * 0.22f;
+                const float y1 = boxY + boxSize * 0.48f;
+                const float x2 = boxX + boxSize * 0.43f;
+                const float y2 = boxY + boxSize * 0.22f;
+                const float x3 = boxX + boxSize * 0.80f;
+                const float y3 = boxY + boxSize * 0.86f;
+                stream << x1 << " " << y1 << " m\n";
+                stream << x2 << " " << y2 << " l\n";
+                stream << x3 << " " << y3 << " l\n";
+                stream << "S\n";
+            }
+        }
+
+        const PdfFont& font = pdfFonts[static_cast<int>(line.font)];
+        stream << "BT\n";
+        stream << std::fixed << std::setprecision(3) << line.colorR << " " << line.colorG << " " << line.colorB << " rg\n";
+        if (font.syntheticBold) {
+            // Fill and stroke the outlines to thicken them
+            stream << line.colorR << " " << line.colorG << " " << line.colorB << " RG\n";
+            stream << (line.fontSize * 0.035f) << " w\n2 Tr\n";
+        }
+        stream << "/" << font.resourceName << " " << std::fixed << std::setprecision(1) << line.fontSize << " Tf\n";
+        stream << std::setprecision(3) << "1 0 0 1 " << (kLeft + line.xOffset) << " " << y << " Tm\n";
+        textOperand.clear();
+        font.AppendString(textOperand, line.text);
+        stream << textOperand << " Tj\n";
+        stream << "ET\n";
+        y -= lineHeight;
+    };
+
+    auto emitWrapped = [&](const std::string& text, PdfLine line, float wrapWidth) {
+        const std::vector<std::string> wrapped =
+            WrapTextToWidth(text, pdfFonts[static_cast<int>(line.font)], line.fontSize, wrapWidth);
+        for (size_t i = 0; i < wrapped.size(); ++i) {
+            line.text = wrapped[i];
+            emitLine(line);
+            line.drawBulletDot = false;
+            line.drawTaskBox = false;
+        }
+    };
+
+    ForEachMarkdownPreviewLine(markdownText, [&](const MarkdownPreviewLine& line) {
+        switch (line.kind) {
+        case MarkdownLineKind::Blank:
+            emitLine({ "", 0.0f, true, false, PdfFontSlot::Regular, 0.07f, 0.08f, 0.10f });
+            break;
+        case MarkdownLineKind::Rule:
+            emitLine({ "", 10.0f, false, true, PdfFontSlot::Regular, 0.35f, 0.39f, 0.46f });
+            break;
+        case MarkdownLineKind::Heading:
+            emitWrapped(line.text, { "", HeadingPdfFontSize(line.headingLevel), false, false, PdfFontSlot::Bold, 0.06f, 0.08f, 0.11f },
+                        kTextWidth);
+            break;
+        case MarkdownLineKind::Quote: {
+            PdfLine q{};
+            q.fontSize = 11.0f;
+            q.font = PdfFontSlot::Regular;
+            q.colorR = 0.32f;
+            q.colorG = 0.37f;
+            q.colorB = 0.45f;
+            q.drawQuoteBar = true;
+            q.xOffset = 14.0f;
+            q.markerIndent = 0.0f;
+            emitWrapped(line.text, q, kTextWidth - q.xOffset);
+            break;
+        }
+        case MarkdownLineKind::Bullet: {
+            const std::string prefix = line.listPrefix.empty() ? "- " : line.listPrefix;
+            const float indentPoints = EstimateIndentPointsFromPrefix(prefix);
+            PdfLine b{};
+            b.fontSize = 11.0f;
+            b.font = PdfFontSlot::Regular;
+            b.colorR = 0.08f;
+            b.colorG = 0.09f;
+            b.colorB = 0.11f;
+            b.drawBulletDot = true;
+            b.xOffset = indentPoints + 12.0f;
+            b.markerIndent = indentPoints;
+            emitWrapped(line.text, b, kTextWidth - b.xOffset);
+            break;
+        }
+        case MarkdownLineKind::Numbered: {
+            // "1. " hangs in front of the first line; continuation lines align with the text after it
+            const std::string prefix = line.listPrefix.empty() ? "1. " : line.listPrefix;
+            const float indentPoints = EstimateIndentPointsFromPrefix(prefix);
+            const std::string marker = prefix.substr(std::min(prefix.find_first_not_of(" \t"), prefix.size()));
+            PdfLine n{ "", 11.0f, false, false, PdfFontSlot::Regular, 0.08f, 0.09f, 0.11f };
+            const float markerWidth = pdfFonts[0].Measure(marker, n.fontSize);
+            const std::vector<std::string> wrapped =
+                WrapTextToWidth(line.text, pdfFonts[0], n.fontSize, kTextWidth - indentPoints - markerWidth);
+            for (size_t i = 0; i < wrapped.size(); ++i) {
+                n.text = i == 0 ? marker + wrapped[i] : wrapped[i];
+                n.xOffset = i == 0 ? indentPoints : indentPoints + markerWidth;
+                emitLine(n);
+            }
+            break;
+        }
+        case MarkdownLineKind::Task: {
+            const std::string prefix = line.listPrefix.empty() ? (line.checked ? "[x] " : "[ ] ") : line.listPrefix;
+            const float indentPoints = EstimateIndentPointsFromPrefix(prefix);
+            PdfLine t{};
+            t.fontSize = 11.0f;
+            t.font = PdfFontSlot::Regular;
+            t.colorR = line.checked ? 0.12f : 0.48f;
+            t.colorG = line.checked ? 0.46f : 0.35f;
+            t.colorB = line.checked ? 0.21f : 0.13f;
+            t.drawTaskBox = true;
+            t.taskChecked = line.checked;
+            t.xOffset = indentPoints + 16.0f;
+            t.markerIndent = indentPoints;
+            emitWrapped(line.text, t, kTextWidth - t.xOffset);
+            break;
+        }
+        case MarkdownLineKind::Code:
+            emitWrapped(line.text, { "", 10.0f, false, false, PdfFontSlot::Mono, 0.10f, 0.30f, 0.56f }, kTextWidth);
+            break;
+        case MarkdownLineKind::Body:
+        default:
+            emitWrapped(line.text, { "", 11.0f, false, false, PdfFontSlot::Regular, 0.08f, 0.09f, 0.11f }, kTextWidth);
+            break;
+        }
+    });
+    if (pageObjectIds.empty() || stream.tellp() > 0) { flushPage(); }
+
+    // Fonts go last: subsets can only be built once every page has been laid out
+    for (const PdfFont& font : pdfFonts) {
+        if (!font.embedded) {
+            writer.WriteObject(font.objectId,
+                               std::string("<< /Type /Font /Subtype /Type1 /BaseFont /") + font.standardName + " /Encoding /WinAnsiEncoding >>");
+        } else if (!font.syntheticBold) { // Synthetic bold shares the regular font's objects
+            WriteEmbeddedFontObjects(writer, *font.embedded);
+        }
+    }
+
+    std::string kids;
+    for (int pageObjId : pageObjectIds) {
+        kids += std::to_string(pageObjId) + " 0 R ";
+    }
+    writer.WriteObject(kPagesObjectId, "<< /Type /Pages /Count " + std::to_string(pageObjectIds.size()) + " /Kids [ " + kids +
+                                           "] /Resources << /Font << /F1 " + std::to_string(pdfFonts[0].objectId) + " 0 R /F2 " +
+                                           std::to_string(pdfFonts[1].objectId) + " 0 R /F3 " + std::to_string(pdfFonts[2].objectId) +
+                                           " 0 R >> >> >>");
+    writer.WriteObject(kCatalogObjectId, "<< /Type /Catalog /Pages " + std::to_string(kPagesObjectId) + " 0 R >>");
+
+    const int infoObjId = writer.ReserveObject();
+    writer.WriteObject(infoObjId, "<< /Title " + PdfTextString(title) + " >>");
+    writer.Finish(infoObjId);
+    return out.good();
+}
+
+std::string BuildMarkdownPdf(const std::string& title, const std::string& markdownText, const NotesPdfFonts& fonts) {
+    std::ostringstream out;
+    WriteMarkdownPdf(out, title, markdownText, fonts);
+    return out.str();
+}
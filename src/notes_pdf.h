@@ -0,0 +1,22 @@
+#pragma once
+
+#include <filesystem>
+#include <ostream>
+#include <string>
+
+// Markdown to PDF export for the notes overlay. Platform-neutral.
+// Pages are laid out one at a time and each content stream is Flate-compressed and written out as soon as its page
+// is full, so memory use does not grow with the length of the note. Text wraps by real glyph widths. TrueType fonts
+// are embedded as subsets holding only the glyphs the document uses (any Unicode text the font covers); without a
+// usable font file the export falls back to the standard Helvetica fonts (ASCII only).
+
+struct NotesPdfFonts {
+    std::filesystem::path regular; // TrueType (.ttf / .ttc) file
+    std::filesystem::path bold;    // Empty: a bold face next to `regular` (arialbd.ttf, Name-Bold.ttf, ...), else synthetic bold
+};
+
+// Letter-size pages. Returns false if writing to `out` failed.
+bool WriteMarkdownPdf(std::ostream& out, const std::string& title, const std::string& markdownText, const NotesPdfFonts& fonts);
+
+// Same, returning the file contents
+std::string BuildMarkdownPdf(const std::string& title, const std::string& markdownText, const NotesPdfFonts& fonts = {});
@@ -0,0 +1,213 @@
+#include "notes_persistence.h"
+#include "notes_pdf.h"
+
+#include <condition_variable>
+#include <deque>
+#include <fstream>
+#include <mutex>
+#include <thread>
+
+#ifdef _WIN32
+#include <Windows.h>
+#endif
+
+static std::thread s_persistThread;
+static std::mutex s_persistMutex;
+static std::condition_variable s_persistCv;
+
+// Protected by s_persistMutex
+static bool s_persistRunning = false;
+static bool s_persistStopRequested = false;
+static uint64_t s_persistNextTicket = 1;
+static std::deque<std::pair<uint64_t, NotesPersistRequest>> s_persistQueue;
+static std::vector<NotesPersistResult> s_persistResults;
+
+static std::filesystem::path PathFromUtf8(const std::string& text) {
+    return std::filesystem::path(std::u8string(text.begin(), text.end()));
+}
+
+static std::string PathToUtf8(const std::filesystem::path& path) {
+    const std::u8string text = path.u8string();
+    return std::string(text.begin(), text.end());
+}
+
+// Case-insensitive (ASCII) lexical comparison, matching how the overlay keys paths
+static bool SamePathLoose(const std::filesystem::path& a, const std::filesystem::path& b) {
+    std::wstring aw = a.lexically_normal().wstring();
+    std::wstring bw = b.lexically_normal().wstring();
+    if (aw.size() != bw.size()) return false;
+    for (size_t i = 0; i < aw.size(); ++i) {
+        const wchar_t ca = (aw[i] >= L'A' && aw[i] <= L'Z') ? static_cast<wchar_t>(aw[i] - L'A' + L'a') : aw[i];
+        const wchar_t cb = (bw[i] >= L'A' && bw[i] <= L'Z') ? static_cast<wchar_t>(bw[i] - L'A' + L'a') : bw[i];
+        if (ca != cb) return false;
+    }
+    return true;
+}
+
+static bool PathExists(const std::filesystem::path& path) {
+    std::error_code ec;
+    return std::filesystem::exists(path, ec);
+}
+
+static std::filesystem::path UniquePathNextTo(const std::filesystem::path& folder, const std::string& fileBase, const std::string& extension) {
+    std::filesystem::path target = folder / PathFromUtf8(fileBase + extension);
+    for (int suffix = 1; PathExists(target) && suffix < 100000; ++suffix) {
+        target = folder / PathFromUtf8(fileBase + "_" + std::to_string(suffix) + extension);
+    }
+    return target;
+}
+
+bool WriteFileAtomic(const std::filesystem::path& path, const std::function<bool(std::ostream&)>& write) {
+    std::filesystem::path tempPath = path;
+    tempPath += ".tmp";
+    {
+        std::ofstream out(tempPath, std::ios::binary | std::ios::trunc);
+        if (!out.is_open()) return false;
+        const bool written = write(out);
+        out.flush();
+        if (!written || !out.good()) {
+            out.close();
+            std::error_code ec;
+            std::filesystem::remove(tempPath, ec);
+            return false;
+        }
+    }
+
+    // Replaces an existing file in one step (MoveFileEx with MOVEFILE_REPLACE_EXISTING on Windows, rename() elsewhere)
+    std::error_code ec;
+    std::filesystem::rename(tempPath, path, ec);
+    if (ec) {
+        std::filesystem::remove(tempPath, ec);
+        return false;
+    }
+    return true;
+}
+
+bool WriteFileAtomic(const std::filesystem::path& path, const std::string& data) {
+    return WriteFileAtomic(path, [&data](std::ostream& out) {
+        out.write(data.data(), static_cast<std::streamsize>(data.size()));
+        return true;
+    });
+}
+
+static NotesPersistResult RunNotesPersistRequest(uint64_t ticket, const NotesPersistRequest& request) {
+    NotesPersistResult result;
+    result.ticket = ticket;
+    result.request = request;
+    static const std::string kEmpty;
+    const std::string& text = request.text ? *request.text : kEmpty;
+
+    const bool hasCurrent = !request.currentPath.empty();
+    const std::filesystem::path folder = hasCurrent ? request.currentPath.parent_path() : request.folder;
+    std::filesystem::path target = request.fileBase.empty() && hasCurrent ? request.currentPath
+                                                                         : folder / PathFromUtf8(request.fileBase + request.extension);
+    const bool renaming = hasCurrent && !SamePathLoose(request.currentPath, target);
+
+    if ((!hasCurrent || renaming) && PathExists(target)) {
+        switch (request.onConflict) {
+        case NotesConflictPolicy::Report:
+            result.status = NotesPersistStatus::Conflict;
+            result.conflictPath = target;
+            return result;
+        case NotesConflictPolicy::Uniquify:
+            target = UniquePathNextTo(folder, request.fileBase, request.extension);
+            break;
+        case NotesConflictPolicy::Overwrite:
+            break;
+        }
+    }
+
+    std::error_code ec;
+    std::filesystem::create_directories(target.parent_path(), ec);
+
+    bool ok = false;
+    if (request.kind == NotesPersistKind::Pdf) {
+        // Pages stream straight into the temp file
+        ok = WriteFileAtomic(target, [&](std::ostream& out) { return WriteMarkdownPdf(out, request.title, text, request.pdfFonts); });
+    } else {
+        ok = WriteFileAtomic(target, text);
+    }
+    if (ok && renaming && PathExists(request.currentPath)) {
+        // The new name holds the latest text; drop the old one
+        std::filesystem::remove(request.currentPath, ec);
+        if (ec) { result.error = "wrote " + PathToUtf8(target) + " but could not remove the old file"; }
+    }
+
+    result.status = ok ? NotesPersistStatus::Written : NotesPersistStatus::Failed;
+    if (ok) {
+        result.writtenPath = target;
+    } else {
+        result.error = "could not write " + PathToUtf8(target);
+    }
+    return result;
+}
+
+static void NotesPersistenceThreadFunc() {
+#if defined(_WIN32)
+    // Lowers both CPU and I/O priority so note saves never compete with the game
+    SetThreadPriority(GetCurrentThread(), THREAD_MODE_BACKGROUND_BEGIN);
+#endif
+
+    std::unique_lock<std::mutex> lock(s_persistMutex);
+    while (true) {
+        s_persistCv.wait(lock, [] { return s_persistStopRequested || !s_persistQueue.empty(); });
+        if (s_persistQueue.empty()) {
+            if (s_persistStopRequested) break;
+            continue;
+        }
+
+        auto [ticket, request] = std::move(s_persistQueue.front());
+        s_persistQueue.pop_front();
+        lock.unlock();
+
+        NotesPersistResult result;
+        result.ticket = ticket;
+        result.request = request;
+        try {
+            result = RunNotesPersistRequest(ticket, request);
+        } catch (const std::exception& e) { result.error = e.what(); }
+
+        lock.lock();
+        s_persistResults.push_back(std::move(result));
+    }
+
+#if defined(_WIN32)
+    SetThreadPriority(GetCurrentThread(), THREAD_MODE_BACKGROUND_END);
+#endif
+}
+
+uint64_t EnqueueNotesPersist(NotesPersistRequest request) {
+    uint64_t ticket = 0;
+    {
+        std::lock_guard<std::mutex> lock(s_persistMutex);
+        ticket = s_persistNextTicket++;
+        s_persistQueue.emplace_back(ticket, std::move(request));
+        if (!s_persistRunning) {
+            s_persistStopRequested = false;
+            s_persistRunning = true;
+            s_persistThread = std::thread(NotesPersistenceThreadFunc);
+        }
+    }
+    s_persistCv.notify_one();
+    return ticket;
+}
+
+std::vector<NotesPersistResult> TakeNotesPersistResults() {
+    std::vector<NotesPersistResult> results;
+    std::lock_guard<std::mutex> lock(s_persistMutex);
+    results.swap(s_persistResults);
+    return results;
+}
+
+void StopNotesPersistenceThread() {
+    {
+        std::lock_guard<std::mutex> lock(s_persistMutex);
+        if (!s_persistRunning) return;
+        s_persistStopRequested = true;
+    }
+    s_persistCv.notify_all();
+    if (s_persistThread.joinable()) { s_persistThread.join(); }
+
+    std::lock_guard<std::mutex> lock(s_persistMutex);
+    s_persistRunning = false;
+}
@@ -0,0 +1,69 @@
+#pragma once
+
+#include "notes_pdf.h"
+
+#include <cstdint>
+#include <filesystem>
+#include <functional>
+#include <memory>
+#include <ostream>
+#include <string>
+#include <vector>
+
+// Background writer for the notes overlay.
+// The overlay hands over immutable draft snapshots; a low-priority worker resolves the target file name, renames the
+// note when its title changed, renders PDFs, and replaces files atomically (temp file + rename). Results are queued
+// for the overlay to collect on its next frame, so no note save or export touches the disk on the render thread.
+// Requests run in order. The overlay keeps at most one save per draft in flight and sends only the newest snapshot
+// once it lands, so a burst of edits costs one write. Platform-neutral: the worker doesn't log; problems come back in
+// NotesPersistResult::error for the caller to report.
+
+enum class NotesPersistKind : int { Markdown = 0, Pdf };
+
+enum class NotesConflictPolicy : int {
+    Uniquify = 0, // Write next to an existing file as name_1, name_2, ...
+    Report,       // Don't write; report the conflict so the user can choose
+    Overwrite
+};
+
+enum class NotesPersistStatus : int { Written = 0, Conflict, Failed };
+
+struct NotesPersistRequest {
+    NotesPersistKind kind = NotesPersistKind::Markdown;
+
+    // Markdown: the file currently holding this note (empty for a new note). The target is currentPath's folder (or
+    // `folder` for a new note) / fileBase + extension; a changed name renames currentPath.
+    std::filesystem::path currentPath;
+    std::filesystem::path folder;
+    std::string fileBase; // UTF-8 stem
+    std::string extension = ".md";
+    NotesConflictPolicy onConflict = NotesConflictPolicy::Uniquify;
+
+    std::string title; // PDF document title
+    NotesPdfFonts pdfFonts;
+    std::shared_ptr<const std::string> text;
+};
+
+struct NotesPersistResult {
+    uint64_t ticket = 0;
+    NotesPersistStatus status = NotesPersistStatus::Failed;
+    std::filesystem::path writtenPath;  // Written: the file now holding the text
+    std::filesystem::path conflictPath; // Conflict: the existing file that blocked the write
+    std::string error;                  // Failed: why; Written: anything that went wrong after the write
+    NotesPersistRequest request; // Echoed back so the caller can retry or re-offer the text
+};
+
+// Queues a request (starting the worker on first use) and returns its ticket (never 0)
+uint64_t EnqueueNotesPersist(NotesPersistRequest request);
+
+// Finished requests since the last call, in completion order (one per ticket)
+std::vector<NotesPersistResult> TakeNotesPersistResults();
+
+// Writes everything still queued before returning
+void StopNotesPersistenceThread();
+
+// Write to `path`.tmp, then rename over `path`
+bool WriteFileAtomic(const std::filesystem::path& path, const std::string& data);
+
+// Same, with the contents produced by `write` (return false to abandon the write)
+bool WriteFileAtomic(const std::filesystem::path& path, const std::function<bool(std::ostream&)>& write);
@@ -0,0 +1,188 @@
+#include "notes_search.h"
+
+#include <algorithm>
+#include <cmath>
+#include <cstddef>
+#include <unordered_map>
+
+namespace {
+
+// BM25 parameters for the body; a title match adds kTitleWeight * idf (saturating with repeats)
+constexpr float kBm25K1 = 1.2f;
+constexpr float kBm25B = 0.75f;
+constexpr float kTitleWeight = 2.5f;
+
+bool IsTokenByte(unsigned char c) {
+    return (c >= '0' && c <= '9') || (c >= 'a' && c <= 'z') || (c >= 'A' && c <= 'Z') || c >= 0x80;
+}
+
+} // namespace
+
+void NotesSearchIndex::Tokenize(std::string_view text, std::vector<std::string>& out) {
+    out.clear();
+    std::string token;
+    for (size_t i = 0; i <= text.size(); ++i) {
+        const unsigned char c = i < text.size() ? static_cast<unsigned char>(text[i]) : ' ';
+        if (IsTokenByte(c)) {
+            if (token.size() < kMaxTokenLength) { token.push_back(c >= 'A' && c <= 'Z' ? static_cast<char>(c - 'A' + 'a') : static_cast<char>(c)); }
+            continue;
+        }
+        if (!token.empty()) {
+            out.push_back(std::move(token));
+            token.clear();
+        }
+    }
+}
+
+void NotesSearchIndex::Upsert(const std::string& key, std::string_view title, std::string_view body) {
+    Remove(key);
+
+    uint32_t docId = 0;
+    if (!m_freeDocs.empty()) {
+        docId = m_freeDocs.back();
+        m_freeDocs.pop_back();
+    } else {
+        docId = static_cast<uint32_t>(m_docs.size());
+        m_docs.emplace_back();
+    }
+
+    struct Counts {
+        uint32_t title = 0;
+        uint32_t body = 0;
+    };
+    std::unordered_map<std::string, Counts> counts;
+    std::vector<std::string> tokens;
+    Tokenize(title, tokens);
+    for (std::string& token : tokens) { counts[std::move(token)].title++; }
+    Tokenize(body, tokens);
+    for (std::string& token : tokens) { counts[std::move(token)].body++; }
+
+    Document& doc = m_docs[docId];
+    doc.key = key;
+    doc.live = true;
+    doc.bodyLength = static_cast<uint32_t>(tokens.size());
+    doc.terms.clear();
+    doc.terms.reserve(counts.size());
+    for (auto& [term, count] : counts) {
+        Posting posting;
+        posting.doc = docId;
+        posting.titleCount = static_cast<uint16_t>(std::min<uint32_t>(count.title, UINT16_MAX));
+        posting.bodyCount = static_cast<uint16_t>(std::min<uint32_t>(count.body, UINT16_MAX));
+        auto it = m_terms.find(term);
+        if (it == m_terms.end()) { it = m_terms.emplace(term, std::vector<Posting>()).first; }
+        it->second.push_back(posting);
+        doc.terms.push_back(term);
+    }
+
+    m_totalBodyLength += doc.bodyLength;
+    m_keyToDoc[key] = docId;
+}
+
+void NotesSearchIndex::Remove(const std::string& key) {
+    auto keyIt = m_keyToDoc.find(key);
+    if (keyIt == m_keyToDoc.end()) return;
+    const uint32_t docId = keyIt->second;
+    m_keyToDoc.erase(keyIt);
+
+    Document& doc = m_docs[docId];
+    for (const std::string& term : doc.terms) {
+        auto it = m_terms.find(term);
+        if (it == m_terms.end()) continue;
+        std::vector<Posting>& postings = it->second;
+        for (size_t i = 0; i < postings.size(); ++i) {
+            if (postings[i].doc != docId) continue;
+            postings[i] = postings.back();
+            postings.pop_back();
+            break;
+        }
+        if (postings.empty()) { m_terms.erase(it); }
+    }
+
+    m_totalBodyLength -= doc.bodyLength;
+    doc = Document();
+    m_freeDocs.push_back(docId);
+}
+
+void NotesSearchIndex::Clear() {
+    m_terms.clear();
+    m_docs.clear();
+    m_freeDocs.clear();
+    m_keyToDoc.clear();
+    m_totalBodyLength = 0;
+}
+
+void NotesSearchIndex::AccumulateTerm(const std::vector<Posting>& postings, std::vector<float>& termScores) const {
+    const float docCount = static_cast<float>(m_keyToDoc.size());
+    const float df = static_cast<float>(postings.size());
+    const float idf = std::log(1.0f + (docCount - df + 0.5f) / (df + 0.5f));
+    const float avgLength = std::max(1.0f, static_cast<float>(m_totalBodyLength) / std::max(1.0f, docCount));
+
+    for (const Posting& posting : postings) {
+        const Document& doc = m_docs[posting.doc];
+        const float tf = static_cast<float>(posting.bodyCount);
+        const float lengthNorm = kBm25K1 * (1.0f - kBm25B + kBm25B * static_cast<float>(doc.bodyLength) / avgLength);
+        float score = idf * tf * (kBm25K1 + 1.0f) / (tf + lengthNorm);
+        if (posting.titleCount > 0) {
+            const float titleTf = static_cast<float>(posting.titleCount);
+            score += kTitleWeight * idf * titleTf / (titleTf + 0.5f);
+        }
+        // A prefix can expand to several terms of the same document; the best one counts
+        termScores[posting.doc] = std::max(termScores[posting.doc], score);
+    }
+}
+
+std::vector<NotesSearchIndex::Hit> NotesSearchIndex::Search(std::string_view query, size_t maxResults) const {
+    std::vector<Hit> hits;
+    std::vector<std::string> terms;
+    Tokenize(query, terms);
+    if (terms.empty() || maxResults == 0 || m_keyToDoc.empty()) return hits;
+
+    // Only a query ending mid-word treats its last term as a prefix ("pear" finds "pearls", "pear " does not)
+    const bool lastIsPrefix = !query.empty() && IsTokenByte(static_cast<unsigned char>(query.back()));
+
+    const size_t docSlots = m_docs.size();
+    m_scores.assign(docSlots, 0.0f);
+    m_matchedTerms.assign(docSlots, 0);
+
+    for (size_t t = 0; t < terms.size(); ++t) {
+        const std::string& term = terms[t];
+        m_termScores.assign(docSlots, 0.0f);
+        if (lastIsPrefix && t + 1 == terms.size()) {
+            size_t expansions = 0;
+            for (auto it = m_terms.lower_bound(term); it != m_terms.end() && expansions < kMaxPrefixExpansions; ++it, ++expansions) {
+                if (it->first.compare(0, term.size(), term) != 0) break;
+                AccumulateTerm(it->second, m_termScores);
+            }
+        } else {
+            auto it = m_terms.find(term);
+            if (it == m_terms.end()) return hits; // Every term must match
+            AccumulateTerm(it->second, m_termScores);
+        }
+
+        for (size_t d = 0; d < docSlots; ++d) {
+            if (m_termScores[d] <= 0.0f) continue;
+            m_scores[d] += m_termScores[d];
+            m_matchedTerms[d]++;
+        }
+    }
+
+    // Rank doc ids first; only the returned hits copy their key
+    const uint16_t required = static_cast<uint16_t>(std::min<size_t>(terms.size(), UINT16_MAX));
+    std::vector<uint32_t> ranked;
+    for (size_t d = 0; d < docSlots; ++d) {
+        if (m_docs[d].live && m_matchedTerms[d] == required) { ranked.push_back(static_cast<uint32_t>(d)); }
+    }
+
+    auto better = [this](uint32_t a, uint32_t b) {
+        if (m_scores[a] != m_scores[b]) return m_scores[a] > m_scores[b];
+        return m_docs[a].key < m_docs[b].key;
+    };
+    const size_t count = std::min(maxResults, ranked.size());
+    std::partial_sort(ranked.begin(), ranked.begin() + static_cast<std::ptrdiff_t>(count), ranked.end(), better);
+
+    hits.reserve(count);
+    for (size_t i = 0; i < count; ++i) {
+        hits.push_back({ m_docs[ranked[i]].key, m_scores[ranked[i]] });
+    }
+    return hits;
+}
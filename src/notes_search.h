@@ -0,0 +1,65 @@
+#pragma once
+
+#include <cstdint>
+#include <map>
+#include <string>
+#include <string_view>
+#include <vector>
+
+// In-memory inverted index over note titles and bodies. Platform-neutral; not thread-safe (the notes index service
+// serializes access).
+//
+// - Tokens are runs of ASCII letters/digits (lowercased) or non-ASCII UTF-8 bytes, so accented and CJK words stay
+//   whole; everything else separates tokens.
+// - Upsert/Remove touch only the postings of the document involved.
+// - Search: every query term must match (the last one as a prefix, for search-as-you-type). Documents are ranked by
+//   BM25 over the body plus a weighted title match.
+class NotesSearchIndex {
+  public:
+    struct Hit {
+        std::string key;
+        float score = 0.0f;
+    };
+
+    static constexpr size_t kMaxTokenLength = 48;
+    static constexpr size_t kMaxPrefixExpansions = 64; // Distinct terms a prefix may expand to
+
+    void Upsert(const std::string& key, std::string_view title, std::string_view body);
+    void Remove(const std::string& key);
+    void Clear();
+
+    std::vector<Hit> Search(std::string_view query, size_t maxResults) const;
+
+    size_t DocumentCount() const { return m_keyToDoc.size(); }
+    size_t TermCount() const { return m_terms.size(); }
+
+    // Lowercased tokens of text, in order (exposed for the query parser and for checking tokenization)
+    static void Tokenize(std::string_view text, std::vector<std::string>& out);
+
+  private:
+    struct Posting {
+        uint32_t doc = 0;
+        uint16_t titleCount = 0;
+        uint16_t bodyCount = 0;
+    };
+
+    struct Document {
+        std::string key;
+        std::vector<std::string> terms; // Distinct terms, for removal
+        uint32_t bodyLength = 0;        // Tokens
+        bool live = false;
+    };
+
+    void AccumulateTerm(const std::vector<Posting>& postings, std::vector<float>& termScores) const;
+
+    std::map<std::string, std::vector<Posting>, std::less<>> m_terms;
+    std::vector<Document> m_docs;
+    std::vector<uint32_t> m_freeDocs;
+    std::map<std::string, uint32_t, std::less<>> m_keyToDoc;
+    uint64_t m_totalBodyLength = 0;
+
+    // Search scratch, sized to m_docs
+    mutable std::vector<float> m_scores;
+    mutable std::vector<float> m_termScores;
+    mutable std::vector<uint16_t> m_matchedTerms;
+};
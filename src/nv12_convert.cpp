@@ -0,0 +1,377 @@
+#include "nv12_convert.h"
+
+#include <algorithm>
+#include <condition_variable>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+#if defined(_M_X64) || defined(_M_IX86) || defined(__x86_64__) || defined(__i386__)
+#define NV12_HAS_X86_KERNELS 1
+#if defined(_MSC_VER) && !defined(__clang__)
+#include <intrin.h>
+#include <immintrin.h>
+// MSVC allows intrinsics for any ISA without per-function target attributes
+#define NV12_TARGET_SSE41
+#define NV12_TARGET_AVX2
+#else
+#include <cpuid.h>
+#include <immintrin.h>
+#define NV12_TARGET_SSE41 __attribute__((target("sse4.1")))
+#define NV12_TARGET_AVX2 __attribute__((target("avx2")))
+#endif
+#else
+#define NV12_HAS_X86_KERNELS 0
+#endif
+
+namespace {
+
+// Every kernel converts output rows [rowBegin, rowEnd) (rowBegin even) of the full frame.
+using Nv12RowKernelFn = void (*)(const uint8_t* rgba, uint8_t* nv12, uint32_t width, uint32_t height, uint32_t rowBegin,
+                                 uint32_t rowEnd);
+
+// Reference fixed-point conversion for columns [xBegin, width) of one output row pair.
+// Y = ((66*R + 129*G + 25*B + 128) >> 8) + 16 stays within [16, 235] and U/V within [16, 240] for 8-bit input,
+// so no clamping is needed.
+inline void ConvertRowPairScalar(const uint8_t* srcRow0, const uint8_t* srcRow1, uint8_t* yRow0, uint8_t* yRow1, uint8_t* uvRow,
+                                 uint32_t xBegin, uint32_t width) {
+    for (uint32_t x = xBegin; x < width; x += 2) {
+        const uint8_t* p00 = srcRow0 + x * 4;
+        const uint8_t* p10 = srcRow0 + (x + 1) * 4;
+        const uint8_t* p01 = srcRow1 + x * 4;
+        const uint8_t* p11 = srcRow1 + (x + 1) * 4;
+
+        yRow0[x] = static_cast<uint8_t>(((66 * p00[0] + 129 * p00[1] + 25 * p00[2] + 128) >> 8) + 16);
+        yRow0[x + 1] = static_cast<uint8_t>(((66 * p10[0] + 129 * p10[1] + 25 * p10[2] + 128) >> 8) + 16);
+        yRow1[x] = static_cast<uint8_t>(((66 * p01[0] + 129 * p01[1] + 25 * p01[2] + 128) >> 8) + 16);
+        yRow1[x + 1] = static_cast<uint8_t>(((66 * p11[0] + 129 * p11[1] + 25 * p11[2] + 128) >> 8) + 16);
+
+        // Average RGB of 2x2 block for chroma
+        const int32_t avgR = (p00[0] + p10[0] + p01[0] + p11[0] + 2) >> 2;
+        const int32_t avgG = (p00[1] + p10[1] + p01[1] + p11[1] + 2) >> 2;
+        const int32_t avgB = (p00[2] + p10[2] + p01[2] + p11[2] + 2) >> 2;
+
+        uvRow[x] = static_cast<uint8_t>(((-38 * avgR - 74 * avgG + 112 * avgB + 128) >> 8) + 128);
+        uvRow[x + 1] = static_cast<uint8_t>(((112 * avgR - 94 * avgG - 18 * avgB + 128) >> 8) + 128);
+    }
+}
+
+struct RowPair {
+    const uint8_t* srcRow0;
+    const uint8_t* srcRow1;
+    uint8_t* yRow0;
+    uint8_t* yRow1;
+    uint8_t* uvRow;
+};
+
+inline RowPair GetRowPair(const uint8_t* rgba, uint8_t* nv12, uint32_t width, uint32_t height, uint32_t y) {
+    const size_t stride = static_cast<size_t>(width) * 4;
+    RowPair rows;
+    rows.srcRow0 = rgba + (height - 1 - y) * stride; // Source rows are flipped (bottom-up -> top-down)
+    rows.srcRow1 = rgba + (height - 2 - y) * stride;
+    rows.yRow0 = nv12 + static_cast<size_t>(y) * width;
+    rows.yRow1 = rows.yRow0 + width;
+    rows.uvRow = nv12 + static_cast<size_t>(width) * height + static_cast<size_t>(y / 2) * width;
+    return rows;
+}
+
+void ConvertRowsScalar(const uint8_t* rgba, uint8_t* nv12, uint32_t width, uint32_t height, uint32_t rowBegin, uint32_t rowEnd) {
+    for (uint32_t y = rowBegin; y < rowEnd; y += 2) {
+        const RowPair r = GetRowPair(rgba, nv12, width, height, y);
+        ConvertRowPairScalar(r.srcRow0, r.srcRow1, r.yRow0, r.yRow1, r.uvRow, 0, width);
+    }
+}
+
+#if NV12_HAS_X86_KERNELS
+
+// 4 RGBA pixels -> 4 x int32 luma
+NV12_TARGET_SSE41 inline __m128i LumaX4Sse(__m128i px, __m128i zero, __m128i coeffY) {
+    const __m128i lo = _mm_madd_epi16(_mm_unpacklo_epi8(px, zero), coeffY);
+    const __m128i hi = _mm_madd_epi16(_mm_unpackhi_epi8(px, zero), coeffY);
+    const __m128i sum = _mm_hadd_epi32(lo, hi);
+    return _mm_add_epi32(_mm_srai_epi32(_mm_add_epi32(sum, _mm_set1_epi32(128)), 8), _mm_set1_epi32(16));
+}
+
+// 2x2 blocks from 4 pixels of each row -> [U0, V0, U1, V1] as int32
+NV12_TARGET_SSE41 inline __m128i ChromaX2Sse(__m128i top, __m128i bottom, __m128i zero, __m128i coeffU, __m128i coeffV) {
+    const __m128i sum01 = _mm_add_epi16(_mm_unpacklo_epi8(top, zero), _mm_unpacklo_epi8(bottom, zero));
+    const __m128i sum23 = _mm_add_epi16(_mm_unpackhi_epi8(top, zero), _mm_unpackhi_epi8(bottom, zero));
+    const __m128i blocks = _mm_add_epi16(_mm_unpacklo_epi64(sum01, sum23), _mm_unpackhi_epi64(sum01, sum23));
+    const __m128i avg = _mm_srli_epi16(_mm_add_epi16(blocks, _mm_set1_epi16(2)), 2);
+    __m128i uv = _mm_hadd_epi32(_mm_madd_epi16(avg, coeffU), _mm_madd_epi16(avg, coeffV)); // U0 U1 V0 V1
+    uv = _mm_add_epi32(_mm_srai_epi32(_mm_add_epi32(uv, _mm_set1_epi32(128)), 8), _mm_set1_epi32(128));
+    return _mm_shuffle_epi32(uv, _MM_SHUFFLE(3, 1, 2, 0));
+}
+
+NV12_TARGET_SSE41 void ConvertRowsSse41(const uint8_t* rgba, uint8_t* nv12, uint32_t width, uint32_t height, uint32_t rowBegin,
+                                        uint32_t rowEnd) {
+    const __m128i zero = _mm_setzero_si128();
+    const __m128i coeffY = _mm_setr_epi16(66, 129, 25, 0, 66, 129, 25, 0);
+    const __m128i coeffU = _mm_setr_epi16(-38, -74, 112, 0, -38, -74, 112, 0);
+    const __m128i coeffV = _mm_setr_epi16(112, -94, -18, 0, 112, -94, -18, 0);
+    const uint32_t simdWidth = width & ~7u;
+
+    for (uint32_t y = rowBegin; y < rowEnd; y += 2) {
+        const RowPair r = GetRowPair(rgba, nv12, width, height, y);
+        for (uint32_t x = 0; x < simdWidth; x += 8) {
+            const __m128i t0 = _mm_loadu_si128(reinterpret_cast<const __m128i*>(r.srcRow0 + x * 4));
+            const __m128i t1 = _mm_loadu_si128(reinterpret_cast<const __m128i*>(r.srcRow0 + x * 4 + 16));
+            const __m128i b0 = _mm_loadu_si128(reinterpret_cast<const __m128i*>(r.srcRow1 + x * 4));
+            const __m128i b1 = _mm_loadu_si128(reinterpret_cast<const __m128i*>(r.srcRow1 + x * 4 + 16));
+
+            const __m128i yTop = _mm_packs_epi32(LumaX4Sse(t0, zero, coeffY), LumaX4Sse(t1, zero, coeffY));
+            const __m128i yBottom = _mm_packs_epi32(LumaX4Sse(b0, zero, coeffY), LumaX4Sse(b1, zero, coeffY));
+            const __m128i yBytes = _mm_packus_epi16(yTop, yBottom);
+            _mm_storel_epi64(reinterpret_cast<__m128i*>(r.yRow0 + x), yBytes);
+            _mm_storel_epi64(reinterpret_cast<__m128i*>(r.yRow1 + x), _mm_srli_si128(yBytes, 8));
+
+            const __m128i uv = _mm_packs_epi32(ChromaX2Sse(t0, b0, zero, coeffU, coeffV), ChromaX2Sse(t1, b1, zero, coeffU, coeffV));
+            _mm_storel_epi64(reinterpret_cast<__m128i*>(r.uvRow + x), _mm_packus_epi16(uv, uv));
+        }
+        ConvertRowPairScalar(r.srcRow0, r.srcRow1, r.yRow0, r.yRow1, r.uvRow, simdWidth, width);
+    }
+}
+
+NV12_TARGET_AVX2 inline __m256i LumaX8Avx2(__m256i px, __m256i zero, __m256i coeffY) {
+    const __m256i lo = _mm256_madd_epi16(_mm256_unpacklo_epi8(px, zero), coeffY);
+    const __m256i hi = _mm256_madd_epi16(_mm256_unpackhi_epi8(px, zero), coeffY);
+    const __m256i sum = _mm256_hadd_epi32(lo, hi);
+    return _mm256_add_epi32(_mm256_srai_epi32(_mm256_add_epi32(sum, _mm256_set1_epi32(128)), 8), _mm256_set1_epi32(16));
+}
+
+NV12_TARGET_AVX2 inline __m256i ChromaX4Avx2(__m256i top, __m256i bottom, __m256i zero, __m256i coeffU, __m256i coeffV) {
+    const __m256i sum01 = _mm256_add_epi16(_mm256_unpacklo_epi8(top, zero), _mm256_unpacklo_epi8(bottom, zero));
+    const __m256i sum23 = _mm256_add_epi16(_mm256_unpackhi_epi8(top, zero), _mm256_unpackhi_epi8(bottom, zero));
+    const __m256i blocks = _mm256_add_epi16(_mm256_unpacklo_epi64(sum01, sum23), _mm256_unpackhi_epi64(sum01, sum23));
+    const __m256i avg = _mm256_srli_epi16(_mm256_add_epi16(blocks, _mm256_set1_epi16(2)), 2);
+    __m256i uv = _mm256_hadd_epi32(_mm256_madd_epi16(avg, coeffU), _mm256_madd_epi16(avg, coeffV));
+    uv = _mm256_add_epi32(_mm256_srai_epi32(_mm256_add_epi32(uv, _mm256_set1_epi32(128)), 8), _mm256_set1_epi32(128));
+    return _mm256_shuffle_epi32(uv, _MM_SHUFFLE(3, 1, 2, 0));
+}
+
+// Same math as the SSE kernel, 16 pixels per iteration. In-lane packs leave dwords interleaved across the two
+// 128-bit lanes; a single permute restores pixel order.
+NV12_TARGET_AVX2 void ConvertRowsAvx2(const uint8_t* rgba, uint8_t* nv12, uint32_t width, uint32_t height, uint32_t rowBegin,
+                                      uint32_t rowEnd) {
+    const __m256i zero = _mm256_setzero_si256();
+    const __m256i coeffY = _mm256_setr_epi16(66, 129, 25, 0, 66, 129, 25, 0, 66, 129, 25, 0, 66, 129, 25, 0);
+    const __m256i coeffU = _mm256_setr_epi16(-38, -74, 112, 0, -38, -74, 112, 0, -38, -74, 112, 0, -38, -74, 112, 0);
+    const __m256i coeffV = _mm256_setr_epi16(112, -94, -18, 0, 112, -94, -18, 0, 112, -94, -18, 0, 112, -94, -18, 0);
+    const __m256i laneOrder = _mm256_setr_epi32(0, 4, 1, 5, 2, 6, 3, 7);
+    const uint32_t simdWidth = width & ~15u;
+
+    for (uint32_t y = rowBegin; y < rowEnd; y += 2) {
+        const RowPair r = GetRowPair(rgba, nv12, width, height, y);
+        for (uint32_t x = 0; x < simdWidth; x += 16) {
+            const __m256i t0 = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(r.srcRow0 + x * 4));
+            const __m256i t1 = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(r.srcRow0 + x * 4 + 32));
+            const __m256i b0 = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(r.srcRow1 + x * 4));
+            const __m256i b1 = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(r.srcRow1 + x * 4 + 32));
+
+            const __m256i yTop = _mm256_packs_epi32(LumaX8Avx2(t0, zero, coeffY), LumaX8Avx2(t1, zero, coeffY));
+            const __m256i yBottom = _mm256_packs_epi32(LumaX8Avx2(b0, zero, coeffY), LumaX8Avx2(b1, zero, coeffY));
+            const __m256i yBytes = _mm256_permutevar8x32_epi32(_mm256_packus_epi16(yTop, yBottom), laneOrder);
+            _mm_storeu_si128(reinterpret_cast<__m128i*>(r.yRow0 + x), _mm256_castsi256_si128(yBytes));
+            _mm_storeu_si128(reinterpret_cast<__m128i*>(r.yRow1 + x), _mm256_extracti128_si256(yBytes, 1));
+
+            const __m256i uv16 =
+                _mm256_packs_epi32(ChromaX4Avx2(t0, b0, zero, coeffU, coeffV), ChromaX4Avx2(t1, b1, zero, coeffU, coeffV));
+            const __m256i uvBytes = _mm256_permutevar8x32_epi32(_mm256_packus_epi16(uv16, uv16), laneOrder);
+            _mm_storeu_si128(reinterpret_cast<__m128i*>(r.uvRow + x), _mm256_castsi256_si128(uvBytes));
+        }
+        ConvertRowPairScalar(r.srcRow0, r.srcRow1, r.yRow0, r.yRow1, r.uvRow, simdWidth, width);
+    }
+}
+
+struct CpuFeatures {
+    bool sse41 = false;
+    bool avx2 = false;
+};
+
+CpuFeatures DetectCpuFeatures() {
+    CpuFeatures features;
+#if defined(_MSC_VER) && !defined(__clang__)
+    int regs[4] = {};
+    __cpuid(regs, 0);
+    const int maxLeaf = regs[0];
+    __cpuid(regs, 1);
+    features.sse41 = (regs[2] & (1 << 19)) != 0;
+    const bool osxsave = (regs[2] & (1 << 27)) != 0;
+    const bool avx = (regs[2] & (1 << 28)) != 0;
+    if (maxLeaf >= 7 && osxsave && avx && (_xgetbv(0) & 0x6) == 0x6) {
+        __cpuidex(regs, 7, 0);
+        features.avx2 = (regs[1] & (1 << 5)) != 0;
+    }
+#else
+    __builtin_cpu_init();
+    features.sse41 = __builtin_cpu_supports("sse4.1");
+    features.avx2 = __builtin_cpu_supports("avx2");
+#endif
+    return features;
+}
+
+#endif // NV12_HAS_X86_KERNELS
+
+Nv12ConvertKernel ResolveKernel(Nv12ConvertKernel requested) {
+#if NV12_HAS_X86_KERNELS
+    static const CpuFeatures s_features = DetectCpuFeatures();
+    if (requested == Nv12ConvertKernel::Avx2 && s_features.avx2) return Nv12ConvertKernel::Avx2;
+    if (requested >= Nv12ConvertKernel::Sse41 && s_features.sse41) return Nv12ConvertKernel::Sse41;
+#else
+    (void)requested;
+#endif
+    return Nv12ConvertKernel::Scalar;
+}
+
+Nv12RowKernelFn GetRowKernel(Nv12ConvertKernel kernel) {
+    switch (kernel) {
+#if NV12_HAS_X86_KERNELS
+    case Nv12ConvertKernel::Avx2:
+        return &ConvertRowsAvx2;
+    case Nv12ConvertKernel::Sse41:
+        return &ConvertRowsSse41;
+#endif
+    default:
+        return &ConvertRowsScalar;
+    }
+}
+
+// Below ~1440p a single SIMD thread finishes well inside a frame; banding only pays off for larger outputs.
+constexpr uint64_t kBandingMinPixels = 2560ull * 1440ull;
+constexpr uint32_t kMaxBandWorkers = 3;
+
+// Persistent helpers for row banding, started on the first large frame. The calling thread always converts band 0.
+// Intentionally leaked: workers are joined by ShutdownNv12ConvertWorkers(), never from a static destructor
+// (joining threads during DLL unload would deadlock on the loader lock).
+class Nv12BandPool {
+  public:
+    static Nv12BandPool& Get() {
+        static Nv12BandPool* s_pool = new Nv12BandPool();
+        return *s_pool;
+    }
+
+    // Returns false if no helper threads are available; the caller then converts single-threaded.
+    bool Run(Nv12RowKernelFn kernel, const uint8_t* rgba, uint8_t* nv12, uint32_t width, uint32_t height) {
+        std::lock_guard<std::mutex> runLock(m_runMutex);
+        if (m_workers.empty() && !m_startAttempted) StartWorkersLocked();
+        if (m_workers.empty()) return false;
+
+        const uint32_t bandCount = static_cast<uint32_t>(m_workers.size()) + 1;
+        // Bands are whole row pairs
+        const uint32_t pairsPerBand = ((height / 2) + bandCount - 1) / bandCount;
+        {
+            std::lock_guard<std::mutex> lock(m_mutex);
+            m_job = { kernel, rgba, nv12, width, height, pairsPerBand * 2 };
+            m_pending = static_cast<uint32_t>(m_workers.size());
+            ++m_generation;
+        }
+        m_wake.notify_all();
+
+        kernel(rgba, nv12, width, height, 0, std::min(height, pairsPerBand * 2));
+
+        std::unique_lock<std::mutex> lock(m_mutex);
+        m_done.wait(lock, [this] { return m_pending == 0; });
+        return true;
+    }
+
+    void Shutdown() {
+        std::lock_guard<std::mutex> runLock(m_runMutex);
+        {
+            std::lock_guard<std::mutex> lock(m_mutex);
+            m_stop = true;
+        }
+        m_wake.notify_all();
+        for (auto& worker : m_workers) {
+            if (worker.joinable()) worker.join();
+        }
+        m_workers.clear();
+        m_stop = false;
+        m_startAttempted = false;
+    }
+
+  private:
+    struct Job {
+        Nv12RowKernelFn kernel = nullptr;
+        const uint8_t* rgba = nullptr;
+        uint8_t* nv12 = nullptr;
+        uint32_t width = 0;
+        uint32_t height = 0;
+        uint32_t rowsPerBand = 0;
+    };
+
+    void StartWorkersLocked() {
+        m_startAttempted = true;
+        const uint32_t hw = std::max(1u, std::thread::hardware_concurrency());
+        const uint32_t workers = std::min(kMaxBandWorkers, hw > 2 ? hw / 2 : 0u);
+        const uint64_t generation = m_generation;
+        for (uint32_t i = 0; i < workers; ++i) {
+            m_workers.emplace_back([this, band = i + 1, generation] { WorkerLoop(band, generation); });
+        }
+    }
+
+    void WorkerLoop(uint32_t band, uint64_t seenGeneration) {
+        for (;;) {
+            Job job;
+            {
+                std::unique_lock<std::mutex> lock(m_mutex);
+                m_wake.wait(lock, [&] { return m_stop || m_generation != seenGeneration; });
+                if (m_stop) return;
+                seenGeneration = m_generation;
+                job = m_job;
+            }
+
+            const uint32_t rowBegin = std::min(job.height, band * job.rowsPerBand);
+            const uint32_t rowEnd = std::min(job.height, rowBegin + job.rowsPerBand);
+            if (rowBegin < rowEnd) job.kernel(job.rgba, job.nv12, job.width, job.height, rowBegin, rowEnd);
+
+            {
+                std::lock_guard<std::mutex> lock(m_mutex);
+                --m_pending;
+            }
+            m_done.notify_one();
+        }
+    }
+
+    std::mutex m_runMutex; // One banded conversion (or shutdown) at a time
+    std::mutex m_mutex;
+    std::condition_variable m_wake;
+    std::condition_variable m_done;
+    std::vector<std::thread> m_workers;
+    Job m_job;
+    uint32_t m_pending = 0;
+    uint64_t m_generation = 0;
+    bool m_stop = false;
+    bool m_startAttempted = false;
+};
+
+} // namespace
+
+Nv12ConvertKernel GetActiveNv12ConvertKernel() {
+    static const Nv12ConvertKernel s_kernel = ResolveKernel(Nv12ConvertKernel::Avx2);
+    return s_kernel;
+}
+
+const char* GetNv12ConvertKernelName(Nv12ConvertKernel kernel) {
+    switch (kernel) {
+    case Nv12ConvertKernel::Avx2:
+        return "AVX2";
+    case Nv12ConvertKernel::Sse41:
+        return "SSE4.1";
+    default:
+        return "scalar";
+    }
+}
+
+void ConvertRGBAtoNV12WithKernel(Nv12ConvertKernel kernel, const uint8_t* rgba, uint8_t* nv12, uint32_t width, uint32_t height) {
+    GetRowKernel(ResolveKernel(kernel))(rgba, nv12, width, height, 0, height);
+}
+
+void ConvertRGBAtoNV12(const uint8_t* rgba, uint8_t* nv12, uint32_t width, uint32_t height) {
+    const Nv12RowKernelFn kernel = GetRowKernel(GetActiveNv12ConvertKernel());
+    if (static_cast<uint64_t>(width) * height >= kBandingMinPixels && Nv12BandPool::Get().Run(kernel, rgba, nv12, width, height)) {
+        return;
+    }
+    kernel(rgba, nv12, width, height, 0, height);
+}
+
+void ShutdownNv12ConvertWorkers() { Nv12BandPool::Get().Shutdown(); }
@@ -0,0 +1,27 @@
+#pragma once
+
+#include <cstdint>
+
+// RGBA -> NV12 conversion for the virtual camera CPU path (BT.601 limited range, fixed point).
+// Output is vertically flipped (OpenGL bottom-up -> NV12 top-down). Width and height must be even.
+// Platform-neutral: SIMD kernels are selected at runtime from CPUID, and large frames are split into row
+// bands processed on a small persistent worker pool.
+
+enum class Nv12ConvertKernel {
+    Scalar,
+    Sse41,
+    Avx2,
+};
+
+// Converts using the best kernel supported by the running CPU
+void ConvertRGBAtoNV12(const uint8_t* rgba, uint8_t* nv12, uint32_t width, uint32_t height);
+
+// Converts with an explicit kernel on the calling thread only (reference/verification use).
+// Falls back to Scalar if the requested kernel isn't supported.
+void ConvertRGBAtoNV12WithKernel(Nv12ConvertKernel kernel, const uint8_t* rgba, uint8_t* nv12, uint32_t width, uint32_t height);
+
+// Joins the row-band helper threads (restarted on demand by the next large frame)
+void ShutdownNv12ConvertWorkers();
+
+Nv12ConvertKernel GetActiveNv12ConvertKernel();
+const char* GetNv12ConvertKernelName(Nv12ConvertKernel kernel);
@@ -0,0 +1,120 @@
+#include "overlay_capture_scheduler.h"
+
+#include <algorithm>
+
+void OverlayCaptureScheduler::SetTicksPerSecond(int64_t ticksPerSecond) {
+    m_ticksPerSecond = std::max<int64_t>(ticksPerSecond, 1);
+}
+
+int64_t OverlayCaptureScheduler::IntervalForFps(int fps) const { return std::max<int64_t>(m_ticksPerSecond / std::max(fps, 1), 1); }
+
+OverlayCaptureScheduler::Slot* OverlayCaptureScheduler::Find(const std::string& id) {
+    for (Slot& slot : m_slots) {
+        if (slot.id == id) { return &slot; }
+    }
+    return nullptr;
+}
+
+void OverlayCaptureScheduler::Sync(const std::vector<OverlaySpec>& overlays, int64_t now) {
+    std::vector<Slot> next;
+    next.reserve(overlays.size());
+    for (const OverlaySpec& spec : overlays) {
+        if (Slot* existing = Find(spec.id)) {
+            next.push_back(std::move(*existing));
+        } else {
+            Slot slot;
+            slot.id = spec.id;
+            slot.deadline = now;
+            next.push_back(std::move(slot));
+        }
+        next.back().interval = IntervalForFps(spec.fps);
+    }
+    m_slots = std::move(next);
+}
+
+void OverlayCaptureScheduler::MarkUrgent(const std::string& id, int64_t now) {
+    Slot* slot = Find(id);
+    if (!slot) { return; }
+    if (slot->inFlight) {
+        slot->urgent = true;
+    } else {
+        slot->deadline = std::min(slot->deadline, now);
+    }
+}
+
+bool OverlayCaptureScheduler::PopDue(int64_t now, std::string& outId) {
+    Slot* best = nullptr;
+    for (Slot& slot : m_slots) {
+        if (slot.inFlight || slot.deadline > now) { continue; }
+        if (!best || slot.deadline < best->deadline) { best = &slot; }
+    }
+    if (!best) { return false; }
+
+    best->inFlight = true;
+    best->dispatchedDeadline = best->deadline;
+    outId = best->id;
+    return true;
+}
+
+void OverlayCaptureScheduler::Complete(const std::string& id, int64_t startedAt, int64_t now) {
+    Slot* slot = Find(id);
+    if (!slot || !slot->inFlight) { return; } // Removed by Sync() while capturing
+
+    slot->inFlight = false;
+    const int64_t captureTicks = std::max<int64_t>(now - startedAt, 0);
+    slot->captures++;
+    slot->captureTicksSum += captureTicks;
+    slot->captureTicksMax = std::max(slot->captureTicksMax, captureTicks);
+    slot->latenessTicksMax = std::max(slot->latenessTicksMax, startedAt - slot->dispatchedDeadline);
+
+    if (slot->urgent) {
+        slot->urgent = false;
+        slot->deadline = now;
+        return;
+    }
+
+    // Stay on the grid. If the capture overran one or more slots, skip to the most recent one instead of
+    // replaying every missed slot back to back.
+    int64_t next = slot->dispatchedDeadline + slot->interval;
+    if (next < now) {
+        const int64_t missed = (now - next) / slot->interval;
+        slot->missed += static_cast<uint64_t>(missed);
+        next += missed * slot->interval;
+    }
+    slot->deadline = next;
+}
+
+int64_t OverlayCaptureScheduler::NextDeadline() const {
+    int64_t earliest = kNoDeadline;
+    for (const Slot& slot : m_slots) {
+        if (!slot.inFlight) { earliest = std::min(earliest, slot.deadline); }
+    }
+    return earliest;
+}
+
+bool OverlayCaptureScheduler::TakeWindowStats(int64_t now, std::vector<Stats>& out) {
+    if (m_windowStart == 0) { m_windowStart = now; }
+    if (now - m_windowStart < m_ticksPerSecond) { return false; }
+    m_windowStart = now;
+
+    const double msPerTick = 1000.0 / static_cast<double>(m_ticksPerSecond);
+    out.clear();
+    out.reserve(m_slots.size());
+    for (Slot& slot : m_slots) {
+        Stats stats;
+        stats.id = slot.id;
+        stats.captures = slot.captures;
+        stats.missed = slot.missed;
+        if (slot.captures > 0) { stats.avgCaptureMs = static_cast<double>(slot.captureTicksSum) * msPerTick / slot.captures; }
+        stats.maxCaptureMs = static_cast<double>(slot.captureTicksMax) * msPerTick;
+        stats.maxLatenessMs = static_cast<double>(slot.latenessTicksMax) * msPerTick;
+        out.push_back(std::move(stats));
+
+        slot.captures = 0;
+        slot.missed = 0;
+        slot.captureTicksSum = 0;
+        slot.captureTicksMax = 0;
+        slot.latenessTicksMax = 0;
+    }
+    return true;
+}
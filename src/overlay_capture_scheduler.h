@@ -0,0 +1,79 @@
+#pragma once
+
+#include <cstdint>
+#include <string>
+#include <vector>
+
+// Earliest-deadline-first scheduling of window overlay captures.
+// Platform-neutral: time is passed in as integer ticks of a caller-provided clock.
+//
+// - Every overlay owns a deadline on a fixed grid of 1/fps. Workers take the due overlay with the earliest
+//   deadline, so a slow capture only delays overlays whose deadlines have actually passed.
+// - An overlay is never handed to two workers at once; it becomes eligible again after Complete().
+// - Slots missed while an overlay was in flight (or while every worker was busy) are skipped rather than
+//   replayed back to back, and counted in the stats.
+// - Overlay counts are small (a handful), so the queue is a flat vector scanned per pop.
+class OverlayCaptureScheduler {
+  public:
+    struct OverlaySpec {
+        std::string id;
+        int fps = 30;
+    };
+
+    struct Stats {
+        std::string id;
+        uint64_t captures = 0;
+        uint64_t missed = 0;        // Deadlines skipped because the previous capture ran past them
+        double avgCaptureMs = 0.0;  // Time spent inside the capture call
+        double maxCaptureMs = 0.0;
+        double maxLatenessMs = 0.0; // Dispatch time minus deadline
+    };
+
+    static constexpr int64_t kNoDeadline = INT64_MAX;
+
+    void SetTicksPerSecond(int64_t ticksPerSecond); // Call before Sync()
+
+    // Replaces the scheduled set. New overlays are due immediately; existing ones keep their grid and only pick up
+    // a changed fps on their next Complete(). Overlays that disappear are dropped, even if in flight.
+    void Sync(const std::vector<OverlaySpec>& overlays, int64_t now);
+
+    // Pulls the overlay's deadline forward to now (config change, window reacquired, ...)
+    void MarkUrgent(const std::string& id, int64_t now);
+
+    // Pops the due overlay with the earliest deadline and marks it in flight. Returns false if none is due.
+    bool PopDue(int64_t now, std::string& outId);
+
+    // Finishes an in-flight capture that started at startedAt (as returned by the caller's clock before capturing)
+    void Complete(const std::string& id, int64_t startedAt, int64_t now);
+
+    // Earliest deadline among overlays that are not in flight, or kNoDeadline
+    int64_t NextDeadline() const;
+
+    size_t Size() const { return m_slots.size(); }
+
+    // Returns true once per stats window (1 s) with per-overlay stats for that window in out
+    bool TakeWindowStats(int64_t now, std::vector<Stats>& out);
+
+  private:
+    struct Slot {
+        std::string id;
+        int64_t interval = 1;
+        int64_t deadline = 0;
+        int64_t dispatchedDeadline = 0;
+        bool inFlight = false;
+        bool urgent = false; // MarkUrgent() arrived while in flight
+
+        uint64_t captures = 0;
+        uint64_t missed = 0;
+        int64_t captureTicksSum = 0;
+        int64_t captureTicksMax = 0;
+        int64_t latenessTicksMax = 0;
+    };
+
+    Slot* Find(const std::string& id);
+    int64_t IntervalForFps(int fps) const;
+
+    int64_t m_ticksPerSecond = 1;
+    std::vector<Slot> m_slots;
+    int64_t m_windowStart = 0;
+};
@@ -0,0 +1,244 @@
+#include "overlay_pixel_convert.h"
+
+#include <algorithm>
+#include <cmath>
+#include <cstring>
+
+#if defined(_M_X64) || defined(_M_IX86) || defined(__x86_64__) || defined(__i386__)
+#define OVERLAY_HAS_X86_KERNELS 1
+#if defined(_MSC_VER) && !defined(__clang__)
+#include <intrin.h>
+#include <immintrin.h>
+// MSVC allows intrinsics for any ISA without per-function target attributes
+#define OVERLAY_TARGET_SSE2
+#define OVERLAY_TARGET_AVX2
+#else
+#include <immintrin.h>
+#define OVERLAY_TARGET_SSE2 __attribute__((target("sse2")))
+#define OVERLAY_TARGET_AVX2 __attribute__((target("avx2")))
+#endif
+#else
+#define OVERLAY_HAS_X86_KERNELS 0
+#endif
+
+namespace {
+
+using OverlayKernelFn = void (*)(const uint8_t* bgra, uint8_t* rgba, size_t pixelCount, const OverlayColorKey* keys, size_t keyCount);
+
+// Pixels are handled as little-endian 32-bit words: BGRA bytes -> 0xAARRGGBB, RGBA bytes -> 0xAABBGGRR.
+inline uint32_t LoadPixel(const uint8_t* p) {
+    uint32_t v;
+    std::memcpy(&v, p, 4);
+    return v;
+}
+
+void ConvertScalar(const uint8_t* bgra, uint8_t* rgba, size_t pixelCount, const OverlayColorKey* keys, size_t keyCount) {
+    for (size_t i = 0; i < pixelCount; ++i) {
+        const uint32_t px = LoadPixel(bgra + i * 4);
+        const int b = static_cast<int>(px & 0xFF);
+        const int g = static_cast<int>((px >> 8) & 0xFF);
+        const int r = static_cast<int>((px >> 16) & 0xFF);
+
+        bool keyed = false;
+        for (size_t k = 0; k < keyCount && !keyed; ++k) {
+            const int dr = r - keys[k].r, dg = g - keys[k].g, db = b - keys[k].b;
+            keyed = static_cast<uint32_t>(dr * dr + dg * dg + db * db) <= keys[k].maxDistanceSq;
+        }
+
+        const uint32_t out = (px & 0x0000FF00u) | ((px & 0xFFu) << 16) | ((px >> 16) & 0xFFu) | (keyed ? 0u : 0xFF000000u);
+        std::memcpy(rgba + i * 4, &out, 4);
+    }
+}
+
+#if OVERLAY_HAS_X86_KERNELS
+
+// Per-key constants for the SIMD kernels: (b, r) and (g, 0) in the 16-bit halves of each 32-bit lane, so that
+// madd(px - key) yields db^2 + dr^2 and dg^2 directly in the pixel's own lane. Distances and thresholds never exceed
+// 3 * 255^2, so the signed 32-bit compare is safe.
+struct SimdKey {
+    int32_t br;
+    int32_t g0;
+    int32_t threshold;
+};
+
+constexpr size_t kMaxSimdKeysOnStack = 16;
+
+inline void BuildSimdKeys(const OverlayColorKey* keys, size_t keyCount, SimdKey* out) {
+    for (size_t k = 0; k < keyCount; ++k) {
+        out[k].br = static_cast<int32_t>(keys[k].b) | (static_cast<int32_t>(keys[k].r) << 16);
+        out[k].g0 = static_cast<int32_t>(keys[k].g);
+        out[k].threshold = static_cast<int32_t>(keys[k].maxDistanceSq);
+    }
+}
+
+OVERLAY_TARGET_SSE2 inline __m128i ConvertBlockSse2(__m128i px, const SimdKey* keys, size_t keyCount) {
+    const __m128i lowMask = _mm_set1_epi32(0x00FF00FF);
+    const __m128i alphaBits = _mm_set1_epi32(static_cast<int>(0xFF000000u));
+
+    __m128i opaque = alphaBits; // Cleared per lane as soon as any key matches
+    if (keyCount > 0) {
+        const __m128i br = _mm_and_si128(px, lowMask);                              // (b, r) per lane
+        const __m128i g0 = _mm_and_si128(_mm_srli_epi32(px, 8), _mm_set1_epi32(0xFF)); // (g, 0) per lane
+        __m128i noMatch = _mm_set1_epi32(-1);
+        for (size_t k = 0; k < keyCount; ++k) {
+            const __m128i dBR = _mm_sub_epi16(br, _mm_set1_epi32(keys[k].br));
+            const __m128i dG = _mm_sub_epi16(g0, _mm_set1_epi32(keys[k].g0));
+            const __m128i dist = _mm_add_epi32(_mm_madd_epi16(dBR, dBR), _mm_madd_epi16(dG, dG));
+            noMatch = _mm_and_si128(noMatch, _mm_cmpgt_epi32(dist, _mm_set1_epi32(keys[k].threshold)));
+        }
+        opaque = _mm_and_si128(opaque, noMatch);
+    }
+
+    // Swap B and R: keep G, move B up to bit 16 and R down to bit 0
+    const __m128i g = _mm_and_si128(px, _mm_set1_epi32(0x0000FF00));
+    const __m128i b = _mm_slli_epi32(_mm_and_si128(px, _mm_set1_epi32(0xFF)), 16);
+    const __m128i r = _mm_and_si128(_mm_srli_epi32(px, 16), _mm_set1_epi32(0xFF));
+    return _mm_or_si128(_mm_or_si128(g, b), _mm_or_si128(r, opaque));
+}
+
+OVERLAY_TARGET_SSE2 void ConvertSse2(const uint8_t* bgra, uint8_t* rgba, size_t pixelCount, const OverlayColorKey* keys, size_t keyCount) {
+    if (keyCount > kMaxSimdKeysOnStack) {
+        ConvertScalar(bgra, rgba, pixelCount, keys, keyCount);
+        return;
+    }
+    SimdKey simdKeys[kMaxSimdKeysOnStack];
+    BuildSimdKeys(keys, keyCount, simdKeys);
+
+    const size_t simdCount = pixelCount & ~size_t{ 3 };
+    for (size_t i = 0; i < simdCount; i += 4) {
+        const __m128i px = _mm_loadu_si128(reinterpret_cast<const __m128i*>(bgra + i * 4));
+        _mm_storeu_si128(reinterpret_cast<__m128i*>(rgba + i * 4), ConvertBlockSse2(px, simdKeys, keyCount));
+    }
+    ConvertScalar(bgra + simdCount * 4, rgba + simdCount * 4, pixelCount - simdCount, keys, keyCount);
+}
+
+OVERLAY_TARGET_AVX2 void ConvertAvx2(const uint8_t* bgra, uint8_t* rgba, size_t pixelCount, const OverlayColorKey* keys, size_t keyCount) {
+    if (keyCount > kMaxSimdKeysOnStack) {
+        ConvertScalar(bgra, rgba, pixelCount, keys, keyCount);
+        return;
+    }
+    SimdKey simdKeys[kMaxSimdKeysOnStack];
+    BuildSimdKeys(keys, keyCount, simdKeys);
+
+    const __m256i lowMask = _mm256_set1_epi32(0x00FF00FF);
+    const __m256i byteMask = _mm256_set1_epi32(0xFF);
+    const __m256i alphaBits = _mm256_set1_epi32(static_cast<int>(0xFF000000u));
+
+    const size_t simdCount = pixelCount & ~size_t{ 7 };
+    for (size_t i = 0; i < simdCount; i += 8) {
+        const __m256i px = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(bgra + i * 4));
+
+        __m256i opaque = alphaBits;
+        if (keyCount > 0) {
+            const __m256i br = _mm256_and_si256(px, lowMask);
+            const __m256i g0 = _mm256_and_si256(_mm256_srli_epi32(px, 8), byteMask);
+            __m256i noMatch = _mm256_set1_epi32(-1);
+            for (size_t k = 0; k < keyCount; ++k) {
+                const __m256i dBR = _mm256_sub_epi16(br, _mm256_set1_epi32(simdKeys[k].br));
+                const __m256i dG = _mm256_sub_epi16(g0, _mm256_set1_epi32(simdKeys[k].g0));
+                const __m256i dist = _mm256_add_epi32(_mm256_madd_epi16(dBR, dBR), _mm256_madd_epi16(dG, dG));
+                noMatch = _mm256_and_si256(noMatch, _mm256_cmpgt_epi32(dist, _mm256_set1_epi32(simdKeys[k].threshold)));
+            }
+            opaque = _mm256_and_si256(opaque, noMatch);
+        }
+
+        const __m256i g = _mm256_and_si256(px, _mm256_set1_epi32(0x0000FF00));
+        const __m256i b = _mm256_slli_epi32(_mm256_and_si256(px, byteMask), 16);
+        const __m256i r = _mm256_and_si256(_mm256_srli_epi32(px, 16), byteMask);
+        const __m256i out = _mm256_or_si256(_mm256_or_si256(g, b), _mm256_or_si256(r, opaque));
+        _mm256_storeu_si256(reinterpret_cast<__m256i*>(rgba + i * 4), out);
+    }
+    ConvertScalar(bgra + simdCount * 4, rgba + simdCount * 4, pixelCount - simdCount, keys, keyCount);
+}
+
+struct CpuFeatures {
+    bool sse2 = false;
+    bool avx2 = false;
+};
+
+CpuFeatures DetectCpuFeatures() {
+    CpuFeatures features;
+#if defined(_MSC_VER) && !defined(__clang__)
+    int regs[4] = {};
+    __cpuid(regs, 0);
+    const int maxLeaf = regs[0];
+    __cpuid(regs, 1);
+    features.sse2 = (regs[3] & (1 << 26)) != 0;
+    const bool osxsave = (regs[2] & (1 << 27)) != 0;
+    const bool avx = (regs[2] & (1 << 28)) != 0;
+    if (maxLeaf >= 7 && osxsave && avx && (_xgetbv(0) & 0x6) == 0x6) {
+        __cpuidex(regs, 7, 0);
+        features.avx2 = (regs[1] & (1 << 5)) != 0;
+    }
+#else
+    __builtin_cpu_init();
+    features.sse2 = __builtin_cpu_supports("sse2");
+    features.avx2 = __builtin_cpu_supports("avx2");
+#endif
+    return features;
+}
+
+#endif // OVERLAY_HAS_X86_KERNELS
+
+OverlayConvertKernel ResolveKernel(OverlayConvertKernel requested) {
+#if OVERLAY_HAS_X86_KERNELS
+    static const CpuFeatures s_features = DetectCpuFeatures();
+    if (requested == OverlayConvertKernel::Avx2 && s_features.avx2) return OverlayConvertKernel::Avx2;
+    if (requested >= OverlayConvertKernel::Sse2 && s_features.sse2) return OverlayConvertKernel::Sse2;
+#else
+    (void)requested;
+#endif
+    return OverlayConvertKernel::Scalar;
+}
+
+OverlayKernelFn GetKernel(OverlayConvertKernel kernel) {
+    switch (kernel) {
+#if OVERLAY_HAS_X86_KERNELS
+    case OverlayConvertKernel::Avx2:
+        return &ConvertAvx2;
+    case OverlayConvertKernel::Sse2:
+        return &ConvertSse2;
+#endif
+    default:
+        return &ConvertScalar;
+    }
+}
+
+} // namespace
+
+OverlayColorKey MakeOverlayColorKey(float r, float g, float b, float sensitivity) {
+    auto toByte = [](float v) { return static_cast<uint8_t>(std::lround(std::clamp(v, 0.0f, 1.0f) * 255.0f)); };
+    OverlayColorKey key;
+    key.r = toByte(r);
+    key.g = toByte(g);
+    key.b = toByte(b);
+    // distanceSq <= sensitivity^2 in 0..1 units  <=>  integer distanceSq <= (255 * sensitivity)^2
+    const double scaled = static_cast<double>(sensitivity) * 255.0;
+    key.maxDistanceSq = static_cast<uint32_t>((std::min)(std::floor(scaled * scaled), 3.0 * 255.0 * 255.0));
+    return key;
+}
+
+OverlayConvertKernel GetActiveOverlayConvertKernel() {
+    static const OverlayConvertKernel s_kernel = ResolveKernel(OverlayConvertKernel::Avx2);
+    return s_kernel;
+}
+
+const char* GetOverlayConvertKernelName(OverlayConvertKernel kernel) {
+    switch (kernel) {
+    case OverlayConvertKernel::Avx2:
+        return "AVX2";
+    case OverlayConvertKernel::Sse2:
+        return "SSE2";
+    default:
+        return "scalar";
+    }
+}
+
+void ConvertOverlayBGRAToRGBAWithKernel(OverlayConvertKernel kernel, const uint8_t* bgra, uint8_t* rgba, size_t pixelCount,
+                                        const OverlayColorKey* keys, size_t keyCount) {
+    GetKernel(ResolveKernel(kernel))(bgra, rgba, pixelCount, keys, keyCount);
+}
+
+void ConvertOverlayBGRAToRGBA(const uint8_t* bgra, uint8_t* rgba, size_t pixelCount, const OverlayColorKey* keys, size_t keyCount) {
+    GetKernel(GetActiveOverlayConvertKernel())(bgra, rgba, pixelCount, keys, keyCount);
+}
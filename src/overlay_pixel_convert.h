@@ -0,0 +1,35 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+
+// BGRA (GDI DIB) -> RGBA conversion for window overlays, with optional color keying in the same pass.
+// Alpha is written as 255, or 0 where the pixel is within any key's distance. The test runs in 8-bit integer space:
+// a key matches when (dr^2 + dg^2 + db^2) <= maxDistanceSq, with channel deltas in 0..255 units.
+// Platform-neutral: SIMD kernels are selected at runtime from CPUID. src and dst may be the same buffer.
+
+struct OverlayColorKey {
+    uint8_t r = 0;
+    uint8_t g = 0;
+    uint8_t b = 0;
+    uint32_t maxDistanceSq = 0;
+};
+
+// Builds a key from the config's 0..1 color and sensitivity (same distance metric as the old float test)
+OverlayColorKey MakeOverlayColorKey(float r, float g, float b, float sensitivity);
+
+enum class OverlayConvertKernel {
+    Scalar,
+    Sse2,
+    Avx2,
+};
+
+// Converts using the best kernel supported by the running CPU. keyCount == 0 just swizzles and sets alpha.
+void ConvertOverlayBGRAToRGBA(const uint8_t* bgra, uint8_t* rgba, size_t pixelCount, const OverlayColorKey* keys, size_t keyCount);
+
+// Converts with an explicit kernel (reference/verification use). Falls back to Scalar if unsupported.
+void ConvertOverlayBGRAToRGBAWithKernel(OverlayConvertKernel kernel, const uint8_t* bgra, uint8_t* rgba, size_t pixelCount,
+                                        const OverlayColorKey* keys, size_t keyCount);
+
+OverlayConvertKernel GetActiveOverlayConvertKernel();
+const char* GetOverlayConvertKernelName(OverlayConvertKernel kernel);
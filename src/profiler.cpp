@@ -42,10 +42,12 @@ void Profiler::RegisterThreadBuffer(ThreadRingBuffer* buffer) {
 
 void Profiler::MarkAsRenderThread() { GetThreadBuffer().isRenderThread = true; }
 
+void Profiler::SetThreadName(const char* name) { GetThreadBuffer().threadName.store(name, std::memory_order_release); }
+
 // ScopedTimer - completely lock-free
 Profiler::ScopedTimer::ScopedTimer(Profiler& profiler, const char* sectionName) : m_sectionName(sectionName), m_depth(0), m_active(false) {
-    if (profiler.IsEnabled()) {
-        m_startTime = std::chrono::high_resolution_clock::now();
+    if (profiler.IsRecording()) {
+        m_startTime = std::chrono::steady_clock::now();
 
         // Track stack depth for hierarchy (thread-local, no sync)
         ThreadRingBuffer& buffer = GetThreadBuffer();
@@ -58,9 +60,10 @@ Profiler::ScopedTimer::ScopedTimer(Profiler& profiler, const char* sectionName)
 
 Profiler::ScopedTimer::~ScopedTimer() {
     if (m_active) {
-        auto endTime = std::chrono::high_resolution_clock::now();
+        auto endTime = std::chrono::steady_clock::now();
         auto duration = std::chrono::duration<double, std::milli>(endTime - m_startTime);
         double durationMs = duration.count();
+        int64_t startNs = std::chrono::duration_cast<std::chrono::nanoseconds>(m_startTime.time_since_epoch()).count();
 
         // Get parent name BEFORE popping (thread-local, no sync)
         ThreadRingBuffer& buffer = GetThreadBuffer();
@@ -74,13 +77,13 @@ Profiler::ScopedTimer::~ScopedTimer() {
         if (!buffer.scopeStack.empty()) { buffer.scopeStack.pop_back(); }
 
         // Submit event with parent info - completely lock-free
-        Profiler::GetInstance().SubmitEvent(m_sectionName, parentName, durationMs, m_depth);
+        Profiler::GetInstance().SubmitEvent(m_sectionName, parentName, startNs, durationMs, m_depth);
     }
 }
 
 // Lock-free event submission - O(1), no locks, no allocations
-void Profiler::SubmitEvent(const char* sectionName, const char* parentName, double durationMs, uint8_t depth) {
-    if (!m_enabled) return;
+void Profiler::SubmitEvent(const char* sectionName, const char* parentName, int64_t startNs, double durationMs, uint8_t depth) {
+    if (!IsRecording()) return;
 
     ThreadRingBuffer& buffer = GetThreadBuffer();
 
@@ -107,6 +110,7 @@ void Profiler::SubmitEvent(const char* sectionName, const char* parentName, doub
     TimingEvent& event = buffer.events[writePos];
     event.sectionName = sectionName;
     event.parentName = parentName;
+    event.startNs = startNs;
     event.durationMs = durationMs;
     event.threadId = buffer.threadId;
     event.depth = depth;
@@ -137,16 +141,26 @@ void Profiler::ProcessingThreadMain() {
     }
 }
 
+// A slot is in use once it has been updated; stale removal resets it to the default (unset) time
+static bool IsLive(const Profiler::ProfileEntry& entry) { return entry.lastUpdateTime != std::chrono::steady_clock::time_point{}; }
+
 void Profiler::ProcessEvents() {
     // Process events from all registered thread buffers
     while (m_registryLock.test_and_set(std::memory_order_acquire)) {}
     std::vector<ThreadRingBuffer*> buffers = m_threadRegistry; // Copy to release lock quickly
     m_registryLock.clear(std::memory_order_release);
 
+    const bool tracing = m_traceCapture->IsActive();
+    const auto now = std::chrono::steady_clock::now();
+
     for (ThreadRingBuffer* buffer : buffers) {
         // Skip invalidated buffers (thread has exited)
         if (!buffer->isValid.load(std::memory_order_acquire)) { continue; }
 
+        if (tracing) {
+            m_traceCapture->AddThread(buffer->threadId, buffer->threadName.load(std::memory_order_acquire));
+        }
+
         // Read all available events from this buffer
         size_t readPos = buffer->readIndex.load(std::memory_order_relaxed);
         size_t writePos = buffer->writeIndex.load(std::memory_order_acquire);
@@ -154,40 +168,52 @@ void Profiler::ProcessEvents() {
         while (readPos != writePos) {
             const TimingEvent& event = buffer->events[readPos];
 
-            // Process this event into our aggregated data
-            auto& targetEntries = event.isRenderThread ? m_renderThreadEntries : m_otherThreadEntries;
+            if (tracing) {
+                m_traceCapture->AddEvent(
+                    { event.sectionName, event.startNs, static_cast<int64_t>(event.durationMs * 1000000.0), event.threadId });
+            }
 
-            // Use section name as key
-            std::string pathKey = event.sectionName;
+            // Process this event into our aggregated data
+            ScopeTable& table = event.isRenderThread ? m_renderThreadScopes : m_otherThreadScopes;
+
+            const uint32_t scopeId = InternScope(event.sectionName);
+            const int32_t parentId = event.parentName != nullptr ? static_cast<int32_t>(InternScope(event.parentName)) : -1;
+            const size_t needed = static_cast<size_t>(std::max<int64_t>(scopeId, parentId)) + 1;
+            if (table.entries.size() < needed) {
+                table.entries.resize(needed);
+                table.latency.resize(needed);
+            }
 
-            auto& entry = targetEntries[pathKey];
-            entry.displayName = event.sectionName;
+            auto& entry = table.entries[scopeId];
+            entry.scopeId = scopeId;
             entry.totalTime += event.durationMs;
             entry.callCount++;
             entry.depth = event.depth;
-            entry.lastUpdateTime = std::chrono::steady_clock::now();
+            entry.lastUpdateTime = now;
 
             // Build parent-child relationships
-            if (event.parentName != nullptr) {
-                std::string parentKey = event.parentName;
-                entry.parentPath = parentKey;
-
-                // Add this as a child of the parent
-                auto& parentEntry = targetEntries[parentKey];
-                parentEntry.displayName = event.parentName;
-                // Add to child paths if not already present
-                bool found = false;
-                for (const auto& child : parentEntry.childPaths) {
-                    if (child == pathKey) {
-                        found = true;
-                        break;
-                    }
+            if (parentId >= 0) {
+                entry.parentId = parentId;
+
+                // Create the parent implicitly if it hasn't completed yet (or was reset as stale), so the child isn't
+                // hidden from the tree; it shows as a root with no time of its own until its own events arrive.
+                // Active children keep it from going stale.
+                auto& parent = table.entries[parentId];
+                if (!IsLive(parent)) {
+                    parent.scopeId = static_cast<uint32_t>(parentId);
+                    parent.depth = event.depth > 0 ? event.depth - 1 : 0;
                 }
-                if (!found) { parentEntry.childPaths.push_back(pathKey); }
+                parent.lastUpdateTime = now;
+
+                // Add this as a child of the parent if not already present
+                auto& children = parent.childIds;
+                if (std::find(children.begin(), children.end(), scopeId) == children.end()) { children.push_back(scopeId); }
             }
 
-            // Track max time
-            if (event.durationMs > entry.maxTimeInLastSecond) { entry.maxTimeInLastSecond = event.durationMs; }
+            // Per-call latency distribution
+            auto& latency = table.latency[scopeId];
+            if (!latency) { latency = std::make_unique<RollingLatencyHistogram>(); }
+            latency->Record(static_cast<int64_t>(event.durationMs * 1000000.0));
 
             // Advance read position
             readPos = (readPos + 1) % RING_BUFFER_SIZE;
@@ -196,89 +222,130 @@ void Profiler::ProcessEvents() {
         // Publish read progress
         buffer->readIndex.store(readPos, std::memory_order_release);
     }
+
+    if (tracing) {
+        const int64_t nowNs = std::chrono::duration_cast<std::chrono::nanoseconds>(now.time_since_epoch()).count();
+        if (m_traceCapture->Flush(nowNs)) { Log("Profiler trace capture finished recording, writing file..."); }
+    }
+}
+
+bool Profiler::StartTraceCapture(const std::filesystem::path& path, double seconds) {
+    const int64_t nowNs = std::chrono::duration_cast<std::chrono::nanoseconds>(std::chrono::steady_clock::now().time_since_epoch()).count();
+    const double clampedSeconds = std::clamp(seconds, 0.1, 600.0);
+    if (!m_traceCapture->Start(path, nowNs, static_cast<int64_t>(clampedSeconds * 1e9))) { return false; }
+    Log("Profiler trace capture started (" + std::to_string(static_cast<int>(clampedSeconds * 1000.0)) + " ms): " + WideToUtf8(path.wstring()));
+    return true;
+}
+
+uint32_t Profiler::InternScope(const char* name) {
+    auto it = m_scopeIdsByPointer.find(name);
+    if (it != m_scopeIdsByPointer.end()) { return it->second; }
+
+    // First time this pointer is seen - fall back to the text
+    auto [nameIt, inserted] = m_scopeIdsByName.try_emplace(name, static_cast<uint32_t>(m_scopeNames.size()));
+    if (inserted) { m_scopeNames.emplace_back(name); }
+    m_scopeIdsByPointer.emplace(name, nameIt->second);
+    return nameIt->second;
+}
+
+void Profiler::UpdateLatencyPercentiles(ScopeTable& table) {
+    LatencyHistogram merged;
+    for (size_t id = 0; id < table.entries.size(); ++id) {
+        RollingLatencyHistogram* latency = table.latency[id].get();
+        if (!latency) { continue; }
+
+        ProfileEntry& entry = table.entries[id];
+        latency->Merge(merged);
+        entry.windowCalls = merged.Count();
+        entry.p50Ms = merged.ValueAtQuantileNs(0.50) / 1e6;
+        entry.p99Ms = merged.ValueAtQuantileNs(0.99) / 1e6;
+        entry.p999Ms = merged.ValueAtQuantileNs(0.999) / 1e6;
+        entry.maxMs = merged.MaxNs() / 1e6;
+        latency->Rotate();
+    }
 }
 
-void Profiler::CalculateHierarchy(std::unordered_map<std::string, ProfileEntry>& entries, double totalTime) {
+void Profiler::CalculateHierarchy(std::vector<ProfileEntry>& entries, double totalTime) {
     // Calculate self time (total time minus children's time)
-    for (auto& [path, entry] : entries) {
+    for (auto& entry : entries) {
+        if (!IsLive(entry)) continue;
         double childrenTime = 0.0;
-        for (const auto& childPath : entry.childPaths) {
-            auto it = entries.find(childPath);
-            if (it != entries.end()) { childrenTime += it->second.totalTime; }
+        for (uint32_t childId : entry.childIds) {
+            if (IsLive(entries[childId])) { childrenTime += entries[childId].totalTime; }
         }
         entry.selfTime = entry.totalTime - childrenTime;
         if (entry.selfTime < 0.0) entry.selfTime = 0.0; // Clamp to 0
     }
 
     // Calculate percentages
-    for (auto& [path, entry] : entries) {
+    for (auto& entry : entries) {
+        if (!IsLive(entry)) continue;
         entry.totalPercentage = totalTime > 0.0 ? (entry.totalTime / totalTime) * 100.0 : 0.0;
 
         // Parent percentage
-        if (!entry.parentPath.empty()) {
-            auto it = entries.find(entry.parentPath);
-            if (it != entries.end() && it->second.totalTime > 0.0) {
-                entry.parentPercentage = (entry.totalTime / it->second.totalTime) * 100.0;
-            }
+        if (entry.parentId >= 0) {
+            const ProfileEntry& parent = entries[entry.parentId];
+            if (IsLive(parent) && parent.totalTime > 0.0) { entry.parentPercentage = (entry.totalTime / parent.totalTime) * 100.0; }
         } else {
             entry.parentPercentage = entry.totalPercentage;
         }
     }
 }
 
-void Profiler::BuildDisplayTree(const std::unordered_map<std::string, ProfileEntry>& entries,
-                                std::vector<std::pair<std::string, ProfileEntry>>& output) {
+void Profiler::BuildDisplayTree(const std::vector<ProfileEntry>& entries, std::vector<std::pair<std::string, ProfileEntry>>& output) {
     output.clear();
 
-    // Build a map of parent -> children for quick lookup
-    std::unordered_map<std::string, std::vector<std::string>> childrenMap;
-    std::vector<std::string> rootEntries;
+    // Build parent -> children lists for quick lookup
+    std::vector<std::vector<uint32_t>> childrenOf(entries.size());
+    std::vector<uint32_t> rootEntries;
 
-    for (const auto& [path, entry] : entries) {
-        if (entry.parentPath.empty()) {
-            rootEntries.push_back(path);
+    for (uint32_t id = 0; id < entries.size(); ++id) {
+        const ProfileEntry& entry = entries[id];
+        if (!IsLive(entry)) continue;
+        if (entry.parentId < 0) {
+            rootEntries.push_back(id);
         } else {
-            childrenMap[entry.parentPath].push_back(path);
+            childrenOf[entry.parentId].push_back(id);
         }
     }
 
     // Sort children by rolling average time (descending) within each parent
-    auto sortByTime = [&entries](std::vector<std::string>& names) {
-        std::sort(names.begin(), names.end(), [&entries](const std::string& a, const std::string& b) {
-            auto itA = entries.find(a);
-            auto itB = entries.find(b);
-            double timeA = (itA != entries.end()) ? itA->second.rollingAverageTime : 0.0;
-            double timeB = (itB != entries.end()) ? itB->second.rollingAverageTime : 0.0;
-            return timeA > timeB;
-        });
+    auto sortByTime = [&entries](std::vector<uint32_t>& ids) {
+        std::sort(ids.begin(), ids.end(),
+                  [&entries](uint32_t a, uint32_t b) { return entries[a].rollingAverageTime > entries[b].rollingAverageTime; });
     };
 
     // Sort root entries by time
     sortByTime(rootEntries);
 
     // Sort all children groups by time
-    for (auto& [parent, children] : childrenMap) { sortByTime(children); }
+    for (auto& children : childrenOf) { sortByTime(children); }
 
     // Recursive function to add entry and its children in order
-    std::function<void(const std::string&)> addEntryWithChildren = [&](const std::string& path) {
-        auto it = entries.find(path);
-        if (it != entries.end()) {
-            output.emplace_back(path, it->second);
-
-            // Add all children recursively
-            auto childIt = childrenMap.find(path);
-            if (childIt != childrenMap.end()) {
-                for (const auto& childPath : childIt->second) { addEntryWithChildren(childPath); }
-            }
-        }
+    std::function<void(uint32_t)> addEntryWithChildren = [&](uint32_t id) {
+        output.emplace_back(m_scopeNames[id], entries[id]);
+        output.back().second.displayName = m_scopeNames[id];
+
+        // Add all children recursively
+        for (uint32_t childId : childrenOf[id]) { addEntryWithChildren(childId); }
     };
 
     // Start with root entries and recursively add children
-    for (const auto& rootPath : rootEntries) { addEntryWithChildren(rootPath); }
+    for (uint32_t rootId : rootEntries) { addEntryWithChildren(rootId); }
 }
 
 void Profiler::EndFrame() {
-    if (!m_enabled) return;
+    ProfilerTraceCapture::Result traceResult;
+    if (m_traceCapture->TakeResult(traceResult)) {
+        if (traceResult.ok) {
+            Log("Profiler trace written: " + WideToUtf8(traceResult.path.wstring()) + " (" + std::to_string(traceResult.events) + " events, " +
+                std::to_string(traceResult.dropped) + " dropped)");
+        } else {
+            Log("Profiler trace failed to write: " + WideToUtf8(traceResult.path.wstring()));
+        }
+    }
+
+    if (!IsRecording()) return;
 
     auto currentTime = std::chrono::steady_clock::now();
 
@@ -289,12 +356,12 @@ void Profiler::EndFrame() {
     m_totalRenderTime = 0.0;
     m_totalOtherTime = 0.0;
 
-    for (const auto& [path, entry] : m_renderThreadEntries) { m_totalRenderTime += entry.totalTime; }
-    for (const auto& [path, entry] : m_otherThreadEntries) { m_totalOtherTime += entry.totalTime; }
+    for (const auto& entry : m_renderThreadScopes.entries) { m_totalRenderTime += entry.totalTime; }
+    for (const auto& entry : m_otherThreadScopes.entries) { m_totalOtherTime += entry.totalTime; }
 
     // Calculate hierarchy (self time, percentages)
-    CalculateHierarchy(m_renderThreadEntries, m_totalRenderTime);
-    CalculateHierarchy(m_otherThreadEntries, m_totalOtherTime);
+    CalculateHierarchy(m_renderThreadScopes.entries, m_totalRenderTime);
+    CalculateHierarchy(m_otherThreadScopes.entries, m_totalOtherTime);
 
     // Accumulate for rolling average
     m_accumulatedRenderTime += m_totalRenderTime;
@@ -302,24 +369,25 @@ void Profiler::EndFrame() {
     m_frameCountForAveraging++;
 
     // Accumulate per-entry data
-    auto accumulateEntries = [this](std::unordered_map<std::string, ProfileEntry>& entries) {
-        for (auto& [path, entry] : entries) {
+    auto accumulateEntries = [this](std::vector<ProfileEntry>& entries) {
+        for (auto& entry : entries) {
+            if (!IsLive(entry)) continue;
             entry.accumulatedTime += entry.totalTime;
             entry.accumulatedSelfTime += entry.selfTime;
             entry.accumulatedCalls += entry.callCount;
             entry.frameCount++;
         }
     };
-    accumulateEntries(m_renderThreadEntries);
-    accumulateEntries(m_otherThreadEntries);
+    accumulateEntries(m_renderThreadScopes.entries);
+    accumulateEntries(m_otherThreadScopes.entries);
 
     // Reset frame data for next frame
-    for (auto& [path, entry] : m_renderThreadEntries) {
+    for (auto& entry : m_renderThreadScopes.entries) {
         entry.totalTime = 0.0;
         entry.selfTime = 0.0;
         entry.callCount = 0;
     }
-    for (auto& [path, entry] : m_otherThreadEntries) {
+    for (auto& entry : m_otherThreadScopes.entries) {
         entry.totalTime = 0.0;
         entry.selfTime = 0.0;
         entry.callCount = 0;
@@ -327,18 +395,17 @@ void Profiler::EndFrame() {
 
     // Remove stale entries that haven't been updated in 5 seconds
     constexpr auto STALE_THRESHOLD = std::chrono::seconds(5);
-    auto removeStaleEntries = [&currentTime](std::unordered_map<std::string, ProfileEntry>& entries) {
-        for (auto it = entries.begin(); it != entries.end();) {
-            auto timeSinceUpdate = currentTime - it->second.lastUpdateTime;
-            if (timeSinceUpdate > STALE_THRESHOLD) {
-                it = entries.erase(it);
-            } else {
-                ++it;
+    auto removeStaleEntries = [&currentTime](ScopeTable& table) {
+        for (size_t id = 0; id < table.entries.size(); ++id) {
+            ProfileEntry& entry = table.entries[id];
+            if (IsLive(entry) && currentTime - entry.lastUpdateTime > STALE_THRESHOLD) {
+                entry = ProfileEntry{};
+                table.latency[id].reset();
             }
         }
     };
-    removeStaleEntries(m_renderThreadEntries);
-    removeStaleEntries(m_otherThreadEntries);
+    removeStaleEntries(m_renderThreadScopes);
+    removeStaleEntries(m_otherThreadScopes);
 
     // Update display cache
     auto timeSinceLastUpdate = std::chrono::duration_cast<std::chrono::milliseconds>(currentTime - m_lastUpdateTime);
@@ -346,8 +413,8 @@ void Profiler::EndFrame() {
         double avgRenderTime = m_frameCountForAveraging > 0 ? m_accumulatedRenderTime / m_frameCountForAveraging : 0.0;
         double avgOtherTime = m_frameCountForAveraging > 0 ? m_accumulatedOtherTime / m_frameCountForAveraging : 0.0;
 
-        auto updateRollingAverages = [this](std::unordered_map<std::string, ProfileEntry>& entries, double avgTotal) {
-            for (auto& [path, entry] : entries) {
+        auto updateRollingAverages = [this](std::vector<ProfileEntry>& entries, double avgTotal) {
+            for (auto& entry : entries) {
                 if (entry.frameCount > 0) {
                     entry.rollingAverageTime = entry.accumulatedTime / entry.frameCount;
                     entry.rollingSelfTime = entry.accumulatedSelfTime / entry.frameCount;
@@ -355,14 +422,18 @@ void Profiler::EndFrame() {
                 entry.totalPercentage = avgTotal > 0.0 ? (entry.rollingAverageTime / avgTotal) * 100.0 : 0.0;
             }
         };
-        updateRollingAverages(m_renderThreadEntries, avgRenderTime);
-        updateRollingAverages(m_otherThreadEntries, avgOtherTime);
+        updateRollingAverages(m_renderThreadScopes.entries, avgRenderTime);
+        updateRollingAverages(m_otherThreadScopes.entries, avgOtherTime);
+
+        // Percentiles over the rolling window, then start the next one-second slice
+        UpdateLatencyPercentiles(m_renderThreadScopes);
+        UpdateLatencyPercentiles(m_otherThreadScopes);
 
         // Lock mutex while updating display cache to prevent race with GetProfileData
         {
             std::lock_guard<std::mutex> lock(m_displayDataMutex);
-            BuildDisplayTree(m_renderThreadEntries, m_cachedDisplayData.renderThread);
-            BuildDisplayTree(m_otherThreadEntries, m_cachedDisplayData.otherThreads);
+            BuildDisplayTree(m_renderThreadScopes.entries, m_cachedDisplayData.renderThread);
+            BuildDisplayTree(m_otherThreadScopes.entries, m_cachedDisplayData.otherThreads);
         }
 
         m_lastUpdateTime = currentTime;
@@ -383,6 +454,21 @@ std::vector<std::pair<std::string, Profiler::ProfileEntry>> Profiler::GetProfile
     return result;
 }
 
+void Profiler::SetCounter(const std::string& name, double value) {
+    std::lock_guard<std::mutex> lock(m_countersMutex);
+    m_counters[name] = value;
+}
+
+void Profiler::RemoveCounter(const std::string& name) {
+    std::lock_guard<std::mutex> lock(m_countersMutex);
+    m_counters.erase(name);
+}
+
+std::vector<std::pair<std::string, double>> Profiler::GetCounters() const {
+    std::lock_guard<std::mutex> lock(m_countersMutex);
+    return std::vector<std::pair<std::string, double>>(m_counters.begin(), m_counters.end());
+}
+
 void Profiler::Clear() {
     // Clear all thread buffers
     while (m_registryLock.test_and_set(std::memory_order_acquire)) {}
@@ -395,8 +481,8 @@ void Profiler::Clear() {
 
     m_registryLock.clear(std::memory_order_release);
 
-    m_renderThreadEntries.clear();
-    m_otherThreadEntries.clear();
+    m_renderThreadScopes = ScopeTable{};
+    m_otherThreadScopes = ScopeTable{};
     m_cachedDisplayData.renderThread.clear();
     m_cachedDisplayData.otherThreads.clear();
     m_totalRenderTime = 0.0;
@@ -404,4 +490,7 @@ void Profiler::Clear() {
     m_accumulatedRenderTime = 0.0;
     m_accumulatedOtherTime = 0.0;
     m_frameCountForAveraging = 0;
+
+    std::lock_guard<std::mutex> lock(m_countersMutex);
+    m_counters.clear();
 }
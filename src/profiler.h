@@ -1,7 +1,12 @@
 #pragma once
 
+#include "profiler_histogram.h"
+#include "profiler_trace.h"
 #include <atomic>
 #include <chrono>
+#include <filesystem>
+#include <map>
+#include <memory>
 #include <mutex>
 #include <string>
 #include <thread>
@@ -11,6 +16,8 @@
 // Lock-free hierarchical profiler using a single-producer queue per thread
 // Hot path (PROFILE_SCOPE) is completely lock-free - just writes to a ring buffer
 // Background thread aggregates and processes timing data
+// Events carry absolute start times, so a trace capture can replay them as a per-thread timeline
+// Scope names are interned to integer ids on the processing side; each scope keeps a rolling latency histogram
 class Profiler {
   public:
     struct ProfileEntry {
@@ -27,16 +34,21 @@ class Profiler {
         double rollingAverageTime = 0.0;
         double rollingSelfTime = 0.0;
 
-        // Max time tracking
-        double maxTimeInLastSecond = 0.0;
+        // Per-call latency over the last RollingLatencyHistogram::kSlices seconds
+        double p50Ms = 0.0;
+        double p99Ms = 0.0;
+        double p999Ms = 0.0;
+        double maxMs = 0.0;
+        uint64_t windowCalls = 0;
 
-        // Stale entry removal - time when entry was last updated with actual data
+        // Stale entry removal - time when entry was last updated with actual data (unset = unused slot)
         std::chrono::steady_clock::time_point lastUpdateTime{};
 
-        // Hierarchy support - using string paths
-        std::string parentPath;              // Parent scope path (empty for root)
-        std::vector<std::string> childPaths; // Child scope paths
-        int depth = 0;                       // Nesting depth (0 = root)
+        // Hierarchy support - using interned scope ids
+        uint32_t scopeId = 0;
+        int32_t parentId = -1;          // Parent scope id (-1 for root)
+        std::vector<uint32_t> childIds; // Child scope ids
+        int depth = 0;                  // Nesting depth (0 = root)
 
         // Percentages
         double parentPercentage = 0.0; // Percentage of parent's time
@@ -47,6 +59,7 @@ class Profiler {
     struct TimingEvent {
         const char* sectionName; // Static string (from PROFILE_SCOPE macro)
         const char* parentName;  // Parent scope name (for hierarchy)
+        int64_t startNs;         // steady_clock nanoseconds at scope entry
         double durationMs;       // Duration in milliseconds
         uint32_t threadId;       // Thread that generated this event
         uint8_t depth;           // Stack depth when event was created
@@ -63,6 +76,7 @@ class Profiler {
         std::atomic<bool> isValid{ true };   // Set to false when thread exits
         bool isRenderThread = false;
         uint32_t threadId = 0;
+        std::atomic<const char*> threadName{ nullptr }; // Static string, labels this thread in trace captures
 
         // Scope stack for hierarchy tracking (thread-local, no sync needed)
         std::vector<const char*> scopeStack;
@@ -79,7 +93,7 @@ class Profiler {
 
       private:
         const char* m_sectionName;
-        std::chrono::high_resolution_clock::time_point m_startTime;
+        std::chrono::steady_clock::time_point m_startTime;
         uint8_t m_depth;
         bool m_active;
     };
@@ -90,8 +104,11 @@ class Profiler {
     // Mark the current thread as the render thread
     void MarkAsRenderThread();
 
+    // Name the current thread in trace captures (static string)
+    void SetThreadName(const char* name);
+
     // Lock-free event submission (called from ScopedTimer destructor)
-    void SubmitEvent(const char* sectionName, const char* parentName, double durationMs, uint8_t depth);
+    void SubmitEvent(const char* sectionName, const char* parentName, int64_t startNs, double durationMs, uint8_t depth);
 
     // Frame management
     void EndFrame();
@@ -110,9 +127,21 @@ class Profiler {
     // Legacy API for compatibility
     std::vector<std::pair<std::string, ProfileEntry>> GetProfileDataFlat() const;
 
+    // Named scalar counters (rates, latencies) shown alongside the timing tree.
+    // Takes a lock - publish from a periodic point (e.g. once per second), not per scope.
+    void SetCounter(const std::string& name, double value);
+    void RemoveCounter(const std::string& name); // For counters of objects that no longer exist
+    std::vector<std::pair<std::string, double>> GetCounters() const;
+
+    // Timeline capture: records every scope on every thread for the given duration and streams it to a Chrome trace
+    // JSON file. Scopes are recorded while a capture runs even if the profiler overlay is disabled. Any thread.
+    bool StartTraceCapture(const std::filesystem::path& path, double seconds);
+    bool IsTraceCaptureActive() const { return m_traceCapture->IsActive(); }
+
     void Clear();
     void SetEnabled(bool enabled) { m_enabled = enabled; }
     bool IsEnabled() const { return m_enabled; }
+    bool IsRecording() const { return m_enabled.load(std::memory_order_relaxed) || m_traceCapture->IsActive(); }
 
     void RegisterThreadBuffer(ThreadRingBuffer* buffer);
 
@@ -124,9 +153,19 @@ class Profiler {
     std::atomic<bool> m_processingThreadRunning{ false };
     std::thread m_processingThread;
 
-    // Processed data (only accessed by processing thread and display)
-    std::unordered_map<std::string, ProfileEntry> m_renderThreadEntries;
-    std::unordered_map<std::string, ProfileEntry> m_otherThreadEntries;
+    // Processed data (only accessed by processing thread and display), indexed by scope id
+    struct ScopeTable {
+        std::vector<ProfileEntry> entries;
+        std::vector<std::unique_ptr<RollingLatencyHistogram>> latency; // Allocated on a scope's first event
+    };
+    ScopeTable m_renderThreadScopes;
+    ScopeTable m_otherThreadScopes;
+
+    // Scope interning (processing side only). Names are static strings, so the pointer is the fast key; the same
+    // text behind a different pointer (e.g. one literal in two translation units) still maps to one id.
+    std::unordered_map<const char*, uint32_t> m_scopeIdsByPointer;
+    std::unordered_map<std::string, uint32_t> m_scopeIdsByName;
+    std::vector<std::string> m_scopeNames;
 
     double m_totalRenderTime = 0.0;
     double m_totalOtherTime = 0.0;
@@ -141,15 +180,24 @@ class Profiler {
     std::chrono::steady_clock::time_point m_lastUpdateTime;
     static constexpr int UPDATE_INTERVAL_MS = 1000;
 
+    // Published counters, kept sorted by name for stable display
+    mutable std::mutex m_countersMutex;
+    std::map<std::string, double> m_counters;
+
     // Thread registry (lock-free via atomic flag)
     std::atomic_flag m_registryLock = ATOMIC_FLAG_INIT;
     std::vector<ThreadRingBuffer*> m_threadRegistry;
 
+    // Timeline capture, fed from ProcessEvents. Intentionally leaked: its writer thread may still be running when
+    // static destructors run, and it must never be joined (or have its condition variable destroyed) from there.
+    ProfilerTraceCapture* m_traceCapture = new ProfilerTraceCapture();
+
     void ProcessingThreadMain();
     void ProcessEvents();
-    void CalculateHierarchy(std::unordered_map<std::string, ProfileEntry>& entries, double totalTime);
-    void BuildDisplayTree(const std::unordered_map<std::string, ProfileEntry>& entries,
-                          std::vector<std::pair<std::string, ProfileEntry>>& output);
+    uint32_t InternScope(const char* name);
+    void UpdateLatencyPercentiles(ScopeTable& table);
+    void CalculateHierarchy(std::vector<ProfileEntry>& entries, double totalTime);
+    void BuildDisplayTree(const std::vector<ProfileEntry>& entries, std::vector<std::pair<std::string, ProfileEntry>>& output);
 };
 
 // Convenience macros - completely lock-free on hot path
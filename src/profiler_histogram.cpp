@@ -0,0 +1,76 @@
+#include "profiler_histogram.h"
+
+#include <algorithm>
+#include <bit>
+#include <cmath>
+
+int LatencyHistogram::BucketIndex(int64_t valueNs) {
+    const uint64_t units = static_cast<uint64_t>(std::max<int64_t>(valueNs, 0)) >> kUnitShift;
+    // Below 2 * kSubBuckets units the buckets are one unit wide; above, each octave keeps kSubBuckets buckets
+    const int shift = std::max(static_cast<int>(std::bit_width(units | 1)) - 1 - kSubBucketBits, 0);
+    if (shift > kMaxShift) { return kBucketCount - 1; }
+    return (shift << kSubBucketBits) + static_cast<int>(units >> shift);
+}
+
+int64_t LatencyHistogram::BucketLowerNs(int index) {
+    if (index < 2 * kSubBuckets) { return static_cast<int64_t>(index) << kUnitShift; }
+    const int shift = (index >> kSubBucketBits) - 1;
+    const int64_t top = index - (static_cast<int64_t>(shift) << kSubBucketBits);
+    return (top << shift) << kUnitShift;
+}
+
+int64_t LatencyHistogram::BucketWidthNs(int index) {
+    if (index < 2 * kSubBuckets) { return int64_t{ 1 } << kUnitShift; }
+    const int shift = (index >> kSubBucketBits) - 1;
+    return (int64_t{ 1 } << shift) << kUnitShift;
+}
+
+void LatencyHistogram::Record(int64_t valueNs) {
+    m_buckets[BucketIndex(valueNs)]++;
+    m_count++;
+    m_maxNs = std::max(m_maxNs, valueNs);
+}
+
+void LatencyHistogram::Add(const LatencyHistogram& other) {
+    if (other.m_count == 0) { return; }
+    for (int i = 0; i < kBucketCount; ++i) { m_buckets[i] += other.m_buckets[i]; }
+    m_count += other.m_count;
+    m_maxNs = std::max(m_maxNs, other.m_maxNs);
+}
+
+void LatencyHistogram::Clear() {
+    if (m_count == 0) { return; }
+    m_buckets.fill(0);
+    m_count = 0;
+    m_maxNs = 0;
+}
+
+int64_t LatencyHistogram::ValueAtQuantileNs(double q) const {
+    if (m_count == 0) { return 0; }
+    // Rank of the sample at quantile q (1-based, nearest-rank definition)
+    const uint64_t rank = std::clamp<uint64_t>(static_cast<uint64_t>(std::ceil(q * static_cast<double>(m_count))), 1, m_count);
+    uint64_t seen = 0;
+    for (int i = 0; i < kBucketCount; ++i) {
+        seen += m_buckets[i];
+        if (seen >= rank) {
+            // Never report more than the largest value actually recorded
+            return std::min(BucketLowerNs(i) + BucketWidthNs(i) / 2, m_maxNs);
+        }
+    }
+    return m_maxNs;
+}
+
+void RollingLatencyHistogram::Rotate() {
+    m_head = (m_head + 1) % kSlices;
+    m_slices[m_head].Clear();
+}
+
+void RollingLatencyHistogram::Merge(LatencyHistogram& out) const {
+    out.Clear();
+    for (const LatencyHistogram& slice : m_slices) { out.Add(slice); }
+}
+
+void RollingLatencyHistogram::Clear() {
+    for (LatencyHistogram& slice : m_slices) { slice.Clear(); }
+    m_head = 0;
+}
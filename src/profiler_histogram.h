@@ -0,0 +1,51 @@
+#pragma once
+
+#include <array>
+#include <cstdint>
+
+// Log-bucketed latency histogram (HDR-style). Values are nanoseconds, quantized to 64 ns units; every power of two
+// is split into 64 linear sub-buckets, so a reported value is within ~0.8% of the recorded one from 4 us up to ~137 s
+// (larger values saturate into the top bucket). Fixed size (6.5 KB), no allocation; single writer.
+class LatencyHistogram {
+  public:
+    static constexpr int kUnitShift = 6;      // 64 ns resolution at the bottom of the range
+    static constexpr int kSubBucketBits = 6;  // 64 sub-buckets per power of two: half a bucket is at most 1/128 of a value
+    static constexpr int kSubBuckets = 1 << kSubBucketBits;
+    static constexpr int kMaxShift = 24;      // Top octave: units in [2^30, 2^31), i.e. ~69-137 s
+    static constexpr int kBucketCount = (kMaxShift + 2) * kSubBuckets;
+
+    void Record(int64_t valueNs);
+    void Add(const LatencyHistogram& other);
+    void Clear();
+
+    uint64_t Count() const { return m_count; }
+    int64_t MaxNs() const { return m_maxNs; }
+
+    // Value at quantile q (0..1], reported as the midpoint of its bucket. 0 when empty.
+    int64_t ValueAtQuantileNs(double q) const;
+
+    static int BucketIndex(int64_t valueNs);
+    static int64_t BucketLowerNs(int index);
+    static int64_t BucketWidthNs(int index);
+
+  private:
+    std::array<uint32_t, kBucketCount> m_buckets{};
+    uint64_t m_count = 0;
+    int64_t m_maxNs = 0;
+};
+
+// Rolling window of per-second histograms. Record() goes into the current slice; Rotate() (once per second) starts
+// a new slice and forgets the oldest, so Merge() covers the last kSlices seconds.
+class RollingLatencyHistogram {
+  public:
+    static constexpr int kSlices = 5;
+
+    void Record(int64_t valueNs) { m_slices[m_head].Record(valueNs); }
+    void Rotate();
+    void Merge(LatencyHistogram& out) const;
+    void Clear();
+
+  private:
+    std::array<LatencyHistogram, kSlices> m_slices;
+    int m_head = 0;
+};
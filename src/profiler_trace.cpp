@@ -0,0 +1,217 @@
+#include "profiler_trace.h"
+
+#include <cstdio>
+
+// ============================================================================
+// ChromeTraceWriter
+// ============================================================================
+
+static void AppendJsonString(std::string& out, const char* text) {
+    out += '"';
+    for (const char* p = text ? text : ""; *p; ++p) {
+        const unsigned char c = static_cast<unsigned char>(*p);
+        if (c == '"' || c == '\\') {
+            out += '\\';
+            out += static_cast<char>(c);
+        } else if (c < 0x20) {
+            char escaped[8];
+            snprintf(escaped, sizeof(escaped), "\\u%04x", c);
+            out += escaped;
+        } else {
+            out += static_cast<char>(c);
+        }
+    }
+    out += '"';
+}
+
+// Microseconds with nanosecond precision, the unit Chrome trace timestamps use
+static void AppendMicros(std::string& out, int64_t ns) {
+    char buffer[32];
+    const char* sign = ns < 0 ? "-" : "";
+    const int64_t magnitude = ns < 0 ? -ns : ns;
+    snprintf(buffer, sizeof(buffer), "%s%lld.%03lld", sign, static_cast<long long>(magnitude / 1000), static_cast<long long>(magnitude % 1000));
+    out += buffer;
+}
+
+bool ChromeTraceWriter::Open(const std::filesystem::path& path, int64_t originNs) {
+    m_out.open(path, std::ios::binary | std::ios::trunc);
+    if (!m_out.is_open()) { return false; }
+    m_originNs = originNs;
+    m_firstRecord = true;
+    m_out << "{\"displayTimeUnit\":\"ms\",\"traceEvents\":[";
+
+    m_line.clear();
+    BeginRecord();
+    m_line += "{\"name\":\"process_name\",\"ph\":\"M\",\"pid\":1,\"args\":{\"name\":\"Toolscreen\"}}";
+    m_out << m_line;
+    return m_out.good();
+}
+
+void ChromeTraceWriter::BeginRecord() {
+    m_line += m_firstRecord ? "\n" : ",\n";
+    m_firstRecord = false;
+}
+
+void ChromeTraceWriter::WriteThreadName(uint32_t threadId, const std::string& name) {
+    m_line.clear();
+    BeginRecord();
+    m_line += "{\"name\":\"thread_name\",\"ph\":\"M\",\"pid\":1,\"tid\":";
+    m_line += std::to_string(threadId);
+    m_line += ",\"args\":{\"name\":";
+    AppendJsonString(m_line, name.c_str());
+    m_line += "}}";
+    m_out << m_line;
+}
+
+void ChromeTraceWriter::WriteEvent(const ProfilerTraceEvent& event) {
+    m_line.clear();
+    BeginRecord();
+    m_line += "{\"name\":";
+    AppendJsonString(m_line, event.name);
+    m_line += ",\"ph\":\"X\",\"pid\":1,\"tid\":";
+    m_line += std::to_string(event.threadId);
+    m_line += ",\"ts\":";
+    AppendMicros(m_line, event.startNs - m_originNs);
+    m_line += ",\"dur\":";
+    AppendMicros(m_line, event.durationNs);
+    m_line += '}';
+    m_out << m_line;
+}
+
+bool ChromeTraceWriter::Close() {
+    if (!m_out.is_open()) { return false; }
+    m_out << "\n]}\n";
+    const bool ok = m_out.good();
+    m_out.close();
+    return ok && !m_out.fail();
+}
+
+// ============================================================================
+// ProfilerTraceCapture
+// ============================================================================
+
+ProfilerTraceCapture::~ProfilerTraceCapture() {
+    // Usually destroyed during static destruction - never block there on a writer thread
+    if (m_writer.joinable()) { m_writer.detach(); }
+}
+
+bool ProfilerTraceCapture::Start(const std::filesystem::path& path, int64_t nowNs, int64_t durationNs) {
+    std::lock_guard<std::mutex> startLock(m_startMutex);
+    if (IsActive() || !m_writerDone.load(std::memory_order_acquire)) { return false; }
+    if (m_writer.joinable()) { m_writer.join(); } // Already finished, returns immediately
+
+    if (!m_file.Open(path, nowNs)) { return false; }
+    m_path = path;
+    m_startNs = nowNs;
+    m_endNs = nowNs + durationNs;
+
+    m_batch.clear();
+    m_namedThreads.clear();
+    m_batchNames.clear();
+    m_dropped = 0;
+    {
+        std::lock_guard<std::mutex> lock(m_queueMutex);
+        m_queue.clear();
+        m_queueNames.clear();
+        m_ending = false;
+    }
+
+    m_writerDone.store(false, std::memory_order_release);
+    m_writer = std::thread(&ProfilerTraceCapture::WriterMain, this);
+    m_active.store(true, std::memory_order_release); // Producer state above is visible once this is observed
+    return true;
+}
+
+void ProfilerTraceCapture::AddThread(uint32_t threadId, const char* name) {
+    for (uint32_t known : m_namedThreads) {
+        if (known == threadId) { return; }
+    }
+    m_namedThreads.push_back(threadId);
+    m_batchNames.emplace_back(threadId, name ? std::string(name) : "Thread " + std::to_string(threadId));
+}
+
+void ProfilerTraceCapture::AddEvent(const ProfilerTraceEvent& event) {
+    if (event.startNs < m_startNs || event.startNs >= m_endNs) { return; }
+    m_batch.push_back(event);
+}
+
+void ProfilerTraceCapture::HandOffBatch(bool ending) {
+    {
+        std::lock_guard<std::mutex> lock(m_queueMutex);
+        if (m_queue.size() + m_batch.size() > kMaxQueuedEvents) {
+            m_dropped += m_batch.size();
+        } else {
+            m_queue.insert(m_queue.end(), m_batch.begin(), m_batch.end());
+        }
+        for (auto& name : m_batchNames) { m_queueNames.push_back(std::move(name)); }
+        if (ending) { m_ending = true; }
+    }
+    m_batch.clear();
+    m_batchNames.clear();
+    m_queueCv.notify_one();
+}
+
+bool ProfilerTraceCapture::Flush(int64_t nowNs) {
+    if (!IsActive()) { return false; }
+    const bool ending = nowNs >= m_endNs + kEndGraceNs;
+    HandOffBatch(ending);
+    if (ending) { m_active.store(false, std::memory_order_release); }
+    return ending;
+}
+
+void ProfilerTraceCapture::Finish() {
+    if (IsActive()) {
+        HandOffBatch(true);
+        m_active.store(false, std::memory_order_release);
+    }
+    std::lock_guard<std::mutex> startLock(m_startMutex);
+    if (m_writer.joinable()) { m_writer.join(); }
+}
+
+void ProfilerTraceCapture::WriterMain() {
+    std::vector<ProfilerTraceEvent> events;
+    std::vector<std::pair<uint32_t, std::string>> names;
+    uint64_t written = 0;
+
+    for (;;) {
+        bool ending = false;
+        {
+            std::unique_lock<std::mutex> lock(m_queueMutex);
+            m_queueCv.wait(lock, [this] { return !m_queue.empty() || !m_queueNames.empty() || m_ending; });
+            events.swap(m_queue);
+            names.swap(m_queueNames);
+            ending = m_ending; // Set in the same critical section as the final batch, so nothing follows it
+        }
+
+        for (const auto& [threadId, name] : names) { m_file.WriteThreadName(threadId, name); }
+        for (const auto& event : events) { m_file.WriteEvent(event); }
+        written += events.size();
+        events.clear();
+        names.clear();
+
+        if (ending) { break; }
+    }
+
+    Result result;
+    result.path = m_path;
+    result.events = written;
+    {
+        std::lock_guard<std::mutex> lock(m_queueMutex);
+        result.dropped = m_dropped;
+    }
+    result.ok = m_file.Close();
+    {
+        std::lock_guard<std::mutex> lock(m_resultMutex);
+        m_result = std::move(result);
+        m_hasResult.store(true, std::memory_order_release);
+    }
+    m_writerDone.store(true, std::memory_order_release);
+}
+
+bool ProfilerTraceCapture::TakeResult(Result& out) {
+    if (!m_hasResult.load(std::memory_order_acquire)) { return false; }
+    std::lock_guard<std::mutex> lock(m_resultMutex);
+    out = std::move(m_result);
+    m_hasResult.store(false, std::memory_order_relaxed);
+    return true;
+}
@@ -0,0 +1,111 @@
+#pragma once
+
+#include <atomic>
+#include <condition_variable>
+#include <cstdint>
+#include <filesystem>
+#include <fstream>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <utility>
+#include <vector>
+
+// Timeline capture for the profiler: scope events with absolute start times, streamed to a Chrome trace JSON file
+// that opens in ui.perfetto.dev or chrome://tracing. Platform-neutral.
+
+struct ProfilerTraceEvent {
+    const char* name; // Static string (from PROFILE_SCOPE macro)
+    int64_t startNs;  // steady_clock nanoseconds
+    int64_t durationNs;
+    uint32_t threadId;
+};
+
+// Writes the Chrome trace "JSON object format": one complete ("X") event per scope plus thread_name metadata.
+// Timestamps are written relative to originNs so the timeline starts at zero.
+class ChromeTraceWriter {
+  public:
+    bool Open(const std::filesystem::path& path, int64_t originNs);
+    void WriteThreadName(uint32_t threadId, const std::string& name);
+    void WriteEvent(const ProfilerTraceEvent& event);
+    bool Close(); // Terminates the JSON document; false if any write failed
+
+    bool IsOpen() const { return m_out.is_open(); }
+
+  private:
+    void BeginRecord();
+
+    std::ofstream m_out;
+    std::string m_line;
+    int64_t m_originNs = 0;
+    bool m_firstRecord = true;
+};
+
+// One capture session. The thread draining the profiler rings is the only producer (AddThread/AddEvent/Flush);
+// a writer thread owned by the session streams batches to disk so file I/O never runs on the producer.
+class ProfilerTraceCapture {
+  public:
+    struct Result {
+        std::filesystem::path path;
+        uint64_t events = 0;
+        uint64_t dropped = 0; // Events discarded because the writer fell behind
+        bool ok = false;
+    };
+
+    static constexpr size_t kMaxQueuedEvents = 1 << 20; // Writer backlog cap (~24 MB)
+    static constexpr int64_t kEndGraceNs = 250000000;    // Keep draining after the window so straddling scopes land
+
+    ProfilerTraceCapture() = default;
+    ~ProfilerTraceCapture();
+
+    ProfilerTraceCapture(const ProfilerTraceCapture&) = delete;
+    ProfilerTraceCapture& operator=(const ProfilerTraceCapture&) = delete;
+
+    // Records [nowNs, nowNs + durationNs). Fails if a capture is active, its file is still being written, or the
+    // file can't be created. Safe to call from any thread.
+    bool Start(const std::filesystem::path& path, int64_t nowNs, int64_t durationNs);
+    bool IsActive() const { return m_active.load(std::memory_order_acquire); }
+
+    // Producer side
+    void AddThread(uint32_t threadId, const char* name); // Emitted once per capture; name may be null
+    void AddEvent(const ProfilerTraceEvent& event);      // Events starting outside the capture window are ignored
+    // Hands pending events to the writer and ends the capture once nowNs passes its end. Returns true on the call
+    // that ended it.
+    bool Flush(int64_t nowNs);
+
+    // Ends an active capture early (producer side) and blocks until the file is complete
+    void Finish();
+
+    // Returns the result of the last completed capture, once
+    bool TakeResult(Result& out);
+
+  private:
+    void WriterMain();
+    void HandOffBatch(bool ending);
+
+    std::mutex m_startMutex; // Serializes Start/Finish against each other (hotkey vs. GUI)
+    std::atomic<bool> m_active{ false };
+    std::atomic<bool> m_writerDone{ true };
+    std::thread m_writer;
+    ChromeTraceWriter m_file;
+    std::filesystem::path m_path;
+    int64_t m_startNs = 0;
+    int64_t m_endNs = 0;
+
+    // Producer-local
+    std::vector<ProfilerTraceEvent> m_batch;
+    std::vector<uint32_t> m_namedThreads;
+    std::vector<std::pair<uint32_t, std::string>> m_batchNames;
+    uint64_t m_dropped = 0;
+
+    // Producer -> writer handoff
+    std::mutex m_queueMutex;
+    std::condition_variable m_queueCv;
+    std::vector<ProfilerTraceEvent> m_queue;
+    std::vector<std::pair<uint32_t, std::string>> m_queueNames;
+    bool m_ending = false;
+
+    std::mutex m_resultMutex;
+    Result m_result;
+    std::atomic<bool> m_hasResult{ false }; // Lets TakeResult() skip the lock on the common path
+};
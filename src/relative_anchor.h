@@ -0,0 +1,21 @@
+#pragma once
+
+#include <string>
+
+// Output anchors are a corner/edge name with an optional "Screen" or "Viewport" suffix ("topLeftScreen",
+// "centerViewport", "bottomRight"). Platform-neutral.
+
+// Writes the base name GetRelativeCoords takes into `anchor` and returns whether the anchor is screen-relative.
+// `anchor` is assigned in place, so a buffer reused across frames stops allocating once it holds the longest name.
+inline bool SplitRelativeAnchor(const std::string& relativeTo, std::string& anchor) {
+    if (relativeTo.length() > 6 && relativeTo.compare(relativeTo.length() - 6, 6, "Screen") == 0) {
+        anchor.assign(relativeTo, 0, relativeTo.length() - 6);
+        return true;
+    }
+    if (relativeTo.length() > 8 && relativeTo.compare(relativeTo.length() - 8, 8, "Viewport") == 0) {
+        anchor.assign(relativeTo, 0, relativeTo.length() - 8);
+    } else {
+        anchor.assign(relativeTo);
+    }
+    return false;
+}
@@ -6,14 +6,15 @@
 #include "obs_thread.h"
 #include "profiler.h"
 #include "render_thread.h"
-#include "stb_image.h"
 #include "utils.h"
 #include "window_overlay.h"
 #include <algorithm>
 #include <chrono>
 #include <cstring>
+#include <deque>
 #include <iostream>
 #include <shared_mutex>
+#include <type_traits>
 #include <unordered_map>
 
 // These caches provide O(1) lookup instead of O(n) linear search for active element collection
@@ -879,32 +880,30 @@ void CleanupShaders() {
     }
 }
 
+namespace {
+// Caller holds g_texturesToDeleteMutex. frameTextures is also filled while an animation is still uploading (before
+// isAnimated is set), so it decides rather than isAnimated.
+template <typename Instance> void QueueImageTexturesForDeletion(const Instance& inst) {
+    if (!inst.frameTextures.empty()) {
+        for (GLuint tex : inst.frameTextures) {
+            if (tex != 0) g_texturesToDelete.push_back(tex);
+        }
+    } else if (inst.textureId != 0) {
+        g_texturesToDelete.push_back(inst.textureId);
+    }
+}
+} // namespace
+
 void DiscardAllGPUImages() {
     PROFILE_SCOPE_CAT("GPU Image Discard", "GPU Operations");
     std::lock_guard<std::mutex> lock(g_texturesToDeleteMutex);
 
     // Clean up background textures (static and animated)
-    for (auto const& [id, inst] : g_backgroundTextures) {
-        if (inst.isAnimated) {
-            for (GLuint tex : inst.frameTextures) {
-                if (tex != 0) g_texturesToDelete.push_back(tex);
-            }
-        } else if (inst.textureId != 0) {
-            g_texturesToDelete.push_back(inst.textureId);
-        }
-    }
+    for (auto const& [id, inst] : g_backgroundTextures) { QueueImageTexturesForDeletion(inst); }
     g_backgroundTextures.clear();
 
     // Clean up user images (static and animated)
-    for (auto const& [id, inst] : g_userImages) {
-        if (inst.isAnimated) {
-            for (GLuint tex : inst.frameTextures) {
-                if (tex != 0) g_texturesToDelete.push_back(tex);
-            }
-        } else if (inst.textureId != 0) {
-            g_texturesToDelete.push_back(inst.textureId);
-        }
-    }
+    for (auto const& [id, inst] : g_userImages) { QueueImageTexturesForDeletion(inst); }
     g_userImages.clear();
     Log("All background and user image textures have been queued for deletion.");
 }
@@ -1137,12 +1136,6 @@ void CleanupGPUResources() {
         std::lock_guard<std::mutex> lock(g_decodedImagesMutex);
         if (!g_decodedImagesQueue.empty()) {
             Log("Cleaning up " + std::to_string(g_decodedImagesQueue.size()) + " " + "pending decoded images to prevent memory leaks...");
-            for (auto& decodedImg : g_decodedImagesQueue) {
-                if (decodedImg.data) {
-                    stbi_image_free(decodedImg.data);
-                    decodedImg.data = nullptr; // Prevent double-free
-                }
-            }
             g_decodedImagesQueue.clear();
         }
     }
@@ -1181,174 +1174,139 @@ void CleanupGPUResources() {
     g_glInitialized = false;
     Log("CleanupGPUResources: Cleanup complete.");
 }
-void UploadDecodedImageToGPU(const DecodedImageData& imgData) {
-    PROFILE_SCOPE_CAT("GPU Image Upload", "GPU Operations");
-    if (imgData.type == DecodedImageData::Type::Background) {
-        std::lock_guard<std::mutex> bgLock(g_backgroundTexturesMutex);
+namespace {
+// Decoded parts waiting for upload. Frames go up a few per call so a long animation doesn't stall the render thread.
+struct PendingImageUpload {
+    DecodedImageData data;
+    size_t nextFrame = 0; // Index into data.part.image->frames
+};
+std::deque<PendingImageUpload> s_pendingImageUploads;
+// Latest load started per image; parts of a superseded load are dropped. Render thread only.
+std::map<std::pair<DecodedImageData::Type, std::string>, uint64_t> s_currentImageLoads;
+
+GLuint CreateImageFrameTexture(const DecodedImage& image, size_t frame) {
+    GLuint t;
+    glGenTextures(1, &t);
+    glBindTexture(GL_TEXTURE_2D, t);
+    glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_S, GL_CLAMP_TO_EDGE);
+    glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_T, GL_CLAMP_TO_EDGE);
+    glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MIN_FILTER, GL_LINEAR);
+    glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MAG_FILTER, GL_LINEAR);
+    glPixelStorei(GL_UNPACK_ROW_LENGTH, 0);
+    glPixelStorei(GL_UNPACK_SKIP_PIXELS, 0);
+    glPixelStorei(GL_UNPACK_SKIP_ROWS, 0);
+    glPixelStorei(GL_UNPACK_ALIGNMENT, 4);
+
+    glTexImage2D(GL_TEXTURE_2D, 0, GL_RGBA8, image.width, image.height, 0, GL_RGBA, GL_UNSIGNED_BYTE, image.frames[frame].data());
+    glGenerateMipmap(GL_TEXTURE_2D);
+    return t;
+}
 
-        // Clean up old instance if it exists
-        auto it = g_backgroundTextures.find(imgData.id);
-        if (it != g_backgroundTextures.end()) {
-            BackgroundTextureInstance& oldInst = it->second;
+// Uploads frames of `pending` until done or past `deadline` (at least one frame per call, so uploads always progress).
+// Returns true once the part is finished or dropped.
+template <typename Instance>
+bool UploadPendingImageFrames(std::map<std::string, Instance>& instances, PendingImageUpload& pending, const char* kind,
+                              std::chrono::steady_clock::time_point deadline, bool& uploadedAny) {
+    const DecodedImageData& data = pending.data;
+    const DecodedImage& image = *data.part.image;
+
+    if (pending.nextFrame == 0 && data.part.firstFrame == 0) {
+        // First part of a load: replace the old instance. The new one shows frame 0 until the rest is uploaded.
+        auto it = instances.find(data.id);
+        if (it != instances.end()) {
             std::lock_guard<std::mutex> lock(g_texturesToDeleteMutex);
-            if (oldInst.isAnimated) {
-                for (GLuint tex : oldInst.frameTextures) {
-                    if (tex != 0) g_texturesToDelete.push_back(tex);
-                }
-            } else if (oldInst.textureId != 0) {
-                g_texturesToDelete.push_back(oldInst.textureId);
-            }
-            g_backgroundTextures.erase(it);
+            QueueImageTexturesForDeletion(it->second);
+            instances.erase(it);
         }
 
-        if (imgData.data) {
-            BackgroundTextureInstance inst;
-
-            if (imgData.isAnimated && imgData.frameCount > 1) {
-                // Animated background: create texture for each frame
-                inst.isAnimated = true;
-                inst.frameDelays = imgData.frameDelays;
-                inst.currentFrame = 0;
-                inst.lastFrameTime = std::chrono::steady_clock::now();
-
-                int frameHeight = imgData.frameHeight;
-                for (int i = 0; i < imgData.frameCount; i++) {
-                    GLuint t;
-                    glGenTextures(1, &t);
-                    glBindTexture(GL_TEXTURE_2D, t);
-                    glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_S, GL_CLAMP_TO_EDGE);
-                    glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_T, GL_CLAMP_TO_EDGE);
-                    glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MIN_FILTER, GL_LINEAR);
-                    glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MAG_FILTER, GL_LINEAR);
-                    glPixelStorei(GL_UNPACK_ROW_LENGTH, 0);
-                    glPixelStorei(GL_UNPACK_SKIP_PIXELS, 0);
-                    glPixelStorei(GL_UNPACK_SKIP_ROWS, 0);
-                    glPixelStorei(GL_UNPACK_ALIGNMENT, 4);
-
-                    // Upload this frame (frames are stacked vertically in the data)
-                    unsigned char* frameData = imgData.data + (i * frameHeight * imgData.width * 4);
-                    glTexImage2D(GL_TEXTURE_2D, 0, GL_RGBA8, imgData.width, frameHeight, 0, GL_RGBA, GL_UNSIGNED_BYTE, frameData);
-                    glGenerateMipmap(GL_TEXTURE_2D);
-
-                    inst.frameTextures.push_back(t);
-                }
-                inst.textureId = inst.frameTextures[0]; // Start with first frame
-
-                g_backgroundTextures[imgData.id] = inst;
-                Log("Uploaded animated background for '" + imgData.id + "' to GPU (" + std::to_string(imgData.frameCount) + " frames).");
-            } else {
-                // Static background
-                inst.isAnimated = false;
-
-                GLuint t;
-                glGenTextures(1, &t);
-                glBindTexture(GL_TEXTURE_2D, t);
-                glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_S, GL_CLAMP_TO_EDGE);
-                glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_T, GL_CLAMP_TO_EDGE);
-                glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MIN_FILTER, GL_LINEAR);
-                glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MAG_FILTER, GL_LINEAR);
-                glPixelStorei(GL_UNPACK_ROW_LENGTH, 0);
-                glPixelStorei(GL_UNPACK_SKIP_PIXELS, 0);
-                glPixelStorei(GL_UNPACK_SKIP_ROWS, 0);
-                glPixelStorei(GL_UNPACK_ALIGNMENT, 4);
-
-                glTexImage2D(GL_TEXTURE_2D, 0, GL_RGBA8, imgData.width, imgData.frameHeight, 0, GL_RGBA, GL_UNSIGNED_BYTE, imgData.data);
-                glGenerateMipmap(GL_TEXTURE_2D);
-
-                inst.textureId = t;
-                g_backgroundTextures[imgData.id] = inst;
-                Log("Uploaded background for '" + imgData.id + "' to GPU.");
-            }
-        } else {
-            Log("Skipping GPU upload for background '" + imgData.id + "' due to null image data.");
-        }
-    } else if (imgData.type == DecodedImageData::Type::UserImage) {
-        // Clean up old instance if it exists
-        auto it = g_userImages.find(imgData.id);
-        if (it != g_userImages.end()) {
-            UserImageInstance& oldInst = it->second;
-            std::lock_guard<std::mutex> lock(g_texturesToDeleteMutex);
-            if (oldInst.isAnimated) {
-                for (GLuint tex : oldInst.frameTextures) {
-                    if (tex != 0) g_texturesToDelete.push_back(tex);
-                }
-            } else if (oldInst.textureId != 0) {
-                g_texturesToDelete.push_back(oldInst.textureId);
-            }
-            g_userImages.erase(it);
-        }
-
-        if (imgData.data) {
-            UserImageInstance inst;
-            inst.width = imgData.width;
-            inst.height = imgData.frameHeight; // Height of single frame
+        Instance inst;
+        if constexpr (std::is_same_v<Instance, UserImageInstance>) {
+            inst.width = image.width;
+            inst.height = image.height;
 
             // Check if first frame is fully transparent
             inst.isFullyTransparent = true;
-            int framePixels = imgData.width * imgData.frameHeight;
-            for (int i = 0; i < framePixels; i++) {
-                if (imgData.data[i * 4 + 3] > 0) {
+            const std::vector<uint8_t>& firstFrame = image.frames[0];
+            for (size_t i = 3; i < firstFrame.size(); i += 4) {
+                if (firstFrame[i] > 0) {
                     inst.isFullyTransparent = false;
                     break;
                 }
             }
+        }
+        instances[data.id] = std::move(inst);
+    }
+
+    auto it = instances.find(data.id);
+    if (it == instances.end()) return true; // Discarded while its animation was still uploading
+    Instance& inst = it->second;
+
+    while (pending.nextFrame < image.frames.size()) {
+        if (uploadedAny && std::chrono::steady_clock::now() >= deadline) return false;
+        const GLuint t = CreateImageFrameTexture(image, pending.nextFrame);
+        if (inst.frameTextures.empty()) inst.textureId = t;
+        inst.frameTextures.push_back(t);
+        inst.frameDelays.push_back(image.frameDelays[pending.nextFrame]);
+        pending.nextFrame++;
+        uploadedAny = true;
+    }
+
+    if (data.part.lastPart) {
+        if (inst.frameTextures.size() > 1) {
+            inst.isAnimated = true;
+            inst.currentFrame = 0;
+            inst.lastFrameTime = std::chrono::steady_clock::now();
+            Log("Uploaded animated " + std::string(kind) + " '" + data.id + "' to GPU (" + std::to_string(inst.frameTextures.size()) +
+                " frames).");
+        } else {
+            inst.frameTextures.clear();
+            inst.frameDelays.clear();
+            Log("Uploaded " + std::string(kind) + " '" + data.id + "' to GPU.");
+        }
+    }
+    return true;
+}
+} // namespace
 
-            if (imgData.isAnimated && imgData.frameCount > 1) {
-                // Animated user image: create texture for each frame
-                inst.isAnimated = true;
-                inst.frameDelays = imgData.frameDelays;
-                inst.currentFrame = 0;
-                inst.lastFrameTime = std::chrono::steady_clock::now();
-
-                int frameHeight = imgData.frameHeight;
-                for (int i = 0; i < imgData.frameCount; i++) {
-                    GLuint t;
-                    glGenTextures(1, &t);
-                    glBindTexture(GL_TEXTURE_2D, t);
-                    glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_S, GL_CLAMP_TO_EDGE);
-                    glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_T, GL_CLAMP_TO_EDGE);
-                    glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MIN_FILTER, GL_LINEAR);
-                    glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MAG_FILTER, GL_LINEAR);
-                    glPixelStorei(GL_UNPACK_ROW_LENGTH, 0);
-                    glPixelStorei(GL_UNPACK_SKIP_PIXELS, 0);
-                    glPixelStorei(GL_UNPACK_SKIP_ROWS, 0);
-                    glPixelStorei(GL_UNPACK_ALIGNMENT, 4);
-
-                    // Upload this frame (frames are stacked vertically in the data)
-                    unsigned char* frameData = imgData.data + (i * frameHeight * imgData.width * 4);
-                    glTexImage2D(GL_TEXTURE_2D, 0, GL_RGBA8, imgData.width, frameHeight, 0, GL_RGBA, GL_UNSIGNED_BYTE, frameData);
-                    glGenerateMipmap(GL_TEXTURE_2D);
-
-                    inst.frameTextures.push_back(t);
-                }
-                inst.textureId = inst.frameTextures[0]; // Start with first frame
-
-                g_userImages[imgData.id] = inst;
-                Log("Uploaded animated user image '" + imgData.id + "' to GPU (" + std::to_string(imgData.frameCount) + " frames).");
-            } else {
-                // Static user image
-                inst.isAnimated = false;
-
-                glGenTextures(1, &inst.textureId);
-                glBindTexture(GL_TEXTURE_2D, inst.textureId);
-                glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_S, GL_CLAMP_TO_EDGE);
-                glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_T, GL_CLAMP_TO_EDGE);
-                glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MIN_FILTER, GL_LINEAR);
-                glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MAG_FILTER, GL_LINEAR);
-                glPixelStorei(GL_UNPACK_ROW_LENGTH, 0);
-                glPixelStorei(GL_UNPACK_SKIP_PIXELS, 0);
-                glPixelStorei(GL_UNPACK_SKIP_ROWS, 0);
-                glPixelStorei(GL_UNPACK_ALIGNMENT, 4);
-
-                glTexImage2D(GL_TEXTURE_2D, 0, GL_RGBA8, imgData.width, imgData.frameHeight, 0, GL_RGBA, GL_UNSIGNED_BYTE, imgData.data);
-                glGenerateMipmap(GL_TEXTURE_2D);
-
-                g_userImages[imgData.id] = inst;
-                Log("Uploaded user image '" + imgData.id + "' to GPU.");
+void UploadDecodedImagesToGPU(std::chrono::microseconds budget) {
+    PROFILE_SCOPE_CAT("GPU Image Upload", "GPU Operations");
+    {
+        std::lock_guard<std::mutex> lock(g_decodedImagesMutex);
+        for (DecodedImageData& decoded : g_decodedImagesQueue) {
+            if (decoded.part.image && !decoded.part.image->frames.empty()) s_pendingImageUploads.push_back({ std::move(decoded) });
+        }
+        g_decodedImagesQueue.clear();
+    }
+
+    const auto deadline = std::chrono::steady_clock::now() + budget;
+    bool uploadedAny = false;
+    while (!s_pendingImageUploads.empty()) {
+        if (uploadedAny && std::chrono::steady_clock::now() >= deadline) break; // Continues next call
+        PendingImageUpload& pending = s_pendingImageUploads.front();
+        const DecodedImageData& data = pending.data;
+
+        // Loads can finish out of order on the decode pool; only the newest one per image is uploaded
+        if (pending.nextFrame == 0) {
+            const auto key = std::make_pair(data.type, data.id);
+            auto current = s_currentImageLoads.find(key);
+            const bool superseded = current != s_currentImageLoads.end() && (data.part.firstFrame == 0 ? data.loadId < current->second
+                                                                                                       : data.loadId != current->second);
+            if (superseded || (data.part.firstFrame != 0 && current == s_currentImageLoads.end())) {
+                s_pendingImageUploads.pop_front();
+                continue;
             }
+            if (data.part.firstFrame == 0) s_currentImageLoads[key] = data.loadId;
+        }
+
+        bool finished;
+        if (data.type == DecodedImageData::Type::Background) {
+            std::lock_guard<std::mutex> bgLock(g_backgroundTexturesMutex);
+            finished = UploadPendingImageFrames(g_backgroundTextures, pending, "background", deadline, uploadedAny);
         } else {
-            Log("Skipping GPU upload for user image '" + imgData.id + "' due to null image data.");
+            finished = UploadPendingImageFrames(g_userImages, pending, "user image", deadline, uploadedAny);
         }
+        if (!finished) break;
+        s_pendingImageUploads.pop_front();
     }
 }
 
@@ -1396,7 +1354,7 @@ void InitializeGPUResources() {
     {
         auto initSnap = GetConfigSnapshot();
         if (initSnap) { mirrorsToCreate = initSnap->mirrors; }
-        LogCategory("init", "Found " + std::to_string(mirrorsToCreate.size()) + " mirrors in config to create.");
+        LogCategory(LogCategoryId::Init, "Found " + std::to_string(mirrorsToCreate.size()) + " mirrors in config to create.");
     }
     // Release the framebuffer binding before calling CreateMirrorGPUResources
     glBindFramebuffer(GL_FRAMEBUFFER, last_framebuffer);
@@ -1448,7 +1406,7 @@ void InitializeGPUResources() {
 
     glBindVertexArray(0);
 
-    LogCategory("init", "Restoring original OpenGL state...");
+    LogCategory(LogCategoryId::Init, "Restoring original OpenGL state...");
     glUseProgram(last_program);
     glActiveTexture(last_active_texture);
     glBindTexture(GL_TEXTURE_2D, last_texture);
@@ -1457,7 +1415,7 @@ void InitializeGPUResources() {
     glBindFramebuffer(GL_FRAMEBUFFER, last_framebuffer);
 
     g_glInitialized = true;
-    LogCategory("init", "--- GPU resources initialized successfully. ---");
+    LogCategory(LogCategoryId::Init, "--- GPU resources initialized successfully. ---");
 }
 
 void CreateMirrorGPUResources(const MirrorConfig& conf) {
@@ -1531,9 +1489,10 @@ void CreateMirrorGPUResources(const MirrorConfig& conf) {
         inst.capturedAsRawOutput = conf.rawOutput;
         inst.capturedAsRawOutputBack = conf.rawOutput;
         g_mirrorInstances[conf.name] = inst;
-        LogCategory("init", "Created double-buffered GPU resources for mirror '" + conf.name + "' (FBO: " + std::to_string(inst.fbo) +
-                                ", Back: " + std::to_string(inst.fboBack) + ", FinalFBO: " + std::to_string(inst.finalFbo) + " [" +
-                                std::to_string(inst.final_w) + "x" + std::to_string(inst.final_h) + "])");
+        LogCategory(LogCategoryId::Init,
+                    "Created double-buffered GPU resources for mirror '" + conf.name + "' (FBO: " + std::to_string(inst.fbo) +
+                        ", Back: " + std::to_string(inst.fboBack) + ", FinalFBO: " + std::to_string(inst.finalFbo) + " [" +
+                        std::to_string(inst.final_w) + "x" + std::to_string(inst.final_h) + "])");
     } else {
         Log("ERROR: Failed to create complete framebuffers for mirror '" + conf.name + "'");
         // Clean up failed resources
@@ -2010,7 +1969,7 @@ void RenderModeInternal(const ModeConfig* modeToRender, const GLState& s, int cu
     }
 
     // Note: Active elements (mirrors/images/overlays) are collected on the render thread
-    // via RT_CollectActiveElements. Here we only check if mirrors exist for thread startup
+    // from per-mode render lists (render_list.h). Here we only check if mirrors exist for thread startup
     // and use mode's direct ID lists for drag mode input handling.
     bool hasMirrors = !modeToRender->mirrorIds.empty() || !modeToRender->mirrorGroupIds.empty();
 
@@ -2876,7 +2835,7 @@ void RenderModeInternal(const ModeConfig* modeToRender, const GLState& s, int cu
                     else if (!leftButtonDown && s_isWindowOverlayDragging) {
                         s_isWindowOverlayDragging = false;
                         s_draggedWindowOverlayName = "";
-                        SaveConfigImmediate();
+                        SaveConfig();
                     }
 
                     s_hoveredWindowOverlayName = hoveredOverlay;
@@ -2922,7 +2881,7 @@ void RenderModeInternal(const ModeConfig* modeToRender, const GLState& s, int cu
             request.finalW = currentGeo.finalW;
             request.finalH = currentGeo.finalH;
             request.gameTextureId = gameTextureToUse;
-            request.modeId = modeToRender->id;
+            request.mode = InternModeId(modeToRender->id);
             request.isAnimating = isAnimating;
             request.overlayOpacity = overlayOpacity;
             request.obsDetected = g_graphicsHookDetected.load();
@@ -3002,7 +2961,7 @@ void RenderModeInternal(const ModeConfig* modeToRender, const GLState& s, int cu
 
             // Transition-related background/border (for transitioning TO Fullscreen)
             request.transitioningToFullscreen = isAnimating && EqualsIgnoreCase(modeToRender->id, "Fullscreen");
-            request.fromModeId = transitionState.fromModeId;
+            request.fromMode = InternModeId(transitionState.fromModeId);
             if (!transitionState.fromModeId.empty()) {
                 const ModeConfig* fromMode = GetMode_Internal(transitionState.fromModeId);
                 if (fromMode) {
@@ -3565,9 +3524,9 @@ static float CalculateBounceOffset(float bounceProgress, int bounceIndex, int to
 
 void StartModeTransition(const std::string& fromModeId, const std::string& toModeId, int fromWidth, int fromHeight, int fromX, int fromY,
                          int toWidth, int toHeight, int toX, int toY, const ModeConfig& toMode) {
-    LogCategory("animation", "[ANIMATION] StartModeTransition entry - acquiring g_modeTransitionMutex...");
+    LogCategory(LogCategoryId::Animation, "[ANIMATION] StartModeTransition entry - acquiring g_modeTransitionMutex...");
     std::lock_guard<std::mutex> lock(g_modeTransitionMutex);
-    LogCategory("animation", "[ANIMATION] g_modeTransitionMutex acquired");
+    LogCategory(LogCategoryId::Animation, "[ANIMATION] g_modeTransitionMutex acquired");
 
     // Handle Cut/Cut/Cut transition - needs first-frame protection to prevent black flash
     // EXCEPTION: When transitioning TO Fullscreen, we ALWAYS need to animate to keep the from-mode's
@@ -3584,7 +3543,7 @@ void StartModeTransition(const std::string& fromModeId, const std::string& toMod
                               toMode.backgroundTransition == BackgroundTransitionType::Cut;
 
     if (isAllCutTransition && !transitioningToFullscreen) {
-        LogCategory("animation", "[ANIMATION] Cut/Cut/Cut transition - using 1-frame protection to prevent black flash");
+        LogCategory(LogCategoryId::Animation, "[ANIMATION] Cut/Cut/Cut transition - using 1-frame protection to prevent black flash");
     }
 
     g_modeTransition.active = true;
@@ -3684,7 +3643,7 @@ void StartModeTransition(const std::string& fromModeId, const std::string& toMod
     // This freezes the EyeZoom snapshot immediately so it's captured before the game texture resizes
     if (transitioningFromEyeZoom && !transitioningToEyeZoom) {
         g_isTransitioningFromEyeZoom.store(true, std::memory_order_release);
-        LogCategory("animation", "[ANIMATION] Set g_isTransitioningFromEyeZoom=true BEFORE WM_SIZE to freeze snapshot");
+        LogCategory(LogCategoryId::Animation, "[ANIMATION] Set g_isTransitioningFromEyeZoom=true BEFORE WM_SIZE to freeze snapshot");
     } else {
         g_isTransitioningFromEyeZoom.store(false, std::memory_order_release);
     }
@@ -3700,16 +3659,18 @@ void StartModeTransition(const std::string& fromModeId, const std::string& toMod
         g_modeTransition.wmSizeSent = true;
         g_modeTransition.lastSentWidth = wmWidth;
         g_modeTransition.lastSentHeight = wmHeight;
-        LogCategory("animation", "[ANIMATION] WM_SIZE sent immediately: " + std::to_string(wmWidth) + "x" + std::to_string(wmHeight));
+        LogCategory(LogCategoryId::Animation,
+                    "[ANIMATION] WM_SIZE sent immediately: " + std::to_string(wmWidth) + "x" + std::to_string(wmHeight));
     }
 
-    LogCategory("animation", "[ANIMATION] Starting mode transition (Game:" + GameTransitionTypeToString(toMode.gameTransition) +
-                                 ", Overlay:" + OverlayTransitionTypeToString(toMode.overlayTransition) +
-                                 ", Bg:" + BackgroundTransitionTypeToString(toMode.backgroundTransition) + ", " +
-                                 std::to_string(toMode.transitionDurationMs) + "ms): " + fromModeId + " (" + std::to_string(fromWidth) +
-                                 "x" + std::to_string(fromHeight) + " at " + std::to_string(fromX) + "," + std::to_string(fromY) + ")" +
-                                 " -> " + toModeId + " (" + std::to_string(toWidth) + "x" + std::to_string(toHeight) + " at " +
-                                 std::to_string(toX) + "," + std::to_string(toY) + ")");
+    LogCategory(LogCategoryId::Animation,
+                "[ANIMATION] Starting mode transition (Game:" + GameTransitionTypeToString(toMode.gameTransition) +
+                    ", Overlay:" + OverlayTransitionTypeToString(toMode.overlayTransition) +
+                    ", Bg:" + BackgroundTransitionTypeToString(toMode.backgroundTransition) + ", " +
+                    std::to_string(toMode.transitionDurationMs) + "ms): " + fromModeId + " (" + std::to_string(fromWidth) +
+                    "x" + std::to_string(fromHeight) + " at " + std::to_string(fromX) + "," + std::to_string(fromY) + ")" +
+                    " -> " + toModeId + " (" + std::to_string(toWidth) + "x" + std::to_string(toHeight) + " at " +
+                    std::to_string(toX) + "," + std::to_string(toY) + ")");
 
     // Update lock-free snapshot for viewport hook and GetModeTransitionState (done inside the lock)
     int nextSnapshotIndex = 1 - g_viewportTransitionSnapshotIndex.load(std::memory_order_relaxed);
@@ -3745,7 +3706,7 @@ void StartModeTransition(const std::string& fromModeId, const std::string& toMod
     snapshot.startTime = g_modeTransition.startTime;
     g_viewportTransitionSnapshotIndex.store(nextSnapshotIndex, std::memory_order_release);
 
-    LogCategory("animation", "[ANIMATION] StartModeTransition complete - releasing g_modeTransitionMutex");
+    LogCategory(LogCategoryId::Animation, "[ANIMATION] StartModeTransition complete - releasing g_modeTransitionMutex");
 }
 
 void UpdateModeTransition() {
@@ -3894,9 +3855,10 @@ void UpdateModeTransition() {
     bool allComplete = (elapsed >= totalDuration);
 
     if (allComplete) {
-        LogCategory("animation", "[ANIMATION] Mode transition complete: " + g_modeTransition.toModeId + " (final stretch: " +
-                                     std::to_string(g_modeTransition.toWidth) + "x" + std::to_string(g_modeTransition.toHeight) + " at " +
-                                     std::to_string(g_modeTransition.toX) + "," + std::to_string(g_modeTransition.toY) + ")");
+        LogCategory(LogCategoryId::Animation,
+                    "[ANIMATION] Mode transition complete: " + g_modeTransition.toModeId + " (final stretch: " +
+                        std::to_string(g_modeTransition.toWidth) + "x" + std::to_string(g_modeTransition.toHeight) + " at " +
+                        std::to_string(g_modeTransition.toX) + "," + std::to_string(g_modeTransition.toY) + ")");
 
         // Ensure current values are exactly at target before deactivating to prevent
         // any stale bounce values from being read in the brief window before deactivation
@@ -231,8 +231,8 @@ void RenderGameBorder(int x, int y, int w, int h, int borderWidth, int radius, c
 // GPU Resource Management
 void DiscardAllGPUImages();
 void CleanupGPUResources();
-void UploadDecodedImageToGPU(const DecodedImageData& imgData);
-void UploadDecodedImageToGPU_Internal(const DecodedImageData& imgData);
+// Uploads queued decoded images, spending about `budget` per call; a large animation is spread over several calls
+void UploadDecodedImagesToGPU(std::chrono::microseconds budget);
 void InitializeGPUResources();
 void CreateMirrorGPUResources(const MirrorConfig& conf);
 
@@ -0,0 +1,137 @@
+#include "render_list.h"
+
+#include <algorithm>
+#include <cctype>
+#include <unordered_map>
+
+namespace {
+
+// First definition wins, matching the linear searches this replaces
+template <typename T> std::unordered_map<std::string, const T*> IndexByName(const std::vector<T>& items) {
+    std::unordered_map<std::string, const T*> index;
+    index.reserve(items.size());
+    for (const T& item : items) { index.try_emplace(item.name, &item); }
+    return index;
+}
+
+template <typename T> const T* Lookup(const std::unordered_map<std::string, const T*>& index, const std::string& name) {
+    auto it = index.find(name);
+    return it != index.end() ? it->second : nullptr;
+}
+
+// Same rule as EqualsIgnoreCase (utils.h), kept here so the render lists build without Win32
+bool ModeIdEquals(const std::string& a, const std::string& b) {
+    return a.size() == b.size() && std::equal(a.begin(), a.end(), b.begin(), [](char x, char y) { return std::tolower(x) == std::tolower(y); });
+}
+
+} // namespace
+
+void CompileModeRenderList(const Config& config, const ModeConfig& mode, int screenW, int screenH, ModeRenderList& out) {
+    out.modeId = mode.id;
+    out.mirrors.clear();
+    out.images.clear();
+    out.windowOverlays.clear();
+    out.referencedMirrorNames.clear();
+
+    const auto mirrorsByName = IndexByName(config.mirrors);
+    const auto groupsByName = IndexByName(config.mirrorGroups);
+
+    out.mirrors.reserve(mode.mirrorIds.size() + mode.mirrorGroupIds.size());
+    for (const auto& mirrorName : mode.mirrorIds) {
+        out.referencedMirrorNames.push_back(mirrorName);
+        if (const MirrorConfig* mirror = Lookup(mirrorsByName, mirrorName)) { out.mirrors.push_back(*mirror); }
+    }
+
+    // Mirror groups: each enabled item is the mirror positioned at the group's output plus the item offset, with the
+    // item's widthPercent/heightPercent applied on top of the mirror's own scale
+    for (const auto& groupName : mode.mirrorGroupIds) {
+        const MirrorGroupConfig* group = Lookup(groupsByName, groupName);
+        if (!group) continue;
+
+        int groupX = group->output.x;
+        int groupY = group->output.y;
+        if (group->output.useRelativePosition) {
+            groupX = static_cast<int>(group->output.relativeX * screenW);
+            groupY = static_cast<int>(group->output.relativeY * screenH);
+        }
+
+        for (const auto& item : group->mirrors) {
+            out.referencedMirrorNames.push_back(item.mirrorId);
+            if (!item.enabled) continue;
+            const MirrorConfig* mirror = Lookup(mirrorsByName, item.mirrorId);
+            if (!mirror) continue;
+
+            MirrorConfig& grouped = out.mirrors.emplace_back(*mirror);
+            grouped.output.x = groupX + item.offsetX;
+            grouped.output.y = groupY + item.offsetY;
+            grouped.output.relativeTo = group->output.relativeTo;
+            grouped.output.useRelativePosition = group->output.useRelativePosition;
+            grouped.output.relativeX = group->output.relativeX;
+            grouped.output.relativeY = group->output.relativeY;
+            if (item.widthPercent != 1.0f || item.heightPercent != 1.0f) {
+                grouped.output.separateScale = true;
+                float baseScaleX = mirror->output.separateScale ? mirror->output.scaleX : mirror->output.scale;
+                float baseScaleY = mirror->output.separateScale ? mirror->output.scaleY : mirror->output.scale;
+                grouped.output.scaleX = baseScaleX * item.widthPercent;
+                grouped.output.scaleY = baseScaleY * item.heightPercent;
+            }
+        }
+    }
+
+    std::sort(out.referencedMirrorNames.begin(), out.referencedMirrorNames.end());
+    out.referencedMirrorNames.erase(std::unique(out.referencedMirrorNames.begin(), out.referencedMirrorNames.end()),
+                                    out.referencedMirrorNames.end());
+
+    const auto imagesByName = IndexByName(config.images);
+    out.images.reserve(mode.imageIds.size());
+    for (const auto& imageName : mode.imageIds) {
+        if (const ImageConfig* image = Lookup(imagesByName, imageName)) { out.images.push_back(image); }
+    }
+
+    const auto overlaysByName = IndexByName(config.windowOverlays);
+    out.windowOverlays.reserve(mode.windowOverlayIds.size());
+    for (const auto& overlayId : mode.windowOverlayIds) {
+        if (const WindowOverlayConfig* overlay = Lookup(overlaysByName, overlayId)) { out.windowOverlays.push_back(overlay); }
+    }
+}
+
+void RenderListCache::Rebuild(const std::shared_ptr<const Config>& snapshot, int screenW, int screenH) {
+    m_snapshot = snapshot;
+    m_screenW = screenW;
+    m_screenH = screenH;
+    m_slideOutFrom = nullptr;
+    m_slideOutTo = nullptr;
+
+    m_lists.resize(snapshot->modes.size());
+    for (size_t i = 0; i < snapshot->modes.size(); ++i) { CompileModeRenderList(*snapshot, snapshot->modes[i], screenW, screenH, m_lists[i]); }
+}
+
+const ModeRenderList& RenderListCache::Get(const std::shared_ptr<const Config>& snapshot, const std::string& modeId, int screenW,
+                                           int screenH) {
+    if (!snapshot) return m_empty;
+    if (snapshot != m_snapshot || screenW != m_screenW || screenH != m_screenH) { Rebuild(snapshot, screenW, screenH); }
+
+    for (const ModeRenderList& list : m_lists) {
+        if (ModeIdEquals(list.modeId, modeId)) { return list; }
+    }
+    return m_empty;
+}
+
+const std::vector<MirrorConfig>& RenderListCache::MirrorsOnlyIn(const ModeRenderList& from, const ModeRenderList& to) {
+    if (&from == m_slideOutFrom && &to == m_slideOutTo) { return m_slideOutMirrors; }
+
+    m_slideOutFrom = &from;
+    m_slideOutTo = &to;
+    m_slideOutMirrors.clear();
+    for (const MirrorConfig& fromMirror : from.mirrors) {
+        bool existsInTarget = false;
+        for (const MirrorConfig& toMirror : to.mirrors) {
+            if (toMirror.name == fromMirror.name) {
+                existsInTarget = true;
+                break;
+            }
+        }
+        if (!existsInTarget) { m_slideOutMirrors.push_back(fromMirror); }
+    }
+    return m_slideOutMirrors;
+}
@@ -0,0 +1,46 @@
+#pragma once
+
+#include "config_types.h"
+
+#include <memory>
+#include <string>
+#include <vector>
+
+// A mode's overlays, resolved once per config snapshot for the render thread.
+// Images and window overlays point into the snapshot the list was compiled from; the cache keeps it alive.
+struct ModeRenderList {
+    std::string modeId;
+    std::vector<MirrorConfig> mirrors; // Mode mirrors, then enabled group items with the group's position and sizing applied
+    std::vector<const ImageConfig*> images;
+    std::vector<const WindowOverlayConfig*> windowOverlays;
+    std::vector<std::string> referencedMirrorNames; // Sorted; every mirror the mode names, directly or through a group
+};
+
+// Compiled render lists for every mode of one config snapshot. Render thread only.
+// Rebuilt when the snapshot or the screen size changes (relative group positions resolve against the screen), so a
+// steady-state frame is a lookup with no allocation and no copying.
+class RenderListCache {
+  public:
+    // List for modeId (case-insensitive); unknown modes get an empty list.
+    // Stays valid until a Get() with a different snapshot or screen size.
+    const ModeRenderList& Get(const std::shared_ptr<const Config>& snapshot, const std::string& modeId, int screenW, int screenH);
+
+    // Mirrors of `from` that `to` does not show (slide-out pass). Memoized on the pair.
+    const std::vector<MirrorConfig>& MirrorsOnlyIn(const ModeRenderList& from, const ModeRenderList& to);
+
+  private:
+    void Rebuild(const std::shared_ptr<const Config>& snapshot, int screenW, int screenH);
+
+    std::shared_ptr<const Config> m_snapshot;
+    int m_screenW = 0;
+    int m_screenH = 0;
+    std::vector<ModeRenderList> m_lists;
+    ModeRenderList m_empty;
+
+    const ModeRenderList* m_slideOutFrom = nullptr;
+    const ModeRenderList* m_slideOutTo = nullptr;
+    std::vector<MirrorConfig> m_slideOutMirrors;
+};
+
+// Compiles one mode's list (exposed for the cache and for checking the compiled output)
+void CompileModeRenderList(const Config& config, const ModeConfig& mode, int screenW, int screenH, ModeRenderList& out);
@@ -3,11 +3,16 @@
 #include "gui.h"
 #include "mirror_thread.h"
 #include "notes_overlay.h"
+#include "nv12_convert.h"
 #include "obs_thread.h"
 #include "profiler.h"
 #include "render.h"
+#include "relative_anchor.h"
+#include "render_list.h"
+#include "profiler_histogram.h"
 #include "shared_contexts.h"
 #include "stb_image.h"
+#include "triple_buffer_mailbox.h"
 #include "utils.h"
 #include "virtual_camera.h"
 #include "window_overlay.h"
@@ -18,9 +23,9 @@
 #include <filesystem>
 #include <fstream>
 #include <iomanip>
-#include <set>
 #include <sstream>
 #include <thread>
+#include <unordered_map>
 
 // ImGui includes for render thread
 #include "imgui_impl_opengl3.h"
@@ -85,6 +90,7 @@ static GLuint g_virtualCamPBO = 0;
 static int g_virtualCamPBOWidth = 0;
 static int g_virtualCamPBOHeight = 0;
 static bool g_virtualCamPBOPending = false; // True if async read is in flight
+static GLsync g_virtualCamPBOFence = nullptr; // GPU fence after the RGBA readback into g_virtualCamPBO
 static GLuint g_virtualCamCopyFBO = 0;      // FBO for reading from OBS texture
 
 // Virtual Camera GPU compute shader path (double-buffered image textures + PBO readback)
@@ -106,6 +112,8 @@ static int g_vcOutWidth = 0;                 // Current output dimensions
 static int g_vcOutHeight = 0;
 static bool g_vcComputePending = false;  // True if compute dispatch is in flight
 static bool g_vcReadbackPending = false; // True if PBO readback is in flight
+static GLsync g_vcReadbackFence = nullptr; // GPU fence after the NV12 readback into g_vcReadbackPBO[g_vcReadbackIdx]
+static int g_vcReadbackIdx = 0;           // PBO index the in-flight readback targets
 
 // Virtual Camera cursor staging: separate FBO/texture so cursor only appears on virtual camera, not game capture
 static GLuint g_vcCursorFBO = 0;
@@ -118,26 +126,15 @@ static GLint g_vcLocRgbaTexture = -1;
 static GLint g_vcLocWidth = -1;
 static GLint g_vcLocHeight = -1;
 
-// Double-buffered request queue: main thread writes to one slot, render thread reads from other
-// This allows lock-free submission - main thread never blocks waiting for render thread
-static FrameRenderRequest g_requestSlots[2];
-static std::atomic<int> g_requestWriteSlot{ 0 };    // Slot main thread writes to next
-static std::atomic<bool> g_requestPending{ false }; // True when a request is ready to be consumed
-static std::mutex g_requestSignalMutex;             // Only for CV signaling, not data protection
-static std::condition_variable g_requestCV;
+// Triple-buffered request mailboxes: the submitting thread never blocks and never writes a slot the render thread
+// is reading. A request published before the previous one was taken replaces it (counted as dropped).
+static TripleBufferMailbox<FrameRenderRequest> g_requestMailbox;
+static TripleBufferMailbox<ObsFrameSubmission> g_obsMailbox;
+static WaitableSequence g_requestSignal; // Bumped by both submit paths and by StopRenderThread
 
-// Double-buffered OBS submission (same pattern)
-static ObsFrameSubmission g_obsSubmissionSlots[2];
-static std::atomic<int> g_obsWriteSlot{ 0 };
-static std::atomic<bool> g_obsSubmissionPending{ false };
-
-static std::mutex g_completionMutex;
-static std::condition_variable g_completionCV;
-static std::atomic<bool> g_frameComplete{ false };
-
-static std::mutex g_obsCompletionMutex;
-static std::condition_variable g_obsCompletionCV;
-static std::atomic<bool> g_obsFrameComplete{ false };
+// Completion of main (non-OBS) requests, for WaitForRenderComplete
+static WaitableSequence g_renderCompleteSignal;
+static std::atomic<uint64_t> g_completedRequestSequence{ 0 };
 
 // Captured when stable in EyeZoom mode, used during transition-out animation
 static GLuint rt_eyeZoomSnapshotTexture = 0;
@@ -151,6 +148,38 @@ static std::atomic<uint64_t> g_framesDropped{ 0 };
 static std::atomic<double> g_avgRenderTimeMs{ 0.0 };
 static std::atomic<double> g_lastRenderTimeMs{ 0.0 };
 
+// Submit -> texture-ready latency of main requests, published to the profiler once per second (render thread only)
+static LatencyHistogram g_requestLatency;
+static std::chrono::steady_clock::time_point g_requestStatsWindowStart;
+static uint64_t g_requestStatsDroppedAtWindowStart = 0;
+
+static int64_t RT_NowNs() {
+    return std::chrono::duration_cast<std::chrono::nanoseconds>(std::chrono::steady_clock::now().time_since_epoch()).count();
+}
+
+// A main request's texture is ready: wake WaitForRenderComplete and record its latency. Once per second, push the
+// latency percentiles and the drop rate to the profiler overlay.
+static void RT_SignalRequestComplete(uint64_t sequence, int64_t publishedNs) {
+    g_completedRequestSequence.store(sequence, std::memory_order_release);
+    g_renderCompleteSignal.Notify();
+
+    g_requestLatency.Record(RT_NowNs() - publishedNs);
+
+    const auto now = std::chrono::steady_clock::now();
+    if (now - g_requestStatsWindowStart < std::chrono::seconds(1)) return;
+
+    const uint64_t dropped = g_framesDropped.load(std::memory_order_relaxed);
+    const double windowSeconds = std::chrono::duration<double>(now - g_requestStatsWindowStart).count();
+    Profiler& profiler = Profiler::GetInstance();
+    profiler.SetCounter("Render Latency p50 (ms)", static_cast<double>(g_requestLatency.ValueAtQuantileNs(0.50)) / 1.0e6);
+    profiler.SetCounter("Render Latency p99 (ms)", static_cast<double>(g_requestLatency.ValueAtQuantileNs(0.99)) / 1.0e6);
+    profiler.SetCounter("Render Requests Dropped/s", static_cast<double>(dropped - g_requestStatsDroppedAtWindowStart) / windowSeconds);
+
+    g_requestLatency.Clear();
+    g_requestStatsWindowStart = now;
+    g_requestStatsDroppedAtWindowStart = dropped;
+}
+
 extern std::atomic<HWND> g_minecraftHwnd;
 extern std::atomic<bool> g_hwndChanged;
 
@@ -286,7 +315,7 @@ static bool RT_TryInitializeImGui(HWND hwnd, const Config& cfg) {
     InitializeOverlayTextFont(cfg.fontPath, 16.0f, scaleFactor);
 
     g_renderThreadImGuiInitialized = true;
-    LogCategory("init", "Render Thread: ImGui initialized successfully");
+    LogCategory(LogCategoryId::Init, "Render Thread: ImGui initialized successfully");
     return true;
 }
 
@@ -2907,7 +2936,7 @@ static GLuint RT_CreateComputeProgram(const char* src) {
 }
 
 static bool RT_InitializeShaders() {
-    LogCategory("init", "RenderThread: Initializing shaders...");
+    LogCategory(LogCategoryId::Init, "RenderThread: Initializing shaders...");
 
     // NOTE: Border rendering shaders have been removed - all border rendering is done by mirror_thread
     // Render thread only needs: background (for mirror blitting), solid color (for game borders), image render, static border, and gradient
@@ -2931,7 +2960,7 @@ static bool RT_InitializeShaders() {
             g_vcLocRgbaTexture = glGetUniformLocation(g_vcComputeProgram, "u_rgbaTexture");
             g_vcLocWidth = glGetUniformLocation(g_vcComputeProgram, "u_width");
             g_vcLocHeight = glGetUniformLocation(g_vcComputeProgram, "u_height");
-            LogCategory("init", "RenderThread: NV12 compute shader compiled successfully (Rec. 709, image2D path)");
+            LogCategory(LogCategoryId::Init, "RenderThread: NV12 compute shader compiled successfully (Rec. 709, image2D path)");
         } else {
             Log("RenderThread: NV12 compute shader failed, falling back to CPU conversion");
             g_vcUseCompute = false;
@@ -2981,7 +3010,7 @@ static bool RT_InitializeShaders() {
 
     glUseProgram(0);
 
-    LogCategory("init", "RenderThread: Shaders initialized successfully");
+    LogCategory(LogCategoryId::Init, "RenderThread: Shaders initialized successfully");
     return true;
 }
 
@@ -3301,8 +3330,8 @@ static void InitRenderFBOs(int width, int height) {
 
             fbo.width = width;
             fbo.height = height;
-            LogCategory("init", "RenderThread: Initialized FBO " + std::to_string(i) + " at " + std::to_string(width) + "x" +
-                                    std::to_string(height));
+            LogCategory(LogCategoryId::Init, "RenderThread: Initialized FBO " + std::to_string(i) + " at " + std::to_string(width) + "x" +
+                                                 std::to_string(height));
         }
 
         glBindFramebuffer(GL_FRAMEBUFFER, 0);
@@ -3342,8 +3371,9 @@ static void InitRenderFBOs(int width, int height) {
 
             fbo.width = width;
             fbo.height = height;
-            LogCategory("init", "RenderThread: Initialized OBS FBO " + std::to_string(i) + " at " + std::to_string(width) + "x" +
-                                    std::to_string(height));
+            LogCategory(LogCategoryId::Init,
+                        "RenderThread: Initialized OBS FBO " + std::to_string(i) + " at " + std::to_string(width) + "x" +
+                            std::to_string(height));
         }
 
         glBindFramebuffer(GL_FRAMEBUFFER, 0);
@@ -3411,6 +3441,10 @@ static void CleanupRenderFBOs() {
     g_virtualCamPBOWidth = 0;
     g_virtualCamPBOHeight = 0;
     g_virtualCamPBOPending = false;
+    if (g_virtualCamPBOFence) {
+        glDeleteSync(g_virtualCamPBOFence);
+        g_virtualCamPBOFence = nullptr;
+    }
 
     // Cleanup GPU compute path resources
     for (int i = 0; i < 2; i++) {
@@ -3435,6 +3469,10 @@ static void CleanupRenderFBOs() {
         glDeleteSync(g_vcFence);
         g_vcFence = nullptr;
     }
+    if (g_vcReadbackFence) {
+        glDeleteSync(g_vcReadbackFence);
+        g_vcReadbackFence = nullptr;
+    }
     if (g_vcScaleFBO != 0) {
         glDeleteFramebuffers(1, &g_vcScaleFBO);
         g_vcScaleFBO = 0;
@@ -3561,6 +3599,9 @@ static void EnsureVCImageResources(int w, int h) {
 
     if (g_vcReadbackFBO == 0) glGenFramebuffers(1, &g_vcReadbackFBO);
 
+    // Frames still in the old buffers are lost with them
+    DropVirtualCameraFrames((g_vcComputePending ? 1 : 0) + (g_vcReadbackPending ? 1 : 0));
+
     g_vcOutWidth = w;
     g_vcOutHeight = h;
     g_vcWriteIdx = 0;
@@ -3570,74 +3611,97 @@ static void EnsureVCImageResources(int w, int h) {
         glDeleteSync(g_vcFence);
         g_vcFence = nullptr;
     }
+    if (g_vcReadbackFence) {
+        glDeleteSync(g_vcReadbackFence);
+        g_vcReadbackFence = nullptr;
+    }
 }
 
-// Complete previous frame's readback: map PBO and write NV12 to virtual camera
+// Non-blocking fence poll; deletes and clears the fence once the GPU has passed it
+static bool RT_PollFence(GLsync& fence) {
+    if (!fence) return true;
+    GLenum result = glClientWaitSync(fence, 0, 0);
+    if (result != GL_ALREADY_SIGNALED && result != GL_CONDITION_SATISFIED) return false;
+    glDeleteSync(fence);
+    fence = nullptr;
+    return true;
+}
+
+// Virtual camera timestamps are QPC converted to 100-nanosecond units
+static uint64_t GetVirtualCameraTimestamp() {
+    LARGE_INTEGER counter, freq;
+    QueryPerformanceCounter(&counter);
+    QueryPerformanceFrequency(&freq);
+    return (counter.QuadPart * 10000000ULL) / freq.QuadPart;
+}
+
+// Complete a finished NV12 readback: copy the PBO straight into the next shared-memory frame slot.
+// Never stalls — if the readback fence hasn't signaled yet, this is a no-op and we try again next frame.
 static void FlushVirtualCameraReadback() {
     if (!g_vcReadbackPending) return;
+    if (!RT_PollFence(g_vcReadbackFence)) return;
+    g_vcReadbackPending = false;
 
-    int readIdx = 1 - g_vcWriteIdx; // Read from the buffer we wrote to last frame
-    glBindBuffer(GL_PIXEL_PACK_BUFFER, g_vcReadbackPBO[readIdx]);
-    void* data = glMapBuffer(GL_PIXEL_PACK_BUFFER, GL_READ_ONLY);
-    if (data) {
-        LARGE_INTEGER counter, freq;
-        QueryPerformanceCounter(&counter);
-        QueryPerformanceFrequency(&freq);
-        uint64_t timestamp = (counter.QuadPart * 10000000ULL) / freq.QuadPart;
-        WriteVirtualCameraFrameNV12(static_cast<const uint8_t*>(data), g_vcOutWidth, g_vcOutHeight, timestamp);
-        glUnmapBuffer(GL_PIXEL_PACK_BUFFER);
-    }
+    // Dropped if rate-limited or the camera size changed; the next compute result is already on its way
+    VirtualCameraFrameSlot slot;
+    if (!BeginVirtualCameraFrame(g_vcOutWidth, g_vcOutHeight, slot)) return;
+
+    glBindBuffer(GL_PIXEL_PACK_BUFFER, g_vcReadbackPBO[g_vcReadbackIdx]);
+    glGetBufferSubData(GL_PIXEL_PACK_BUFFER, 0, slot.size, slot.data);
     glBindBuffer(GL_PIXEL_PACK_BUFFER, 0);
-    g_vcReadbackPending = false;
+
+    CommitVirtualCameraFrame(slot, GetVirtualCameraTimestamp());
 }
 
-// GPU path: dispatch compute shader to convert RGBA texture -> NV12 image textures,
-// then start async PBO readback. Uses double-buffering so dispatch and readback overlap.
-static void StartVirtualCameraComputeReadback(GLuint srcTexture, int texW, int texH, int outW, int outH) {
-    // Step 1: If previous compute finished, start PBO readback of the result
-    if (g_vcComputePending && g_vcFence) {
-        // Non-blocking check: if GPU isn't done yet, skip this frame's virtual camera update
-        GLenum result = glClientWaitSync(g_vcFence, 0, 0);
-        if (result == GL_ALREADY_SIGNALED || result == GL_CONDITION_SATISFIED) {
-            glDeleteSync(g_vcFence);
-            g_vcFence = nullptr;
-            g_vcComputePending = false;
-
-            // Readback Y plane then UV plane into the PBO (contiguous NV12 layout)
-            int readIdx = g_vcWriteIdx; // We just finished writing to this buffer
-            uint32_t ySize = outW * outH;
-
-            glBindBuffer(GL_PIXEL_PACK_BUFFER, g_vcReadbackPBO[readIdx]);
-            glBindFramebuffer(GL_READ_FRAMEBUFFER, g_vcReadbackFBO);
-
-            // Read Y plane
-            glFramebufferTexture2D(GL_READ_FRAMEBUFFER, GL_COLOR_ATTACHMENT0, GL_TEXTURE_2D, g_vcYImage[readIdx], 0);
-            glReadPixels(0, 0, outW, outH, GL_RED_INTEGER, GL_UNSIGNED_BYTE, (void*)0);
-
-            // Read UV plane (appended after Y)
-            glFramebufferTexture2D(GL_READ_FRAMEBUFFER, GL_COLOR_ATTACHMENT0, GL_TEXTURE_2D, g_vcUVImage[readIdx], 0);
-            glReadPixels(0, 0, outW, outH / 2, GL_RED_INTEGER, GL_UNSIGNED_BYTE, (void*)(uintptr_t)ySize);
-
-            glBindFramebuffer(GL_READ_FRAMEBUFFER, 0);
-            glBindBuffer(GL_PIXEL_PACK_BUFFER, 0);
+// If the last compute finished and the readback PBOs are free, start reading its result back
+static void StartVirtualCameraNV12Readback() {
+    if (g_vcComputePending && !g_vcReadbackPending && RT_PollFence(g_vcFence)) {
+        g_vcComputePending = false;
 
-            // Mark readback pending — will be mapped + written to virtual camera next call
-            g_vcReadbackPending = true;
-        }
-        // If not signaled yet, we just skip — no stall
-    }
+        // Readback Y plane then UV plane into the PBO (contiguous NV12 layout)
+        int readIdx = g_vcWriteIdx; // We just finished writing to this buffer
+        uint32_t ySize = g_vcOutWidth * g_vcOutHeight;
+
+        glBindBuffer(GL_PIXEL_PACK_BUFFER, g_vcReadbackPBO[readIdx]);
+        glBindFramebuffer(GL_READ_FRAMEBUFFER, g_vcReadbackFBO);
+
+        // Read Y plane
+        glFramebufferTexture2D(GL_READ_FRAMEBUFFER, GL_COLOR_ATTACHMENT0, GL_TEXTURE_2D, g_vcYImage[readIdx], 0);
+        glReadPixels(0, 0, g_vcOutWidth, g_vcOutHeight, GL_RED_INTEGER, GL_UNSIGNED_BYTE, (void*)0);
 
-    // Step 2: Flush any pending PBO readback from the previous cycle
-    FlushVirtualCameraReadback();
+        // Read UV plane (appended after Y)
+        glFramebufferTexture2D(GL_READ_FRAMEBUFFER, GL_COLOR_ATTACHMENT0, GL_TEXTURE_2D, g_vcUVImage[readIdx], 0);
+        glReadPixels(0, 0, g_vcOutWidth, g_vcOutHeight / 2, GL_RED_INTEGER, GL_UNSIGNED_BYTE, (void*)(uintptr_t)ySize);
+
+        glBindFramebuffer(GL_READ_FRAMEBUFFER, 0);
+        glBindBuffer(GL_PIXEL_PACK_BUFFER, 0);
+
+        // Fence the transfer so the flush never maps a buffer the GPU is still writing
+        g_vcReadbackFence = glFenceSync(GL_SYNC_GPU_COMMANDS_COMPLETE, 0);
+        g_vcReadbackIdx = readIdx;
+        g_vcReadbackPending = true;
+    }
+}
 
-    // Step 3: Ensure image resources exist at the right size
+// GPU path: dispatch compute shader to convert RGBA texture -> NV12 image textures.
+// Readback of the result is started by PumpVirtualCameraPipeline() once the dispatch fence signals;
+// double-buffered images let the next dispatch overlap the previous readback.
+static void StartVirtualCameraComputeReadback(GLuint srcTexture, int texW, int texH, int outW, int outH) {
+    // Step 1: Ensure image resources exist at the right size (resets in-flight work on resize)
     EnsureVCImageResources(outW, outH);
 
-    // Step 4: Swap write buffer index for this frame's dispatch
+    // Step 2: Only one compute in flight at a time — otherwise its fence would be overwritten and leaked.
+    // The pacer doesn't hand out captures while busy, so this is only a safety net.
+    if (g_vcComputePending) {
+        DropVirtualCameraFrames(1);
+        return;
+    }
+
+    // Step 3: Swap write buffer index for this frame's dispatch
     g_vcWriteIdx = 1 - g_vcWriteIdx;
     int writeIdx = g_vcWriteIdx;
 
-    // Step 5: Determine source texture (downscale if needed)
+    // Step 4: Determine source texture (downscale if needed)
     GLuint sampleTexture = srcTexture;
     if (outW != texW || outH != texH) {
         EnsureVCScaleResources(outW, outH);
@@ -3651,7 +3715,7 @@ static void StartVirtualCameraComputeReadback(GLuint srcTexture, int texW, int t
         sampleTexture = g_vcScaleTexture;
     }
 
-    // Step 6: Dispatch compute shader with image2D bindings (no atomics, no SSBO clear)
+    // Step 5: Dispatch compute shader with image2D bindings (no atomics, no SSBO clear)
     glUseProgram(g_vcComputeProgram);
 
     glActiveTexture(GL_TEXTURE0);
@@ -3668,6 +3732,9 @@ static void StartVirtualCameraComputeReadback(GLuint srcTexture, int texW, int t
     GLuint groupsY = (outH + 15) / 16;
     glDispatchCompute(groupsX, groupsY, 1);
 
+    // Image writes must be visible to the glReadPixels that reads them back
+    glMemoryBarrier(GL_TEXTURE_UPDATE_BARRIER_BIT | GL_FRAMEBUFFER_BARRIER_BIT);
+
     // Fence after dispatch — we'll check it next frame (non-blocking)
     g_vcFence = glFenceSync(GL_SYNC_GPU_COMMANDS_COMPLETE, 0);
     glFlush(); // Ensure commands are submitted
@@ -3678,23 +3745,34 @@ static void StartVirtualCameraComputeReadback(GLuint srcTexture, int texW, int t
     g_vcComputePending = true;
 }
 
-// CPU fallback path: PBO readback + CPU NV12 conversion
-static void StartVirtualCameraPBOReadback(GLuint obsTexture, int width, int height) {
-    // If a previous read is still pending, complete it first and write to virtual camera
+// CPU fallback path: once the RGBA readback has landed, convert it straight into the shared-memory frame slot
+static void FlushVirtualCameraPBOReadback() {
     if (g_virtualCamPBOPending && g_virtualCamPBO != 0) {
-        glBindBuffer(GL_PIXEL_PACK_BUFFER, g_virtualCamPBO);
-        void* data = glMapBuffer(GL_PIXEL_PACK_BUFFER, GL_READ_ONLY);
-        if (data) {
-            LARGE_INTEGER counter, freq;
-            QueryPerformanceCounter(&counter);
-            QueryPerformanceFrequency(&freq);
-            uint64_t timestamp = (counter.QuadPart * 10000000ULL) / freq.QuadPart;
-
-            WriteVirtualCameraFrame(static_cast<const uint8_t*>(data), g_virtualCamPBOWidth, g_virtualCamPBOHeight, timestamp);
-            glUnmapBuffer(GL_PIXEL_PACK_BUFFER);
-        }
-        glBindBuffer(GL_PIXEL_PACK_BUFFER, 0);
+        // Still in flight: don't stall on the map
+        if (!RT_PollFence(g_virtualCamPBOFence)) return;
         g_virtualCamPBOPending = false;
+
+        VirtualCameraFrameSlot slot;
+        if (BeginVirtualCameraFrame(g_virtualCamPBOWidth, g_virtualCamPBOHeight, slot)) {
+            glBindBuffer(GL_PIXEL_PACK_BUFFER, g_virtualCamPBO);
+            void* data = glMapBuffer(GL_PIXEL_PACK_BUFFER, GL_READ_ONLY);
+            if (data) {
+                ConvertRGBAtoNV12(static_cast<const uint8_t*>(data), slot.data, g_virtualCamPBOWidth, g_virtualCamPBOHeight);
+                glUnmapBuffer(GL_PIXEL_PACK_BUFFER);
+                CommitVirtualCameraFrame(slot, GetVirtualCameraTimestamp());
+            } else {
+                CancelVirtualCameraFrame(slot);
+            }
+            glBindBuffer(GL_PIXEL_PACK_BUFFER, 0);
+        }
+    }
+}
+
+// CPU fallback path: start an async RGBA readback of the frame into the PBO
+static void StartVirtualCameraPBOReadback(GLuint obsTexture, int width, int height) {
+    if (g_virtualCamPBOPending) {
+        DropVirtualCameraFrames(1);
+        return;
     }
 
     // Resize PBO if needed
@@ -3721,14 +3799,34 @@ static void StartVirtualCameraPBOReadback(GLuint obsTexture, int width, int heig
     glBindBuffer(GL_PIXEL_PACK_BUFFER, 0);
     glBindFramebuffer(GL_READ_FRAMEBUFFER, 0);
 
+    g_virtualCamPBOFence = glFenceSync(GL_SYNC_GPU_COMMANDS_COMPLETE, 0);
     g_virtualCamPBOPending = true;
 }
 
-// Start async readback of OBS texture to Virtual Camera
+// Advance in-flight virtual camera work without capturing: hand finished readbacks to the camera and start
+// reading back a finished compute. Runs every render frame so completions never wait for the next paced capture.
+static void PumpVirtualCameraPipeline() {
+    if (g_vcUseCompute && g_vcComputeProgram != 0) {
+        FlushVirtualCameraReadback();
+        StartVirtualCameraNV12Readback();
+    } else {
+        FlushVirtualCameraPBOReadback();
+    }
+}
+
+// True if a new capture can't be started this frame (it would have to wait behind the in-flight one)
+static bool IsVirtualCameraPipelineBusy() {
+    if (g_vcUseCompute && g_vcComputeProgram != 0) return g_vcComputePending;
+    return g_virtualCamPBOPending;
+}
+
+// Start async readback of OBS texture to Virtual Camera (only for frames the pacer handed out)
 // Routes to GPU compute path or CPU fallback based on hardware support
 static void StartVirtualCameraAsyncReadback(GLuint obsTexture, int width, int height) {
-    if (obsTexture == 0 || width <= 0 || height <= 0) return;
-    if (!IsVirtualCameraActive()) return;
+    if (obsTexture == 0 || width <= 0 || height <= 0 || !IsVirtualCameraActive()) {
+        DropVirtualCameraFrames(1);
+        return;
+    }
 
     int outW, outH;
     GetVirtualCamScaledSize(width, height, 1.0f, outW, outH);
@@ -4040,12 +4138,17 @@ static void RT_RenderEyeZoom(GLuint gameTexture, int requestViewportX, int fullW
     glDisable(GL_BLEND);
 }
 
+// RT_RenderMirrors scratch, render thread only. Reused across frames (and across the slide-out pass, which runs after
+// the main pass has finished with them) so steady-state frames don't allocate.
+static std::vector<MirrorRenderData> rt_mirrorsToRender;
+static std::string rt_mirrorAnchor;
+
 // Render mirrors using render thread's local shader programs
 static void RT_RenderMirrors(const std::vector<MirrorConfig>& activeMirrors, const GameViewportGeometry& geo, int fullW, int fullH,
                              float modeOpacity, bool excludeOnlyOnMyScreen, bool relativeStretching, float transitionProgress,
                              float mirrorSlideProgress, int fromX, int fromY, int fromW, int fromH, int toX, int toY, int toW, int toH,
                              bool isEyeZoomMode, bool isTransitioningFromEyeZoom, int eyeZoomAnimatedViewportX, bool skipAnimation,
-                             const std::string& fromModeId, bool fromSlideMirrorsIn, bool toSlideMirrorsIn, bool isSlideOutPass, GLuint vao,
+                             const ModeRenderList* fromList, bool fromSlideMirrorsIn, bool toSlideMirrorsIn, bool isSlideOutPass, GLuint vao,
                              GLuint vbo) {
     if (activeMirrors.empty()) return;
 
@@ -4054,33 +4157,18 @@ static void RT_RenderMirrors(const std::vector<MirrorConfig>& activeMirrors, con
     if (!slideCfgSnap) return; // Config not yet published
     const Config& slideCfg = *slideCfgSnap;
 
-    // Collect source mode mirror names (for determining which mirrors exist in both modes)
+    // Source mode mirror names (for determining which mirrors exist in both modes), sorted
     // Mirrors that exist in both the source mode and target mode should use normal bounce animation,
     // not the slide animation (which is for mode-specific mirrors only)
-    std::set<std::string> sourceMirrorNames;
-    if (!fromModeId.empty() && (fromSlideMirrorsIn || toSlideMirrorsIn || slideCfg.eyezoom.slideMirrorsIn)) {
-        // Look up the FROM mode to get its mirror list
-        for (const auto& mode : slideCfg.modes) {
-            if (EqualsIgnoreCase(mode.id, fromModeId)) {
-                for (const auto& mirrorName : mode.mirrorIds) { sourceMirrorNames.insert(mirrorName); }
-                // Also include mirrors from mirror groups
-                for (const auto& groupName : mode.mirrorGroupIds) {
-                    for (const auto& group : slideCfg.mirrorGroups) {
-                        if (group.name == groupName) {
-                            for (const auto& item : group.mirrors) { sourceMirrorNames.insert(item.mirrorId); }
-                            break;
-                        }
-                    }
-                }
-                break;
-            }
-        }
+    const std::vector<std::string>* sourceMirrorNames = nullptr;
+    if (fromList && (fromSlideMirrorsIn || toSlideMirrorsIn || slideCfg.eyezoom.slideMirrorsIn)) {
+        sourceMirrorNames = &fromList->referencedMirrorNames;
     }
 
     // Pre-cache mirror render data
     // Use unique_lock because we need to wait on the fence while holding the lock
-    std::vector<MirrorRenderData> mirrorsToRender;
-    mirrorsToRender.reserve(activeMirrors.size());
+    rt_mirrorsToRender.clear();
+    rt_mirrorsToRender.reserve(activeMirrors.size());
 
     {
         std::unique_lock<std::shared_mutex> mirrorLock(g_mirrorInstancesMutex);
@@ -4105,7 +4193,7 @@ static void RT_RenderMirrors(const std::vector<MirrorConfig>& activeMirrors, con
             // NOTE: We calculate outW/outH from FBO base dimensions and config scale, NOT from
             // inst.final_w/h. This allows the same mirror texture to be rendered at different scales:
             // - Mirror's own scale when used directly
-            // - Group's scale when used in a group (conf.output comes from group via RT_CollectActiveElements)
+            // - Group's scale when used in a group (conf.output comes from group via the mode render list)
             if (inst.finalTexture != 0 && inst.final_w > 0 && inst.final_h > 0) {
                 data.texture = inst.finalTexture;
                 data.tex_w = inst.final_w;
@@ -4166,11 +4254,11 @@ static void RT_RenderMirrors(const std::vector<MirrorConfig>& activeMirrors, con
             // Copy content presence flag for static border rendering
             data.hasFrameContent = inst.hasFrameContent;
 
-            mirrorsToRender.push_back(data);
+            rt_mirrorsToRender.push_back(data);
         }
     }
 
-    if (mirrorsToRender.empty()) return;
+    if (rt_mirrorsToRender.empty()) return;
 
     // Memory barrier to ensure all mirror texture writes are visible
     // This is critical for cross-context texture sharing under GPU load
@@ -4188,7 +4276,7 @@ static void RT_RenderMirrors(const std::vector<MirrorConfig>& activeMirrors, con
     // Render thread just blits the pre-rendered finalTexture using passthrough shader
     glUseProgram(rt_backgroundProgram);
 
-    for (auto& renderData : mirrorsToRender) {
+    for (auto& renderData : rt_mirrorsToRender) {
         const MirrorConfig& conf = *renderData.config;
         glUniform1f(rt_backgroundShaderLocs.opacity, modeOpacity * conf.opacity);
 
@@ -4198,16 +4286,9 @@ static void RT_RenderMirrors(const std::vector<MirrorConfig>& activeMirrors, con
             glBufferSubData(GL_ARRAY_BUFFER, 0, sizeof(renderData.vertices), renderData.vertices);
         } else {
             // Calculate vertices on the fly (fallback)
-            std::string anchor = conf.output.relativeTo;
-
-            // Check if this is a Screen anchor (absolute screen positioning)
-            bool isScreenRelative = false;
-            if (anchor.length() > 6 && anchor.substr(anchor.length() - 6) == "Screen") {
-                anchor = anchor.substr(0, anchor.length() - 6);
-                isScreenRelative = true;
-            } else if (anchor.length() > 8 && anchor.substr(anchor.length() - 8) == "Viewport") {
-                anchor = anchor.substr(0, anchor.length() - 8);
-            }
+            // Screen anchors position absolutely on screen; Viewport and bare anchors follow the game viewport
+            const std::string& anchor = rt_mirrorAnchor;
+            const bool isScreenRelative = SplitRelativeAnchor(conf.output.relativeTo, rt_mirrorAnchor);
 
             int finalX_screen, finalY_screen, finalW_screen, finalH_screen;
 
@@ -4287,9 +4368,7 @@ static void RT_RenderMirrors(const std::vector<MirrorConfig>& activeMirrors, con
             float slideProgress = 1.0f; // 1.0 = at final position, 0.0 = off-screen
 
             // --- EyeZoom slide animation (uses viewport X for synchronization) ---
-            auto ezCfgSnap = GetConfigSnapshot();
-            if (!ezCfgSnap) continue; // Config not yet published
-            EyeZoomConfig zoomConfig = ezCfgSnap->eyezoom;
+            const EyeZoomConfig& zoomConfig = slideCfg.eyezoom;
             int modeWidth = zoomConfig.windowWidth;
             int targetViewportX = (fullW - modeWidth) / 2;
 
@@ -4329,7 +4408,10 @@ static void RT_RenderMirrors(const std::vector<MirrorConfig>& activeMirrors, con
             }
 
             // Skip slide for mirrors that exist in both source and target modes (they should bounce normally)
-            if (shouldApplySlide && sourceMirrorNames.count(conf.name) > 0) { shouldApplySlide = false; }
+            if (shouldApplySlide && sourceMirrorNames &&
+                std::binary_search(sourceMirrorNames->begin(), sourceMirrorNames->end(), conf.name)) {
+                shouldApplySlide = false;
+            }
 
             if (shouldApplySlide) {
                 slideProgress = (slideProgress < 0.0f) ? 0.0f : (slideProgress > 1.0f ? 1.0f : slideProgress);
@@ -4377,7 +4459,7 @@ static void RT_RenderMirrors(const std::vector<MirrorConfig>& activeMirrors, con
     // and extend outside mirror bounds
     glUseProgram(rt_staticBorderProgram);
 
-    for (const auto& renderData : mirrorsToRender) {
+    for (const auto& renderData : rt_mirrorsToRender) {
         const MirrorConfig& conf = *renderData.config;
         const MirrorBorderConfig& border = conf.border;
 
@@ -4448,7 +4530,7 @@ static void RT_RenderMirrors(const std::vector<MirrorConfig>& activeMirrors, con
 
 // Render images using render thread's local shader programs
 // gameX/Y/W/H = game viewport position on screen (for viewport-relative positioning)
-static void RT_RenderImages(const std::vector<ImageConfig>& activeImages, int fullW, int fullH, int gameX, int gameY, int gameW, int gameH,
+static void RT_RenderImages(const std::vector<const ImageConfig*>& activeImages, int fullW, int fullH, int gameX, int gameY, int gameW, int gameH,
                             int gameResW, int gameResH, bool relativeStretching, float transitionProgress, int fromX, int fromY, int fromW,
                             int fromH, float modeOpacity, bool excludeOnlyOnMyScreen, GLuint vao, GLuint vbo) {
     if (activeImages.empty()) return;
@@ -4463,7 +4545,8 @@ static void RT_RenderImages(const std::vector<ImageConfig>& activeImages, int fu
     // This ensures the FBO contains properly premultiplied alpha content
     glBlendFuncSeparate(GL_SRC_ALPHA, GL_ONE_MINUS_SRC_ALPHA, GL_ONE, GL_ONE_MINUS_SRC_ALPHA);
 
-    for (const auto& conf : activeImages) {
+    for (const ImageConfig* image : activeImages) {
+        const ImageConfig& conf = *image;
         if (excludeOnlyOnMyScreen && conf.onlyOnMyScreen) continue;
 
         auto it_inst = g_userImages.find(conf.name);
@@ -4493,7 +4576,8 @@ static void RT_RenderImages(const std::vector<ImageConfig>& activeImages, int fu
             CalculateImageDimensions(conf, displayW, displayH);
 
             // Check if viewport-relative (ends with "Viewport")
-            bool isViewportRelative = conf.relativeTo.length() > 8 && conf.relativeTo.substr(conf.relativeTo.length() - 8) == "Viewport";
+            bool isViewportRelative =
+                conf.relativeTo.length() > 8 && conf.relativeTo.compare(conf.relativeTo.length() - 8, 8, "Viewport") == 0;
 
             int finalScreenX_win, finalScreenY_win;
             int finalDisplayW = displayW;
@@ -4610,11 +4694,11 @@ static void RT_RenderImages(const std::vector<ImageConfig>& activeImages, int fu
 
 // Render window overlays using render thread's local shader programs
 // gameX/Y/W/H = game viewport position on screen (for viewport-relative positioning)
-static void RT_RenderWindowOverlays(const std::vector<std::string>& overlayIds, int fullW, int fullH, int gameX, int gameY, int gameW,
-                                    int gameH, int gameResW, int gameResH, bool relativeStretching, float transitionProgress, int fromX,
+static void RT_RenderWindowOverlays(const std::vector<const WindowOverlayConfig*>& overlays, int fullW, int fullH, int gameX, int gameY,
+                                    int gameW, int gameH, int gameResW, int gameResH, bool relativeStretching, float transitionProgress, int fromX,
                                     int fromY, int fromW, int fromH, float modeOpacity, bool excludeOnlyOnMyScreen, GLuint vao,
                                     GLuint vbo) {
-    if (overlayIds.empty()) return;
+    if (overlays.empty()) return;
 
     glBindVertexArray(vao);
     glBindBuffer(GL_ARRAY_BUFFER, vbo);
@@ -4632,11 +4716,12 @@ static void RT_RenderWindowOverlays(const std::vector<std::string>& overlayIds,
         return; // Skip if can't get lock
     }
 
-    for (const auto& overlayId : overlayIds) {
-        // Use snapshot for thread-safe config lookup (render thread reads, GUI thread writes)
-        auto rtOverlaySnap = GetConfigSnapshot();
-        const WindowOverlayConfig* conf = rtOverlaySnap ? FindWindowOverlayConfigIn(overlayId, *rtOverlaySnap) : nullptr;
-        if (!conf) continue;
+    // Once per pass rather than per overlay (it copies the name under a lock)
+    const std::string focusedName = GetFocusedWindowOverlayName();
+
+    for (const WindowOverlayConfig* conf : overlays) {
+        // Configs point into the frame's config snapshot (resolved by the render list)
+        const std::string& overlayId = conf->name;
         if (excludeOnlyOnMyScreen && conf->onlyOnMyScreen) continue;
 
         auto it = g_windowOverlayCache.find(overlayId);
@@ -4698,7 +4783,8 @@ static void RT_RenderWindowOverlays(const std::vector<std::string>& overlayIds,
         int displayH = static_cast<int>(croppedH * conf->scale);
 
         // Check if viewport-relative (ends with "Viewport")
-        bool isViewportRelative = conf->relativeTo.length() > 8 && conf->relativeTo.substr(conf->relativeTo.length() - 8) == "Viewport";
+        bool isViewportRelative =
+            conf->relativeTo.length() > 8 && conf->relativeTo.compare(conf->relativeTo.length() - 8, 8, "Viewport") == 0;
 
         int screenX, screenY;
 
@@ -4796,7 +4882,6 @@ static void RT_RenderWindowOverlays(const std::vector<std::string>& overlayIds,
         }
 
         // Render special focused border if this overlay is currently taking inputs
-        std::string focusedName = GetFocusedWindowOverlayName();
         if (!focusedName.empty() && focusedName == overlayId) {
             // Bright green border to indicate focused state
             Color focusedBorderColor = { 0.0f, 1.0f, 0.0f, 1.0f }; // Bright green
@@ -4815,116 +4900,15 @@ static void RT_RenderWindowOverlays(const std::vector<std::string>& overlayIds,
     glDisable(GL_BLEND);
 }
 
-// Collect active mirrors/images/overlays for a mode from g_config
-// This runs on the render thread, moving the work off the main thread
-// When onlyOnMyScreenPass is true, only items with onlyOnMyScreen=true are collected
-static void RT_CollectActiveElements(const Config& config, const std::string& modeId, bool onlyOnMyScreenPass,
-                                     std::vector<MirrorConfig>& outMirrors, std::vector<ImageConfig>& outImages,
-                                     std::vector<std::string>& outWindowOverlayIds) {
-    outMirrors.clear();
-    outImages.clear();
-    outWindowOverlayIds.clear();
-
-    // Look up mode by ID
-    const ModeConfig* mode = nullptr;
-    for (const auto& m : config.modes) {
-        if (EqualsIgnoreCase(m.id, modeId)) {
-            mode = &m;
-            break;
-        }
-    }
-    if (!mode) return;
-
-    // Reserve space upfront
-    outMirrors.reserve(mode->mirrorIds.size() + mode->mirrorGroupIds.size());
-    outImages.reserve(mode->imageIds.size());
-    outWindowOverlayIds.reserve(mode->windowOverlayIds.size());
-
-    // Collect mirrors - use linear search (render thread has more time budget)
-    for (const auto& mirrorName : mode->mirrorIds) {
-        for (const auto& mirror : config.mirrors) {
-            if (mirror.name == mirrorName) {
-                // Filter by onlyOnMyScreen if this is an OOMS pass
-                if (!onlyOnMyScreenPass || mirror.onlyOnMyScreen) { outMirrors.push_back(mirror); }
-                break;
-            }
-        }
-    }
-
-    // Collect mirror groups (override output position for each mirror in the group)
-    // Per-item sizing: each mirror in the group has its own widthPercent/heightPercent
-    for (const auto& groupName : mode->mirrorGroupIds) {
-        for (const auto& group : config.mirrorGroups) {
-            if (group.name != groupName) continue;
-
-            for (const auto& item : group.mirrors) {
-                if (!item.enabled) continue; // Skip disabled items
-                for (const auto& mirror : config.mirrors) {
-                    if (mirror.name == item.mirrorId) {
-                        if (!onlyOnMyScreenPass || mirror.onlyOnMyScreen) {
-                            MirrorConfig groupedMirror = mirror;
-                            // Calculate group position - use relative percentages if enabled
-                            int groupX = group.output.x;
-                            int groupY = group.output.y;
-                            if (group.output.useRelativePosition) {
-                                int screenW = GetCachedScreenWidth();
-                                int screenH = GetCachedScreenHeight();
-                                groupX = static_cast<int>(group.output.relativeX * screenW);
-                                groupY = static_cast<int>(group.output.relativeY * screenH);
-                            }
-                            // Position comes from group output settings + per-item offset
-                            groupedMirror.output.x = groupX + item.offsetX;
-                            groupedMirror.output.y = groupY + item.offsetY;
-                            groupedMirror.output.relativeTo = group.output.relativeTo;
-                            groupedMirror.output.useRelativePosition = group.output.useRelativePosition;
-                            groupedMirror.output.relativeX = group.output.relativeX;
-                            groupedMirror.output.relativeY = group.output.relativeY;
-                            // Per-item sizing: multiply mirror's own scale by item's widthPercent/heightPercent
-                            // Use separate scale when per-item sizing differs from 100%
-                            if (item.widthPercent != 1.0f || item.heightPercent != 1.0f) {
-                                groupedMirror.output.separateScale = true;
-                                float baseScaleX = mirror.output.separateScale ? mirror.output.scaleX : mirror.output.scale;
-                                float baseScaleY = mirror.output.separateScale ? mirror.output.scaleY : mirror.output.scale;
-                                groupedMirror.output.scaleX = baseScaleX * item.widthPercent;
-                                groupedMirror.output.scaleY = baseScaleY * item.heightPercent;
-                            }
-                            // Otherwise keep mirror's original scale settings
-                            outMirrors.push_back(groupedMirror);
-                        }
-                        break;
-                    }
-                }
-            }
-            break;
-        }
-    }
-
-    // Collect images
-    for (const auto& imageName : mode->imageIds) {
-        for (const auto& image : config.images) {
-            if (image.name == imageName) {
-                if (!onlyOnMyScreenPass || image.onlyOnMyScreen) { outImages.push_back(image); }
-                break;
-            }
-        }
-    }
-
-    // Collect window overlays
-    for (const auto& overlayId : mode->windowOverlayIds) {
-        for (const auto& overlay : config.windowOverlays) {
-            if (overlay.name == overlayId) {
-                if (!onlyOnMyScreenPass || overlay.onlyOnMyScreen) { outWindowOverlayIds.push_back(overlayId); }
-                break;
-            }
-        }
-    }
-}
+// Per-mode mirror/image/overlay lists, compiled from the config snapshot only when it (or the screen size) changes
+static RenderListCache g_rtRenderLists;
 
 static void RenderThreadFunc(void* gameGLContext) {
     _set_se_translator(SEHTranslator);
 
     try {
         Log("Render Thread: Starting...");
+        Profiler::GetInstance().SetThreadName("Render Thread");
 
         // Validate pre-created context
         if (!g_renderThreadDC || !g_renderThreadContext) {
@@ -4948,7 +4932,7 @@ static void RenderThreadFunc(void* gameGLContext) {
             return;
         }
 
-        LogCategory("init", "Render Thread: Context initialized successfully");
+        LogCategory(LogCategoryId::Init, "Render Thread: Context initialized successfully");
 
         // Initialize shaders on this context
         if (!RT_InitializeShaders()) {
@@ -4966,8 +4950,9 @@ static void RenderThreadFunc(void* gameGLContext) {
             int vcW, vcH;
             GetVirtualCamScaledSize(screenW, screenH, 1.0f, vcW, vcH);
             if (StartVirtualCamera(vcW, vcH, initCfg->debug.virtualCameraFps)) {
-                LogCategory("init", "Render Thread: Virtual Camera initialized at " + std::to_string(vcW) + "x" + std::to_string(vcH) +
-                                        " @ " + std::to_string(initCfg->debug.virtualCameraFps) + "fps");
+                LogCategory(LogCategoryId::Init,
+                            "Render Thread: Virtual Camera initialized at " + std::to_string(vcW) + "x" + std::to_string(vcH) +
+                                " @ " + std::to_string(initCfg->debug.virtualCameraFps) + "fps");
             } else {
                 Log("Render Thread: Virtual Camera initialization failed");
             }
@@ -5039,62 +5024,56 @@ static void RenderThreadFunc(void* gameGLContext) {
                 InitializeOverlayTextFont(fontPath, 16.0f, scaleFactor);
 
                 g_renderThreadImGuiInitialized = true;
-                LogCategory("init", "Render Thread: ImGui initialized successfully");
+                LogCategory(LogCategoryId::Init, "Render Thread: ImGui initialized successfully");
             } else {
-                LogCategory("init", "Render Thread: HWND not available, ImGui not initialized");
+                LogCategory(LogCategoryId::Init, "Render Thread: HWND not available, ImGui not initialized");
             }
         }
 
-        LogCategory("init", "Render Thread: Entering main loop");
+        LogCategory(LogCategoryId::Init, "Render Thread: Entering main loop");
 
         while (!g_renderThreadShouldStop.load()) {
             // Wait for frame request (lock only held during wait, not during processing)
             FrameRenderRequest request;
             bool isObsRequest = false;
 
-            {
-                std::unique_lock<std::mutex> lock(g_requestSignalMutex);
-                g_requestCV.wait_for(lock, std::chrono::milliseconds(16), [] {
-                    return g_requestPending.load(std::memory_order_acquire) || g_obsSubmissionPending.load(std::memory_order_acquire) ||
-                           g_renderThreadShouldStop.load();
-                });
+            // Spin briefly, then sleep until a submit (or stop) bumps the signal; 16ms timeout keeps the loop responsive
+            const uint32_t seenSignal = g_requestSignal.Load();
+            if (!g_requestMailbox.HasPending() && !g_obsMailbox.HasPending() && !g_renderThreadShouldStop.load()) {
+                g_requestSignal.WaitChange(seenSignal, std::chrono::milliseconds(16));
             }
-            // Lock released - we don't hold it while processing
 
             if (g_renderThreadShouldStop.load()) break;
 
-            // Check which request types are pending
-            bool hasObsRequest = g_obsSubmissionPending.exchange(false, std::memory_order_acq_rel);
-            bool hasMainRequest = g_requestPending.exchange(false, std::memory_order_acq_rel);
+            const auto* obsMessage = g_obsMailbox.TryTake();
+            const auto* mainMessage = g_requestMailbox.TryTake();
 
-            if (!hasObsRequest && !hasMainRequest) {
+            if (!obsMessage && !mainMessage) {
                 continue; // Timeout, no request
             }
 
             // Process OBS request first if pending (virtual camera needs this)
-            if (hasObsRequest) {
+            if (obsMessage) {
                 PROFILE_SCOPE_CAT("RT Build OBS Request", "Render Thread");
-                // Read from the slot that was last written
-                int readSlot = 1 - g_obsWriteSlot.load(std::memory_order_relaxed);
-                ObsFrameSubmission submission = g_obsSubmissionSlots[readSlot];
+                const ObsFrameSubmission& submission = obsMessage->value;
                 // Build the full request on the render thread (deferred from main thread)
                 request = BuildObsFrameRequest(submission.context, submission.isDualRenderingPath);
                 request.gameTextureFence = submission.gameTextureFence;
                 isObsRequest = true;
             } else {
                 // Only main request pending
-                int readSlot = 1 - g_requestWriteSlot.load(std::memory_order_relaxed);
-                request = g_requestSlots[readSlot];
+                request = mainMessage->value;
                 isObsRequest = false;
             }
 
+            // Main request bookkeeping: processed right away, or after the OBS request (pendingMainRequest)
+            uint64_t mainSequence = mainMessage ? mainMessage->sequence : 0;
+            int64_t mainPublishedNs = mainMessage ? mainMessage->publishedNs : 0;
+
             // Store main request for later if we're processing OBS first
             FrameRenderRequest pendingMainRequest;
-            bool hasPendingMain = hasObsRequest && hasMainRequest;
-            if (hasPendingMain) {
-                int readSlot = 1 - g_requestWriteSlot.load(std::memory_order_relaxed);
-                pendingMainRequest = g_requestSlots[readSlot];
-            }
+            bool hasPendingMain = obsMessage && mainMessage;
+            if (hasPendingMain) { pendingMainRequest = mainMessage->value; }
 
         // Label for processing a request (used to process both OBS and main in same iteration)
         process_request:
@@ -5110,17 +5089,7 @@ static void RenderThreadFunc(void* gameGLContext) {
             // Process decoded images and upload to GPU
             {
                 PROFILE_SCOPE_CAT("RT Image Processing", "Render Thread");
-                std::vector<DecodedImageData> imagesToProcess;
-                {
-                    std::lock_guard<std::mutex> lock(g_decodedImagesMutex);
-                    if (!g_decodedImagesQueue.empty()) { imagesToProcess.swap(g_decodedImagesQueue); }
-                }
-                if (!imagesToProcess.empty()) {
-                    for (const auto& decodedImg : imagesToProcess) {
-                        UploadDecodedImageToGPU(decodedImg);
-                        if (decodedImg.data) { stbi_image_free(decodedImg.data); }
-                    }
-                }
+                UploadDecodedImagesToGPU(std::chrono::microseconds(2000));
             }
 
             // Ensure FBOs are sized correctly
@@ -5165,15 +5134,12 @@ static void RenderThreadFunc(void* gameGLContext) {
                 // When transitioning FROM EyeZoom, use EyeZoom's background (not the target mode's)
                 // When transitioning TO Fullscreen, use the from-mode's background (Fullscreen has no background)
                 if (!request.isRawWindowedMode) {
-                    std::string bgModeId = request.modeId;
-                    // If transitioning FROM EyeZoom, use EyeZoom's background instead of target mode
-                    if (request.isTransitioningFromEyeZoom) {
-                        bgModeId = "EyeZoom";
-                    }
-                    // If transitioning TO Fullscreen, use the from-mode's background (Fullscreen has no background of its own)
-                    else if (EqualsIgnoreCase(request.modeId, "Fullscreen") && !request.fromModeId.empty()) {
-                        bgModeId = request.fromModeId;
-                    }
+                    static const std::string eyeZoomModeId = "EyeZoom";
+                    const std::string& targetModeId = ModeIdFromHandle(request.mode);
+                    const std::string& bgModeId =
+                        request.isTransitioningFromEyeZoom ? eyeZoomModeId
+                        : (EqualsIgnoreCase(targetModeId, "Fullscreen") && request.fromMode != 0) ? ModeIdFromHandle(request.fromMode)
+                                                                                                    : targetModeId;
 
                     const ModeConfig* mode = nullptr;
                     for (const auto& m : cfg.modes) {
@@ -5362,14 +5328,16 @@ static void RenderThreadFunc(void* gameGLContext) {
                 geo.finalH = request.finalH;
             }
 
-            // Collect active elements from g_config (this work moved from main thread)
-            std::vector<MirrorConfig> activeMirrors;
-            std::vector<ImageConfig> activeImages;
-            std::vector<std::string> activeWindowOverlayIds;
+            // Active elements for this mode, compiled once per config snapshot
+            const ModeRenderList* renderList;
             {
                 PROFILE_SCOPE_CAT("RT Collect Active Elements", "Render Thread");
-                RT_CollectActiveElements(cfg, request.modeId, false, activeMirrors, activeImages, activeWindowOverlayIds);
+                renderList = &g_rtRenderLists.Get(cfgSnapshot, ModeIdFromHandle(request.mode), GetCachedScreenWidth(),
+                                                  GetCachedScreenHeight());
             }
+            const std::vector<MirrorConfig>& activeMirrors = renderList->mirrors;
+            const std::vector<const ImageConfig*>& activeImages = renderList->images;
+            const std::vector<const WindowOverlayConfig*>& activeWindowOverlays = renderList->windowOverlays;
 
             StrongholdOverlayRenderSnapshot strongholdOverlaySnap = GetStrongholdOverlayRenderSnapshot();
             bool shouldRenderStrongholdOverlay = strongholdOverlaySnap.enabled && strongholdOverlaySnap.visible &&
@@ -5396,7 +5364,7 @@ static void RenderThreadFunc(void* gameGLContext) {
 
             // Early exit if nothing to render
             // BUT don't early exit if we need to render ImGui or the welcome toast (raw OpenGL)
-            if (activeMirrors.empty() && activeImages.empty() && activeWindowOverlayIds.empty() && !shouldRenderAnyImGui &&
+            if (activeMirrors.empty() && activeImages.empty() && activeWindowOverlays.empty() && !shouldRenderAnyImGui &&
                 !request.showWelcomeToast) {
                 // Still need to advance FBO and signal completion even if empty
                 // Create fence for synchronization
@@ -5429,19 +5397,10 @@ static void RenderThreadFunc(void* gameGLContext) {
 
                 if (isObsRequest) {
                     AdvanceObsFBO();
-                    {
-                        std::lock_guard<std::mutex> lock(g_obsCompletionMutex);
-                        g_obsFrameComplete.store(true);
-                    }
-                    g_obsCompletionCV.notify_one();
                 } else {
                     AdvanceWriteFBO();
                     g_renderFrameNumber.store(request.frameNumber);
-                    {
-                        std::lock_guard<std::mutex> lock(g_completionMutex);
-                        g_frameComplete.store(true);
-                    }
-                    g_completionCV.notify_one();
+                    RT_SignalRequestComplete(mainSequence, mainPublishedNs);
                 }
                 continue;
             }
@@ -5473,13 +5432,17 @@ static void RenderThreadFunc(void* gameGLContext) {
                 SwapMirrorBuffers();
 
                 // Determine if we're in EyeZoom mode (for the collected mirrors)
-                bool isEyeZoomMode = (request.modeId == "EyeZoom");
+                bool isEyeZoomMode = (ModeIdFromHandle(request.mode) == "EyeZoom");
+                const ModeRenderList* fromList =
+                    request.fromMode == 0 ? nullptr
+                                          : &g_rtRenderLists.Get(cfgSnapshot, ModeIdFromHandle(request.fromMode), GetCachedScreenWidth(),
+                                                                 GetCachedScreenHeight());
 
                 RT_RenderMirrors(activeMirrors, geo, request.fullW, request.fullH, request.overlayOpacity, excludeOoms,
                                  request.relativeStretching, request.transitionProgress, request.mirrorSlideProgress, request.fromX,
                                  request.fromY, request.fromW, request.fromH, request.toX, request.toY, request.toW, request.toH,
                                  isEyeZoomMode, request.isTransitioningFromEyeZoom, request.eyeZoomAnimatedViewportX, request.skipAnimation,
-                                 request.fromModeId, request.fromSlideMirrorsIn, request.toSlideMirrorsIn, false /* isSlideOutPass */,
+                                 fromList, request.fromSlideMirrorsIn, request.toSlideMirrorsIn, false /* isSlideOutPass */,
                                  renderVAO, renderVBO);
             }
 
@@ -5490,34 +5453,21 @@ static void RenderThreadFunc(void* gameGLContext) {
             if (!request.isRawWindowedMode && request.isTransitioningFromEyeZoom && cfg.eyezoom.slideMirrorsIn && !request.skipAnimation) {
                 PROFILE_SCOPE_CAT("RT EyeZoom Mirror Slide Out", "Render Thread");
 
-                // Collect EyeZoom mirrors (not the target mode's mirrors)
-                std::vector<MirrorConfig> eyeZoomMirrors;
-                std::vector<ImageConfig> unusedImages;
-                std::vector<std::string> unusedOverlays;
-                RT_CollectActiveElements(cfg, "EyeZoom", false, eyeZoomMirrors, unusedImages, unusedOverlays);
-
-                // Filter out mirrors that already exist in the target mode (don't slide those out)
-                std::vector<MirrorConfig> mirrorsToSlideOut;
-                for (const auto& ezMirror : eyeZoomMirrors) {
-                    bool existsInTarget = false;
-                    for (const auto& targetMirror : activeMirrors) {
-                        if (targetMirror.name == ezMirror.name) {
-                            existsInTarget = true;
-                            break;
-                        }
-                    }
-                    if (!existsInTarget) { mirrorsToSlideOut.push_back(ezMirror); }
-                }
+                // EyeZoom mirrors (not the target mode's mirrors), minus those the target mode also shows (don't slide
+                // those out)
+                const ModeRenderList& eyeZoomList =
+                    g_rtRenderLists.Get(cfgSnapshot, "EyeZoom", GetCachedScreenWidth(), GetCachedScreenHeight());
+                const std::vector<MirrorConfig>& mirrorsToSlideOut = g_rtRenderLists.MirrorsOnlyIn(eyeZoomList, *renderList);
 
                 if (!mirrorsToSlideOut.empty()) {
                     // Render these EyeZoom mirrors with slide-out animation
                     // isEyeZoomMode=true because these ARE EyeZoom mirrors
-                    // Pass request.modeId as fromModeId - this is the target mode we're transitioning TO
+                    // Pass the target mode's list as fromList - this is the mode we're transitioning TO
                     RT_RenderMirrors(mirrorsToSlideOut, geo, request.fullW, request.fullH, request.overlayOpacity, excludeOoms,
                                      request.relativeStretching, request.transitionProgress, request.mirrorSlideProgress, request.fromX,
                                      request.fromY, request.fromW, request.fromH, request.toX, request.toY, request.toW, request.toH, true,
                                      request.isTransitioningFromEyeZoom, request.eyeZoomAnimatedViewportX, request.skipAnimation,
-                                     request.modeId, cfg.eyezoom.slideMirrorsIn, request.toSlideMirrorsIn, true /* isSlideOutPass */,
+                                     renderList, cfg.eyezoom.slideMirrorsIn, request.toSlideMirrorsIn, true /* isSlideOutPass */,
                                      renderVAO, renderVBO);
                 }
             }
@@ -5525,35 +5475,21 @@ static void RenderThreadFunc(void* gameGLContext) {
             // When transitioning FROM a mode with slideMirrorsIn (non-EyeZoom), render slide-out animation
             // for mirrors unique to the FROM mode
             // Skip animation when hideAnimationsInGame is enabled (skipAnimation flag)
-            if (!request.isTransitioningFromEyeZoom && request.fromSlideMirrorsIn && !request.fromModeId.empty() &&
+            if (!request.isTransitioningFromEyeZoom && request.fromSlideMirrorsIn && request.fromMode != 0 &&
                 request.mirrorSlideProgress < 1.0f && !request.skipAnimation) {
                 PROFILE_SCOPE_CAT("RT Generic Mirror Slide Out", "Render Thread");
 
-                // Collect FROM mode mirrors
-                std::vector<MirrorConfig> fromModeMirrors;
-                std::vector<ImageConfig> unusedImages;
-                std::vector<std::string> unusedOverlays;
-                RT_CollectActiveElements(cfg, request.fromModeId, false, fromModeMirrors, unusedImages, unusedOverlays);
-
-                // Filter out mirrors that already exist in the target mode (don't slide those out)
-                std::vector<MirrorConfig> mirrorsToSlideOut;
-                for (const auto& fromMirror : fromModeMirrors) {
-                    bool existsInTarget = false;
-                    for (const auto& targetMirror : activeMirrors) {
-                        if (targetMirror.name == fromMirror.name) {
-                            existsInTarget = true;
-                            break;
-                        }
-                    }
-                    if (!existsInTarget) { mirrorsToSlideOut.push_back(fromMirror); }
-                }
+                // FROM mode mirrors, minus those that also exist in the target mode (don't slide those out)
+                const ModeRenderList& fromModeList =
+                    g_rtRenderLists.Get(cfgSnapshot, ModeIdFromHandle(request.fromMode), GetCachedScreenWidth(), GetCachedScreenHeight());
+                const std::vector<MirrorConfig>& mirrorsToSlideOut = g_rtRenderLists.MirrorsOnlyIn(fromModeList, *renderList);
 
                 if (!mirrorsToSlideOut.empty()) {
                     // Render these mirrors with slide-out animation
                     RT_RenderMirrors(mirrorsToSlideOut, geo, request.fullW, request.fullH, request.overlayOpacity, excludeOoms,
                                      request.relativeStretching, request.transitionProgress, request.mirrorSlideProgress, request.fromX,
                                      request.fromY, request.fromW, request.fromH, request.toX, request.toY, request.toW, request.toH, false,
-                                     false, -1, request.skipAnimation, request.modeId, request.fromSlideMirrorsIn, request.toSlideMirrorsIn,
+                                     false, -1, request.skipAnimation, renderList, request.fromSlideMirrorsIn, request.toSlideMirrorsIn,
                                      true /* isSlideOutPass */, renderVAO, renderVBO);
                 }
             }
@@ -5567,9 +5503,9 @@ static void RenderThreadFunc(void* gameGLContext) {
             }
 
             // Render window overlays using local shaders
-            if (!activeWindowOverlayIds.empty()) {
+            if (!activeWindowOverlays.empty()) {
                 PROFILE_SCOPE_CAT("RT Window Overlay Render", "Render Thread");
-                RT_RenderWindowOverlays(activeWindowOverlayIds, request.fullW, request.fullH, request.toX, request.toY, request.toW,
+                RT_RenderWindowOverlays(activeWindowOverlays, request.fullW, request.fullH, request.toX, request.toY, request.toW,
                                         request.toH, request.gameW, request.gameH, request.relativeStretching, request.transitionProgress,
                                         request.fromX, request.fromY, request.fromW, request.fromH, request.overlayOpacity, excludeOoms,
                                         renderVAO, renderVBO);
@@ -5763,8 +5699,10 @@ static void RenderThreadFunc(void* gameGLContext) {
                 g_lastGoodObsTexture.store(writeFBO.texture, std::memory_order_release);
 
                 // Virtual Camera: render cursor onto a SEPARATE staging texture so it doesn't
-                // appear on game capture (which reads g_lastGoodObsTexture directly)
-                if (IsVirtualCameraActive()) {
+                // appear on game capture (which reads g_lastGoodObsTexture directly).
+                // Completed readbacks are handed off every frame; new captures (blit + readback) only when paced in.
+                if (IsVirtualCameraActive()) { PumpVirtualCameraPipeline(); }
+                if (IsVirtualCameraActive() && ShouldCaptureVirtualCameraFrame(IsVirtualCameraPipelineBusy())) {
                     int vcW = request.fullW;
                     int vcH = request.fullH;
 
@@ -5817,7 +5755,7 @@ static void RenderThreadFunc(void* gameGLContext) {
                     // Start async readback from the staging texture (with cursor)
                     StartVirtualCameraAsyncReadback(g_vcCursorTexture, vcW, vcH);
                 } else {
-                    // No virtual camera - no cursor rendering needed
+                    // No virtual camera or not a capture frame - no cursor rendering needed
                 }
             } else {
                 // Exchange fences - delete the OLDEST pending fence, not the one just swapped out
@@ -5836,19 +5774,10 @@ static void RenderThreadFunc(void* gameGLContext) {
             // Advance to next FBO and signal completion
             if (isObsRequest) {
                 AdvanceObsFBO();
-                {
-                    std::lock_guard<std::mutex> lock(g_obsCompletionMutex);
-                    g_obsFrameComplete.store(true);
-                }
-                g_obsCompletionCV.notify_one();
             } else {
                 AdvanceWriteFBO();
                 g_renderFrameNumber.store(request.frameNumber);
-                {
-                    std::lock_guard<std::mutex> lock(g_completionMutex);
-                    g_frameComplete.store(true);
-                }
-                g_completionCV.notify_one();
+                RT_SignalRequestComplete(mainSequence, mainPublishedNs);
             }
 
             // If we processed OBS first and there was also a main request pending, process it now
@@ -5988,8 +5917,14 @@ void StartRenderThread(void* gameGLContext) {
     // Reset state
     g_renderThreadShouldStop.store(false);
     g_renderThreadRunning.store(true);
-    g_requestPending.store(false);
-    g_frameComplete.store(false);
+    // Requests published while no render thread was running are stale; the new thread must not render them
+    g_requestMailbox.Reset();
+    ObsFrameSubmission staleObs;
+    if (g_obsMailbox.Reset(&staleObs) && staleObs.gameTextureFence) { glDeleteSync(staleObs.gameTextureFence); }
+    g_completedRequestSequence.store(g_requestMailbox.PublishedSequence());
+    g_requestLatency.Clear();
+    g_requestStatsWindowStart = std::chrono::steady_clock::now();
+    g_requestStatsDroppedAtWindowStart = 0;
     g_writeFBOIndex.store(0);
     g_readFBOIndex.store(-1);
     g_lastGoodTexture.store(0);
@@ -5999,7 +5934,7 @@ void StartRenderThread(void* gameGLContext) {
 
     // Start thread
     g_renderThread = std::thread(RenderThreadFunc, gameGLContext);
-    LogCategory("init", "Render Thread: Started");
+    LogCategory(LogCategoryId::Init, "Render Thread: Started");
 }
 
 void StopRenderThread() {
@@ -6009,48 +5944,84 @@ void StopRenderThread() {
     g_renderThreadShouldStop.store(true);
 
     // Wake up thread if waiting
-    g_requestCV.notify_one();
+    g_requestSignal.Notify();
+    g_renderCompleteSignal.Notify();
 
     if (g_renderThread.joinable()) { g_renderThread.join(); }
 
+    // The render thread is the only caller of the CPU NV12 path; release its band workers with it
+    ShutdownNv12ConvertWorkers();
+
     Log("Render Thread: Joined");
 }
 
-void SubmitFrameForRendering(const FrameRenderRequest& request) {
-    // Lock-free submission using double-buffered slots
-    // Main thread ALWAYS succeeds - never blocks waiting for render thread
-
-    // If there was a pending request we're overwriting, count it as dropped
-    if (g_requestPending.load(std::memory_order_relaxed)) { g_framesDropped.fetch_add(1, std::memory_order_relaxed); }
+// Mode id interning. Lookups by handle are lock-free; interning a new id takes the mutex, and each thread remembers
+// its last hit so the per-frame call for an unchanged mode skips it entirely.
+static constexpr ModeHandle MAX_INTERNED_MODE_IDS = 1024;
+static std::atomic<const std::string*> g_internedModeIds[MAX_INTERNED_MODE_IDS];
+static std::mutex g_internModeIdMutex;
+static std::unordered_map<std::string, ModeHandle> g_modeHandlesById; // Guarded by g_internModeIdMutex
 
-    // Write to current write slot
-    int writeSlot = g_requestWriteSlot.load(std::memory_order_relaxed);
-    g_requestSlots[writeSlot] = request;
+ModeHandle InternModeId(const std::string& modeId) {
+    if (modeId.empty()) return 0;
 
-    // Swap write slot so next submission goes to the other slot
-    // This also tells render thread which slot to read from (the one we just wrote)
-    g_requestWriteSlot.store(1 - writeSlot, std::memory_order_relaxed);
+    thread_local std::string lastId;
+    thread_local ModeHandle lastHandle = 0;
+    if (lastHandle != 0 && lastId == modeId) return lastHandle;
 
-    // Mark as pending
-    g_requestPending.store(true, std::memory_order_release);
-    g_frameComplete.store(false, std::memory_order_relaxed);
+    ModeHandle handle = 0;
+    {
+        std::lock_guard<std::mutex> lock(g_internModeIdMutex);
+        auto it = g_modeHandlesById.find(modeId);
+        if (it != g_modeHandlesById.end()) {
+            handle = it->second;
+        } else {
+            handle = static_cast<ModeHandle>(g_modeHandlesById.size() + 1);
+            if (handle >= MAX_INTERNED_MODE_IDS) {
+                Log("Render Thread: Too many distinct mode ids, '" + modeId + "' will render as an unknown mode");
+                return 0;
+            }
+            // Leaked on purpose: handles stay valid for the life of the process
+            g_internedModeIds[handle].store(new std::string(modeId), std::memory_order_release);
+            g_modeHandlesById.emplace(modeId, handle);
+        }
+    }
 
-    // Signal the condition variable (brief lock only for CV, not for data protection)
-    { std::lock_guard<std::mutex> lock(g_requestSignalMutex); }
-    g_requestCV.notify_one();
+    lastId = modeId;
+    lastHandle = handle;
+    return handle;
 }
 
-int WaitForRenderComplete(int timeoutMs) {
-    std::unique_lock<std::mutex> lock(g_completionMutex);
+const std::string& ModeIdFromHandle(ModeHandle handle) {
+    static const std::string empty;
+    if (handle == 0 || handle >= MAX_INTERNED_MODE_IDS) return empty;
+    const std::string* id = g_internedModeIds[handle].load(std::memory_order_acquire);
+    return id ? *id : empty;
+}
 
-    bool completed = g_completionCV.wait_for(lock, std::chrono::milliseconds(timeoutMs),
-                                             [] { return g_frameComplete.load() || g_renderThreadShouldStop.load(); });
+void SubmitFrameForRendering(const FrameRenderRequest& request) {
+    // Lock-free submission through the triple-buffered mailbox
+    // Main thread ALWAYS succeeds - never blocks waiting for render thread
 
-    if (g_renderThreadShouldStop.load()) return -1;
-    if (!completed) return -1;
+    // If there was a pending request we're overwriting, count it as dropped
+    if (g_requestMailbox.Publish(request, RT_NowNs())) { g_framesDropped.fetch_add(1, std::memory_order_relaxed); }
+    g_requestSignal.Notify();
+}
 
-    g_frameComplete.store(false);
-    return g_readFBOIndex.load();
+int WaitForRenderComplete(int timeoutMs) {
+    // Waits for the render of the most recently submitted request (or a newer one)
+    const uint64_t target = g_requestMailbox.PublishedSequence();
+    const auto deadline = std::chrono::steady_clock::now() + std::chrono::milliseconds(timeoutMs);
+
+    for (;;) {
+        const uint32_t seen = g_renderCompleteSignal.Load();
+        if (g_renderThreadShouldStop.load()) return -1;
+        if (g_completedRequestSequence.load(std::memory_order_acquire) >= target) return g_readFBOIndex.load();
+
+        const auto remaining = deadline - std::chrono::steady_clock::now();
+        if (remaining <= std::chrono::nanoseconds::zero()) return -1;
+        g_renderCompleteSignal.WaitChange(seen, std::chrono::duration_cast<std::chrono::nanoseconds>(remaining));
+    }
 }
 
 GLuint GetCompletedRenderTexture() {
@@ -6068,29 +6039,16 @@ GLsync GetCompletedRenderFence() {
 }
 
 void SubmitObsFrameContext(const ObsFrameSubmission& submission) {
-    // Lock-free submission using double-buffered slots
+    // Lock-free submission through the triple-buffered mailbox
     // Main thread ALWAYS succeeds - never blocks waiting for render thread
 
-    // NOTE: We do NOT delete fences here even if overwriting a pending submission.
-    // The render thread owns the gameTextureFence and is responsible for deleting it
-    // after processing. Deleting here causes a race condition where the render thread
-    // may have already copied the fence pointer and will try to delete it again.
-    // Occasional fence leaks from dropped frames are acceptable and rare.
-
-    // Write to current write slot
-    int writeSlot = g_obsWriteSlot.load(std::memory_order_relaxed);
-    g_obsSubmissionSlots[writeSlot] = submission;
-
-    // Swap write slot
-    g_obsWriteSlot.store(1 - writeSlot, std::memory_order_relaxed);
-
-    // Mark as pending
-    g_obsSubmissionPending.store(true, std::memory_order_release);
-    g_obsFrameComplete.store(false, std::memory_order_relaxed);
-
-    // Signal the condition variable
-    { std::lock_guard<std::mutex> lock(g_requestSignalMutex); }
-    g_requestCV.notify_one();
+    // A replaced submission was never taken by the render thread, so its fence is still ours to delete.
+    // (Fences of submissions the render thread did take are deleted there after processing.)
+    ObsFrameSubmission replaced;
+    if (g_obsMailbox.Publish(submission, RT_NowNs(), &replaced) && replaced.gameTextureFence) {
+        glDeleteSync(replaced.gameTextureFence);
+    }
+    g_requestSignal.Notify();
 }
 
 GLuint GetCompletedObsTexture() {
@@ -6124,21 +6082,22 @@ FrameRenderRequest BuildObsFrameRequest(const ObsFrameContext& ctx, bool isDualR
     req.gameW = ctx.gameW;
     req.gameH = ctx.gameH;
     req.gameTextureId = ctx.gameTextureId;
-    req.modeId = ctx.modeId;
+    req.mode = ctx.mode;
     req.overlayOpacity = 1.0f;
     req.obsDetected = true;
     req.excludeOnlyOnMyScreen = true;
     req.skipAnimation = false;
     req.isObsPass = true;
     req.relativeStretching = ctx.relativeStretching;
-    req.fromModeId = transitionState.fromModeId; // For source mirror check in sliding animation
+    req.fromMode = InternModeId(transitionState.fromModeId); // For source mirror check in sliding animation
 
     // Slide mirrors animation settings
     if (!transitionState.fromModeId.empty()) {
         const ModeConfig* fromMode = GetModeFromSnapshot(obsCfg, transitionState.fromModeId);
         if (fromMode) { req.fromSlideMirrorsIn = fromMode->slideMirrorsIn; }
     }
-    const ModeConfig* toMode = GetModeFromSnapshot(obsCfg, ctx.modeId);
+    const std::string& modeId = ModeIdFromHandle(ctx.mode);
+    const ModeConfig* toMode = GetModeFromSnapshot(obsCfg, modeId);
     if (toMode) { req.toSlideMirrorsIn = toMode->slideMirrorsIn; }
 
     // Mirror slide progress - uses actual moveProgress independent of overlay transition type
@@ -6337,7 +6296,7 @@ FrameRenderRequest BuildObsFrameRequest(const ObsFrameContext& ctx, bool isDualR
     }
 
     // Background color - check for fullscreen transition
-    bool transitioningToFullscreen = EqualsIgnoreCase(ctx.modeId, "Fullscreen") && !transitionState.fromModeId.empty();
+    bool transitioningToFullscreen = EqualsIgnoreCase(modeId, "Fullscreen") && !transitionState.fromModeId.empty();
     if (transitioningToFullscreen && !transitionEffectivelyComplete) {
         const ModeConfig* fromMode = GetModeFromSnapshot(obsCfg, transitionState.fromModeId);
         if (fromMode) {
@@ -6356,7 +6315,7 @@ FrameRenderRequest BuildObsFrameRequest(const ObsFrameContext& ctx, bool isDualR
     }
 
     // Mode border config - look up from current mode
-    const ModeConfig* currentMode = GetModeFromSnapshot(obsCfg, ctx.modeId);
+    const ModeConfig* currentMode = GetModeFromSnapshot(obsCfg, modeId);
     if (currentMode) {
         req.borderEnabled = currentMode->border.enabled;
         req.borderR = currentMode->border.color.r;
@@ -6,6 +6,7 @@
 #include <GL/glew.h>
 #include <atomic>
 #include <chrono>
+#include <cstdint>
 #include <condition_variable>
 #include <mutex>
 #include <string>
@@ -20,7 +21,13 @@ struct GameViewportGeometry;
 
 constexpr int RENDER_THREAD_FBO_COUNT = 3; // Triple buffering
 
-// Lightweight struct - render thread looks up active elements from g_config directly
+// Interned mode id, so frame requests stay trivially copyable (they travel through a lock-free mailbox).
+// 0 is the empty id. Handles are never reused and their strings live for the rest of the process.
+using ModeHandle = uint32_t;
+ModeHandle InternModeId(const std::string& modeId);
+const std::string& ModeIdFromHandle(ModeHandle handle);
+
+// Lightweight POD struct - render thread looks up active elements from g_config directly
 // This avoids expensive vector copies on every frame
 struct FrameRenderRequest {
     // Frame identification
@@ -43,7 +50,7 @@ struct FrameRenderRequest {
     GLuint gameTextureId = 0;
 
     // Mode ID - render thread looks up ModeConfig and collects active elements
-    std::string modeId;
+    ModeHandle mode = 0;
 
     // Transition state
     bool isAnimating = false;
@@ -106,7 +113,7 @@ struct FrameRenderRequest {
     float fromBorderB = 1.0f;
     int fromBorderWidth = 0;
     int fromBorderRadius = 0;
-    std::string fromModeId; // For looking up from-mode's background texture
+    ModeHandle fromMode = 0; // For looking up from-mode's background texture
 
     // Slide mirrors animation - per-mode setting for mirror slide in/out
     bool fromSlideMirrorsIn = false;  // FROM mode's slideMirrorsIn setting
@@ -199,7 +206,7 @@ struct ObsFrameContext {
     int fullW, fullH;
     int gameW, gameH;
     GLuint gameTextureId;
-    std::string modeId;
+    ModeHandle mode;
     bool relativeStretching;
     float bgR, bgG, bgB;
 
@@ -0,0 +1,140 @@
+#include "structured_log.h"
+
+#include <cinttypes>
+#include <cstdio>
+#include <mutex>
+#include <vector>
+
+std::atomic<uint32_t> g_logCategoryMask{ 1u << static_cast<uint32_t>(LogCategoryId::General) };
+
+void SetLogCategoryMask(uint32_t mask) {
+    g_logCategoryMask.store(mask | (1u << static_cast<uint32_t>(LogCategoryId::General)), std::memory_order_relaxed);
+}
+
+namespace {
+
+// Single producer (the owning thread), single consumer (the log writer)
+struct LogThreadRing {
+    static constexpr size_t kCapacity = 1024; // Power of 2; 64 KB of records
+    LogRecord records[kCapacity];
+    std::atomic<uint64_t> head{ 0 };     // Only written by the owning thread
+    std::atomic<uint64_t> tail{ 0 };     // Only written by the writer
+    std::atomic<uint64_t> dropped{ 0 };  // Records lost to a full ring
+    std::atomic<bool> threadExited{ false };
+};
+
+std::mutex g_ringRegistryMutex;
+std::vector<LogThreadRing*> g_ringRegistry;
+
+// Hands the ring to the writer when its thread exits; the writer frees it once drained
+struct LogThreadRingOwner {
+    LogThreadRing* ring = nullptr;
+    ~LogThreadRingOwner() {
+        if (ring) ring->threadExited.store(true, std::memory_order_release);
+    }
+};
+
+LogThreadRing& ThisThreadRing() {
+    thread_local LogThreadRingOwner owner;
+    if (!owner.ring) {
+        owner.ring = new LogThreadRing();
+        std::lock_guard<std::mutex> lock(g_ringRegistryMutex);
+        g_ringRegistry.push_back(owner.ring);
+    }
+    return *owner.ring;
+}
+
+void AppendArg(const LogRecord& record, size_t index, size_t& offset, std::string& out) {
+    char buffer[32];
+    const LogArgType type = record.argTypes[index];
+    if (type == LogArgType::String) {
+        if (offset >= kLogRecordPayloadBytes) return;
+        const size_t length = record.payload[offset++];
+        out.append(reinterpret_cast<const char*>(record.payload + offset), length);
+        offset += length;
+        return;
+    }
+    if (offset + 8 > kLogRecordPayloadBytes) return;
+    uint64_t bits = 0;
+    std::memcpy(&bits, record.payload + offset, 8);
+    offset += 8;
+    switch (type) {
+    case LogArgType::Int:
+        std::snprintf(buffer, sizeof(buffer), "%" PRId64, static_cast<int64_t>(bits));
+        break;
+    case LogArgType::UInt:
+        std::snprintf(buffer, sizeof(buffer), "%" PRIu64, bits);
+        break;
+    case LogArgType::Double: {
+        double value = 0.0;
+        std::memcpy(&value, &bits, 8);
+        std::snprintf(buffer, sizeof(buffer), "%g", value);
+        break;
+    }
+    case LogArgType::Bool:
+        std::snprintf(buffer, sizeof(buffer), "%s", bits ? "true" : "false");
+        break;
+    default:
+        buffer[0] = '\0';
+        break;
+    }
+    out += buffer;
+}
+
+} // namespace
+
+void SubmitLogRecord(const LogRecord& record) {
+    LogThreadRing& ring = ThisThreadRing();
+    const uint64_t head = ring.head.load(std::memory_order_relaxed);
+    if (head - ring.tail.load(std::memory_order_acquire) >= LogThreadRing::kCapacity) {
+        // Writer is a full ring behind - drop rather than block the caller
+        ring.dropped.fetch_add(1, std::memory_order_relaxed);
+        return;
+    }
+    ring.records[head & (LogThreadRing::kCapacity - 1)] = record;
+    ring.head.store(head + 1, std::memory_order_release);
+}
+
+void FormatLogRecord(const LogRecord& record, std::string& out) {
+    out.clear();
+    size_t offset = 0;
+    size_t argIndex = 0;
+    for (const char* p = record.format ? record.format : ""; *p; ++p) {
+        if (p[0] == '{' && p[1] == '}' && argIndex < record.argCount) {
+            AppendArg(record, argIndex++, offset, out);
+            ++p;
+            continue;
+        }
+        out += *p;
+    }
+}
+
+uint64_t DrainLogRecords(const std::function<void(int64_t ticks, std::string_view text)>& visit) {
+    thread_local std::string s_text;
+    uint64_t dropped = 0;
+
+    std::lock_guard<std::mutex> lock(g_ringRegistryMutex);
+    for (size_t i = 0; i < g_ringRegistry.size();) {
+        LogThreadRing* ring = g_ringRegistry[i];
+        // Read exit before head: a ring seen as exited has no records left to commit past this head
+        const bool exited = ring->threadExited.load(std::memory_order_acquire);
+        const uint64_t head = ring->head.load(std::memory_order_acquire);
+        uint64_t tail = ring->tail.load(std::memory_order_relaxed);
+        for (; tail != head; ++tail) {
+            const LogRecord& record = ring->records[tail & (LogThreadRing::kCapacity - 1)];
+            FormatLogRecord(record, s_text);
+            visit(record.ticks, s_text);
+        }
+        ring->tail.store(tail, std::memory_order_release);
+        dropped += ring->dropped.exchange(0, std::memory_order_relaxed);
+
+        if (exited) {
+            delete ring;
+            g_ringRegistry[i] = g_ringRegistry.back();
+            g_ringRegistry.pop_back();
+        } else {
+            ++i;
+        }
+    }
+    return dropped;
+}
@@ -0,0 +1,131 @@
+#pragma once
+
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+#include <cstring>
+#include <functional>
+#include <string>
+#include <string_view>
+#include <type_traits>
+
+// Binary log records for hot paths. LogEvent() copies a fixed-size record (timestamp ticks, category, format string
+// pointer, raw argument bytes) into a ring owned by the calling thread: no allocation, no formatting and no lock on
+// the caller. The log writer thread drains every ring and expands the "{}" placeholders. Platform-neutral.
+
+enum class LogCategoryId : uint8_t {
+    General = 0, // Always enabled
+    ModeSwitch,
+    Animation,
+    Hotkey,
+    Obs,
+    WindowOverlay,
+    FileMonitor,
+    ImageMonitor,
+    Performance,
+    TextureOps,
+    Gui,
+    Init,
+    CursorTextures,
+    Count
+};
+
+// One bit per LogCategoryId, refreshed from the debug config whenever a config snapshot is published
+extern std::atomic<uint32_t> g_logCategoryMask;
+
+inline bool IsLogCategoryEnabled(LogCategoryId category) {
+    return (g_logCategoryMask.load(std::memory_order_relaxed) >> static_cast<uint32_t>(category)) & 1u;
+}
+
+void SetLogCategoryMask(uint32_t mask); // General stays enabled whatever the mask says
+
+constexpr size_t kLogRecordMaxArgs = 6;
+constexpr size_t kLogRecordPayloadBytes = 40;
+
+enum class LogArgType : uint8_t { Int = 0, UInt, Double, Bool, String };
+
+// 64 bytes, one cache line
+struct LogRecord {
+    int64_t ticks = 0;            // steady_clock
+    const char* format = nullptr; // String literal, so it outlives the record
+    LogCategoryId category = LogCategoryId::General;
+    uint8_t argCount = 0;
+    LogArgType argTypes[kLogRecordMaxArgs] = {};
+    uint8_t payload[kLogRecordPayloadBytes] = {}; // 8 bytes per number; strings as length byte + bytes (truncated to fit)
+};
+static_assert(sizeof(LogRecord) == 64, "LogRecord should stay one cache line");
+
+// Copies the record into this thread's ring (registering the ring on the thread's first call). Drops it and counts
+// the drop when the writer has fallen a full ring behind.
+void SubmitLogRecord(const LogRecord& record);
+
+// Writer side: visits every committed record of every thread, oldest first within each thread, as the formatted text
+// without timestamp. Rings of threads that have exited are freed once empty. Returns the records dropped since the
+// last call.
+uint64_t DrainLogRecords(const std::function<void(int64_t ticks, std::string_view text)>& visit);
+
+// Expands a record's "{}" placeholders into `out` (replacing its contents)
+void FormatLogRecord(const LogRecord& record, std::string& out);
+
+inline int64_t LogTicksNow() { return std::chrono::steady_clock::now().time_since_epoch().count(); }
+
+namespace log_detail {
+
+inline void PackNumber(LogRecord& record, size_t& used, LogArgType type, const void* value) {
+    if (used + 8 > kLogRecordPayloadBytes) {
+        record.argTypes[record.argCount++] = LogArgType::String; // No room: shows as an empty string
+        return;
+    }
+    record.argTypes[record.argCount++] = type;
+    std::memcpy(record.payload + used, value, 8);
+    used += 8;
+}
+
+inline void PackString(LogRecord& record, size_t& used, std::string_view text) {
+    record.argTypes[record.argCount++] = LogArgType::String;
+    if (used >= kLogRecordPayloadBytes) return;
+    const size_t length = std::min(text.size(), kLogRecordPayloadBytes - used - 1);
+    record.payload[used++] = static_cast<uint8_t>(length);
+    std::memcpy(record.payload + used, text.data(), length);
+    used += length;
+}
+
+template <typename T> inline void PackArg(LogRecord& record, size_t& used, const T& value) {
+    if constexpr (std::is_same_v<T, bool>) {
+        const uint64_t v = value ? 1 : 0;
+        PackNumber(record, used, LogArgType::Bool, &v);
+    } else if constexpr (std::is_enum_v<T>) {
+        PackArg(record, used, static_cast<std::underlying_type_t<T>>(value));
+    } else if constexpr (std::is_integral_v<T> && std::is_signed_v<T>) {
+        const int64_t v = value;
+        PackNumber(record, used, LogArgType::Int, &v);
+    } else if constexpr (std::is_integral_v<T>) {
+        const uint64_t v = value;
+        PackNumber(record, used, LogArgType::UInt, &v);
+    } else if constexpr (std::is_floating_point_v<T>) {
+        const double v = static_cast<double>(value);
+        PackNumber(record, used, LogArgType::Double, &v);
+    } else if constexpr (std::is_convertible_v<const T&, std::string_view>) {
+        PackString(record, used, std::string_view(value));
+    } else {
+        static_assert(std::is_pointer_v<T>, "LogEvent arguments must be numbers, enums, strings or pointers");
+        const uint64_t v = reinterpret_cast<uintptr_t>(value);
+        PackNumber(record, used, LogArgType::UInt, &v);
+    }
+}
+
+} // namespace log_detail
+
+// LogEvent(LogCategoryId::TextureOps, "Resized copy textures to {}x{}", width, height);
+// `format` must be a string literal. Strings are copied (the payload holds 40 bytes in total), so temporaries are fine.
+template <size_t N, typename... Args> inline void LogEvent(LogCategoryId category, const char (&format)[N], const Args&... args) {
+    static_assert(sizeof...(Args) <= kLogRecordMaxArgs, "LogEvent takes at most 6 arguments");
+    if (!IsLogCategoryEnabled(category)) return;
+    LogRecord record;
+    record.ticks = LogTicksNow();
+    record.format = format;
+    record.category = category;
+    size_t used = 0;
+    (log_detail::PackArg(record, used, args), ...);
+    SubmitLogRecord(record);
+}
@@ -0,0 +1,76 @@
+#include "toml_ordered_writer.h"
+
+#include <algorithm>
+#include <sstream>
+
+namespace {
+
+bool IsSectionTable(const toml::node& node) {
+    const toml::table* tbl = node.as_table();
+    return tbl && !tbl->is_inline();
+}
+
+// Same rule toml++ uses for [[ ]] output: an array of tables whose first table isn't marked inline
+bool IsSectionTableArray(const toml::node& node) {
+    const toml::array* arr = node.as_array();
+    return arr && arr->is_array_of_tables() && !(*arr)[0].as_table()->is_inline();
+}
+
+std::string FormatKey(std::string_view key) {
+    const bool bare = !key.empty() && std::all_of(key.begin(), key.end(), [](char c) {
+        return (c >= 'A' && c <= 'Z') || (c >= 'a' && c <= 'z') || (c >= '0' && c <= '9') || c == '_' || c == '-';
+    });
+    if (bare) return std::string(key);
+    std::ostringstream quoted;
+    quoted << toml::value<std::string>(std::string(key));
+    return quoted.str();
+}
+
+void WriteKeyValue(std::ostream& out, std::string_view key, const toml::node& node) {
+    out << FormatKey(key) << " = ";
+    if (const toml::table* tbl = node.as_table()) {
+        // Only inline tables reach here, and toml++ prints those in { } form
+        out << *tbl;
+    } else {
+        node.visit([&out](auto&& value) { out << value; });
+    }
+    out << "\n";
+}
+
+std::string ChildPath(const std::string& path, std::string_view key) { return path.empty() ? FormatKey(key) : path + "." + FormatKey(key); }
+
+} // namespace
+
+void WriteTomlTableOrdered(std::ostream& out, const toml::table& tbl, const std::vector<std::string>& orderedKeys, const std::string& path) {
+    // Listed keys first, in order, then the rest in table order
+    std::vector<std::pair<std::string_view, const toml::node*>> entries;
+    entries.reserve(tbl.size());
+    for (const std::string& key : orderedKeys) {
+        if (const toml::node* node = tbl.get(key)) entries.emplace_back(key, node);
+    }
+    for (const auto& [key, node] : tbl) {
+        if (std::find(orderedKeys.begin(), orderedKeys.end(), key.str()) == orderedKeys.end()) entries.emplace_back(key.str(), &node);
+    }
+
+    for (const auto& [key, node] : entries) {
+        if (!IsSectionTable(*node) && !IsSectionTableArray(*node)) WriteKeyValue(out, key, *node);
+    }
+    for (const auto& [key, node] : entries) {
+        if (IsSectionTable(*node)) {
+            WriteTomlNamedTable(out, ChildPath(path, key), *node->as_table());
+        } else if (IsSectionTableArray(*node)) {
+            for (const toml::node& element : *node->as_array()) WriteTomlArrayTableEntry(out, ChildPath(path, key), *element.as_table());
+        }
+    }
+}
+
+void WriteTomlNamedTable(std::ostream& out, const std::string& name, const toml::table& tbl, const std::vector<std::string>& orderedKeys) {
+    out << "\n[" << name << "]\n";
+    WriteTomlTableOrdered(out, tbl, orderedKeys, name);
+}
+
+void WriteTomlArrayTableEntry(std::ostream& out, const std::string& name, const toml::table& tbl,
+                              const std::vector<std::string>& orderedKeys) {
+    out << "\n[[" << name << "]]\n";
+    WriteTomlTableOrdered(out, tbl, orderedKeys, name);
+}
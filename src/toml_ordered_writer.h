@@ -0,0 +1,28 @@
+#pragma once
+
+#include "toml.hpp"
+#include <ostream>
+#include <string>
+#include <vector>
+
+// Streaming TOML emission that keeps a chosen key order. toml++ prints a table's keys alphabetically and moves every
+// nested table to a header of its own; config.toml instead lists an item's fields in converter order with small
+// tables inline, so user configs don't churn between saves. Platform-neutral.
+//
+// Layout rules: scalars, arrays and inline tables are written as `key = value` lines in `orderedKeys` order, then any
+// keys the order doesn't list (fields added to a converter, or unknown to this version, are never dropped). Tables
+// not marked inline, and arrays of such tables, follow as [path.key] / [[path.key]] sections, since TOML allows no
+// plain key after a sub-table header.
+
+// Writes the body of `tbl`, whose own header (if any) has already been written; `path` is that header's dotted name
+// ("" at the document root)
+void WriteTomlTableOrdered(std::ostream& out, const toml::table& tbl, const std::vector<std::string>& orderedKeys,
+                           const std::string& path = "");
+
+// Writes "[name]" followed by the table
+void WriteTomlNamedTable(std::ostream& out, const std::string& name, const toml::table& tbl,
+                         const std::vector<std::string>& orderedKeys = {});
+
+// Writes one "[[name]]" entry of an array of tables
+void WriteTomlArrayTableEntry(std::ostream& out, const std::string& name, const toml::table& tbl,
+                              const std::vector<std::string>& orderedKeys = {});
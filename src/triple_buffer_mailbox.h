@@ -0,0 +1,169 @@
+#pragma once
+
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <climits>
+#include <cstdint>
+#include <thread>
+#include <type_traits>
+
+#if defined(_WIN32)
+#ifndef NOMINMAX
+#define NOMINMAX
+#endif
+#include <Windows.h> // WaitOnAddress / WakeByAddressAll (link Synchronization.lib)
+#elif defined(__linux__)
+#include <linux/futex.h>
+#include <sys/syscall.h>
+#include <time.h>
+#include <unistd.h>
+#endif
+
+#if defined(_M_X64) || defined(_M_IX86) || defined(__x86_64__) || defined(__i386__)
+#include <immintrin.h>
+#define TBM_CPU_RELAX() _mm_pause()
+#else
+#define TBM_CPU_RELAX() std::this_thread::yield()
+#endif
+
+// Single-producer / single-consumer "latest value" mailbox (triple buffer). Header-only, platform-neutral.
+//
+// - The producer always writes into a slot it owns exclusively, then swaps it with the shared middle slot; the
+//   consumer swaps the middle slot with the one it owns. Neither side ever blocks, and a message is never written
+//   while the other side can read it (no tearing).
+// - Publishing over a message the consumer hasn't taken yet replaces it; the replaced value is handed back to the
+//   producer so it can release what it owned.
+// - Every message carries a sequence number (1, 2, ...) and the caller's publish timestamp for latency stats.
+// - T must be trivially copyable: publishing is a plain copy, no allocation.
+template <typename T> class TripleBufferMailbox {
+    static_assert(std::is_trivially_copyable_v<T>, "TripleBufferMailbox messages must be trivially copyable");
+
+  public:
+    struct Message {
+        T value{};
+        uint64_t sequence = 0;
+        int64_t publishedNs = 0;
+    };
+
+    // Producer. Returns true if an unconsumed message was replaced (copied to *replaced when non-null).
+    bool Publish(const T& value, int64_t nowNs, T* replaced = nullptr) {
+        Message& slot = m_slots[m_writeIndex].message;
+        slot.value = value;
+        slot.sequence = ++m_published;
+        slot.publishedNs = nowNs;
+
+        const uint8_t previous = m_middle.exchange(static_cast<uint8_t>(m_writeIndex | kFreshBit), std::memory_order_acq_rel);
+        m_writeIndex = previous & kIndexMask;
+        const bool wasFresh = (previous & kFreshBit) != 0;
+        if (wasFresh && replaced) { *replaced = m_slots[m_writeIndex].message.value; }
+        return wasFresh;
+    }
+
+    // Consumer. Newest message not taken yet, or nullptr. Valid until the next TryTake().
+    const Message* TryTake() {
+        if ((m_middle.load(std::memory_order_relaxed) & kFreshBit) == 0) { return nullptr; }
+        const uint8_t previous = m_middle.exchange(m_readIndex, std::memory_order_acq_rel);
+        m_readIndex = previous & kIndexMask;
+        return &m_slots[m_readIndex].message;
+    }
+
+    // Either side. True if a message is waiting for the consumer.
+    bool HasPending() const { return (m_middle.load(std::memory_order_acquire) & kFreshBit) != 0; }
+
+    // Producer side: sequence number of the last Publish()
+    uint64_t PublishedSequence() const { return m_published; }
+
+    // Neither side may be running. Discards an unconsumed message (copied to *dropped when non-null) and returns
+    // whether there was one. Sequence numbers keep counting from where they were.
+    bool Reset(T* dropped = nullptr) {
+        const bool wasFresh = (m_middle.load(std::memory_order_acquire) & kFreshBit) != 0;
+        if (wasFresh && dropped) { *dropped = m_slots[m_middle.load(std::memory_order_relaxed) & kIndexMask].message.value; }
+        m_middle.store(1, std::memory_order_release);
+        m_writeIndex = 0;
+        m_readIndex = 2;
+        return wasFresh;
+    }
+
+  private:
+    static constexpr uint8_t kIndexMask = 0x3;
+    static constexpr uint8_t kFreshBit = 0x4;
+
+    struct alignas(64) Slot {
+        Message message;
+    };
+
+    Slot m_slots[3];
+    alignas(64) std::atomic<uint8_t> m_middle{ 1 };
+    alignas(64) uint8_t m_writeIndex = 0; // Producer-owned
+    uint64_t m_published = 0;
+    alignas(64) uint8_t m_readIndex = 2; // Consumer-owned
+};
+
+// Event counter a thread can block on. Notify() bumps it; WaitChange() spins briefly, then sleeps in the kernel
+// (futex on Linux, WaitOnAddress on Windows) until the counter moves or the time budget runs out.
+// Notify() only makes a wake syscall when someone is actually sleeping.
+class WaitableSequence {
+  public:
+    static constexpr int kDefaultSpins = 256; // ~a few microseconds of pause instructions
+
+    uint32_t Load() const { return m_value.load(std::memory_order_acquire); }
+
+    void Notify() {
+        m_value.fetch_add(1, std::memory_order_seq_cst);
+        if (m_sleepers.load(std::memory_order_seq_cst) != 0) { WakeAll(); }
+    }
+
+    // Returns true once the counter differs from `seen`, false if `budget` elapsed first
+    bool WaitChange(uint32_t seen, std::chrono::nanoseconds budget, int spins = kDefaultSpins) {
+        for (int i = 0; i < spins; ++i) {
+            if (m_value.load(std::memory_order_acquire) != seen) { return true; }
+            TBM_CPU_RELAX();
+        }
+
+        const auto deadline = std::chrono::steady_clock::now() + budget;
+        for (;;) {
+            const auto remaining = deadline - std::chrono::steady_clock::now();
+            if (remaining <= std::chrono::nanoseconds::zero()) { return m_value.load(std::memory_order_acquire) != seen; }
+
+            m_sleepers.fetch_add(1, std::memory_order_seq_cst);
+            if (m_value.load(std::memory_order_seq_cst) == seen) {
+                SleepWhileEqual(seen, std::chrono::duration_cast<std::chrono::nanoseconds>(remaining));
+            }
+            m_sleepers.fetch_sub(1, std::memory_order_relaxed);
+
+            if (m_value.load(std::memory_order_acquire) != seen) { return true; }
+        }
+    }
+
+  private:
+    void SleepWhileEqual(uint32_t seen, std::chrono::nanoseconds timeout) {
+#if defined(_WIN32)
+        // Millisecond granularity; round up so short budgets still sleep instead of spinning
+        const DWORD ms = static_cast<DWORD>((timeout.count() + 999999) / 1000000);
+        WaitOnAddress(&m_value, &seen, sizeof(seen), ms);
+#elif defined(__linux__)
+        static_assert(sizeof(std::atomic<uint32_t>) == sizeof(uint32_t), "futex word must be a plain 32-bit integer");
+        timespec ts;
+        ts.tv_sec = static_cast<time_t>(timeout.count() / 1000000000);
+        ts.tv_nsec = static_cast<long>(timeout.count() % 1000000000);
+        syscall(SYS_futex, reinterpret_cast<uint32_t*>(&m_value), FUTEX_WAIT_PRIVATE, seen, &ts, nullptr, 0);
+#else
+        (void)seen;
+        std::this_thread::sleep_for((std::min)(timeout, std::chrono::nanoseconds(std::chrono::microseconds(500))));
+#endif
+    }
+
+    void WakeAll() {
+#if defined(_WIN32)
+        WakeByAddressAll(&m_value);
+#elif defined(__linux__)
+        syscall(SYS_futex, reinterpret_cast<uint32_t*>(&m_value), FUTEX_WAKE_PRIVATE, INT_MAX, nullptr, nullptr, 0);
+#endif
+    }
+
+    std::atomic<uint32_t> m_value{ 0 };
+    std::atomic<uint32_t> m_sleepers{ 0 };
+};
+
+#undef TBM_CPU_RELAX
@@ -0,0 +1,372 @@
+#include "truetype_font.h"
+
+#include <algorithm>
+#include <cstring>
+
+namespace {
+
+uint16_t ReadU16(const std::string& data, size_t offset) {
+    if (offset + 2 > data.size()) return 0;
+    return static_cast<uint16_t>((static_cast<uint8_t>(data[offset]) << 8) | static_cast<uint8_t>(data[offset + 1]));
+}
+
+int16_t ReadS16(const std::string& data, size_t offset) { return static_cast<int16_t>(ReadU16(data, offset)); }
+
+uint32_t ReadU32(const std::string& data, size_t offset) {
+    return (static_cast<uint32_t>(ReadU16(data, offset)) << 16) | ReadU16(data, offset + 2);
+}
+
+void AppendU16(std::string& out, uint32_t v) {
+    out.push_back(static_cast<char>((v >> 8) & 0xFFu));
+    out.push_back(static_cast<char>(v & 0xFFu));
+}
+
+void AppendU32(std::string& out, uint32_t v) {
+    AppendU16(out, v >> 16);
+    AppendU16(out, v & 0xFFFFu);
+}
+
+void PutU16(std::string& data, size_t offset, uint32_t v) {
+    data[offset] = static_cast<char>((v >> 8) & 0xFFu);
+    data[offset + 1] = static_cast<char>(v & 0xFFu);
+}
+
+void PutU32(std::string& data, size_t offset, uint32_t v) {
+    PutU16(data, offset, v >> 16);
+    PutU16(data, offset + 2, v & 0xFFFFu);
+}
+
+uint32_t TableChecksum(const std::string& data, size_t offset, size_t length) {
+    uint32_t sum = 0;
+    for (size_t i = 0; i < length; i += 4) {
+        uint32_t word = 0;
+        for (size_t b = 0; b < 4; ++b) {
+            word <<= 8;
+            if (i + b < length) word |= static_cast<uint8_t>(data[offset + i + b]);
+        }
+        sum += word;
+    }
+    return sum;
+}
+
+// Composite glyph flags (glyf table)
+constexpr uint16_t kArgsAreWords = 0x0001;
+constexpr uint16_t kHaveScale = 0x0008;
+constexpr uint16_t kMoreComponents = 0x0020;
+constexpr uint16_t kHaveXYScale = 0x0040;
+constexpr uint16_t kHaveTwoByTwo = 0x0080;
+
+} // namespace
+
+bool TrueTypeFont::FindTable(uint32_t directoryOffset, const char* tag, Table& out) const {
+    const uint16_t numTables = ReadU16(m_data, directoryOffset + 4);
+    for (uint16_t i = 0; i < numTables; ++i) {
+        const size_t record = directoryOffset + 12 + static_cast<size_t>(i) * 16;
+        if (record + 16 > m_data.size()) return false;
+        if (std::memcmp(m_data.data() + record, tag, 4) != 0) continue;
+        // `out` is only written for a table that lies inside the file; optional tables keep their defaults otherwise
+        const uint32_t offset = ReadU32(m_data, record + 8);
+        const uint32_t length = ReadU32(m_data, record + 12);
+        if (static_cast<uint64_t>(offset) + length > m_data.size()) return false;
+        out.offset = offset;
+        out.length = length;
+        return true;
+    }
+    return false;
+}
+
+bool TrueTypeFont::Load(std::string fileData) {
+    *this = TrueTypeFont();
+    m_data = std::move(fileData);
+    if (m_data.size() < 12) return false;
+
+    uint32_t directory = 0;
+    if (std::memcmp(m_data.data(), "ttcf", 4) == 0) { directory = ReadU32(m_data, 12); }
+    const uint32_t version = ReadU32(m_data, directory);
+    if (version != 0x00010000u && version != 0x74727565u /* 'true' */) return false;
+
+    if (!FindTable(directory, "head", m_head) || !FindTable(directory, "hhea", m_hhea) || !FindTable(directory, "maxp", m_maxp) ||
+        !FindTable(directory, "hmtx", m_hmtx) || !FindTable(directory, "loca", m_loca) || !FindTable(directory, "glyf", m_glyf)) {
+        return false;
+    }
+    if (m_head.length < 54 || m_hhea.length < 36 || m_maxp.length < 6) return false;
+    FindTable(directory, "cvt ", m_cvt);
+    FindTable(directory, "fpgm", m_fpgm);
+    FindTable(directory, "prep", m_prep);
+
+    m_unitsPerEm = std::max<uint16_t>(16, ReadU16(m_data, m_head.offset + 18));
+    for (int i = 0; i < 4; ++i) { m_bbox[i] = ReadS16(m_data, m_head.offset + 36 + i * 2); }
+    m_longLoca = ReadS16(m_data, m_head.offset + 50) != 0;
+    m_ascent = ReadS16(m_data, m_hhea.offset + 4);
+    m_descent = ReadS16(m_data, m_hhea.offset + 6);
+    m_numberOfHMetrics = ReadU16(m_data, m_hhea.offset + 34);
+    const uint16_t numGlyphs = ReadU16(m_data, m_maxp.offset + 4);
+    if (numGlyphs == 0 || m_numberOfHMetrics == 0 || m_numberOfHMetrics > numGlyphs) return false;
+    if (m_hmtx.length < static_cast<uint32_t>(m_numberOfHMetrics) * 4) return false;
+    if (m_loca.length < (static_cast<uint32_t>(numGlyphs) + 1) * (m_longLoca ? 4u : 2u)) return false;
+
+    m_capHeight = static_cast<int16_t>(m_ascent * 7 / 10);
+    Table os2;
+    if (FindTable(directory, "OS/2", os2) && os2.length >= 90 && ReadU16(m_data, os2.offset) >= 2) {
+        m_capHeight = ReadS16(m_data, os2.offset + 88);
+    }
+    Table post;
+    if (FindTable(directory, "post", post) && post.length >= 16) {
+        m_italicAngle = static_cast<float>(static_cast<int32_t>(ReadU32(m_data, post.offset + 4))) / 65536.0f;
+        m_fixedPitch = ReadU32(m_data, post.offset + 12) != 0;
+    }
+    Table name;
+    if (FindTable(directory, "name", name)) { ReadPostScriptName(name); }
+    if (m_postScriptName.empty()) m_postScriptName = "EmbeddedFont";
+
+    // Prefer a full-Unicode (format 12) subtable, else the BMP one (format 4)
+    Table cmap;
+    if (!FindTable(directory, "cmap", cmap)) return false;
+    const uint16_t numSubtables = ReadU16(m_data, cmap.offset + 2);
+    for (uint16_t i = 0; i < numSubtables; ++i) {
+        const size_t record = cmap.offset + 4 + static_cast<size_t>(i) * 8;
+        const uint16_t platform = ReadU16(m_data, record);
+        const uint16_t encoding = ReadU16(m_data, record + 2);
+        const uint32_t subtable = cmap.offset + ReadU32(m_data, record + 4);
+        if (subtable + 4 > cmap.offset + cmap.length) continue;
+        const bool unicode = platform == 0 || (platform == 3 && (encoding == 1 || encoding == 10));
+        if (!unicode) continue;
+        const uint16_t format = ReadU16(m_data, subtable);
+        if (format == 12) {
+            m_cmapSubtable = subtable;
+            m_cmapFormat = 12;
+            break;
+        }
+        if (format == 4 && m_cmapFormat != 4) {
+            m_cmapSubtable = subtable;
+            m_cmapFormat = 4;
+        }
+    }
+    if (m_cmapFormat == 0) return false;
+
+    m_numGlyphs = numGlyphs;
+    return true;
+}
+
+void TrueTypeFont::ReadPostScriptName(const Table& name) {
+    const uint16_t count = ReadU16(m_data, name.offset + 2);
+    const uint32_t strings = name.offset + ReadU16(m_data, name.offset + 4);
+    for (uint16_t i = 0; i < count; ++i) {
+        const size_t record = name.offset + 6 + static_cast<size_t>(i) * 12;
+        if (record + 12 > name.offset + name.length) break;
+        const uint16_t platform = ReadU16(m_data, record);
+        const uint16_t nameId = ReadU16(m_data, record + 6);
+        if (nameId != 6 || (platform != 1 && platform != 3)) continue;
+        const uint16_t length = ReadU16(m_data, record + 8);
+        const uint32_t start = strings + ReadU16(m_data, record + 10);
+        if (static_cast<uint64_t>(start) + length > m_data.size()) continue;
+
+        // Windows names are UTF-16BE; PostScript names are printable ASCII either way
+        std::string result;
+        const size_t step = platform == 3 ? 2 : 1;
+        for (size_t pos = 0; pos + step <= length; pos += step) {
+            const unsigned char c = static_cast<unsigned char>(m_data[start + pos + step - 1]);
+            if ((c >= '0' && c <= '9') || (c >= 'A' && c <= 'Z') || (c >= 'a' && c <= 'z') || c == '-' || c == '_') {
+                result.push_back(static_cast<char>(c));
+            }
+        }
+        if (!result.empty()) {
+            m_postScriptName = result.substr(0, 63);
+            return;
+        }
+    }
+}
+
+uint16_t TrueTypeFont::GlyphForCodepoint(uint32_t codepoint) const {
+    if (m_cmapFormat == 12) {
+        const uint32_t groups = ReadU32(m_data, m_cmapSubtable + 12);
+        size_t lo = 0;
+        size_t hi = groups;
+        while (lo < hi) {
+            const size_t mid = (lo + hi) / 2;
+            const size_t group = m_cmapSubtable + 16 + mid * 12;
+            const uint32_t start = ReadU32(m_data, group);
+            const uint32_t end = ReadU32(m_data, group + 4);
+            if (codepoint < start) {
+                hi = mid;
+            } else if (codepoint > end) {
+                lo = mid + 1;
+            } else {
+                const uint32_t glyph = ReadU32(m_data, group + 8) + (codepoint - start);
+                return glyph < m_numGlyphs ? static_cast<uint16_t>(glyph) : 0;
+            }
+        }
+        return 0;
+    }
+
+    if (m_cmapFormat != 4 || codepoint > 0xFFFF) return 0;
+    const size_t segCount = ReadU16(m_data, m_cmapSubtable + 6) / 2;
+    const size_t endCodes = m_cmapSubtable + 14;
+    const size_t startCodes = endCodes + segCount * 2 + 2;
+    const size_t idDeltas = startCodes + segCount * 2;
+    const size_t idRangeOffsets = idDeltas + segCount * 2;
+
+    size_t lo = 0;
+    size_t hi = segCount;
+    while (lo < hi) {
+        const size_t mid = (lo + hi) / 2;
+        if (ReadU16(m_data, endCodes + mid * 2) < codepoint) {
+            lo = mid + 1;
+        } else {
+            hi = mid;
+        }
+    }
+    if (lo >= segCount) return 0;
+    const uint16_t start = ReadU16(m_data, startCodes + lo * 2);
+    if (codepoint < start) return 0;
+
+    const uint16_t delta = ReadU16(m_data, idDeltas + lo * 2);
+    const uint16_t rangeOffset = ReadU16(m_data, idRangeOffsets + lo * 2);
+    uint16_t glyph = 0;
+    if (rangeOffset == 0) {
+        glyph = static_cast<uint16_t>(codepoint + delta);
+    } else {
+        const size_t glyphAddress = idRangeOffsets + lo * 2 + rangeOffset + (codepoint - start) * 2;
+        glyph = ReadU16(m_data, glyphAddress);
+        if (glyph != 0) glyph = static_cast<uint16_t>(glyph + delta);
+    }
+    return glyph < m_numGlyphs ? glyph : 0;
+}
+
+uint16_t TrueTypeFont::AdvanceWidth(uint16_t glyph) const {
+    if (m_numberOfHMetrics == 0) return 0;
+    const uint16_t metric = std::min<uint16_t>(glyph, static_cast<uint16_t>(m_numberOfHMetrics - 1));
+    return ReadU16(m_data, m_hmtx.offset + static_cast<size_t>(metric) * 4);
+}
+
+bool TrueTypeFont::GlyphRange(uint16_t glyph, uint32_t& start, uint32_t& end) const {
+    if (glyph >= m_numGlyphs) return false;
+    if (m_longLoca) {
+        start = ReadU32(m_data, m_loca.offset + static_cast<size_t>(glyph) * 4);
+        end = ReadU32(m_data, m_loca.offset + static_cast<size_t>(glyph) * 4 + 4);
+    } else {
+        start = static_cast<uint32_t>(ReadU16(m_data, m_loca.offset + static_cast<size_t>(glyph) * 2)) * 2;
+        end = static_cast<uint32_t>(ReadU16(m_data, m_loca.offset + static_cast<size_t>(glyph) * 2 + 2)) * 2;
+    }
+    return start <= end && end <= m_glyf.length;
+}
+
+bool TrueTypeFont::BuildSubset(const std::vector<uint16_t>& usedGlyphs, std::string& out) const {
+    out.clear();
+    if (!IsLoaded()) return false;
+
+    // Close over composite glyph components
+    std::vector<uint8_t> keep(m_numGlyphs, 0);
+    std::vector<uint16_t> pending(usedGlyphs.begin(), usedGlyphs.end());
+    pending.push_back(0);
+    while (!pending.empty()) {
+        const uint16_t glyph = pending.back();
+        pending.pop_back();
+        if (glyph >= m_numGlyphs || keep[glyph]) continue;
+        keep[glyph] = 1;
+
+        uint32_t start = 0;
+        uint32_t end = 0;
+        if (!GlyphRange(glyph, start, end) || end - start < 10) continue;
+        const size_t base = m_glyf.offset + start;
+        if (ReadS16(m_data, base) >= 0) continue;
+
+        size_t pos = base + 10;
+        const size_t limit = m_glyf.offset + end;
+        while (pos + 4 <= limit) {
+            const uint16_t flags = ReadU16(m_data, pos);
+            pending.push_back(ReadU16(m_data, pos + 2));
+            pos += 4 + ((flags & kArgsAreWords) ? 4 : 2);
+            if (flags & kHaveScale) {
+                pos += 2;
+            } else if (flags & kHaveXYScale) {
+                pos += 4;
+            } else if (flags & kHaveTwoByTwo) {
+                pos += 8;
+            }
+            if (!(flags & kMoreComponents)) break;
+        }
+    }
+
+    // Glyph ids past the last kept one are dropped entirely; the rest keep their slot with an empty outline
+    uint16_t glyphCount = m_numGlyphs;
+    while (glyphCount > 1 && !keep[glyphCount - 1]) {
+        --glyphCount;
+    }
+
+    std::string glyf;
+    std::string loca;
+    for (uint16_t glyph = 0; glyph < glyphCount; ++glyph) {
+        AppendU32(loca, static_cast<uint32_t>(glyf.size()));
+        uint32_t start = 0;
+        uint32_t end = 0;
+        if (!keep[glyph] || !GlyphRange(glyph, start, end)) continue;
+        glyf.append(m_data, m_glyf.offset + start, end - start);
+        while (glyf.size() % 4 != 0) {
+            glyf.push_back('\0');
+        }
+    }
+    AppendU32(loca, static_cast<uint32_t>(glyf.size()));
+
+    // hmtx keeps its layout: full metrics for the first numberOfHMetrics glyphs, then left side bearings only
+    const uint16_t hMetrics = std::min(m_numberOfHMetrics, glyphCount);
+    const size_t hmtxLength = static_cast<size_t>(hMetrics) * 4 + static_cast<size_t>(glyphCount - hMetrics) * 2;
+    if (hmtxLength > m_hmtx.length) return false;
+
+    std::string head = m_data.substr(m_head.offset, m_head.length);
+    PutU32(head, 8, 0);  // checkSumAdjustment, set below
+    PutU16(head, 50, 1); // indexToLocFormat: long offsets
+    std::string hhea = m_data.substr(m_hhea.offset, m_hhea.length);
+    PutU16(hhea, 34, hMetrics);
+    std::string maxp = m_data.substr(m_maxp.offset, m_maxp.length);
+    PutU16(maxp, 4, glyphCount);
+
+    struct OutTable {
+        const char* tag;
+        std::string data;
+    };
+    std::vector<OutTable> tables;
+    if (m_cvt.length > 0) tables.push_back({ "cvt ", m_data.substr(m_cvt.offset, m_cvt.length) });
+    if (m_fpgm.length > 0) tables.push_back({ "fpgm", m_data.substr(m_fpgm.offset, m_fpgm.length) });
+    tables.push_back({ "glyf", std::move(glyf) });
+    tables.push_back({ "head", std::move(head) });
+    tables.push_back({ "hhea", std::move(hhea) });
+    tables.push_back({ "hmtx", m_data.substr(m_hmtx.offset, hmtxLength) });
+    tables.push_back({ "loca", std::move(loca) });
+    tables.push_back({ "maxp", std::move(maxp) });
+    if (m_prep.length > 0) tables.push_back({ "prep", m_data.substr(m_prep.offset, m_prep.length) });
+
+    const uint16_t numTables = static_cast<uint16_t>(tables.size());
+    uint16_t entrySelector = 0;
+    while ((2u << entrySelector) <= numTables) {
+        ++entrySelector;
+    }
+    const uint16_t searchRange = static_cast<uint16_t>((1u << entrySelector) * 16);
+
+    AppendU32(out, 0x00010000u);
+    AppendU16(out, numTables);
+    AppendU16(out, searchRange);
+    AppendU16(out, entrySelector);
+    AppendU16(out, static_cast<uint32_t>(numTables) * 16 - searchRange);
+
+    // Directory entries (already sorted by tag), then the 4-byte aligned table data
+    size_t offset = 12 + static_cast<size_t>(numTables) * 16;
+    size_t headOffset = 0;
+    for (const OutTable& table : tables) {
+        out.append(table.tag, 4);
+        AppendU32(out, TableChecksum(table.data, 0, table.data.size()));
+        AppendU32(out, static_cast<uint32_t>(offset));
+        AppendU32(out, static_cast<uint32_t>(table.data.size()));
+        if (std::memcmp(table.tag, "head", 4) == 0) headOffset = offset;
+        offset += (table.data.size() + 3) & ~static_cast<size_t>(3);
+    }
+    for (const OutTable& table : tables) {
+        out += table.data;
+        while (out.size() % 4 != 0) {
+            out.push_back('\0');
+        }
+    }
+
+    PutU32(out, headOffset + 8, 0xB1B0AFBAu - TableChecksum(out, 0, out.size()));
+    return true;
+}
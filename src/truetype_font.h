@@ -0,0 +1,60 @@
+#pragma once
+
+#include <cstdint>
+#include <string>
+#include <vector>
+
+// Minimal reader for TrueType (glyf outline) fonts, enough to embed them in exported PDFs: character to glyph
+// lookup, advance widths, the metrics a PDF font descriptor needs, and glyph subsetting. Platform-neutral.
+class TrueTypeFont {
+  public:
+    // Parses a .ttf, or the first font of a .ttc collection. CFF-flavored OpenType (.otf) fonts are rejected.
+    bool Load(std::string fileData);
+    bool IsLoaded() const { return m_numGlyphs > 0; }
+
+    uint16_t GlyphForCodepoint(uint32_t codepoint) const; // 0 (.notdef) when the font has no glyph for it
+    uint16_t AdvanceWidth(uint16_t glyph) const;          // Font units
+    uint16_t UnitsPerEm() const { return m_unitsPerEm; }
+    uint16_t GlyphCount() const { return m_numGlyphs; }
+
+    // Font-unit metrics for the PDF font descriptor
+    int16_t Ascent() const { return m_ascent; }
+    int16_t Descent() const { return m_descent; }
+    int16_t CapHeight() const { return m_capHeight; }
+    const int16_t* BoundingBox() const { return m_bbox; } // xMin, yMin, xMax, yMax
+    float ItalicAngle() const { return m_italicAngle; }
+    bool IsFixedPitch() const { return m_fixedPitch; }
+    const std::string& PostScriptName() const { return m_postScriptName; }
+
+    // A standalone font program with only `usedGlyphs` (plus .notdef and the components of composite glyphs) keeping
+    // their outlines. Glyph ids don't change, so text encoded against the full font renders the same. Only the
+    // tables a PDF reader needs are written (no cmap, name or post).
+    bool BuildSubset(const std::vector<uint16_t>& usedGlyphs, std::string& out) const;
+
+  private:
+    struct Table {
+        uint32_t offset = 0;
+        uint32_t length = 0;
+    };
+
+    bool FindTable(uint32_t directoryOffset, const char* tag, Table& out) const;
+    bool GlyphRange(uint16_t glyph, uint32_t& start, uint32_t& end) const;
+    void ReadPostScriptName(const Table& name);
+
+    std::string m_data;
+    Table m_head, m_hhea, m_maxp, m_hmtx, m_loca, m_glyf, m_cvt, m_fpgm, m_prep;
+    uint32_t m_cmapSubtable = 0; // Absolute offset of the chosen Unicode cmap subtable
+    uint16_t m_cmapFormat = 0;   // 4 or 12
+
+    uint16_t m_numGlyphs = 0;
+    uint16_t m_numberOfHMetrics = 0;
+    uint16_t m_unitsPerEm = 1000;
+    bool m_longLoca = false;
+    int16_t m_ascent = 0;
+    int16_t m_descent = 0;
+    int16_t m_capHeight = 0;
+    int16_t m_bbox[4] = { 0, 0, 0, 0 };
+    float m_italicAngle = 0.0f;
+    bool m_fixedPitch = false;
+    std::string m_postScriptName;
+};
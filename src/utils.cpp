@@ -1,5 +1,8 @@
 #include "utils.h"
+#include "deflate.h"
 #include "gui.h"
+#include "image_decode.h"
+#include "log_rotation.h"
 #include "logic_thread.h"
 #include "profiler.h"
 
@@ -8,7 +11,6 @@
 #include <ShlObj.h>
 #include <Shlwapi.h>
 #include <algorithm>
-#include <array>
 #include <cctype>
 #include <csignal>
 #include <cstdint>
@@ -179,352 +181,19 @@ extern "C" void abort() {
 }
 #endif
 
-std::string GetTimestamp() {
-    auto now = std::chrono::system_clock::now();
-    auto time_t = std::chrono::system_clock::to_time_t(now);
-    auto ms = std::chrono::duration_cast<std::chrono::milliseconds>(now.time_since_epoch()) % 1000;
-
-    struct tm timeinfo;
-    localtime_s(&timeinfo, &time_t);
-
-    std::stringstream ss;
-    ss << std::put_time(&timeinfo, "%H:%M:%S");
-    ss << '.' << std::setfill('0') << std::setw(3) << ms.count();
-    return ss.str();
-}
-
-// ============================================================================
-// GZIP LOG COMPRESSION
-// In-process gzip writer with real DEFLATE compression.
-// Uses a compact fixed-Huffman encoder + LZ77 matcher, no external tools.
-// ============================================================================
-
-static uint32_t g_crc32Table[256];
-static std::once_flag g_crc32InitFlag;
-
-static void InitCrc32Table() {
-    std::call_once(g_crc32InitFlag, []() {
-        for (uint32_t i = 0; i < 256; i++) {
-            uint32_t c = i;
-            for (int j = 0; j < 8; j++) { c = (c & 1u) ? ((c >> 1) ^ 0xEDB88320u) : (c >> 1); }
-            g_crc32Table[i] = c;
-        }
-    });
-}
-
-static uint32_t Crc32(const uint8_t* data, size_t size) {
-    InitCrc32Table();
-    uint32_t crc = 0xFFFFFFFFu;
-    for (size_t i = 0; i < size; i++) { crc = g_crc32Table[(crc ^ data[i]) & 0xFFu] ^ (crc >> 8); }
-    return crc ^ 0xFFFFFFFFu;
-}
-
-static bool FileExistsW(const std::wstring& path) {
-    DWORD attrs = GetFileAttributesW(path.c_str());
-    return (attrs != INVALID_FILE_ATTRIBUTES) && ((attrs & FILE_ATTRIBUTE_DIRECTORY) == 0);
-}
-
-static bool ReadFileBytes(const std::wstring& path, std::vector<uint8_t>& out) {
-    std::ifstream in(path, std::ios::binary | std::ios::ate);
-    if (!in.is_open()) return false;
-
-    std::streamoff size = in.tellg();
-    if (size < 0) return false;
-    in.seekg(0, std::ios::beg);
-
-    out.resize(static_cast<size_t>(size));
-    if (!out.empty()) {
-        in.read(reinterpret_cast<char*>(out.data()), static_cast<std::streamsize>(out.size()));
-        if (in.bad() || static_cast<size_t>(in.gcount()) != out.size()) return false;
-    }
-    return true;
-}
-
-static void WriteLE32(std::ofstream& out, uint32_t v) {
-    uint8_t b[4] = { (uint8_t)(v & 0xFFu), (uint8_t)((v >> 8) & 0xFFu), (uint8_t)((v >> 16) & 0xFFu), (uint8_t)((v >> 24) & 0xFFu) };
-    out.write(reinterpret_cast<const char*>(b), 4);
-}
-
-static uint16_t ReverseBits(uint16_t v, uint8_t bitCount) {
-    uint16_t r = 0;
-    for (uint8_t i = 0; i < bitCount; i++) {
-        r = static_cast<uint16_t>((r << 1) | (v & 1u));
-        v >>= 1;
-    }
-    return r;
-}
-
-struct HuffCode {
-    uint16_t code = 0; // bit-reversed for LSB-first bitstream writer
-    uint8_t bits = 0;
-};
-
-struct BitWriter {
-    std::vector<uint8_t> bytes;
-    uint32_t bitBuffer = 0;
-    int bitCount = 0;
-
-    void WriteBits(uint32_t value, int count) {
-        bitBuffer |= ((value & ((1u << count) - 1u)) << bitCount);
-        bitCount += count;
-        while (bitCount >= 8) {
-            bytes.push_back(static_cast<uint8_t>(bitBuffer & 0xFFu));
-            bitBuffer >>= 8;
-            bitCount -= 8;
-        }
-    }
-
-    void FlushToByteBoundary() {
-        if (bitCount > 0) {
-            bytes.push_back(static_cast<uint8_t>(bitBuffer & 0xFFu));
-            bitBuffer = 0;
-            bitCount = 0;
-        }
-    }
-};
-
-static void BuildCanonicalCodes(const uint8_t* lengths, size_t count, std::vector<HuffCode>& out) {
-    out.assign(count, {});
-
-    int blCount[16] = { 0 };
-    for (size_t i = 0; i < count; i++) {
-        if (lengths[i] > 0 && lengths[i] <= 15) blCount[lengths[i]]++;
-    }
-
-    int nextCode[16] = { 0 };
-    int code = 0;
-    for (int bits = 1; bits <= 15; bits++) {
-        code = (code + blCount[bits - 1]) << 1;
-        nextCode[bits] = code;
-    }
-
-    for (size_t symbol = 0; symbol < count; symbol++) {
-        uint8_t len = lengths[symbol];
-        if (len == 0) continue;
-        uint16_t c = static_cast<uint16_t>(nextCode[len]++);
-        out[symbol].bits = len;
-        out[symbol].code = ReverseBits(c, len);
-    }
-}
-
-static std::once_flag g_fixedCodesInitFlag;
-static std::vector<HuffCode> g_fixedLitLenCodes;
-static std::vector<HuffCode> g_fixedDistCodes;
-
-static void InitFixedCodes() {
-    std::call_once(g_fixedCodesInitFlag, []() {
-        std::array<uint8_t, 288> ll{};
-        for (int i = 0; i <= 143; i++) ll[i] = 8;
-        for (int i = 144; i <= 255; i++) ll[i] = 9;
-        for (int i = 256; i <= 279; i++) ll[i] = 7;
-        for (int i = 280; i <= 287; i++) ll[i] = 8;
-        BuildCanonicalCodes(ll.data(), ll.size(), g_fixedLitLenCodes);
-
-        std::array<uint8_t, 32> dd{};
-        dd.fill(5);
-        BuildCanonicalCodes(dd.data(), dd.size(), g_fixedDistCodes);
-    });
-}
-
-struct DeflateToken {
-    bool isMatch = false;
-    uint16_t literal = 0;
-    uint16_t length = 0;
-    uint16_t distance = 0;
-};
-
-static std::vector<DeflateToken> BuildLz77Tokens(const std::vector<uint8_t>& data) {
-    std::vector<DeflateToken> tokens;
-    tokens.reserve(data.size());
-
-    const size_t n = data.size();
-    size_t i = 0;
-    while (i < n) {
-        size_t bestLen = 0;
-        size_t bestDist = 0;
-
-        if (i + 3 <= n) {
-            const size_t windowStart = (i > 32768) ? (i - 32768) : 0;
-            size_t attempts = 0;
-
-            for (size_t j = i; j > windowStart && attempts < 2048;) {
-                --j;
-                if (data[j] != data[i]) continue;
-
-                const size_t maxLen = std::min<size_t>(258, n - i);
-                size_t len = 1;
-                while (len < maxLen && data[j + len] == data[i + len]) len++;
-
-                if (len >= 3 && len > bestLen) {
-                    bestLen = len;
-                    bestDist = i - j;
-                    if (len == 258) break;
-                }
-                attempts++;
-            }
-        }
-
-        if (bestLen >= 3) {
-            DeflateToken t;
-            t.isMatch = true;
-            t.length = static_cast<uint16_t>(bestLen);
-            t.distance = static_cast<uint16_t>(bestDist);
-            tokens.push_back(t);
-            i += bestLen;
-        } else {
-            DeflateToken t;
-            t.isMatch = false;
-            t.literal = data[i];
-            tokens.push_back(t);
-            i++;
-        }
-    }
-
-    return tokens;
-}
-
-static bool EncodeLength(uint16_t length, int& outCode, int& outExtraBits, int& outExtraValue) {
-    static const int kLenBase[29] = { 3,  4,  5,  6,  7,  8,  9,  10, 11,  13,  15,  17,  19,  23, 27,
-                                      31, 35, 43, 51, 59, 67, 83, 99, 115, 131, 163, 195, 227, 258 };
-    static const int kLenExtra[29] = { 0, 0, 0, 0, 0, 0, 0, 0, 1, 1, 1, 1, 2, 2, 2, 2, 3, 3, 3, 3, 4, 4, 4, 4, 5, 5, 5, 5, 0 };
-
-    if (length < 3 || length > 258) return false;
-
-    for (int i = 0; i < 29; i++) {
-        int base = kLenBase[i];
-        int extra = kLenExtra[i];
-        int maxLen = base + ((1 << extra) - 1);
-        if (length >= base && length <= maxLen) {
-            outCode = 257 + i;
-            outExtraBits = extra;
-            outExtraValue = length - base;
-            return true;
-        }
-    }
-
-    return false;
-}
-
-static bool EncodeDistance(uint16_t distance, int& outCode, int& outExtraBits, int& outExtraValue) {
-    static const int kDistBase[30] = { 1,   2,   3,   4,   5,   7,    9,    13,   17,   25,   33,   49,   65,    97,    129,
-                                       193, 257, 385, 513, 769, 1025, 1537, 2049, 3073, 4097, 6145, 8193, 12289, 16385, 24577 };
-    static const int kDistExtra[30] = { 0, 0, 0, 0, 1, 1, 2, 2, 3, 3, 4, 4, 5, 5, 6, 6, 7, 7, 8, 8, 9, 9, 10, 10, 11, 11, 12, 12, 13, 13 };
-
-    if (distance < 1 || distance > 32768) return false;
-
-    for (int i = 0; i < 30; i++) {
-        int base = kDistBase[i];
-        int extra = kDistExtra[i];
-        int maxDist = base + ((1 << extra) - 1);
-        if (distance >= base && distance <= maxDist) {
-            outCode = i;
-            outExtraBits = extra;
-            outExtraValue = distance - base;
-            return true;
-        }
-    }
-
-    return false;
-}
-
-static bool WriteFixedDeflateStream(const std::vector<uint8_t>& input, std::vector<uint8_t>& outDeflate) {
-    InitFixedCodes();
-    if (g_fixedLitLenCodes.size() < 288 || g_fixedDistCodes.size() < 30) return false;
-
-    std::vector<DeflateToken> tokens = BuildLz77Tokens(input);
-
-    BitWriter w;
-    // Final block + fixed Huffman block type
-    w.WriteBits(1, 1);    // BFINAL
-    w.WriteBits(0b01, 2); // BTYPE=01 (fixed)
-
-    for (const DeflateToken& t : tokens) {
-        if (!t.isMatch) {
-            const HuffCode& hc = g_fixedLitLenCodes[t.literal];
-            w.WriteBits(hc.code, hc.bits);
-            continue;
-        }
-
-        int lenCode = 0, lenExtraBits = 0, lenExtraValue = 0;
-        int distCode = 0, distExtraBits = 0, distExtraValue = 0;
-
-        if (!EncodeLength(t.length, lenCode, lenExtraBits, lenExtraValue)) return false;
-        if (!EncodeDistance(t.distance, distCode, distExtraBits, distExtraValue)) return false;
-
-        const HuffCode& lenH = g_fixedLitLenCodes[lenCode];
-        w.WriteBits(lenH.code, lenH.bits);
-        if (lenExtraBits > 0) w.WriteBits(static_cast<uint32_t>(lenExtraValue), lenExtraBits);
-
-        const HuffCode& distH = g_fixedDistCodes[distCode];
-        w.WriteBits(distH.code, distH.bits);
-        if (distExtraBits > 0) w.WriteBits(static_cast<uint32_t>(distExtraValue), distExtraBits);
-    }
-
-    // End of block symbol
-    const HuffCode& eob = g_fixedLitLenCodes[256];
-    w.WriteBits(eob.code, eob.bits);
-    w.FlushToByteBoundary();
-
-    outDeflate = std::move(w.bytes);
-    return true;
-}
-
-bool CompressFileToGzip(const std::wstring& srcPath, const std::wstring& dstPath) {
-    if (!FileExistsW(srcPath)) return false;
-
-    std::vector<uint8_t> input;
-    if (!ReadFileBytes(srcPath, input)) return false;
-
-    std::vector<uint8_t> deflate;
-    if (!WriteFixedDeflateStream(input, deflate)) return false;
-
-    std::wstring tempPath = dstPath + L".tmp";
-    DeleteFileW(tempPath.c_str());
-
-    std::ofstream out(tempPath, std::ios::binary | std::ios::trunc);
-    if (!out.is_open()) return false;
-
-    // Gzip header (RFC 1952)
-    const uint8_t hdr[10] = {
-        0x1F, 0x8B,             // ID1, ID2
-        0x08,                   // CM=deflate
-        0x00,                   // FLG
-        0x00, 0x00, 0x00, 0x00, // MTIME
-        0x00,                   // XFL
-        0x0B                    // OS=NTFS/Windows
-    };
-    out.write(reinterpret_cast<const char*>(hdr), sizeof(hdr));
-    if (!deflate.empty()) out.write(reinterpret_cast<const char*>(deflate.data()), static_cast<std::streamsize>(deflate.size()));
-
-    const uint32_t crc = Crc32(input.data(), input.size());
-    WriteLE32(out, crc);
-    WriteLE32(out, static_cast<uint32_t>(input.size() & 0xFFFFFFFFu));
-
-    out.flush();
-    bool good = out.good();
-    out.close();
-    if (!good) {
-        DeleteFileW(tempPath.c_str());
-        return false;
-    }
-
-    if (!MoveFileExW(tempPath.c_str(), dstPath.c_str(), MOVEFILE_REPLACE_EXISTING | MOVEFILE_WRITE_THROUGH)) {
-        DeleteFileW(tempPath.c_str());
-        return false;
-    }
-
-    return true;
-}
-
 // ASYNC LOGGING SYSTEM
 // Uses a lock-free ring buffer for zero-contention log submission.
-// A background thread writes to disk every 500ms.
+// A background thread writes to disk every 50ms.
 // FlushLogs() force-writes all pending messages (for crash/shutdown).
+// latest.log is rotated by the writer thread only (log_rotation.h), never on the FlushLogs() path.
+// Callers only capture a timestamp tick and move the message in; the writer formats timestamps, merges in the
+// binary records from LogEvent() (structured_log.h) in time order, and writes each batch with one call.
 
-// Pre-formatted log entry with timestamp already applied
+// Log entry; the timestamp is formatted by the writer
 struct LogEntry {
     std::atomic<bool> ready{ false }; // True when data is fully written and can be read
-    std::string formattedMessage;     // "[HH:MM:SS.mmm] message"
+    int64_t ticks = 0;                // LogTicksNow() at the Log() call
+    std::string message;
 };
 
 // Lock-free ring buffer for log entries
@@ -538,9 +207,17 @@ static std::atomic<size_t> g_logReadIndex{ 0 };  // Next position to read (reade
 static std::thread g_logThread;
 static std::atomic<bool> g_logThreadRunning{ false };
 
+// Rotates latest.log by size and age; archives are compressed on its own low-priority thread
+static LogRotator g_logRotator;
+
 // Forward declaration
 static void LogThreadMain();
-static void WriteLogsToFile();
+static void WriteLogsToFile(bool allowRotation);
+
+bool OpenLogFile(const std::wstring& latestLogPath) {
+    std::lock_guard<std::mutex> lock(g_logFileMutex);
+    return g_logRotator.Open(latestLogPath, LogRotationPolicy{}, logFile);
+}
 
 void StartLogThread() {
     if (g_logThreadRunning.load()) return;
@@ -554,26 +231,63 @@ void StopLogThread() {
     if (g_logThread.joinable()) { g_logThread.join(); }
     // Final flush after thread stops
     FlushLogs();
+    // Abandons a compression in progress; unfinished archives are compressed on the next start
+    g_logRotator.Stop();
 }
 
 static void LogThreadMain() {
     while (g_logThreadRunning.load()) {
-        WriteLogsToFile();
+        WriteLogsToFile(true);
         std::this_thread::sleep_for(std::chrono::milliseconds(50));
     }
 }
 
-// Internal: Write all pending log entries to file (called by background thread or FlushLogs)
-static void WriteLogsToFile() {
-    size_t readPos = g_logReadIndex.load(std::memory_order_relaxed);
-    size_t claimPos = g_logClaimIndex.load(std::memory_order_acquire);
+// "HH:MM:SS.mmm" local time for a LogTicksNow() value. Writer only (called with g_logFileMutex held).
+static void FormatLogTimestamp(int64_t ticks, char (&out)[16]) {
+    using namespace std::chrono;
+    static const int64_t s_originTicks = LogTicksNow();
+    static const system_clock::time_point s_originWall = system_clock::now();
+    static int64_t s_cachedSecond = INT64_MIN;
+    static struct tm s_cachedTm = {};
+
+    const auto wall = s_originWall + duration_cast<system_clock::duration>(steady_clock::duration(ticks - s_originTicks));
+    const int64_t ms = duration_cast<milliseconds>(wall.time_since_epoch()).count();
+    const int64_t second = ms >= 0 ? ms / 1000 : (ms - 999) / 1000;
+    if (second != s_cachedSecond) {
+        const time_t t = static_cast<time_t>(second);
+        localtime_s(&s_cachedTm, &t);
+        s_cachedSecond = second;
+    }
+    snprintf(out, sizeof(out), "%02d:%02d:%02d.%03d", s_cachedTm.tm_hour, s_cachedTm.tm_min, s_cachedTm.tm_sec,
+             static_cast<int>(ms - second * 1000));
+}
 
-    if (readPos == claimPos) return; // Nothing claimed yet
+// Internal: Write all pending log entries to file (called by background thread or FlushLogs)
+static void WriteLogsToFile(bool allowRotation) {
+    struct PendingLine {
+        int64_t ticks;
+        std::string text;
+    };
+    // Writer state, reused across batches (guarded by g_logFileMutex)
+    static std::vector<PendingLine> s_lines;
+    static size_t s_lineCount = 0;
+    static std::string s_output;
 
-    // Lock only during actual file I/O (not during Log() calls)
+    // Lock only during draining and file I/O (not during Log() calls)
     std::lock_guard<std::mutex> lock(g_logFileMutex);
     if (!logFile.is_open()) return;
 
+    s_lineCount = 0;
+    auto addLine = [](int64_t ticks, std::string_view text) {
+        if (s_lineCount == s_lines.size()) s_lines.emplace_back();
+        PendingLine& line = s_lines[s_lineCount++];
+        line.ticks = ticks;
+        line.text.assign(text.data(), text.size());
+    };
+
+    size_t readPos = g_logReadIndex.load(std::memory_order_relaxed);
+    size_t claimPos = g_logClaimIndex.load(std::memory_order_acquire);
+
     // Process all ready entries in order
     // Note: entries might be claimed but not yet ready if writer is mid-write
     while (readPos != claimPos) {
@@ -587,51 +301,70 @@ static void WriteLogsToFile() {
             break;
         }
 
-        logFile << entry.formattedMessage << std::endl;
+        if (s_lineCount == s_lines.size()) s_lines.emplace_back();
+        PendingLine& line = s_lines[s_lineCount++];
+        line.ticks = entry.ticks;
+        line.text.swap(entry.message);
+        entry.message.clear();
 
         // Clear ready flag for next use of this slot
         entry.ready.store(false, std::memory_order_relaxed);
 
         readPos = (readPos + 1) % LOG_BUFFER_SIZE;
     }
+    g_logReadIndex.store(readPos, std::memory_order_release);
 
+    const uint64_t dropped = DrainLogRecords(addLine);
+    if (dropped > 0) { addLine(LogTicksNow(), "(" + std::to_string(dropped) + " log event(s) dropped: writer fell behind)"); }
+    if (s_lineCount == 0) return;
+
+    // Each thread's lines are already in order; this interleaves the threads and the two queues
+    std::stable_sort(s_lines.begin(), s_lines.begin() + s_lineCount,
+                     [](const PendingLine& a, const PendingLine& b) { return a.ticks < b.ticks; });
+
+    s_output.clear();
+    char timestamp[16];
+    for (size_t i = 0; i < s_lineCount; i++) {
+        FormatLogTimestamp(s_lines[i].ticks, timestamp);
+        s_output += '[';
+        s_output += timestamp;
+        s_output += "] ";
+        s_output += s_lines[i].text;
+        s_output += '\n';
+    }
+    logFile.write(s_output.data(), static_cast<std::streamsize>(s_output.size()));
     logFile.flush();
-    g_logReadIndex.store(readPos, std::memory_order_release);
+    if (allowRotation) g_logRotator.OnWrite(s_output.size(), logFile);
 }
 
 // Force flush all pending logs - call during crash/shutdown
-void FlushLogs() { WriteLogsToFile(); }
+void FlushLogs() { WriteLogsToFile(false); }
+
+uint32_t LogCategoryMaskFromConfig(const DebugGlobalConfig& debug) {
+    const std::pair<LogCategoryId, bool> categories[] = {
+        { LogCategoryId::ModeSwitch, debug.logModeSwitch },
+        { LogCategoryId::Animation, debug.logAnimation },
+        { LogCategoryId::Hotkey, debug.logHotkey },
+        { LogCategoryId::Obs, debug.logObs },
+        { LogCategoryId::WindowOverlay, debug.logWindowOverlay },
+        { LogCategoryId::FileMonitor, debug.logFileMonitor },
+        { LogCategoryId::ImageMonitor, debug.logImageMonitor },
+        { LogCategoryId::Performance, debug.logPerformance },
+        { LogCategoryId::TextureOps, debug.logTextureOps },
+        { LogCategoryId::Gui, debug.logGui },
+        { LogCategoryId::Init, debug.logInit },
+        { LogCategoryId::CursorTextures, debug.logCursorTextures },
+    };
+    uint32_t mask = 1u << static_cast<uint32_t>(LogCategoryId::General);
+    for (const auto& [category, enabled] : categories) {
+        if (enabled) mask |= 1u << static_cast<uint32_t>(category);
+    }
+    return mask;
+}
 
 // Category-based logging - only logs if category is enabled in debug config
-void LogCategory(const char* category, const std::string& message) {
-    // Check if category is enabled
-    bool enabled = false;
-    if (strcmp(category, "mode_switch") == 0)
-        enabled = g_config.debug.logModeSwitch;
-    else if (strcmp(category, "animation") == 0)
-        enabled = g_config.debug.logAnimation;
-    else if (strcmp(category, "hotkey") == 0)
-        enabled = g_config.debug.logHotkey;
-    else if (strcmp(category, "obs") == 0)
-        enabled = g_config.debug.logObs;
-    else if (strcmp(category, "window_overlay") == 0)
-        enabled = g_config.debug.logWindowOverlay;
-    else if (strcmp(category, "file_monitor") == 0)
-        enabled = g_config.debug.logFileMonitor;
-    else if (strcmp(category, "image_monitor") == 0)
-        enabled = g_config.debug.logImageMonitor;
-    else if (strcmp(category, "performance") == 0)
-        enabled = g_config.debug.logPerformance;
-    else if (strcmp(category, "texture_ops") == 0)
-        enabled = g_config.debug.logTextureOps;
-    else if (strcmp(category, "gui") == 0)
-        enabled = g_config.debug.logGui;
-    else if (strcmp(category, "init") == 0)
-        enabled = g_config.debug.logInit;
-    else if (strcmp(category, "cursor_textures") == 0)
-        enabled = g_config.debug.logCursorTextures;
-
-    if (!enabled) return;
+void LogCategory(LogCategoryId category, const std::string& message) {
+    if (!IsLogCategoryEnabled(category)) return;
     Log(message); // Use standard Log for actual output
 }
 
@@ -640,8 +373,7 @@ void LogCategory(const char* category, const std::string& message) {
 // 2. Write data to the claimed slot
 // 3. Mark slot as ready (signals reader that data is complete)
 void Log(const std::string& message) {
-    // Format with timestamp before entering critical path
-    std::string formatted = "[" + GetTimestamp() + "] " + message;
+    const int64_t ticks = LogTicksNow();
 
     // Atomically claim a slot using CAS loop
     size_t claimPos, nextClaimPos;
@@ -659,7 +391,8 @@ void Log(const std::string& message) {
 
     // We successfully claimed slot 'claimPos' - write data
     LogEntry& entry = g_logBuffer[claimPos % LOG_BUFFER_SIZE];
-    entry.formattedMessage = std::move(formatted);
+    entry.ticks = ticks;
+    entry.message = message; // Reuses the slot's capacity once it has grown
 
     // Mark slot as ready (release ensures data write is visible before ready flag)
     entry.ready.store(true, std::memory_order_release);
@@ -930,7 +663,7 @@ void WriteCurrentModeToFile(const std::string& modeId) {
 bool SwitchToMode(const std::string& newModeId, const std::string& source, bool forceCut) {
     PROFILE_SCOPE_CAT("Mode Switch", "Mode Management");
 
-    LogCategory("mode_switch", "[MODE_SWITCH] Entry: Attempting to switch to '" + newModeId + "' from source: " + source);
+    LogCategory(LogCategoryId::ModeSwitch, "[MODE_SWITCH] Entry: Attempting to switch to '" + newModeId + "' from source: " + source);
 
     if (newModeId.empty()) {
         Log("ERROR: Attempted to switch to empty mode ID");
@@ -956,11 +689,11 @@ bool SwitchToMode(const std::string& newModeId, const std::string& source, bool
 
     std::string currentMode;
 
-    LogCategory("mode_switch", "[MODE_SWITCH] Acquiring g_modeIdMutex...");
+    LogCategory(LogCategoryId::ModeSwitch, "[MODE_SWITCH] Acquiring g_modeIdMutex...");
     // Get current mode - keep lock minimal, no I/O inside
     {
         std::lock_guard<std::mutex> lock(g_modeIdMutex);
-        LogCategory("mode_switch", "[MODE_SWITCH] g_modeIdMutex acquired");
+        LogCategory(LogCategoryId::ModeSwitch, "[MODE_SWITCH] g_modeIdMutex acquired");
         currentMode = g_currentModeId;
 
         // Don't switch if we're already in the target mode
@@ -974,16 +707,16 @@ bool SwitchToMode(const std::string& newModeId, const std::string& source, bool
         int nextIndex = 1 - g_currentModeIdIndex.load(std::memory_order_relaxed);
         g_modeIdBuffers[nextIndex] = newModeId;
         g_currentModeIdIndex.store(nextIndex, std::memory_order_release);
-        LogCategory("mode_switch", "[MODE_SWITCH] g_currentModeId updated to: " + newModeId);
+        LogCategory(LogCategoryId::ModeSwitch, "[MODE_SWITCH] g_currentModeId updated to: " + newModeId);
     }
-    LogCategory("mode_switch", "[MODE_SWITCH] g_modeIdMutex released");
+    LogCategory(LogCategoryId::ModeSwitch, "[MODE_SWITCH] g_modeIdMutex released");
 
     // Async file write OUTSIDE the mutex - never blocks
     WriteCurrentModeToFile(newModeId);
 
     std::string logMessage = "[MODE] Switching from '" + currentMode + "' to '" + newModeId + "'";
     if (!source.empty()) { logMessage += " (source: " + source + ")"; }
-    LogCategory("mode_switch", logMessage);
+    LogCategory(LogCategoryId::ModeSwitch, logMessage);
 
     // Read mode configurations to get dimensions/positions
     int fromWidth = 0, fromHeight = 0, fromX = 0, fromY = 0;
@@ -1024,7 +757,7 @@ bool SwitchToMode(const std::string& newModeId, const std::string& source, bool
                 // We need to defer this calculation, so we'll just mark that we need to scale
             }
 
-            LogCategory("mode_switch",
+            LogCategory(LogCategoryId::ModeSwitch,
                         "[MODE_SWITCH] Active transition detected - using current animated position: " + std::to_string(fromWidth) + "x" +
                             std::to_string(fromHeight) + " at " + std::to_string(fromX) + "," + std::to_string(fromY));
         }
@@ -1088,8 +821,9 @@ bool SwitchToMode(const std::string& newModeId, const std::string& source, bool
             toModeCopy.overlayTransition = OverlayTransitionType::Cut;
             toModeCopy.backgroundTransition = BackgroundTransitionType::Cut;
         }
-        LogCategory("mode_switch", "[MODE_SWITCH] Mode dimensions calculated - from: " + std::to_string(fromWidth) + "x" +
-                                       std::to_string(fromHeight) + ", to: " + std::to_string(toWidth) + "x" + std::to_string(toHeight));
+        LogCategory(LogCategoryId::ModeSwitch, "[MODE_SWITCH] Mode dimensions calculated - from: " + std::to_string(fromWidth) + "x" +
+                                                   std::to_string(fromHeight) + ", to: " + std::to_string(toWidth) + "x" +
+                        std::to_string(toHeight));
     }
 
     // If we're reversing mid-animation, scale the duration based on distance ratio
@@ -1127,7 +861,7 @@ bool SwitchToMode(const std::string& newModeId, const std::string& source, bool
                 int originalDuration = toModeCopy.transitionDurationMs;
                 toModeCopy.transitionDurationMs = static_cast<int>(originalDuration * distanceRatio);
 
-                LogCategory("mode_switch",
+                LogCategory(LogCategoryId::ModeSwitch,
                             "[MODE_SWITCH] Mid-animation reversal: scaling duration from " + std::to_string(originalDuration) + "ms to " +
                                 std::to_string(toModeCopy.transitionDurationMs) + "ms (ratio: " + std::to_string(distanceRatio) + ")");
             }
@@ -1142,12 +876,12 @@ bool SwitchToMode(const std::string& newModeId, const std::string& source, bool
     }
 
     // Start animated transition (handles size interpolation and WM_SIZE messages)
-    LogCategory("mode_switch",
+    LogCategory(LogCategoryId::ModeSwitch,
                 "[MODE_SWITCH] Calling StartModeTransition with Game:" + GameTransitionTypeToString(toModeCopy.gameTransition) +
                     ", Overlay:" + OverlayTransitionTypeToString(toModeCopy.overlayTransition) +
                     ", Bg:" + BackgroundTransitionTypeToString(toModeCopy.backgroundTransition));
     StartModeTransition(currentMode, newModeId, fromWidth, fromHeight, fromX, fromY, toWidth, toHeight, toX, toY, toModeCopy);
-    LogCategory("mode_switch", "[MODE_SWITCH] StartModeTransition completed");
+    LogCategory(LogCategoryId::ModeSwitch, "[MODE_SWITCH] StartModeTransition completed");
 
     return true; // Mode was changed
 }
@@ -1347,6 +1081,33 @@ GLuint CreateShaderProgram(const char* vert, const char* frag) {
     return p;
 }
 
+namespace {
+std::mutex g_imageDecodePoolMutex;
+std::unique_ptr<ImageDecodePool> g_imageDecodePool;
+// Whole decoded images by file content, so reloads and images shared between modes skip the decode
+DecodedImageCache g_decodedImageCache(256u << 20);
+std::atomic<uint64_t> g_nextImageLoadId{ 1 };
+
+ImageDecodePool& GetImageDecodePool() {
+    std::lock_guard<std::mutex> lock(g_imageDecodePoolMutex);
+    if (!g_imageDecodePool) {
+        const size_t threads = std::clamp<size_t>(std::thread::hardware_concurrency() / 2, 1, 4);
+        g_imageDecodePool = std::make_unique<ImageDecodePool>(threads);
+    }
+    return *g_imageDecodePool;
+}
+
+void PushDecodedImagePart(DecodedImageData::Type type, const std::string& id, uint64_t loadId, DecodedImagePart&& part) {
+    DecodedImageData decoded;
+    decoded.type = type;
+    decoded.id = id;
+    decoded.loadId = loadId;
+    decoded.part = std::move(part);
+    std::lock_guard<std::mutex> lock(g_decodedImagesMutex);
+    g_decodedImagesQueue.push_back(std::move(decoded));
+}
+} // namespace
+
 void LoadImageAsync(DecodedImageData::Type type, std::string id, std::string path, const std::wstring& toolscreenPath) {
     PROFILE_SCOPE_CAT("Async Image Load", "IO Operations");
     if (path.empty()) {
@@ -1354,11 +1115,12 @@ void LoadImageAsync(DecodedImageData::Type type, std::string id, std::string pat
         return;
     }
 
-    std::thread([type, id, path, toolscreenPath]() {
+    const uint64_t loadId = g_nextImageLoadId.fetch_add(1, std::memory_order_relaxed);
+    GetImageDecodePool().Submit([type, id, path, toolscreenPath, loadId]() {
         _set_se_translator(SEHTranslator);
 
         try {
-            Log("Started thread for loading image '" + id + "' from path '" + path + "'");
+            Log("Started loading image '" + id + "' from path '" + path + "'");
             try {
                 if (g_isShuttingDown.load()) { return; }
 
@@ -1369,103 +1131,64 @@ void LoadImageAsync(DecodedImageData::Type type, std::string id, std::string pat
                 } else {
                     final_path = image_wpath;
                 }
-                std::string path_utf8 = WideToUtf8(final_path);
-
-                // Check if file is a GIF by extension (case-insensitive)
-                bool isGif = false;
-                if (path.size() >= 4) {
-                    std::string ext = path.substr(path.size() - 4);
-                    std::transform(ext.begin(), ext.end(), ext.begin(), ::tolower);
-                    isGif = (ext == ".gif");
-                }
 
-                int w, h, c;
-                unsigned char* data = nullptr;
-                int frameCount = 0;
-                int* delays = nullptr;
-
-                if (isGif) {
-                    // Read file into memory for GIF loading
-                    FILE* f = nullptr;
-                    errno_t err = fopen_s(&f, path_utf8.c_str(), "rb");
-                    if (err == 0 && f) {
-                        fseek(f, 0, SEEK_END);
-                        long fileSize = ftell(f);
-                        fseek(f, 0, SEEK_SET);
-
-                        std::vector<unsigned char> fileData(fileSize);
-                        size_t bytesRead = fread(fileData.data(), 1, fileSize, f);
-                        fclose(f);
-
-                        if (bytesRead == static_cast<size_t>(fileSize)) {
-                            // Try loading as animated GIF
-                            data = stbi_load_gif_from_memory(fileData.data(), (int)fileSize, &delays, &w, &h, &frameCount, &c, 4);
-
-                            if (data && frameCount <= 1) {
-                                // Single-frame GIF, treat as static image
-                                frameCount = 1;
-                                stbi_image_free(delays);
-                                delays = nullptr;
-                            }
-                        }
-                    }
-
-                    // Fall back to regular load if GIF loading failed
-                    if (!data) {
-                        frameCount = 0;
-                        data = stbi_load(path_utf8.c_str(), &w, &h, &c, 4);
-                    }
-                } else {
-                    // Non-GIF: use regular stbi_load
-                    data = stbi_load(path_utf8.c_str(), &w, &h, &c, 4);
+                std::ifstream file(final_path, std::ios::binary | std::ios::ate);
+                if (!file) {
+                    Log("ERROR: Failed to decode image '" + path + "' for ID '" + id + "'. Reason: can't open file");
+                    return;
                 }
-
-                if (g_isShuttingDown.load()) {
-                    if (data) stbi_image_free(data);
-                    if (delays) stbi_image_free(delays);
+                std::vector<uint8_t> fileData(static_cast<size_t>(file.tellg()));
+                file.seekg(0);
+                if (!file.read(reinterpret_cast<char*>(fileData.data()), static_cast<std::streamsize>(fileData.size()))) {
+                    Log("ERROR: Failed to decode image '" + path + "' for ID '" + id + "'. Reason: read error");
                     return;
                 }
+                file.close();
+
+                // The decode callback pushes each part as soon as it's ready, so a streamed animation starts uploading
+                // while later frames are still decoding. Only whole images go into the cache.
+                std::string error;
+                size_t frameCount = 0;
+                int frameWidth = 0, frameHeight = 0;
+                bool ranDecode = false;
+                std::shared_ptr<const DecodedImage> cached = g_decodedImageCache.GetOrDecode(
+                    MakeImageContentKey(fileData.data(), fileData.size()),
+                    [&]() -> std::shared_ptr<const DecodedImage> {
+                        std::shared_ptr<const DecodedImage> whole;
+                        const bool ok = DecodeImage(fileData.data(), fileData.size(), ImageDecodeLimits{}, &g_isShuttingDown,
+                                                    [&](DecodedImagePart&& part) {
+                                                        frameCount += part.image->frames.size();
+                                                        frameWidth = part.image->width;
+                                                        frameHeight = part.image->height;
+                                                        if (part.IsWhole()) whole = part.image;
+                                                        PushDecodedImagePart(type, id, loadId, std::move(part));
+                                                    },
+                                                    error);
+                        return ok ? whole : nullptr;
+                    },
+                    ranDecode);
 
-                if (data && w > 0 && h > 0) {
-                    DecodedImageData decoded;
-                    decoded.type = type;
-                    decoded.id = id;
-                    decoded.width = w;
-                    decoded.channels = 4;
-                    decoded.data = data;
-
-                    // Set animation data
-                    if (frameCount > 1) {
-                        decoded.isAnimated = true;
-                        decoded.frameCount = frameCount;
-                        decoded.height = h * frameCount; // stbi_load_gif returns stacked frames
-                        decoded.frameHeight = h;
-                        for (int i = 0; i < frameCount; i++) {
-                            // stb_image already converts GIF delays to milliseconds internally
-                            // (see stb_image.h line 6916: "delay - 1/100th of a second, saving as 1/1000ths")
-                            int delayMs = (delays && delays[i] > 0) ? delays[i] : 100;
-                            decoded.frameDelays.push_back(delayMs);
-                        }
-                        Log("Loaded animated GIF '" + id + "' with " + std::to_string(frameCount) +
-                            " frames, frame size: " + std::to_string(w) + "x" + std::to_string(h));
-                    } else {
-                        decoded.isAnimated = false;
-                        decoded.frameCount = 1;
-                        decoded.height = h;
-                        decoded.frameHeight = h;
-                    }
-
-                    if (delays) stbi_image_free(delays);
+                if (g_isShuttingDown.load()) { return; }
 
-                    std::lock_guard<std::mutex> lock(g_decodedImagesMutex);
-                    g_decodedImagesQueue.push_back(decoded);
-                    Log("Successfully decoded image for '" + id + "' from '" + path + "' on background thread.");
-                } else {
+                if (!ranDecode && cached) {
+                    frameCount = cached->frames.size();
+                    frameWidth = cached->width;
+                    frameHeight = cached->height;
+                    DecodedImagePart part;
+                    part.image = cached;
+                    PushDecodedImagePart(type, id, loadId, std::move(part));
+                    Log("Reused decoded image for '" + id + "' from cache (same content as an earlier load).");
+                } else if (frameCount == 0) {
                     Log("ERROR: Failed to decode image '" + path + "' for ID '" + id +
-                        "'. Reason: " + (stbi_failure_reason() ? stbi_failure_reason() : "unknown error"));
-                    if (data) stbi_image_free(data);
-                    if (delays) stbi_image_free(delays);
+                        "'. Reason: " + (error.empty() ? "unknown error" : error));
+                    return;
                 }
+
+                if (frameCount > 1) {
+                    Log("Loaded animated GIF '" + id + "' with " + std::to_string(frameCount) +
+                        " frames, frame size: " + std::to_string(frameWidth) + "x" + std::to_string(frameHeight));
+                }
+                Log("Successfully decoded image for '" + id + "' from '" + path + "' on background thread.");
             } catch (const std::exception& ex) {
                 Log("ERROR: Exception during image load for '" + id + "' from '" + path + "': " + ex.what());
             }
@@ -1474,8 +1197,17 @@ void LoadImageAsync(DecodedImageData::Type type, std::string id, std::string pat
         } catch (const std::exception& e) { LogException("ImageLoadThread for '" + id + "'", e); } catch (...) {
             Log("EXCEPTION in ImageLoadThread for '" + id + "': Unknown exception");
         }
-        Log("Image load thread for '" + id + "' has completed.");
-    }).detach();
+    });
+}
+
+void StopImageDecodePool() {
+    std::unique_ptr<ImageDecodePool> pool;
+    {
+        std::lock_guard<std::mutex> lock(g_imageDecodePoolMutex);
+        pool = std::move(g_imageDecodePool);
+    }
+    if (pool) pool->Shutdown();
+    g_decodedImageCache.Clear();
 }
 
 void LoadAllImages() {
@@ -2117,17 +1849,18 @@ void BackupConfigFile() {
     auto timestamp = std::chrono::duration_cast<std::chrono::seconds>(now.time_since_epoch()).count();
 
     // Create backup filename with timestamp
-    std::wstring backupFileName = backupDir + L"\\config_" + std::to_wstring(timestamp) + L".toml";
+    std::wstring backupFileName = backupDir + L"\\config_" + std::to_wstring(timestamp) + L".toml.gz";
 
-    // Copy the config file to backup location
-    if (CopyFileW(configPath.c_str(), backupFileName.c_str(), FALSE)) {
+    // Compress the config file into the backup location
+    if (CompressFileToGzip(configPath, backupFileName)) {
         Log("Config backed up to: " + WideToUtf8(backupFileName));
 
         // Clean up old backups, keeping only the latest 50
         WIN32_FIND_DATAW findData;
         std::vector<std::pair<FILETIME, std::wstring>> backupFiles;
 
-        std::wstring searchPattern = backupDir + L"\\config_*.toml";
+        // Matches both gzip backups and plain .toml backups from older versions
+        std::wstring searchPattern = backupDir + L"\\config_*.toml*";
         HANDLE hFind = FindFirstFileW(searchPattern.c_str(), &findData);
 
         if (hFind != INVALID_HANDLE_VALUE) {
@@ -2161,7 +1894,6 @@ void BackupConfigFile() {
             }
         }
     } else {
-        DWORD error = GetLastError();
-        Log("Failed to backup config file. Error code: " + std::to_string(error));
+        Log("Failed to backup config file to: " + WideToUtf8(backupFileName));
     }
 }
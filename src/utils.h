@@ -17,6 +17,7 @@
 #include <windows.h>
 
 #include "gui.h"
+#include "structured_log.h"
 
 // Config access: Reader threads use GetConfigSnapshot() for safe, lock-free access.
 // g_config is the mutable draft, only touched by the GUI/main thread.
@@ -304,23 +305,22 @@ void Log(const std::string& message);
 void Log(const std::wstring& message);
 
 // Async logging system
+bool OpenLogFile(const std::wstring& latestLogPath); // Archive the previous session's log, open a fresh one, start rotation
 void StartLogThread(); // Start background log writer thread
 void StopLogThread();  // Stop background log writer thread (flushes first)
 void FlushLogs();      // Force flush all pending logs (for crash/shutdown)
 
-// Category-based logging - only logs if category is enabled in debug config
-// Categories: "mode_switch", "animation", "hotkey", "obs", "window_overlay",
-//             "file_monitor", "image_monitor", "performance"
-void LogCategory(const char* category, const std::string& message);
+// Category-based logging - only logs if category is enabled in debug config (a bitmask test, see structured_log.h).
+// Hot paths should prefer LogEvent(), which also skips building the message string.
+void LogCategory(LogCategoryId category, const std::string& message);
+
+// Bitmask of the log categories the debug config enables, for SetLogCategoryMask()
+uint32_t LogCategoryMaskFromConfig(const DebugGlobalConfig& debug);
 
 std::wstring Utf8ToWide(const std::string& utf8_string);
 std::string WideToUtf8(const std::wstring& wstr);
 std::wstring GetToolscreenPath();
 
-// Compress a file to gzip format (.gz) using in-process DEFLATE compression.
-// Returns true on success.
-bool CompressFileToGzip(const std::wstring& srcPath, const std::wstring& dstPath);
-
 inline std::string GetKeyComboString(const std::vector<DWORD>& keys) {
     std::string keyStr;
     for (size_t k = 0; k < keys.size(); ++k) {
@@ -373,6 +373,8 @@ GLuint CreateShaderProgram(const char* vert, const char* frag);
 
 void LoadImageAsync(DecodedImageData::Type type, std::string id, std::string path, const std::wstring& toolscreenPath);
 void LoadAllImages();
+// Drops queued image loads and joins the decode workers; in-flight decodes stop early once g_isShuttingDown is set
+void StopImageDecodePool();
 
 bool CheckHotkeyMatch(const std::vector<DWORD>& keys, WPARAM wParam, const std::vector<DWORD>& exclusionKeys = {},
                       bool triggerOnRelease = false);
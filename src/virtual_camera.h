@@ -26,6 +26,29 @@ bool WriteVirtualCameraFrame(const uint8_t* rgba_data, uint32_t width, uint32_t
 // nv12_data must be width*height*3/2 bytes (NV12 format)
 bool WriteVirtualCameraFrameNV12(const uint8_t* nv12_data, uint32_t width, uint32_t height, uint64_t timestamp);
 
+// Frame pacing: call once per render frame before issuing any capture/readback work.
+// pipelineBusy = the producer can't start a new readback yet (the due frame is dropped without GPU work).
+// Returns true if a frame should be captured now; it then counts as in flight until it is committed or dropped.
+bool ShouldCaptureVirtualCameraFrame(bool pipelineBusy);
+// Account captured frames that were discarded before reaching Begin (e.g. readback buffers reallocated)
+void DropVirtualCameraFrames(int count);
+
+// Zero-copy producer API: reserve the next shared-memory frame slot, fill it with NV12 data
+// (e.g. straight from a PBO readback or the RGBA->NV12 converter), then commit it.
+// Begin returns false when inactive, dimensions mismatch, or a slot is already reserved (counted as a drop).
+// Every successful Begin must be followed by exactly one Commit or Cancel on the same thread.
+struct VirtualCameraFrameSlot {
+    uint8_t* data = nullptr; // size bytes of NV12 (Y plane then interleaved UV)
+    uint32_t size = 0;
+    uint32_t width = 0;
+    uint32_t height = 0;
+    uint32_t index = 0;
+    uint32_t writeIdx = 0;
+};
+bool BeginVirtualCameraFrame(uint32_t width, uint32_t height, VirtualCameraFrameSlot& outSlot);
+void CommitVirtualCameraFrame(const VirtualCameraFrameSlot& slot, uint64_t timestamp);
+void CancelVirtualCameraFrame(const VirtualCameraFrameSlot& slot);
+
 // Check if virtual camera is currently active
 bool IsVirtualCameraActive();
 
@@ -0,0 +1,121 @@
+#include "virtual_camera_pacer.h"
+
+#include <algorithm>
+
+void VirtualCameraPacer::Reset(int targetFps, int64_t ticksPerSecond) {
+    *this = VirtualCameraPacer();
+    m_ticksPerSecond = std::max<int64_t>(ticksPerSecond, 1);
+    m_targetInterval = std::max<int64_t>(m_ticksPerSecond / std::max(targetFps, 1), 1);
+    m_interval = m_targetInterval;
+}
+
+bool VirtualCameraPacer::ShouldCapture(int64_t now, bool pipelineBusy) {
+    if (m_windowStart == 0) { m_windowStart = now; }
+
+    if (m_lastCall != 0) {
+        const int64_t period = now - m_lastCall;
+        // EMA (1/8) of the render-loop period; ignore hitches so one long frame doesn't widen the slack
+        if (period > 0 && period < m_ticksPerSecond / 4) {
+            m_renderPeriod = (m_renderPeriod == 0) ? period : m_renderPeriod + (period - m_renderPeriod) / 8;
+        }
+    }
+    m_lastCall = now;
+
+    if (m_nextDue == 0) { m_nextDue = now; }
+
+    // Capture on the render frame closest to the deadline, not the first one after it
+    const int64_t slack = std::min(m_renderPeriod / 2, m_interval / 2);
+    if (now + slack < m_nextDue) { return false; }
+
+    m_nextDue += m_interval;
+    if (now + slack >= m_nextDue) {
+        // The render loop ran slower than the cadence: the slots it skipped were never produced.
+        // Count them and move past them instead of bursting to catch up.
+        const int64_t missed = (now + slack - m_nextDue) / m_interval + 1;
+        m_window.dropped += static_cast<uint64_t>(missed);
+        m_total.dropped += static_cast<uint64_t>(missed);
+        m_nextDue += missed * m_interval;
+    }
+
+    // This slot would be dropped anyway — skip the readback instead of paying for it. Nothing was captured, so
+    // the in-flight captures are untouched.
+    if (pipelineBusy || m_inFlightCount >= kMaxInFlight) {
+        ++m_window.dropped;
+        ++m_total.dropped;
+        return false;
+    }
+
+    m_inFlight[m_inFlightCount++] = now;
+    return true;
+}
+
+void VirtualCameraPacer::OnDelivered(int64_t now) {
+    if (m_inFlightCount == 0) {
+        // Delivery without a paced capture (e.g. direct WriteVirtualCameraFrame); count it, no latency sample
+        ++m_window.delivered;
+        ++m_total.delivered;
+        return;
+    }
+
+    const int64_t captured = m_inFlight[0];
+    for (int i = 1; i < m_inFlightCount; ++i) { m_inFlight[i - 1] = m_inFlight[i]; }
+    --m_inFlightCount;
+
+    const int64_t latency = std::max<int64_t>(now - captured, 0);
+    const double latencyMs = static_cast<double>(latency) * 1000.0 / static_cast<double>(m_ticksPerSecond);
+
+    ++m_window.delivered;
+    ++m_total.delivered;
+    m_windowLatencySumMs += latencyMs;
+    ++m_windowLatencySamples;
+    ++m_totalLatencySamples;
+    m_window.maxLatencyMs = std::max(m_window.maxLatencyMs, latencyMs);
+    m_total.maxLatencyMs = std::max(m_total.maxLatencyMs, latencyMs);
+    m_total.avgLatencyMs += (latencyMs - m_total.avgLatencyMs) / static_cast<double>(m_totalLatencySamples);
+
+    // Late: reached the queue after the next frame was already due
+    if (latency > m_targetInterval) {
+        ++m_window.late;
+        ++m_total.late;
+    }
+}
+
+void VirtualCameraPacer::OnDropped(int count) {
+    for (int i = 0; i < count; ++i) {
+        if (m_inFlightCount > 0) {
+            for (int j = 1; j < m_inFlightCount; ++j) { m_inFlight[j - 1] = m_inFlight[j]; }
+            --m_inFlightCount;
+        }
+        ++m_window.dropped;
+        ++m_total.dropped;
+    }
+}
+
+void VirtualCameraPacer::CloseWindow(int64_t now) {
+    const double windowSeconds = static_cast<double>(now - m_windowStart) / static_cast<double>(m_ticksPerSecond);
+
+    m_window.avgLatencyMs = m_windowLatencySamples > 0 ? m_windowLatencySumMs / static_cast<double>(m_windowLatencySamples) : 0.0;
+    m_window.effectiveFps = windowSeconds > 0.0 ? static_cast<double>(m_window.delivered) / windowSeconds : 0.0;
+
+    // Adapt: mostly-late windows stretch the interval by 1/8 (capped at 2x); clean windows relax it back
+    if (m_window.delivered > 0 && m_window.late * 2 > m_window.delivered) {
+        m_interval = std::min(m_interval + m_interval / 8, m_targetInterval * 2);
+    } else if (m_window.late == 0 && m_interval > m_targetInterval) {
+        m_interval = std::max(m_interval - m_targetInterval / 16, m_targetInterval);
+    }
+
+    m_lastWindow = m_window;
+    m_windowReady = true;
+    m_window = Stats();
+    m_windowLatencySumMs = 0.0;
+    m_windowLatencySamples = 0;
+    m_windowStart = now;
+}
+
+bool VirtualCameraPacer::TakeWindowStats(int64_t now, Stats& out) {
+    if (m_windowStart != 0 && now - m_windowStart >= m_ticksPerSecond) { CloseWindow(now); }
+    if (!m_windowReady) return false;
+    out = m_lastWindow;
+    m_windowReady = false;
+    return true;
+}
@@ -0,0 +1,66 @@
+#pragma once
+
+#include <cstdint>
+
+// Frame pacing for the virtual camera producer. Decides, before any GPU work is issued, whether the current
+// render frame should be captured, and accounts every captured frame as delivered or dropped.
+// Platform-neutral: time is passed in as integer ticks of a caller-provided clock.
+//
+// - Cadence: captures are scheduled on a fixed grid of the target interval. A capture is accepted up to half a
+//   render-loop period early, so a 144 Hz loop feeding a 60 fps camera averages 60 fps instead of snapping to
+//   every third render frame (48 fps).
+// - Backpressure: when a capture is due but the readback pipeline is still busy, or too many captures are waiting
+//   to reach the shared queue, the frame is dropped up front so no readback is issued for it.
+// - Adaptation: if most frames in a stats window arrive late, the effective interval is stretched (up to 2x);
+//   it relaxes back toward the target once frames arrive on time again.
+class VirtualCameraPacer {
+  public:
+    struct Stats {
+        uint64_t delivered = 0;
+        uint64_t dropped = 0;
+        uint64_t late = 0;
+        double avgLatencyMs = 0.0;
+        double maxLatencyMs = 0.0;
+        double effectiveFps = 0.0;
+    };
+
+    static constexpr int kMaxInFlight = 2; // Captures allowed between ShouldCapture() and delivery
+
+    void Reset(int targetFps, int64_t ticksPerSecond);
+
+    // Called once per render frame that could feed the camera. pipelineBusy = the producer cannot start a new
+    // readback right now. Returns true if the caller should capture; the capture is then in flight until
+    // OnDelivered/OnDropped.
+    bool ShouldCapture(int64_t now, bool pipelineBusy);
+
+    void OnDelivered(int64_t now);
+    void OnDropped(int count = 1);
+
+    // Returns true once per stats window (1 s) with the totals for that window in out
+    bool TakeWindowStats(int64_t now, Stats& out);
+
+    const Stats& TotalStats() const { return m_total; }
+
+  private:
+    void CloseWindow(int64_t now);
+
+    int64_t m_ticksPerSecond = 1;
+    int64_t m_targetInterval = 1;
+    int64_t m_interval = 1; // Effective (adapted) interval
+    int64_t m_nextDue = 0;
+    int64_t m_lastCall = 0;
+    int64_t m_renderPeriod = 0; // Smoothed render-loop period
+
+    int64_t m_inFlight[kMaxInFlight] = {}; // Capture times, oldest first
+    int m_inFlightCount = 0;
+
+    Stats m_total;
+    Stats m_window;
+    // Latency is sampled only for paced captures; unpaced deliveries count as delivered but carry no capture time
+    double m_windowLatencySumMs = 0.0;
+    uint64_t m_windowLatencySamples = 0;
+    uint64_t m_totalLatencySamples = 0;
+    int64_t m_windowStart = 0;
+    Stats m_lastWindow;
+    bool m_windowReady = false;
+};
@@ -0,0 +1,72 @@
+#include "virtual_camera_queue.h"
+
+#include <atomic>
+#include <cstring>
+
+namespace {
+
+constexpr uint32_t kFrameHeaderSize = 32;
+
+constexpr uint32_t AlignUp(uint32_t size, uint32_t align) { return (size + (align - 1)) & ~(align - 1); }
+
+} // namespace
+
+VirtualCameraQueueLayout ComputeVirtualCameraQueueLayout(uint32_t width, uint32_t height) {
+    VirtualCameraQueueLayout layout;
+    layout.frameSize = width * height * 3 / 2; // NV12: Y + UV/2 = 1.5 bytes per pixel
+
+    uint32_t totalSize = AlignUp(static_cast<uint32_t>(sizeof(VirtualCameraQueueHeader)), 32);
+    for (uint32_t i = 0; i < 3; ++i) {
+        layout.offsets[i] = totalSize;
+        totalSize = AlignUp(totalSize + layout.frameSize + kFrameHeaderSize, 32);
+    }
+    layout.totalSize = totalSize;
+    return layout;
+}
+
+void VirtualCameraQueue::Attach(uint8_t* base, uint32_t width, uint32_t height, uint64_t interval) {
+    m_layout = ComputeVirtualCameraQueueLayout(width, height);
+    m_base = base;
+    m_header = reinterpret_cast<VirtualCameraQueueHeader*>(base);
+    m_width = width;
+    m_height = height;
+
+    std::memset(m_header, 0, sizeof(VirtualCameraQueueHeader));
+    m_header->state = VIRTUAL_CAMERA_QUEUE_STATE_STARTING;
+    m_header->type = 0; // SHARED_QUEUE_TYPE_VIDEO
+    m_header->cx = width;
+    m_header->cy = height;
+    m_header->interval = interval;
+    for (uint32_t i = 0; i < 3; ++i) { m_header->offsets[i] = m_layout.offsets[i]; }
+}
+
+void VirtualCameraQueue::Detach() {
+    if (m_header) { m_header->state = VIRTUAL_CAMERA_QUEUE_STATE_STOPPING; }
+    m_header = nullptr;
+    m_base = nullptr;
+}
+
+VirtualCameraQueue::Slot VirtualCameraQueue::Reserve() const {
+    Slot slot;
+    if (!m_header) return slot;
+    slot.writeIdx = m_header->write_idx + 1;
+    slot.index = slot.writeIdx % 3;
+    slot.data = m_base + m_layout.offsets[slot.index] + kFrameHeaderSize;
+    return slot;
+}
+
+void VirtualCameraQueue::Commit(const Slot& slot, uint64_t timestamp) {
+    if (!m_header || !slot) return;
+
+    uint64_t* ts = reinterpret_cast<uint64_t*>(m_base + m_layout.offsets[slot.index]);
+    *ts = timestamp;
+
+    // Frame data and timestamp must be visible to the reader before the indices move
+    std::atomic_thread_fence(std::memory_order_seq_cst);
+
+    m_header->write_idx = slot.writeIdx;
+    m_header->read_idx = slot.writeIdx;
+    m_header->state = VIRTUAL_CAMERA_QUEUE_STATE_READY;
+
+    std::atomic_thread_fence(std::memory_order_seq_cst);
+}
@@ -0,0 +1,69 @@
+#pragma once
+
+#include <cstdint>
+
+// OBS Virtual Camera shared-memory queue (three NV12 frame slots behind a small header).
+// Layout and state values match obs-studio plugins/win-dshow/shared-memory-queue.c.
+// Platform-neutral: operates on an already-mapped region, so the Win32 file mapping can be swapped for any
+// other shared-memory backend (e.g. POSIX shm when exercising the queue off Windows).
+
+enum VirtualCameraQueueState : uint32_t {
+    VIRTUAL_CAMERA_QUEUE_STATE_INVALID = 0,
+    VIRTUAL_CAMERA_QUEUE_STATE_STARTING = 1,
+    VIRTUAL_CAMERA_QUEUE_STATE_READY = 2,
+    VIRTUAL_CAMERA_QUEUE_STATE_STOPPING = 3,
+};
+
+struct VirtualCameraQueueHeader {
+    volatile uint32_t write_idx;
+    volatile uint32_t read_idx;
+    volatile uint32_t state;
+    uint32_t offsets[3];
+    uint32_t type;
+    uint32_t cx;
+    uint32_t cy;
+    uint64_t interval;
+    uint32_t reserved[8];
+};
+
+struct VirtualCameraQueueLayout {
+    uint32_t frameSize = 0;    // NV12 bytes per frame
+    uint32_t offsets[3] = {}; // Slot offsets (each slot: 32-byte timestamp header + frame)
+    uint32_t totalSize = 0;    // Bytes the shared-memory mapping must provide
+};
+
+VirtualCameraQueueLayout ComputeVirtualCameraQueueLayout(uint32_t width, uint32_t height);
+
+class VirtualCameraQueue {
+  public:
+    // A reserved frame slot. The producer fills `data` (layout.frameSize bytes) then calls Commit().
+    struct Slot {
+        uint8_t* data = nullptr;
+        uint32_t index = 0;
+        uint32_t writeIdx = 0;
+
+        explicit operator bool() const { return data != nullptr; }
+    };
+
+    // base must point to a zero-or-garbage mapping of at least ComputeVirtualCameraQueueLayout().totalSize bytes
+    void Attach(uint8_t* base, uint32_t width, uint32_t height, uint64_t interval);
+    // Marks the queue STOPPING; the mapping itself is released by the backend
+    void Detach();
+
+    bool IsAttached() const { return m_header != nullptr; }
+    uint32_t Width() const { return m_width; }
+    uint32_t Height() const { return m_height; }
+    uint32_t FrameSize() const { return m_layout.frameSize; }
+
+    // Reserve the next slot for writing. Only one slot may be outstanding at a time (single producer).
+    Slot Reserve() const;
+    // Publish a filled slot: writes the timestamp, then advances write/read indices after a release fence
+    void Commit(const Slot& slot, uint64_t timestamp);
+
+  private:
+    VirtualCameraQueueHeader* m_header = nullptr;
+    uint8_t* m_base = nullptr;
+    VirtualCameraQueueLayout m_layout;
+    uint32_t m_width = 0;
+    uint32_t m_height = 0;
+};
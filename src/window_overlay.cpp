@@ -1,13 +1,17 @@
 #include "window_overlay.h"
 #include "gui.h"
+#include "overlay_capture_scheduler.h"
+#include "overlay_pixel_convert.h"
 #include "profiler.h"
 #include "render.h"
 #include "utils.h"
 #include <GL/wglew.h>
 #include <algorithm>
 #include <cmath>
+#include <condition_variable>
 #include <dwmapi.h>
 #include <iostream>
+#include <iterator>
 #include <memory>
 #include <mutex>
 #include <shared_mutex>
@@ -40,6 +44,22 @@ struct DeferredOverlayReload {
 std::vector<DeferredOverlayReload> g_deferredOverlayReloads;
 std::mutex g_deferredOverlayReloadsMutex;
 
+// Capture scheduling: the capture thread tracks windows (event hooks, reloads, GUI window list) and keeps the
+// scheduler in sync with the cache; a small worker pool pulls due overlays earliest-deadline-first and captures them.
+static OverlayCaptureScheduler g_captureScheduler;
+static std::mutex g_captureSchedulerMutex;
+static std::condition_variable g_captureSchedulerCv;
+static std::atomic<DWORD> g_windowCaptureThreadId{ 0 };
+static std::atomic<bool> g_windowListDirty{ true };     // A top-level window appeared, vanished or was renamed
+static std::atomic<bool> g_overlayWindowsDirty{ false }; // Same, consumed by the overlay handle refresh
+static constexpr int kMaxWindowCaptureWorkers = 3;
+
+// Wakes the capture thread's message wait so queued reloads and urgent captures are picked up immediately
+static void WakeWindowCaptureThread() {
+    const DWORD threadId = g_windowCaptureThreadId.load(std::memory_order_acquire);
+    if (threadId != 0) { PostThreadMessage(threadId, WM_NULL, 0, 0); }
+}
+
 // Implementation of WindowOverlayCacheEntry destructor
 WindowOverlayCacheEntry::~WindowOverlayCacheEntry() {
     if (hBitmap) {
@@ -50,10 +70,6 @@ WindowOverlayCacheEntry::~WindowOverlayCacheEntry() {
         DeleteDC(hdcMem);
         hdcMem = NULL;
     }
-    if (pixelData) {
-        delete[] pixelData;
-        pixelData = nullptr;
-    }
     // Triple-buffer cleanup is handled automatically by unique_ptr
     // Note: OpenGL texture cleanup should be done on the OpenGL thread
     // The texture will be cleaned up in CleanupWindowOverlayCacheEntry
@@ -250,15 +266,18 @@ void QueueOverlayReload(const std::string& overlayId, const WindowOverlayConfig&
         if (pending.overlayId == overlayId) {
             // Update existing entry
             pending.config = config;
+            WakeWindowCaptureThread();
             return;
         }
     }
     // Add new entry
     g_deferredOverlayReloads.push_back({ overlayId, config });
+    WakeWindowCaptureThread();
 }
 
-// Update all window overlays (refresh window handles)
-void UpdateAllWindowOverlays() {
+// Refresh window handles. ignoreSearchInterval is set when a window event says the window set just changed, so a
+// lost target is searched for right away instead of waiting out its search interval.
+static void RefreshOverlayWindowHandles(bool ignoreSearchInterval) {
     std::lock_guard<std::mutex> lock(g_windowOverlayCacheMutex);
     auto now = std::chrono::steady_clock::now();
 
@@ -274,7 +293,7 @@ void UpdateAllWindowOverlays() {
             auto elapsed = std::chrono::duration_cast<std::chrono::milliseconds>(now - entry->lastSearchTime);
             int interval = entry->searchInterval.load(std::memory_order_relaxed);
 
-            if (elapsed.count() >= interval) {
+            if (ignoreSearchInterval || elapsed.count() >= interval) {
                 entry->targetWindow =
                     FindWindowByTitleAndClass(entry->windowTitle, entry->windowClass, entry->executableName, entry->windowMatchPriority);
                 entry->lastSearchTime = now;
@@ -288,6 +307,9 @@ void UpdateAllWindowOverlays() {
     }
 }
 
+// Update all window overlays (refresh window handles)
+void UpdateAllWindowOverlays() { RefreshOverlayWindowHandles(false); }
+
 // Update window overlay FPS setting
 void UpdateWindowOverlayFPS(const std::string& overlayId, int newFPS) {
     // LOCK-FREE: fps is atomic, so we just need to get the entry pointer safely
@@ -304,6 +326,7 @@ void UpdateWindowOverlayFPS(const std::string& overlayId, int newFPS) {
         // These are atomic operations, no lock needed
         entry->fps.store(newFPS, std::memory_order_relaxed);
         entry->needsUpdate.store(true, std::memory_order_relaxed);
+        WakeWindowCaptureThread();
         Log("Updated FPS for overlay '" + overlayId + "' to " + std::to_string(newFPS));
     } else {
         // Cache entry doesn't exist yet, which is normal for new overlays
@@ -353,6 +376,33 @@ void UpdateWindowOverlay(const std::string& overlayId) {
     // This avoids expensive window enumeration on the render thread
     entry.needsUpdate.store(true, std::memory_order_relaxed);
     entry.lastSearchTime = std::chrono::steady_clock::now() - std::chrono::seconds(100); // Force immediate search
+    g_overlayWindowsDirty.store(true, std::memory_order_relaxed);
+    WakeWindowCaptureThread();
+}
+
+// (Re)allocate a render buffer for width x height RGBA. Returns false if the size is outside (0, maxBytes).
+static bool EnsureRenderDataSize(WindowOverlayRenderData& data, int width, int height, size_t maxBytes) {
+    if (data.pixelData && data.width == width && data.height == height) return true;
+    if (data.pixelData) {
+        delete[] data.pixelData;
+        data.pixelData = nullptr;
+    }
+    data.width = width;
+    data.height = height;
+    // Validate size before allocation to prevent overflow
+    size_t bufferSize = static_cast<size_t>(width) * static_cast<size_t>(height) * 4;
+    if (width <= 0 || height <= 0 || bufferSize >= maxBytes) return false;
+    data.pixelData = new unsigned char[bufferSize];
+    return true;
+}
+
+// Swap the finished write buffer into the ready slot and signal the render thread
+static void PublishOverlayWriteBuffer(WindowOverlayCacheEntry& entry) {
+    {
+        std::lock_guard<std::mutex> lock(entry.swapMutex);
+        entry.writeBuffer.swap(entry.readyBuffer);
+    }
+    entry.hasNewFrame.store(true, std::memory_order_release);
 }
 
 // Capture window content using various methods based on config
@@ -361,17 +411,8 @@ bool CaptureWindowContent(WindowOverlayCacheEntry& entry, const WindowOverlayCon
 
     if (!entry.targetWindow || !IsWindow(entry.targetWindow) || !IsWindowVisible(entry.targetWindow)) { return false; }
 
-    // Check FPS throttling
-    auto now = std::chrono::steady_clock::now();
-    auto elapsed = std::chrono::duration_cast<std::chrono::milliseconds>(now - entry.lastCaptureTime);
-    int targetInterval = 1000 / std::max(1, entry.fps.load(std::memory_order_relaxed));
-
-    if (elapsed.count() < targetInterval && !entry.needsUpdate.load(std::memory_order_relaxed)) {
-        return true; // Skip capture, too soon
-    }
-
-    entry.lastCaptureTime = now;
-    entry.needsUpdate.store(false, std::memory_order_relaxed);
+    // FPS pacing is done by the capture scheduler (see WindowCaptureWorkerFunc); every call captures
+    entry.lastCaptureTime = std::chrono::steady_clock::now();
 
     if (!entry.targetWindow || !IsWindow(entry.targetWindow)) { return false; }
 
@@ -498,29 +539,21 @@ bool CaptureWindowContent(WindowOverlayCacheEntry& entry, const WindowOverlayCon
     // This ensures we never show uninitialized memory or leaked screen content
     bool success = false;
 
-    // Ensure we have pixel data buffer with safe size validation
-    if (entry.width != captureWidth || entry.height != captureHeight) {
-        if (entry.pixelData) {
-            delete[] entry.pixelData;
-            entry.pixelData = nullptr;
-        }
-        entry.width = captureWidth;
-        entry.height = captureHeight;
-        // Validate size before allocation to prevent overflow
-        size_t bufferSize = static_cast<size_t>(captureWidth) * static_cast<size_t>(captureHeight) * 4;
-        if (bufferSize > 0 && bufferSize < 100 * 1024 * 1024) { // Sanity check: < 100MB
-            entry.pixelData = new unsigned char[bufferSize];    // RGBA
-        } else {
-            Log("[WindowOverlay] Invalid buffer size: " + std::to_string(bufferSize));
-            // Clean up GDI resources before returning
-            SelectObject(hdcMem, hOldBitmap);
-            DeleteObject(hBitmap);
-            DeleteDC(hdcMem);
-            if (hdcWindow) { ReleaseDC(entry.targetWindow, hdcWindow); }
-            ReleaseDC(NULL, hdcScreen);
-            return false;
-        }
+    // GDI writes straight into the triple buffer's write slot; the BGRA->RGBA/color-key pass then runs in place,
+    // so the frame never takes an extra copy before being handed to the render thread.
+    entry.width = captureWidth;
+    entry.height = captureHeight;
+    if (!EnsureRenderDataSize(*entry.writeBuffer, captureWidth, captureHeight, 100 * 1024 * 1024)) { // Sanity check: < 100MB
+        Log("[WindowOverlay] Invalid buffer size: " + std::to_string(static_cast<size_t>(captureWidth) * captureHeight * 4));
+        // Clean up GDI resources before returning
+        SelectObject(hdcMem, hOldBitmap);
+        DeleteObject(hBitmap);
+        DeleteDC(hdcMem);
+        if (hdcWindow) { ReleaseDC(entry.targetWindow, hdcWindow); }
+        ReleaseDC(NULL, hdcScreen);
+        return false;
     }
+    unsigned char* pixels = entry.writeBuffer->pixelData;
 
     // Convert bitmap to RGBA pixel data (will be black if capture failed)
     BITMAPINFO bmi = {};
@@ -531,84 +564,29 @@ bool CaptureWindowContent(WindowOverlayCacheEntry& entry, const WindowOverlayCon
     bmi.bmiHeader.biBitCount = 32;
     bmi.bmiHeader.biCompression = BI_RGB;
 
-    int scanlines = GetDIBits(hdcScreen, hBitmap, 0, captureHeight, entry.pixelData, &bmi, DIB_RGB_COLORS);
+    int scanlines = GetDIBits(hdcScreen, hBitmap, 0, captureHeight, pixels, &bmi, DIB_RGB_COLORS);
 
     if (scanlines == captureHeight) {
         // Convert BGRA to RGBA (even if capture failed, we still have the black cleared bitmap)
-        const int totalPixels = captureWidth * captureHeight;
-
-        // Pre-calculate color key values if enabled (optimization)
-        if (result && config.enableColorKey && !config.colorKeys.empty()) {
-            // Process each pixel and check against all color keys
-            for (int i = 0; i < totalPixels; i++) {
-                unsigned char* pixel = &entry.pixelData[i * 4];
-                std::swap(pixel[0], pixel[2]); // Swap B and R
-
-                // Get pixel color as float
-                float r = pixel[0] / 255.0f;
-                float g = pixel[1] / 255.0f;
-                float b = pixel[2] / 255.0f;
-
-                // Check against all color keys - pixel is transparent if it matches ANY key
-                bool matchesAnyKey = false;
-                for (const auto& key : config.colorKeys) {
-                    float dr = r - key.color.r;
-                    float dg = g - key.color.g;
-                    float db = b - key.color.b;
-                    float distanceSq = dr * dr + dg * dg + db * db;
-                    float sensitivitySq = key.sensitivity * key.sensitivity;
-
-                    if (distanceSq <= sensitivitySq) {
-                        matchesAnyKey = true;
-                        break; // No need to check other keys
-                    }
-                }
-
-                pixel[3] = matchesAnyKey ? 0 : 255;
-            }
-        } else {
-            // Just convert BGRA to RGBA without color key
-            for (int i = 0; i < totalPixels; i++) {
-                unsigned char* pixel = &entry.pixelData[i * 4];
-                std::swap(pixel[0], pixel[2]); // Swap B and R
-                pixel[3] = 255;                // Set alpha to fully opaque
+        const size_t totalPixels = static_cast<size_t>(captureWidth) * static_cast<size_t>(captureHeight);
+
+        // Color keys only apply to real captures; a pixel is transparent if it matches ANY key
+        std::vector<OverlayColorKey> keys;
+        if (result && config.enableColorKey) {
+            keys.reserve(config.colorKeys.size());
+            for (const auto& key : config.colorKeys) {
+                keys.push_back(MakeOverlayColorKey(key.color.r, key.color.g, key.color.b, key.sensitivity));
             }
         }
+        ConvertOverlayBGRAToRGBA(pixels, pixels, totalPixels, keys.data(), keys.size());
 
         // Mark as successful only if the actual capture succeeded
         // If capture failed, we still update with black pixels (safe fallback)
         success = true;
     }
 
-    // Mark texture for update if capture was successful
-    if (success) {
-        // Copy to write buffer for thread-safe transfer to render thread (OpenGL path)
-        if (entry.writeBuffer->width != entry.width || entry.writeBuffer->height != entry.height) {
-            if (entry.writeBuffer->pixelData) {
-                delete[] entry.writeBuffer->pixelData;
-                entry.writeBuffer->pixelData = nullptr;
-            }
-            entry.writeBuffer->width = entry.width;
-            entry.writeBuffer->height = entry.height;
-            // Validate size before allocation
-            size_t bufferSize = static_cast<size_t>(entry.width) * static_cast<size_t>(entry.height) * 4;
-            if (bufferSize > 0 && bufferSize < 100 * 1024 * 1024) { entry.writeBuffer->pixelData = new unsigned char[bufferSize]; }
-        }
-
-        if (entry.writeBuffer->pixelData && entry.pixelData) {
-            size_t copySize = static_cast<size_t>(entry.width) * static_cast<size_t>(entry.height) * 4;
-            memcpy(entry.writeBuffer->pixelData, entry.pixelData, copySize);
-
-            // Swap write and ready buffers under lock, then signal new frame available
-            {
-                std::lock_guard<std::mutex> lock(entry.swapMutex);
-                entry.writeBuffer.swap(entry.readyBuffer);
-            }
-
-            // Signal that a new frame is available for the render thread
-            entry.hasNewFrame.store(true, std::memory_order_release);
-        }
-    }
+    // Hand the frame to the render thread
+    if (success) { PublishOverlayWriteBuffer(entry); }
 
     // Cleanup
     SelectObject(hdcMem, hOldBitmap);
@@ -624,54 +602,18 @@ bool CaptureWindowContent(WindowOverlayCacheEntry& entry, const WindowOverlayCon
         int errorWidth = 64;
         int errorHeight = 64;
 
-        // Ensure we have pixel data buffer for error texture
-        if (entry.width != errorWidth || entry.height != errorHeight) {
-            if (entry.pixelData) {
-                delete[] entry.pixelData;
-                entry.pixelData = nullptr;
-            }
-            entry.width = errorWidth;
-            entry.height = errorHeight;
-            // Validate size (error texture should be small anyway)
-            size_t bufferSize = static_cast<size_t>(errorWidth) * static_cast<size_t>(errorHeight) * 4;
-            if (bufferSize > 0 && bufferSize < 1 * 1024 * 1024) { // 1MB sanity check for error texture
-                entry.pixelData = new unsigned char[bufferSize];
+        entry.width = errorWidth;
+        entry.height = errorHeight;
+        if (EnsureRenderDataSize(*entry.writeBuffer, errorWidth, errorHeight, 1 * 1024 * 1024)) { // 1MB sanity check for error texture
+            // Fill with dark blue color (RGBA: 0, 32, 96, 255)
+            unsigned char* pixels = entry.writeBuffer->pixelData;
+            for (int i = 0; i < errorWidth * errorHeight; i++) {
+                pixels[i * 4 + 0] = 0;   // R
+                pixels[i * 4 + 1] = 32;  // G
+                pixels[i * 4 + 2] = 96;  // B
+                pixels[i * 4 + 3] = 255; // A
             }
-        }
-
-        // Fill with dark blue color (RGBA: 0, 32, 96, 255)
-        for (int i = 0; i < errorWidth * errorHeight; i++) {
-            entry.pixelData[i * 4 + 0] = 0;   // R
-            entry.pixelData[i * 4 + 1] = 32;  // G
-            entry.pixelData[i * 4 + 2] = 96;  // B
-            entry.pixelData[i * 4 + 3] = 255; // A
-        }
-
-        // Copy error texture to write buffer
-        if (entry.writeBuffer->width != entry.width || entry.writeBuffer->height != entry.height) {
-            if (entry.writeBuffer->pixelData) {
-                delete[] entry.writeBuffer->pixelData;
-                entry.writeBuffer->pixelData = nullptr;
-            }
-            entry.writeBuffer->width = entry.width;
-            entry.writeBuffer->height = entry.height;
-            // Validate size before allocation
-            size_t bufferSize = static_cast<size_t>(entry.width) * static_cast<size_t>(entry.height) * 4;
-            if (bufferSize > 0 && bufferSize < 100 * 1024 * 1024) { entry.writeBuffer->pixelData = new unsigned char[bufferSize]; }
-        }
-
-        if (entry.writeBuffer->pixelData && entry.pixelData) {
-            size_t copySize = static_cast<size_t>(entry.width) * static_cast<size_t>(entry.height) * 4;
-            memcpy(entry.writeBuffer->pixelData, entry.pixelData, copySize);
-
-            // Swap write and ready buffers under lock
-            {
-                std::lock_guard<std::mutex> lock(entry.swapMutex);
-                entry.writeBuffer.swap(entry.readyBuffer);
-            }
-
-            // Signal that a new frame is available for the render thread
-            entry.hasNewFrame.store(true, std::memory_order_release);
+            PublishOverlayWriteBuffer(entry);
         }
     }
 
@@ -699,6 +641,20 @@ const WindowOverlayConfig* FindWindowOverlayConfigIn(const std::string& overlayI
     return nullptr;
 }
 
+// Per-overlay capture counters published by the capture thread. Published and removed under g_windowOverlayCacheMutex,
+// so a destroyed overlay's counters can't be re-added by a publish that raced its removal.
+static const char* const kOverlayCaptureCounters[] = { "Overlay Capture ms", "Overlay Capture Max ms", "Overlay Capture Late ms",
+                                                       "Overlay Capture Missed/s" };
+
+static std::string OverlayCaptureCounterName(const char* counter, const std::string& overlayId) {
+    return std::string(counter) + " (" + overlayId + ")";
+}
+
+static void RemoveOverlayCaptureCounters(const std::string& overlayId) {
+    auto& profiler = Profiler::GetInstance();
+    for (const char* counter : kOverlayCaptureCounters) { profiler.RemoveCounter(OverlayCaptureCounterName(counter, overlayId)); }
+}
+
 // Remove window overlay from cache without accessing config (call when you already have config access)
 void RemoveWindowOverlayFromCache(const std::string& overlayId) {
     std::lock_guard<std::mutex> cacheLock(g_windowOverlayCacheMutex);
@@ -710,6 +666,7 @@ void RemoveWindowOverlayFromCache(const std::string& overlayId) {
             it->second->glTextureId = 0;
         }
         g_windowOverlayCache.erase(it);
+        RemoveOverlayCaptureCounters(overlayId);
     }
 }
 
@@ -746,6 +703,7 @@ void CleanupWindowOverlayCacheEntry(const std::string& overlayId) {
                 it->second->glTextureId = 0;
             }
             g_windowOverlayCache.erase(it);
+            RemoveOverlayCaptureCounters(overlayId);
         }
     }
 }
@@ -770,6 +728,7 @@ void CleanupWindowOverlayCache() {
         Log("CleanupWindowOverlayCache: No valid GL context, skipping texture cleanup to avoid crashes");
     }
 
+    for (const auto& [id, entry] : g_windowOverlayCache) { RemoveOverlayCaptureCounters(id); }
     g_windowOverlayCache.clear();
 }
 
@@ -1199,12 +1158,89 @@ std::vector<WindowInfo> GetCurrentlyOpenWindows() {
 // Check if window info is still valid
 bool IsWindowInfoValid(const WindowInfo& windowInfo) { return IsWindow(windowInfo.hwnd) && IsWindowVisible(windowInfo.hwnd); }
 
-// Background capture thread function
+static int64_t CaptureSchedulerNow() {
+    LARGE_INTEGER now;
+    QueryPerformanceCounter(&now);
+    return now.QuadPart;
+}
+
+// Top-level window created/destroyed/shown/hidden/renamed. Runs on the capture thread while it pumps messages.
+static void CALLBACK WindowCaptureWinEventProc(HWINEVENTHOOK, DWORD event, HWND hwnd, LONG idObject, LONG idChild, DWORD, DWORD) {
+    if (!hwnd || idObject != OBJID_WINDOW || idChild != CHILDID_SELF) { return; }
+    // A destroyed window can no longer be asked for its parent, so don't filter those
+    if (event != EVENT_OBJECT_DESTROY && GetAncestor(hwnd, GA_PARENT) != GetDesktopWindow()) { return; }
+    g_windowListDirty.store(true, std::memory_order_relaxed);
+    g_overlayWindowsDirty.store(true, std::memory_order_relaxed);
+}
+
+// Capture one scheduled overlay (worker thread)
+static void CaptureScheduledOverlay(const std::string& overlayId) {
+    PROFILE_SCOPE_CAT("Window Overlay Capture", "Window Capture");
+    try {
+        auto captureSnap = GetConfigSnapshot();
+        const WindowOverlayConfig* config = captureSnap ? FindWindowOverlayConfigIn(overlayId, *captureSnap) : nullptr;
+        if (!config) { return; }
+
+        // Get entry pointer with minimal lock duration
+        WindowOverlayCacheEntry* entry = nullptr;
+        {
+            std::lock_guard<std::mutex> cacheLock(g_windowOverlayCacheMutex);
+            auto it = g_windowOverlayCache.find(overlayId);
+            if (it != g_windowOverlayCache.end()) { entry = it->second.get(); }
+        }
+
+        // Capture without holding the cache mutex; the entry's captureMutex guards it, and the scheduler never hands
+        // the same overlay to two workers at once
+        if (entry) { CaptureWindowContent(*entry, *config); }
+    } catch (const SE_Exception& e) {
+        LogException("CaptureScheduledOverlay (SEH) '" + overlayId + "'", e.getCode(), e.getInfo());
+    } catch (const std::exception& e) { Log("Error capturing window content for overlay '" + overlayId + "': " + e.what()); } catch (...) {
+        Log("Unknown error capturing window content for overlay '" + overlayId + "'");
+    }
+}
+
+// Capture worker: pulls the due overlay with the earliest deadline, captures it, reports completion
+static void WindowCaptureWorkerFunc() {
+    _set_se_translator(SEHTranslator);
+    Profiler::GetInstance().SetThreadName("Window Capture Worker");
+
+    std::unique_lock<std::mutex> lock(g_captureSchedulerMutex);
+    while (!g_stopWindowCaptureThread) {
+        std::string overlayId;
+        if (!g_captureScheduler.PopDue(CaptureSchedulerNow(), overlayId)) {
+            // Sleep until the next deadline; Sync()/Complete() elsewhere may bring one forward and notify
+            auto wait = std::chrono::microseconds(100000);
+            const int64_t next = g_captureScheduler.NextDeadline();
+            if (next != OverlayCaptureScheduler::kNoDeadline) {
+                LARGE_INTEGER freq;
+                QueryPerformanceFrequency(&freq);
+                const int64_t untilUs = (next - CaptureSchedulerNow()) * 1000000 / freq.QuadPart;
+                wait = std::min(wait, std::chrono::microseconds(std::max<int64_t>(untilUs, 0)));
+            }
+            g_captureSchedulerCv.wait_for(lock, wait);
+            continue;
+        }
+
+        lock.unlock();
+        const int64_t startedAt = CaptureSchedulerNow();
+        CaptureScheduledOverlay(overlayId);
+        const int64_t finishedAt = CaptureSchedulerNow();
+        lock.lock();
+
+        g_captureScheduler.Complete(overlayId, startedAt, finishedAt);
+    }
+}
+
+// Background capture thread function: window tracking and scheduling. Captures run on the worker pool.
 void WindowCaptureThreadFunc() {
     _set_se_translator(SEHTranslator);
 
+    std::vector<std::thread> workers;
+    HWINEVENTHOOK winEventHooks[2] = { NULL, NULL };
+
     try {
         Log("Window capture thread started");
+        Profiler::GetInstance().SetThreadName("Window Capture Thread");
 
         // Initialize window overlays on the background thread (avoids blocking render thread)
         // This is safe here because the window capture thread runs independently
@@ -1214,24 +1250,71 @@ void WindowCaptureThreadFunc() {
             g_windowOverlaysInitialized.store(true);
         }
 
+        // Create the message queue before publishing the thread id so WakeWindowCaptureThread() can't miss
+        MSG msg;
+        PeekMessage(&msg, NULL, WM_USER, WM_USER, PM_NOREMOVE);
+        g_windowCaptureThreadId.store(GetCurrentThreadId(), std::memory_order_release);
+
+        // Out-of-context hooks are delivered through this thread's message queue, so no DLL injection is involved.
+        // LOCATIONCHANGE sits between SHOW/HIDE and NAMECHANGE and fires constantly, hence two hooks.
+        winEventHooks[0] = SetWinEventHook(EVENT_OBJECT_CREATE, EVENT_OBJECT_HIDE, NULL, WindowCaptureWinEventProc, 0, 0,
+                                           WINEVENT_OUTOFCONTEXT | WINEVENT_SKIPOWNPROCESS);
+        winEventHooks[1] = SetWinEventHook(EVENT_OBJECT_NAMECHANGE, EVENT_OBJECT_NAMECHANGE, NULL, WindowCaptureWinEventProc, 0, 0,
+                                           WINEVENT_OUTOFCONTEXT | WINEVENT_SKIPOWNPROCESS);
+        const bool windowEventsActive = winEventHooks[0] && winEventHooks[1];
+        if (!windowEventsActive) { Log("Window event hooks unavailable (error " + std::to_string(GetLastError()) + "), polling window list"); }
+
+        {
+            LARGE_INTEGER freq;
+            QueryPerformanceFrequency(&freq);
+            std::lock_guard<std::mutex> lock(g_captureSchedulerMutex);
+            g_captureScheduler = OverlayCaptureScheduler();
+            g_captureScheduler.SetTicksPerSecond(freq.QuadPart);
+        }
+
+        const unsigned hardwareThreads = std::thread::hardware_concurrency();
+        const int workerCount = std::clamp(static_cast<int>(hardwareThreads / 4), 2, kMaxWindowCaptureWorkers);
+        for (int i = 0; i < workerCount; ++i) { workers.emplace_back(WindowCaptureWorkerFunc); }
+        Log("Started " + std::to_string(workerCount) + " window capture workers");
+
         auto lastWindowUpdateCheck = std::chrono::steady_clock::now();
-        const auto windowUpdateInterval = std::chrono::seconds(5); // Check for window changes every 5 seconds
+        const auto windowUpdateInterval = std::chrono::seconds(5); // Fallback handle refresh (respects search intervals)
+
+        auto lastWindowListUpdate = std::chrono::steady_clock::time_point{};
+        // With event hooks the list only needs a slow safety refresh; without them, poll like before
+        const auto windowListUpdateInterval = windowEventsActive ? std::chrono::milliseconds(5000) : std::chrono::milliseconds(500);
+        // Coalesce event bursts (an app opening many windows, a title that ticks); enumeration is the costly part
+        const auto windowEventDebounce = std::chrono::milliseconds(100);
+        const auto windowListEventDebounce = std::chrono::milliseconds(250);
+        auto lastWindowEventRefresh = std::chrono::steady_clock::time_point{};
 
-        auto lastWindowListUpdate = std::chrono::steady_clock::now();
-        const auto windowListUpdateInterval = std::chrono::milliseconds(500); // Update window list cache every 500ms
+        std::vector<OverlayCaptureScheduler::OverlaySpec> scheduledOverlays;
+        std::vector<std::string> urgentOverlays;
+        std::vector<OverlayCaptureScheduler::Stats> captureStats;
 
         while (!g_stopWindowCaptureThread) {
             try {
+                // Deliver window events and wake-ups
+                while (PeekMessage(&msg, NULL, 0, 0, PM_REMOVE)) { DispatchMessage(&msg); }
+
                 auto now = std::chrono::steady_clock::now();
 
-                // Periodically update window handles in case windows were closed/reopened
-                if (now - lastWindowUpdateCheck >= windowUpdateInterval) {
-                    UpdateAllWindowOverlays();
+                // Reacquire lost target windows as soon as the window set changes; poll slowly as a fallback
+                if (g_overlayWindowsDirty.load(std::memory_order_relaxed) && now - lastWindowEventRefresh >= windowEventDebounce) {
+                    g_overlayWindowsDirty.store(false, std::memory_order_relaxed);
+                    RefreshOverlayWindowHandles(true);
+                    lastWindowEventRefresh = now;
+                    lastWindowUpdateCheck = now;
+                } else if (now - lastWindowUpdateCheck >= windowUpdateInterval) {
+                    RefreshOverlayWindowHandles(false);
                     lastWindowUpdateCheck = now;
                 }
 
-                // Periodically refresh the window list cache for the GUI (non-blocking window enumeration)
-                if (now - lastWindowListUpdate >= windowListUpdateInterval) {
+                // Refresh the window list cache for the GUI (non-blocking window enumeration)
+                const bool windowListDirty = g_windowListDirty.load(std::memory_order_relaxed);
+                if ((windowListDirty && now - lastWindowListUpdate >= windowListEventDebounce) ||
+                    now - lastWindowListUpdate >= windowListUpdateInterval) {
+                    g_windowListDirty.store(false, std::memory_order_relaxed);
                     auto newWindowList = std::make_unique<std::vector<WindowInfo>>();
                     *newWindowList = GetCurrentlyOpenWindows(); // Expensive call on background thread
 
@@ -1266,53 +1349,45 @@ void WindowCaptureThreadFunc() {
                     }
                 }
 
-                // Build a list of overlay IDs and configs to capture (safer than holding pointers)
-                std::vector<std::pair<std::string, WindowOverlayConfig>> overlaysToCapture;
+                // Schedule every cached overlay that still has a config; needsUpdate pulls its next capture forward
+                scheduledOverlays.clear();
+                urgentOverlays.clear();
                 {
-                    // Use snapshot for thread-safe config access + cache lock for cache access
                     auto captureSnap = GetConfigSnapshot();
                     std::lock_guard<std::mutex> cacheLock(g_windowOverlayCacheMutex);
-
-                    const size_t cacheSize = g_windowOverlayCache.size();
-                    overlaysToCapture.reserve(cacheSize);
-
                     for (const auto& [overlayId, entry] : g_windowOverlayCache) {
-                        // Find config for this overlay from snapshot
-                        const WindowOverlayConfig* config = captureSnap ? FindWindowOverlayConfigIn(overlayId, *captureSnap) : nullptr;
-                        if (config) { overlaysToCapture.emplace_back(overlayId, *config); }
+                        if (!captureSnap || !FindWindowOverlayConfigIn(overlayId, *captureSnap)) { continue; }
+                        scheduledOverlays.push_back({ overlayId, entry->fps.load(std::memory_order_relaxed) });
+                        if (entry->needsUpdate.exchange(false, std::memory_order_relaxed)) { urgentOverlays.push_back(overlayId); }
                     }
                 }
-                // Locks released - now we can capture without blocking config/cache changes
-
-                // Process each overlay
-                for (auto& [overlayId, config] : overlaysToCapture) {
-                    if (g_stopWindowCaptureThread) { break; }
-
-                    try {
-                        // Get entry pointer with minimal lock duration
-                        WindowOverlayCacheEntry* entry = nullptr;
-                        {
-                            std::lock_guard<std::mutex> cacheLock(g_windowOverlayCacheMutex);
-                            auto it = g_windowOverlayCache.find(overlayId);
-                            if (it != g_windowOverlayCache.end()) { entry = it->second.get(); }
-                        }
-                        // Lock released - now we can capture without blocking GUI thread
-
-                        if (entry) {
-                            // Capture without holding the cache mutex
-                            // The entry's own captureMutex protects against concurrent modifications
-                            // Note: Entry deletion is only done from GUI thread via RemoveWindowOverlayFromCache,
-                            // and the capture thread checks for null before each capture
-                            CaptureWindowContent(*entry, config);
+
+                bool publishStats = false;
+                {
+                    std::lock_guard<std::mutex> lock(g_captureSchedulerMutex);
+                    const int64_t schedNow = CaptureSchedulerNow();
+                    g_captureScheduler.Sync(scheduledOverlays, schedNow);
+                    for (const auto& overlayId : urgentOverlays) { g_captureScheduler.MarkUrgent(overlayId, schedNow); }
+                    publishStats = g_captureScheduler.TakeWindowStats(schedNow, captureStats);
+                }
+                g_captureSchedulerCv.notify_all();
+
+                // Per-overlay capture latency, once per second (only for overlays that still exist)
+                if (publishStats) {
+                    auto& profiler = Profiler::GetInstance();
+                    std::lock_guard<std::mutex> cacheLock(g_windowOverlayCacheMutex);
+                    for (const auto& stats : captureStats) {
+                        if (g_windowOverlayCache.find(stats.id) == g_windowOverlayCache.end()) { continue; }
+                        const double values[] = { stats.avgCaptureMs, stats.maxCaptureMs, stats.maxLatenessMs,
+                                                  static_cast<double>(stats.missed) };
+                        for (size_t i = 0; i < std::size(kOverlayCaptureCounters); ++i) {
+                            profiler.SetCounter(OverlayCaptureCounterName(kOverlayCaptureCounters[i], stats.id), values[i]);
                         }
-                        // If entry was removed, skip this overlay (it was deleted from config)
-                    } catch (const std::exception& e) {
-                        Log("Error capturing window content for overlay '" + overlayId + "': " + e.what());
-                    } catch (...) { Log("Unknown error capturing window content for overlay '" + overlayId + "'"); }
+                    }
                 }
 
-                // Sleep for a short time to prevent excessive CPU usage
-                std::this_thread::sleep_for(std::chrono::milliseconds(16)); // ~60 FPS max
+                // Sleep until a window event or wake-up arrives; the timeout keeps fallbacks and stats ticking
+                MsgWaitForMultipleObjects(0, NULL, FALSE, 250, QS_ALLINPUT);
             } catch (const std::exception& e) { Log("Error in window capture thread: " + std::string(e.what())); } catch (...) {
                 Log("Unknown error in window capture thread");
             }
@@ -1323,6 +1398,18 @@ void WindowCaptureThreadFunc() {
         Log("EXCEPTION in WindowCaptureThreadFunc: Unknown exception");
     }
 
+    // Workers exit once g_stopWindowCaptureThread is set (also set here in case we got here through an exception)
+    g_stopWindowCaptureThread = true;
+    g_captureSchedulerCv.notify_all();
+    for (auto& worker : workers) {
+        if (worker.joinable()) { worker.join(); }
+    }
+
+    for (HWINEVENTHOOK hook : winEventHooks) {
+        if (hook) { UnhookWinEvent(hook); }
+    }
+    g_windowCaptureThreadId.store(0, std::memory_order_release);
+
     Log("Window capture thread stopped");
 }
 
@@ -1340,9 +1427,10 @@ void StopWindowCaptureThread() {
     if (g_windowCaptureThread.joinable()) {
         Log("Stopping window capture thread...");
         g_stopWindowCaptureThread = true;
+        WakeWindowCaptureThread();
 
         // Wait for thread to finish with timeout protection
-        // Note: std::thread::join() will block until thread exits
+        // Note: std::thread::join() will block until thread exits (it joins its capture workers first)
         try {
             g_windowCaptureThread.join();
             Log("Window capture thread stopped cleanly");
@@ -69,12 +69,11 @@ struct WindowOverlayCacheEntry {
     // Cached bitmap data (capture thread only)
     HBITMAP hBitmap = NULL;
     HDC hdcMem = NULL;
-    unsigned char* pixelData = nullptr;
-    int width = 0;
+    int width = 0; // Size of the last frame handed to writeBuffer
     int height = 0;
 
     // Triple-buffered render data for lock-free rendering
-    // Capture thread writes to writeBuffer, then swaps with readyBuffer
+    // Capture thread fills writeBuffer in place (GetDIBits + conversion), then swaps with readyBuffer
     // Render thread swaps readyBuffer with backBuffer, then reads from backBuffer
     std::unique_ptr<WindowOverlayRenderData> writeBuffer;
     std::unique_ptr<WindowOverlayRenderData> readyBuffer;          // Last completed capture, waiting to swap to render
@@ -128,7 +127,7 @@ struct WindowOverlayCacheEntry {
 
     // Thread safety
     std::mutex captureMutex;
-    std::atomic<bool> needsUpdate{ true };
+    std::atomic<bool> needsUpdate{ true }; // Pulls the next capture forward (consumed by the capture thread's scheduler)
 
     WindowOverlayCacheEntry() {
         writeBuffer = std::make_unique<WindowOverlayRenderData>();
@@ -247,6 +246,6 @@ extern std::chrono::steady_clock::time_point g_lastWindowListUpdate;
 // Background capture thread management
 extern std::atomic<bool> g_stopWindowCaptureThread;
 extern std::thread g_windowCaptureThread;
-void WindowCaptureThreadFunc();
+void WindowCaptureThreadFunc(); // Window tracking + scheduling; owns the capture worker pool
 void StartWindowCaptureThread();
 void StopWindowCaptureThread();
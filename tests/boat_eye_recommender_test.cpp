@@ -0,0 +1,189 @@
+// Native boat-eye ranking against scripts/boat_eye_calibrate.ps1 over the bundled boatEyeSensitivitiesv1_16.txt table.
+// The expected values come from a step-by-step transcription of the script's Compute-PixelPerfectAutoRecommendation,
+// not a live PowerShell run. The table parser follows Parse-BoatEyeSensitivitiesRaw, including its comma handling.
+
+#include "boat_eye_recommender.h"
+#include "test_util.h"
+
+#include <cmath>
+#include <string>
+
+namespace {
+
+struct ExpectedChoice {
+    int dpi;
+    int cursor;
+    double sensitivity;
+    double skipping;
+};
+
+struct ScriptCase {
+    const char* name;
+    BoatEyeRankingInput input;
+    const char* policy;
+    int choice;
+    int choiceMax;
+    bool skipFilterIgnored;
+    double closestFeelSkipping;
+    double lowestSkipping;
+    double activeRawSensitivity;
+    std::vector<ExpectedChoice> choices;
+};
+
+BoatEyeRankingInput MakeInput(int dpi, double sens, int cursor) {
+    BoatEyeRankingInput in;
+    in.currentDpi = dpi;
+    in.currentSensitivity = sens;
+    in.currentCursorSpeed = cursor;
+    return in;
+}
+
+std::vector<ScriptCase> MakeScriptCases() {
+    std::vector<ScriptCase> cases;
+
+    cases.push_back({ "defaults", MakeInput(800, 0.5, 10), "lowest-skipping", 1, 5, false, 42.27, 8.21, 0.08333333,
+                      { { 6400, 3, 0.08459541, 8.21 },
+                        { 1280, 7, 0.37946573, 42.27 },
+                        { 1600, 6, 0.328299, 33.56 },
+                        { 2133, 5, 0.26419395, 25.13 },
+                        { 3200, 4, 0.19208907, 16.92 } } });
+
+    cases.push_back({ "low sens", MakeInput(1600, 0.25, 6), "lowest-skipping", 1, 8, false, 23.25, 5.77, 0.03414364,
+                      { { 6400, 3, 0.03487502, 5.77 },
+                        { 1600, 6, 0.24885435, 23.25 },
+                        { 2133, 5, 0.19659935, 17.53 },
+                        { 1280, 7, 0.29589784, 28.96 },
+                        { 3200, 4, 0.13491601, 11.26 },
+                        { 1067, 8, 0.33434, 35.06 },
+                        { 914, 9, 0.36975592, 40.44 },
+                        { 800, 10, 0.40076026, 46.6 } } });
+
+    BoatEyeRankingInput preferred = MakeInput(400, 0.83, 10);
+    preferred.preferredCursorSpeed = 8;
+    preferred.lowestSkipChoiceOne = false;
+    cases.push_back({ "balanced with cursor preference", preferred, "balanced-similarity", 1, 4, false, 46.27, 5.77, 0.39952074,
+                      { { 1600, 4, 0.39900824, 46.27 },
+                        { 3200, 3, 0.24792656, 23.13 },
+                        { 6400, 2, 0.12392015, 11.26 },
+                        { 12800, 1, 0.03254452, 5.77 } } });
+
+    BoatEyeRankingInput ranked = MakeInput(800, 0.5, 10);
+    ranked.lowestSkipChoiceOne = false;
+    ranked.preferHigherDpi = true;
+    ranked.recommendationChoice = 3;
+    cases.push_back({ "ranked choice, prefer higher DPI", ranked, "ranked-choice", 3, 5, false, 42.27, 8.21, 0.26760399,
+                      { { 1280, 7, 0.37946573, 42.27 },
+                        { 1600, 6, 0.328299, 33.56 },
+                        { 2133, 5, 0.26419395, 25.13 },
+                        { 3200, 4, 0.19208907, 16.92 },
+                        { 6400, 3, 0.08459541, 8.21 } } });
+
+    BoatEyeRankingInput noCursor = MakeInput(3200, 0.05, 12);
+    noCursor.includeCursorInRanking = false;
+    noCursor.lowestSkipChoiceOne = false;
+    noCursor.maxRecommendedPixelSkipping = 5.0;
+    cases.push_back({ "cursor excluded, tight skip filter", noCursor, "lowest-skipping", 1, 1, false, 4.55, 4.55, 0.00153918,
+                      { { 4800, 10, 0.00467673, 4.55 } } });
+
+    BoatEyeRankingInput ignored = MakeInput(800, 0.9, 20);
+    ignored.maxRecommendedPixelSkipping = 0.1;
+    cases.push_back({ "skip filter ignored", ignored, "lowest-skipping", 1, 12, true, 220.69, 7.77, 0.07282415,
+                      { { 22400, 3, 0.0735192, 7.77 },
+                        { 800, 20, 0.89943063, 220.69 },
+                        { 862, 19, 0.86936665, 204.94 },
+                        { 933, 18, 0.83817714, 189.4 },
+                        { 1018, 17, 0.8047475, 172.65 },
+                        { 1120, 16, 0.7698747, 157.45 },
+                        { 1244, 15, 0.7312624, 141.69 },
+                        { 1400, 14, 0.69007534, 126.27 },
+                        { 1600, 13, 0.64658564, 110.12 },
+                        { 1867, 12, 0.59649515, 94.7 },
+                        { 2240, 11, 0.5411559, 78.78 },
+                        { 2800, 10, 0.47942224, 63.02 } } });
+    return cases;
+}
+
+bool Near(double a, double b, double tolerance = 1e-9) { return std::abs(a - b) <= tolerance; }
+
+void TestAgainstScript(const BoatEyeSensitivityTable& table) {
+    for (const ScriptCase& expected : MakeScriptCases()) {
+        const BoatEyeRecommendation rec = ComputeBoatEyePixelPerfectRecommendation(table, expected.input);
+        CHECK_MSG(rec.ok, "%s: %s", expected.name, rec.error.c_str());
+        if (!rec.ok) continue;
+        CHECK_MSG(rec.selectionPolicy == expected.policy, "%s: policy %s", expected.name, rec.selectionPolicy.c_str());
+        CHECK_MSG(rec.recommendationChoice == expected.choice, "%s", expected.name);
+        CHECK_MSG(rec.recommendationChoiceMax == expected.choiceMax, "%s: %d choices", expected.name, rec.recommendationChoiceMax);
+        CHECK_MSG(rec.skipFilterIgnored == expected.skipFilterIgnored, "%s", expected.name);
+        CHECK_MSG(Near(rec.closestFeelPixelSkipping, expected.closestFeelSkipping), "%s", expected.name);
+        CHECK_MSG(Near(rec.lowestPixelSkipping, expected.lowestSkipping), "%s", expected.name);
+        CHECK_MSG(Near(rec.active.rawSensitivity, expected.activeRawSensitivity), "%s: raw %.8f", expected.name, rec.active.rawSensitivity);
+
+        CHECK_MSG(rec.choices.size() == expected.choices.size(), "%s", expected.name);
+        for (size_t i = 0; i < rec.choices.size() && i < expected.choices.size(); ++i) {
+            const BoatEyeCandidate& c = rec.choices[i];
+            const ExpectedChoice& e = expected.choices[i];
+            CHECK_MSG(c.rank == static_cast<int>(i) + 1, "%s #%zu", expected.name, i + 1);
+            CHECK_MSG(c.targetDpiRounded == e.dpi && c.targetCursorSpeed == e.cursor, "%s #%zu: DPI %d cursor %d", expected.name, i + 1,
+                      c.targetDpiRounded, c.targetCursorSpeed);
+            CHECK_MSG(Near(c.selectedSensitivity, e.sensitivity), "%s #%zu: sens %.8f", expected.name, i + 1, c.selectedSensitivity);
+            CHECK_MSG(Near(c.pixelSkipping, e.skipping), "%s #%zu: skip %.2f", expected.name, i + 1, c.pixelSkipping);
+        }
+        const ExpectedChoice& active = expected.choices[expected.choice - 1];
+        CHECK_MSG(rec.active.targetDpiRounded == active.dpi && Near(rec.active.selectedSensitivity, active.sensitivity), "%s: active",
+                  expected.name);
+    }
+}
+
+void TestTargetMapped(const BoatEyeSensitivityTable& table) {
+    // Same DPI and cursor: the raw sensitivity maps onto itself and snaps between its two neighbouring table entries
+    const BoatEyeRecommendation rec = ComputeBoatEyeTargetMappedRecommendation(table, MakeInput(800, 0.5, 10), 800, 10);
+    CHECK(rec.ok);
+    CHECK(rec.selectionPolicy == "target-mapped");
+    CHECK(Near(rec.active.rawSensitivity, 0.5));
+    CHECK(rec.active.HasSecondary());
+    CHECK(rec.active.primarySensitivity <= 0.5 && rec.active.secondarySensitivity >= 0.5);
+}
+
+void TestParse() {
+    BoatEyeSensitivityTable table;
+    std::string error;
+
+    const std::string text = "\xEF\xBB\xBF"
+                             "First column: sensitivity\r\n"
+                             "0.25 0.01 4096 5\r\n"
+                             "+0.5\t1\n"
+                             "0,75 0,02 4096 8\r"
+                             ".125\n"
+                             "1.5 out of range\n"
+                             "inf\n"
+                             "0.25 duplicate\n"
+                             "\n";
+    CHECK(ParseBoatEyeSensitivityTable(text, table, error));
+    // "0,75" is 0 to the script: its number pattern stops at ',', so the comma fallback never applies
+    CHECK(table.sensitivity == (std::vector<double>{ 0.0, 0.125, 0.25, 0.5 }));
+    CHECK(table.pixelSkipping.size() == table.sensitivity.size());
+    CHECK(table.parsedFirstColumnCount == 6);
+    CHECK(table.acceptedRangeCount == 5);
+
+    CHECK(!ParseBoatEyeSensitivityTable("header only\n0.5\n", table, error));
+    CHECK(!error.empty());
+}
+
+} // namespace
+
+int main() {
+    TestParse();
+
+    BoatEyeSensitivityTable table;
+    std::string error;
+    const bool loaded =
+        LoadBoatEyeSensitivityTable(std::filesystem::path(TOOLSCREEN_SCRIPTS_DIR) / "resources" / "boat_eye_senses" / "boatEyeSensitivitiesv1_16.txt",
+                                    table, error);
+    CHECK_MSG(loaded, "%s", error.c_str());
+    if (loaded) {
+        CHECK(table.sensitivity.size() == 853);
+        TestAgainstScript(table);
+        TestTargetMapped(table);
+    }
+    return TestResult("boat_eye_recommender_test");
+}
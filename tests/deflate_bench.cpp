@@ -0,0 +1,47 @@
+// DeflateEncoder against zlib at levels 1, 6 and 9 on a synthetic latest.log, plus CRC-32 and Adler-32 throughput.
+// Reports compressed size as a percentage of the input and MB/s of input, best of 3. Usage: deflate_bench [megabytes]
+
+#include "deflate.h"
+#include "deflate_fixture.h"
+#include "test_util.h"
+
+#include <zlib.h>
+
+#include <cstdlib>
+
+int main(int argc, char** argv) {
+    const size_t megabytes = argc > 1 ? static_cast<size_t>(std::atoll(argv[1])) : 16;
+    const std::vector<uint8_t> input = MakeSyntheticLog(megabytes << 20);
+    const double mb = static_cast<double>(input.size()) / (1 << 20);
+    std::printf("%zu MB synthetic log\n", megabytes);
+
+    std::vector<uint8_t> ours;
+    std::vector<uint8_t> theirs(compressBound(static_cast<uLong>(input.size())));
+    for (const int level : { 1, 6, 9 }) {
+        const double t = BestSeconds(
+            [&] {
+                ours.clear();
+                ZlibCompress(input.data(), input.size(), ours, level);
+            },
+            3);
+        uLongf zlibSize = 0;
+        const double tz = BestSeconds(
+            [&] {
+                zlibSize = static_cast<uLongf>(theirs.size());
+                compress2(theirs.data(), &zlibSize, input.data(), static_cast<uLong>(input.size()), level);
+            },
+            3);
+        std::printf("  level %d: %6.2f%% at %6.1f MB/s   (zlib %6.2f%% at %6.1f MB/s)\n", level, 100.0 * ours.size() / input.size(), mb / t,
+                    100.0 * zlibSize / input.size(), mb / tz);
+    }
+
+    // Fold the results into the output so the loops can't be dropped
+    uint32_t ourCrc = 0, zlibCrc = 0, ourAdler = 0, zlibAdler = 0;
+    const double crc = BestSeconds([&] { ourCrc = Crc32(input.data(), input.size()); }, 3);
+    const double crcZ = BestSeconds([&] { zlibCrc = static_cast<uint32_t>(crc32(0, input.data(), static_cast<uInt>(input.size()))); }, 3);
+    const double adler = BestSeconds([&] { ourAdler = Adler32(input.data(), input.size()); }, 3);
+    const double adlerZ = BestSeconds([&] { zlibAdler = static_cast<uint32_t>(adler32(1, input.data(), static_cast<uInt>(input.size()))); }, 3);
+    std::printf("  CRC-32:   %6.2f GB/s   (zlib %6.2f GB/s)%s\n", mb / 1024 / crc, mb / 1024 / crcZ, ourCrc == zlibCrc ? "" : " (MISMATCH)");
+    std::printf("  Adler-32: %6.2f GB/s   (zlib %6.2f GB/s)%s\n", mb / 1024 / adler, mb / 1024 / adlerZ, ourAdler == zlibAdler ? "" : " (MISMATCH)");
+    return 0;
+}
@@ -0,0 +1,31 @@
+#pragma once
+
+#include <cstdint>
+#include <cstdio>
+#include <random>
+#include <string>
+#include <vector>
+
+// Synthetic latest.log text for the deflate test and benchmark: timestamped lines from a handful of threads with
+// repeating message templates and varying numbers, about what the log rotation compresses.
+inline std::vector<uint8_t> MakeSyntheticLog(size_t bytes, uint32_t seed = 1) {
+    static const char* kThreads[] = { "Render Thread", "Mirror Thread", "Logic Thread", "Main", "OBS Hook" };
+    static const char* kMessages[] = { "Frame submitted, sequence %u, latency %u us", "Mirror '%u' capture resized to %ux720",
+                                       "Config snapshot published (revision %u, %u mirrors)", "WARNING: fence wait took %u.%u ms",
+                                       "Mode switch Thin -> Wide, slide %u/%u" };
+    std::mt19937 rng(seed);
+    std::vector<uint8_t> out;
+    out.reserve(bytes + 256);
+    char line[256];
+    char message[160];
+    uint32_t seconds = 0;
+    while (out.size() < bytes) {
+        seconds += rng() % 3;
+        std::snprintf(message, sizeof(message), kMessages[rng() % 5], rng() % 100000, rng() % 1000);
+        const int n = std::snprintf(line, sizeof(line), "[%02u:%02u:%02u] [%s/INFO]: %s\n", seconds / 3600 % 24, seconds / 60 % 60,
+                                    seconds % 60, kThreads[rng() % 5], message);
+        out.insert(out.end(), line, line + n);
+    }
+    out.resize(bytes);
+    return out;
+}
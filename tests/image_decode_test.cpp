@@ -0,0 +1,435 @@
+// Image decode layer: stills and GIFs decode to bottom-row-first RGBA with their frame delays, large animations
+// stream in ordered parts whose bytes are tracked until released (and decoding waits on that budget), a single frame
+// past the stream threshold is delivered whole and never counted as in flight, and the decoded-image cache decodes
+// each content key once, evicts least recently used entries within its budget and skips what it can't cache. Also the
+// content key and the decode pool. Inputs are synthesized PPM and GIF files.
+
+#include "image_decode.h"
+#include "test_util.h"
+
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <cstdio>
+#include <memory>
+#include <string>
+#include <thread>
+#include <vector>
+
+namespace {
+
+// Binary PPM (P6): stb_image reads it like any other still
+std::vector<uint8_t> MakePpm(int w, int h) {
+    char header[64];
+    const int n = std::snprintf(header, sizeof(header), "P6\n%d %d\n255\n", w, h);
+    std::vector<uint8_t> out(header, header + n);
+    for (int y = 0; y < h; ++y) {
+        for (int x = 0; x < w; ++x) {
+            out.push_back(static_cast<uint8_t>(x));
+            out.push_back(static_cast<uint8_t>(y));
+            out.push_back(static_cast<uint8_t>(x ^ y));
+        }
+    }
+    return out;
+}
+
+// Palette used by MakeGif; index i is this color
+void GifColor(int i, uint8_t rgb[3]) {
+    rgb[0] = static_cast<uint8_t>(i);
+    rgb[1] = static_cast<uint8_t>(255 - i);
+    rgb[2] = static_cast<uint8_t>(i * 7);
+}
+
+int GifIndex(int frame, int x, int y) { return (frame * 31 + x + y * 3) & 0xFF; }
+
+void PutLe16(std::vector<uint8_t>& out, int v) {
+    out.push_back(static_cast<uint8_t>(v & 0xFF));
+    out.push_back(static_cast<uint8_t>(v >> 8));
+}
+
+// Full-canvas frames of GifIndex() pixels. The LZW data is 9-bit literals with a clear code often enough that the
+// code size never grows, which every decoder accepts.
+std::vector<uint8_t> MakeGif(int w, int h, int frames, int delayCs) {
+    std::vector<uint8_t> out = { 'G', 'I', 'F', '8', '9', 'a' };
+    PutLe16(out, w);
+    PutLe16(out, h);
+    out.insert(out.end(), { 0xF7, 0, 0 }); // 256-entry global color table
+    for (int i = 0; i < 256; ++i) {
+        uint8_t rgb[3];
+        GifColor(i, rgb);
+        out.insert(out.end(), rgb, rgb + 3);
+    }
+
+    for (int f = 0; f < frames; ++f) {
+        out.insert(out.end(), { 0x21, 0xF9, 4, 0x04 }); // Graphic control: leave in place
+        PutLe16(out, delayCs);
+        out.insert(out.end(), { 0, 0 });
+        out.push_back(0x2C);
+        PutLe16(out, 0);
+        PutLe16(out, 0);
+        PutLe16(out, w);
+        PutLe16(out, h);
+        out.push_back(0);
+        out.push_back(8); // LZW minimum code size
+
+        std::vector<uint8_t> lzw;
+        uint32_t bits = 0;
+        int bitCount = 0;
+        auto emit = [&](int code) {
+            bits |= static_cast<uint32_t>(code) << bitCount;
+            bitCount += 9;
+            while (bitCount >= 8) {
+                lzw.push_back(static_cast<uint8_t>(bits & 0xFF));
+                bits >>= 8;
+                bitCount -= 8;
+            }
+        };
+        int sinceClear = 0;
+        emit(256);
+        for (int y = 0; y < h; ++y) {
+            for (int x = 0; x < w; ++x) {
+                if (sinceClear == 200) {
+                    emit(256);
+                    sinceClear = 0;
+                }
+                emit(GifIndex(f, x, y));
+                ++sinceClear;
+            }
+        }
+        emit(257);
+        if (bitCount > 0) lzw.push_back(static_cast<uint8_t>(bits & 0xFF));
+        for (size_t pos = 0; pos < lzw.size(); pos += 255) {
+            const size_t n = std::min<size_t>(255, lzw.size() - pos);
+            out.push_back(static_cast<uint8_t>(n));
+            out.insert(out.end(), lzw.begin() + pos, lzw.begin() + pos + n);
+        }
+        out.push_back(0);
+    }
+    out.push_back(0x3B);
+    return out;
+}
+
+bool GifFrameMatches(const std::vector<uint8_t>& rgba, int w, int h, int frame) {
+    for (int y = 0; y < h; ++y) {
+        for (int x = 0; x < w; ++x) {
+            uint8_t rgb[3];
+            GifColor(GifIndex(frame, x, y), rgb);
+            const uint8_t* p = rgba.data() + (static_cast<size_t>(h - 1 - y) * w + x) * 4; // Stored bottom row first
+            if (p[0] != rgb[0] || p[1] != rgb[1] || p[2] != rgb[2] || p[3] != 255) return false;
+        }
+    }
+    return true;
+}
+
+std::vector<DecodedImagePart> DecodeAll(const std::vector<uint8_t>& data, const ImageDecodeLimits& limits, bool& ok) {
+    std::vector<DecodedImagePart> parts;
+    std::string error;
+    ok = DecodeImage(data.data(), data.size(), limits, nullptr, [&](DecodedImagePart&& part) { parts.push_back(std::move(part)); }, error);
+    return parts;
+}
+
+void TestStill() {
+    bool ok = false;
+    const auto parts = DecodeAll(MakePpm(5, 3), ImageDecodeLimits(), ok);
+    CHECK(ok);
+    CHECK(parts.size() == 1 && parts[0].IsWhole());
+    if (parts.size() != 1) return;
+    const DecodedImage& image = *parts[0].image;
+    CHECK(image.width == 5 && image.height == 3);
+    CHECK(image.frames.size() == 1 && image.frameDelays.size() == 1 && image.frameDelays[0] == 100);
+    bool pixelsOk = true;
+    for (int y = 0; y < 3; ++y) {
+        for (int x = 0; x < 5; ++x) {
+            const uint8_t* p = image.frames[0].data() + (static_cast<size_t>(2 - y) * 5 + x) * 4;
+            pixelsOk = pixelsOk && p[0] == x && p[1] == y && p[2] == (x ^ y) && p[3] == 255;
+        }
+    }
+    CHECK(pixelsOk);
+    CHECK(StreamedImageBytesInFlight() == 0);
+}
+
+void TestAnimatedGif() {
+    bool ok = false;
+    const auto parts = DecodeAll(MakeGif(40, 30, 4, 5), ImageDecodeLimits(), ok);
+    CHECK(ok);
+    CHECK(parts.size() == 1 && parts[0].IsWhole());
+    if (parts.size() != 1) return;
+    const DecodedImage& image = *parts[0].image;
+    CHECK(image.width == 40 && image.height == 30);
+    CHECK(image.frames.size() == 4);
+    for (size_t f = 0; f < image.frames.size(); ++f) {
+        CHECK_MSG(GifFrameMatches(image.frames[f], 40, 30, static_cast<int>(f)), "frame %zu", f);
+        CHECK(image.frameDelays[f] == 50);
+    }
+}
+
+void TestCorruptInput() {
+    std::vector<uint8_t> gif = MakeGif(16, 16, 1, 5);
+    gif.resize(20); // Header and part of the color table only
+    std::string error;
+    int parts = 0;
+    CHECK(!DecodeImage(gif.data(), gif.size(), ImageDecodeLimits(), nullptr, [&](DecodedImagePart&&) { ++parts; }, error));
+    CHECK(parts == 0 && !error.empty());
+    const uint8_t junk[] = { 1, 2, 3, 4, 5, 6, 7, 8 };
+    CHECK(!DecodeImage(junk, sizeof(junk), ImageDecodeLimits(), nullptr, [&](DecodedImagePart&&) { ++parts; }, error));
+    CHECK(!DecodeImage(nullptr, 0, ImageDecodeLimits(), nullptr, [&](DecodedImagePart&&) { ++parts; }, error));
+    CHECK(parts == 0);
+}
+
+void TestStreamedAnimation() {
+    // 64x64 frames are 16 KB: stream past 3 frames, 2 frames per part
+    ImageDecodeLimits limits;
+    limits.streamThresholdBytes = 48 * 1024;
+    limits.streamPartBytes = 32 * 1024;
+    limits.maxStreamedBytesInFlight = 1u << 30;
+    bool ok = false;
+    auto parts = DecodeAll(MakeGif(64, 64, 9, 2), limits, ok);
+    CHECK(ok);
+    CHECK_MSG(parts.size() > 1, "%zu parts", parts.size());
+
+    size_t nextFrame = 0, bytes = 0;
+    for (size_t i = 0; i < parts.size(); ++i) {
+        const DecodedImagePart& part = parts[i];
+        CHECK(!part.IsWhole());
+        CHECK(part.firstFrame == nextFrame);
+        CHECK(part.lastPart == (i + 1 == parts.size()));
+        for (size_t f = 0; f < part.image->frames.size(); ++f) {
+            CHECK_MSG(GifFrameMatches(part.image->frames[f], 64, 64, static_cast<int>(nextFrame + f)), "frame %zu", nextFrame + f);
+        }
+        nextFrame += part.image->frames.size();
+        bytes += part.image->ByteSize();
+    }
+    CHECK(nextFrame == 9);
+    CHECK(StreamedImageBytesInFlight() == bytes);
+    parts.clear();
+    CHECK(StreamedImageBytesInFlight() == 0);
+}
+
+// A still (or one-frame GIF) past the threshold arrives whole, so it may be cached; it must not hold the streaming
+// budget while it lives, or every later streamed decode would stall behind it
+void TestLargeSingleFrameIsNotStreamed() {
+    ImageDecodeLimits limits;
+    limits.streamThresholdBytes = 16 * 1024;
+    limits.maxStreamedBytesInFlight = 32 * 1024;
+    DecodedImageCache cache(1u << 20);
+    const auto ppm = MakePpm(128, 128); // 64 KB decoded
+    bool ranDecode = false;
+    std::shared_ptr<const DecodedImage> image = cache.GetOrDecode(
+        MakeImageContentKey(ppm.data(), ppm.size()),
+        [&]() -> std::shared_ptr<const DecodedImage> {
+            bool ok = false;
+            const auto parts = DecodeAll(ppm, limits, ok);
+            CHECK(ok && parts.size() == 1 && parts[0].IsWhole());
+            return ok && parts.size() == 1 ? parts[0].image : nullptr;
+        },
+        ranDecode);
+    CHECK(ranDecode && image);
+    CHECK(cache.BytesUsed() == 128 * 128 * 4);
+    CHECK_MSG(StreamedImageBytesInFlight() == 0, "%zu bytes in flight", StreamedImageBytesInFlight());
+
+    // With that image still cached, a streamed decode still runs to completion
+    limits.streamPartBytes = 16 * 1024;
+    limits.maxStreamedBytesInFlight = 64 * 1024;
+    std::atomic<bool> cancel{ false };
+    std::atomic<bool> done{ false };
+    bool ok = false;
+    size_t partCount = 0;
+    const auto gif = MakeGif(64, 64, 6, 2);
+    std::thread decoder([&] {
+        std::string error;
+        ok = DecodeImage(gif.data(), gif.size(), limits, &cancel, [&](DecodedImagePart&&) { ++partCount; }, error);
+        done.store(true);
+    });
+    for (int i = 0; i < 500 && !done.load(); ++i) std::this_thread::sleep_for(std::chrono::milliseconds(10));
+    CHECK(done.load());
+    cancel.store(true);
+    decoder.join();
+    CHECK(ok && partCount > 1);
+    image.reset();
+    CHECK(StreamedImageBytesInFlight() == 0);
+}
+
+void TestStreamingBackPressure() {
+    ImageDecodeLimits limits;
+    limits.streamThresholdBytes = 16 * 1024;
+    limits.streamPartBytes = 16 * 1024;           // One 64x64 frame per part
+    limits.maxStreamedBytesInFlight = 40 * 1024; // Two parts
+    const auto gif = MakeGif(64, 64, 8, 2);
+
+    // The consumer holds every part: decoding stops at the budget until cancelled
+    std::atomic<bool> cancel{ false };
+    std::atomic<size_t> delivered{ 0 };
+    std::vector<DecodedImagePart> held;
+    bool ok = true;
+    std::thread decoder([&] {
+        std::string error;
+        ok = DecodeImage(gif.data(), gif.size(), limits, &cancel,
+                         [&](DecodedImagePart&& part) {
+                             held.push_back(std::move(part));
+                             delivered.fetch_add(1);
+                         },
+                         error);
+    });
+    std::this_thread::sleep_for(std::chrono::milliseconds(200));
+    CHECK_MSG(delivered.load() == 2, "%zu parts delivered", delivered.load());
+    CHECK(StreamedImageBytesInFlight() <= limits.maxStreamedBytesInFlight);
+    cancel.store(true);
+    decoder.join();
+    CHECK(!ok);
+    held.clear();
+    CHECK(StreamedImageBytesInFlight() == 0);
+
+    // Released parts let it continue
+    cancel.store(false);
+    size_t frames = 0;
+    std::string error;
+    CHECK(DecodeImage(gif.data(), gif.size(), limits, &cancel, [&](DecodedImagePart&& part) { frames += part.image->frames.size(); }, error));
+    CHECK(frames == 8);
+    CHECK(StreamedImageBytesInFlight() == 0);
+}
+
+std::shared_ptr<const DecodedImage> MakeImage(int w, int h) {
+    auto image = std::make_shared<DecodedImage>();
+    image->width = w;
+    image->height = h;
+    image->frames.emplace_back(static_cast<size_t>(w) * h * 4, uint8_t(0x5A));
+    image->frameDelays.push_back(100);
+    return image;
+}
+
+void TestContentKey() {
+    std::vector<uint8_t> a = MakePpm(33, 7);
+    std::vector<uint8_t> b = a;
+    const ImageContentKey ka = MakeImageContentKey(a.data(), a.size());
+    CHECK(!(ka < MakeImageContentKey(b.data(), b.size())) && !(MakeImageContentKey(b.data(), b.size()) < ka));
+    b[b.size() / 2] ^= 1;
+    const ImageContentKey kb = MakeImageContentKey(b.data(), b.size());
+    CHECK(ka.hash != kb.hash);
+    const ImageContentKey shorter = MakeImageContentKey(a.data(), a.size() - 1);
+    CHECK(shorter.size == a.size() - 1 && (shorter < ka || ka < shorter));
+}
+
+void TestCache() {
+    const size_t imageBytes = 64 * 64 * 4;
+    DecodedImageCache cache(imageBytes * 3);
+    auto key = [](uint64_t n) {
+        ImageContentKey k;
+        k.hash = n;
+        k.size = 1;
+        return k;
+    };
+    int decodes = 0;
+    auto decode = [&]() -> std::shared_ptr<const DecodedImage> {
+        ++decodes;
+        return MakeImage(64, 64);
+    };
+    bool ranDecode = false;
+
+    const auto first = cache.GetOrDecode(key(1), decode, ranDecode);
+    CHECK(ranDecode && decodes == 1);
+    CHECK(cache.GetOrDecode(key(1), decode, ranDecode) == first && !ranDecode && decodes == 1);
+
+    // LRU: touching 1 makes 2 the oldest when 4 arrives
+    cache.GetOrDecode(key(2), decode, ranDecode);
+    cache.GetOrDecode(key(3), decode, ranDecode);
+    cache.GetOrDecode(key(1), decode, ranDecode);
+    cache.GetOrDecode(key(4), decode, ranDecode);
+    CHECK(decodes == 4);
+    CHECK(cache.BytesUsed() == imageBytes * 3);
+    cache.GetOrDecode(key(1), decode, ranDecode);
+    CHECK(!ranDecode);
+    cache.GetOrDecode(key(2), decode, ranDecode);
+    CHECK(ranDecode && decodes == 5);
+
+    // Failed or streamed decodes (nullptr) and images over the whole budget aren't kept
+    cache.GetOrDecode(key(9), [] { return std::shared_ptr<const DecodedImage>(); }, ranDecode);
+    CHECK(ranDecode);
+    cache.GetOrDecode(key(9), [] { return std::shared_ptr<const DecodedImage>(); }, ranDecode);
+    CHECK(ranDecode);
+    const auto huge = cache.GetOrDecode(key(10), [] { return MakeImage(128, 128); }, ranDecode);
+    CHECK(huge && cache.BytesUsed() == imageBytes * 3);
+    cache.GetOrDecode(key(10), [] { return MakeImage(128, 128); }, ranDecode);
+    CHECK(ranDecode);
+
+    cache.Clear();
+    CHECK(cache.BytesUsed() == 0);
+    cache.GetOrDecode(key(1), decode, ranDecode);
+    CHECK(ranDecode);
+}
+
+// Loads of the same content submitted together decode once
+void TestCacheConcurrentMisses() {
+    DecodedImageCache cache(1u << 20);
+    ImageContentKey key;
+    key.hash = 42;
+    key.size = 1;
+    std::atomic<int> decodes{ 0 };
+    std::atomic<int> ran{ 0 };
+    std::vector<std::thread> threads;
+    std::vector<std::shared_ptr<const DecodedImage>> results(8);
+    for (size_t t = 0; t < results.size(); ++t) {
+        threads.emplace_back([&, t] {
+            bool ranDecode = false;
+            results[t] = cache.GetOrDecode(
+                key,
+                [&] {
+                    decodes.fetch_add(1);
+                    std::this_thread::sleep_for(std::chrono::milliseconds(50));
+                    return MakeImage(16, 16);
+                },
+                ranDecode);
+            if (ranDecode) ran.fetch_add(1);
+        });
+    }
+    for (auto& thread : threads) thread.join();
+    CHECK(decodes.load() == 1 && ran.load() == 1);
+    bool same = true;
+    for (const auto& r : results) same = same && r && r == results[0];
+    CHECK(same);
+}
+
+void TestPool() {
+    std::atomic<int> ran{ 0 };
+    {
+        ImageDecodePool pool(3);
+        CHECK(pool.ThreadCount() == 3);
+        for (int i = 0; i < 100; ++i) pool.Submit([&] { ran.fetch_add(1); });
+        for (int i = 0; i < 500 && ran.load() < 100; ++i) std::this_thread::sleep_for(std::chrono::milliseconds(2));
+        CHECK(ran.load() == 100);
+    }
+
+    // Shutdown drops queued jobs, lets the running one finish and ignores later submissions
+    ImageDecodePool pool(1);
+    std::atomic<bool> started{ false };
+    std::atomic<bool> release{ false };
+    ran.store(0);
+    pool.Submit([&] {
+        started.store(true);
+        while (!release.load()) std::this_thread::sleep_for(std::chrono::milliseconds(1));
+        ran.fetch_add(1);
+    });
+    for (int i = 0; i < 10; ++i) pool.Submit([&] { ran.fetch_add(1); });
+    while (!started.load()) std::this_thread::sleep_for(std::chrono::milliseconds(1));
+    std::thread stopper([&] { pool.Shutdown(); });
+    std::this_thread::sleep_for(std::chrono::milliseconds(20));
+    release.store(true);
+    stopper.join();
+    pool.Submit([&] { ran.fetch_add(1); });
+    CHECK_MSG(ran.load() == 1, "%d jobs ran", ran.load());
+}
+
+} // namespace
+
+int main() {
+    TestStill();
+    TestAnimatedGif();
+    TestCorruptInput();
+    TestStreamedAnimation();
+    TestLargeSingleFrameIsNotStreamed();
+    TestStreamingBackPressure();
+    TestContentKey();
+    TestCache();
+    TestCacheConcurrentMisses();
+    TestPool();
+    return TestResult("image_decode_test");
+}
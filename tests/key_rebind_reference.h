@@ -0,0 +1,40 @@
+#pragma once
+
+#include "key_rebind_table.h"
+
+#include <cstdint>
+#include <vector>
+
+// The WndProc's lookup before KeyRebindTable: a linear scan with RebindKeyMatchesInput's modifier-family rules. Side
+// state stands in for GetAsyncKeyState. Shared by the rebind table test and its latency benchmark.
+
+inline bool ReferenceRebindMatches(uint32_t inputVk, uint32_t fromKey, bool isKeyDown, const bool* sideDown) {
+    if (inputVk == fromKey) return true;
+    auto matchesFamily = [&](uint32_t genericKey, uint32_t leftKey, uint32_t rightKey) {
+        const bool inputIsGeneric = inputVk == genericKey;
+        const bool inputIsSpecific = inputVk == leftKey || inputVk == rightKey;
+        const bool fromIsGeneric = fromKey == genericKey;
+        const bool fromIsSpecific = fromKey == leftKey || fromKey == rightKey;
+        if (!(inputIsGeneric || inputIsSpecific) || !(fromIsGeneric || fromIsSpecific)) return false;
+        if (inputIsGeneric && fromIsSpecific) return isKeyDown ? sideDown[fromKey] : true;
+        return inputIsSpecific && fromIsGeneric;
+    };
+    return matchesFamily(0x11, 0xA2, 0xA3) || matchesFamily(0x10, 0xA0, 0xA1) || matchesFamily(0x12, 0xA4, 0xA5);
+}
+
+// Index of the first rebind that fires, or -1
+inline int ReferenceFirstRebind(const std::vector<KeyRebindSpec>& specs, uint32_t inputVk, bool isKeyDown, const bool* sideDown) {
+    for (size_t i = 0; i < specs.size(); ++i) {
+        if (ReferenceRebindMatches(inputVk, specs[i].fromKey, isKeyDown, sideDown)) return static_cast<int>(i);
+    }
+    return -1;
+}
+
+// The WndProc's lookup with the compiled table
+inline int TableFirstRebind(const KeyRebindTable& table, uint32_t inputVk, bool isKeyDown, const bool* sideDown) {
+    for (const KeyRebindCandidate& candidate : table.Candidates(inputVk)) {
+        if (candidate.requiresSideCheck && isKeyDown && !sideDown[table.Spec(candidate.specIndex).fromKey]) continue;
+        return candidate.specIndex;
+    }
+    return -1;
+}
@@ -0,0 +1,41 @@
+// Rebind lookup latency: ns per key message for the compiled KeyRebindTable against the old linear scan, over a
+// stream of random key events, for a few rebind-list sizes. Usage: key_rebind_table_bench [events]
+
+#include "key_rebind_reference.h"
+#include "test_util.h"
+
+#include <cstdlib>
+#include <random>
+
+int main(int argc, char** argv) {
+    const size_t events = argc > 1 ? static_cast<size_t>(std::atoll(argv[1])) : 5000000;
+    std::mt19937 rng(42);
+    std::vector<uint32_t> keys(events);
+    for (auto& key : keys) key = 1 + rng() % 255;
+    bool sideDown[256] = {};
+
+    for (const size_t rebindCount : { 4u, 16u, 64u, 256u }) {
+        std::vector<KeyRebindSpec> specs(rebindCount);
+        for (auto& spec : specs) {
+            spec.fromKey = 1 + rng() % 255;
+            spec.outputVk = 1 + rng() % 255;
+        }
+        double t0 = BenchSeconds();
+        KeyRebindTable table;
+        table.Build(specs);
+        const double buildMs = (BenchSeconds() - t0) * 1000.0;
+
+        // Sum the results so neither loop can be optimized away
+        long long sink = 0;
+        t0 = BenchSeconds();
+        for (size_t i = 0; i < events; ++i) sink += ReferenceFirstRebind(specs, keys[i], (i & 1) != 0, sideDown);
+        const double scanNs = (BenchSeconds() - t0) * 1e9 / events;
+        t0 = BenchSeconds();
+        for (size_t i = 0; i < events; ++i) sink -= TableFirstRebind(table, keys[i], (i & 1) != 0, sideDown);
+        const double tableNs = (BenchSeconds() - t0) * 1e9 / events;
+
+        std::printf("%4zu rebinds: linear scan %7.2f ns/event, table %6.2f ns/event, build %.3f ms%s\n", rebindCount, scanNs, tableNs,
+                    buildMs, sink == 0 ? "" : " (MISMATCH)");
+    }
+    return 0;
+}
@@ -0,0 +1,73 @@
+// KeyRebindTable against the linear scan it replaced: for random rebind sets, every input VK, key up/down and every
+// modifier side state, the compiled lookup fires the same first rebind.
+
+#include "key_rebind_reference.h"
+#include "test_util.h"
+
+#include <random>
+
+namespace {
+
+// Biased toward the modifier VKs, where generic/sided matching makes the table non-trivial
+uint32_t RandomKey(std::mt19937& rng) {
+    static constexpr uint32_t kModifiers[] = { 0x10, 0x11, 0x12, 0xA0, 0xA1, 0xA2, 0xA3, 0xA4, 0xA5 };
+    if (rng() % 3 == 0) return kModifiers[rng() % std::size(kModifiers)];
+    return 1 + rng() % 255;
+}
+
+void TestMatchesLinearScan() {
+    std::mt19937 rng(1234);
+    for (int round = 0; round < 200; ++round) {
+        std::vector<KeyRebindSpec> specs(1 + rng() % 40);
+        for (auto& spec : specs) {
+            spec.fromKey = RandomKey(rng);
+            spec.outputVk = RandomKey(rng);
+        }
+        KeyRebindTable table;
+        table.Build(specs);
+        CHECK(!table.Empty());
+
+        bool sideDown[256] = {};
+        for (int sides = 0; sides < 64; ++sides) {
+            for (int bit = 0; bit < 6; ++bit) sideDown[0xA0 + bit] = (sides >> bit) & 1;
+            for (uint32_t vk = 0; vk < 256; ++vk) {
+                for (const bool isKeyDown : { false, true }) {
+                    const int expected = ReferenceFirstRebind(specs, vk, isKeyDown, sideDown);
+                    const int actual = TableFirstRebind(table, vk, isKeyDown, sideDown);
+                    CHECK_MSG(expected == actual, "round %d vk 0x%02X down %d sides %d: expected %d, got %d", round, vk, isKeyDown, sides,
+                              expected, actual);
+                    if (expected != actual) return;
+                }
+            }
+        }
+    }
+}
+
+void TestEdges() {
+    KeyRebindTable table;
+    table.Build({});
+    CHECK(table.Empty());
+    CHECK(table.Candidates(0x41).empty());
+    CHECK(table.Candidates(300).empty());
+
+    // Config order wins: both rebinds match Left Shift, the first one listed fires
+    table.Build({ { 0x10, 0x41, 0, false }, { 0xA0, 0x42, 0, false } });
+    bool sideDown[256] = {};
+    CHECK(TableFirstRebind(table, 0xA0, true, sideDown) == 0);
+    // Generic Shift input with a sided rebind needs that side held on key-down, but not on key-up
+    table.Build({ { 0xA1, 0x41, 0, false } });
+    CHECK(TableFirstRebind(table, 0x10, true, sideDown) == -1);
+    CHECK(TableFirstRebind(table, 0x10, false, sideDown) == 0);
+    sideDown[0xA1] = true;
+    CHECK(TableFirstRebind(table, 0x10, true, sideDown) == 0);
+    // Sided input never matches the other side
+    CHECK(TableFirstRebind(table, 0xA0, true, sideDown) == -1);
+}
+
+} // namespace
+
+int main() {
+    TestEdges();
+    TestMatchesLinearScan();
+    return TestResult("key_rebind_table_test");
+}
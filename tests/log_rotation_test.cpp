@@ -0,0 +1,264 @@
+// Log rotation: archive naming, the previous session's log archived and gzipped at Open, size and age limits,
+// retention of the newest generations, leftovers from an interrupted session cleaned up, and the writer never
+// waiting on a compression in progress. Archives are read back through zlib.
+
+#include "deflate.h"
+#include "deflate_fixture.h"
+#include "log_rotation.h"
+#include "test_util.h"
+
+#include <zlib.h>
+
+#include <algorithm>
+#include <filesystem>
+#include <fstream>
+#include <iterator>
+#include <string>
+#include <thread>
+#include <vector>
+
+namespace fs = std::filesystem;
+
+namespace {
+
+fs::path FreshDir(const char* name) {
+    const fs::path dir = fs::temp_directory_path() / name;
+    fs::remove_all(dir);
+    fs::create_directories(dir);
+    return dir;
+}
+
+std::vector<uint8_t> ReadBytes(const fs::path& path) {
+    std::ifstream in(path, std::ios::binary);
+    return std::vector<uint8_t>((std::istreambuf_iterator<char>(in)), std::istreambuf_iterator<char>());
+}
+
+void WriteBytes(const fs::path& path, const std::vector<uint8_t>& bytes) {
+    std::ofstream(path, std::ios::binary).write(reinterpret_cast<const char*>(bytes.data()), static_cast<std::streamsize>(bytes.size()));
+}
+
+bool Gunzip(const std::vector<uint8_t>& compressed, std::vector<uint8_t>& out) {
+    z_stream zs{};
+    if (inflateInit2(&zs, 15 + 16) != Z_OK) return false;
+    zs.next_in = const_cast<Bytef*>(compressed.data());
+    zs.avail_in = static_cast<uInt>(compressed.size());
+    out.clear();
+    uint8_t buf[65536];
+    int ret = Z_OK;
+    while (ret == Z_OK) {
+        zs.next_out = buf;
+        zs.avail_out = sizeof(buf);
+        ret = inflate(&zs, Z_NO_FLUSH);
+        out.insert(out.end(), buf, buf + (sizeof(buf) - zs.avail_out));
+    }
+    inflateEnd(&zs);
+    return ret == Z_STREAM_END && zs.avail_in == 0;
+}
+
+// Sorted file names in `dir`, optionally only archive names
+std::vector<std::string> ListFiles(const fs::path& dir, bool archivesOnly) {
+    std::vector<std::string> names;
+    for (const auto& entry : fs::directory_iterator(dir)) {
+        const std::string name = entry.path().filename().string();
+        if (!archivesOnly || IsLogArchiveName(name)) names.push_back(name);
+    }
+    std::sort(names.begin(), names.end());
+    return names;
+}
+
+bool EndsWith(const std::string& s, const std::string& suffix) {
+    return s.size() >= suffix.size() && s.compare(s.size() - suffix.size(), suffix.size(), suffix) == 0;
+}
+
+// The worker runs at its own pace; poll for the state it should settle in
+template <typename Pred> bool WaitFor(Pred&& pred) {
+    for (int i = 0; i < 6000; ++i) { // 30 s, for sanitizer builds
+        if (pred()) return true;
+        std::this_thread::sleep_for(std::chrono::milliseconds(5));
+    }
+    return pred();
+}
+
+bool AllCompressed(const fs::path& dir, size_t count) {
+    const auto archives = ListFiles(dir, true);
+    return archives.size() == count && std::all_of(archives.begin(), archives.end(), [](const std::string& n) { return EndsWith(n, ".gz"); });
+}
+
+void TestArchiveNames() {
+    CHECK(IsLogArchiveName("20260101_120000.log"));
+    CHECK(IsLogArchiveName("20260101_120000.log.gz"));
+    CHECK(IsLogArchiveName("20260101_120000_3.log"));
+    CHECK(IsLogArchiveName("20260101_120000_123.log.gz"));
+    CHECK(!IsLogArchiveName("latest.log"));
+    CHECK(!IsLogArchiveName("20260101_120000.log.gz.tmp"));
+    CHECK(!IsLogArchiveName("20260101-120000.log"));
+    CHECK(!IsLogArchiveName("20260101_120000_.log"));
+    CHECK(!IsLogArchiveName("20260101_120000_last.log"));
+    CHECK(!IsLogArchiveName("20260101_120000.txt"));
+}
+
+void TestSessionStart() {
+    const fs::path dir = FreshDir("toolscreen_log_rotation_start");
+    const auto previous = MakeSyntheticLog(300000, 7);
+    WriteBytes(dir / "latest.log", previous);
+    // Leftovers of an interrupted session: a partial .gz, and an archive whose .gz was completed but not yet cleaned up
+    WriteBytes(dir / "20200101_000000.log.gz.tmp", { 1, 2, 3 });
+    WriteBytes(dir / "20200101_000001.log", previous);
+    CHECK(CompressFileToGzip(dir / "20200101_000001.log", dir / "20200101_000001.log.gz"));
+
+    LogRotator rotator;
+    std::ofstream file;
+    CHECK(rotator.Open(dir / "latest.log", LogRotationPolicy(), file));
+    CHECK(file.is_open());
+    CHECK(fs::file_size(dir / "latest.log") == 0);
+
+    CHECK(WaitFor([&] { return AllCompressed(dir, 2); }));
+    rotator.Stop();
+    const auto names = ListFiles(dir, false);
+    CHECK_MSG(names.size() == 3, "%zu files", names.size()); // Two archives and latest.log, no .tmp
+    CHECK(std::find(names.begin(), names.end(), "20200101_000001.log.gz") != names.end());
+    for (const auto& name : names) {
+        if (!IsLogArchiveName(name)) continue;
+        std::vector<uint8_t> decoded;
+        CHECK_MSG(Gunzip(ReadBytes(dir / name), decoded) && decoded == previous, "%s", name.c_str());
+    }
+    fs::remove_all(dir);
+}
+
+void TestSizeLimit() {
+    const fs::path dir = FreshDir("toolscreen_log_rotation_size");
+    LogRotationPolicy policy;
+    policy.maxBytes = 1000;
+    policy.maxAge = std::chrono::seconds(0);
+    policy.compress = false;
+    LogRotator rotator;
+    std::ofstream file;
+    CHECK(rotator.Open(dir / "latest.log", policy, file));
+
+    const std::string line(99, 'x');
+    int rotations = 0;
+    for (int i = 0; i < 35; ++i) {
+        file << line << '\n';
+        const bool rotated = rotator.OnWrite(line.size() + 1, file);
+        CHECK_MSG(rotated == (i % 10 == 9), "write %d", i);
+        rotations += rotated;
+    }
+    file.flush();
+    rotator.Stop();
+    CHECK(rotations == 3);
+
+    // Same-second rotations get distinct names rather than overwriting each other
+    const auto archives = ListFiles(dir, true);
+    CHECK_MSG(archives.size() == 3, "%zu archives", archives.size());
+    for (const auto& name : archives) CHECK_MSG(fs::file_size(dir / name) == 1000, "%s", name.c_str());
+    CHECK(fs::file_size(dir / "latest.log") == 500);
+    fs::remove_all(dir);
+}
+
+void TestAgeLimit() {
+    const fs::path dir = FreshDir("toolscreen_log_rotation_age");
+    LogRotationPolicy policy;
+    policy.maxBytes = 0;
+    policy.maxAge = std::chrono::seconds(1);
+    policy.compress = false;
+    LogRotator rotator;
+    std::ofstream file;
+    CHECK(rotator.Open(dir / "latest.log", policy, file));
+
+    file << "early\n";
+    CHECK(!rotator.OnWrite(6, file));
+    std::this_thread::sleep_for(std::chrono::milliseconds(1100));
+    file << "late\n";
+    CHECK(rotator.OnWrite(5, file));
+    CHECK(!rotator.OnWrite(0, file)); // The age limit restarts with the new file
+    rotator.Stop();
+    CHECK(ListFiles(dir, true).size() == 1);
+    fs::remove_all(dir);
+}
+
+void TestRetention() {
+    const fs::path dir = FreshDir("toolscreen_log_rotation_keep");
+    LogRotationPolicy policy;
+    policy.maxBytes = 100;
+    policy.maxAge = std::chrono::seconds(0);
+    policy.keepGenerations = 3;
+    LogRotator rotator;
+    std::ofstream file;
+    CHECK(rotator.Open(dir / "latest.log", policy, file));
+
+    // Eight generations, each filled with its own number
+    for (int generation = 0; generation < 8; ++generation) {
+        const std::string text(100, static_cast<char>('0' + generation));
+        file << text;
+        CHECK(rotator.OnWrite(text.size(), file));
+    }
+    CHECK(WaitFor([&] { return AllCompressed(dir, 3); }));
+    rotator.Stop();
+
+    // The newest three survive
+    const auto archives = ListFiles(dir, true);
+    CHECK_MSG(archives.size() == 3, "%zu archives", archives.size());
+    std::vector<char> kept;
+    for (const auto& name : archives) {
+        std::vector<uint8_t> decoded;
+        CHECK(Gunzip(ReadBytes(dir / name), decoded) && decoded.size() == 100);
+        if (!decoded.empty()) kept.push_back(static_cast<char>(decoded[0]));
+    }
+    std::sort(kept.begin(), kept.end());
+    CHECK((kept == std::vector<char>{ '5', '6', '7' }));
+    fs::remove_all(dir);
+}
+
+// The writer keeps logging and rotating while a large archive compresses; Stop() mid-compression keeps the source
+// archive, and the next Open() finishes the job
+void TestWriterDoesNotWaitForCompression() {
+    const fs::path dir = FreshDir("toolscreen_log_rotation_busy");
+    const auto previous = MakeSyntheticLog(8u << 20, 3);
+    WriteBytes(dir / "latest.log", previous);
+
+    LogRotationPolicy policy;
+    policy.maxBytes = 64 * 1024; // A few rotations, none pruned
+    policy.maxAge = std::chrono::seconds(0);
+    LogRotator rotator;
+    std::ofstream file;
+    CHECK(rotator.Open(dir / "latest.log", policy, file));
+
+    const std::string line(127, 'y');
+    double worst = 0.0;
+    for (int i = 0; i < 2000; ++i) {
+        const double t0 = BenchSeconds();
+        file << line << '\n';
+        rotator.OnWrite(line.size() + 1, file);
+        file.flush(); // What the crash path does
+        worst = std::max(worst, BenchSeconds() - t0);
+    }
+    CHECK_MSG(worst < 0.1, "a write took %.1f ms", worst * 1000.0);
+    rotator.Stop();
+    file.close();
+
+    for (const auto& name : ListFiles(dir, false)) CHECK_MSG(!EndsWith(name, ".tmp"), "%s left behind", name.c_str());
+    const size_t generations = ListFiles(dir, true).size();
+
+    LogRotator next;
+    CHECK(next.Open(dir / "latest.log", policy, file));
+    CHECK(WaitFor([&] { return AllCompressed(dir, generations + 1); }));
+    next.Stop();
+
+    // The previous session's 8 MB log is the oldest archive
+    const auto archives = ListFiles(dir, true);
+    std::vector<uint8_t> decoded;
+    CHECK(!archives.empty() && Gunzip(ReadBytes(dir / archives.front()), decoded) && decoded == previous);
+    fs::remove_all(dir);
+}
+
+} // namespace
+
+int main() {
+    TestArchiveNames();
+    TestSessionStart();
+    TestSizeLimit();
+    TestAgeLimit();
+    TestRetention();
+    TestWriterDoesNotWaitForCompression();
+    return TestResult("log_rotation_test");
+}
@@ -0,0 +1,144 @@
+// Mirror batch packing and uniform layout: packed rects stay inside the atlas and maxSize, never overlap and keep a
+// 1-texel gutter between neighbours; packing fails cleanly when rects can't fit; MirrorFilterInstanceStd140 has the
+// std140 offsets the batched filter shaders declare; and BuildMirrorFilterInstance carries every field across,
+// including the clip rect the vertex shader clamps each quad to.
+
+#include "mirror_batch.h"
+#include "test_util.h"
+
+#include <cstddef>
+#include <random>
+#include <vector>
+
+namespace {
+
+// True if a and b are at least one texel apart on some axis
+bool Separated(const MirrorAtlasRect& a, const MirrorAtlasRect& b) {
+    return a.x + a.w + 1 <= b.x || b.x + b.w + 1 <= a.x || a.y + a.h + 1 <= b.y || b.y + b.h + 1 <= a.y;
+}
+
+void CheckPacking(const char* name, const std::vector<MirrorAtlasRect>& sizes, int maxSize) {
+    std::vector<MirrorAtlasRect> rects;
+    int atlasW = -1, atlasH = -1;
+    CHECK_MSG(PackMirrorAtlas(sizes, maxSize, rects, atlasW, atlasH), "%s", name);
+    CHECK_MSG(rects.size() == sizes.size(), "%s", name);
+    CHECK_MSG(atlasW > 0 && atlasH > 0 && atlasW <= maxSize && atlasH <= maxSize, "%s: atlas %dx%d", name, atlasW, atlasH);
+
+    int outOfBounds = 0, wrongSize = 0, touching = 0;
+    for (size_t i = 0; i < rects.size(); ++i) {
+        const MirrorAtlasRect& r = rects[i];
+        if (r.w != sizes[i].w || r.h != sizes[i].h) ++wrongSize;
+        if (r.x < 0 || r.y < 0 || r.x + r.w > atlasW || r.y + r.h > atlasH) ++outOfBounds;
+        for (size_t j = i + 1; j < rects.size(); ++j) {
+            if (!Separated(r, rects[j])) ++touching;
+        }
+    }
+    CHECK_MSG(wrongSize == 0, "%s: %d rects changed size", name, wrongSize);
+    CHECK_MSG(outOfBounds == 0, "%s: %d rects out of bounds", name, outOfBounds);
+    CHECK_MSG(touching == 0, "%s: %d pairs overlap or share an edge", name, touching);
+}
+
+void TestPacking() {
+    CheckPacking("one", { { 0, 0, 300, 200 } }, 4096);
+    CheckPacking("equal", std::vector<MirrorAtlasRect>(16, { 0, 0, 64, 64 }), 4096);
+    CheckPacking("one texel", std::vector<MirrorAtlasRect>(50, { 0, 0, 1, 1 }), 64);
+    CheckPacking("full width", { { 0, 0, 512, 10 }, { 0, 0, 512, 10 }, { 0, 0, 3, 3 } }, 512);
+
+    // 90 mirrors of mixed shapes, as a busy config might have
+    std::mt19937 rng(35);
+    std::vector<MirrorAtlasRect> mixed;
+    for (int i = 0; i < 90; ++i) mixed.push_back({ 0, 0, 1 + static_cast<int>(rng() % 400), 1 + static_cast<int>(rng() % 300) });
+    CheckPacking("mixed", mixed, 8192);
+
+    std::vector<MirrorAtlasRect> rects;
+    int atlasW = -1, atlasH = -1;
+    CHECK(PackMirrorAtlas({}, 4096, rects, atlasW, atlasH));
+    CHECK(rects.empty() && atlasW == 0 && atlasH == 0);
+}
+
+void TestPackingFailures() {
+    std::vector<MirrorAtlasRect> rects;
+    int atlasW = 0, atlasH = 0;
+    CHECK(!PackMirrorAtlas({ { 0, 0, 257, 10 } }, 256, rects, atlasW, atlasH)); // Wider than maxSize
+    CHECK(!PackMirrorAtlas({ { 0, 0, 10, 257 } }, 256, rects, atlasW, atlasH)); // Taller than maxSize
+    CHECK(!PackMirrorAtlas({ { 0, 0, 0, 10 } }, 256, rects, atlasW, atlasH));
+    CHECK(!PackMirrorAtlas({ { 0, 0, 10, -1 } }, 256, rects, atlasW, atlasH));
+    // Each fits alone, but with gutters four 128x128 rects need 257 texels either way
+    CHECK(!PackMirrorAtlas(std::vector<MirrorAtlasRect>(4, { 0, 0, 128, 128 }), 256, rects, atlasW, atlasH));
+    CHECK(PackMirrorAtlas(std::vector<MirrorAtlasRect>(4, { 0, 0, 127, 127 }), 256, rects, atlasW, atlasH));
+}
+
+void TestStd140Layout() {
+    // Every member of the GLSL MirrorFilterInstance is a vec4/ivec4 (or an array of them): 16-byte aligned and packed
+    CHECK(offsetof(MirrorFilterInstanceStd140, dstRect) == 0);
+    CHECK(offsetof(MirrorFilterInstanceStd140, srcRect) == 16);
+    CHECK(offsetof(MirrorFilterInstanceStd140, clipRect) == 32);
+    CHECK(offsetof(MirrorFilterInstanceStd140, outputColor) == 48);
+    CHECK(offsetof(MirrorFilterInstanceStd140, targetColors) == 64);
+    CHECK(sizeof(MirrorFilterInstanceStd140::targetColors) == 16 * MIRROR_BATCH_MAX_TARGET_COLORS);
+    CHECK(offsetof(MirrorFilterInstanceStd140, params) == 64 + 16 * MIRROR_BATCH_MAX_TARGET_COLORS);
+    CHECK(offsetof(MirrorFilterInstanceStd140, misc) == offsetof(MirrorFilterInstanceStd140, params) + 16);
+    CHECK(sizeof(MirrorFilterInstanceStd140) == offsetof(MirrorFilterInstanceStd140, misc) + 16);
+    // A full draw's block fits the smallest UBO size GL guarantees
+    CHECK(sizeof(MirrorFilterInstanceStd140) * MIRROR_BATCH_MAX_INSTANCES <= 16384);
+}
+
+void TestBuildInstance() {
+    const float colors[10][3] = { { 0.1f, 0.2f, 0.3f }, { 0.4f, 0.5f, 0.6f }, { 0.7f, 0.8f, 0.9f }, { 1, 0, 0 }, { 0, 1, 0 },
+                                  { 0, 0, 1 },          { 1, 1, 0 },          { 0, 1, 1 },          { 1, 0, 1 }, { 1, 1, 1 } };
+    MirrorFilterInstanceDesc desc;
+    desc.dst = { 10, 20, 300, 200 };
+    desc.clip = { 12, 22, 150, 100 };
+    desc.srcRect[0] = 0.25f;
+    desc.srcRect[1] = 0.5f;
+    desc.srcRect[2] = 0.125f;
+    desc.srcRect[3] = 0.0625f;
+    desc.mode = MirrorFilterMode::ColorPassthrough;
+    desc.targetColors = colors;
+    desc.targetColorCount = 3;
+    desc.outputColor[0] = 1.0f;
+    desc.outputColor[3] = 0.5f;
+    desc.sensitivity = 0.07f;
+    desc.gammaMode = 2;
+    desc.colorLutLayer = 5;
+
+    const MirrorFilterInstanceStd140 inst = BuildMirrorFilterInstance(desc);
+    CHECK(inst.dstRect[0] == 10 && inst.dstRect[1] == 20 && inst.dstRect[2] == 300 && inst.dstRect[3] == 200);
+    CHECK(inst.clipRect[0] == 12 && inst.clipRect[1] == 22 && inst.clipRect[2] == 150 && inst.clipRect[3] == 100);
+    CHECK(inst.srcRect[0] == 0.25f && inst.srcRect[1] == 0.5f && inst.srcRect[2] == 0.125f && inst.srcRect[3] == 0.0625f);
+    CHECK(inst.outputColor[0] == 1.0f && inst.outputColor[1] == 0.0f && inst.outputColor[3] == 0.5f);
+    CHECK(inst.params[0] == static_cast<int32_t>(MirrorFilterMode::ColorPassthrough));
+    CHECK(inst.params[1] == 3 && inst.params[2] == 2 && inst.params[3] == 5);
+    CHECK(inst.misc[0] == 0.07f);
+    for (int i = 0; i < 3; ++i) CHECK(inst.targetColors[i][0] == colors[i][0] && inst.targetColors[i][2] == colors[i][2]);
+    CHECK(inst.targetColors[3][0] == 0.0f && inst.targetColors[3][1] == 0.0f); // Unused slots stay zero
+
+    // More colors than the block holds are cut at its size; the count follows
+    desc.targetColorCount = 10;
+    const MirrorFilterInstanceStd140 capped = BuildMirrorFilterInstance(desc);
+    CHECK(capped.params[1] == MIRROR_BATCH_MAX_TARGET_COLORS);
+    CHECK(capped.targetColors[MIRROR_BATCH_MAX_TARGET_COLORS - 1][0] == colors[MIRROR_BATCH_MAX_TARGET_COLORS - 1][0]);
+
+    // A clip rect equal to the packed mirror rect passes through unchanged for every rect of a real packing
+    std::vector<MirrorAtlasRect> rects;
+    int atlasW = 0, atlasH = 0;
+    CHECK(PackMirrorAtlas({ { 0, 0, 40, 30 }, { 0, 0, 17, 90 }, { 0, 0, 64, 8 } }, 1024, rects, atlasW, atlasH));
+    for (const MirrorAtlasRect& r : rects) {
+        MirrorFilterInstanceDesc d;
+        d.dst = { r.x - 3, r.y - 3, r.w + 6, r.h + 6 }; // A region bigger than its mirror
+        d.clip = r;
+        const MirrorFilterInstanceStd140 i = BuildMirrorFilterInstance(d);
+        CHECK(i.clipRect[0] == r.x && i.clipRect[1] == r.y && i.clipRect[2] == r.w && i.clipRect[3] == r.h);
+        CHECK(i.params[3] == -1 && i.params[1] == 0);
+    }
+}
+
+} // namespace
+
+int main() {
+    TestPacking();
+    TestPackingFailures();
+    TestStd140Layout();
+    TestBuildInstance();
+    return TestResult("mirror_batch_test");
+}
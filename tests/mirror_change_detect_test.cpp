@@ -0,0 +1,113 @@
+// Mirror change-detection reference: cells are hashed texel for texel up to MIRROR_HASH_MAX_CELL_SAMPLES per axis and
+// stride-sampled beyond that, and the result matches an independent transcription of mt_change_hash_frag_shader.
+
+#include "mirror_change_detect.h"
+#include "test_util.h"
+
+#include <algorithm>
+#include <cstdint>
+#include <vector>
+
+namespace {
+
+std::vector<uint8_t> MakeImage(int w, int h) {
+    std::vector<uint8_t> rgba(static_cast<size_t>(w) * h * 4);
+    uint32_t state = 12345;
+    for (auto& b : rgba) {
+        state = state * 1664525u + 1013904223u;
+        b = static_cast<uint8_t>(state >> 24);
+    }
+    return rgba;
+}
+
+uint64_t Digest(const std::vector<uint8_t>& rgba, int texW, int texH, const MirrorHashRegion& region) {
+    int gridW, gridH;
+    MirrorHashGridSize(region, gridW, gridH);
+    std::vector<uint32_t> cells(static_cast<size_t>(gridW) * gridH);
+    ComputeMirrorCellHashes(rgba.data(), texW, texH, region, gridW, gridH, cells.data());
+    return CombineMirrorCellHashes(cells.data(), cells.size(), MIRROR_DIGEST_SEED);
+}
+
+// Line-for-line port of the GLSL main(), one cell at a time
+uint32_t ShaderCellHash(const std::vector<uint8_t>& rgba, int texW, int texH, const MirrorHashRegion& region, int gridW, int gridH,
+                        int cellX, int cellY) {
+    int x0 = region.x + cellX * region.w / gridW;
+    int x1 = region.x + (cellX + 1) * region.w / gridW;
+    int y0 = region.y + cellY * region.h / gridH;
+    int y1 = region.y + (cellY + 1) * region.h / gridH;
+    const int kMaxSamples = 8;
+    int strideX = (x1 - x0 > kMaxSamples) ? (x1 - x0 + kMaxSamples - 1) / kMaxSamples : 1;
+    int strideY = (y1 - y0 > kMaxSamples) ? (y1 - y0 + kMaxSamples - 1) / kMaxSamples : 1;
+
+    uint32_t hash = 2166136261u;
+    for (int y = y0; y < y1; y += strideY) {
+        for (int x = x0; x < x1; x += strideX) {
+            const uint8_t* p = rgba.data() + (static_cast<size_t>(std::clamp(y, 0, texH - 1)) * texW + std::clamp(x, 0, texW - 1)) * 4;
+            hash = (hash ^ (p[0] | (p[1] << 8) | (p[2] << 16) | (static_cast<uint32_t>(p[3]) << 24))) * 16777619u;
+        }
+    }
+    return hash;
+}
+
+void TestMatchesShader() {
+    const int texW = 400, texH = 300;
+    const auto rgba = MakeImage(texW, texH);
+    const MirrorHashRegion regions[] = { { 0, 0, 1, 1 }, { 10, 20, 37, 11 }, { 5, 5, 128, 128 }, { 0, 0, 400, 300 }, { 390, 290, 30, 30 } };
+    for (const auto& region : regions) {
+        int gridW, gridH;
+        MirrorHashGridSize(region, gridW, gridH);
+        std::vector<uint32_t> cells(static_cast<size_t>(gridW) * gridH);
+        ComputeMirrorCellHashes(rgba.data(), texW, texH, region, gridW, gridH, cells.data());
+        for (int cy = 0; cy < gridH; ++cy) {
+            for (int cx = 0; cx < gridW; ++cx) {
+                CHECK_MSG(cells[cy * gridW + cx] == ShaderCellHash(rgba, texW, texH, region, gridW, gridH, cx, cy), "region %dx%d cell %d,%d",
+                          region.w, region.h, cx, cy);
+            }
+        }
+    }
+}
+
+void TestSmallRegionsSeeEveryTexel() {
+    // 16 cells * 8 samples: every texel of a 128x128 region is hashed
+    const int texW = 160, texH = 160;
+    const MirrorHashRegion region{ 16, 16, 128, 128 };
+    auto rgba = MakeImage(texW, texH);
+    const uint64_t base = Digest(rgba, texW, texH, region);
+    for (int y = region.y; y < region.y + region.h; y += 7) {
+        for (int x = region.x; x < region.x + region.w; x += 5) {
+            uint8_t& g = rgba[(static_cast<size_t>(y) * texW + x) * 4 + 1];
+            g ^= 1;
+            CHECK_MSG(Digest(rgba, texW, texH, region) != base, "change at %d,%d missed", x, y);
+            g ^= 1;
+        }
+    }
+    CHECK(Digest(rgba, texW, texH, region) == base);
+}
+
+void TestLargeRegionsAreStrided() {
+    // 1024-wide region: 64-texel cells hashed every 8th texel
+    CHECK(MirrorHashSampleStride(8) == 1);
+    CHECK(MirrorHashSampleStride(9) == 2);
+    CHECK(MirrorHashSampleStride(64) == 8);
+
+    const int texW = 1024, texH = 1024;
+    const MirrorHashRegion region{ 0, 0, 1024, 1024 };
+    auto rgba = MakeImage(texW, texH);
+    const uint64_t base = Digest(rgba, texW, texH, region);
+
+    rgba[(static_cast<size_t>(8) * texW + 16) * 4] ^= 0x80; // Sampled texel
+    CHECK(Digest(rgba, texW, texH, region) != base);
+    rgba[(static_cast<size_t>(8) * texW + 16) * 4] ^= 0x80;
+
+    rgba[(static_cast<size_t>(9) * texW + 17) * 4] ^= 0x80; // Between samples
+    CHECK(Digest(rgba, texW, texH, region) == base);
+}
+
+} // namespace
+
+int main() {
+    TestMatchesShader();
+    TestSmallRegionsSeeEveryTexel();
+    TestLargeRegionsAreStrided();
+    return TestResult("mirror_change_detect_test");
+}
@@ -0,0 +1,130 @@
+// Color-match LUT: every definite cell class must agree with the filter shaders' per-pixel test for every 8-bit color
+// in the cell, and MirrorColorMatches must be that test. The reference below is a line-for-line transcription of
+// main() in mt_filter_frag_shader (float math, SRGBToLinear, distance against each target).
+
+#include "mirror_color_lut.h"
+#include "test_util.h"
+
+#include <array>
+#include <cmath>
+#include <initializer_list>
+#include <vector>
+
+namespace {
+
+float ShaderSRGBToLinear(float c) { return c <= 0.04045f ? c / 12.92f : std::pow((c + 0.055f) / 1.055f, 2.4f); }
+
+float ShaderDistance(const float a[3], const float b[3]) {
+    const float dx = a[0] - b[0], dy = a[1] - b[1], dz = a[2] - b[2];
+    return std::sqrt(dx * dx + dy * dy + dz * dz);
+}
+
+struct ShaderReference {
+    float linear[256];
+    MirrorColorLutParams params;
+    float targetLinear[MIRROR_LUT_MAX_TARGET_COLORS][3];
+
+    explicit ShaderReference(const MirrorColorLutParams& p) : params(p) {
+        for (int v = 0; v < 256; ++v) linear[v] = ShaderSRGBToLinear(static_cast<float>(v) / 255.0f);
+        for (int i = 0; i < params.targetColorCount; ++i) {
+            for (int c = 0; c < 3; ++c) targetLinear[i][c] = ShaderSRGBToLinear(params.targetColors[i][c]);
+        }
+    }
+
+    bool Matches(int r, int g, int b) const {
+        const float screen[3] = { r / 255.0f, g / 255.0f, b / 255.0f };
+        const float screenLinear[3] = { linear[r], linear[g], linear[b] };
+        for (int i = 0; i < params.targetColorCount; ++i) {
+            float dist;
+            if (params.gammaMode == 2) {
+                dist = ShaderDistance(screen, targetLinear[i]);
+            } else if (params.gammaMode == 1) {
+                dist = ShaderDistance(screenLinear, targetLinear[i]);
+            } else {
+                dist = std::fmin(ShaderDistance(screen, params.targetColors[i]), ShaderDistance(screenLinear, targetLinear[i]));
+            }
+            if (dist < params.sensitivity) return true;
+        }
+        return false;
+    }
+};
+
+MirrorColorLutParams MakeParams(int gammaMode, float sensitivity, std::initializer_list<std::array<float, 3>> colors) {
+    MirrorColorLutParams params;
+    params.gammaMode = gammaMode;
+    params.sensitivity = sensitivity;
+    for (const auto& c : colors) {
+        for (int k = 0; k < 3; ++k) params.targetColors[params.targetColorCount][k] = c[k];
+        ++params.targetColorCount;
+    }
+    return params;
+}
+
+// Same texel the shaders' ColorLutClass() fetches
+int ShaderLutIndex(int r, int g, int b) {
+    const int cr = r / 4, cg = g / 4, cb = b / 4;
+    return (cg + 64 * (cb / 8)) * MIRROR_LUT_TILE_W + cr + 64 * (cb % 8);
+}
+
+void CheckParams(const char* name, const MirrorColorLutParams& params) {
+    std::vector<uint8_t> lut;
+    const int ambiguous = BuildMirrorColorLut(params, lut);
+    CHECK(lut.size() == static_cast<size_t>(MIRROR_LUT_TILE_W) * MIRROR_LUT_TILE_H);
+
+    const ShaderReference ref(params);
+    int wrong = 0, matchCells = 0, countedAmbiguous = 0;
+    for (int b = 0; b < 256; ++b) {
+        for (int g = 0; g < 256; ++g) {
+            for (int r = 0; r < 256; ++r) {
+                const int index = MirrorColorLutIndex(r, g, b);
+                if (index != ShaderLutIndex(r, g, b)) ++wrong;
+                const uint8_t cls = lut[index];
+                if (cls == MIRROR_LUT_AMBIGUOUS) continue;
+                if ((cls == MIRROR_LUT_MATCH) != ref.Matches(r, g, b)) ++wrong;
+            }
+        }
+    }
+    for (uint8_t cls : lut) {
+        if (cls == MIRROR_LUT_MATCH) ++matchCells;
+        if (cls == MIRROR_LUT_AMBIGUOUS) ++countedAmbiguous;
+    }
+    CHECK_MSG(wrong == 0, "%s: %d colors disagree with the shader", name, wrong);
+    CHECK_MSG(countedAmbiguous == ambiguous, "%s: returned %d ambiguous, table has %d", name, ambiguous, countedAmbiguous);
+    // The LUT only pays off if most cells are decided on the CPU
+    CHECK_MSG(ambiguous < static_cast<int>(lut.size()) / 4, "%s: %d ambiguous cells", name, ambiguous);
+    std::printf("  %s: %d match cells, %d ambiguous\n", name, matchCells, ambiguous);
+
+    // MirrorColorMatches is the same test
+    int mismatched = 0;
+    for (int b = 0; b < 256; b += 5) {
+        for (int g = 0; g < 256; g += 3) {
+            for (int r = 0; r < 256; r += 7) {
+                const float rgb[3] = { r / 255.0f, g / 255.0f, b / 255.0f };
+                if (MirrorColorMatches(params, rgb) != ref.Matches(r, g, b)) ++mismatched;
+            }
+        }
+    }
+    CHECK_MSG(mismatched == 0, "%s: MirrorColorMatches differs on %d colors", name, mismatched);
+}
+
+void TestEmptyParams() {
+    std::vector<uint8_t> lut;
+    CHECK(BuildMirrorColorLut(MirrorColorLutParams(), lut) == 0);
+    bool allMiss = true;
+    for (uint8_t cls : lut) allMiss = allMiss && cls == MIRROR_LUT_NO_MATCH;
+    CHECK(allMiss);
+}
+
+} // namespace
+
+int main() {
+    TestEmptyParams();
+    CheckParams("auto, one color", MakeParams(0, 0.05f, { { 0.85f, 0.2f, 0.2f } }));
+    CheckParams("srgb, two colors", MakeParams(1, 0.1f, { { 0.0f, 1.0f, 0.0f }, { 1.0f, 1.0f, 1.0f } }));
+    CheckParams("linear, wide", MakeParams(2, 0.3f, { { 0.5f, 0.5f, 0.5f } }));
+    CheckParams("auto, eight colors",
+                MakeParams(0, 0.02f,
+                           { { 0.1f, 0.1f, 0.1f }, { 0.2f, 0.4f, 0.6f }, { 0.9f, 0.1f, 0.5f }, { 0.33f, 0.66f, 0.99f }, { 0.0f, 0.0f, 1.0f },
+                             { 0.75f, 0.75f, 0.0f }, { 0.5f, 0.25f, 0.125f }, { 1.0f, 0.0f, 0.0f } }));
+    return TestResult("mirror_color_lut_test");
+}
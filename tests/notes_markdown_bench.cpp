@@ -0,0 +1,95 @@
+// Notes preview parse cost on a 10k-line note: a full ParseMarkdownPreviewLines (what the preview paid every frame
+// before MarkdownDocument) against MarkdownDocument::Update for an unchanged frame, a one-character edit, and an edit
+// that opens a code fence mid-note. Usage: notes_markdown_bench [lines]
+
+#include "notes_markdown.h"
+#include "test_util.h"
+
+#include <cstdlib>
+#include <random>
+#include <string>
+
+namespace {
+
+// Routing-note mix: headings, bullets, tasks, numbered steps, quotes, links, short code blocks and blank lines
+std::string MakeNote(size_t lineCount) {
+    std::mt19937 rng(7);
+    std::string text;
+    for (size_t i = 0; i < lineCount; ++i) {
+        switch (rng() % 10) {
+        case 0: text += "## Split " + std::to_string(i) + "\n"; break;
+        case 1: text += "- Portal at " + std::to_string(rng() % 2000) + ", " + std::to_string(rng() % 2000) + " then boat east\n"; break;
+        case 2: text += "- [" + std::string(rng() % 2 ? "x" : " ") + "] Trade for pearls, target 12 in under 3 minutes\n"; break;
+        case 3: text += std::to_string(i % 20 + 1) + ". Measure the second throw and triangulate\n"; break;
+        case 4: text += "> Seed notes: see [the chart](https://example.com/chart/" + std::to_string(i) + ") and https://example.org/run\n"; break;
+        case 5:
+            text += "```\n/execute in minecraft:the_nether run tp @s 0 80 0\n```\n";
+            i += 2;
+            break;
+        case 6: text += "\n"; break;
+        default: text += "Body text about bastion routes, hoglin pens and the treasure variant, line " + std::to_string(i) + "\n"; break;
+        }
+    }
+    return text;
+}
+
+bool SameLines(MarkdownDocument& doc, const std::string& text) {
+    const auto expected = ParseMarkdownPreviewLines(text);
+    const auto lines = doc.Lines();
+    if (lines.size() != expected.size()) return false;
+    for (size_t i = 0; i < lines.size(); ++i) {
+        if (lines[i].kind != expected[i].kind || lines[i].text != expected[i].text || lines[i].links.size() != expected[i].links.size()) {
+            return false;
+        }
+    }
+    return true;
+}
+
+} // namespace
+
+int main(int argc, char** argv) {
+    const size_t lineCount = argc > 1 ? static_cast<size_t>(std::atoll(argv[1])) : 10000;
+    const std::string note = MakeNote(lineCount);
+    const size_t middle = note.find('\n', note.size() / 2) + 1;
+
+    std::string typed = note;
+    typed.insert(middle + 3, 1, 'q');
+    std::string fenced = note;
+    fenced.insert(middle, "```\n");
+
+    std::printf("%zu lines, %zu KB\n", lineCount, note.size() / 1024);
+
+    size_t sink = 0;
+    const double full = BestSeconds([&] { sink += ParseMarkdownPreviewLines(note).size(); }, 10);
+    std::printf("  full parse (old per-frame cost): %9.1f us\n", full * 1e6);
+
+    MarkdownDocument doc;
+    doc.Update(note);
+    const double unchanged = BestSeconds([&] { sink += doc.Update(note); }, 200);
+    std::printf("  Update, unchanged text:          %9.1f us\n", unchanged * 1e6);
+
+    // Each run applies the edit and then reverts it; both directions are measured and averaged
+    auto editPair = [&](const std::string& edited, const char* label) {
+        size_t reparsed = 0;
+        const double t = BestSeconds(
+            [&] {
+                doc.Update(edited);
+                reparsed = doc.LastReparsedLineCount();
+                doc.Update(note);
+            },
+            50) / 2;
+        std::printf("  Update, %-24s %9.1f us  %zu line(s) re-parsed  (%.0fx faster than full)\n", label, t * 1e6, reparsed, full / t);
+    };
+    editPair(typed, "one-character edit:");
+    editPair(fenced, "code fence opened:");
+
+    doc.Update(typed);
+    const bool typedOk = SameLines(doc, typed);
+    doc.Update(fenced);
+    const bool fencedOk = SameLines(doc, fenced);
+    doc.Update(note);
+    const bool restoredOk = SameLines(doc, note);
+    const bool matches = typedOk && fencedOk && restoredOk;
+    std::printf("  incremental result matches full parse: %s\n", matches ? "yes" : "NO");
+    return matches && sink != 0 ? 0 : 1;
+}
@@ -0,0 +1,138 @@
+// Incremental notes preview parse: after every one of thousands of random edits (typed characters, deletions,
+// pasted blocks, code fences opened and closed, links, line breaks at the start and end of the text),
+// MarkdownDocument::Update() must hold exactly the lines ParseMarkdownPreviewLines() returns for the new text, field
+// by field. Update() reports a change and bumps Revision() only when the text changed, and lines it did not re-parse
+// keep their layout cache.
+
+#include "notes_markdown.h"
+#include "test_util.h"
+
+#include <algorithm>
+#include <random>
+#include <string>
+#include <vector>
+
+namespace {
+
+// Pieces an edit inserts, weighted toward what changes a line's kind or the code-fence state
+const char* const kSnippets[] = { "\n",         "```",    "```\n",        "\n```\n", "# ",      "### ",  "- ",    "- [ ] ", "- [x] ",
+                                  "1. ",        "> ",     "---",          "  ",      "[chart](", ")",     "https://example.com/a ",
+                                  "http://x.y", "q",      "pearls",       "\t",      "\r\n",     "`",     "[",     "]",      "*" };
+
+std::string RandomSnippet(std::mt19937& rng) {
+    std::string s;
+    const int pieces = 1 + static_cast<int>(rng() % 4);
+    for (int i = 0; i < pieces; ++i) s += kSnippets[rng() % (sizeof(kSnippets) / sizeof(kSnippets[0]))];
+    return s;
+}
+
+std::string MakeNote(std::mt19937& rng, size_t lineCount) {
+    std::string text;
+    for (size_t i = 0; i < lineCount; ++i) {
+        switch (rng() % 8) {
+        case 0: text += "## Split " + std::to_string(i) + "\n"; break;
+        case 1: text += "- [ ] Trade for pearls\n"; break;
+        case 2: text += "> See [the chart](https://example.com/" + std::to_string(i) + ") and https://example.org/run\n"; break;
+        case 3: text += "```\ntp @s 0 80 0\n```\n"; break;
+        case 4: text += "\n"; break;
+        case 5: text += std::to_string(i % 9 + 1) + ". Measure the throw\n"; break;
+        default: text += "Body text about bastion routes, line " + std::to_string(i) + "\n"; break;
+        }
+    }
+    return text;
+}
+
+// One random edit at a random position: insert, delete, replace, or (rarely) clear the whole text
+void RandomEdit(std::mt19937& rng, std::string& text) {
+    const size_t pos = text.empty() ? 0 : rng() % (text.size() + 1);
+    const size_t len = std::min<size_t>(text.size() - pos, rng() % 3 == 0 ? rng() % 200 : rng() % 8);
+    switch (rng() % 16) {
+    case 0: text.insert(0, RandomSnippet(rng)); break;
+    case 1: text += RandomSnippet(rng); break;
+    case 2: text.erase(pos, len); break;
+    case 3: text.replace(pos, len, RandomSnippet(rng)); break;
+    case 4: text.insert(pos, MakeNote(rng, 1 + rng() % 6)); break; // Pasted block
+    case 5:
+        if (rng() % 10 == 0) text.clear();
+        break;
+    default: text.insert(pos, RandomSnippet(rng)); break;
+    }
+}
+
+bool SameLink(const MarkdownPreviewLink& a, const MarkdownPreviewLink& b) {
+    return a.label == b.label && a.url == b.url && a.start == b.start && a.end == b.end;
+}
+
+bool SameLine(const MarkdownPreviewLine& a, const MarkdownPreviewLine& b) {
+    if (a.kind != b.kind || a.text != b.text || a.headingLevel != b.headingLevel || a.listPrefix != b.listPrefix || a.checked != b.checked ||
+        a.sourceLineIndex != b.sourceLineIndex || a.links.size() != b.links.size()) {
+        return false;
+    }
+    for (size_t i = 0; i < a.links.size(); ++i) {
+        if (!SameLink(a.links[i], b.links[i])) return false;
+    }
+    return true;
+}
+
+// Index of the first line that differs from a full parse, or -1
+long FirstDifference(MarkdownDocument& doc, const std::string& text) {
+    const auto expected = ParseMarkdownPreviewLines(text);
+    const auto lines = doc.Lines();
+    for (size_t i = 0; i < lines.size() && i < expected.size(); ++i) {
+        if (!SameLine(lines[i], expected[i])) return static_cast<long>(i);
+    }
+    return lines.size() == expected.size() ? -1 : static_cast<long>(std::min(lines.size(), expected.size()));
+}
+
+void TestRandomEdits(uint32_t seed, size_t noteLines, int edits) {
+    std::mt19937 rng(seed);
+    std::string text = MakeNote(rng, noteLines);
+    MarkdownDocument doc;
+    CHECK(doc.Update(text));
+    CHECK(FirstDifference(doc, text) == -1);
+
+    int failures = 0, staleLayouts = 0;
+    for (int edit = 0; edit < edits && failures == 0; ++edit) {
+        // Mark every line as laid out; Update() must only reset the ones it re-parses
+        for (MarkdownPreviewLine& line : doc.Lines()) line.layoutWrapWidth = 123.0f;
+
+        const std::string before = text;
+        RandomEdit(rng, text);
+        const uint64_t revision = doc.Revision();
+        const bool changed = doc.Update(text);
+        CHECK_MSG(changed == (text != before), "seed %u, edit %d", seed, edit);
+        CHECK_MSG((doc.Revision() != revision) == changed, "seed %u, edit %d", seed, edit);
+
+        const long diff = FirstDifference(doc, text);
+        if (diff != -1) {
+            ++failures;
+            CHECK_MSG(false, "seed %u, edit %d: line %ld differs from a full parse of %zu bytes", seed, edit, diff, text.size());
+        }
+
+        size_t reset = 0;
+        for (const MarkdownPreviewLine& line : doc.Lines()) reset += line.layoutWrapWidth != 123.0f;
+        if (changed && reset > doc.LastReparsedLineCount()) ++staleLayouts;
+        if (!changed && reset != 0) ++staleLayouts;
+    }
+    CHECK_MSG(staleLayouts == 0, "seed %u: %d edit(s) reset the layout of lines they didn't re-parse", seed, staleLayouts);
+}
+
+void TestEdgeCases() {
+    MarkdownDocument doc;
+    for (const char* text : { "", "\n", "```", "```\n", "\n\n\n", "a\r\nb\r\n", "```\n```\n```", "# x\n```\n- y\n" }) {
+        doc.Update(text);
+        CHECK_MSG(FirstDifference(doc, text) == -1, "\"%s\"", text);
+        MarkdownDocument fresh;
+        fresh.Update(text);
+        CHECK_MSG(FirstDifference(fresh, text) == -1, "fresh \"%s\"", text);
+    }
+    CHECK(!doc.Update("# x\n```\n- y\n"));
+}
+
+} // namespace
+
+int main() {
+    TestEdgeCases();
+    for (uint32_t seed = 1; seed <= 8; ++seed) TestRandomEdits(seed, seed % 2 ? 40 : 400, 1500);
+    return TestResult("notes_markdown_test");
+}
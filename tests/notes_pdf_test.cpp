@@ -0,0 +1,341 @@
+// Notes PDF export against golden files. Each export is dumped object by object with its streams inflated (zlib is
+// the reference decoder) and embedded font programs reduced to their table list, then compared with
+// tests/golden/<name>.txt. Set TOOLSCREEN_UPDATE_GOLDEN=1 to rewrite the goldens after an intended output change.
+// The fonts are small TrueType files built here: a good one, one whose hmtx is too short to subset (must fall back to
+// the standard fonts) and one with an out-of-range optional table (must load and subset without it).
+
+#include "notes_pdf.h"
+#include "test_util.h"
+#include "truetype_font.h"
+
+#include <zlib.h>
+
+#include <cctype>
+#include <cstdlib>
+#include <cstring>
+#include <filesystem>
+#include <fstream>
+#include <map>
+#include <sstream>
+#include <string>
+#include <vector>
+
+namespace {
+
+// ---- TrueType builder -------------------------------------------------------------------------------------------
+
+void PutBE(std::string& out, uint32_t v, int bytes) {
+    for (int i = bytes - 1; i >= 0; --i) out.push_back(static_cast<char>((v >> (i * 8)) & 0xFFu));
+}
+
+struct FontOptions {
+    bool truncatedHmtx = false;    // Leave out the left side bearings after the last full metric
+    bool badOptionalTable = false; // A "cvt " record pointing past the end of the file
+};
+
+// Glyph 0 .notdef, then one square glyph per codepoint in `codepoints`, plus a composite glyph for U+00E9 built from
+// 'e' and an accent glyph (so subsetting has components to follow)
+std::string BuildTestFont(const std::vector<uint32_t>& codepoints, const FontOptions& options) {
+    std::vector<std::string> glyphs(1); // .notdef: empty outline
+    std::map<uint32_t, uint16_t> cmap;
+    auto squareGlyph = [](int16_t size) {
+        std::string g;
+        PutBE(g, 1, 2); // One contour
+        PutBE(g, 0, 2);
+        PutBE(g, 0, 2);
+        PutBE(g, static_cast<uint16_t>(size), 2);
+        PutBE(g, static_cast<uint16_t>(size), 2);
+        PutBE(g, 3, 2); // endPtsOfContours
+        PutBE(g, 0, 2); // No instructions
+        for (int i = 0; i < 4; ++i) g.push_back(0x01); // On-curve, 16-bit deltas
+        const int16_t xs[4] = { 0, size, 0, static_cast<int16_t>(-size) };
+        const int16_t ys[4] = { 0, 0, size, 0 };
+        for (int16_t x : xs) PutBE(g, static_cast<uint16_t>(x), 2);
+        for (int16_t y : ys) PutBE(g, static_cast<uint16_t>(y), 2);
+        return g;
+    };
+    for (uint32_t cp : codepoints) {
+        cmap[cp] = static_cast<uint16_t>(glyphs.size());
+        glyphs.push_back(squareGlyph(static_cast<int16_t>(300 + cp % 200)));
+    }
+    const uint16_t accent = static_cast<uint16_t>(glyphs.size());
+    glyphs.push_back(squareGlyph(120));
+    std::string composite;
+    PutBE(composite, 0xFFFF, 2); // numberOfContours -1
+    for (int i = 0; i < 4; ++i) PutBE(composite, 0, 2);
+    PutBE(composite, 0x0020 | 0x0002, 2); // MORE_COMPONENTS | ARGS_ARE_XY_VALUES, byte args
+    PutBE(composite, cmap.at('e'), 2);
+    PutBE(composite, 0, 2);
+    PutBE(composite, 0x0002, 2);
+    PutBE(composite, accent, 2);
+    composite.push_back(static_cast<char>(100));
+    composite.push_back(static_cast<char>(80));
+    cmap[0xE9] = static_cast<uint16_t>(glyphs.size());
+    glyphs.push_back(composite);
+
+    const uint16_t numGlyphs = static_cast<uint16_t>(glyphs.size());
+    const uint16_t hMetrics = options.truncatedHmtx ? 4 : numGlyphs;
+
+    std::string glyf, loca;
+    for (const std::string& g : glyphs) {
+        PutBE(loca, static_cast<uint32_t>(glyf.size()), 4);
+        glyf += g;
+        while (glyf.size() % 4) glyf.push_back('\0');
+    }
+    PutBE(loca, static_cast<uint32_t>(glyf.size()), 4);
+
+    std::string hmtx;
+    for (uint16_t g = 0; g < hMetrics; ++g) {
+        PutBE(hmtx, 400u + g * 7u % 300u, 2);
+        PutBE(hmtx, 0, 2);
+    }
+    if (!options.truncatedHmtx) {
+        for (uint16_t g = hMetrics; g < numGlyphs; ++g) PutBE(hmtx, 0, 2);
+    }
+
+    auto put16 = [](std::string& table, size_t offset, uint16_t v) {
+        table[offset] = static_cast<char>(v >> 8);
+        table[offset + 1] = static_cast<char>(v & 0xFF);
+    };
+    std::string head(54, '\0');
+    put16(head, 0, 1);     // Version 1.0
+    put16(head, 18, 1000); // unitsPerEm
+    put16(head, 40, 512);  // xMax
+    put16(head, 42, 512);  // yMax
+    put16(head, 50, 1);    // indexToLocFormat: long
+
+    std::string hhea(36, '\0');
+    put16(hhea, 0, 1);
+    put16(hhea, 4, 800);                         // Ascent
+    put16(hhea, 6, static_cast<uint16_t>(-200)); // Descent
+    put16(hhea, 34, hMetrics);
+
+    std::string maxp;
+    PutBE(maxp, 0x00005000u, 4);
+    PutBE(maxp, numGlyphs, 2);
+
+    std::string cmapTable;
+    const uint16_t segCount = static_cast<uint16_t>(cmap.size() + 1);
+    std::string sub;
+    PutBE(sub, 4, 2);
+    PutBE(sub, 16u + segCount * 8u, 2);
+    PutBE(sub, 0, 2);
+    PutBE(sub, segCount * 2u, 2);
+    for (int i = 0; i < 3; ++i) PutBE(sub, 0, 2); // Search hints (unused by the reader)
+    for (const auto& [cp, g] : cmap) PutBE(sub, cp, 2);
+    PutBE(sub, 0xFFFF, 2);
+    PutBE(sub, 0, 2);
+    for (const auto& [cp, g] : cmap) PutBE(sub, cp, 2);
+    PutBE(sub, 0xFFFF, 2);
+    for (const auto& [cp, g] : cmap) PutBE(sub, static_cast<uint16_t>(g - cp), 2);
+    PutBE(sub, 1, 2);
+    for (size_t i = 0; i < segCount; ++i) PutBE(sub, 0, 2);
+    PutBE(cmapTable, 0, 2);
+    PutBE(cmapTable, 1, 2);
+    PutBE(cmapTable, 3, 2);
+    PutBE(cmapTable, 1, 2);
+    PutBE(cmapTable, 12, 4);
+    cmapTable += sub;
+
+    std::vector<std::pair<std::string, std::string>> tables = { { "cmap", cmapTable }, { "glyf", glyf }, { "head", head }, { "hhea", hhea },
+                                                                { "hmtx", hmtx },      { "loca", loca }, { "maxp", maxp } };
+    const size_t recordCount = tables.size() + (options.badOptionalTable ? 1 : 0);
+    std::string font;
+    PutBE(font, 0x00010000u, 4);
+    PutBE(font, static_cast<uint32_t>(recordCount), 2);
+    for (int i = 0; i < 3; ++i) PutBE(font, 0, 2);
+    size_t offset = 12 + recordCount * 16;
+    if (options.badOptionalTable) {
+        font += "cvt ";
+        PutBE(font, 0, 4);
+        PutBE(font, 0x7FFFFFF0u, 4);
+        PutBE(font, 64, 4);
+    }
+    for (const auto& [tag, data] : tables) {
+        font += tag;
+        PutBE(font, 0, 4);
+        PutBE(font, static_cast<uint32_t>(offset), 4);
+        PutBE(font, static_cast<uint32_t>(data.size()), 4);
+        offset += (data.size() + 3) & ~size_t(3);
+    }
+    for (const auto& [tag, data] : tables) {
+        font += data;
+        while (font.size() % 4) font.push_back('\0');
+    }
+    return font;
+}
+
+std::vector<uint32_t> PrintableAscii() {
+    std::vector<uint32_t> cps;
+    for (uint32_t c = 32; c < 127; ++c) cps.push_back(c);
+    cps.push_back(0x2192); // Arrow
+    return cps;
+}
+
+std::filesystem::path WriteTempFile(const char* name, const std::string& data) {
+    const auto path = std::filesystem::temp_directory_path() / name;
+    std::ofstream(path, std::ios::binary) << data;
+    return path;
+}
+
+// ---- PDF dump -----------------------------------------------------------------------------------------------------
+
+bool Inflate(const std::string& compressed, std::string& out) {
+    z_stream zs{};
+    if (inflateInit(&zs) != Z_OK) return false;
+    zs.next_in = reinterpret_cast<Bytef*>(const_cast<char*>(compressed.data()));
+    zs.avail_in = static_cast<uInt>(compressed.size());
+    char buf[16384];
+    int ret = Z_OK;
+    out.clear();
+    while (ret == Z_OK) {
+        zs.next_out = reinterpret_cast<Bytef*>(buf);
+        zs.avail_out = sizeof(buf);
+        ret = inflate(&zs, Z_NO_FLUSH);
+        out.append(buf, sizeof(buf) - zs.avail_out);
+    }
+    inflateEnd(&zs);
+    return ret == Z_STREAM_END && zs.avail_in == 0;
+}
+
+std::string DescribeFontProgram(const std::string& program) {
+    std::string tags;
+    if (program.size() < 12) return "(truncated)";
+    const size_t numTables = (static_cast<uint8_t>(program[4]) << 8) | static_cast<uint8_t>(program[5]);
+    for (size_t i = 0; i < numTables && 12 + i * 16 + 16 <= program.size(); ++i) tags += " " + program.substr(12 + i * 16, 4);
+    return "font program, " + std::to_string(program.size()) + " bytes, tables:" + tags;
+}
+
+// Objects in file order with inflated streams; also checks the cross-reference table points at every object
+std::string DumpPdf(const std::string& pdf) {
+    std::ostringstream dump;
+    std::map<int, size_t> offsets;
+    size_t pos = 0;
+    while ((pos = pdf.find(" 0 obj\n", pos)) != std::string::npos) {
+        size_t numStart = pos;
+        while (numStart > 0 && std::isdigit(static_cast<unsigned char>(pdf[numStart - 1]))) --numStart;
+        const int id = std::atoi(pdf.c_str() + numStart);
+        offsets[id] = numStart;
+        const size_t body = pos + 7;
+        const size_t streamPos = pdf.find("\nstream\n", body);
+        const size_t endPos = pdf.find("\nendobj\n", body);
+        dump << "obj " << id << ":\n";
+        if (streamPos != std::string::npos && streamPos < endPos) {
+            const std::string dict = pdf.substr(body, streamPos - body);
+            const size_t lengthAt = dict.find("/Length ");
+            const size_t length = static_cast<size_t>(std::atoll(dict.c_str() + lengthAt + 8));
+            const std::string compressed = pdf.substr(streamPos + 8, length);
+            std::string data;
+            CHECK_MSG(Inflate(compressed, data), "object %d: stream does not inflate", id);
+            // The compressed length depends on the encoder; the golden only records what the stream holds
+            std::string normalized = dict;
+            normalized.replace(lengthAt + 8, std::to_string(length).size(), "N");
+            dump << normalized << "\n";
+            dump << (dict.find("/Length1") != std::string::npos ? DescribeFontProgram(data) + "\n" : data);
+            pos = pdf.find("\nendobj\n", streamPos + 8 + length);
+            CHECK(pdf.compare(streamPos + 8 + length, 18, "\nendstream\nendobj\n") == 0);
+        } else {
+            dump << pdf.substr(body, endPos - body) << "\n";
+            pos = endPos;
+        }
+    }
+
+    const size_t startxref = pdf.rfind("startxref\n");
+    const size_t xref = static_cast<size_t>(std::atoll(pdf.c_str() + startxref + 10));
+    CHECK(pdf.compare(xref, 5, "xref\n") == 0);
+    for (const auto& [id, offset] : offsets) {
+        const size_t entry = pdf.find('\n', pdf.find('\n', xref + 5) + 1) + 1 + static_cast<size_t>(id - 1) * 20;
+        CHECK_MSG(static_cast<size_t>(std::atoll(pdf.c_str() + entry)) == offset, "xref entry for object %d", id);
+    }
+    return dump.str();
+}
+
+void CheckGolden(const char* name, const std::string& actual) {
+    const std::filesystem::path path = std::filesystem::path(TOOLSCREEN_GOLDEN_DIR) / (std::string(name) + ".txt");
+    if (const char* update = std::getenv("TOOLSCREEN_UPDATE_GOLDEN"); update && *update == '1') {
+        std::ofstream(path, std::ios::binary) << actual;
+        std::printf("  updated %s\n", path.string().c_str());
+        return;
+    }
+    std::ifstream in(path, std::ios::binary);
+    std::stringstream expected;
+    expected << in.rdbuf();
+    if (expected.str() == actual) return;
+
+    const std::string want = expected.str();
+    size_t line = 1, i = 0;
+    for (; i < want.size() && i < actual.size() && want[i] == actual[i]; ++i) line += want[i] == '\n';
+    CHECK_MSG(false, "%s differs from %s at line %zu (TOOLSCREEN_UPDATE_GOLDEN=1 to accept)", name, path.string().c_str(), line);
+}
+
+const char* kNote = "# Route notes\n"
+                    "\n"
+                    "Body text that is long enough to wrap across more than one line of the page, so the layout uses the "
+                    "real glyph widths of whichever font the export ended up with.\n"
+                    "- Portal at 120, -48\n"
+                    "  - Nested bullet\n"
+                    "- [x] Trade for pearls\n"
+                    "- [ ] Blind travel\n"
+                    "1. Measure the throw\n"
+                    "> Quoted (parens) and \\backslash\\\n"
+                    "---\n"
+                    "```\n"
+                    "/tp @s 0 80 0\n"
+                    "```\n"
+                    "## Second heading\n"
+                    "See https://example.com/chart for the chart.\n";
+
+void TestStandardFonts() {
+    const std::string pdf = BuildMarkdownPdf("Route notes", kNote);
+    CheckGolden("notes_pdf_standard_fonts", DumpPdf(pdf));
+}
+
+void TestEmbeddedFont() {
+    const auto regular = WriteTempFile("toolscreen_pdf_test_regular.ttf", BuildTestFont(PrintableAscii(), {}));
+    NotesPdfFonts fonts;
+    fonts.regular = regular;
+    fonts.bold = regular.parent_path() / "toolscreen_pdf_test_missing_bold.ttf"; // Synthetic bold
+    const std::string note = std::string(kNote) + "Caf\xC3\xA9 \xE2\x86\x92 done, \xE6\xBC\xA2 is missing\n";
+    const std::string pdf = BuildMarkdownPdf("Caf\xC3\xA9 notes", note, fonts);
+    CHECK(pdf.find("/FontFile2") != std::string::npos);
+    CheckGolden("notes_pdf_embedded_font", DumpPdf(pdf));
+    std::filesystem::remove(regular);
+}
+
+void TestUnsubsettableFontFallsBack() {
+    FontOptions options;
+    options.truncatedHmtx = true;
+    const std::string data = BuildTestFont(PrintableAscii(), options);
+    TrueTypeFont font;
+    CHECK(font.Load(data)); // Loads (the full metrics are there)...
+    std::string subset;
+    CHECK(!font.BuildSubset({ static_cast<uint16_t>(font.GlyphCount() - 1) }, subset)); // ...but can't be subset
+
+    const auto path = WriteTempFile("toolscreen_pdf_test_truncated.ttf", data);
+    NotesPdfFonts fonts;
+    fonts.regular = path;
+    // Same output as no font at all
+    CHECK(BuildMarkdownPdf("Route notes", kNote, fonts) == BuildMarkdownPdf("Route notes", kNote));
+    std::filesystem::remove(path);
+}
+
+void TestOutOfRangeOptionalTable() {
+    FontOptions options;
+    options.badOptionalTable = true;
+    TrueTypeFont font;
+    CHECK(font.Load(BuildTestFont(PrintableAscii(), options)));
+    std::string subset;
+    CHECK(font.BuildSubset({ font.GlyphForCodepoint('A'), font.GlyphForCodepoint(0xE9) }, subset));
+    CHECK(DescribeFontProgram(subset).find("cvt") == std::string::npos);
+    CHECK(subset.size() < BuildTestFont(PrintableAscii(), {}).size()); // Unused outlines are dropped
+}
+
+} // namespace
+
+int main() {
+    TestStandardFonts();
+    TestEmbeddedFont();
+    TestUnsubsettableFontFallsBack();
+    TestOutOfRangeOptionalTable();
+    return TestResult("notes_pdf_test");
+}
@@ -0,0 +1,240 @@
+// Notes persistence worker: WriteFileAtomic replaces a file in one step and leaves the old contents (and no temp file)
+// when a write is abandoned or fails; new notes, in-place updates and renames land where the overlay expects; the
+// Uniquify, Report and Overwrite conflict policies; a failed write echoes the request back with an error; a burst of
+// saves to one note is written in order and ends with the newest text, one result per ticket; PDFs render on the
+// worker; and Stop writes everything still queued.
+
+#include "notes_pdf.h"
+#include "notes_persistence.h"
+#include "test_util.h"
+
+#include <algorithm>
+#include <chrono>
+#include <filesystem>
+#include <fstream>
+#include <iterator>
+#include <memory>
+#include <string>
+#include <thread>
+#include <vector>
+
+namespace fs = std::filesystem;
+
+namespace {
+
+fs::path FreshDir(const char* name) {
+    const fs::path dir = fs::temp_directory_path() / name;
+    fs::remove_all(dir);
+    fs::create_directories(dir);
+    return dir;
+}
+
+std::string ReadText(const fs::path& path) {
+    std::ifstream in(path, std::ios::binary);
+    return std::string((std::istreambuf_iterator<char>(in)), std::istreambuf_iterator<char>());
+}
+
+void WriteText(const fs::path& path, const std::string& text) { std::ofstream(path, std::ios::binary) << text; }
+
+std::vector<std::string> ListFiles(const fs::path& dir) {
+    std::vector<std::string> names;
+    for (const auto& entry : fs::directory_iterator(dir)) names.push_back(entry.path().filename().string());
+    std::sort(names.begin(), names.end());
+    return names;
+}
+
+// Results for `count` requests, in completion order (30 s limit, for sanitizer builds)
+std::vector<NotesPersistResult> WaitForResults(size_t count) {
+    std::vector<NotesPersistResult> results;
+    for (int i = 0; i < 6000 && results.size() < count; ++i) {
+        for (NotesPersistResult& result : TakeNotesPersistResults()) results.push_back(std::move(result));
+        if (results.size() < count) std::this_thread::sleep_for(std::chrono::milliseconds(5));
+    }
+    return results;
+}
+
+NotesPersistResult Persist(NotesPersistRequest request) {
+    const uint64_t ticket = EnqueueNotesPersist(std::move(request));
+    const auto results = WaitForResults(1);
+    CHECK(results.size() == 1 && results[0].ticket == ticket);
+    return results.empty() ? NotesPersistResult() : results[0];
+}
+
+NotesPersistRequest NewNote(const fs::path& folder, const std::string& fileBase, const std::string& text) {
+    NotesPersistRequest request;
+    request.folder = folder;
+    request.fileBase = fileBase;
+    request.text = std::make_shared<const std::string>(text);
+    return request;
+}
+
+NotesPersistRequest Update(const fs::path& currentPath, const std::string& fileBase, const std::string& text) {
+    NotesPersistRequest request;
+    request.currentPath = currentPath;
+    request.fileBase = fileBase;
+    request.text = std::make_shared<const std::string>(text);
+    return request;
+}
+
+void TestWriteFileAtomic() {
+    const fs::path dir = FreshDir("toolscreen_notes_persist_atomic");
+    const fs::path path = dir / "note.md";
+    CHECK(WriteFileAtomic(path, std::string("first")));
+    CHECK(ReadText(path) == "first");
+    CHECK(WriteFileAtomic(path, std::string("second, longer")));
+    CHECK(ReadText(path) == "second, longer");
+
+    // An abandoned write keeps the old file whole and cleans up after itself
+    CHECK(!WriteFileAtomic(path, [](std::ostream& out) {
+        out << "partial";
+        return false;
+    }));
+    CHECK(ReadText(path) == "second, longer");
+    CHECK((ListFiles(dir) == std::vector<std::string>{ "note.md" }));
+
+    // A temp file left by a crash is simply replaced
+    WriteText(dir / "note.md.tmp", "stale temp contents that are longer than the note");
+    CHECK(WriteFileAtomic(path, std::string("third")));
+    CHECK(ReadText(path) == "third");
+    CHECK((ListFiles(dir) == std::vector<std::string>{ "note.md" }));
+
+    CHECK(!WriteFileAtomic(dir / "missing_folder" / "note.md", std::string("x")));
+    fs::remove_all(dir);
+}
+
+void TestSavesAndRenames() {
+    const fs::path dir = FreshDir("toolscreen_notes_persist_saves");
+
+    // A new note in a folder that doesn't exist yet
+    NotesPersistResult result = Persist(NewNote(dir / "General", "Route", "# Route\n"));
+    CHECK(result.status == NotesPersistStatus::Written && result.writtenPath == dir / "General" / "Route.md" && result.error.empty());
+    CHECK(ReadText(dir / "General" / "Route.md") == "# Route\n");
+
+    // In place, with or without the same file name
+    result = Persist(Update(dir / "General" / "Route.md", "", "# Route\nv2\n"));
+    CHECK(result.status == NotesPersistStatus::Written && result.writtenPath == dir / "General" / "Route.md");
+    result = Persist(Update(dir / "General" / "Route.md", "Route", "# Route\nv3\n"));
+    CHECK(result.status == NotesPersistStatus::Written && ReadText(dir / "General" / "Route.md") == "# Route\nv3\n");
+
+    // A changed title renames the note: the new file holds the text and the old one is gone
+    result = Persist(Update(dir / "General" / "Route.md", "Bastion", "# Bastion\n"));
+    CHECK(result.status == NotesPersistStatus::Written && result.writtenPath == dir / "General" / "Bastion.md");
+    CHECK((ListFiles(dir / "General") == std::vector<std::string>{ "Bastion.md" }));
+
+    // Renaming onto another note's name (default Uniquify) keeps both
+    WriteText(dir / "General" / "Stronghold.md", "other note");
+    result = Persist(Update(dir / "General" / "Bastion.md", "Stronghold", "# Stronghold too\n"));
+    CHECK(result.status == NotesPersistStatus::Written && result.writtenPath == dir / "General" / "Stronghold_1.md");
+    CHECK(ReadText(dir / "General" / "Stronghold.md") == "other note");
+    CHECK((ListFiles(dir / "General") == std::vector<std::string>{ "Stronghold.md", "Stronghold_1.md" }));
+    fs::remove_all(dir);
+}
+
+void TestConflictPolicies() {
+    const fs::path dir = FreshDir("toolscreen_notes_persist_conflict");
+    WriteText(dir / "Route.md", "existing");
+    WriteText(dir / "Route_1.md", "existing too");
+
+    NotesPersistRequest request = NewNote(dir, "Route", "uniquified");
+    NotesPersistResult result = Persist(request);
+    CHECK(result.status == NotesPersistStatus::Written && result.writtenPath == dir / "Route_2.md" && ReadText(dir / "Route_2.md") == "uniquified");
+
+    // Report writes nothing and hands the text back so the user can choose
+    request = NewNote(dir, "Route", "reported");
+    request.onConflict = NotesConflictPolicy::Report;
+    result = Persist(request);
+    CHECK(result.status == NotesPersistStatus::Conflict && result.conflictPath == dir / "Route.md" && result.writtenPath.empty());
+    CHECK(result.request.text && *result.request.text == "reported" && result.request.onConflict == NotesConflictPolicy::Report);
+    CHECK(ReadText(dir / "Route.md") == "existing");
+
+    request.onConflict = NotesConflictPolicy::Overwrite;
+    result = Persist(request);
+    CHECK(result.status == NotesPersistStatus::Written && result.writtenPath == dir / "Route.md" && ReadText(dir / "Route.md") == "reported");
+
+    // Updating a note in place is never a conflict with itself
+    request = Update(dir / "Route.md", "", "in place");
+    request.onConflict = NotesConflictPolicy::Report;
+    result = Persist(request);
+    CHECK(result.status == NotesPersistStatus::Written && ReadText(dir / "Route.md") == "in place");
+    CHECK((ListFiles(dir) == std::vector<std::string>{ "Route.md", "Route_1.md", "Route_2.md" }));
+    fs::remove_all(dir);
+}
+
+void TestFailedWrite() {
+    const fs::path dir = FreshDir("toolscreen_notes_persist_failed");
+    WriteText(dir / "not_a_folder", "file");
+    const NotesPersistResult result = Persist(NewNote(dir / "not_a_folder", "Route", "lost?"));
+    CHECK(result.status == NotesPersistStatus::Failed && result.writtenPath.empty() && !result.error.empty());
+    CHECK(result.request.text && *result.request.text == "lost?"); // The overlay restores or retries from this
+    CHECK((ListFiles(dir) == std::vector<std::string>{ "not_a_folder" }));
+    fs::remove_all(dir);
+}
+
+// The overlay sends a newer snapshot of a note whenever the previous one lands or, for exports and conflict
+// resolutions, straight away; the worker must apply them in order so the newest text wins
+void TestBurstInOrder() {
+    const fs::path dir = FreshDir("toolscreen_notes_persist_burst");
+    const NotesPersistResult first = Persist(NewNote(dir, "Route", "rev 0"));
+    CHECK(first.status == NotesPersistStatus::Written);
+
+    std::vector<uint64_t> tickets;
+    for (int rev = 1; rev <= 50; ++rev) tickets.push_back(EnqueueNotesPersist(Update(first.writtenPath, "", "rev " + std::to_string(rev))));
+    const auto results = WaitForResults(tickets.size());
+    CHECK_MSG(results.size() == tickets.size(), "%zu of %zu results", results.size(), tickets.size());
+    bool inOrder = results.size() == tickets.size();
+    for (size_t i = 0; inOrder && i < results.size(); ++i) {
+        inOrder = results[i].ticket == tickets[i] && results[i].status == NotesPersistStatus::Written && *results[i].request.text == "rev " + std::to_string(i + 1);
+    }
+    CHECK(inOrder);
+    CHECK(std::adjacent_find(tickets.begin(), tickets.end(), [](uint64_t a, uint64_t b) { return b <= a; }) == tickets.end());
+    CHECK(ReadText(first.writtenPath) == "rev 50");
+    CHECK((ListFiles(dir) == std::vector<std::string>{ "Route.md" }));
+    CHECK(TakeNotesPersistResults().empty());
+    fs::remove_all(dir);
+}
+
+void TestPdf() {
+    const fs::path dir = FreshDir("toolscreen_notes_persist_pdf");
+    const std::string markdown = "# Route\n- Portal at 120, -40\n- [x] Pearls\n";
+    NotesPersistRequest request = NewNote(dir, "Route", markdown);
+    request.kind = NotesPersistKind::Pdf;
+    request.extension = ".pdf";
+    request.title = "Route";
+    request.onConflict = NotesConflictPolicy::Report;
+    NotesPersistResult result = Persist(request);
+    CHECK(result.status == NotesPersistStatus::Written && result.writtenPath == dir / "Route.pdf");
+    CHECK(ReadText(dir / "Route.pdf") == BuildMarkdownPdf("Route", markdown));
+
+    result = Persist(request);
+    CHECK(result.status == NotesPersistStatus::Conflict && result.conflictPath == dir / "Route.pdf");
+    fs::remove_all(dir);
+}
+
+void TestStopDrainsQueue() {
+    const fs::path dir = FreshDir("toolscreen_notes_persist_stop");
+    for (int i = 0; i < 50; ++i) EnqueueNotesPersist(NewNote(dir, "note" + std::to_string(i), std::string(1000, static_cast<char>('a' + i % 26))));
+    StopNotesPersistenceThread();
+
+    CHECK(TakeNotesPersistResults().size() == 50);
+    const auto names = ListFiles(dir);
+    CHECK_MSG(names.size() == 50, "%zu files", names.size());
+    CHECK(ReadText(dir / "note49.md") == std::string(1000, static_cast<char>('a' + 49 % 26)));
+
+    // The worker starts again on the next request
+    CHECK(Persist(NewNote(dir, "after", "x")).status == NotesPersistStatus::Written);
+    StopNotesPersistenceThread();
+    fs::remove_all(dir);
+}
+
+} // namespace
+
+int main() {
+    TestWriteFileAtomic();
+    TestSavesAndRenames();
+    TestConflictPolicies();
+    TestFailedWrite();
+    TestBurstInOrder();
+    TestPdf();
+    TestStopDrainsQueue();
+    return TestResult("notes_persistence_test");
+}
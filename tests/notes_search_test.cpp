@@ -0,0 +1,126 @@
+// Notes full-text search: every query word must match, the last one as a prefix only while it's being typed, title
+// matches outrank body-only ones, and Upsert/Remove show up in the next search. Then search latency over 5000 synthetic
+// notes (200-1000 words, Zipf-like vocabulary), which must stay well inside a frame since the overlay searches as the
+// user types.
+
+#include "notes_search.h"
+#include "test_util.h"
+
+#include <algorithm>
+#include <random>
+#include <string>
+#include <vector>
+
+namespace {
+
+bool HasKey(const std::vector<NotesSearchIndex::Hit>& hits, const std::string& key) {
+    return std::any_of(hits.begin(), hits.end(), [&](const NotesSearchIndex::Hit& hit) { return hit.key == key; });
+}
+
+void TestTokenize() {
+    std::vector<std::string> tokens;
+    NotesSearchIndex::Tokenize("Blind-travel: 1.5x, Café!", tokens);
+    CHECK((tokens == std::vector<std::string>{ "blind", "travel", "1", "5x", "caf\xC3\xA9" }));
+}
+
+void TestMatching() {
+    NotesSearchIndex index;
+    index.Upsert("a", "Bastion routes", "Housing and treasure variants, pearls from the chest");
+    index.Upsert("b", "Portal notes", "Trade for pearls then build the portal near the bastion");
+    index.Upsert("c", "Stronghold", "Measure the eye throw and triangulate");
+    CHECK(index.DocumentCount() == 3);
+
+    auto hits = index.Search("bastion", 10);
+    CHECK(hits.size() == 2);
+    CHECK(!hits.empty() && hits[0].key == "a"); // Title match ranks first
+
+    hits = index.Search("pearls portal", 10);
+    CHECK(hits.size() == 1 && HasKey(hits, "b")); // Every word must match
+
+    CHECK(index.Search("triang", 10).size() == 1);  // Last word typed so far: prefix
+    CHECK(index.Search("triang ", 10).empty());      // Finished word: exact
+    CHECK(index.Search("pear treas", 10).empty());   // Only the last word is a prefix
+    CHECK(index.Search("pearls treas", 10).size() == 1);
+    CHECK(index.Search("", 10).empty() && index.Search("...", 10).empty());
+    CHECK(index.Search("pearls", 1).size() == 1);
+
+    index.Upsert("c", "Stronghold", "Pearls left over after the portal");
+    CHECK(index.Search("triangulate", 10).empty());
+    CHECK(HasKey(index.Search("pearls portal", 10), "c"));
+    index.Remove("b");
+    CHECK(!HasKey(index.Search("pearls", 10), "b"));
+    CHECK(index.DocumentCount() == 2);
+    index.Upsert("d", "New", "pearls"); // Reuses b's slot
+    CHECK(HasKey(index.Search("pearls", 10), "d") && !HasKey(index.Search("pearls", 10), "b"));
+    index.Clear();
+    CHECK(index.DocumentCount() == 0 && index.TermCount() == 0 && index.Search("pearls", 10).empty());
+}
+
+void TestLatency() {
+    constexpr int kNotes = 5000;
+    constexpr int kQueries = 2000;
+    constexpr int kVocabulary = 20000;
+
+    std::mt19937 rng(1234);
+    std::vector<std::string> words(kVocabulary);
+    for (int i = 0; i < kVocabulary; ++i) {
+        const int length = 3 + static_cast<int>(rng() % 8);
+        for (int c = 0; c < length; ++c) words[i].push_back(static_cast<char>('a' + rng() % 26));
+    }
+    // Zipf(1) over the vocabulary
+    std::vector<double> cumulative(kVocabulary);
+    double total = 0.0;
+    for (int i = 0; i < kVocabulary; ++i) cumulative[i] = (total += 1.0 / (i + 1));
+    auto pickWord = [&]() -> const std::string& {
+        const double r = std::uniform_real_distribution<double>(0.0, total)(rng);
+        return words[std::lower_bound(cumulative.begin(), cumulative.end(), r) - cumulative.begin()];
+    };
+
+    NotesSearchIndex index;
+    std::string title, body;
+    for (int n = 0; n < kNotes; ++n) {
+        title = pickWord() + " " + pickWord();
+        body.clear();
+        const int length = 200 + static_cast<int>(rng() % 801);
+        for (int w = 0; w < length; ++w) (body += pickWord()) += (w % 12 == 11 ? "\n" : " ");
+        index.Upsert("note" + std::to_string(n), title, body);
+    }
+
+    // Half single words, half two-word queries typed up to a partial last word
+    std::vector<std::string> queries(kQueries);
+    for (int q = 0; q < kQueries; ++q) {
+        queries[q] = pickWord();
+        if (q % 2) {
+            const std::string& last = pickWord();
+            queries[q] += " " + last.substr(0, std::max<size_t>(1, last.size() / 2));
+        }
+    }
+
+    std::vector<double> ms(kQueries);
+    size_t results = 0;
+    for (int q = 0; q < kQueries; ++q) {
+        const double t0 = BenchSeconds();
+        results += index.Search(queries[q], 50).size();
+        ms[q] = (BenchSeconds() - t0) * 1000.0;
+    }
+    std::sort(ms.begin(), ms.end());
+    double sum = 0.0;
+    for (double v : ms) sum += v;
+    const double mean = sum / kQueries, p99 = ms[kQueries * 99 / 100], worst = ms.back();
+    std::printf("  %d notes, %zu terms: mean %.3f ms, p99 %.3f ms, max %.3f ms (%zu results)\n", kNotes, index.TermCount(), mean, p99, worst,
+                results);
+
+    CHECK(results > 0);
+    // Generous bounds (sanitizer builds run several times slower); a regression to scanning documents blows past them
+    CHECK_MSG(mean < 4.0, "mean %.3f ms", mean);
+    CHECK_MSG(p99 < 16.0, "p99 %.3f ms", p99);
+}
+
+} // namespace
+
+int main() {
+    TestTokenize();
+    TestMatching();
+    TestLatency();
+    return TestResult("notes_search_test");
+}
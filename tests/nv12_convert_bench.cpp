@@ -0,0 +1,29 @@
+// RGBA->NV12 throughput per kernel, single-threaded, plus the default banded path. Reports GB/s of RGBA input.
+
+#include "nv12_convert.h"
+#include "test_util.h"
+
+#include <vector>
+
+int main() {
+    const uint32_t sizes[][2] = { { 1920, 1080 }, { 2560, 1440 }, { 3840, 2160 } };
+    for (const auto& size : sizes) {
+        const uint32_t width = size[0];
+        const uint32_t height = size[1];
+        std::vector<uint8_t> rgba(static_cast<size_t>(width) * height * 4);
+        for (size_t i = 0; i < rgba.size(); ++i) rgba[i] = static_cast<uint8_t>(i * 2654435761u >> 24);
+        std::vector<uint8_t> nv12(static_cast<size_t>(width) * height * 3 / 2);
+        const double gb = rgba.size() / 1e9;
+
+        std::printf("%ux%u:\n", width, height);
+        for (const Nv12ConvertKernel kernel : { Nv12ConvertKernel::Scalar, Nv12ConvertKernel::Sse41, Nv12ConvertKernel::Avx2 }) {
+            const double s = BestSeconds([&] { ConvertRGBAtoNV12WithKernel(kernel, rgba.data(), nv12.data(), width, height); }, 20);
+            std::printf("  %-7s %6.2f GB/s  %6.3f ms\n", GetNv12ConvertKernelName(kernel), gb / s, s * 1000.0);
+        }
+        const double s = BestSeconds([&] { ConvertRGBAtoNV12(rgba.data(), nv12.data(), width, height); }, 20);
+        std::printf("  default %6.2f GB/s  %6.3f ms (%s, banded at 1440p and above)\n", gb / s, s * 1000.0,
+                    GetNv12ConvertKernelName(GetActiveNv12ConvertKernel()));
+    }
+    ShutdownNv12ConvertWorkers();
+    return 0;
+}
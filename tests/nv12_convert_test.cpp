@@ -0,0 +1,82 @@
+// Exactness test for the RGBA->NV12 kernels: every kernel, and the banded multi-threaded path, must match an
+// independent per-pixel BT.601 reference byte for byte, including widths that aren't a multiple of the SIMD step.
+
+#include "nv12_convert.h"
+#include "test_util.h"
+
+#include <algorithm>
+#include <random>
+#include <vector>
+
+namespace {
+
+// Clamped per-pixel reference, written from the formula rather than the scalar kernel
+std::vector<uint8_t> ReferenceNv12(const std::vector<uint8_t>& rgba, uint32_t width, uint32_t height) {
+    std::vector<uint8_t> out(static_cast<size_t>(width) * height * 3 / 2);
+    auto clampByte = [](int v) { return static_cast<uint8_t>(std::clamp(v, 0, 255)); };
+    auto px = [&](uint32_t x, uint32_t yTopDown, int channel) {
+        return static_cast<int>(rgba[(static_cast<size_t>(height - 1 - yTopDown) * width + x) * 4 + channel]);
+    };
+    for (uint32_t y = 0; y < height; ++y) {
+        for (uint32_t x = 0; x < width; ++x) {
+            out[static_cast<size_t>(y) * width + x] = clampByte(((66 * px(x, y, 0) + 129 * px(x, y, 1) + 25 * px(x, y, 2) + 128) >> 8) + 16);
+        }
+    }
+    uint8_t* uv = out.data() + static_cast<size_t>(width) * height;
+    for (uint32_t y = 0; y < height; y += 2) {
+        for (uint32_t x = 0; x < width; x += 2) {
+            int avg[3];
+            for (int c = 0; c < 3; ++c) avg[c] = (px(x, y, c) + px(x + 1, y, c) + px(x, y + 1, c) + px(x + 1, y + 1, c) + 2) >> 2;
+            uint8_t* dst = uv + static_cast<size_t>(y / 2) * width + x;
+            dst[0] = clampByte(((-38 * avg[0] - 74 * avg[1] + 112 * avg[2] + 128) >> 8) + 128);
+            dst[1] = clampByte(((112 * avg[0] - 94 * avg[1] - 18 * avg[2] + 128) >> 8) + 128);
+        }
+    }
+    return out;
+}
+
+void CheckFrame(const char* label, const std::vector<uint8_t>& rgba, uint32_t width, uint32_t height) {
+    const std::vector<uint8_t> expected = ReferenceNv12(rgba, width, height);
+    std::vector<uint8_t> actual(expected.size());
+
+    for (const Nv12ConvertKernel kernel : { Nv12ConvertKernel::Scalar, Nv12ConvertKernel::Sse41, Nv12ConvertKernel::Avx2 }) {
+        std::fill(actual.begin(), actual.end(), 0xCD);
+        ConvertRGBAtoNV12WithKernel(kernel, rgba.data(), actual.data(), width, height);
+        const auto mismatch = std::mismatch(expected.begin(), expected.end(), actual.begin());
+        CHECK_MSG(mismatch.first == expected.end(), "%s %ux%u %s: first mismatch at byte %td", label, width, height,
+                  GetNv12ConvertKernelName(kernel), mismatch.first - expected.begin());
+    }
+
+    // Default path: best kernel, banded across helper threads for large frames
+    std::fill(actual.begin(), actual.end(), 0xCD);
+    ConvertRGBAtoNV12(rgba.data(), actual.data(), width, height);
+    CHECK_MSG(actual == expected, "%s %ux%u default path", label, width, height);
+}
+
+} // namespace
+
+int main() {
+    std::printf("active kernel: %s\n", GetNv12ConvertKernelName(GetActiveNv12ConvertKernel()));
+    std::mt19937 rng(7);
+    const uint32_t sizes[][2] = { { 2, 2 }, { 4, 2 }, { 6, 4 }, { 14, 2 }, { 18, 6 }, { 30, 8 }, { 34, 10 }, { 62, 4 },
+                                  { 66, 2 }, { 640, 360 }, { 1918, 1080 }, { 2560, 1440 }, { 3840, 2160 } };
+    for (const auto& size : sizes) {
+        const uint32_t width = size[0];
+        const uint32_t height = size[1];
+        std::vector<uint8_t> rgba(static_cast<size_t>(width) * height * 4);
+        for (auto& b : rgba) b = static_cast<uint8_t>(rng());
+        CheckFrame("random", rgba, width, height);
+        if (width <= 66) {
+            std::fill(rgba.begin(), rgba.end(), 255);
+            CheckFrame("white", rgba, width, height);
+            std::fill(rgba.begin(), rgba.end(), 0);
+            CheckFrame("black", rgba, width, height);
+        }
+    }
+    ShutdownNv12ConvertWorkers();
+    // Workers restart on demand after a shutdown
+    std::vector<uint8_t> rgba(2560ull * 1440 * 4, 77);
+    CheckFrame("after shutdown", rgba, 2560, 1440);
+    ShutdownNv12ConvertWorkers();
+    return TestResult("nv12_convert_test");
+}
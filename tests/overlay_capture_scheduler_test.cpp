@@ -0,0 +1,178 @@
+// Overlay capture scheduler, on a 1000 ticks/s clock so ticks read as milliseconds: the earliest deadline is dispatched
+// first; an overlay in flight is never handed out again; an overrun skips to the latest slot on its grid and counts
+// the slots it missed; MarkUrgent during a capture reschedules it for right after; Sync drops an overlay even while
+// it is in flight; and the stats come out once per one-second window and reset after.
+
+#include "overlay_capture_scheduler.h"
+#include "test_util.h"
+
+#include <string>
+#include <vector>
+
+namespace {
+
+OverlayCaptureScheduler MakeScheduler() {
+    OverlayCaptureScheduler scheduler;
+    scheduler.SetTicksPerSecond(1000);
+    return scheduler;
+}
+
+void TestEarliestDeadlineFirst() {
+    OverlayCaptureScheduler scheduler = MakeScheduler();
+    scheduler.Sync({ { "slow", 10 } }, 0);             // Every 100 ticks, due at 0
+    scheduler.Sync({ { "slow", 10 }, { "fast", 50 } }, 5); // Every 20 ticks, due at 5
+    CHECK(scheduler.Size() == 2);
+    CHECK(scheduler.NextDeadline() == 0);
+
+    std::string id;
+    CHECK(scheduler.PopDue(10, id) && id == "slow");
+    CHECK(scheduler.PopDue(10, id) && id == "fast");
+    CHECK(!scheduler.PopDue(10, id));
+
+    scheduler.Complete("slow", 10, 12);
+    scheduler.Complete("fast", 10, 12);
+    CHECK(scheduler.NextDeadline() == 25);
+    CHECK(!scheduler.PopDue(24, id));
+    CHECK(scheduler.PopDue(25, id) && id == "fast");
+    scheduler.Complete("fast", 25, 27);
+
+    // Both due by now: the older deadline goes first whatever the list order
+    CHECK(scheduler.PopDue(200, id) && id == "fast"); // Deadline 45
+    CHECK(scheduler.PopDue(200, id) && id == "slow"); // Deadline 100
+}
+
+void TestNoDoubleDispatch() {
+    OverlayCaptureScheduler scheduler = MakeScheduler();
+    scheduler.Sync({ { "a", 30 } }, 0);
+    std::string id;
+    CHECK(scheduler.PopDue(0, id) && id == "a");
+    CHECK(scheduler.NextDeadline() == OverlayCaptureScheduler::kNoDeadline);
+    for (int64_t now = 0; now < 5000; now += 250) CHECK_MSG(!scheduler.PopDue(now, id), "dispatched again at %lld", (long long)now);
+
+    // A Complete for an overlay that isn't in flight changes nothing
+    scheduler.Complete("a", 10, 20);
+    scheduler.Complete("a", 10, 20);
+    CHECK(scheduler.NextDeadline() == 33);
+    scheduler.Complete("a", 40, 50);
+    CHECK(scheduler.NextDeadline() == 33);
+}
+
+void TestMissedSlots() {
+    OverlayCaptureScheduler scheduler = MakeScheduler();
+    scheduler.Sync({ { "a", 10 } }, 0);
+    std::string id;
+    CHECK(scheduler.PopDue(0, id));
+    // Slots at 100, 200 and 300 pass during a 350-tick capture: 100 and 200 are skipped, 300 is the next one
+    scheduler.Complete("a", 0, 350);
+    CHECK(scheduler.NextDeadline() == 300);
+    CHECK(scheduler.PopDue(350, id));
+    scheduler.Complete("a", 350, 360); // On time again: the next slot on the grid
+    CHECK(scheduler.NextDeadline() == 400);
+
+    // A capture finishing exactly on a slot misses nothing
+    CHECK(scheduler.PopDue(400, id));
+    scheduler.Complete("a", 400, 500);
+    CHECK(scheduler.NextDeadline() == 500);
+
+    std::vector<OverlayCaptureScheduler::Stats> stats;
+    CHECK(!scheduler.TakeWindowStats(1000, stats));
+    CHECK(scheduler.TakeWindowStats(2000, stats));
+    CHECK(stats.size() == 1 && stats[0].captures == 3 && stats[0].missed == 2);
+}
+
+void TestUrgent() {
+    OverlayCaptureScheduler scheduler = MakeScheduler();
+    scheduler.Sync({ { "a", 10 } }, 0);
+    std::string id;
+    CHECK(scheduler.PopDue(0, id));
+
+    // Content changed mid-capture: rerun right after this one, not a full interval later, and only once
+    scheduler.MarkUrgent("a", 5);
+    CHECK(!scheduler.PopDue(5, id));
+    scheduler.Complete("a", 0, 10);
+    CHECK(scheduler.NextDeadline() == 10);
+    CHECK(scheduler.PopDue(10, id) && id == "a");
+    scheduler.Complete("a", 10, 20);
+    CHECK(scheduler.NextDeadline() == 110); // Back on the grid from the urgent dispatch
+
+    // While idle, an urgent mark pulls the deadline in but never pushes it out
+    scheduler.MarkUrgent("a", 50);
+    CHECK(scheduler.NextDeadline() == 50);
+    scheduler.MarkUrgent("a", 80);
+    CHECK(scheduler.NextDeadline() == 50);
+    scheduler.MarkUrgent("missing", 0);
+    CHECK(scheduler.Size() == 1);
+}
+
+void TestSyncDropsInFlight() {
+    OverlayCaptureScheduler scheduler = MakeScheduler();
+    scheduler.Sync({ { "a", 10 }, { "b", 10 } }, 0);
+    std::string id;
+    CHECK(scheduler.PopDue(0, id) && id == "a");
+
+    scheduler.Sync({ { "b", 10 } }, 5);
+    CHECK(scheduler.Size() == 1);
+    scheduler.Complete("a", 0, 30); // The capture that was running when "a" was removed lands: ignored
+    CHECK(scheduler.PopDue(30, id) && id == "b");
+    CHECK(!scheduler.PopDue(30, id));
+
+    // Added back, it is a new overlay: due at once, not in flight, no stats from before
+    scheduler.Sync({ { "b", 10 }, { "a", 10 } }, 40);
+    CHECK(scheduler.NextDeadline() == 40);
+    CHECK(scheduler.PopDue(40, id) && id == "a");
+    scheduler.Complete("b", 30, 45);
+
+    std::vector<OverlayCaptureScheduler::Stats> stats;
+    CHECK(!scheduler.TakeWindowStats(1000, stats));
+    CHECK(scheduler.TakeWindowStats(2000, stats));
+    CHECK(stats.size() == 2 && stats[0].id == "b" && stats[1].id == "a");
+    CHECK(stats.size() == 2 && stats[0].captures == 1 && stats[1].captures == 0);
+
+    // An fps change keeps the current deadline and applies from the next Complete
+    scheduler.Sync({ { "b", 50 } }, 50);
+    CHECK(scheduler.NextDeadline() == 100);
+    CHECK(scheduler.PopDue(100, id) && id == "b");
+    scheduler.Complete("b", 100, 105);
+    CHECK(scheduler.NextDeadline() == 120);
+}
+
+void TestWindowStats() {
+    OverlayCaptureScheduler scheduler = MakeScheduler();
+    scheduler.Sync({ { "a", 10 } }, 1000);
+    std::vector<OverlayCaptureScheduler::Stats> stats;
+    CHECK(!scheduler.TakeWindowStats(1000, stats)); // Opens the window
+
+    std::string id;
+    CHECK(scheduler.PopDue(1004, id));
+    scheduler.Complete("a", 1004, 1010); // 6 ms, 4 ms late
+    CHECK(scheduler.PopDue(1100, id));
+    scheduler.Complete("a", 1101, 1103); // 2 ms, 1 ms late
+
+    CHECK(!scheduler.TakeWindowStats(1999, stats));
+    CHECK(stats.empty());
+    CHECK(scheduler.TakeWindowStats(2000, stats));
+    CHECK(stats.size() == 1);
+    if (stats.size() == 1) {
+        CHECK(stats[0].id == "a" && stats[0].captures == 2 && stats[0].missed == 0);
+        CHECK_MSG(stats[0].avgCaptureMs == 4.0, "avg %.3f", stats[0].avgCaptureMs);
+        CHECK(stats[0].maxCaptureMs == 6.0);
+        CHECK(stats[0].maxLatenessMs == 4.0);
+    }
+
+    // The next window starts where the last one was taken, with the counters reset
+    CHECK(!scheduler.TakeWindowStats(2999, stats));
+    CHECK(scheduler.TakeWindowStats(3000, stats));
+    CHECK(stats.size() == 1 && stats[0].captures == 0 && stats[0].avgCaptureMs == 0.0 && stats[0].maxCaptureMs == 0.0);
+}
+
+} // namespace
+
+int main() {
+    TestEarliestDeadlineFirst();
+    TestNoDoubleDispatch();
+    TestMissedSlots();
+    TestUrgent();
+    TestSyncDropsInFlight();
+    TestWindowStats();
+    return TestResult("overlay_capture_scheduler_test");
+}
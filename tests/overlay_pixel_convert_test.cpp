@@ -0,0 +1,157 @@
+// Exactness test for the window overlay BGRA->RGBA kernels. The scalar kernel must match the float per-pixel loop
+// window_overlay.cpp used before the kernels, byte for byte, on random frames with pixels on, just inside and just
+// outside each color key; every kernel, in place and out of place, and the default path must then match the scalar
+// kernel exactly. Pixel counts that aren't a multiple of the SIMD step cover the tails.
+//
+// One known difference: when (255 * sensitivity)^2 falls within float rounding of a whole number (e.g. 0.2 -> 2601),
+// the float loop accepts some colors at exactly that distance and rejects others depending on rounding of the channel
+// terms. The kernels always include the boundary. Only those pixels are exempt from the legacy comparison.
+
+#include "overlay_pixel_convert.h"
+#include "test_util.h"
+
+#include <algorithm>
+#include <array>
+#include <cmath>
+#include <random>
+#include <utility>
+#include <vector>
+
+namespace {
+
+struct FloatKey {
+    float r, g, b, sensitivity;
+};
+
+// The scalar swap + float distance loop the kernels replaced (same as in overlay_pixel_convert_bench)
+void LegacyConvert(uint8_t* pixels, size_t pixelCount, const std::vector<FloatKey>& keys) {
+    for (size_t i = 0; i < pixelCount; i++) {
+        uint8_t* pixel = &pixels[i * 4];
+        std::swap(pixel[0], pixel[2]);
+        if (keys.empty()) {
+            pixel[3] = 255;
+            continue;
+        }
+        const float r = pixel[0] / 255.0f;
+        const float g = pixel[1] / 255.0f;
+        const float b = pixel[2] / 255.0f;
+        bool matchesAnyKey = false;
+        for (const auto& key : keys) {
+            const float dr = r - key.r, dg = g - key.g, db = b - key.b;
+            if (dr * dr + dg * dg + db * db <= key.sensitivity * key.sensitivity) {
+                matchesAnyKey = true;
+                break;
+            }
+        }
+        pixel[3] = matchesAnyKey ? 0 : 255;
+    }
+}
+
+uint8_t ClampByte(int v) { return static_cast<uint8_t>(std::clamp(v, 0, 255)); }
+
+// Random BGRA with, for every key, the key color itself and colors around its match radius on each axis and diagonal
+std::vector<uint8_t> MakeFrame(size_t pixelCount, const std::vector<FloatKey>& keys, std::mt19937& rng) {
+    std::vector<uint8_t> bgra(pixelCount * 4);
+    for (auto& b : bgra) b = static_cast<uint8_t>(rng());
+
+    std::vector<std::array<int, 3>> special;
+    for (const FloatKey& k : keys) {
+        const int r = static_cast<int>(std::lround(k.r * 255.0f)), g = static_cast<int>(std::lround(k.g * 255.0f)),
+                  b = static_cast<int>(std::lround(k.b * 255.0f));
+        const int radius = static_cast<int>(k.sensitivity * 255.0f);
+        for (const int d : { 0, 1, radius - 1, radius, radius + 1 }) {
+            for (const int sign : { -1, 1 }) {
+                special.push_back({ r + sign * d, g, b });
+                special.push_back({ r, g + sign * d, b });
+                special.push_back({ r, g, b + sign * d });
+                const int diag = static_cast<int>(std::lround(d / std::sqrt(3.0)));
+                special.push_back({ r + sign * diag, g + sign * diag, b - sign * diag });
+            }
+        }
+    }
+    // Spread the special colors over the frame, so they land in SIMD bodies and tails alike
+    for (size_t i = 0; i < special.size() && pixelCount > 0; ++i) {
+        uint8_t* p = bgra.data() + (rng() % pixelCount) * 4;
+        p[0] = ClampByte(special[i][2]);
+        p[1] = ClampByte(special[i][1]);
+        p[2] = ClampByte(special[i][0]);
+    }
+    return bgra;
+}
+
+// True if the BGRA pixel lies exactly on a key's radius where the float loop's answer depends on rounding
+bool OnAmbiguousBoundary(const uint8_t* bgra, const std::vector<OverlayColorKey>& keys, const std::vector<FloatKey>& floatKeys) {
+    for (size_t k = 0; k < keys.size(); ++k) {
+        const double scaled = static_cast<double>(floatKeys[k].sensitivity) * 255.0;
+        if (scaled * scaled - keys[k].maxDistanceSq > 1e-2) continue;
+        const int dr = bgra[2] - keys[k].r, dg = bgra[1] - keys[k].g, db = bgra[0] - keys[k].b;
+        if (static_cast<uint32_t>(dr * dr + dg * dg + db * db) == keys[k].maxDistanceSq) return true;
+    }
+    return false;
+}
+
+void CheckFrame(size_t pixelCount, const std::vector<FloatKey>& floatKeys, std::mt19937& rng, int& boundaryPixels) {
+    std::vector<OverlayColorKey> keys;
+    for (const auto& k : floatKeys) keys.push_back(MakeOverlayColorKey(k.r, k.g, k.b, k.sensitivity));
+    const std::vector<uint8_t> source = MakeFrame(pixelCount, floatKeys, rng);
+    std::vector<uint8_t> legacy = source;
+    LegacyConvert(legacy.data(), pixelCount, floatKeys);
+
+    // Scalar kernel against the legacy loop
+    std::vector<uint8_t> expected(source.size());
+    ConvertOverlayBGRAToRGBAWithKernel(OverlayConvertKernel::Scalar, source.data(), expected.data(), pixelCount, keys.data(), keys.size());
+    int wrong = 0;
+    for (size_t i = 0; i < pixelCount; ++i) {
+        if (std::equal(expected.begin() + i * 4, expected.begin() + i * 4 + 4, legacy.begin() + i * 4)) continue;
+        const bool boundary = OnAmbiguousBoundary(&source[i * 4], keys, floatKeys);
+        if (boundary && std::equal(expected.begin() + i * 4, expected.begin() + i * 4 + 3, legacy.begin() + i * 4) && expected[i * 4 + 3] == 0) {
+            ++boundaryPixels;
+            continue;
+        }
+        if (wrong++ == 0) {
+            CHECK_MSG(false, "%zu px, %zu key(s): pixel %zu differs from the legacy loop (alpha %d vs %d)", pixelCount, keys.size(), i,
+                      expected[i * 4 + 3], legacy[i * 4 + 3]);
+        }
+    }
+
+    std::vector<uint8_t> actual(source.size());
+    for (const OverlayConvertKernel kernel : { OverlayConvertKernel::Scalar, OverlayConvertKernel::Sse2, OverlayConvertKernel::Avx2 }) {
+        std::fill(actual.begin(), actual.end(), 0xCD);
+        ConvertOverlayBGRAToRGBAWithKernel(kernel, source.data(), actual.data(), pixelCount, keys.data(), keys.size());
+        auto mismatch = std::mismatch(expected.begin(), expected.end(), actual.begin());
+        CHECK_MSG(mismatch.first == expected.end(), "%zu px, %zu key(s), %s: first mismatch at byte %td", pixelCount, keys.size(),
+                  GetOverlayConvertKernelName(kernel), mismatch.first - expected.begin());
+
+        actual = source;
+        ConvertOverlayBGRAToRGBAWithKernel(kernel, actual.data(), actual.data(), pixelCount, keys.data(), keys.size());
+        mismatch = std::mismatch(expected.begin(), expected.end(), actual.begin());
+        CHECK_MSG(mismatch.first == expected.end(), "%zu px, %zu key(s), %s in place: first mismatch at byte %td", pixelCount,
+                  keys.size(), GetOverlayConvertKernelName(kernel), mismatch.first - expected.begin());
+    }
+
+    actual = source;
+    ConvertOverlayBGRAToRGBA(actual.data(), actual.data(), pixelCount, keys.data(), keys.size());
+    CHECK_MSG(actual == expected, "%zu px, %zu key(s), default kernel", pixelCount, keys.size());
+}
+
+} // namespace
+
+int main() {
+    std::printf("active kernel: %s\n", GetOverlayConvertKernelName(GetActiveOverlayConvertKernel()));
+
+    // Key colors are whole 8-bit steps, as the color picker produces; sensitivities cover small, wide and one whose
+    // squared radius is a whole number (0.2)
+    auto key = [](int r, int g, int b, float sensitivity) { return FloatKey{ r / 255.0f, g / 255.0f, b / 255.0f, sensitivity }; };
+    const std::vector<FloatKey> allKeys = { key(0, 255, 0, 0.1f), key(255, 0, 255, 0.05f), key(51, 51, 51, 0.02f),
+                                            key(255, 255, 255, 0.15f), key(128, 64, 32, 0.2f), key(10, 200, 90, 0.0f) };
+
+    std::mt19937 rng(37);
+    int boundaryPixels = 0;
+    for (const size_t pixelCount : { size_t(1), size_t(3), size_t(7), size_t(8), size_t(15), size_t(33), size_t(1000), size_t(640 * 37 + 5) }) {
+        for (const size_t keyCount : { size_t(0), size_t(1), size_t(2), size_t(4), size_t(6) }) {
+            CheckFrame(pixelCount, std::vector<FloatKey>(allKeys.begin(), allKeys.begin() + keyCount), rng, boundaryPixels);
+        }
+    }
+    std::printf("%d pixel(s) on an ambiguous key boundary (kept by the kernels, mixed in the float loop)\n", boundaryPixels);
+    return TestResult("overlay_pixel_convert_test");
+}
@@ -0,0 +1,175 @@
+// Profiler latency histogram: bucket index, lower bound and width agree with each other for every bucket and tile
+// the range without gaps; values past the top octave (and negative ones) land in the end buckets; quantiles of
+// 200k lognormal samples stay within 1.5% of the exact nearest-rank values; Add and the rolling Merge match a single
+// histogram fed the same samples; and Rotate forgets exactly the oldest slice.
+
+#include "profiler_histogram.h"
+#include "test_util.h"
+
+#include <algorithm>
+#include <cmath>
+#include <cstdint>
+#include <limits>
+#include <random>
+#include <vector>
+
+namespace {
+
+using H = LatencyHistogram;
+
+void TestBuckets() {
+    int bad = 0;
+    for (int i = 0; i < H::kBucketCount; ++i) {
+        const int64_t lower = H::BucketLowerNs(i), width = H::BucketWidthNs(i);
+        if (width <= 0 || H::BucketIndex(lower) != i || H::BucketIndex(lower + width - 1) != i) {
+            if (bad++ == 0) CHECK_MSG(false, "bucket %d: lower %lld width %lld", i, (long long)lower, (long long)width);
+        }
+        if (i + 1 < H::kBucketCount && lower + width != H::BucketLowerNs(i + 1)) {
+            if (bad++ == 0) CHECK_MSG(false, "gap after bucket %d", i);
+        }
+        // Above the linear range a bucket is at most 1/kSubBuckets of its lower bound wide
+        if (lower >= (int64_t{ 2 * H::kSubBuckets } << H::kUnitShift) && width * H::kSubBuckets > lower) {
+            if (bad++ == 0) CHECK_MSG(false, "bucket %d too wide", i);
+        }
+    }
+    CHECK(bad == 0);
+    CHECK(H::BucketLowerNs(0) == 0);
+    CHECK(H::BucketIndex(63) == 0 && H::BucketIndex(64) == 1); // 64 ns units
+
+    // Every octave up to the top, at its bottom, middle and last nanosecond
+    for (int bit = H::kUnitShift; bit < 37; ++bit) {
+        for (const int64_t v : { int64_t{ 1 } << bit, (int64_t{ 3 } << bit) / 2, (int64_t{ 2 } << bit) - 1 }) {
+            const int i = H::BucketIndex(v);
+            CHECK_MSG(H::BucketLowerNs(i) <= v && v < H::BucketLowerNs(i) + H::BucketWidthNs(i), "%lld ns -> bucket %d", (long long)v, i);
+        }
+    }
+
+    // The top octave ends at 2^31 units (~137 s); anything above saturates, anything negative counts as zero
+    const int top = H::kBucketCount - 1;
+    const int64_t end = H::BucketLowerNs(top) + H::BucketWidthNs(top);
+    CHECK(end == (int64_t{ 1 } << (31 + H::kUnitShift)));
+    CHECK(H::BucketIndex(end - 1) == top);
+    CHECK(H::BucketIndex(end) == top);
+    CHECK(H::BucketIndex(int64_t{ 3600 } * 1000000000) == top);
+    CHECK(H::BucketIndex(std::numeric_limits<int64_t>::max()) == top);
+    CHECK(H::BucketIndex(-5) == 0 && H::BucketIndex(std::numeric_limits<int64_t>::min()) == 0);
+
+    H h;
+    h.Record(std::numeric_limits<int64_t>::max());
+    CHECK(h.Count() == 1 && h.ValueAtQuantileNs(1.0) <= h.MaxNs());
+}
+
+int64_t ExactQuantile(const std::vector<int64_t>& sorted, double q) {
+    const size_t rank = std::clamp<size_t>(static_cast<size_t>(std::ceil(q * sorted.size())), 1, sorted.size());
+    return sorted[rank - 1];
+}
+
+void TestQuantiles() {
+    // Frame-time-like: lognormal around 0.5 ms with a long tail
+    std::mt19937_64 rng(40);
+    std::lognormal_distribution<double> dist(std::log(500000.0), 0.8);
+    std::vector<int64_t> values(200000);
+    H h;
+    for (auto& v : values) {
+        v = static_cast<int64_t>(dist(rng));
+        h.Record(v);
+    }
+    std::sort(values.begin(), values.end());
+    CHECK(h.Count() == values.size() && h.MaxNs() == values.back());
+
+    double worst = 0.0;
+    for (const double q : { 0.01, 0.1, 0.25, 0.5, 0.75, 0.9, 0.95, 0.99, 0.995, 0.999, 0.9999 }) {
+        const double exact = static_cast<double>(ExactQuantile(values, q));
+        const double error = std::abs(static_cast<double>(h.ValueAtQuantileNs(q)) - exact) / exact;
+        worst = std::max(worst, error);
+        CHECK_MSG(error <= 0.015, "p%g: %lld vs exact %.0f (%.2f%%)", q * 100.0, (long long)h.ValueAtQuantileNs(q), exact, error * 100.0);
+    }
+    std::printf("worst quantile error %.3f%%\n", worst * 100.0);
+    CHECK(std::abs(h.ValueAtQuantileNs(1.0) - values.back()) <= H::BucketWidthNs(H::BucketIndex(values.back())) / 2);
+
+    // A single value reports within half a bucket of itself, and an empty histogram reports 0
+    H one;
+    one.Record(1234567);
+    const int i = H::BucketIndex(1234567);
+    CHECK(std::abs(one.ValueAtQuantileNs(0.5) - 1234567) <= H::BucketWidthNs(i) / 2);
+    CHECK(H().ValueAtQuantileNs(0.99) == 0);
+}
+
+bool SameHistogram(const H& a, const H& b) {
+    if (a.Count() != b.Count() || a.MaxNs() != b.MaxNs()) return false;
+    for (int q = 1; q <= 1000; ++q) {
+        if (a.ValueAtQuantileNs(q / 1000.0) != b.ValueAtQuantileNs(q / 1000.0)) return false;
+    }
+    return true;
+}
+
+void TestAddAndMerge() {
+    std::mt19937_64 rng(41);
+    std::uniform_int_distribution<int64_t> dist(0, 50000000);
+    H all, first, second;
+    for (int i = 0; i < 5000; ++i) {
+        const int64_t v = dist(rng);
+        all.Record(v);
+        (i % 3 == 0 ? first : second).Record(v);
+    }
+    H sum;
+    sum.Add(first);
+    sum.Add(second);
+    sum.Add(H());
+    CHECK(SameHistogram(sum, all));
+
+    // Spread over the slices of a rolling window, Merge sees all of them
+    RollingLatencyHistogram rolling;
+    H expected;
+    for (int slice = 0; slice < RollingLatencyHistogram::kSlices; ++slice) {
+        if (slice > 0) rolling.Rotate();
+        for (int i = 0; i < 1000; ++i) {
+            const int64_t v = dist(rng);
+            rolling.Record(v);
+            expected.Record(v);
+        }
+    }
+    H merged;
+    merged.Record(1); // Merge replaces what was there
+    rolling.Merge(merged);
+    CHECK(SameHistogram(merged, expected));
+
+    sum.Clear();
+    CHECK(sum.Count() == 0 && sum.MaxNs() == 0 && sum.ValueAtQuantileNs(0.5) == 0);
+}
+
+void TestRotate() {
+    RollingLatencyHistogram rolling;
+    H merged;
+    rolling.Record(1000000); // 1 ms, in the oldest slice
+    for (int i = 1; i < RollingLatencyHistogram::kSlices; ++i) {
+        rolling.Rotate();
+        rolling.Record(2000);
+        rolling.Merge(merged);
+        CHECK_MSG(merged.Count() == static_cast<uint64_t>(i + 1) && merged.MaxNs() == 1000000, "after %d rotation(s)", i);
+    }
+
+    // One more rotation reuses the oldest slice: the 1 ms sample is gone, the rest stay
+    rolling.Rotate();
+    rolling.Merge(merged);
+    CHECK(merged.Count() == RollingLatencyHistogram::kSlices - 1);
+    CHECK(merged.MaxNs() == 2000);
+    for (int i = 0; i < RollingLatencyHistogram::kSlices - 1; ++i) rolling.Rotate();
+    rolling.Merge(merged);
+    CHECK(merged.Count() == 0);
+
+    rolling.Record(5);
+    rolling.Clear();
+    rolling.Merge(merged);
+    CHECK(merged.Count() == 0);
+}
+
+} // namespace
+
+int main() {
+    TestBuckets();
+    TestQuantiles();
+    TestAddAndMerge();
+    TestRotate();
+    return TestResult("profiler_histogram_test");
+}
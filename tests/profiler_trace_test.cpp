@@ -0,0 +1,247 @@
+// Profiler timeline capture: Chrome trace output is valid JSON with escaped names and origin-relative microseconds,
+// the capture window and thread naming hold, overflow is counted, and a producer streaming into a running writer
+// loses nothing (run under -DTOOLSCREEN_TEST_SANITIZER=thread for the handoff).
+
+#include "profiler_trace.h"
+#include "test_util.h"
+
+#include <atomic>
+#include <cctype>
+#include <filesystem>
+#include <fstream>
+#include <sstream>
+#include <string>
+#include <thread>
+
+namespace {
+
+std::filesystem::path TempPath(const char* name) { return std::filesystem::temp_directory_path() / name; }
+
+std::string ReadFile(const std::filesystem::path& path) {
+    std::ifstream in(path, std::ios::binary);
+    std::stringstream ss;
+    ss << in.rdbuf();
+    return ss.str();
+}
+
+size_t CountOccurrences(const std::string& text, const std::string& needle) {
+    size_t count = 0;
+    for (size_t pos = text.find(needle); pos != std::string::npos; pos = text.find(needle, pos + needle.size())) ++count;
+    return count;
+}
+
+// Minimal JSON syntax check (objects, arrays, strings with escapes, numbers, literals)
+class JsonValidator {
+  public:
+    explicit JsonValidator(const std::string& text) : m_text(text) {}
+
+    bool Valid() {
+        SkipSpace();
+        if (!Value()) return false;
+        SkipSpace();
+        return m_pos == m_text.size();
+    }
+
+  private:
+    void SkipSpace() {
+        while (m_pos < m_text.size() && std::isspace(static_cast<unsigned char>(m_text[m_pos]))) ++m_pos;
+    }
+    bool Eat(char c) {
+        SkipSpace();
+        if (m_pos < m_text.size() && m_text[m_pos] == c) {
+            ++m_pos;
+            return true;
+        }
+        return false;
+    }
+    bool String() {
+        if (!Eat('"')) return false;
+        while (m_pos < m_text.size()) {
+            const unsigned char c = static_cast<unsigned char>(m_text[m_pos++]);
+            if (c == '"') return true;
+            if (c < 0x20) return false;
+            if (c == '\\') {
+                if (m_pos >= m_text.size()) return false;
+                const char e = m_text[m_pos++];
+                if (e == 'u') {
+                    for (int i = 0; i < 4; ++i) {
+                        if (m_pos >= m_text.size() || !std::isxdigit(static_cast<unsigned char>(m_text[m_pos++]))) return false;
+                    }
+                } else if (std::string("\"\\/bfnrt").find(e) == std::string::npos) {
+                    return false;
+                }
+            }
+        }
+        return false;
+    }
+    bool Number() {
+        const size_t start = m_pos;
+        if (m_pos < m_text.size() && m_text[m_pos] == '-') ++m_pos;
+        while (m_pos < m_text.size() && (std::isdigit(static_cast<unsigned char>(m_text[m_pos])) || m_text[m_pos] == '.')) ++m_pos;
+        return m_pos > start;
+    }
+    bool Value() {
+        SkipSpace();
+        if (m_pos >= m_text.size()) return false;
+        const char c = m_text[m_pos];
+        if (c == '{') {
+            ++m_pos;
+            if (Eat('}')) return true;
+            do {
+                SkipSpace();
+                if (!String() || !Eat(':') || !Value()) return false;
+            } while (Eat(','));
+            return Eat('}');
+        }
+        if (c == '[') {
+            ++m_pos;
+            if (Eat(']')) return true;
+            do {
+                if (!Value()) return false;
+            } while (Eat(','));
+            return Eat(']');
+        }
+        if (c == '"') return String();
+        for (const char* literal : { "true", "false", "null" }) {
+            if (m_text.compare(m_pos, std::char_traits<char>::length(literal), literal) == 0) {
+                m_pos += std::char_traits<char>::length(literal);
+                return true;
+            }
+        }
+        return Number();
+    }
+
+    const std::string& m_text;
+    size_t m_pos = 0;
+};
+
+void TestWriterFormat() {
+    const auto path = TempPath("toolscreen_trace_writer_test.json");
+    ChromeTraceWriter writer;
+    CHECK(writer.Open(path, 1000000));
+    writer.WriteThreadName(7, "Game \"main\" \\ thread\n");
+    writer.WriteEvent({ "Outer", 1000000, 2500, 7 });
+    writer.WriteEvent({ "Inner \"quoted\"", 1001500, 1, 7 });
+    writer.WriteEvent({ "Before origin", 999000, 1000, 8 });
+    CHECK(writer.Close());
+
+    const std::string json = ReadFile(path);
+    CHECK_MSG(JsonValidator(json).Valid(), "invalid JSON:\n%s", json.c_str());
+    CHECK(json.find("\"name\":\"Game \\\"main\\\" \\\\ thread\\u000a\"") != std::string::npos);
+    CHECK(json.find("\"name\":\"Outer\",\"ph\":\"X\",\"pid\":1,\"tid\":7,\"ts\":0.000,\"dur\":2.500") != std::string::npos);
+    CHECK(json.find("\"name\":\"Inner \\\"quoted\\\"\",\"ph\":\"X\",\"pid\":1,\"tid\":7,\"ts\":1.500,\"dur\":0.001") != std::string::npos);
+    CHECK(json.find("\"ts\":-1.000") != std::string::npos);
+    CHECK(CountOccurrences(json, "\"ph\":\"X\"") == 3);
+    std::filesystem::remove(path);
+}
+
+void TestCaptureWindowAndThreads() {
+    const auto path = TempPath("toolscreen_trace_capture_test.json");
+    ProfilerTraceCapture capture;
+    const int64_t start = 5000000000;
+    const int64_t duration = 100000000; // 100 ms
+    CHECK(capture.Start(path, start, duration));
+    CHECK(capture.IsActive());
+    CHECK(!capture.Start(path, start, duration)); // Already running
+
+    capture.AddThread(1, "Render Thread");
+    capture.AddThread(1, "Renamed"); // First name per capture wins
+    capture.AddThread(2, nullptr);
+    capture.AddEvent({ "Too early", start - 1, 10, 1 });
+    capture.AddEvent({ "First", start, 10, 1 });
+    capture.AddEvent({ "Last", start + duration - 1, 10, 2 });
+    capture.AddEvent({ "Too late", start + duration, 10, 2 });
+    CHECK(!capture.Flush(start + duration));                                    // Still inside the grace period
+    CHECK(capture.Flush(start + duration + ProfilerTraceCapture::kEndGraceNs)); // Ends here
+    CHECK(!capture.IsActive());
+    capture.Finish(); // Joins the writer
+
+    ProfilerTraceCapture::Result result;
+    CHECK(capture.TakeResult(result));
+    CHECK(!capture.TakeResult(result)); // Once
+    CHECK(result.ok);
+    CHECK(result.events == 2);
+    CHECK(result.dropped == 0);
+
+    const std::string json = ReadFile(path);
+    CHECK(JsonValidator(json).Valid());
+    CHECK(json.find("\"Render Thread\"") != std::string::npos);
+    CHECK(json.find("\"Renamed\"") == std::string::npos);
+    CHECK(json.find("\"Thread 2\"") != std::string::npos);
+    CHECK(json.find("\"First\"") != std::string::npos && json.find("\"Last\"") != std::string::npos);
+    CHECK(json.find("Too early") == std::string::npos && json.find("Too late") == std::string::npos);
+
+    // A finished capture can be restarted
+    CHECK(capture.Start(path, start, duration));
+    capture.Finish();
+    CHECK(capture.TakeResult(result) && result.ok && result.events == 0);
+    std::filesystem::remove(path);
+}
+
+void TestOverflowIsCounted() {
+    const auto path = TempPath("toolscreen_trace_overflow_test.json");
+    ProfilerTraceCapture capture;
+    CHECK(capture.Start(path, 0, 1000000000));
+    // One batch larger than the writer backlog cap is dropped whole, whatever the writer has drained
+    const size_t oversized = ProfilerTraceCapture::kMaxQueuedEvents + 1;
+    for (size_t i = 0; i < oversized; ++i) capture.AddEvent({ "Spam", static_cast<int64_t>(i), 1, 1 });
+    CHECK(!capture.Flush(1));
+    capture.AddEvent({ "Kept", 2, 1, 1 });
+    capture.Finish();
+
+    ProfilerTraceCapture::Result result;
+    CHECK(capture.TakeResult(result));
+    CHECK(result.ok);
+    CHECK(result.dropped == oversized);
+    CHECK(result.events == 1);
+    std::filesystem::remove(path);
+}
+
+void TestStreamingProducer() {
+    const auto path = TempPath("toolscreen_trace_stream_test.json");
+    ProfilerTraceCapture capture;
+    const int64_t duration = 1000000000;
+    CHECK(capture.Start(path, 0, duration));
+
+    // The profiler's processing thread is the only producer; a second thread hammers Start meanwhile (hotkey vs. GUI)
+    constexpr int kBatches = 200;
+    constexpr int kPerBatch = 500;
+    std::atomic<bool> producing{ true };
+    std::thread starter([&] {
+        while (producing.load()) { CHECK(!capture.Start(path, 0, duration)); }
+    });
+    std::thread producer([&] {
+        int64_t t = 0;
+        for (int b = 0; b < kBatches; ++b) {
+            capture.AddThread(static_cast<uint32_t>(b % 4), "Worker");
+            for (int i = 0; i < kPerBatch; ++i) capture.AddEvent({ "Scope", t++, 1, static_cast<uint32_t>(b % 4) });
+            capture.Flush(t);
+        }
+    });
+    producer.join();
+    producing.store(false);
+    starter.join(); // Before the capture ends, after which a Start would rightly succeed
+    CHECK(capture.Flush(duration + ProfilerTraceCapture::kEndGraceNs));
+    capture.Finish();
+
+    ProfilerTraceCapture::Result result;
+    CHECK(capture.TakeResult(result));
+    CHECK(result.ok);
+    CHECK_MSG(result.events == static_cast<uint64_t>(kBatches) * kPerBatch, "%llu events", static_cast<unsigned long long>(result.events));
+    CHECK(result.dropped == 0);
+    const std::string json = ReadFile(path);
+    CHECK(JsonValidator(json).Valid());
+    CHECK(CountOccurrences(json, "\"ph\":\"X\"") == result.events);
+    CHECK(CountOccurrences(json, "\"thread_name\"") == 4);
+    std::filesystem::remove(path);
+}
+
+} // namespace
+
+int main() {
+    TestWriterFormat();
+    TestCaptureWindowAndThreads();
+    TestOverflowIsCounted();
+    TestStreamingProducer();
+    return TestResult("profiler_trace_test");
+}
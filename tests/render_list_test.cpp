@@ -0,0 +1,223 @@
+// Per-mode render lists on a real Config snapshot: group items positioned and scaled from their group, disabled and
+// missing entries skipped, referenced mirror names sorted and unique, case-insensitive lookup, rebuilds on a new
+// snapshot or screen size, and the slide-out difference. Then the allocation behaviour the render thread relies on:
+// once a snapshot's lists are compiled, frames that look up the active, from, EyeZoom and slide-out lists and split
+// each mirror's output anchor (as RT_RenderMirrors does) make no heap allocations. Counted with a replacement
+// operator new.
+
+#include "relative_anchor.h"
+#include "render_list.h"
+#include "test_util.h"
+
+#include <algorithm>
+#include <atomic>
+#include <cstdlib>
+#include <memory>
+#include <new>
+#include <string>
+#include <vector>
+
+namespace {
+std::atomic<size_t> g_allocations{ 0 };
+} // namespace
+
+// Out of line, or GCC inlines the malloc()/free() into the allocator and flags them as mismatched with new/delete
+[[gnu::noinline]] void* operator new(size_t size) {
+    g_allocations.fetch_add(1, std::memory_order_relaxed);
+    if (void* p = std::malloc(size ? size : 1)) return p;
+    throw std::bad_alloc();
+}
+[[gnu::noinline]] void operator delete(void* p) noexcept { std::free(p); }
+[[gnu::noinline]] void operator delete(void* p, size_t) noexcept { std::free(p); }
+
+namespace {
+
+// Names longer than any small-string buffer, so a copy per frame would show up as an allocation
+const std::string kPieChart = "Pie Chart Mirror With A Long Descriptive Name";
+const std::string kEntities = "Entity Counter Mirror With A Long Descriptive Name";
+const std::string kCompass = "Compass Mirror With A Long Descriptive Name";
+const std::string kDisabled = "Disabled Group Item Mirror With A Long Name";
+
+MirrorConfig Mirror(const std::string& name, int x, int y, float scale, const std::string& relativeTo) {
+    MirrorConfig mirror;
+    mirror.name = name;
+    mirror.input.push_back({ 10, 20, "centerViewport" });
+    mirror.output.x = x;
+    mirror.output.y = y;
+    mirror.output.scale = scale;
+    mirror.output.relativeTo = relativeTo;
+    mirror.colors.targetColors = { { 1.0f, 0.0f, 0.0f }, { 0.0f, 1.0f, 0.0f } };
+    return mirror;
+}
+
+ModeConfig Mode(const std::string& id, std::vector<std::string> mirrors, std::vector<std::string> groups) {
+    ModeConfig mode;
+    mode.id = id;
+    mode.mirrorIds = std::move(mirrors);
+    mode.mirrorGroupIds = std::move(groups);
+    return mode;
+}
+
+std::shared_ptr<const Config> MakeSnapshot() {
+    auto config = std::make_shared<Config>();
+    config->mirrors = { Mirror(kPieChart, 100, 200, 2.0f, "bottomRightScreen"), Mirror(kEntities, 5, 6, 1.0f, "topLeftViewport"),
+                        Mirror(kCompass, 7, 8, 3.0f, "centerScreenWithAVeryLongCustomAnchorNameScreen"),
+                        Mirror(kDisabled, 0, 0, 1.0f, "topRight") };
+    config->mirrors.push_back(Mirror(kPieChart, 999, 999, 9.0f, "topLeftScreen")); // Duplicate name: the first one wins
+
+    MirrorGroupConfig group;
+    group.name = "Readouts Group With A Long Descriptive Name";
+    group.output.x = 40;
+    group.output.y = 50;
+    group.output.relativeX = 0.25f;
+    group.output.relativeY = 0.5f;
+    group.output.relativeTo = "topRightViewport";
+    group.mirrors = { { kCompass, true, 0.5f, 2.0f, 3, 4 }, { kDisabled, false }, { "No Such Mirror", true }, { kEntities, true, 1.0f, 1.0f, -1, -2 } };
+    config->mirrorGroups.push_back(group);
+    group.name = "Relative Group";
+    group.output.useRelativePosition = true;
+    group.mirrors = { { kEntities, true } };
+    config->mirrorGroups.push_back(group);
+
+    ImageConfig image;
+    image.name = "Overlay Image";
+    config->images.push_back(image);
+    WindowOverlayConfig overlay;
+    overlay.name = "Ninjabrain Bot";
+    config->windowOverlays.push_back(overlay);
+
+    config->modes = { Mode("Fullscreen", {}, {}), Mode("Thin", { kPieChart, kEntities }, {}),
+                      Mode("EyeZoom", { kPieChart, kCompass, "Deleted Mirror" }, { "Missing Group" }),
+                      Mode("Wide", { kEntities }, { "Readouts Group With A Long Descriptive Name", "Relative Group" }) };
+    config->modes[1].imageIds = { "Overlay Image", "Deleted Image" };
+    config->modes[1].windowOverlayIds = { "Ninjabrain Bot" };
+    return config;
+}
+
+std::vector<std::string> Names(const std::vector<MirrorConfig>& mirrors) {
+    std::vector<std::string> names;
+    for (const MirrorConfig& mirror : mirrors) names.push_back(mirror.name);
+    return names;
+}
+
+void TestCompile() {
+    const auto snapshot = MakeSnapshot();
+    RenderListCache cache;
+
+    const ModeRenderList& thin = cache.Get(snapshot, "thin", 1920, 1080);
+    CHECK(thin.modeId == "Thin");
+    CHECK((Names(thin.mirrors) == std::vector<std::string>{ kPieChart, kEntities }));
+    CHECK(thin.mirrors.size() == 2 && thin.mirrors[0].output.x == 100 && thin.mirrors[0].output.scale == 2.0f);
+    CHECK(thin.images.size() == 1 && thin.images[0] == &snapshot->images[0]);
+    CHECK(thin.windowOverlays.size() == 1 && thin.windowOverlays[0] == &snapshot->windowOverlays[0]);
+
+    // Missing mirrors and groups are skipped, but names the mode refers to stay referenced
+    const ModeRenderList& eyeZoom = cache.Get(snapshot, "EyeZoom", 1920, 1080);
+    CHECK((Names(eyeZoom.mirrors) == std::vector<std::string>{ kPieChart, kCompass }));
+    CHECK((eyeZoom.referencedMirrorNames == std::vector<std::string>{ kCompass, "Deleted Mirror", kPieChart }));
+
+    // Group items take the group's position and anchor, plus their offset, with their size on top of the mirror's scale
+    const ModeRenderList& wide = cache.Get(snapshot, "WIDE", 1920, 1080);
+    CHECK((Names(wide.mirrors) == std::vector<std::string>{ kEntities, kCompass, kEntities, kEntities }));
+    if (wide.mirrors.size() == 4) {
+        const MirrorRenderConfig& compass = wide.mirrors[1].output;
+        CHECK(compass.x == 43 && compass.y == 54 && compass.relativeTo == "topRightViewport");
+        CHECK(compass.separateScale && compass.scaleX == 1.5f && compass.scaleY == 6.0f);
+        const MirrorRenderConfig& entities = wide.mirrors[2].output;
+        CHECK(entities.x == 39 && entities.y == 48 && !entities.separateScale && entities.scale == 1.0f);
+        const MirrorRenderConfig& relative = wide.mirrors[3].output;
+        CHECK(relative.useRelativePosition && relative.x == 480 && relative.y == 540);
+    }
+    CHECK((wide.referencedMirrorNames == std::vector<std::string>{ kCompass, kDisabled, kEntities, "No Such Mirror" }));
+
+    CHECK(cache.Get(snapshot, "Unknown", 1920, 1080).mirrors.empty());
+    CHECK(cache.Get(nullptr, "Thin", 1920, 1080).mirrors.empty());
+
+    // A new screen size re-resolves relative group positions; a new snapshot recompiles everything
+    const ModeRenderList& wide4k = cache.Get(snapshot, "Wide", 3840, 2160);
+    CHECK(wide4k.mirrors.size() == 4 && wide4k.mirrors[3].output.x == 960 && wide4k.mirrors[3].output.y == 1080);
+    auto edited = std::make_shared<Config>(*snapshot);
+    edited->modes[1].mirrorIds = { kCompass };
+    CHECK((Names(cache.Get(edited, "Thin", 3840, 2160).mirrors) == std::vector<std::string>{ kCompass }));
+    CHECK(cache.Get(edited, "Thin", 3840, 2160).images[0] == &edited->images[0]);
+}
+
+void TestMirrorsOnlyIn() {
+    const auto snapshot = MakeSnapshot();
+    RenderListCache cache;
+    const ModeRenderList& thin = cache.Get(snapshot, "Thin", 1920, 1080);
+    const ModeRenderList& eyeZoom = cache.Get(snapshot, "EyeZoom", 1920, 1080);
+    const ModeRenderList& wide = cache.Get(snapshot, "Wide", 1920, 1080);
+
+    CHECK((Names(cache.MirrorsOnlyIn(eyeZoom, thin)) == std::vector<std::string>{ kCompass }));
+    CHECK((Names(cache.MirrorsOnlyIn(thin, eyeZoom)) == std::vector<std::string>{ kEntities }));
+    CHECK((Names(cache.MirrorsOnlyIn(wide, thin)) == std::vector<std::string>{ kCompass }));
+    CHECK(cache.MirrorsOnlyIn(thin, thin).empty());
+    // Memoized on the pair, and recomputed when the pair changes
+    CHECK(&cache.MirrorsOnlyIn(wide, thin) == &cache.MirrorsOnlyIn(wide, thin));
+    CHECK((Names(cache.MirrorsOnlyIn(eyeZoom, thin)) == std::vector<std::string>{ kCompass }));
+}
+
+// One render-thread frame of a transition from `fromId` to `toId`: the active list, the from list, the slide-out
+// difference (EyeZoom's own lookup when leaving EyeZoom) and every mirror's anchor split into a reused buffer
+size_t Frame(RenderListCache& cache, const std::shared_ptr<const Config>& snapshot, const std::string& toId, const std::string& fromId,
+             std::string& anchor) {
+    const ModeRenderList& renderList = cache.Get(snapshot, toId, 1920, 1080);
+    const ModeRenderList& fromList = cache.Get(snapshot, fromId, 1920, 1080);
+    const bool fromEyeZoom = fromId == "EyeZoom";
+    const ModeRenderList& slideFrom = fromEyeZoom ? cache.Get(snapshot, "EyeZoom", 1920, 1080) : fromList;
+    const std::vector<MirrorConfig>& slideOut = cache.MirrorsOnlyIn(slideFrom, renderList);
+
+    size_t screenRelative = 0;
+    for (const std::vector<MirrorConfig>* mirrors : { &renderList.mirrors, &slideOut }) {
+        for (const MirrorConfig& mirror : *mirrors) screenRelative += SplitRelativeAnchor(mirror.output.relativeTo, anchor);
+    }
+    return screenRelative + renderList.images.size() + slideOut.size();
+}
+
+void TestSteadyStateFramesDontAllocate() {
+    const auto snapshot = MakeSnapshot();
+    RenderListCache cache;
+    std::string anchor;
+    // Mode ids arrive as references to interned strings (ModeIdFromHandle)
+    const std::string thin = "Thin", wide = "Wide", eyeZoom = "EyeZoom";
+
+    const size_t coldStart = g_allocations.load();
+    CHECK(Frame(cache, snapshot, thin, eyeZoom, anchor) > 0); // Compiles every list and sizes the anchor buffer
+    CHECK(g_allocations.load() > coldStart);                  // The counter sees them
+
+    struct Transition {
+        const std::string* to;
+        const std::string* from;
+    };
+    for (const Transition t : { Transition{ &thin, &eyeZoom }, Transition{ &thin, &wide }, Transition{ &wide, &thin }, Transition{ &eyeZoom, &wide } }) {
+        Frame(cache, snapshot, *t.to, *t.from, anchor); // First frame of a transition computes its slide-out list
+        const size_t before = g_allocations.load();
+        size_t work = 0;
+        for (int i = 0; i < 1000; ++i) work += Frame(cache, snapshot, *t.to, *t.from, anchor);
+        const size_t allocations = g_allocations.load() - before;
+        CHECK_MSG(allocations == 0, "%s -> %s: %zu allocations over 1000 frames", t.from->c_str(), t.to->c_str(), allocations);
+        CHECK(work > 0);
+    }
+}
+
+void TestSplitRelativeAnchor() {
+    std::string anchor;
+    CHECK(SplitRelativeAnchor("topLeftScreen", anchor) && anchor == "topLeft");
+    CHECK(!SplitRelativeAnchor("bottomRightViewport", anchor) && anchor == "bottomRight");
+    CHECK(!SplitRelativeAnchor("center", anchor) && anchor == "center");
+    // A bare suffix is a name, not an empty anchor
+    CHECK(!SplitRelativeAnchor("Screen", anchor) && anchor == "Screen");
+    CHECK(!SplitRelativeAnchor("Viewport", anchor) && anchor == "Viewport");
+    CHECK(!SplitRelativeAnchor("", anchor) && anchor.empty());
+}
+
+} // namespace
+
+int main() {
+    TestCompile();
+    TestMirrorsOnlyIn();
+    TestSteadyStateFramesDontAllocate();
+    TestSplitRelativeAnchor();
+    return TestResult("render_list_test");
+}
@@ -0,0 +1,129 @@
+// Caller-side cost of logging, in ns per call: LogEvent with its category disabled, LogEvent into the thread's ring
+// while a writer drains it (1 and 4 producer threads) and into a full ring, the string Log() path's caller side, and
+// the timestamp + concatenation the old Log() did on the caller. Also the writer's cost to drain and format a record.
+// Usage: structured_log_bench [calls per thread]
+
+#include "structured_log.h"
+#include "test_util.h"
+
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <cstdlib>
+#include <ctime>
+#include <iomanip>
+#include <sstream>
+#include <string>
+#include <thread>
+#include <vector>
+
+namespace {
+
+// What Log() did on the caller before the writer took over timestamps: "[HH:MM:SS.mmm] message" via stringstream
+std::string OldFormattedMessage(const std::string& message) {
+    const auto now = std::chrono::system_clock::now();
+    const std::time_t t = std::chrono::system_clock::to_time_t(now);
+    const auto ms = std::chrono::duration_cast<std::chrono::milliseconds>(now.time_since_epoch()) % 1000;
+    std::tm timeinfo{};
+    localtime_r(&t, &timeinfo);
+    std::stringstream ss;
+    ss << std::put_time(&timeinfo, "%H:%M:%S") << '.' << std::setfill('0') << std::setw(3) << ms.count();
+    return "[" + ss.str() + "] " + message;
+}
+
+// Log()'s caller side now: a tick and a moved message (the queue slot is modeled by a reused string)
+struct NewLogEntry {
+    int64_t ticks = 0;
+    std::string message;
+};
+
+struct DrainResult {
+    uint64_t records = 0;
+    uint64_t dropped = 0;
+};
+
+// `producers` threads each log `calls` records in bursts that fit their ring, pausing between bursts so the writer (this
+// thread, draining as the log writer does) keeps up. Only the bursts are timed.
+double TimeLogEventWithWriter(int producers, size_t calls, DrainResult& result) {
+    constexpr size_t kBurst = 512;
+    std::atomic<int> running{ producers };
+    std::vector<double> perThread(static_cast<size_t>(producers));
+    std::vector<std::thread> threads;
+    for (int p = 0; p < producers; ++p) {
+        threads.emplace_back([&, p] {
+            double timed = 0.0;
+            for (size_t done = 0; done < calls; done += kBurst) {
+                const double t0 = BenchSeconds();
+                for (size_t i = done; i < done + kBurst; ++i) {
+                    LogEvent(LogCategoryId::TextureOps, "Resized copy texture {} to {}x{} ({})", i, 1920, 1080, "mirror");
+                }
+                timed += BenchSeconds() - t0;
+                std::this_thread::sleep_for(std::chrono::milliseconds(2));
+            }
+            perThread[static_cast<size_t>(p)] = timed;
+            running.fetch_sub(1, std::memory_order_release);
+        });
+    }
+
+    result = DrainResult();
+    auto countRecord = [&](int64_t, std::string_view) { ++result.records; };
+    while (running.load(std::memory_order_acquire) > 0) result.dropped += DrainLogRecords(countRecord);
+    for (auto& t : threads) t.join();
+    result.dropped += DrainLogRecords(countRecord); // Also frees the exited threads' rings
+
+    double total = 0.0;
+    for (double s : perThread) total += s;
+    return total / producers * 1e9 / static_cast<double>((calls + kBurst - 1) / kBurst * kBurst);
+}
+
+} // namespace
+
+int main(int argc, char** argv) {
+    const size_t calls = argc > 1 ? static_cast<size_t>(std::atoll(argv[1])) : 2000000;
+
+    SetLogCategoryMask(0);
+    double t0 = BenchSeconds();
+    for (size_t i = 0; i < calls; ++i) LogEvent(LogCategoryId::TextureOps, "Resized copy texture {} to {}x{}", i, 1920, 1080);
+    std::printf("LogEvent, category disabled:     %8.1f ns/call\n", (BenchSeconds() - t0) * 1e9 / calls);
+
+    SetLogCategoryMask(1u << static_cast<uint32_t>(LogCategoryId::TextureOps));
+    const size_t ringCalls = std::min<size_t>(calls / 10, 100000); // Paced by the writer, so fewer
+    for (const int producers : { 1, 4 }) {
+        DrainResult result;
+        const double ns = TimeLogEventWithWriter(producers, ringCalls, result);
+        std::printf("LogEvent, enabled, %d thread(s):  %8.1f ns/call  (%llu written, %llu dropped)\n", producers, ns,
+                    static_cast<unsigned long long>(result.records), static_cast<unsigned long long>(result.dropped));
+    }
+
+    // Writer side: format every record of one full ring
+    const size_t ringRecords = 1024;
+    for (size_t i = 0; i < ringRecords; ++i) LogEvent(LogCategoryId::TextureOps, "Resized copy texture {} to {}x{} ({})", i, 1920, 1080, "mirror");
+
+    // The ring is full now: further calls take the drop path
+    t0 = BenchSeconds();
+    for (size_t i = 0; i < calls; ++i) LogEvent(LogCategoryId::TextureOps, "Resized copy texture {} to {}x{} ({})", i, 1920, 1080, "mirror");
+    std::printf("LogEvent, ring full (dropped):   %8.1f ns/call\n", (BenchSeconds() - t0) * 1e9 / calls);
+
+    size_t formattedBytes = 0;
+    t0 = BenchSeconds();
+    const uint64_t drained = DrainLogRecords([&](int64_t, std::string_view text) { formattedBytes += text.size(); });
+    std::printf("writer drain + format:           %8.1f ns/record (%zu bytes, %llu counted as dropped)\n",
+                (BenchSeconds() - t0) * 1e9 / ringRecords, formattedBytes, static_cast<unsigned long long>(drained));
+
+    const size_t stringCalls = calls / 10;
+    const std::string message = "Render Thread: Resized copy texture to 1920x1080";
+    NewLogEntry entry;
+    size_t sink = 0;
+    t0 = BenchSeconds();
+    for (size_t i = 0; i < stringCalls; ++i) {
+        std::string text = message;
+        entry.ticks = LogTicksNow();
+        entry.message = std::move(text);
+        sink += entry.message.size();
+    }
+    std::printf("Log(), caller side:              %8.1f ns/call\n", (BenchSeconds() - t0) * 1e9 / stringCalls);
+    t0 = BenchSeconds();
+    for (size_t i = 0; i < stringCalls; ++i) sink += OldFormattedMessage(message).size();
+    std::printf("old Log(), timestamp + concat:   %8.1f ns/call\n", (BenchSeconds() - t0) * 1e9 / stringCalls);
+    return sink == 0 ? 1 : 0;
+}
@@ -0,0 +1,50 @@
+#pragma once
+
+#include <algorithm>
+#include <chrono>
+#include <cstdio>
+
+// Minimal check helpers shared by the tests/ executables. A failed CHECK reports and keeps going; main() returns
+// TestResult() so ctest sees the failure count.
+
+inline int g_testFailures = 0;
+
+#define CHECK(cond)                                                                                                    \
+    do {                                                                                                               \
+        if (!(cond)) {                                                                                                 \
+            std::fprintf(stderr, "%s:%d: CHECK failed: %s\n", __FILE__, __LINE__, #cond);                              \
+            ++g_testFailures;                                                                                          \
+        }                                                                                                              \
+    } while (0)
+
+#define CHECK_MSG(cond, ...)                                                                                           \
+    do {                                                                                                               \
+        if (!(cond)) {                                                                                                 \
+            std::fprintf(stderr, "%s:%d: CHECK failed: %s: ", __FILE__, __LINE__, #cond);                              \
+            std::fprintf(stderr, __VA_ARGS__);                                                                         \
+            std::fprintf(stderr, "\n");                                                                                \
+            ++g_testFailures;                                                                                          \
+        }                                                                                                              \
+    } while (0)
+
+inline int TestResult(const char* name) {
+    if (g_testFailures == 0) {
+        std::printf("%s: passed\n", name);
+        return 0;
+    }
+    std::fprintf(stderr, "%s: %d check(s) failed\n", name, g_testFailures);
+    return 1;
+}
+
+inline double BenchSeconds() { return std::chrono::duration<double>(std::chrono::steady_clock::now().time_since_epoch()).count(); }
+
+// Fastest of `runs` calls to fn, in seconds
+template <typename Fn> double BestSeconds(Fn&& fn, int runs) {
+    double best = 1e9;
+    for (int i = 0; i < runs; ++i) {
+        const double t0 = BenchSeconds();
+        fn();
+        best = std::min(best, BenchSeconds() - t0);
+    }
+    return best;
+}
@@ -0,0 +1,66 @@
+#pragma once
+
+#include "toml.hpp"
+#include <string>
+#include <vector>
+
+// Generates a config.toml-shaped document for the ordered-writer test and benchmark: top-level scalars, named
+// sections, and large [[mode]] / [[mirror]] arrays whose items mix scalars, inline tables, a nested section table and
+// keys the key order doesn't list.
+
+inline const std::vector<std::string> kFixtureTopLevelOrder = { "configVersion", "defaultMode", "fontPath", "fpsLimit", "guiHotkey" };
+inline const std::vector<std::string> kFixtureModeOrder = { "id", "width", "height", "background", "mirrorIds", "stretch", "border" };
+
+inline toml::table MakeFixtureHeader() {
+    toml::table header;
+    header.insert("guiHotkey", toml::array{ 162, 73 });
+    header.insert("fpsLimit", 0);
+    header.insert("fontPath", "C:\\Windows\\Fonts\\Arial.ttf");
+    header.insert("defaultMode", "Fullscreen");
+    header.insert("configVersion", 1);
+    header.insert("zzFutureSetting", true);
+    return header;
+}
+
+inline toml::table MakeFixtureDebug() {
+    toml::table debug;
+    debug.insert("showProfiler", false);
+    debug.insert("profilerScale", 1.0);
+    debug.insert("traceCaptureHotkey", toml::array{ 17, 16, 123 });
+    toml::table nested;
+    nested.insert("enabled", true);
+    nested.insert("level", 3);
+    debug.insert("trace", std::move(nested));
+    return debug;
+}
+
+inline toml::table MakeFixtureMode(int i) {
+    toml::table mode;
+    // Inserted in reverse of the wanted order so the writer has to reorder
+    toml::table border{ { "enabled", i % 2 == 0 }, { "width", 4 }, { "color", toml::array{ 255, 255, 255 } } };
+    border.is_inline(true);
+    mode.insert("border", std::move(border));
+    toml::table stretch{ { "enabled", true }, { "x", i }, { "y", 0 }, { "width", 2560 }, { "height", 1440 } };
+    stretch.is_inline(true);
+    mode.insert("stretch", std::move(stretch));
+    mode.insert("mirrorIds", toml::array{ "Mapless", "E Counter " + std::to_string(i) });
+    // Not inline: written as a [mode.background] section after the item's plain keys
+    mode.insert("background", toml::table{ { "selectedMode", "color" }, { "color", toml::array{ 0, 0, 0 } } });
+    mode.insert("height", 1440 - i);
+    mode.insert("width", 2560 + i);
+    mode.insert("id", "Mode " + std::to_string(i));
+    mode.insert("unlisted key", "kept");
+    mode.insert("zzFutureField", static_cast<double>(i) * 0.5);
+    return mode;
+}
+
+inline toml::table MakeFixtureMirror(int i) {
+    toml::table mirror;
+    mirror.insert("fps", 30);
+    mirror.insert("captureWidth", 32 + i);
+    mirror.insert("name", "Mirror " + std::to_string(i));
+    toml::table colors{ { "output", toml::array{ 255, 0, 0 } } };
+    colors.is_inline(true);
+    mirror.insert("colors", std::move(colors));
+    return mirror;
+}
@@ -0,0 +1,57 @@
+// Benchmark for config saves: the ordered writer streaming a large config-shaped document section by section, against
+// building the full toml::table and printing it with toml++, plus the parse cost of the result.
+// Usage: toml_ordered_writer_bench [itemCount]
+
+#include "test_util.h"
+#include "toml_config_fixture.h"
+#include "toml_ordered_writer.h"
+
+#include <algorithm>
+#include <cstdlib>
+#include <sstream>
+
+int main(int argc, char** argv) {
+    const int items = argc > 1 ? std::atoi(argv[1]) : 2000;
+    constexpr int kRuns = 5;
+
+    double streamBest = 1e9, treeBest = 1e9, parseBest = 1e9;
+    size_t bytes = 0;
+    for (int run = 0; run < kRuns; ++run) {
+        double t0 = BenchSeconds();
+        std::ostringstream streamed;
+        WriteTomlTableOrdered(streamed, MakeFixtureHeader(), kFixtureTopLevelOrder);
+        WriteTomlNamedTable(streamed, "debug", MakeFixtureDebug());
+        for (int i = 0; i < items; ++i) WriteTomlArrayTableEntry(streamed, "mode", MakeFixtureMode(i), kFixtureModeOrder);
+        for (int i = 0; i < items; ++i) WriteTomlArrayTableEntry(streamed, "mirror", MakeFixtureMirror(i), { "name", "captureWidth" });
+        const std::string text = streamed.str();
+        streamBest = std::min(streamBest, BenchSeconds() - t0);
+        bytes = text.size();
+
+        t0 = BenchSeconds();
+        toml::table doc = MakeFixtureHeader();
+        doc.insert("debug", MakeFixtureDebug());
+        toml::array modes, mirrors;
+        for (int i = 0; i < items; ++i) modes.push_back(MakeFixtureMode(i));
+        for (int i = 0; i < items; ++i) mirrors.push_back(MakeFixtureMirror(i));
+        doc.insert("mode", std::move(modes));
+        doc.insert("mirror", std::move(mirrors));
+        std::ostringstream tree;
+        tree << doc;
+        treeBest = std::min(treeBest, BenchSeconds() - t0);
+
+        t0 = BenchSeconds();
+        try {
+            toml::table parsed = toml::parse(text);
+        } catch (const toml::parse_error& e) {
+            std::fprintf(stderr, "generated document failed to parse: %s\n", std::string(e.description()).c_str());
+            return 1;
+        }
+        parseBest = std::min(parseBest, BenchSeconds() - t0);
+    }
+
+    std::printf("%d modes + %d mirrors, %.1f KiB\n", items, items, bytes / 1024.0);
+    std::printf("ordered stream write: %8.2f ms\n", streamBest * 1000.0);
+    std::printf("full-table write:     %8.2f ms\n", treeBest * 1000.0);
+    std::printf("parse:                %8.2f ms\n", parseBest * 1000.0);
+    return 0;
+}
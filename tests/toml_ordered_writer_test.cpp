@@ -0,0 +1,130 @@
+// Round-trip test for the ordered TOML writer used by config saves: a large generated config-shaped document is
+// written section by section, parsed back with toml++, and compared to the source; key order is checked on the text.
+
+#include "test_util.h"
+#include "toml_config_fixture.h"
+#include "toml_ordered_writer.h"
+
+#include <sstream>
+
+namespace {
+
+constexpr int kModeCount = 400;
+constexpr int kMirrorCount = 400;
+
+void WriteFixture(std::ostream& out, toml::table& expected) {
+    toml::table header = MakeFixtureHeader();
+    WriteTomlTableOrdered(out, header, kFixtureTopLevelOrder);
+    for (auto&& [key, node] : header) expected.insert(key, node);
+
+    toml::table debug = MakeFixtureDebug();
+    WriteTomlNamedTable(out, "debug", debug);
+    expected.insert("debug", debug);
+
+    toml::array modes;
+    for (int i = 0; i < kModeCount; ++i) {
+        toml::table mode = MakeFixtureMode(i);
+        WriteTomlArrayTableEntry(out, "mode", mode, kFixtureModeOrder);
+        modes.push_back(std::move(mode));
+    }
+    expected.insert("mode", std::move(modes));
+
+    toml::array mirrors;
+    for (int i = 0; i < kMirrorCount; ++i) {
+        toml::table mirror = MakeFixtureMirror(i);
+        WriteTomlArrayTableEntry(out, "mirror", mirror, { "name", "captureWidth" });
+        mirrors.push_back(std::move(mirror));
+    }
+    expected.insert("mirror", std::move(mirrors));
+}
+
+// Order of `keys` as they first appear at line starts after `from`
+bool KeysAppearInOrder(const std::string& text, size_t from, const std::vector<std::string>& keys) {
+    size_t pos = from;
+    for (const std::string& key : keys) {
+        size_t found = text.find("\n" + key + " = ", pos);
+        if (found == std::string::npos) return false;
+        pos = found + 1;
+    }
+    return true;
+}
+
+void TestRoundTrip() {
+    std::ostringstream out;
+    toml::table expected;
+    WriteFixture(out, expected);
+    const std::string text = out.str();
+
+    toml::table tbl;
+    try {
+        tbl = toml::parse(text);
+    } catch (const toml::parse_error& e) {
+        CHECK_MSG(false, "generated document failed to parse: %s", std::string(e.description()).c_str());
+        return;
+    }
+
+    // Inline flags aren't part of equality, so this compares values and structure only
+    CHECK(tbl == expected);
+    CHECK(tbl["mode"].as_array() && tbl["mode"].as_array()->size() == static_cast<size_t>(kModeCount));
+    CHECK(tbl["mode"][kModeCount - 1]["id"].value_or(std::string()) == "Mode " + std::to_string(kModeCount - 1));
+    CHECK(tbl["mode"][7]["background"]["selectedMode"].value_or(std::string()) == "color");
+    CHECK(tbl["mode"][7]["unlisted key"].value_or(std::string()) == "kept");
+    CHECK(tbl["debug"]["trace"]["level"].value_or(0) == 3);
+    CHECK(tbl["zzFutureSetting"].value_or(false));
+
+    // Writing what was read back parses to the same document again
+    std::ostringstream again;
+    WriteTomlTableOrdered(again, tbl, {});
+    CHECK(toml::parse(again.str()) == expected);
+}
+
+void TestKeyOrder() {
+    std::ostringstream out;
+    toml::table expected;
+    WriteFixture(out, expected);
+    const std::string text = "\n" + out.str();
+
+    // Listed top-level keys first in order, then unlisted ones, all before the first section header
+    CHECK(KeysAppearInOrder(text, 0, { "configVersion", "defaultMode", "fontPath", "fpsLimit", "guiHotkey", "zzFutureSetting" }));
+    CHECK(text.find("\nzzFutureSetting = ") < text.find("\n[debug]"));
+
+    // Each [[mode]] item: listed keys in order, inline tables kept inline, then unlisted keys, then [mode.background]
+    const size_t firstMode = text.find("\n[[mode]]\n");
+    CHECK(firstMode != std::string::npos);
+    CHECK(KeysAppearInOrder(text, firstMode, { "id", "width", "height", "mirrorIds", "stretch", "border", "'unlisted key'", "zzFutureField" }));
+    CHECK(text.find("\nstretch = {", firstMode) != std::string::npos);
+    const size_t background = text.find("\n[mode.background]\n", firstMode);
+    const size_t secondMode = text.find("\n[[mode]]\n", firstMode + 1);
+    CHECK(background != std::string::npos && background < secondMode);
+    CHECK(text.find("\nzzFutureField = ", firstMode) < background);
+
+    // Unlisted named-section keys keep toml++'s sorted order
+    const size_t debug = text.find("\n[debug]\n");
+    CHECK(KeysAppearInOrder(text, debug, { "profilerScale", "showProfiler", "traceCaptureHotkey" }));
+    CHECK(text.find("\n[debug.trace]\n", debug) != std::string::npos);
+}
+
+void TestQuotedNames() {
+    toml::table tbl;
+    tbl.insert("plain_key-1", 1);
+    tbl.insert("needs quoting", 2);
+    tbl.insert("dotted.key", 3);
+    toml::table sub{ { "x", 4 } };
+    tbl.insert("odd section", std::move(sub));
+    std::ostringstream out;
+    WriteTomlTableOrdered(out, tbl, {});
+    try {
+        CHECK(toml::parse(out.str()) == tbl);
+    } catch (const toml::parse_error& e) {
+        CHECK_MSG(false, "%s", std::string(e.description()).c_str());
+    }
+}
+
+} // namespace
+
+int main() {
+    TestRoundTrip();
+    TestKeyOrder();
+    TestQuotedNames();
+    return TestResult("toml_ordered_writer_test");
+}
@@ -0,0 +1,121 @@
+// TripleBufferMailbox stress test: a producer publishes sequenced frames while a consumer sleeps on a
+// WaitableSequence and takes the latest, as SubmitFrameForRendering and the render thread do. No message is ever torn,
+// sequences only move forward, and every message is either taken once or handed back as replaced.
+// Build with TOOLSCREEN_TEST_SANITIZER=thread to race-check.
+
+#include "test_util.h"
+#include "triple_buffer_mailbox.h"
+
+#include <atomic>
+#include <chrono>
+#include <thread>
+
+namespace {
+
+// Large enough that a torn copy would show as mismatched words
+struct Frame {
+    uint64_t id = 0;
+    uint64_t words[15] = {};
+};
+
+Frame MakeFrame(uint64_t id) {
+    Frame f;
+    f.id = id;
+    for (int i = 0; i < 15; ++i) f.words[i] = id * 0x9E3779B97F4A7C15ull + static_cast<uint64_t>(i);
+    return f;
+}
+
+bool Intact(const Frame& f) {
+    for (int i = 0; i < 15; ++i) {
+        if (f.words[i] != f.id * 0x9E3779B97F4A7C15ull + static_cast<uint64_t>(i)) return false;
+    }
+    return true;
+}
+
+void TestSingleThreaded() {
+    TripleBufferMailbox<Frame> mailbox;
+    CHECK(!mailbox.HasPending());
+    CHECK(mailbox.TryTake() == nullptr);
+
+    CHECK(!mailbox.Publish(MakeFrame(1), 100));
+    CHECK(mailbox.HasPending());
+    const auto* msg = mailbox.TryTake();
+    CHECK(msg && msg->value.id == 1 && msg->sequence == 1 && msg->publishedNs == 100);
+    CHECK(mailbox.TryTake() == nullptr);
+
+    // Publishing over an untaken message replaces it and hands it back
+    Frame replaced;
+    CHECK(!mailbox.Publish(MakeFrame(2), 200, &replaced));
+    CHECK(mailbox.Publish(MakeFrame(3), 300, &replaced));
+    CHECK(replaced.id == 2);
+    msg = mailbox.TryTake();
+    CHECK(msg && msg->value.id == 3 && msg->sequence == 3);
+    CHECK(mailbox.PublishedSequence() == 3);
+
+    // Reset drops a pending message and keeps the sequence counting
+    mailbox.Publish(MakeFrame(4), 400);
+    Frame dropped;
+    CHECK(mailbox.Reset(&dropped));
+    CHECK(dropped.id == 4);
+    CHECK(!mailbox.HasPending() && mailbox.TryTake() == nullptr);
+    CHECK(!mailbox.Reset());
+    CHECK(!mailbox.Publish(MakeFrame(5), 500));
+    msg = mailbox.TryTake();
+    CHECK(msg && msg->value.id == 5 && msg->sequence == 5 && Intact(msg->value));
+}
+
+void TestProducerConsumer(int frames, bool throttleProducer) {
+    TripleBufferMailbox<Frame> mailbox;
+    WaitableSequence signal;
+    std::atomic<bool> done{ false };
+    uint64_t replacedCount = 0;
+    uint64_t lastReplaced = 0;
+    bool replacedOutOfOrder = false;
+
+    std::thread producer([&] {
+        for (int i = 1; i <= frames; ++i) {
+            Frame replaced;
+            if (mailbox.Publish(MakeFrame(static_cast<uint64_t>(i)), i, &replaced)) {
+                ++replacedCount;
+                if (!Intact(replaced) || replaced.id <= lastReplaced) replacedOutOfOrder = true;
+                lastReplaced = replaced.id;
+            }
+            signal.Notify();
+            if (throttleProducer && i % 64 == 0) std::this_thread::sleep_for(std::chrono::microseconds(50));
+        }
+        done.store(true, std::memory_order_release);
+        signal.Notify();
+    });
+
+    uint64_t taken = 0, lastSequence = 0, torn = 0, backwards = 0;
+    for (;;) {
+        const uint32_t seen = signal.Load();
+        while (const auto* msg = mailbox.TryTake()) {
+            if (!Intact(msg->value) || msg->value.id != msg->sequence) ++torn;
+            if (msg->sequence <= lastSequence) ++backwards;
+            lastSequence = msg->sequence;
+            ++taken;
+        }
+        if (done.load(std::memory_order_acquire) && !mailbox.HasPending()) break;
+        signal.WaitChange(seen, std::chrono::milliseconds(5));
+    }
+    producer.join();
+
+    CHECK_MSG(torn == 0, "%llu torn messages", static_cast<unsigned long long>(torn));
+    CHECK(backwards == 0);
+    CHECK(!replacedOutOfOrder);
+    CHECK(lastSequence == static_cast<uint64_t>(frames)); // The newest message always gets through
+    CHECK_MSG(taken + replacedCount == static_cast<uint64_t>(frames), "%llu taken + %llu replaced != %d",
+              static_cast<unsigned long long>(taken), static_cast<unsigned long long>(replacedCount), frames);
+    std::printf("  %d frames%s: %llu taken, %llu replaced\n", frames, throttleProducer ? " (throttled)" : "",
+                static_cast<unsigned long long>(taken), static_cast<unsigned long long>(replacedCount));
+}
+
+} // namespace
+
+int main() {
+    TestSingleThreaded();
+    TestProducerConsumer(200000, false);
+    TestProducerConsumer(20000, true);
+    return TestResult("triple_buffer_mailbox_test");
+}
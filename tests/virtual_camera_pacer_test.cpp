@@ -0,0 +1,74 @@
+// VirtualCameraPacer accounting: busy-pipeline drops must not retire in-flight captures, and deliveries without a
+// paced capture must not skew the latency averages.
+
+#include "test_util.h"
+#include "virtual_camera_pacer.h"
+
+namespace {
+
+constexpr int64_t kTicksPerSecond = 1000000; // Microseconds
+constexpr int64_t kFrame = kTicksPerSecond / 60;
+
+void TestBusyDropKeepsInFlight() {
+    VirtualCameraPacer pacer;
+    pacer.Reset(60, kTicksPerSecond);
+    int64_t now = 1;
+    CHECK(pacer.ShouldCapture(now, false));
+
+    // Next slot is due while the readback pipeline is busy: dropped up front, the first capture stays in flight
+    now += kFrame;
+    CHECK(!pacer.ShouldCapture(now, true));
+    CHECK(pacer.TotalStats().dropped == 1);
+
+    // Delivering now retires the first capture with its real latency (2 frames), not a later one
+    now += kFrame;
+    pacer.OnDelivered(now);
+    CHECK(pacer.TotalStats().delivered == 1);
+    CHECK(pacer.TotalStats().maxLatencyMs > 30.0);
+
+    // Nothing is left in flight, so a second delivery is unpaced
+    pacer.OnDelivered(now);
+    CHECK(pacer.TotalStats().delivered == 2);
+    CHECK(pacer.TotalStats().avgLatencyMs > 30.0);
+}
+
+void TestUnpacedDeliveriesSkipLatency() {
+    VirtualCameraPacer pacer;
+    pacer.Reset(60, kTicksPerSecond);
+    int64_t now = 1;
+    CHECK(pacer.ShouldCapture(now, false));
+    pacer.OnDelivered(now + 10000); // 10 ms
+    for (int i = 0; i < 9; ++i) pacer.OnDelivered(now + 10000);
+
+    CHECK(pacer.TotalStats().delivered == 10);
+    CHECK(pacer.TotalStats().avgLatencyMs > 9.99 && pacer.TotalStats().avgLatencyMs < 10.01);
+
+    VirtualCameraPacer::Stats window;
+    CHECK(pacer.TakeWindowStats(now + kTicksPerSecond, window));
+    CHECK(window.delivered == 10);
+    CHECK(window.avgLatencyMs > 9.99 && window.avgLatencyMs < 10.01);
+}
+
+void TestCadence() {
+    // 144 Hz render loop feeding a 60 fps camera delivers ~60 frames per second
+    VirtualCameraPacer pacer;
+    pacer.Reset(60, kTicksPerSecond);
+    const int64_t renderPeriod = kTicksPerSecond / 144;
+    int captured = 0;
+    for (int64_t now = 1; now < 2 * kTicksPerSecond; now += renderPeriod) {
+        if (pacer.ShouldCapture(now, false)) {
+            ++captured;
+            pacer.OnDelivered(now + 1000);
+        }
+    }
+    CHECK_MSG(captured >= 118 && captured <= 122, "%d captures in 2 s", captured);
+}
+
+} // namespace
+
+int main() {
+    TestBusyDropKeepsInFlight();
+    TestUnpacedDeliveriesSkipLatency();
+    TestCadence();
+    return TestResult("virtual_camera_pacer_test");
+}
@@ -0,0 +1,130 @@
+// VirtualCameraQueue over a POSIX shared-memory mapping, read back through a second mapping of the same object the
+// way the OBS virtual camera reader (shared-memory-queue.c) does: state, read_idx % 3, then the slot's timestamp and
+// frame.
+
+#include "test_util.h"
+#include "virtual_camera_queue.h"
+
+#include <cstddef>
+#include <cstring>
+#include <fcntl.h>
+#include <string>
+#include <sys/mman.h>
+#include <unistd.h>
+#include <vector>
+
+namespace {
+
+struct SharedMapping {
+    int fd = -1;
+    uint8_t* writer = nullptr;
+    uint8_t* reader = nullptr;
+    size_t size = 0;
+    std::string name;
+
+    bool Open(size_t bytes) {
+        name = "/toolscreen_vcam_test_" + std::to_string(getpid());
+        fd = shm_open(name.c_str(), O_CREAT | O_RDWR | O_EXCL, 0600);
+        if (fd < 0 || ftruncate(fd, static_cast<off_t>(bytes)) != 0) return false;
+        size = bytes;
+        void* w = mmap(nullptr, bytes, PROT_READ | PROT_WRITE, MAP_SHARED, fd, 0);
+        void* r = mmap(nullptr, bytes, PROT_READ, MAP_SHARED, fd, 0);
+        if (w == MAP_FAILED || r == MAP_FAILED) return false;
+        // Start from garbage, as a reused mapping would
+        std::memset(w, 0xA5, bytes);
+        writer = static_cast<uint8_t*>(w);
+        reader = static_cast<uint8_t*>(r);
+        return true;
+    }
+
+    ~SharedMapping() {
+        if (writer) munmap(writer, size);
+        if (reader) munmap(reader, size);
+        if (fd >= 0) {
+            close(fd);
+            shm_unlink(name.c_str());
+        }
+    }
+};
+
+struct ReadFrame {
+    bool ready = false;
+    uint64_t timestamp = 0;
+    const uint8_t* data = nullptr;
+};
+
+ReadFrame ReadLikeObs(const uint8_t* base) {
+    const auto* header = reinterpret_cast<const VirtualCameraQueueHeader*>(base);
+    ReadFrame frame;
+    if (header->state != VIRTUAL_CAMERA_QUEUE_STATE_READY) return frame;
+    const uint32_t slot = header->read_idx % 3;
+    std::memcpy(&frame.timestamp, base + header->offsets[slot], sizeof(frame.timestamp));
+    frame.data = base + header->offsets[slot] + 32;
+    frame.ready = true;
+    return frame;
+}
+
+void TestLayout() {
+    const VirtualCameraQueueLayout layout = ComputeVirtualCameraQueueLayout(1920, 1080);
+    CHECK(layout.frameSize == 1920u * 1080u * 3u / 2u);
+    CHECK(layout.offsets[0] % 32 == 0 && layout.offsets[0] >= sizeof(VirtualCameraQueueHeader));
+    for (int i = 0; i < 3; ++i) {
+        const uint32_t end = layout.offsets[i] + 32 + layout.frameSize;
+        CHECK(end <= (i < 2 ? layout.offsets[i + 1] : layout.totalSize));
+    }
+    // Field offsets the OBS reader relies on
+    CHECK(offsetof(VirtualCameraQueueHeader, state) == 8);
+    CHECK(offsetof(VirtualCameraQueueHeader, offsets) == 12);
+    CHECK(offsetof(VirtualCameraQueueHeader, interval) == 40);
+}
+
+void TestProduceAndRead() {
+    constexpr uint32_t kWidth = 64;
+    constexpr uint32_t kHeight = 36;
+    const VirtualCameraQueueLayout layout = ComputeVirtualCameraQueueLayout(kWidth, kHeight);
+    SharedMapping mapping;
+    CHECK(mapping.Open(layout.totalSize));
+    if (!mapping.writer) return;
+
+    VirtualCameraQueue queue;
+    queue.Attach(mapping.writer, kWidth, kHeight, 333333);
+    CHECK(queue.IsAttached());
+    CHECK(queue.FrameSize() == layout.frameSize);
+
+    const auto* header = reinterpret_cast<const VirtualCameraQueueHeader*>(mapping.reader);
+    CHECK(header->state == VIRTUAL_CAMERA_QUEUE_STATE_STARTING);
+    CHECK(header->cx == kWidth && header->cy == kHeight && header->interval == 333333);
+    CHECK(!ReadLikeObs(mapping.reader).ready);
+
+    for (uint32_t frame = 1; frame <= 10; ++frame) {
+        VirtualCameraQueue::Slot slot = queue.Reserve();
+        CHECK(static_cast<bool>(slot));
+        CHECK(slot.index == frame % 3);
+        std::memset(slot.data, static_cast<int>(frame), queue.FrameSize());
+        queue.Commit(slot, 1000ull * frame);
+
+        const ReadFrame read = ReadLikeObs(mapping.reader);
+        CHECK(read.ready);
+        CHECK(header->write_idx == frame && header->read_idx == frame);
+        CHECK(read.timestamp == 1000ull * frame);
+        const std::vector<uint8_t> expected(queue.FrameSize(), static_cast<uint8_t>(frame));
+        CHECK(read.data && std::memcmp(read.data, expected.data(), expected.size()) == 0);
+    }
+
+    // The other two slots still hold the previous frames (OBS may be mid-read on one of them)
+    const uint8_t* previous = mapping.reader + header->offsets[9 % 3] + 32;
+    CHECK(previous[0] == 9 && previous[queue.FrameSize() - 1] == 9);
+
+    queue.Detach();
+    CHECK(!queue.IsAttached());
+    CHECK(header->state == VIRTUAL_CAMERA_QUEUE_STATE_STOPPING);
+    CHECK(!queue.Reserve());
+}
+
+} // namespace
+
+int main() {
+    TestLayout();
+    TestProduceAndRead();
+    return TestResult("virtual_camera_queue_test");
+}